@@ -0,0 +1,170 @@
+/*
+ * @brief Write-back sector cache with read-ahead for block devices
+ *
+ * @note
+ * Sits between a file system and a block driver such as
+ * Chip_SDMMC_ReadBlocks()/Chip_SDMMC_WriteBlocks().  Small reads and writes
+ * are served from segments of BLKCACHE_SEG_SECTORS sectors kept in memory
+ * the application gives; large ones go to the device in one call.  See
+ * readme.txt in this directory.
+ *
+ * @par
+ * There is no heap and no locking: use a cache from one task only.
+ */
+
+#ifndef __BLKCACHE_H_
+#define __BLKCACHE_H_
+
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup BLKCACHE BLKCACHE: Write-back sector cache
+ * @{
+ */
+
+/** Sector size of the device */
+#define BLKCACHE_SECTOR_SIZE    512
+
+/** Sectors per segment, a power of 2 up to 32 */
+#ifndef BLKCACHE_SEG_SECTORS
+#define BLKCACHE_SEG_SECTORS    8
+#endif
+
+/** Largest number of segments in a cache */
+#ifndef BLKCACHE_MAX_SEGS
+#define BLKCACHE_MAX_SEGS       16
+#endif
+
+/** Memory used by one segment */
+#define BLKCACHE_SEG_SIZE       (BLKCACHE_SEG_SECTORS * BLKCACHE_SECTOR_SIZE)
+
+/** Base of an unused segment */
+#define BLKCACHE_NO_SECTOR      0xFFFFFFFF
+
+/**
+ * @brief	Device read callback
+ * @param	ctx		: Context pointer given to BlkCache_Init()
+ * @param	pBuf	: Buffer for the sectors, word aligned
+ * @param	sector	: First sector
+ * @param	count	: Number of sectors, at least 1
+ * @return	SUCCESS once all the sectors are in pBuf, ERROR otherwise
+ */
+typedef Status (*BLKCACHE_READ_T)(void *ctx, void *pBuf, uint32_t sector, uint32_t count);
+
+/**
+ * @brief	Device write callback
+ * @param	ctx		: Context pointer given to BlkCache_Init()
+ * @param	pBuf	: Sectors to write, word aligned
+ * @param	sector	: First sector
+ * @param	count	: Number of sectors, at least 1
+ * @return	SUCCESS once all the sectors are written, ERROR otherwise
+ */
+typedef Status (*BLKCACHE_WRITE_T)(void *ctx, const void *pBuf, uint32_t sector, uint32_t count);
+
+/**
+ * @brief Cache segment, BLKCACHE_SEG_SECTORS sectors from an aligned base
+ */
+typedef struct {
+	uint32_t base;			/*!< First sector, BLKCACHE_NO_SECTOR when unused */
+	uint32_t valid;			/*!< Bit n set when sector base + n is in pData */
+	uint32_t dirty;			/*!< Bit n set when sector base + n is not written back */
+	uint32_t lastUse;		/*!< Stamp of the last access, for the LRU */
+	uint8_t *pData;			/*!< BLKCACHE_SEG_SIZE bytes */
+} BLKCACHE_SEG_T;
+
+/**
+ * @brief Sector cache state
+ */
+typedef struct {
+	BLKCACHE_READ_T pRead;	/*!< Device read callback */
+	BLKCACHE_WRITE_T pWrite;	/*!< Device write callback */
+	void *ctx;				/*!< Passed to the callbacks */
+	uint32_t numSegs;		/*!< Segments in use */
+	uint32_t stamp;			/*!< Access counter for lastUse */
+	uint32_t nextSector;	/*!< Sector after the last read, to spot sequential reads */
+	BLKCACHE_SEG_T segs[BLKCACHE_MAX_SEGS];	/*!< Segments */
+	uint32_t hits;			/*!< Reads served from the cache */
+	uint32_t misses;		/*!< Reads that needed the device */
+	uint32_t readAhead;		/*!< Sectors read ahead of a sequential read */
+	uint32_t devReads;		/*!< Device read calls */
+	uint32_t devWrites;		/*!< Device write calls */
+} BLKCACHE_T;
+
+/**
+ * @brief	Set up a cache
+ * @param	pCache	: Cache to set up
+ * @param	pRead	: Device read callback
+ * @param	pWrite	: Device write callback
+ * @param	ctx		: Passed to the callbacks
+ * @param	pMem	: Memory for the segments, word aligned, and reachable
+ *					  by the DMA when the device uses it
+ * @param	memSize	: Size of pMem in bytes, at least BLKCACHE_SEG_SIZE
+ * @return	Number of segments, at most BLKCACHE_MAX_SEGS, or 0 if memSize is
+ *			less than BLKCACHE_SEG_SIZE or a callback or pMem is NULL
+ * @note	A cache refused here, like a zeroed BLKCACHE_T, is not set up:
+ *			BlkCache_Read(), BlkCache_Write() and BlkCache_Flush() return
+ *			ERROR without calling the device.
+ */
+uint32_t BlkCache_Init(BLKCACHE_T *pCache, BLKCACHE_READ_T pRead, BLKCACHE_WRITE_T pWrite,
+					   void *ctx, void *pMem, uint32_t memSize);
+
+/**
+ * @brief	Read sectors
+ * @param	pCache	: Cache set up with BlkCache_Init()
+ * @param	pBuf	: Buffer for the sectors, word aligned
+ * @param	sector	: First sector
+ * @param	count	: Number of sectors
+ * @return	ERROR if the cache is not set up or a device call failed,
+ *			SUCCESS otherwise
+ * @note	Reads of BLKCACHE_SEG_SECTORS sectors or more go to the device in
+ *			one call, straight into pBuf, and are not cached. A read that
+ *			goes on from the previous one reads ahead to the end of its
+ *			segment, in the same device call.
+ */
+Status BlkCache_Read(BLKCACHE_T *pCache, void *pBuf, uint32_t sector, uint32_t count);
+
+/**
+ * @brief	Write sectors
+ * @param	pCache	: Cache set up with BlkCache_Init()
+ * @param	pBuf	: Sectors to write, word aligned
+ * @param	sector	: First sector
+ * @param	count	: Number of sectors
+ * @return	ERROR if the cache is not set up or a device call failed,
+ *			SUCCESS otherwise
+ * @note	Writes of BLKCACHE_SEG_SECTORS sectors or more go to the device in
+ *			one call, and update the cached copies. Smaller ones stay in the
+ *			cache until their segment is evicted or BlkCache_Flush() is
+ *			called, and never read the device.
+ */
+Status BlkCache_Write(BLKCACHE_T *pCache, const void *pBuf, uint32_t sector, uint32_t count);
+
+/**
+ * @brief	Write back all the cached writes
+ * @param	pCache	: Cache set up with BlkCache_Init()
+ * @return	ERROR if the cache is not set up or a device call failed,
+ *			SUCCESS otherwise
+ * @note	Segments are written in sector order, one device call per run of
+ *			dirty sectors. Call it before the card is removed or powered off.
+ */
+Status BlkCache_Flush(BLKCACHE_T *pCache);
+
+/**
+ * @brief	Drop all the cached sectors, without writing them back
+ * @param	pCache	: Cache set up with BlkCache_Init()
+ * @return	Nothing
+ * @note	For a card that was changed.
+ */
+void BlkCache_Invalidate(BLKCACHE_T *pCache);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLKCACHE_H_ */
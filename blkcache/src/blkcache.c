@@ -0,0 +1,332 @@
+/*
+ * @brief Write-back sector cache with read-ahead for block devices
+ *
+ * @note
+ * Segments hold BLKCACHE_SEG_SECTORS sectors from a base aligned to the
+ * segment size, with one valid and one dirty bit per sector, so a write
+ * never has to read the rest of its segment first.  The least recently
+ * used segment is evicted, writing back its dirty runs.
+ */
+
+#include <string.h>
+#include "blkcache.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#if (BLKCACHE_SEG_SECTORS > 32) || (BLKCACHE_SEG_SECTORS & (BLKCACHE_SEG_SECTORS - 1))
+#error "BLKCACHE_SEG_SECTORS must be a power of 2 up to 32"
+#endif
+
+#define SEG_MASK            (BLKCACHE_SEG_SECTORS - 1)
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Bits first to first + count - 1 of a sector mask */
+static uint32_t sectorMask(uint32_t first, uint32_t count)
+{
+	if (count >= 32) {
+		return 0xFFFFFFFF;
+	}
+	return ((1UL << count) - 1) << first;
+}
+
+/* Segment holding a base, or NULL */
+static BLKCACHE_SEG_T *segFind(BLKCACHE_T *pCache, uint32_t base)
+{
+	uint32_t i;
+
+	for (i = 0; i < pCache->numSegs; i++) {
+		if (pCache->segs[i].base == base) {
+			return &pCache->segs[i];
+		}
+	}
+	return NULL;
+}
+
+/* Write back the runs of dirty sectors of a segment */
+static Status segWriteBack(BLKCACHE_T *pCache, BLKCACHE_SEG_T *pSeg)
+{
+	uint32_t first, last;
+
+	first = 0;
+	while (pSeg->dirty != 0) {
+		while (!(pSeg->dirty & (1UL << first))) {
+			first++;
+		}
+		last = first;
+		while ((last < BLKCACHE_SEG_SECTORS) && (pSeg->dirty & (1UL << last))) {
+			last++;
+		}
+
+		pCache->devWrites++;
+		if (pCache->pWrite(pCache->ctx, pSeg->pData + first * BLKCACHE_SECTOR_SIZE,
+						   pSeg->base + first, last - first) != SUCCESS) {
+			return ERROR;
+		}
+		pSeg->dirty &= ~sectorMask(first, last - first);
+		first = last;
+	}
+	return SUCCESS;
+}
+
+/* Take the least recently used segment for a base, writing back its old
+   sectors */
+static BLKCACHE_SEG_T *segNew(BLKCACHE_T *pCache, uint32_t base)
+{
+	BLKCACHE_SEG_T *pSeg = &pCache->segs[0];
+	uint32_t i;
+
+	for (i = 0; (i < pCache->numSegs) && (pSeg->base != BLKCACHE_NO_SECTOR); i++) {
+		if ((pCache->segs[i].base == BLKCACHE_NO_SECTOR) ||
+			(pCache->segs[i].lastUse < pSeg->lastUse)) {
+			pSeg = &pCache->segs[i];
+		}
+	}
+
+	if (segWriteBack(pCache, pSeg) != SUCCESS) {
+		return NULL;
+	}
+	pSeg->base = base;
+	pSeg->valid = 0;
+	return pSeg;
+}
+
+/* Read the missing sectors first to end - 1 of a segment, one device call
+   per run */
+static Status segFill(BLKCACHE_T *pCache, BLKCACHE_SEG_T *pSeg, uint32_t first, uint32_t end)
+{
+	uint32_t last;
+
+	while (first < end) {
+		if (pSeg->valid & (1UL << first)) {
+			first++;
+			continue;
+		}
+		last = first;
+		while ((last < end) && !(pSeg->valid & (1UL << last))) {
+			last++;
+		}
+
+		pCache->devReads++;
+		if (pCache->pRead(pCache->ctx, pSeg->pData + first * BLKCACHE_SECTOR_SIZE,
+						  pSeg->base + first, last - first) != SUCCESS) {
+			return ERROR;
+		}
+		pSeg->valid |= sectorMask(first, last - first);
+		first = last;
+	}
+	return SUCCESS;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Set up a cache */
+uint32_t BlkCache_Init(BLKCACHE_T *pCache, BLKCACHE_READ_T pRead, BLKCACHE_WRITE_T pWrite,
+					   void *ctx, void *pMem, uint32_t memSize)
+{
+	uint32_t i;
+
+	/* A refused cache keeps numSegs at 0, which the other calls refuse */
+	memset(pCache, 0, sizeof(*pCache));
+	if ((pRead == NULL) || (pWrite == NULL) || (pMem == NULL) || (memSize < BLKCACHE_SEG_SIZE)) {
+		return 0;
+	}
+	pCache->pRead = pRead;
+	pCache->pWrite = pWrite;
+	pCache->ctx = ctx;
+	pCache->numSegs = MIN(memSize / BLKCACHE_SEG_SIZE, BLKCACHE_MAX_SEGS);
+	pCache->nextSector = BLKCACHE_NO_SECTOR;
+
+	for (i = 0; i < pCache->numSegs; i++) {
+		pCache->segs[i].base = BLKCACHE_NO_SECTOR;
+		pCache->segs[i].pData = (uint8_t *) pMem + i * BLKCACHE_SEG_SIZE;
+	}
+	return pCache->numSegs;
+}
+
+/* Read sectors */
+Status BlkCache_Read(BLKCACHE_T *pCache, void *pBuf, uint32_t sector, uint32_t count)
+{
+	uint8_t *pDst = pBuf;
+	BLKCACHE_SEG_T *pSeg;
+	uint32_t i, first, n, end, base, mask;
+	bool sequential = (sector == pCache->nextSector);
+
+	if (pCache->numSegs == 0) {
+		return ERROR;
+	}
+	pCache->nextSector = sector + count;
+
+	if (count >= BLKCACHE_SEG_SECTORS) {
+		/* Large reads bypass the cache, then take the writes it holds */
+		pCache->misses++;
+		pCache->devReads++;
+		if (pCache->pRead(pCache->ctx, pBuf, sector, count) != SUCCESS) {
+			return ERROR;
+		}
+		for (i = 0; i < pCache->numSegs; i++) {
+			pSeg = &pCache->segs[i];
+			if ((pSeg->dirty == 0) || (pSeg->base + BLKCACHE_SEG_SECTORS <= sector) ||
+				(pSeg->base >= sector + count)) {
+				continue;
+			}
+			for (first = 0; first < BLKCACHE_SEG_SECTORS; first++) {
+				if ((pSeg->dirty & (1UL << first)) && (pSeg->base + first >= sector) &&
+					(pSeg->base + first < sector + count)) {
+					memcpy(pDst + (pSeg->base + first - sector) * BLKCACHE_SECTOR_SIZE,
+						   pSeg->pData + first * BLKCACHE_SECTOR_SIZE, BLKCACHE_SECTOR_SIZE);
+				}
+			}
+		}
+		return SUCCESS;
+	}
+
+	while (count > 0) {
+		base = sector & ~SEG_MASK;
+		first = sector & SEG_MASK;
+		n = MIN(count, BLKCACHE_SEG_SECTORS - first);
+		mask = sectorMask(first, n);
+
+		pSeg = segFind(pCache, base);
+		if ((pSeg != NULL) && ((pSeg->valid & mask) == mask)) {
+			pCache->hits++;
+		}
+		else {
+			pCache->misses++;
+			if (pSeg == NULL) {
+				pSeg = segNew(pCache, base);
+				if (pSeg == NULL) {
+					return ERROR;
+				}
+			}
+
+			/* A sequential read goes on to the end of the segment */
+			end = sequential ? BLKCACHE_SEG_SECTORS : first + n;
+			if (end > first + n) {
+				pCache->readAhead += end - (first + n);
+			}
+			if (segFill(pCache, pSeg, first, end) != SUCCESS) {
+				return ERROR;
+			}
+		}
+
+		pSeg->lastUse = ++pCache->stamp;
+		memcpy(pDst, pSeg->pData + first * BLKCACHE_SECTOR_SIZE, n * BLKCACHE_SECTOR_SIZE);
+		pDst += n * BLKCACHE_SECTOR_SIZE;
+		sector += n;
+		count -= n;
+	}
+	return SUCCESS;
+}
+
+/* Write sectors */
+Status BlkCache_Write(BLKCACHE_T *pCache, const void *pBuf, uint32_t sector, uint32_t count)
+{
+	const uint8_t *pSrc = pBuf;
+	BLKCACHE_SEG_T *pSeg;
+	uint32_t i, first, base, n, mask;
+
+	if (pCache->numSegs == 0) {
+		return ERROR;
+	}
+
+	if (count >= BLKCACHE_SEG_SECTORS) {
+		/* Large writes go through, the cached copies follow */
+		pCache->devWrites++;
+		if (pCache->pWrite(pCache->ctx, pBuf, sector, count) != SUCCESS) {
+			return ERROR;
+		}
+		for (i = 0; i < pCache->numSegs; i++) {
+			pSeg = &pCache->segs[i];
+			if ((pSeg->base == BLKCACHE_NO_SECTOR) || (pSeg->base + BLKCACHE_SEG_SECTORS <= sector) ||
+				(pSeg->base >= sector + count)) {
+				continue;
+			}
+			for (first = 0; first < BLKCACHE_SEG_SECTORS; first++) {
+				if ((pSeg->base + first >= sector) && (pSeg->base + first < sector + count)) {
+					memcpy(pSeg->pData + first * BLKCACHE_SECTOR_SIZE,
+						   pSrc + (pSeg->base + first - sector) * BLKCACHE_SECTOR_SIZE,
+						   BLKCACHE_SECTOR_SIZE);
+					pSeg->valid |= 1UL << first;
+					pSeg->dirty &= ~(1UL << first);
+				}
+			}
+		}
+		return SUCCESS;
+	}
+
+	while (count > 0) {
+		base = sector & ~SEG_MASK;
+		first = sector & SEG_MASK;
+		n = MIN(count, BLKCACHE_SEG_SECTORS - first);
+		mask = sectorMask(first, n);
+
+		pSeg = segFind(pCache, base);
+		if (pSeg == NULL) {
+			pSeg = segNew(pCache, base);
+			if (pSeg == NULL) {
+				return ERROR;
+			}
+		}
+
+		memcpy(pSeg->pData + first * BLKCACHE_SECTOR_SIZE, pSrc, n * BLKCACHE_SECTOR_SIZE);
+		pSeg->valid |= mask;
+		pSeg->dirty |= mask;
+		pSeg->lastUse = ++pCache->stamp;
+		pSrc += n * BLKCACHE_SECTOR_SIZE;
+		sector += n;
+		count -= n;
+	}
+	return SUCCESS;
+}
+
+/* Write back all the cached writes */
+Status BlkCache_Flush(BLKCACHE_T *pCache)
+{
+	BLKCACHE_SEG_T *pSeg;
+	uint32_t i;
+
+	if (pCache->numSegs == 0) {
+		return ERROR;
+	}
+
+	/* Lowest base first, so the card sees the writes in sector order */
+	for (;; ) {
+		pSeg = NULL;
+		for (i = 0; i < pCache->numSegs; i++) {
+			if ((pCache->segs[i].dirty != 0) &&
+				((pSeg == NULL) || (pCache->segs[i].base < pSeg->base))) {
+				pSeg = &pCache->segs[i];
+			}
+		}
+		if (pSeg == NULL) {
+			return SUCCESS;
+		}
+		if (segWriteBack(pCache, pSeg) != SUCCESS) {
+			return ERROR;
+		}
+	}
+}
+
+/* Drop all the cached sectors */
+void BlkCache_Invalidate(BLKCACHE_T *pCache)
+{
+	uint32_t i;
+
+	for (i = 0; i < pCache->numSegs; i++) {
+		pCache->segs[i].base = BLKCACHE_NO_SECTOR;
+		pCache->segs[i].valid = 0;
+		pCache->segs[i].dirty = 0;
+	}
+	pCache->nextSector = BLKCACHE_NO_SECTOR;
+}
@@ -242,6 +242,50 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 
 #endif /* configUSE_TIMERS */
 
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOTS
+	#define configTIMER_WHEEL_SLOTS 32
+#endif
+
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+	#define configUSE_TIMER_DIRECT_COMMANDS 0
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOTS
+	#define configDELAYED_TASK_WHEEL_SLOTS 32
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SCAN_SLOTS
+	#define configDELAYED_TASK_WHEEL_SCAN_SLOTS 8
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+	#define configUSE_EDF_SCHEDULING 0
+#endif
+
+#ifndef configEDF_PRIORITY
+	#define configEDF_PRIORITY 1
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION 0
+#endif
+
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+	#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#endif
+
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, otherwise no kernel objects can be created.
+#endif
+
 #ifndef INCLUDE_xTaskGetSchedulerState
 	#define INCLUDE_xTaskGetSchedulerState 0
 #endif
@@ -468,6 +512,10 @@ typedef portBASE_TYPE (*pdTASK_HOOK_CODE)( void * );
 	#define traceTASK_DELAY_UNTIL()
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+	#define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY
 	#define traceTASK_DELAY()
 #endif
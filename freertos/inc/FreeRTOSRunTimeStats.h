@@ -0,0 +1,104 @@
+/*
+ * @brief FreeRTOS run time statistics support
+ *
+ * @note
+ * Per-task run time statistics are collected by the kernel when
+ * configGENERATE_RUN_TIME_STATS is 1. The time base is a free-running 32-bit
+ * LPC timer selected with configRUN_TIME_STATS_TIMER in FreeRTOSConfig.h.
+ *
+ * A snapshot of every task is taken with the kernel uxTaskGetSystemState()
+ * into a caller supplied xTaskStatusType array. The functions below encode
+ * such a snapshot into a compact binary frame, without any printf style
+ * formatting, so that it can be streamed over a UART and decoded on a host.
+ *
+ * Frame layout, all fields little endian:
+ * - header, 8 bytes: 'R' 'T', version, task count, total run time (u32)
+ * - one 20 byte record per task: task number (u8), state (u8),
+ *   current priority (u8), base priority (u8), run time (u32),
+ *   stack high water mark in words (u16), task name (10 bytes, 0 padded)
+ * - trailer, 2 bytes: Fletcher-16 checksum of header and records
+ */
+
+#ifndef __FREERTOSRUNTIMESTATS_H_
+#define __FREERTOSRUNTIMESTATS_H_
+
+/** @ingroup FreeRTOS_COMMON
+ * @{
+ */
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+/** Frame format version */
+#define RTS_FRAME_VERSION       1
+
+/** Size of the frame header in bytes */
+#define RTS_HEADER_SIZE         8
+
+/** Size of one encoded task record in bytes */
+#define RTS_RECORD_SIZE         20
+
+/** Size of the frame trailer in bytes */
+#define RTS_TRAILER_SIZE        2
+
+/** Number of task name characters kept in a record */
+#define RTS_NAME_LEN            10
+
+/** Size of a complete frame for a given number of tasks */
+#define RTS_FRAME_SIZE(tasks)   (RTS_HEADER_SIZE + ((tasks) * RTS_RECORD_SIZE) + RTS_TRAILER_SIZE)
+
+/**
+ * @brief	Start the free-running run time stats timer
+ * @return	Nothing
+ * @note	Called by the kernel through portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
+ * when the scheduler starts. The timer counts at configRUN_TIME_STATS_CLOCK_HZ
+ * and is read directly by portGET_RUN_TIME_COUNTER_VALUE.
+ */
+void vConfigureTimerForRunTimeStats(void);
+
+/**
+ * @brief	Encode a task snapshot into a binary frame
+ * @param	pucBuffer			: Destination buffer
+ * @param	ulBufferSize		: Size of the destination buffer in bytes
+ * @param	pxTaskStatusArray	: Snapshot filled by uxTaskGetSystemState()
+ * @param	uxArraySize			: Number of valid entries in pxTaskStatusArray
+ * @param	ulTotalRunTime		: Total run time returned by uxTaskGetSystemState()
+ * @return	Number of bytes written, or 0 if the buffer is too small
+ * @note	The buffer must hold RTS_FRAME_SIZE(uxArraySize) bytes.
+ */
+unsigned long ulRunTimeStatsEncode(unsigned char *pucBuffer, unsigned long ulBufferSize,
+								   const xTaskStatusType *pxTaskStatusArray,
+								   unsigned portBASE_TYPE uxArraySize, unsigned long ulTotalRunTime);
+
+/**
+ * @brief	Stream a task snapshot as a binary frame over a UART
+ * @param	pUART				: UART to send the frame on
+ * @param	pxTaskStatusArray	: Snapshot filled by uxTaskGetSystemState()
+ * @param	uxArraySize			: Number of valid entries in pxTaskStatusArray
+ * @param	ulTotalRunTime		: Total run time returned by uxTaskGetSystemState()
+ * @return	Nothing
+ * @note	Records are encoded and sent one at a time so no frame sized
+ * buffer is needed. Uses blocking UART transmit.
+ */
+void vRunTimeStatsSendUART(LPC_USART_T *pUART, const xTaskStatusType *pxTaskStatusArray,
+						   unsigned portBASE_TYPE uxArraySize, unsigned long ulTotalRunTime);
+
+/**
+ * @brief	Time the run time accounting sequence of a context switch in a loop
+ * @return	Average number of core clock cycles of one pass of the sequence
+ * @note	Runs the counter read and accumulate sequence that
+ * vTaskSwitchContext() adds for the run time stats in a loop, outside any
+ * context switch, and times it with the DWT cycle counter. It is an
+ * estimate of what the stats add to each switch, not a measurement of a
+ * switch: inside vTaskSwitchContext() the sequence also loads and stores
+ * its variables in memory and in the current TCB. Most of the cost is the
+ * timer TC read over the APB bus.
+ */
+unsigned long ulRunTimeStatsAccountingCycles(void);
+
+#endif /* configGENERATE_RUN_TIME_STATS == 1 */
+
+/**
+ * @}
+ */
+
+#endif /* __FREERTOSRUNTIMESTATS_H_ */
@@ -0,0 +1,303 @@
+/*
+ * @brief FreeRTOS binary trace recorder
+ *
+ * @note
+ * Included at the end of FreeRTOSConfig.h when configUSE_TRACE_RECORDER is
+ * 1. It maps the kernel trace macros onto fixed-size records written into
+ * an in-RAM circular buffer. A slot is claimed by incrementing the write
+ * count with an LDREX/STREX loop, so interrupts are never masked, not even
+ * those above configMAX_SYSCALL_INTERRUPT_PRIORITY, and a writer only
+ * retries when an interrupt that also records lands inside its claim.
+ *
+ * Task names are kept in a table of their own next to the buffer, so they
+ * survive the buffer wrapping. The whole recorder object (xTraceRecorder)
+ * is self describing and can be dumped from a debugger as a raw binary image, for example with
+ * "dump binary value trace.bin xTraceRecorder" in GDB, and turned into a
+ * Chrome trace / Perfetto JSON timeline with tools/freertos_trace_decode.c.
+ */
+
+#ifndef __FREERTOSTRACE_H_
+#define __FREERTOSTRACE_H_
+
+#include <stdint.h>
+
+/** @ingroup FreeRTOS_COMMON
+ * @{
+ */
+
+#if configUSE_TRACE_RECORDER == 1
+
+/** Number of records in the circular buffer, must be a power of 2 */
+#ifndef configTRACE_RECORDER_RECORDS
+#define configTRACE_RECORDER_RECORDS    256
+#endif
+
+#if (configTRACE_RECORDER_RECORDS & (configTRACE_RECORDER_RECORDS - 1)) != 0
+#error configTRACE_RECORDER_RECORDS must be a power of 2
+#endif
+
+/** Number of task names kept, the oldest is replaced once it is full */
+#ifndef configTRACE_RECORDER_TASKS
+#define configTRACE_RECORDER_TASKS      16
+#endif
+
+/** Set to 1 to also record every tick interrupt */
+#ifndef configTRACE_RECORDER_TICKS
+#define configTRACE_RECORDER_TICKS      0
+#endif
+
+/** Record timestamp source, the DWT cycle counter by default */
+#ifndef configTRACE_TIMESTAMP
+#define configTRACE_TIMESTAMP()         (DWT->CYCCNT)
+#endif
+
+/** "FRTR" in little endian, identifies a recorder dump */
+#define TRACE_MAGIC                     0x52545246UL
+
+/** Recorder dump format version */
+#define TRACE_VERSION                   2
+
+/** Bytes kept of a task name, configMAX_TASK_NAME_LEN rounded up to a word */
+#define TRACE_NAME_LEN                  ((configMAX_TASK_NAME_LEN + 3) & ~3)
+
+/**
+ * @brief Trace event identifiers
+ */
+typedef enum {
+	TRACE_EV_NONE = 0,
+	TRACE_EV_TASK_SWITCHED_IN,			/*!< object = task, info = priority */
+	TRACE_EV_TASK_SWITCHED_OUT,			/*!< object = task, info = priority */
+	TRACE_EV_TASK_CREATE,				/*!< object = task, info = priority */
+	TRACE_EV_TASK_DELETE,				/*!< object = task */
+	TRACE_EV_TASK_DELAY,				/*!< object = task */
+	TRACE_EV_TASK_DELAY_UNTIL,			/*!< object = task */
+	TRACE_EV_TASK_SUSPEND,				/*!< object = task */
+	TRACE_EV_TASK_RESUME,				/*!< object = task */
+	TRACE_EV_TASK_RESUME_FROM_ISR,		/*!< object = task */
+	TRACE_EV_TASK_PRIORITY_SET,			/*!< object = task, info = new priority */
+	TRACE_EV_TASK_PRIORITY_INHERIT,		/*!< object = mutex holder, info = new priority */
+	TRACE_EV_TASK_PRIORITY_DISINHERIT,	/*!< object = mutex holder, info = new priority */
+	TRACE_EV_TASK_READY,				/*!< object = task, info = priority */
+	TRACE_EV_TICK,						/*!< object = tick count */
+	TRACE_EV_TICK_STEP,					/*!< object = ticks stepped after tickless idle */
+	TRACE_EV_LOW_POWER_BEGIN,
+	TRACE_EV_LOW_POWER_END,
+	TRACE_EV_QUEUE_CREATE,				/*!< object = queue, info = length */
+	TRACE_EV_MUTEX_CREATE,				/*!< object = mutex */
+	TRACE_EV_QUEUE_DELETE,				/*!< object = queue */
+	TRACE_EV_QUEUE_SEND,				/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_SEND_FAILED,			/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_SEND_FROM_ISR,		/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_SEND_FROM_ISR_FAILED,/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_RECEIVE,				/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_RECEIVE_FAILED,		/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_RECEIVE_FROM_ISR,	/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_RECEIVE_FROM_ISR_FAILED,/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_PEEK,				/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_BLOCK_SEND,			/*!< object = queue, info = items waiting */
+	TRACE_EV_QUEUE_BLOCK_RECEIVE,		/*!< object = queue, info = items waiting */
+	TRACE_EV_MUTEX_GIVE_RECURSIVE,		/*!< object = mutex, info = 1 if failed */
+	TRACE_EV_MUTEX_TAKE_RECURSIVE,		/*!< object = mutex, info = 1 if failed */
+	TRACE_EV_TIMER_CREATE,				/*!< object = timer */
+	TRACE_EV_TIMER_COMMAND_SEND,		/*!< object = timer, info = command */
+	TRACE_EV_TIMER_COMMAND_RECEIVED,	/*!< object = timer, info = command */
+	TRACE_EV_TIMER_EXPIRED,				/*!< object = timer */
+	TRACE_EV_USER = 0x8000				/*!< First identifier free for application events */
+} TRACE_EVENT_T;
+
+/**
+ * @brief Trace record, 12 bytes
+ */
+typedef struct {
+	uint32_t timestamp;		/*!< configTRACE_TIMESTAMP() when the record was claimed */
+	uint32_t object;		/*!< Kernel object handle or event specific value */
+	uint16_t event;			/*!< TRACE_EVENT_T identifier */
+	uint16_t info;			/*!< Event specific value */
+} TRACE_RECORD_T;
+
+/**
+ * @brief Task name table entry
+ */
+typedef struct {
+	uint32_t task;					/*!< Task handle, 0 for an unused entry */
+	char name[TRACE_NAME_LEN];		/*!< Task name, not terminated when it fills the array */
+} TRACE_TASK_NAME_T;
+
+/**
+ * @brief Trace recorder, dumped as a whole for decoding
+ */
+typedef struct {
+	uint32_t magic;				/*!< TRACE_MAGIC once initialised */
+	uint16_t version;			/*!< TRACE_VERSION */
+	uint16_t recordSize;		/*!< sizeof(TRACE_RECORD_T) */
+	uint32_t capacity;			/*!< Number of records in the buffer */
+	uint32_t timestampHz;		/*!< Timestamp clock rate */
+	volatile uint32_t written;	/*!< Total records claimed, wraps the buffer */
+	uint16_t nameCapacity;		/*!< Number of entries in the name table */
+	uint16_t nameSize;			/*!< sizeof(TRACE_TASK_NAME_T) */
+	uint32_t namesWritten;		/*!< Total names stored, wraps the table */
+	TRACE_RECORD_T records[configTRACE_RECORDER_RECORDS];
+	TRACE_TASK_NAME_T names[configTRACE_RECORDER_TASKS];
+} TRACE_RECORDER_T;
+
+extern TRACE_RECORDER_T xTraceRecorder;
+
+/**
+ * @brief	Initialise the recorder and start the timestamp clock
+ * @return	Nothing
+ * @note	Called automatically when the first task or queue is created.
+ * Calling it again restarts recording with an empty buffer.
+ */
+void vTraceInit(void);
+
+/**
+ * @brief	Record a task creation and store the task name
+ * @param	pvTask		: Task handle
+ * @param	pcName		: Task name
+ * @param	priority	: Task priority
+ * @return	Nothing
+ */
+void vTraceTaskCreate(void *pvTask, const signed char *pcName, uint32_t priority);
+
+/**
+ * @brief	Record a queue, semaphore or mutex creation
+ * @param	event		: TRACE_EV_QUEUE_CREATE or TRACE_EV_MUTEX_CREATE
+ * @param	pvQueue		: Queue handle
+ * @param	length		: Queue length
+ * @return	Nothing
+ */
+void vTraceQueueCreate(uint16_t event, void *pvQueue, uint32_t length);
+
+/**
+ * @brief	Write one trace record
+ * @param	event	: Event identifier
+ * @param	object	: Kernel object handle or event specific value
+ * @param	info	: Event specific value
+ * @return	Nothing
+ * @note	Lock-free and safe to call from any task or interrupt, at any
+ * priority. The timestamp is read between the LDREX and the STREX of the
+ * claim. An exception in between clears the exclusive monitor, so the STREX
+ * fails and the claim is retried with a new timestamp, which keeps records
+ * in timestamp order in the buffer without masking interrupts. A writer
+ * preempted between claiming and filling its slot can only be overwritten if
+ * the whole buffer wraps in the meantime.
+ */
+STATIC INLINE void vTraceRecord(uint16_t event, uint32_t object, uint16_t info)
+{
+	TRACE_RECORD_T *pRecord;
+	uint32_t index, timestamp;
+
+#if defined(__arm__) || defined(__CC_ARM) || defined(__ICCARM__)
+	do {
+		index = __LDREXW(&xTraceRecorder.written);
+		timestamp = configTRACE_TIMESTAMP();
+	} while (__STREXW(index + 1, &xTraceRecorder.written) != 0);
+#else
+	/* Host build, the same claim with a compare and swap, which fails if
+	   another writer claimed the slot after the timestamp was read */
+	index = __atomic_load_n(&xTraceRecorder.written, __ATOMIC_RELAXED);
+	do {
+		timestamp = configTRACE_TIMESTAMP();
+	} while (!__atomic_compare_exchange_n(&xTraceRecorder.written, &index, index + 1, false,
+										  __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+#endif
+
+	pRecord = &xTraceRecorder.records[index & (configTRACE_RECORDER_RECORDS - 1)];
+	pRecord->timestamp = timestamp;
+	pRecord->object = object;
+	pRecord->event = event;
+	pRecord->info = info;
+}
+
+/* Kernel trace macro mapping */
+#define traceTASK_SWITCHED_IN() \
+	vTraceRecord(TRACE_EV_TASK_SWITCHED_IN, (uint32_t) pxCurrentTCB, (uint16_t) pxCurrentTCB->uxPriority)
+#define traceTASK_SWITCHED_OUT() \
+	vTraceRecord(TRACE_EV_TASK_SWITCHED_OUT, (uint32_t) pxCurrentTCB, (uint16_t) pxCurrentTCB->uxPriority)
+#define traceTASK_CREATE(pxNewTCB) \
+	vTraceTaskCreate((pxNewTCB), (pxNewTCB)->pcTaskName, (pxNewTCB)->uxPriority)
+#define traceTASK_DELETE(pxTaskToDelete) \
+	vTraceRecord(TRACE_EV_TASK_DELETE, (uint32_t) (pxTaskToDelete), 0)
+#define traceTASK_DELAY() \
+	vTraceRecord(TRACE_EV_TASK_DELAY, (uint32_t) pxCurrentTCB, 0)
+#define traceTASK_DELAY_UNTIL() \
+	vTraceRecord(TRACE_EV_TASK_DELAY_UNTIL, (uint32_t) pxCurrentTCB, 0)
+#define traceTASK_SUSPEND(pxTaskToSuspend) \
+	vTraceRecord(TRACE_EV_TASK_SUSPEND, (uint32_t) (pxTaskToSuspend), 0)
+#define traceTASK_RESUME(pxTaskToResume) \
+	vTraceRecord(TRACE_EV_TASK_RESUME, (uint32_t) (pxTaskToResume), 0)
+#define traceTASK_RESUME_FROM_ISR(pxTaskToResume) \
+	vTraceRecord(TRACE_EV_TASK_RESUME_FROM_ISR, (uint32_t) (pxTaskToResume), 0)
+#define traceTASK_PRIORITY_SET(pxTask, uxNewPriority) \
+	vTraceRecord(TRACE_EV_TASK_PRIORITY_SET, (uint32_t) (pxTask), (uint16_t) (uxNewPriority))
+#define traceTASK_PRIORITY_INHERIT(pxTCBOfMutexHolder, uxInheritedPriority) \
+	vTraceRecord(TRACE_EV_TASK_PRIORITY_INHERIT, (uint32_t) (pxTCBOfMutexHolder), (uint16_t) (uxInheritedPriority))
+#define traceTASK_PRIORITY_DISINHERIT(pxTCBOfMutexHolder, uxOriginalPriority) \
+	vTraceRecord(TRACE_EV_TASK_PRIORITY_DISINHERIT, (uint32_t) (pxTCBOfMutexHolder), (uint16_t) (uxOriginalPriority))
+/* Used without a trailing semicolon by prvAddTaskToReadyList() */
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+	vTraceRecord(TRACE_EV_TASK_READY, (uint32_t) (pxTCB), (uint16_t) (pxTCB)->uxPriority);
+#if configTRACE_RECORDER_TICKS == 1
+#define traceTASK_INCREMENT_TICK(xTickCount) \
+	vTraceRecord(TRACE_EV_TICK, (uint32_t) (xTickCount), 0)
+#endif
+#define traceINCREASE_TICK_COUNT(xTicksToJump) \
+	vTraceRecord(TRACE_EV_TICK_STEP, (uint32_t) (xTicksToJump), 0)
+#define traceLOW_POWER_IDLE_BEGIN() \
+	vTraceRecord(TRACE_EV_LOW_POWER_BEGIN, 0, 0)
+#define traceLOW_POWER_IDLE_END() \
+	vTraceRecord(TRACE_EV_LOW_POWER_END, 0, 0)
+
+#define traceQUEUE_CREATE(pxNewQueue) \
+	vTraceQueueCreate(TRACE_EV_QUEUE_CREATE, (pxNewQueue), (pxNewQueue)->uxLength)
+#define traceCREATE_MUTEX(pxNewQueue) \
+	vTraceQueueCreate(TRACE_EV_MUTEX_CREATE, (pxNewQueue), 1)
+#define traceQUEUE_DELETE(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_DELETE, (uint32_t) (pxQueue), 0)
+#define traceQUEUE_SEND(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_SEND, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FAILED(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_SEND_FAILED, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_SEND_FROM_ISR, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_SEND_FROM_ISR_FAILED(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_SEND_FROM_ISR_FAILED, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_RECEIVE, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FAILED(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_RECEIVE_FAILED, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_RECEIVE_FROM_ISR, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_RECEIVE_FROM_ISR_FAILED, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceQUEUE_PEEK(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_PEEK, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_BLOCK_SEND, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+	vTraceRecord(TRACE_EV_QUEUE_BLOCK_RECEIVE, (uint32_t) (pxQueue), (uint16_t) (pxQueue)->uxMessagesWaiting)
+#define traceGIVE_MUTEX_RECURSIVE(pxMutex) \
+	vTraceRecord(TRACE_EV_MUTEX_GIVE_RECURSIVE, (uint32_t) (pxMutex), 0)
+#define traceGIVE_MUTEX_RECURSIVE_FAILED(pxMutex) \
+	vTraceRecord(TRACE_EV_MUTEX_GIVE_RECURSIVE, (uint32_t) (pxMutex), 1)
+#define traceTAKE_MUTEX_RECURSIVE(pxMutex) \
+	vTraceRecord(TRACE_EV_MUTEX_TAKE_RECURSIVE, (uint32_t) (pxMutex), 0)
+#define traceTAKE_MUTEX_RECURSIVE_FAILED(pxMutex) \
+	vTraceRecord(TRACE_EV_MUTEX_TAKE_RECURSIVE, (uint32_t) (pxMutex), 1)
+
+#define traceTIMER_CREATE(pxNewTimer) \
+	vTraceRecord(TRACE_EV_TIMER_CREATE, (uint32_t) (pxNewTimer), 0)
+#define traceTIMER_COMMAND_SEND(xTimer, xMessageID, xMessageValueValue, xReturn) \
+	vTraceRecord(TRACE_EV_TIMER_COMMAND_SEND, (uint32_t) (xTimer), (uint16_t) (xMessageID))
+#define traceTIMER_COMMAND_RECEIVED(pxTimer, xMessageID, xMessageValue) \
+	vTraceRecord(TRACE_EV_TIMER_COMMAND_RECEIVED, (uint32_t) (pxTimer), (uint16_t) (xMessageID))
+#define traceTIMER_EXPIRED(pxTimer) \
+	vTraceRecord(TRACE_EV_TIMER_EXPIRED, (uint32_t) (pxTimer), 0)
+
+#endif /* configUSE_TRACE_RECORDER == 1 */
+
+/**
+ * @}
+ */
+
+#endif /* __FREERTOSTRACE_H_ */
@@ -131,22 +131,26 @@
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
+/* The stack is filled with tskSTACK_FILL_BYTE when the task is created.  Method
+2 compares the 20 bytes at the far end of the stack, five 32-bit words, with the
+fill pattern a word at a time, which is a handful of loads in the context switch
+rather than a call to memcmp().  The fill word is as wide as an unsigned long,
+so a host build with 64-bit longs checks 40 bytes. */
+#define taskSTACK_FILL_WORD		( ( unsigned long ) tskSTACK_FILL_BYTE * ( ~0UL / 0xffUL ) )
+
 #if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) )
 
-	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
-	{																																			\
-	static const unsigned char ucExpectedStackBytes[] = {	tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE };	\
-																																				\
-																																				\
-		/* Has the extremity of the task stack ever been written over? */																		\
-		if( memcmp( ( void * ) pxCurrentTCB->pxStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )					\
-		{																																		\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );											\
-		}																																		\
+	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																\
+	{																											\
+	const unsigned long * const pulStack = ( const unsigned long * ) pxCurrentTCB->pxStack;						\
+																												\
+		/* Has the extremity of the task stack ever been written over? */										\
+		if( ( pulStack[ 0 ] != taskSTACK_FILL_WORD ) || ( pulStack[ 1 ] != taskSTACK_FILL_WORD ) ||				\
+			( pulStack[ 2 ] != taskSTACK_FILL_WORD ) || ( pulStack[ 3 ] != taskSTACK_FILL_WORD ) ||				\
+			( pulStack[ 4 ] != taskSTACK_FILL_WORD ) )															\
+		{																										\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );			\
+		}																										\
 	}
 
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
@@ -154,23 +158,17 @@
 
 #if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) )
 
-	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																								\
-	{																																			\
-	char *pcEndOfStack = ( char * ) pxCurrentTCB->pxEndOfStack;																					\
-	static const unsigned char ucExpectedStackBytes[] = {	tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE,		\
-															tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE, tskSTACK_FILL_BYTE };	\
-																																				\
-																																				\
-		pcEndOfStack -= sizeof( ucExpectedStackBytes );																							\
-																																				\
-		/* Has the extremity of the task stack ever been written over? */																		\
-		if( memcmp( ( void * ) pcEndOfStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )							\
-		{																																		\
-			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );											\
-		}																																		\
+	#define taskSECOND_CHECK_FOR_STACK_OVERFLOW()																\
+	{																											\
+	const unsigned long * const pulEndOfStack = ( const unsigned long * ) pxCurrentTCB->pxEndOfStack;			\
+																												\
+		/* Has the extremity of the task stack ever been written over? */										\
+		if( ( pulEndOfStack[ -1 ] != taskSTACK_FILL_WORD ) || ( pulEndOfStack[ -2 ] != taskSTACK_FILL_WORD ) ||	\
+			( pulEndOfStack[ -3 ] != taskSTACK_FILL_WORD ) || ( pulEndOfStack[ -4 ] != taskSTACK_FILL_WORD ) ||	\
+			( pulEndOfStack[ -5 ] != taskSTACK_FILL_WORD ) )													\
+		{																										\
+			vApplicationStackOverflowHook( ( xTaskHandle ) pxCurrentTCB, pxCurrentTCB->pcTaskName );			\
+		}																										\
 	}
 
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
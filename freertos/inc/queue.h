@@ -71,6 +71,10 @@
 	#error "include FreeRTOS.h" must appear in source files before "include queue.h"
 #endif
 
+/*lint -e537 This headers are only multiply included if the application code
+happens to also be including list.h.  It is needed here for xStaticQueue. */
+#include "list.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -110,6 +114,43 @@ typedef void * xQueueSetMemberHandle;
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( unsigned char ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( unsigned char ) 4U )
 
+/**
+ * Memory in which a queue, semaphore or mutex is created by
+ * xQueueCreateStatic() or one of the xSemaphoreCreate...Static() macros.
+ *
+ * The members mirror the private queue structure in queue.c so the size is
+ * correct, but they must not be accessed by the application.  The create
+ * functions assert that the two sizes match.
+ */
+typedef struct xSTATIC_QUEUE
+{
+	void *pvDummy1[ 3 ];
+
+	union
+	{
+		void *pvDummy2;
+		unsigned portBASE_TYPE uxDummy2;
+	} u;
+
+	xList xDummy3[ 2 ];
+	volatile unsigned portBASE_TYPE uxDummy4;
+	unsigned portBASE_TYPE uxDummy5[ 2 ];
+	volatile signed portBASE_TYPE xDummy6[ 2 ];
+
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned char ucDummy7[ 2 ];
+	#endif
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+		void *pvDummy8;
+	#endif
+
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char ucDummy9;
+	#endif
+
+} xStaticQueue;
+
 /**
  * queue. h
  * <pre>
@@ -168,6 +209,57 @@ typedef void * xQueueSetMemberHandle;
  */
 #define xQueueCreate( uxQueueLength, uxItemSize ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE )
 
+/**
+ * queue. h
+ * <pre>
+ xQueueHandle xQueueCreateStatic(
+							  unsigned portBASE_TYPE uxQueueLength,
+							  unsigned portBASE_TYPE uxItemSize,
+							  unsigned char *pucQueueStorage,
+							  xStaticQueue *pxQueueBuffer
+						  );
+ * </pre>
+ *
+ * Creates a new queue instance in memory provided by the application, so the
+ * heap is not used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ *
+ * @param pucQueueStorage An array of at least uxQueueLength * uxItemSize
+ * bytes into which items are copied.  Can be NULL if uxItemSize is 0.
+ *
+ * @param pxQueueBuffer An xStaticQueue variable that holds the queue
+ * structure.  It must remain in scope for as long as the queue is used.
+ *
+ * @return The handle of the queue, or NULL if pxQueueBuffer is NULL.
+ *
+ * Example usage:
+   <pre>
+ #define QUEUE_LENGTH	10
+ #define ITEM_SIZE		sizeof( unsigned long )
+
+ static xStaticQueue xQueueBuffer;
+ static unsigned char ucQueueStorage[ QUEUE_LENGTH * ITEM_SIZE ];
+
+ void vATask( void *pvParameters )
+ {
+ xQueueHandle xQueue;
+
+	// Create a queue capable of containing 10 unsigned long values, without
+	// touching the heap.
+	xQueue = xQueueCreateStatic( QUEUE_LENGTH, ITEM_SIZE, ucQueueStorage, &xQueueBuffer );
+
+	// ... Rest of task code.
+ }
+ </pre>
+ * \defgroup xQueueCreateStatic xQueueCreateStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+
 /**
  * queue. h
  * <pre>
@@ -1474,6 +1566,8 @@ signed portBASE_TYPE xQueueCRReceive( xQueueHandle xQueue, void *pvBuffer, portT
  */
 xQueueHandle xQueueCreateMutex( unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 xQueueHandle xQueueCreateCountingSemaphore( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateMutexStatic( unsigned char ucQueueType, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
+xQueueHandle xQueueCreateCountingSemaphoreStatic( unsigned portBASE_TYPE uxCountValue, unsigned portBASE_TYPE uxInitialCount, xStaticQueue *pxStaticQueue ) PRIVILEGED_FUNCTION;
 void* xQueueGetMutexHolder( xQueueHandle xSemaphore ) PRIVILEGED_FUNCTION;
 
 /*
@@ -1535,6 +1629,12 @@ portBASE_TYPE xQueueGiveMutexRecursive( xQueueHandle pxMutex ) PRIVILEGED_FUNCTI
  */
 xQueueHandle xQueueGenericCreate( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
 
+/*
+ * Generic version of the static queue creation function, which is in turn
+ * called by xQueueCreateStatic() and the static semaphore macros.
+ */
+xQueueHandle xQueueGenericCreateStatic( unsigned portBASE_TYPE uxQueueLength, unsigned portBASE_TYPE uxItemSize, unsigned char *pucQueueStorage, xStaticQueue *pxStaticQueue, unsigned char ucQueueType ) PRIVILEGED_FUNCTION;
+
 /*
  * Queue sets provide a mechanism to allow a task to block (pend) on a read
  * operation from multiple queues or semaphores simultaneously.
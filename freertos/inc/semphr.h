@@ -74,6 +74,11 @@
 
 typedef xQueueHandle xSemaphoreHandle;
 
+/* Memory in which a semaphore or mutex is created by one of the
+xSemaphoreCreate...Static() macros.  A semaphore is a queue, so this is the
+same as xStaticQueue. */
+typedef xStaticQueue xStaticSemaphore;
+
 #define semBINARY_SEMAPHORE_QUEUE_LENGTH	( ( unsigned char ) 1U )
 #define semSEMAPHORE_QUEUE_ITEM_LENGTH		( ( unsigned char ) 0U )
 #define semGIVE_BLOCK_TIME					( ( portTickType ) 0U )
@@ -126,6 +131,42 @@ typedef xQueueHandle xSemaphoreHandle;
 		}																																		\
 	}
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateBinaryStatic( xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * Creates a binary semaphore in memory provided by the application, so the
+ * heap is not used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this macro to be available.
+ *
+ * Unlike vSemaphoreCreateBinary() the semaphore is created empty, so it must
+ * be given before it can first be taken.  This suits the common case of an
+ * interrupt signalling a task.
+ *
+ * @param pxSemaphoreBuffer An xStaticSemaphore variable that holds the
+ * semaphore.  It must remain in scope for as long as the semaphore is used.
+ *
+ * @return The handle of the semaphore, or NULL if pxSemaphoreBuffer is NULL.
+ *
+ * Example usage:
+ <pre>
+ static xStaticSemaphore xSemaphoreBuffer;
+
+ void vATask( void * pvParameters )
+ {
+ xSemaphoreHandle xSemaphore;
+
+    xSemaphore = xSemaphoreCreateBinaryStatic( &xSemaphoreBuffer );
+
+    // The semaphore is empty; an interrupt gives it to wake this task.
+    xSemaphoreTake( xSemaphore, portMAX_DELAY );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateBinaryStatic xSemaphoreCreateBinaryStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateBinaryStatic( pxSemaphoreBuffer ) xQueueGenericCreateStatic( ( unsigned portBASE_TYPE ) 1, semSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, ( pxSemaphoreBuffer ), queueQUEUE_TYPE_BINARY_SEMAPHORE )
+
 /**
  * semphr. h
  * <pre>xSemaphoreTake( 
@@ -634,6 +675,19 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateMutex() xQueueCreateMutex( queueQUEUE_TYPE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateMutex(), but the mutex is created in pxMutexBuffer
+ * rather than allocated from the heap.  configSUPPORT_STATIC_ALLOCATION must
+ * be set to 1 in FreeRTOSConfig.h for this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateMutexStatic xSemaphoreCreateMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
+
 
 /**
  * semphr. h
@@ -689,6 +743,20 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateRecursiveMutex() xQueueCreateMutex( queueQUEUE_TYPE_RECURSIVE_MUTEX )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateRecursiveMutexStatic( xStaticSemaphore *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateRecursiveMutex(), but the mutex is created in
+ * pxMutexBuffer rather than allocated from the heap.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateRecursiveMutexStatic xSemaphoreCreateRecursiveMutexStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateRecursiveMutexStatic( pxMutexBuffer ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxMutexBuffer ) )
+
 /**
  * semphr. h
  * <pre>xSemaphoreHandle xSemaphoreCreateCounting( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount )</pre>
@@ -752,6 +820,20 @@ typedef xQueueHandle xSemaphoreHandle;
  */
 #define xSemaphoreCreateCounting( uxMaxCount, uxInitialCount ) xQueueCreateCountingSemaphore( ( uxMaxCount ), ( uxInitialCount ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreHandle xSemaphoreCreateCountingStatic( unsigned portBASE_TYPE uxMaxCount, unsigned portBASE_TYPE uxInitialCount, xStaticSemaphore *pxSemaphoreBuffer )</pre>
+ *
+ * As xSemaphoreCreateCounting(), but the semaphore is created in
+ * pxSemaphoreBuffer rather than allocated from the heap.
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * \defgroup xSemaphoreCreateCountingStatic xSemaphoreCreateCountingStatic
+ * \ingroup Semaphores
+ */
+#define xSemaphoreCreateCountingStatic( uxMaxCount, uxInitialCount, pxSemaphoreBuffer ) xQueueCreateCountingSemaphoreStatic( ( uxMaxCount ), ( uxInitialCount ), ( pxSemaphoreBuffer ) )
+
 /**
  * semphr. h
  * <pre>void vSemaphoreDelete( xSemaphoreHandle xSemaphore );</pre>
@@ -152,6 +152,55 @@ typedef struct xTASK_STATUS
 	unsigned short usStackHighWaterMark;		/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } xTaskStatusType;
 
+/*
+ * Storage for a task created by xTaskCreateStatic().  It has the same size and
+ * alignment as the task control block, which is private to tasks.c, so the
+ * application can allocate task control blocks at compile time.  The members
+ * must not be accessed.
+ */
+typedef struct xSTATIC_TASK
+{
+	void *pxDummy1;
+	#if ( portUSING_MPU_WRAPPERS == 1 )
+		xMPU_SETTINGS xDummy2;
+	#endif
+	xListItem xDummy3[ 2 ];
+	unsigned portBASE_TYPE uxDummy4;
+	void *pxDummy5;
+	signed char ucDummy6[ configMAX_TASK_NAME_LEN ];
+	#if ( portSTACK_GROWTH > 0 )
+		void *pxDummy7;
+	#endif
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		unsigned portBASE_TYPE uxDummy8;
+	#endif
+	#if ( configUSE_TRACE_FACILITY == 1 )
+		unsigned portBASE_TYPE uxDummy9[ 2 ];
+	#endif
+	#if ( configUSE_MUTEXES == 1 )
+		unsigned portBASE_TYPE uxDummy10;
+	#endif
+	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+		void *pxDummy11;
+	#endif
+	#if ( configGENERATE_RUN_TIME_STATS == 1 )
+		unsigned long ulDummy12;
+	#endif
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		portTickType xDummy13[ 4 ];
+		unsigned portBASE_TYPE uxDummy14;
+	#endif
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+		unsigned long long ullDummy15;
+	#endif
+	#if ( configUSE_NEWLIB_REENTRANT == 1 )
+		struct _reent xDummy16;
+	#endif
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char ucDummy17;
+	#endif
+} xStaticTask;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -313,6 +362,68 @@ typedef enum
  */
 #define xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask ) xTaskGenericCreate( ( pvTaskCode ), ( pcName ), ( usStackDepth ), ( pvParameters ), ( uxPriority ), ( pxCreatedTask ), ( NULL ), ( NULL ) )
 
+/**
+ * task. h
+ *<pre>
+ xTaskHandle xTaskCreateStatic(
+							  pdTASK_CODE pvTaskCode,
+							  const signed char * const pcName,
+							  unsigned short usStackDepth,
+							  void *pvParameters,
+							  unsigned portBASE_TYPE uxPriority,
+							  portSTACK_TYPE *puxStackBuffer,
+							  xStaticTask *pxTaskBuffer
+						  );</pre>
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * Create a new task and add it to the list of tasks that are ready to run,
+ * exactly as xTaskCreate(), but using memory provided by the caller instead of
+ * memory allocated from the FreeRTOS heap.  The memory is normally declared
+ * static, so the linker checks that it fits in RAM.
+ *
+ * @param pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority As
+ * xTaskCreate().
+ *
+ * @param puxStackBuffer Must point to an array of at least usStackDepth
+ * portSTACK_TYPE variables, which is used as the stack of the task.
+ *
+ * @param pxTaskBuffer Must point to an xStaticTask variable, which is used to
+ * hold the task control block of the task.
+ *
+ * @return The handle of the created task.  NULL is only returned if
+ * puxStackBuffer or pxTaskBuffer is NULL.
+ *
+ * Example usage:
+   <pre>
+ #define STACK_SIZE 200
+
+ // The stack and task control block of the task.
+ static portSTACK_TYPE xStack[ STACK_SIZE ];
+ static xStaticTask xTaskBuffer;
+
+ void vOtherFunction( void )
+ {
+ xTaskHandle xHandle;
+
+	 // Create the task without using any heap memory.
+	 xHandle = xTaskCreateStatic( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, xStack, &xTaskBuffer );
+ }
+   </pre>
+ * \defgroup xTaskCreateStatic xTaskCreateStatic
+ * \ingroup Tasks
+ */
+xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is 1 the idle task is created with
+ * xTaskCreateStatic(), and the application must provide this function to
+ * supply its task control block and stack.  The stack size is in words, as
+ * the usStackDepth parameter of xTaskCreate().
+ */
+void vApplicationGetIdleTaskMemory( xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer, unsigned short *pusIdleTaskStackSize );
+
 /**
  * task. h
  *<pre>
@@ -584,6 +695,95 @@ void vTaskDelay( portTickType xTicksToDelay ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelayUntil( portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * <pre>signed portBASE_TYPE xTaskCreatePeriodic( pdTASK_CODE pvTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, portTickType xPeriod, portTickType xRelativeDeadline, xTaskHandle *pvCreatedTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Create a periodic task that is scheduled earliest deadline first.  The task
+ * is created at priority configEDF_PRIORITY.  Tasks at that priority are not
+ * run in turn but in order of their absolute deadline, the task whose deadline
+ * is nearest running first.  Tasks at other priorities are scheduled as normal,
+ * so configEDF_PRIORITY should normally be above any task that is not periodic.
+ *
+ * The first job of the task is released when it is created.  Every following
+ * job is released xPeriod ticks after the one before, and must finish within
+ * xRelativeDeadline ticks of its release.  The task ends each job by calling
+ * vTaskWaitForNextPeriod().
+ *
+ * @param pvTaskCode, pcName, usStackDepth, pvParameters, pvCreatedTask As
+ * xTaskCreate().
+ *
+ * @param xPeriod The time between the releases of two jobs, in ticks.
+ *
+ * @param xRelativeDeadline The time each job has to finish after it has been
+ * released, in ticks.  Must not be greater than xPeriod.
+ *
+ * @return pdPASS if the task was successfully created and added to a ready
+ * list, otherwise an error code defined in the file errors. h
+ *
+ * Example usage:
+   <pre>
+ // Sample an input every 20 ticks, within 5 ticks of the sample being due.
+ void vTaskFunction( void * pvParameters )
+ {
+	 for( ;; )
+	 {
+		 // Perform action here.
+
+		 // Wait for the next job to be released.
+		 vTaskWaitForNextPeriod();
+	 }
+ }
+
+ void vOtherFunction( void )
+ {
+	 xTaskCreatePeriodic( vTaskFunction, "SAMPLE", STACK_SIZE, NULL, 20, 5, NULL );
+ }
+   </pre>
+ * \defgroup xTaskCreatePeriodic xTaskCreatePeriodic
+ * \ingroup Tasks
+ */
+signed portBASE_TYPE xTaskCreatePeriodic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, portTickType xPeriod, portTickType xRelativeDeadline, xTaskHandle *pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>void vTaskWaitForNextPeriod( void );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a task created with xTaskCreatePeriodic() when it has finished
+ * its current job.  If the deadline of the job has passed the deadline miss
+ * count of the task is incremented.  The task then blocks until its next job
+ * is released, or returns straight away if that release time has already
+ * passed.
+ *
+ * \defgroup vTaskWaitForNextPeriod vTaskWaitForNextPeriod
+ * \ingroup TaskCtrl
+ */
+void vTaskWaitForNextPeriod( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * <pre>unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask );</pre>
+ *
+ * configUSE_EDF_SCHEDULING must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xTask Handle of the periodic task to be queried.  Passing a NULL
+ * handle queries the calling task.
+ *
+ * @return The number of jobs of xTask that have finished after their
+ * deadline.  A job that is still running is only counted once it finishes.
+ *
+ * \defgroup uxTaskGetDeadlineMisses uxTaskGetDeadlineMisses
+ * \ingroup TaskCtrl
+ */
+unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * <pre>unsigned portBASE_TYPE uxTaskPriorityGet( xTaskHandle xTask );</pre>
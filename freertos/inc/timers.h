@@ -103,6 +103,27 @@ typedef void * xTimerHandle;
 /* Define the prototype to which timer callback functions must conform. */
 typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
 
+/*
+ * Memory in which a timer is created by xTimerCreateStatic().  The members
+ * mirror the private timer structure in timers.c so the size is correct, but
+ * they must not be accessed by the application.  xTimerCreateStatic() asserts
+ * that the two sizes match.
+ */
+typedef struct xSTATIC_TIMER
+{
+	void					*pvDummy1;
+	xListItem				xDummy2;
+	portTickType			xDummy3;
+	unsigned portBASE_TYPE	uxDummy4;
+	void					*pvDummy5;
+	tmrTIMER_CALLBACK		pxDummy6;
+
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char		ucDummy7;
+	#endif
+
+} xStaticTimer;
+
 /**
  * xTimerHandle xTimerCreate( 	const signed char *pcTimerName,
  * 								portTickType xTimerPeriodInTicks,
@@ -233,6 +254,46 @@ typedef void (*tmrTIMER_CALLBACK)( xTimerHandle xTimer );
  */
 xTimerHandle xTimerCreate( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction ) PRIVILEGED_FUNCTION;
 
+/**
+ * xTimerHandle xTimerCreateStatic(	const signed char *pcTimerName,
+ * 									portTickType xTimerPeriodInTicks,
+ * 									unsigned portBASE_TYPE uxAutoReload,
+ * 									void * pvTimerID,
+ * 									tmrTIMER_CALLBACK pxCallbackFunction,
+ * 									xStaticTimer *pxTimerBuffer );
+ *
+ * As xTimerCreate(), but the timer is created in pxTimerBuffer rather than
+ * allocated from the heap.  pxTimerBuffer must remain in scope for as long as
+ * the timer is used.  configSUPPORT_STATIC_ALLOCATION must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * @return The handle of the timer, or NULL if xTimerPeriodInTicks is 0 or
+ * pxTimerBuffer is NULL.
+ *
+ * Example usage:
+ * @verbatim
+ * static xStaticTimer xBacklightTimerBuffer;
+ *
+ * void main( void )
+ * {
+ * xTimerHandle xBacklightTimer;
+ *
+ *     // A one shot timer that never touches the heap.
+ *     xBacklightTimer = xTimerCreateStatic( ( const signed char * ) "Backlight", ( 5000 / portTICK_RATE_MS ), pdFALSE, NULL, vBacklightTimerCallback, &xBacklightTimerBuffer );
+ *
+ *     vTaskStartScheduler();
+ * }
+ * @endverbatim
+ */
+xTimerHandle xTimerCreateStatic( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void * pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * When configSUPPORT_STATIC_ALLOCATION is 1 the timer service task is created
+ * with xTaskCreateStatic(), and the application must provide this function to
+ * supply its task control block and stack.
+ */
+void vApplicationGetTimerTaskMemory( xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer, unsigned short *pusTimerTaskStackSize );
+
 /**
  * void *pvTimerGetTimerID( xTimerHandle xTimer );
  *
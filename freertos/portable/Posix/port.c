@@ -0,0 +1,327 @@
+/*
+ * @brief FreeRTOS port for Linux and other POSIX hosts
+ *
+ * @note
+ * Lets the unmodified kernel and application task code run in a host
+ * process, for unit tests and simulation.  See portmacro.h.
+ *
+ * Each task gets a pthread, created suspended on its own semaphore when the
+ * task is created.  A context switch posts the semaphore of the task the
+ * kernel picked and waits on the semaphore of the task being switched out,
+ * so exactly one task thread runs at a time.  The tick handler runs on the
+ * running task's thread, as a real interrupt would, because only that
+ * thread ever has SIGALRM unblocked.
+ *
+ * A task preempted by the tick while it holds a C library lock, inside
+ * printf() for example, keeps it until it runs again.  Tasks that share
+ * stdio should call it with the scheduler suspended.
+ */
+
+#if defined( FREERTOS_HOST_POSIX )
+
+#include <errno.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*-----------------------------------------------------------*/
+
+/* The host thread behind a task.  It is kept at the top of the task's own
+stack, and pxTopOfStack, the first member of the TCB, points at it. */
+typedef struct xPOSIX_THREAD
+{
+	pthread_t xThread;
+	sem_t xWake;							/*< Posted to let the thread run. */
+	pdTASK_CODE pxCode;
+	void *pvParameters;
+	unsigned portBASE_TYPE uxCriticalNesting;	/*< Saved while the task is switched out. */
+	volatile portBASE_TYPE xDeleted;
+} xPosixThread;
+
+/* Each task maintains its own critical nesting count, saved in its thread
+while it is switched out. */
+static unsigned portBASE_TYPE uxCriticalNesting = 0;
+
+/* Posted by vPortEndScheduler() to let xPortStartScheduler() return. */
+static sem_t xSchedulerEnd;
+
+/* The task that is running. */
+extern void * volatile pxCurrentTCB;
+
+/*
+ * Map a TCB onto its thread.
+ */
+#define portTHREAD_OF( pvTCB )	( *( xPosixThread * volatile * ) ( pvTCB ) )
+
+/*
+ * The start routine of every task thread.
+ */
+static void *prvTaskThread( void *pvParameters );
+
+/*
+ * The tick interrupt.
+ */
+static void prvTickHandler( int iSignal );
+
+/*
+ * Run the thread of the task now in pxCurrentTCB, and suspend the calling
+ * thread, which belongs to pxThisThread, until it is switched back in.
+ */
+static void prvSwitchThread( xPosixThread *pxThisThread );
+
+/*
+ * Block or unblock the tick in the calling thread.
+ */
+static void prvMaskTick( int iHow );
+
+/*-----------------------------------------------------------*/
+
+static void prvMaskTick( int iHow )
+{
+sigset_t xSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGALRM );
+	pthread_sigmask( iHow, &xSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitToRun( xPosixThread *pxThread )
+{
+	while( sem_wait( &( pxThread->xWake ) ) != 0 )
+	{
+		/* Only EINTR can get here. */
+	}
+
+	if( pxThread->xDeleted != pdFALSE )
+	{
+		/* vPortCleanUpTCB() is waiting for the thread to end. */
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvTaskThread( void *pvParameters )
+{
+xPosixThread *pxThread = ( xPosixThread * ) pvParameters;
+
+	prvWaitToRun( pxThread );
+
+	/* A task starts with interrupts enabled and no critical nesting. */
+	uxCriticalNesting = 0;
+	prvMaskTick( SIG_UNBLOCK );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* Tasks must not return, they delete themselves instead. */
+	fprintf( stderr, "FreeRTOS: a task function returned\n" );
+	abort();
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+xPosixThread *pxThread;
+sigset_t xSignals, xOldSignals;
+pthread_attr_t xAttributes;
+
+	pxThread = ( xPosixThread * ) ( ( ( portPOINTER_SIZE_TYPE ) ( pxTopOfStack + 1 ) - sizeof( xPosixThread ) ) & ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) );
+	memset( pxThread, 0, sizeof( xPosixThread ) );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->xDeleted = pdFALSE;
+	sem_init( &( pxThread->xWake ), 0, 0 );
+
+	/* The new thread inherits a mask with the tick blocked, so it can never
+	take the tick while it waits to run. */
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGALRM );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+
+	pthread_attr_init( &xAttributes );
+	pthread_attr_setdetachstate( &xAttributes, PTHREAD_CREATE_JOINABLE );
+	if( pthread_create( &( pxThread->xThread ), &xAttributes, prvTaskThread, pxThread ) != 0 )
+	{
+		fprintf( stderr, "FreeRTOS: could not create a task thread\n" );
+		abort();
+	}
+	pthread_attr_destroy( &xAttributes );
+
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+
+	return ( portSTACK_TYPE * ) pxThread;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortStartScheduler( void )
+{
+struct sigaction xAction;
+struct itimerval xTimer;
+
+	sem_init( &xSchedulerEnd, 0, 0 );
+
+	/* This thread never runs task code, and must not take the tick. */
+	prvMaskTick( SIG_BLOCK );
+
+	memset( &xAction, 0, sizeof( xAction ) );
+	xAction.sa_handler = prvTickHandler;
+	sigfillset( &xAction.sa_mask );
+	sigaction( SIGALRM, &xAction, NULL );
+
+	xTimer.it_interval.tv_sec = 0;
+	xTimer.it_interval.tv_usec = 1000000UL / configTICK_RATE_HZ;
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	/* Start the first task. */
+	uxCriticalNesting = 0;
+	sem_post( &( portTHREAD_OF( pxCurrentTCB )->xWake ) );
+
+	while( sem_wait( &xSchedulerEnd ) != 0 )
+	{
+		/* Only EINTR can get here. */
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+
+	/* The tasks are left suspended, they end with the process. */
+	memset( &xTimer, 0, sizeof( xTimer ) );
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+	sem_post( &xSchedulerEnd );
+
+	/* The calling task is left suspended too.  It must not run on once the
+	scheduler has stopped: calling the kernel would find it stopped, and
+	returning from the task function aborts the process.  Park its thread
+	until main() ends the process. */
+	if( pthread_equal( pthread_self(), portTHREAD_OF( pxCurrentTCB )->xThread ) != 0 )
+	{
+		prvMaskTick( SIG_BLOCK );
+		for( ;; )
+		{
+			pause();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( xPosixThread *pxThisThread )
+{
+xPosixThread *pxNextThread = portTHREAD_OF( pxCurrentTCB );
+
+	if( pxNextThread != pxThisThread )
+	{
+		pxThisThread->uxCriticalNesting = uxCriticalNesting;
+		sem_post( &( pxNextThread->xWake ) );
+		prvWaitToRun( pxThisThread );
+		uxCriticalNesting = pxThisThread->uxCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+xPosixThread *pxThisThread = portTHREAD_OF( pxCurrentTCB );
+sigset_t xSignals, xOldSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGALRM );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+
+	vTaskSwitchContext();
+	prvSwitchThread( pxThisThread );
+
+	pthread_sigmask( SIG_SETMASK, &xOldSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickHandler( int iSignal )
+{
+xPosixThread *pxThisThread = portTHREAD_OF( pxCurrentTCB );
+int iSavedErrno = errno;
+
+	( void ) iSignal;
+
+	/* Only the running task's thread has the tick unblocked, anything else
+	is a tick that arrived as the running task was being switched out. */
+	if( pthread_equal( pthread_self(), pxThisThread->xThread ) != 0 )
+	{
+		if( xTaskIncrementTick() != pdFALSE )
+		{
+			vTaskSwitchContext();
+			prvSwitchThread( pxThisThread );
+		}
+	}
+
+	errno = iSavedErrno;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	prvMaskTick( SIG_BLOCK );
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxCriticalNesting );
+	uxCriticalNesting--;
+	if( uxCriticalNesting == 0 )
+	{
+		prvMaskTick( SIG_UNBLOCK );
+	}
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortSetInterruptMask( void )
+{
+sigset_t xSignals, xOldSignals;
+
+	sigemptyset( &xSignals );
+	sigaddset( &xSignals, SIGALRM );
+	pthread_sigmask( SIG_BLOCK, &xSignals, &xOldSignals );
+
+	return ( unsigned long ) sigismember( &xOldSignals, SIGALRM );
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( unsigned long ulNewMaskValue )
+{
+	if( ulNewMaskValue == 0UL )
+	{
+		prvMaskTick( SIG_UNBLOCK );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pvTCB )
+{
+xPosixThread *pxThread = portTHREAD_OF( pvTCB );
+
+	/* The thread is waiting to run, let it end before its stack, which
+	holds pxThread, is freed. */
+	pxThread->xDeleted = pdTRUE;
+	sem_post( &( pxThread->xWake ) );
+	pthread_join( pxThread->xThread, NULL );
+	sem_destroy( &( pxThread->xWake ) );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* FREERTOS_HOST_POSIX */
@@ -0,0 +1,275 @@
+/*
+ * @brief Common FreeRTOS functions shared among platforms
+ *
+ * @note
+ * Copyright(C) NXP Semiconductors, 2012
+ * All rights reserved.
+ *
+ * @par
+ * Software that is described herein is for illustrative purposes only
+ * which provides customers with programming information regarding the
+ * LPC products.  This software is supplied "AS IS" without any warranties of
+ * any kind, and NXP Semiconductors and its licensor disclaim any and
+ * all warranties, express or implied, including all implied warranties of
+ * merchantability, fitness for a particular purpose and non-infringement of
+ * intellectual property rights.  NXP Semiconductors assumes no responsibility
+ * or liability for the use of the software, conveys no license or rights under any
+ * patent, copyright, mask work right, or any other intellectual property rights in
+ * or to any products. NXP Semiconductors reserves the right to make changes
+ * in the software without notification. NXP Semiconductors also makes no
+ * representation or warranty that such application will be suitable for the
+ * specified use without further testing or modification.
+ *
+ * @par
+ * Permission to use, copy, modify, and distribute this software and its
+ * documentation is hereby granted, under NXP Semiconductors' and its
+ * licensor's relevant copyrights in the software, without fee, provided that it
+ * is used in conjunction with NXP Semiconductors microcontrollers.  This
+ * copyright, permission, and disclaimer notice must appear in all copies of
+ * this code.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "FreeRTOSCommonHooks.h"
+
+#include "chip.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#if configUSE_TICKLESS_IDLE == 1
+
+/* Interrupt priority of the RIT wake-up interrupt, lowest by default */
+#ifndef configRIT_TICKLESS_INTERRUPT_PRIORITY
+#define configRIT_TICKLESS_INTERRUPT_PRIORITY   configLIBRARY_LOWEST_INTERRUPT_PRIORITY
+#endif
+
+/* SysTick counts (core clocks) per RTOS tick */
+static uint32_t ulSysTickCountsPerTick;
+
+/* Core clocks per RIT count, the RIT runs from a divided peripheral clock */
+static uint32_t ulCoreClocksPerRITCount;
+
+/* Longest idle period, in ticks, that keeps core clock counts in 32 bits */
+static portTickType xMaxSuppressedTicks;
+
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+
+#if configUSE_TRACE_FACILITY == 1
+
+/* Most tasks FreeRTOSStackReport() can list, the idle and timer tasks count */
+#ifndef configSTACK_REPORT_MAX_TASKS
+#define configSTACK_REPORT_MAX_TASKS    16
+#endif
+
+/* Kept off the calling task's stack, which is the thing being measured */
+static xTaskStatusType xStackReportStatus[configSTACK_REPORT_MAX_TASKS];
+
+#endif /* configUSE_TRACE_FACILITY == 1 */
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#if configUSE_TICKLESS_IDLE == 1
+
+/* Start the RIT as a free-running 32-bit wake-up counter */
+static void prvTicklessRITInit(void)
+{
+	uint32_t ritRate;
+
+	Chip_RIT_Init(LPC_RITIMER);
+	ritRate = Chip_Clock_GetPeripheralClockRate(SYSCTL_PCLK_RIT);
+
+	ulSysTickCountsPerTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+	ulCoreClocksPerRITCount = configCPU_CLOCK_HZ / ritRate;
+	xMaxSuppressedTicks = (portTickType) (0xFFFFFFFFUL / ulSysTickCountsPerTick) - 1;
+
+	NVIC_SetPriority(RITIMER_IRQn, configRIT_TICKLESS_INTERRUPT_PRIORITY);
+	NVIC_ClearPendingIRQ(RITIMER_IRQn);
+	NVIC_EnableIRQ(RITIMER_IRQn);
+}
+
+/* Restart SysTick so that the next tick lands on the original tick grid */
+static void prvTicklessRestartSysTick(uint32_t remaining)
+{
+	/* Never load a tiny or out of range value */
+	if ((remaining < 2) || (remaining > ulSysTickCountsPerTick)) {
+		remaining = ulSysTickCountsPerTick;
+	}
+
+	SysTick->LOAD = remaining - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+	SysTick->LOAD = ulSysTickCountsPerTick - 1;
+}
+
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Delay for the specified number of milliSeconds */
+void FreeRTOSDelay(uint32_t ms)
+{
+	portTickType xDelayTime;
+
+	xDelayTime = xTaskGetTickCount();
+	vTaskDelayUntil(&xDelayTime, ms);
+}
+
+/* FreeRTOS malloc fail hook */
+void vApplicationMallocFailedHook(void)
+{
+	DEBUGSTR("DIE:ERROR:FreeRTOS: Malloc Failure!\r\n");
+	taskDISABLE_INTERRUPTS();
+	for (;; ) {}
+}
+
+/* FreeRTOS application idle hook */
+void vApplicationIdleHook(void)
+{
+#if configUSE_TICKLESS_IDLE == 0
+	/* Best to sleep here until next systick */
+	__WFI();
+#endif
+	/* With tickless idle the kernel sleeps in vPortSuppressTicksAndSleep() */
+}
+
+#if configUSE_TICKLESS_IDLE == 1
+
+/* RIT wake-up interrupt, normally already cleared before it is taken */
+void RIT_IRQHandler(void)
+{
+	Chip_RIT_ClearInt(LPC_RITIMER);
+}
+
+/* Tickless idle using the RIT, overrides the SysTick limited port default */
+void vPortSuppressTicksAndSleep(portTickType xExpectedIdleTime)
+{
+	uint32_t ritStart, ritElapsed, elapsed, sleepCounts;
+	portTickType xCompleteTicks, xModifiableIdleTime;
+	eSleepModeStatus eSleepStatus;
+
+	if (ulSysTickCountsPerTick == 0) {
+		prvTicklessRITInit();
+	}
+
+	if (xExpectedIdleTime > xMaxSuppressedTicks) {
+		xExpectedIdleTime = xMaxSuppressedTicks;
+	}
+
+	/* Stop SysTick and timestamp the point within the current tick period */
+	__disable_irq();
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk;
+	ritStart = Chip_RIT_GetCounter(LPC_RITIMER);
+
+	/* Counts already consumed from the tick period that was interrupted,
+	   VAL reloads with LOAD one count after reaching 0 */
+	elapsed = ulSysTickCountsPerTick - SysTick->VAL;
+
+	/* A tick that fell due while SysTick was being stopped is pending and
+	   VAL has already reloaded, so let the tick interrupt count it */
+	eSleepStatus = eTaskConfirmSleepModeStatus();
+	if ((eSleepStatus == eAbortSleep) || (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) {
+		/* Finish the interrupted tick period and carry on as normal */
+		prvTicklessRestartSysTick(ulSysTickCountsPerTick - elapsed);
+		__enable_irq();
+		return;
+	}
+
+	/* Program the RIT to fire on the last tick boundary of the idle period.
+	   When no task waits on a timeout this is simply the longest sleep. */
+	Chip_RIT_ClearInt(LPC_RITIMER);
+	NVIC_ClearPendingIRQ(RITIMER_IRQn);
+	sleepCounts = ((xExpectedIdleTime * ulSysTickCountsPerTick) - elapsed) / ulCoreClocksPerRITCount;
+	Chip_RIT_SetCOMPVAL(LPC_RITIMER, ritStart + sleepCounts);
+
+	xModifiableIdleTime = xExpectedIdleTime;
+	configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+	if (xModifiableIdleTime > 0) {
+		__DSB();
+		__WFI();
+		__ISB();
+	}
+	configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+	/* Whatever woke the core, work out how far the tick grid has moved.  The
+	   difference is right across one wrap of the free running counter. */
+	ritElapsed = Chip_RIT_GetCounter(LPC_RITIMER) - ritStart;
+	Chip_RIT_SetCOMPVAL(LPC_RITIMER, ritStart - 1);
+	Chip_RIT_ClearInt(LPC_RITIMER);
+	NVIC_ClearPendingIRQ(RITIMER_IRQn);
+
+	/* At or past the match the whole period has gone, whatever the rounding
+	   of sleepCounts.  Below it elapsed stays under xExpectedIdleTime ticks
+	   of core clocks, which xMaxSuppressedTicks keeps in 32 bits. */
+	if (ritElapsed >= sleepCounts) {
+		xCompleteTicks = xExpectedIdleTime;
+	}
+	else {
+		elapsed += ritElapsed * ulCoreClocksPerRITCount;
+		xCompleteTicks = elapsed / ulSysTickCountsPerTick;
+	}
+
+	/* The final tick of the period is left to the tick interrupt so that
+	   tasks due at that tick are unblocked by xTaskIncrementTick() */
+	if (xCompleteTicks >= xExpectedIdleTime) {
+		xCompleteTicks = xExpectedIdleTime - 1;
+		prvTicklessRestartSysTick(ulSysTickCountsPerTick);
+		SCB->ICSR = SCB_ICSR_PENDSTSET_Msk;
+	}
+	else {
+		prvTicklessRestartSysTick(ulSysTickCountsPerTick - (elapsed % ulSysTickCountsPerTick));
+	}
+
+	vTaskStepTick(xCompleteTicks);
+	__enable_irq();
+}
+
+#endif /* configUSE_TICKLESS_IDLE == 1 */
+
+/* FreeRTOS stack overflow hook */
+void vApplicationStackOverflowHook(xTaskHandle pxTask, signed char *pcTaskName)
+{
+	(void) pxTask;
+	(void) pcTaskName;
+
+	DEBUGOUT("DIE:ERROR:FreeRTOS: Stack overflow in task %s\r\n", pcTaskName);
+	/* Run time stack overflow checking is performed if
+	   configCHECK_FOR_STACK_OVERFLOW is defined to 1 or 2.  This hook
+	   function is called if a stack overflow is detected. */
+	taskDISABLE_INTERRUPTS();
+	for (;; ) {}
+}
+
+#if configUSE_TRACE_FACILITY == 1
+
+/* Print the stack high water mark of every task */
+void FreeRTOSStackReport(void)
+{
+	unsigned portBASE_TYPE uxCount, i;
+
+	uxCount = uxTaskGetSystemState(xStackReportStatus, configSTACK_REPORT_MAX_TASKS, NULL);
+	if (uxCount == 0) {
+		DEBUGSTR("STACK:ERROR:more tasks than configSTACK_REPORT_MAX_TASKS\r\n");
+	}
+
+	for (i = 0; i < uxCount; i++) {
+		DEBUGOUT("STACK:%s:%u\r\n", (const char *) xStackReportStatus[i].pcTaskName,
+				 (unsigned int) xStackReportStatus[i].usStackHighWaterMark);
+	}
+}
+
+#endif /* configUSE_TRACE_FACILITY == 1 */
+
+/* FreeRTOS application tick hook */
+void vApplicationTickHook(void)
+{}
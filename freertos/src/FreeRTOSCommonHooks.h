@@ -54,10 +54,28 @@ void vApplicationMallocFailedHook(void);
 /**
  * @brief	FreeRTOS application idle hook
  * @return	Nothing
- * @note	Calls ARM Wait for Interrupt function to idle core
+ * @note	Calls ARM Wait for Interrupt function to idle core. When
+ * configUSE_TICKLESS_IDLE is 1 the core is instead put to sleep by
+ * vPortSuppressTicksAndSleep().
  */
 void vApplicationIdleHook(void);
 
+#if configUSE_TICKLESS_IDLE == 1
+/**
+ * @brief	FreeRTOS tickless idle using the Repetitive Interrupt Timer
+ * @param	xExpectedIdleTime	: Number of ticks until a task must run
+ * @return	Nothing
+ * @note	Stops SysTick and sleeps until the RIT matches the last tick of
+ * the idle period or another interrupt occurs, then steps the tick count
+ * with vTaskStepTick() and restarts SysTick on the original tick grid.
+ * Unlike the SysTick based default in port.c the idle period is not limited
+ * by the 24-bit SysTick counter. The RIT and RIT_IRQHandler are reserved for
+ * this use.
+ */
+void vPortSuppressTicksAndSleep(portTickType xExpectedIdleTime);
+
+#endif
+
 /**
  * @brief	FreeRTOS stack overflow hook
  * @param	pxTask		: Task handle that overflowed stack
@@ -67,6 +85,19 @@ void vApplicationIdleHook(void);
  */
 void vApplicationStackOverflowHook(xTaskHandle pxTask, signed char *pcTaskName);
 
+#if configUSE_TRACE_FACILITY == 1
+/**
+ * @brief	Print the stack high water mark of every task
+ * @return	Nothing
+ * @note	Prints one "STACK:<task name>:<free words>" line per task with
+ * DEBUGOUT. The free words are the least stack the task has had left since
+ * it was created. Capture the output and pass it to tools/freertos_stack_report
+ * with -l to compare it against the static worst case of each task.
+ */
+void FreeRTOSStackReport(void);
+
+#endif
+
 /**
  * @brief	FreeRTOS application tick hook
  * @return	Nothing
@@ -0,0 +1,196 @@
+/*
+ * @brief FreeRTOS run time statistics support
+ *
+ * @note
+ * See FreeRTOSRunTimeStats.h for the time base and the frame layout.
+ */
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "chip.h"
+
+#include "FreeRTOSRunTimeStats.h"
+
+#if configGENERATE_RUN_TIME_STATS == 1
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Number of accounting passes averaged by ulRunTimeStatsAccountingCycles() */
+#define RTS_ACCOUNTING_LOOPS    64
+
+/* Running Fletcher-16 checksum state */
+typedef struct {
+	uint16_t sum1;
+	uint16_t sum2;
+} RTS_CHECKSUM_T;
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void prvPutU16(unsigned char *pucBuffer, uint16_t value)
+{
+	pucBuffer[0] = (unsigned char) value;
+	pucBuffer[1] = (unsigned char) (value >> 8);
+}
+
+static void prvPutU32(unsigned char *pucBuffer, uint32_t value)
+{
+	pucBuffer[0] = (unsigned char) value;
+	pucBuffer[1] = (unsigned char) (value >> 8);
+	pucBuffer[2] = (unsigned char) (value >> 16);
+	pucBuffer[3] = (unsigned char) (value >> 24);
+}
+
+static void prvChecksumUpdate(RTS_CHECKSUM_T *pSum, const unsigned char *pucData, uint32_t len)
+{
+	while (len-- > 0) {
+		pSum->sum1 = (pSum->sum1 + *pucData++) % 255;
+		pSum->sum2 = (pSum->sum2 + pSum->sum1) % 255;
+	}
+}
+
+/* Encode the frame header */
+static void prvEncodeHeader(unsigned char *pucBuffer, unsigned portBASE_TYPE uxArraySize,
+							unsigned long ulTotalRunTime)
+{
+	pucBuffer[0] = 'R';
+	pucBuffer[1] = 'T';
+	pucBuffer[2] = RTS_FRAME_VERSION;
+	pucBuffer[3] = (unsigned char) uxArraySize;
+	prvPutU32(&pucBuffer[4], ulTotalRunTime);
+}
+
+/* Encode a single task record */
+static void prvEncodeRecord(unsigned char *pucBuffer, const xTaskStatusType *pxStatus)
+{
+	const signed char *pcName = pxStatus->pcTaskName;
+	int i;
+
+	pucBuffer[0] = (unsigned char) pxStatus->xTaskNumber;
+	pucBuffer[1] = (unsigned char) pxStatus->eCurrentState;
+	pucBuffer[2] = (unsigned char) pxStatus->uxCurrentPriority;
+	pucBuffer[3] = (unsigned char) pxStatus->uxBasePriority;
+	prvPutU32(&pucBuffer[4], pxStatus->ulRunTimeCounter);
+	prvPutU16(&pucBuffer[8], pxStatus->usStackHighWaterMark);
+
+	for (i = 0; i < RTS_NAME_LEN; i++) {
+		pucBuffer[10 + i] = (unsigned char) *pcName;
+		if (*pcName != 0) {
+			pcName++;
+		}
+	}
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Start the free-running run time stats timer */
+void vConfigureTimerForRunTimeStats(void)
+{
+	uint32_t timerRate;
+
+	Chip_TIMER_Init(configRUN_TIME_STATS_TIMER);
+	Chip_TIMER_Reset(configRUN_TIME_STATS_TIMER);
+
+	/* Divide the peripheral clock down to the stats clock, no match events
+	   so the 32-bit counter simply wraps */
+	timerRate = Chip_Clock_GetPeripheralClockRate(configRUN_TIME_STATS_TIMER_PCLK);
+	Chip_TIMER_PrescaleSet(configRUN_TIME_STATS_TIMER, (timerRate / configRUN_TIME_STATS_CLOCK_HZ) - 1);
+	Chip_TIMER_Enable(configRUN_TIME_STATS_TIMER);
+}
+
+/* Encode a task snapshot into a binary frame */
+unsigned long ulRunTimeStatsEncode(unsigned char *pucBuffer, unsigned long ulBufferSize,
+								   const xTaskStatusType *pxTaskStatusArray,
+								   unsigned portBASE_TYPE uxArraySize, unsigned long ulTotalRunTime)
+{
+	RTS_CHECKSUM_T sum = {0, 0};
+	unsigned long ulLength = RTS_FRAME_SIZE(uxArraySize);
+	unsigned char *pucRecord;
+	unsigned portBASE_TYPE x;
+
+	if ((ulBufferSize < ulLength) || (uxArraySize > 0xFF)) {
+		return 0;
+	}
+
+	prvEncodeHeader(pucBuffer, uxArraySize, ulTotalRunTime);
+	pucRecord = &pucBuffer[RTS_HEADER_SIZE];
+	for (x = 0; x < uxArraySize; x++) {
+		prvEncodeRecord(pucRecord, &pxTaskStatusArray[x]);
+		pucRecord += RTS_RECORD_SIZE;
+	}
+
+	prvChecksumUpdate(&sum, pucBuffer, ulLength - RTS_TRAILER_SIZE);
+	prvPutU16(pucRecord, (uint16_t) ((sum.sum2 << 8) | sum.sum1));
+
+	return ulLength;
+}
+
+/* Stream a task snapshot as a binary frame over a UART */
+void vRunTimeStatsSendUART(LPC_USART_T *pUART, const xTaskStatusType *pxTaskStatusArray,
+						   unsigned portBASE_TYPE uxArraySize, unsigned long ulTotalRunTime)
+{
+	RTS_CHECKSUM_T sum = {0, 0};
+	unsigned char buffer[RTS_RECORD_SIZE];
+	unsigned portBASE_TYPE x;
+
+	if (uxArraySize > 0xFF) {
+		uxArraySize = 0xFF;
+	}
+
+	prvEncodeHeader(buffer, uxArraySize, ulTotalRunTime);
+	prvChecksumUpdate(&sum, buffer, RTS_HEADER_SIZE);
+	Chip_UART_SendBlocking(pUART, buffer, RTS_HEADER_SIZE);
+
+	for (x = 0; x < uxArraySize; x++) {
+		prvEncodeRecord(buffer, &pxTaskStatusArray[x]);
+		prvChecksumUpdate(&sum, buffer, RTS_RECORD_SIZE);
+		Chip_UART_SendBlocking(pUART, buffer, RTS_RECORD_SIZE);
+	}
+
+	prvPutU16(buffer, (uint16_t) ((sum.sum2 << 8) | sum.sum1));
+	Chip_UART_SendBlocking(pUART, buffer, RTS_TRAILER_SIZE);
+}
+
+/* Time the run time accounting sequence of a context switch in a loop */
+unsigned long ulRunTimeStatsAccountingCycles(void)
+{
+	volatile unsigned long ulTotalRunTime, ulSwitchedInTime = 0, ulCounter = 0;
+	uint32_t start, end, empty;
+	int i;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	/* Loop overhead alone */
+	start = DWT->CYCCNT;
+	for (i = 0; i < RTS_ACCOUNTING_LOOPS; i++) {
+		__NOP();
+	}
+	empty = DWT->CYCCNT - start;
+
+	/* Same sequence as the accounting in vTaskSwitchContext(), outside any
+	   switch, so it runs with a warm pipeline and the loop's registers */
+	start = DWT->CYCCNT;
+	for (i = 0; i < RTS_ACCOUNTING_LOOPS; i++) {
+		ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+		if (ulTotalRunTime > ulSwitchedInTime) {
+			ulCounter += (ulTotalRunTime - ulSwitchedInTime);
+		}
+		ulSwitchedInTime = ulTotalRunTime;
+	}
+	end = DWT->CYCCNT - start;
+
+	return (end - empty) / RTS_ACCOUNTING_LOOPS;
+}
+
+#endif /* configGENERATE_RUN_TIME_STATS == 1 */
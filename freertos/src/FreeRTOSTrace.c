@@ -0,0 +1,102 @@
+/*
+ * @brief FreeRTOS binary trace recorder
+ *
+ * @note
+ * See FreeRTOSTrace.h for the record format and how to decode a dump.
+ */
+
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "chip.h"
+
+#if configUSE_TRACE_RECORDER == 1
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/* The recorder, a fixed header followed by the circular buffer and the
+   name table */
+TRACE_RECORDER_T xTraceRecorder = {
+	TRACE_MAGIC,
+	TRACE_VERSION,
+	sizeof(TRACE_RECORD_T),
+	configTRACE_RECORDER_RECORDS,
+	0,
+	0,
+	configTRACE_RECORDER_TASKS,
+	sizeof(TRACE_TASK_NAME_T),
+	0,
+	{{0, 0, 0, 0}},
+	{{0, {0}}}
+};
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Initialise the recorder and start the timestamp clock */
+void vTraceInit(void)
+{
+	/* The DWT cycle counter is the default timestamp */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	xTraceRecorder.timestampHz = SystemCoreClock;
+	xTraceRecorder.written = 0;
+	xTraceRecorder.namesWritten = 0;
+	memset(xTraceRecorder.names, 0, sizeof(xTraceRecorder.names));
+}
+
+/* Record a task creation and store the task name */
+void vTraceTaskCreate(void *pvTask, const signed char *pcName, uint32_t priority)
+{
+	TRACE_TASK_NAME_T *pName;
+	int i;
+
+	if (xTraceRecorder.timestampHz == 0) {
+		vTraceInit();
+	}
+
+	/* Called from the kernel's critical section, so the table has a single
+	   writer. A handle reused by a later task gets a new entry, the decoder
+	   takes the most recent one. */
+	pName = &xTraceRecorder.names[xTraceRecorder.namesWritten % configTRACE_RECORDER_TASKS];
+	xTraceRecorder.namesWritten++;
+	for (i = 0; i < TRACE_NAME_LEN; i++) {
+		pName->name[i] = (i < configMAX_TASK_NAME_LEN) ? (char) pcName[i] : 0;
+		if (pName->name[i] == 0) {
+			break;
+		}
+	}
+	for (; i < TRACE_NAME_LEN; i++) {
+		pName->name[i] = 0;
+	}
+	pName->task = (uint32_t) pvTask;
+
+	vTraceRecord(TRACE_EV_TASK_CREATE, (uint32_t) pvTask, (uint16_t) priority);
+}
+
+/* Record a queue, semaphore or mutex creation */
+void vTraceQueueCreate(uint16_t event, void *pvQueue, uint32_t length)
+{
+	if (xTraceRecorder.timestampHz == 0) {
+		vTraceInit();
+	}
+
+	vTraceRecord(event, (uint32_t) pvQueue, (uint16_t) length);
+}
+
+#endif /* configUSE_TRACE_RECORDER == 1 */
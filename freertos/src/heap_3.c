@@ -87,6 +87,11 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* When configSUPPORT_DYNAMIC_ALLOCATION is 0 every kernel object is created
+statically, so this file builds empty and any remaining call to pvPortMalloc()
+shows up as an undefined reference at link time. */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
@@ -127,5 +132,4 @@ void vPortFree( void *pv )
 	}
 }
 
-
-
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
@@ -99,6 +99,20 @@ privileged Vs unprivileged linkage and placement. */
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if ( ( configUSE_STATS_FORMATTING_FUNCTIONS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+	#error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used when configSUPPORT_DYNAMIC_ALLOCATION is 0, the formatting functions allocate a buffer from the heap.
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+	#if ( INCLUDE_vTaskDelayUntil != 1 )
+		#error INCLUDE_vTaskDelayUntil must be set to 1 if configUSE_EDF_SCHEDULING is set to 1
+	#endif /* INCLUDE_vTaskDelayUntil */
+
+	#if ( configEDF_PRIORITY < 1 )
+		#error configEDF_PRIORITY must be above the idle priority
+	#endif
+#endif /* configUSE_EDF_SCHEDULING */
+
 /*
  * Defines the size, in words, of the stack allocated to the idle task.
  */
@@ -148,6 +162,18 @@ typedef struct tskTaskControlBlock
 		unsigned long ulRunTimeCounter;			/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+		portTickType xPeriod;					/*< The time between the releases of two jobs of a periodic task, or 0 if the task is not periodic. */
+		portTickType xRelativeDeadline;			/*< The time each job of a periodic task has to finish after its release. */
+		portTickType xReleaseTime;				/*< The tick count at which the current job was released. */
+		portTickType xAbsoluteDeadline;			/*< The tick count by which the current job must finish.  Orders the task in the EDF ready list. */
+		unsigned portBASE_TYPE uxDeadlineMisses;	/*< The number of jobs that finished after their deadline. */
+	#endif
+
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+		unsigned long long ullTimeToWake;		/*< The 64-bit tick count at which the task leaves the Blocked state, used while it is referenced from the delayed task wheel. */
+	#endif
+
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		/* Allocate a Newlib reent structure that is specific to this task.
 		Note Newlib support has been included by popular demand, but is not
@@ -159,6 +185,10 @@ typedef struct tskTaskControlBlock
 		struct _reent xNewLib_reent;
 	#endif
 
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char ucStaticallyAllocated;	/*< Set to pdTRUE if the TCB and stack were provided by the application, so they are not freed if the task is deleted. */
+	#endif
+
 } tskTCB;
 
 
@@ -177,10 +207,18 @@ PRIVILEGED_DATA tskTCB * volatile pxCurrentTCB = NULL;
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static xList pxReadyTasksLists[ configMAX_PRIORITIES ];	/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
-PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static xList * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
+	PRIVILEGED_DATA static xList xDelayedTaskList1;							/*< Delayed tasks. */
+	PRIVILEGED_DATA static xList xDelayedTaskList2;							/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static xList * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static xList * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#else
+
+	PRIVILEGED_DATA static xList xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SLOTS ];	/*< Delayed tasks, hashed on their wake time.  The slot lists are not sorted. */
+
+#endif
 PRIVILEGED_DATA static xList xPendingReadyList;							/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -214,6 +252,22 @@ PRIVILEGED_DATA static volatile portBASE_TYPE xNumOfOverflows 					= ( portBASE_
 PRIVILEGED_DATA static unsigned portBASE_TYPE uxTaskNumber 						= ( unsigned portBASE_TYPE ) 0U;
 PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_DELAY;
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* Never later than the 64-bit wake time of any task in the delayed task
+	wheel.  Unblocking tasks sets it to the next tick, and marks it stale, as
+	the next wake time is then unknown until the idle task scans the wheel.
+	xNextTaskUnblockTime holds the low bits for the tickless idle code. */
+	PRIVILEGED_DATA static volatile unsigned long long ullNextTaskUnblockTime	= ~( ( unsigned long long ) 0U );
+	PRIVILEGED_DATA static volatile portBASE_TYPE xNextTaskUnblockTimeStale		= pdFALSE;
+
+	/* The idle task's scan of the wheel while the next unblock time is stale:
+	the next slot to scan, and the earliest wake time found so far. */
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxNextSlotToScan				= ( unsigned portBASE_TYPE ) 0U;
+	PRIVILEGED_DATA static unsigned long long ullScanNextUnblockTime			= ~( ( unsigned long long ) 0U );
+
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	PRIVILEGED_DATA static unsigned long ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
@@ -241,6 +295,36 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 0 )
+
+	/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of
+	the same priority get an equal share of the processor time. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority ) listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	/* The ready list at configEDF_PRIORITY is kept in deadline order, so the
+	task at its head is the one whose deadline is nearest. */
+	#define taskSELECT_FROM_READY_LIST( uxPriority )																		\
+	{																													\
+		if( ( uxPriority ) == ( unsigned portBASE_TYPE ) configEDF_PRIORITY )											\
+		{																												\
+			pxCurrentTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );	\
+		}																												\
+		else																											\
+		{																												\
+			listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );						\
+		}																												\
+	}
+
+	/* Is deadline xA earlier than deadline xB?  The difference is used so the
+	answer is still right after the tick count has overflowed. */
+	#define taskDEADLINE_BEFORE( xA, xB ) ( ( portTickType ) ( ( xA ) - ( xB ) ) > ( portMAX_DELAY >> 1 ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 	/* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
@@ -268,9 +352,7 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 			--uxTopReadyPriority;																						\
 		}																												\
 																														\
-		/* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of										\
-		the	same priority get an equal share of the processor time. */													\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopReadyPriority ] ) );						\
+		taskSELECT_FROM_READY_LIST( uxTopReadyPriority );																\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 	/*-----------------------------------------------------------*/
@@ -299,7 +381,7 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 		/* Find the highest priority queue that contains ready tasks. */							\
 		portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );								\
 		configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );		\
-		listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );		\
+		taskSELECT_FROM_READY_LIST( uxTopPriority );												\
 	} /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 	/*-----------------------------------------------------------*/
@@ -319,6 +401,21 @@ PRIVILEGED_DATA static volatile portTickType xNextTaskUnblockTime				= portMAX_D
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	#if ( ( configDELAYED_TASK_WHEEL_SLOTS & ( configDELAYED_TASK_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configDELAYED_TASK_WHEEL_SLOTS must be a power of 2.
+	#endif
+
+	/* The tick count extended to 64 bits by the number of times it has
+	overflowed, so wake times never wrap and no overflow list is needed. */
+	#define taskTICK_COUNT_64()	( ( ( unsigned long long ) ( unsigned portBASE_TYPE ) xNumOfOverflows << ( sizeof( portTickType ) * 8U ) ) | ( unsigned long long ) xTickCount )
+
+	/* The delayed task wheel slot that holds tasks waking at tick xTime. */
+	#define taskDELAYED_WHEEL_SLOT( xTime )	( &( xDelayedTaskWheel[ ( xTime ) & ( ( portTickType ) configDELAYED_TASK_WHEEL_SLOTS - ( portTickType ) 1U ) ] ) )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()																	\
@@ -357,12 +454,31 @@ count overflows. */
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if
+ * the task is at configEDF_PRIORITY when configUSE_EDF_SCHEDULING is 1.
  */
-#define prvAddTaskToReadyList( pxTCB )																				\
-	traceMOVED_TASK_TO_READY_STATE( pxTCB )																			\
-	taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );																\
-	vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+#if ( configUSE_EDF_SCHEDULING == 0 )
+
+	#define prvAddTaskToReadyList( pxTCB )																			\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																		\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );															\
+		vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+	#define prvAddTaskToReadyList( pxTCB )																			\
+		traceMOVED_TASK_TO_READY_STATE( pxTCB )																		\
+		taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );															\
+		if( ( pxTCB )->uxPriority == ( unsigned portBASE_TYPE ) configEDF_PRIORITY )								\
+		{																											\
+			prvInsertTaskByDeadline( pxTCB );																		\
+		}																											\
+		else																										\
+		{																											\
+			vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xGenericListItem ) );	\
+		}
+
+#endif /* configUSE_EDF_SCHEDULING */
 /*-----------------------------------------------------------*/
 
 /*
@@ -426,15 +542,51 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
 
 /*
  * The currently executing task is entering the Blocked state.  Add the task to
- * either the current or the overflow delayed task list.
+ * either the current or the overflow delayed task list, or to the delayed task
+ * wheel slot for its wake time when configUSE_DELAYED_TASK_WHEEL is 1.
  */
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	/*
+	 * Insert the task into the ready list at configEDF_PRIORITY, behind every
+	 * task whose deadline is the same or earlier.
+	 */
+	static void prvInsertTaskByDeadline( tskTCB *pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/*
+	 * Called from the tick interrupt.  Move the tasks whose wake time has been
+	 * reached from the slot for the current tick to the ready lists.  Returns
+	 * pdTRUE if a context switch is required.
+	 */
+	static portBASE_TYPE prvCheckDelayedTaskWheel( void ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Scan the next configDELAYED_TASK_WHEEL_SCAN_SLOTS slots of the delayed
+	 * task wheel for the earliest wake time, and set the next unblock time
+	 * once the whole wheel has been scanned.  Only called by the idle task,
+	 * with the scheduler suspended.
+	 */
+	static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*
  * Allocates memory from the heap for a TCB and associated stack.  Checks the
- * allocation was successful.
+ * allocation was successful.  If pxTaskBuffer is not NULL the TCB and stack
+ * provided by the application are used instead.
+ */
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Creates a task for both xTaskGenericCreate() and xTaskCreateStatic().
  */
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer ) PRIVILEGED_FUNCTION;
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask *pxTaskBuffer ) PRIVILEGED_FUNCTION;
 
 /*
  * Fills an xTaskStatusType structure with information on each task that is
@@ -476,7 +628,42 @@ static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TY
 
 #endif
 
-signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	signed portBASE_TYPE xTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions )
+	{
+		return prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, puxStackBuffer, xRegions, NULL );
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTaskHandle xTaskCreateStatic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
+	{
+	xTaskHandle xReturn = NULL;
+
+		configASSERT( puxStackBuffer );
+		configASSERT( pxTaskBuffer );
+
+		/* xStaticTask must be exactly the size of the TCB it holds.  If this
+		fails the structures in task.h and tasks.c are out of step. */
+		configASSERT( ( sizeof( xStaticTask ) == sizeof( tskTCB ) ) );
+
+		if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+		{
+			/* The memory is already there, so this cannot fail. */
+			( void ) prvTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, &xReturn, puxStackBuffer, NULL, pxTaskBuffer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static signed portBASE_TYPE prvTaskGenericCreate( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, unsigned portBASE_TYPE uxPriority, xTaskHandle *pxCreatedTask, portSTACK_TYPE *puxStackBuffer, const xMemoryRegion * const xRegions, xStaticTask *pxTaskBuffer )
 {
 signed portBASE_TYPE xReturn;
 tskTCB * pxNewTCB;
@@ -486,7 +673,7 @@ tskTCB * pxNewTCB;
 
 	/* Allocate the memory required by the TCB and stack for the new task,
 	checking that the allocation was successful. */
-	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer );
+	pxNewTCB = prvAllocateTCBAndStack( usStackDepth, puxStackBuffer, pxTaskBuffer );
 
 	if( pxNewTCB != NULL )
 	{
@@ -760,6 +947,109 @@ tskTCB * pxNewTCB;
 #endif /* INCLUDE_vTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	signed portBASE_TYPE xTaskCreatePeriodic( pdTASK_CODE pxTaskCode, const signed char * const pcName, unsigned short usStackDepth, void *pvParameters, portTickType xPeriod, portTickType xRelativeDeadline, xTaskHandle *pxCreatedTask )
+	{
+	signed portBASE_TYPE xReturn;
+	xTaskHandle xCreatedTask;
+	tskTCB *pxNewTCB;
+
+		configASSERT( ( ( unsigned portBASE_TYPE ) configEDF_PRIORITY < ( unsigned portBASE_TYPE ) configMAX_PRIORITIES ) );
+		configASSERT( ( xPeriod > 0U ) );
+		configASSERT( ( xRelativeDeadline > 0U ) && ( xRelativeDeadline <= xPeriod ) );
+
+		/* The new task must not run before it has a deadline. */
+		vTaskSuspendAll();
+		{
+			xReturn = xTaskGenericCreate( pxTaskCode, pcName, usStackDepth, pvParameters, ( unsigned portBASE_TYPE ) configEDF_PRIORITY, &xCreatedTask, NULL, NULL );
+
+			if( xReturn == pdPASS )
+			{
+				pxNewTCB = ( tskTCB * ) xCreatedTask;
+
+				taskENTER_CRITICAL();
+				{
+					pxNewTCB->xPeriod = xPeriod;
+					pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+					pxNewTCB->xReleaseTime = xTickCount;
+					pxNewTCB->xAbsoluteDeadline = xTickCount + xRelativeDeadline;
+
+					/* The task was added to the ready list before it had a
+					deadline, move it to its place in deadline order. */
+					( void ) uxListRemove( &( pxNewTCB->xGenericListItem ) );
+					prvInsertTaskByDeadline( pxNewTCB );
+
+					/* Before the scheduler is started pxCurrentTCB is the task
+					that will run first.  Make sure it is the task with the
+					nearest deadline if it is periodic. */
+					if( ( xSchedulerRunning == pdFALSE ) && ( pxCurrentTCB->uxPriority == ( unsigned portBASE_TYPE ) configEDF_PRIORITY ) )
+					{
+						pxCurrentTCB = ( tskTCB * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ configEDF_PRIORITY ] ) );
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxCreatedTask != NULL )
+				{
+					*pxCreatedTask = xCreatedTask;
+				}
+			}
+		}
+		( void ) xTaskResumeAll();
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskWaitForNextPeriod( void )
+	{
+		configASSERT( ( pxCurrentTCB->xPeriod > 0U ) );
+
+		taskENTER_CRITICAL();
+		{
+			/* The current job has finished.  Did it finish in time? */
+			if( taskDEADLINE_BEFORE( pxCurrentTCB->xAbsoluteDeadline, xTickCount ) )
+			{
+				( pxCurrentTCB->uxDeadlineMisses )++;
+				traceTASK_DEADLINE_MISSED( pxCurrentTCB );
+			}
+
+			/* The next job is due its relative deadline after it is released,
+			one period after the current job was. */
+			pxCurrentTCB->xAbsoluteDeadline = pxCurrentTCB->xReleaseTime + pxCurrentTCB->xPeriod + pxCurrentTCB->xRelativeDeadline;
+
+			/* If the next job has already been released the task will not
+			block, so it has to move to its new place in the ready list now.
+			The task is not in the EDF ready list if it has inherited a higher
+			priority. */
+			if( pxCurrentTCB->uxPriority == ( unsigned portBASE_TYPE ) configEDF_PRIORITY )
+			{
+				( void ) uxListRemove( &( pxCurrentTCB->xGenericListItem ) );
+				prvInsertTaskByDeadline( pxCurrentTCB );
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Wait for the release of the next job.  This also updates
+		xReleaseTime, and yields so a task with a nearer deadline can run. */
+		vTaskDelayUntil( &( pxCurrentTCB->xReleaseTime ), pxCurrentTCB->xPeriod );
+	}
+	/*-----------------------------------------------------------*/
+
+	unsigned portBASE_TYPE uxTaskGetDeadlineMisses( xTaskHandle xTask )
+	{
+	tskTCB *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		configASSERT( ( pxTCB->xPeriod > 0U ) );
+
+		return pxTCB->uxDeadlineMisses;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
 #if ( INCLUDE_vTaskDelay == 1 )
 
 	void vTaskDelay( portTickType xTicksToDelay )
@@ -833,7 +1123,11 @@ tskTCB * pxNewTCB;
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+				if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#else
+				if( ( pxStateList >= &( xDelayedTaskWheel[ 0 ] ) ) && ( pxStateList < &( xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SLOTS ] ) ) )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1227,7 +1521,34 @@ void vTaskStartScheduler( void )
 portBASE_TYPE xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+	xStaticTask *pxIdleTaskTCBBuffer = NULL;
+	portSTACK_TYPE *pxIdleTaskStackBuffer = NULL;
+	unsigned short usIdleTaskStackSize = tskIDLE_STACK_SIZE;
+	xTaskHandle xIdleHandle;
+
+		/* The application provides the memory used by the idle task, so
+		starting the scheduler does not use the heap. */
+		vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &usIdleTaskStackSize );
+		xIdleHandle = xTaskCreateStatic( prvIdleTask, ( signed char * ) "IDLE", usIdleTaskStackSize, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), pxIdleTaskStackBuffer, pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+		if( xIdleHandle != NULL )
+		{
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+		{
+			xIdleTaskHandle = xIdleHandle;
+		}
+		#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+	}
+	#elif ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
 	{
 		/* Create the idle task, storing its handle in xIdleTaskHandle so it can
 		be returned by the xTaskGetIdleTaskHandle() function. */
@@ -1238,7 +1559,7 @@ portBASE_TYPE xReturn;
 		/* Create the idle task without storing its handle. */
 		xReturn = xTaskCreate( prvIdleTask, ( signed char * ) "IDLE", tskIDLE_STACK_SIZE, ( void * ) NULL, ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), NULL );  /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 	}
-	#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 	#if ( configUSE_TIMERS == 1 )
 	{
@@ -1500,8 +1821,21 @@ unsigned portBASE_TYPE uxTaskGetNumberOfTasks( void )
 
 				/* Fill in an xTaskStatusType structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+				#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+				{
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( xList * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#else
+				{
+				unsigned portBASE_TYPE uxSlot;
+
+					for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxSlot++ )
+					{
+						uxTask += prvListTaskWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxSlot ] ), eBlocked );
+					}
+				}
+				#endif
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -1572,7 +1906,29 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 		/* Correct the tick count value after a period during which the tick
 		was suppressed.  Note this does *not* call the tick hook function for
 		each stepped tick. */
-		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+		{
+			configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+		}
+		#else
+		{
+			configASSERT( ( taskTICK_COUNT_64() + xTicksToJump ) <= ullNextTaskUnblockTime );
+
+			/* Only the slot for the tick being counted is checked, so a task
+			that is due on the last tick of the jump is left for
+			xTaskIncrementTick() to unblock when the scheduler is resumed. */
+			if( ( taskTICK_COUNT_64() + xTicksToJump ) == ullNextTaskUnblockTime )
+			{
+				xTicksToJump--;
+				++uxPendedTicks;
+			}
+
+			if( ( portTickType ) ( xTickCount + xTicksToJump ) < xTickCount )
+			{
+				xNumOfOverflows++;
+			}
+		}
+		#endif
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
 	}
@@ -1582,8 +1938,10 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 
 portBASE_TYPE xTaskIncrementTick( void )
 {
-tskTCB * pxTCB;
-portTickType xItemValue;
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+	tskTCB * pxTCB;
+	portTickType xItemValue;
+#endif
 portBASE_TYPE xSwitchRequired = pdFALSE;
 
 	/* Called by the portable layer each time a tick interrupt occurs.
@@ -1603,9 +1961,22 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 
 			if( xConstTickCount == ( portTickType ) 0U )
 			{
-				taskSWITCH_DELAYED_LISTS();
+				#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+					taskSWITCH_DELAYED_LISTS();
+				#else
+					xNumOfOverflows++;
+				#endif
 			}
 
+			#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+				/* No task can be due before ullNextTaskUnblockTime. */
+				if( taskTICK_COUNT_64() >= ullNextTaskUnblockTime )
+				{
+					xSwitchRequired = prvCheckDelayedTaskWheel();
+				}
+			}
+			#else
 			/* See if this tick has made a timeout expire.  Tasks are stored in the
 			queue in the order of their wake time - meaning once one tasks has been
 			found whose block time has not expired there is no need not look any
@@ -1673,6 +2044,7 @@ portBASE_TYPE xSwitchRequired = pdFALSE;
 					}
 				}
 			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 		}
 
 		/* Tasks of equal priority to the currently running task will share
@@ -2180,6 +2552,25 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 		to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
 		user defined low power mode	implementations require
 		configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+		#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			/* Unblocking tasks leaves the next unblock time unknown, so the
+			tick interrupt checks the wheel on every tick until it has been
+			found again.  The wheel cannot change while the scheduler is
+			suspended, which is only done for a few slots at a time so the
+			time spent with it suspended does not grow with the number of
+			slots. */
+			if( xNextTaskUnblockTimeStale != pdFALSE )
+			{
+				vTaskSuspendAll();
+				{
+					prvResetNextTaskUnblockTime();
+				}
+				( void ) xTaskResumeAll();
+			}
+		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 		#if ( configUSE_TICKLESS_IDLE != 0 )
 		{
 		portTickType xExpectedIdleTime;
@@ -2198,7 +2589,11 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 					/* Now the scheduler is suspended, the expected idle
 					time can be sampled again, and this time its value can
 					be used. */
-					configASSERT( xNextTaskUnblockTime >= xTickCount );
+					#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+						configASSERT( xNextTaskUnblockTime >= xTickCount );
+					#else
+						configASSERT( ullNextTaskUnblockTime >= taskTICK_COUNT_64() );
+					#endif
 					xExpectedIdleTime = prvGetExpectedIdleTime();
 
 					if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
@@ -2321,6 +2716,17 @@ unsigned portBASE_TYPE x;
 	}
 	#endif /* configGENERATE_RUN_TIME_STATS */
 
+	#if ( configUSE_EDF_SCHEDULING == 1 )
+	{
+		/* Only xTaskCreatePeriodic() creates periodic tasks. */
+		pxTCB->xPeriod = ( portTickType ) 0U;
+		pxTCB->xRelativeDeadline = ( portTickType ) 0U;
+		pxTCB->xReleaseTime = ( portTickType ) 0U;
+		pxTCB->xAbsoluteDeadline = ( portTickType ) 0U;
+		pxTCB->uxDeadlineMisses = ( unsigned portBASE_TYPE ) 0U;
+	}
+	#endif /* configUSE_EDF_SCHEDULING */
+
 	#if ( portUSING_MPU_WRAPPERS == 1 )
 	{
 		vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, pxTCB->pxStack, usStackDepth );
@@ -2365,8 +2771,22 @@ unsigned portBASE_TYPE uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#else
+	{
+	unsigned portBASE_TYPE uxSlot;
+
+		for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS; uxSlot++ )
+		{
+			vListInitialise( &( xDelayedTaskWheel[ uxSlot ] ) );
+		}
+	}
+	#endif
+
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -2381,10 +2801,14 @@ unsigned portBASE_TYPE uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2423,6 +2847,8 @@ static void prvCheckTasksWaitingTermination( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+
 static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 {
 	/* The list item will be inserted in wake time order. */
@@ -2447,34 +2873,268 @@ static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
 		}
 	}
 }
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
+static void prvAddCurrentTaskToDelayedList( portTickType xTimeToWake )
+{
+portTickType xTicksToWait;
+
+	/* Extend the wake time to 64 bits.  The slot for the current tick has
+	already been checked, so a wake time of now is treated as the next tick,
+	which is when the delayed lists would unblock the task. */
+	xTicksToWait = xTimeToWake - xTickCount;
+	if( xTicksToWait == ( portTickType ) 0U )
+	{
+		xTicksToWait = ( portTickType ) 1U;
+		xTimeToWake = xTickCount + xTicksToWait;
+	}
+
+	pxCurrentTCB->ullTimeToWake = taskTICK_COUNT_64() + ( unsigned long long ) xTicksToWait;
+
+	/* The slot lists are not sorted, so this takes the same time however many
+	tasks are already blocked. */
+	listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xGenericListItem ), xTimeToWake );
+	vListInsertEnd( taskDELAYED_WHEEL_SLOT( xTimeToWake ), &( pxCurrentTCB->xGenericListItem ) );
+
+	if( pxCurrentTCB->ullTimeToWake < ullNextTaskUnblockTime )
+	{
+		ullNextTaskUnblockTime = pxCurrentTCB->ullTimeToWake;
+		xNextTaskUnblockTime = xTimeToWake;
+	}
+
+	/* The slot may have been scanned already. */
+	if( pxCurrentTCB->ullTimeToWake < ullScanNextUnblockTime )
+	{
+		ullScanNextUnblockTime = pxCurrentTCB->ullTimeToWake;
+	}
+}
 /*-----------------------------------------------------------*/
 
-static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer )
+static portBASE_TYPE prvCheckDelayedTaskWheel( void )
 {
-tskTCB *pxNewTCB;
+tskTCB *pxTCB;
+xList *pxSlot;
+xListItem *pxItem, *pxNextItem;
+portBASE_TYPE xSwitchRequired = pdFALSE;
+const unsigned long long ullConstTickCount = taskTICK_COUNT_64();
 
-	/* Allocate space for the TCB.  Where the memory comes from depends on
-	the implementation of the port malloc function. */
-	pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+	/* Only the slot for this tick can hold tasks that are due now.  It can
+	also hold tasks that are due on a later revolution of the wheel, which are
+	left where they are. */
+	pxSlot = taskDELAYED_WHEEL_SLOT( xTickCount );
+	pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
 
-	if( pxNewTCB != NULL )
+	while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+	{
+		pxNextItem = ( xListItem * ) pxItem->pxNext;
+		pxTCB = ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+		if( pxTCB->ullTimeToWake <= ullConstTickCount )
+		{
+			/* It is time to remove the item from the Blocked state. */
+			( void ) uxListRemove( &( pxTCB->xGenericListItem ) );
+
+			/* Is the task waiting on an event also?  If so remove it from the
+			event list. */
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			}
+
+			/* Place the unblocked task into the appropriate ready list. */
+			prvAddTaskToReadyList( pxTCB );
+
+			/* A task being unblocked cannot cause an immediate context
+			switch if preemption is turned off. */
+			#if (  configUSE_PREEMPTION == 1 )
+			{
+				/* Preemption is on, but a context switch should only be
+				performed if the unblocked task has a priority that is equal
+				to or higher than the currently executing task. */
+				if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+			}
+			#endif /* configUSE_PREEMPTION */
+		}
+
+		pxItem = pxNextItem;
+	}
+
+	/* Finding the next wake time means scanning the whole wheel, which is
+	left to the idle task.  Until then every tick checks its own slot.  A scan
+	that is already under way carries on: tasks have only left the wheel
+	since it started, so what it has found is still no later than the next
+	wake time. */
+	if( xNextTaskUnblockTimeStale == pdFALSE )
+	{
+		uxNextSlotToScan = ( unsigned portBASE_TYPE ) 0U;
+		ullScanNextUnblockTime = ~( ( unsigned long long ) 0U );
+	}
+	ullNextTaskUnblockTime = ullConstTickCount + 1U;
+	xNextTaskUnblockTime = xTickCount + ( portTickType ) 1U;
+	xNextTaskUnblockTimeStale = pdTRUE;
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+unsigned portBASE_TYPE uxSlot;
+xList *pxSlot;
+xListItem *pxItem;
+
+	for( uxSlot = ( unsigned portBASE_TYPE ) 0U; ( uxSlot < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SCAN_SLOTS ) && ( uxNextSlotToScan < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS ); uxSlot++ )
+	{
+		pxSlot = &( xDelayedTaskWheel[ uxNextSlotToScan ] );
+		uxNextSlotToScan++;
+
+		for( pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext; pxItem != ( xListItem * ) &( pxSlot->xListEnd ); pxItem = ( xListItem * ) pxItem->pxNext )
+		{
+			if( ( ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem ) )->ullTimeToWake < ullScanNextUnblockTime )
+			{
+				ullScanNextUnblockTime = ( ( tskTCB * ) listGET_LIST_ITEM_OWNER( pxItem ) )->ullTimeToWake;
+			}
+		}
+	}
+
+	if( uxNextSlotToScan < ( unsigned portBASE_TYPE ) configDELAYED_TASK_WHEEL_SLOTS )
+	{
+		/* Carry on from here on the next pass of the idle task. */
+	}
+	else if( ullScanNextUnblockTime <= taskTICK_COUNT_64() )
+	{
+		/* The earliest wake time found belonged to a task that has since
+		been unblocked by its tick, so the next one is still unknown.  Scan
+		again. */
+		uxNextSlotToScan = ( unsigned portBASE_TYPE ) 0U;
+		ullScanNextUnblockTime = ~( ( unsigned long long ) 0U );
+	}
+	else
+	{
+		/* An empty wheel gives portMAX_DELAY, as an empty delayed list
+		does. */
+		ullNextTaskUnblockTime = ullScanNextUnblockTime;
+		xNextTaskUnblockTime = ( portTickType ) ullScanNextUnblockTime;
+		xNextTaskUnblockTimeStale = pdFALSE;
+	}
+}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+	static void prvInsertTaskByDeadline( tskTCB *pxTCB )
 	{
-		/* Allocate space for the stack used by the task being created.
-		The base of the stack memory stored in the TCB so the task can
-		be deleted later if required. */
-		pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t ) usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	xList * const pxList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+	xListItem * const pxNewListItem = &( pxTCB->xGenericListItem );
+	xListItem *pxIterator;
+	portTickType xDeadline;
 
-		if( pxNewTCB->pxStack == NULL )
+		/* A task that is not periodic can only be at this priority because it
+		has inherited it from a periodic task that is waiting for a mutex it
+		holds.  It is treated as being due now so the mutex is released as
+		soon as possible. */
+		if( pxTCB->xPeriod == ( portTickType ) 0U )
 		{
-			/* Could not allocate the stack.  Delete the allocated TCB. */
-			vPortFree( pxNewTCB );
-			pxNewTCB = NULL;
+			xDeadline = xTickCount;
 		}
 		else
 		{
-			/* Just to help debugging. */
-			( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
+			xDeadline = pxTCB->xAbsoluteDeadline;
+		}
+
+		listSET_LIST_ITEM_VALUE( pxNewListItem, xDeadline );
+
+		/* vListInsert() cannot be used as it compares the deadlines directly,
+		which gives the wrong order once the tick count overflows. */
+		for( pxIterator = ( xListItem * ) &( pxList->xListEnd ); pxIterator->pxNext != ( xListItem * ) &( pxList->xListEnd ); pxIterator = pxIterator->pxNext )
+		{
+			if( taskDEADLINE_BEFORE( xDeadline, listGET_LIST_ITEM_VALUE( pxIterator->pxNext ) ) )
+			{
+				break;
+			}
 		}
+
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pvContainer = ( void * ) pxList;
+
+		( pxList->uxNumberOfItems )++;
+	}
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+static tskTCB *prvAllocateTCBAndStack( unsigned short usStackDepth, portSTACK_TYPE *puxStackBuffer, xStaticTask *pxTaskBuffer )
+{
+tskTCB *pxNewTCB = NULL;
+
+	#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		if( pxTaskBuffer != NULL )
+		{
+			/* The application has provided both the TCB and the stack. */
+			pxNewTCB = ( tskTCB * ) pxTaskBuffer;
+			pxNewTCB->pxStack = puxStackBuffer;
+
+			#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxNewTCB->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif
+		}
+	}
+	#else
+	{
+		( void ) pxTaskBuffer;
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxTaskBuffer == NULL )
+		{
+			/* Allocate space for the TCB.  Where the memory comes from depends
+			on the implementation of the port malloc function. */
+			pxNewTCB = ( tskTCB * ) pvPortMalloc( sizeof( tskTCB ) );
+
+			if( pxNewTCB != NULL )
+			{
+				/* Allocate space for the stack used by the task being created.
+				The base of the stack memory stored in the TCB so the task can
+				be deleted later if required. */
+				pxNewTCB->pxStack = ( portSTACK_TYPE * ) pvPortMallocAligned( ( ( ( size_t ) usStackDepth ) * sizeof( portSTACK_TYPE ) ), puxStackBuffer ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+				if( pxNewTCB->pxStack == NULL )
+				{
+					/* Could not allocate the stack.  Delete the allocated TCB. */
+					vPortFree( pxNewTCB );
+					pxNewTCB = NULL;
+				}
+				else
+				{
+					#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+					{
+						pxNewTCB->ucStaticallyAllocated = pdFALSE;
+					}
+					#endif
+				}
+			}
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+	if( pxNewTCB != NULL )
+	{
+		/* Just to help debugging. */
+		( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) usStackDepth * sizeof( portSTACK_TYPE ) );
 	}
 
 	return pxNewTCB;
@@ -2605,9 +3265,27 @@ tskTCB *pxNewTCB;
 		portCLEAN_UP_TCB( pxTCB );
 
 		/* Free up the memory allocated by the scheduler for the task.  It is up to
-		the task to free any memory allocated at the application level. */
-		vPortFreeAligned( pxTCB->pxStack );
-		vPortFree( pxTCB );
+		the task to free any memory allocated at the application level.  The
+		memory of a task created by xTaskCreateStatic() belongs to the
+		application, so is left alone. */
+		#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+		{
+			vPortFreeAligned( pxTCB->pxStack );
+			vPortFree( pxTCB );
+		}
+		#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			if( pxTCB->ucStaticallyAllocated == pdFALSE )
+			{
+				vPortFreeAligned( pxTCB->pxStack );
+				vPortFree( pxTCB );
+			}
+		}
+		#else
+		{
+			( void ) pxTCB;
+		}
+		#endif /* configSUPPORT_STATIC_ALLOCATION */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -0,0 +1,1335 @@
+/*
+ * timers.c
+ *
+ *  Created on: Aug. 27, 2020
+ *      Author: navjot
+ */
+/*
+    FreeRTOS V7.5.0 - Copyright (C) 2013 Real Time Engineers Ltd.
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that has become a de facto standard.             *
+     *                                                                       *
+     *    Help yourself get started quickly and support the FreeRTOS         *
+     *    project by purchasing a FreeRTOS tutorial book, reference          *
+     *    manual, or both from: http://www.FreeRTOS.org/Documentation        *
+     *                                                                       *
+     *    Thank you!                                                         *
+     *                                                                       *
+    ***************************************************************************
+    This file is part of the FreeRTOS distribution.
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>!AND MODIFIED BY!<< the FreeRTOS exception.
+    >>! NOTE: The modification to the GPL is included to allow you to distribute
+    >>! a combined work that includes FreeRTOS without being obliged to provide
+    >>! the source code for proprietary components outside of the FreeRTOS
+    >>! kernel.
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available from the following
+    link: http://www.freertos.org/a00114.html
+    1 tab == 4 spaces!
+    ***************************************************************************
+     *                                                                       *
+     *    Having a problem?  Start by reading the FAQ "My application does   *
+     *    not run, what could be wrong?"                                     *
+     *                                                                       *
+     *    http://www.FreeRTOS.org/FAQHelp.html                               *
+     *                                                                       *
+    ***************************************************************************
+    http://www.FreeRTOS.org - Documentation, books, training, latest versions,
+    license and Real Time Engineers Ltd. contact details.
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+    http://www.OpenRTOS.com - Real Time Engineers ltd license FreeRTOS to High
+    Integrity Systems to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and middleware.
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+to include software timer functionality.  This #if is closed at the very bottom
+of this file.  If you want to include software timer functionality then ensure
+configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_TIMERS == 1 )
+
+/* Misc definitions. */
+#define tmrNO_DELAY		( portTickType ) 0U
+
+#if ( configUSE_TIMER_WHEEL == 1 )
+
+	#if ( ( configTIMER_WHEEL_SLOTS & ( configTIMER_WHEEL_SLOTS - 1 ) ) != 0 )
+		#error configTIMER_WHEEL_SLOTS must be a power of 2.
+	#endif
+
+	/* The wheel slot that holds timers expiring at tick xTime. */
+	#define tmrWHEEL_SLOT( xTime )	( &( xTimerWheel[ ( xTime ) & ( ( portTickType ) configTIMER_WHEEL_SLOTS - ( portTickType ) 1U ) ] ) )
+
+	/* pdTRUE if xTime is at or before xNow.  Both values are absolute tick
+	counts, compared modulo the tick range, so a timer period must be less
+	than half the range of portTickType. */
+	#define tmrTIME_REACHED( xTime, xNow )	( ( ( portTickType ) ( ( xNow ) - ( xTime ) ) ) <= ( portMAX_DELAY >> 1 ) )
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	#if ( configUSE_TIMER_WHEEL == 0 )
+		#error configUSE_TIMER_DIRECT_COMMANDS requires configUSE_TIMER_WHEEL to be set to 1.
+	#endif
+
+	#if ( INCLUDE_uxTaskPriorityGet == 0 )
+		#error configUSE_TIMER_DIRECT_COMMANDS requires INCLUDE_uxTaskPriorityGet to be set to 1.
+	#endif
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+/* The definition of the timers themselves. */
+typedef struct tmrTimerControl
+{
+	const signed char		*pcTimerName;		/*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */
+	xListItem				xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management. */
+	portTickType			xTimerPeriodInTicks;/*<< How quickly and often the timer expires. */
+	unsigned portBASE_TYPE	uxAutoReload;		/*<< Set to pdTRUE if the timer should be automatically restarted once expired.  Set to pdFALSE if the timer is, in effect, a one shot timer. */
+	void 					*pvTimerID;			/*<< An ID to identify the timer.  This allows the timer to be identified when the same callback is used for multiple timers. */
+	tmrTIMER_CALLBACK		pxCallbackFunction;	/*<< The function that will be called when the timer expires. */
+	#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		unsigned char		ucStaticallyAllocated;	/*<< Set to pdTRUE if the timer was created by xTimerCreateStatic(), so is not freed when deleted. */
+	#endif
+} xTIMER;
+
+/* The definition of messages that can be sent and received on the timer
+queue. */
+typedef struct tmrTimerQueueMessage
+{
+	portBASE_TYPE			xMessageID;			/*<< The command being sent to the timer service task. */
+	portTickType			xMessageValue;		/*<< An optional value used by a subset of commands, for example, when changing the period of a timer. */
+	xTIMER *				pxTimer;			/*<< The timer to which the command will be applied. */
+} xTIMER_MESSAGE;
+
+/*lint -e956 A manual analysis and inspection has been used to determine which
+static variables must be declared volatile. */
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access xActiveTimerList. */
+	PRIVILEGED_DATA static xList xActiveTimerList1;
+	PRIVILEGED_DATA static xList xActiveTimerList2;
+	PRIVILEGED_DATA static xList *pxCurrentTimerList;
+	PRIVILEGED_DATA static xList *pxOverflowTimerList;
+
+#else
+
+	/* Hashed timing wheel.  Each slot holds, in no particular order, the
+	timers whose absolute expiry time maps onto that slot, so starting,
+	stopping or resetting a timer is a single O(1) list insert or remove.
+	Expiry times are compared modulo the tick range, so no overflow list is
+	needed.  xWheelLastTime is the last tick whose slot has been swept.
+	Only the timer service task is allowed to access the wheel. */
+	PRIVILEGED_DATA static xList xTimerWheel[ configTIMER_WHEEL_SLOTS ];
+
+	/* Timers that have reached their expire time but have not yet been
+	processed, in the order they were swept from the wheel (expire time order
+	unless the timer service task fell more than one revolution behind).
+	They are processed one at a time, as the head of the sorted list is, so
+	commands received in between are applied in the same order. */
+	PRIVILEGED_DATA static xList xExpiredTimerList;
+	PRIVILEGED_DATA static portTickType xWheelLastTime = ( portTickType ) 0U;
+	PRIVILEGED_DATA static unsigned portBASE_TYPE uxWheelActiveTimers = ( unsigned portBASE_TYPE ) 0U;
+
+	/* Cache of the nearest expiry time, so the wheel is only scanned after
+	timers have been processed.  Inserting an earlier timer updates it.
+	Stopping the timer it refers to leaves it in place, which only costs one
+	early wake of the timer service task. */
+	PRIVILEGED_DATA static portTickType xWheelNextExpireTime = ( portTickType ) 0U;
+	PRIVILEGED_DATA static portBASE_TYPE xWheelNextExpireTimeValid = pdFALSE;
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/* Set by the timer service task, with the scheduler suspended, just before
+	it blocks, and cleared when it next runs.  While it is set the timer
+	service task is not using the wheel, so a task can apply a command to the
+	wheel itself from within a critical section.  xTimerTaskWakeTime is the
+	time the timer service task will unblock at if xTimerTaskWakeTimeValid is
+	pdTRUE, otherwise it will only unblock when a command is received. */
+	PRIVILEGED_DATA static volatile portBASE_TYPE xTimerTaskBlocked = pdFALSE;
+	PRIVILEGED_DATA static portTickType xTimerTaskWakeTime = ( portTickType ) 0U;
+	PRIVILEGED_DATA static portBASE_TYPE xTimerTaskWakeTimeValid = pdFALSE;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+/* A queue that is used to send commands to the timer service task. */
+PRIVILEGED_DATA static xQueueHandle xTimerQueue = NULL;
+
+#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+
+	PRIVILEGED_DATA static xTaskHandle xTimerTaskHandle = NULL;
+
+#endif
+
+/*lint +e956 */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialise the infrastructure used by the timer service task if it has not
+ * been initialised already.
+ */
+static void prvCheckForValidListAndQueue( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialise the members of a timer created by either xTimerCreate() or
+ * xTimerCreateStatic().
+ */
+static void prvInitialiseNewTimer( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xTIMER *pxNewTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Release the memory of a deleted timer, unless it belongs to the application.
+ */
+static void prvFreeTimer( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * The timer service task (daemon).  Timer functionality is controlled by this
+ * task.  Other tasks communicate with the timer service task using the
+ * xTimerQueue queue.
+ */
+static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the timer service task to interpret and process a command it
+ * received on the timer queue.
+ */
+static void	prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
+ * depending on if the expire time causes a timer counter overflow.  When
+ * configUSE_TIMER_WHEEL is 1 the timer is instead appended to the wheel slot
+ * selected by its expiry time.
+ */
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * An active timer has reached its expire time.  Reload the timer if it is an
+ * auto reload timer, then call its callback.  When configUSE_TIMER_WHEEL is 1
+ * every timer that has reached its expire time by xTimeNow is first moved to
+ * the list of expired timers, and the one that expired first is processed.
+ */
+static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( portTickType xLastTime ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Remove an active timer from the wheel, or from the list of expired
+	 * timers that have not been processed yet.
+	 */
+	static void prvRemoveTimerFromWheel( xTIMER *pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Insert a timer that has reached its expire time into the list of
+	 * expired timers, ordered by how long ago it expired.
+	 */
+	static void prvInsertExpiredTimer( xListItem *pxNewListItem, portTickType xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Scan one revolution of the wheel for the nearest expiry time and cache
+	 * it in xWheelNextExpireTime.
+	 */
+	static void prvFindNextExpireTime( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
+
+/*
+ * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
+ * if a tick count overflow occurred since prvSampleTimeNow() was last called.
+ */
+static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+
+/*
+ * If the timer list contains any active timers then return the expire time of
+ * the timer that will expire first and set *pxListWasEmpty to false.  If the
+ * timer list does not contain any timers then return 0 and set *pxListWasEmpty
+ * to pdTRUE.
+ */
+static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * If a timer has expired, process it.  Otherwise, block the timer service task
+ * until either a timer does expire or a command is received.
+ */
+static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	/*
+	 * Apply a command from a task to the wheel without going through the timer
+	 * queue.  This is only done while the timer service task is blocked, there
+	 * are no queued commands the new command could overtake, and the command
+	 * cannot need the timer service task to unblock earlier than it already
+	 * will.  Returns pdPASS if the command was applied, otherwise pdFAIL and
+	 * the command must be sent on the timer queue instead.
+	 */
+	static portBASE_TYPE prvApplyCommandDirectly( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTimerCreateTimerTask( void )
+{
+portBASE_TYPE xReturn = pdFAIL;
+
+	/* This function is called when the scheduler is started if
+	configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
+	timer service task has been created/initialised.  If timers have already
+	been created then the initialisation will already have been performed. */
+	prvCheckForValidListAndQueue();
+
+	if( xTimerQueue != NULL )
+	{
+		#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+		{
+		xStaticTask *pxTimerTaskTCBBuffer = NULL;
+		portSTACK_TYPE *pxTimerTaskStackBuffer = NULL;
+		unsigned short usTimerTaskStackSize = ( unsigned short ) configTIMER_TASK_STACK_DEPTH;
+		xTaskHandle xCreatedTask;
+
+			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &usTimerTaskStackSize );
+			xCreatedTask = xTaskCreateStatic( prvTimerTask, ( const signed char * ) "Tmr Svc", usTimerTaskStackSize, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, pxTimerTaskStackBuffer, pxTimerTaskTCBBuffer );
+
+			if( xCreatedTask != NULL )
+			{
+				xReturn = pdPASS;
+			}
+
+			#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+			{
+				xTimerTaskHandle = xCreatedTask;
+			}
+			#endif
+		}
+		#elif ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+		{
+			/* Create the timer task, storing its handle in xTimerTaskHandle so
+			it can be returned by the xTimerGetTimerDaemonTaskHandle() function. */
+			xReturn = xTaskCreate( prvTimerTask, ( const signed char * ) "Tmr Svc", ( unsigned short ) configTIMER_TASK_STACK_DEPTH, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, &xTimerTaskHandle );
+		}
+		#else
+		{
+			/* Create the timer task without storing its handle. */
+			xReturn = xTaskCreate( prvTimerTask, ( const signed char * ) "Tmr Svc", ( unsigned short ) configTIMER_TASK_STACK_DEPTH, NULL, ( ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT, NULL);
+		}
+		#endif
+	}
+
+	configASSERT( xReturn );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreate( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction )
+	{
+	xTIMER *pxNewTimer;
+
+		/* Allocate the timer structure. */
+		if( xTimerPeriodInTicks == ( portTickType ) 0U )
+		{
+			pxNewTimer = NULL;
+			configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		}
+		else
+		{
+			pxNewTimer = ( xTIMER * ) pvPortMalloc( sizeof( xTIMER ) );
+			if( pxNewTimer != NULL )
+			{
+				#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					pxNewTimer->ucStaticallyAllocated = pdFALSE;
+				}
+				#endif
+
+				prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+			}
+			else
+			{
+				traceTIMER_CREATE_FAILED();
+			}
+		}
+
+		return ( xTimerHandle ) pxNewTimer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	xTimerHandle xTimerCreateStatic( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xStaticTimer *pxTimerBuffer )
+	{
+	xTIMER *pxNewTimer = NULL;
+
+		configASSERT( ( xTimerPeriodInTicks > 0 ) );
+		configASSERT( pxTimerBuffer );
+
+		/* xStaticTimer must be exactly the size of the timer structure it
+		holds.  If this fails the structures in timers.h and timers.c are out
+		of step. */
+		configASSERT( ( sizeof( xStaticTimer ) == sizeof( xTIMER ) ) );
+
+		if( ( xTimerPeriodInTicks != ( portTickType ) 0U ) && ( pxTimerBuffer != NULL ) )
+		{
+			pxNewTimer = ( xTIMER * ) pxTimerBuffer;
+
+			#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pxNewTimer->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif
+
+			prvInitialiseNewTimer( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+		}
+		else
+		{
+			traceTIMER_CREATE_FAILED();
+		}
+
+		return ( xTimerHandle ) pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewTimer( const signed char * const pcTimerName, portTickType xTimerPeriodInTicks, unsigned portBASE_TYPE uxAutoReload, void *pvTimerID, tmrTIMER_CALLBACK pxCallbackFunction, xTIMER *pxNewTimer )
+{
+	/* Ensure the infrastructure used by the timer service task has been
+	created/initialised. */
+	prvCheckForValidListAndQueue();
+
+	/* Initialise the timer structure members using the function parameters. */
+	pxNewTimer->pcTimerName = pcTimerName;
+	pxNewTimer->xTimerPeriodInTicks = xTimerPeriodInTicks;
+	pxNewTimer->uxAutoReload = uxAutoReload;
+	pxNewTimer->pvTimerID = pvTimerID;
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+
+	traceTIMER_CREATE( pxNewTimer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeTimer( xTIMER *pxTimer )
+{
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+	{
+		vPortFree( pxTimer );
+	}
+	#elif ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxTimer->ucStaticallyAllocated == pdFALSE )
+		{
+			vPortFree( pxTimer );
+		}
+	}
+	#else
+	{
+		( void ) pxTimer;
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTimerGenericCommand( xTimerHandle xTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue, signed portBASE_TYPE *pxHigherPriorityTaskWoken, portTickType xBlockTime )
+{
+portBASE_TYPE xReturn = pdFAIL;
+xTIMER_MESSAGE xMessage;
+
+	/* Send a message to the timer service task to perform a particular action
+	on a particular timer definition. */
+	if( xTimerQueue != NULL )
+	{
+		/* Send a command to the timer service task to start the xTimer timer. */
+		xMessage.xMessageID = xCommandID;
+		xMessage.xMessageValue = xOptionalValue;
+		xMessage.pxTimer = ( xTIMER * ) xTimer;
+
+		if( pxHigherPriorityTaskWoken == NULL )
+		{
+			#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+			{
+				/* A task that does not have a priority above the timer
+				service task would otherwise have to wait for a context
+				switch to the timer service task before the command took
+				effect.  Higher priority tasks use the queue, as posting to
+				it does not cause a context switch for them.  Until the
+				scheduler is running there is no calling task to ask the
+				priority of, and the timer service task is not blocked, so
+				the queue is used. */
+				if( ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) &&
+					( uxTaskPriorityGet( NULL ) <= ( unsigned portBASE_TYPE ) configTIMER_TASK_PRIORITY ) )
+				{
+					xReturn = prvApplyCommandDirectly( xMessage.pxTimer, xCommandID, xOptionalValue );
+				}
+			}
+			#endif
+
+			if( xReturn == pdFAIL )
+			{
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xBlockTime );
+				}
+				else
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+				}
+			}
+		}
+		else
+		{
+			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		}
+
+		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTimerGetTimerDaemonTaskHandle == 1 )
+
+	xTaskHandle xTimerGetTimerDaemonTaskHandle( void )
+	{
+		/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
+		started, then xTimerTaskHandle will be NULL. */
+		configASSERT( ( xTimerTaskHandle != NULL ) );
+		return xTimerTaskHandle;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+{
+xTIMER *pxTimer;
+portBASE_TYPE xResult;
+
+	/* Remove the timer from the list of active timers.  A check has already
+	been performed to ensure the list is not empty. */
+	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	traceTIMER_EXPIRED( pxTimer );
+
+	/* If the timer is an auto reload timer then calculate the next
+	expiry time and re-insert the timer in the list of active timers. */
+	if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+	{
+		/* This is the only time a timer is inserted into a list using
+		a time relative to anything other than the current time.  It
+		will therefore be inserted into the correct list relative to
+		the time this task thinks it is now, even if a command to
+		switch lists due to a tick count overflow is already waiting in
+		the timer queue. */
+		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+		{
+			/* The timer expired before it was added to the active timer
+			list.  Reload it now.  */
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+			configASSERT( xResult );
+			( void ) xResult;
+		}
+	}
+
+	/* Call the timer callback. */
+	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
+static void prvProcessExpiredTimer( portTickType xNextExpireTime, portTickType xTimeNow )
+{
+xList *pxSlot;
+xListItem *pxItem, *pxNextItem;
+portTickType xSlotsToSweep, xSlot;
+xTIMER *pxTimer;
+portBASE_TYPE xResult;
+
+	/* Sweep the slot of every tick since the wheel was last swept, once
+	each, moving the timers that are due to the list of expired timers.  A
+	slot also holds timers that are due on a later revolution of the wheel,
+	so each timer's own expire time is checked. */
+	xSlotsToSweep = xTimeNow - xWheelLastTime;
+	if( xSlotsToSweep > ( portTickType ) configTIMER_WHEEL_SLOTS )
+	{
+		xSlotsToSweep = ( portTickType ) configTIMER_WHEEL_SLOTS;
+	}
+
+	for( xSlot = ( portTickType ) 1U; xSlot <= xSlotsToSweep; xSlot++ )
+	{
+		pxSlot = tmrWHEEL_SLOT( xWheelLastTime + xSlot );
+		pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext;
+
+		while( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+		{
+			pxNextItem = ( xListItem * ) pxItem->pxNext;
+
+			if( tmrTIME_REACHED( listGET_LIST_ITEM_VALUE( pxItem ), xTimeNow ) != pdFALSE )
+			{
+				/* Still counted in uxWheelActiveTimers. */
+				( void ) uxListRemove( pxItem );
+				prvInsertExpiredTimer( pxItem, xTimeNow );
+			}
+
+			pxItem = pxNextItem;
+		}
+	}
+
+	xWheelLastTime = xTimeNow;
+	xWheelNextExpireTimeValid = pdFALSE;
+
+	/* Nothing is due if the timer the cached next expire time referred to
+	has been stopped since. */
+	if( listLIST_IS_EMPTY( &xExpiredTimerList ) != pdFALSE )
+	{
+		return;
+	}
+
+	/* Process the timer that expired first.  A command to stop or reset a
+	timer that is still in the expired list is applied before it is reached,
+	just as if it were still in the sorted active list. */
+	pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( &xExpiredTimerList );
+	xNextExpireTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	prvRemoveTimerFromWheel( pxTimer );
+	traceTIMER_EXPIRED( pxTimer );
+
+	/* If the timer is an auto reload timer then calculate the next expiry
+	time relative to the time it was due, and re-insert it in the wheel. */
+	if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+	{
+		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) == pdTRUE )
+		{
+			/* The timer expired before it was added to the wheel.  Reload it
+			now.  */
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+			configASSERT( xResult );
+			( void ) xResult;
+		}
+	}
+
+	/* Call the timer callback. */
+	pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvTimerTask( void *pvParameters )
+{
+portTickType xNextExpireTime;
+portBASE_TYPE xListWasEmpty;
+
+	/* Just to avoid compiler warnings. */
+	( void ) pvParameters;
+
+	for( ;; )
+	{
+		/* Query the timers list to see if it contains any timers, and if so,
+		obtain the time at which the next timer will expire. */
+		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+
+		/* If a timer has expired, process it.  Otherwise, block this task
+		until either a timer does expire, or a command is received. */
+		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+
+		/* Empty the command queue. */
+		prvProcessReceivedCommands();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvProcessTimerOrBlockTask( portTickType xNextExpireTime, portBASE_TYPE xListWasEmpty )
+{
+portTickType xTimeNow;
+portBASE_TYPE xTimerListsWereSwitched;
+
+	vTaskSuspendAll();
+	{
+		/* Obtain the time now to make an assessment as to whether the timer
+		has expired or not.  If obtaining the time causes the lists to switch
+		then don't process this timer as any timers that remained in the list
+		when the lists were switched will have been processed within the
+		prvSampelTimeNow() function. */
+		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+		if( xTimerListsWereSwitched == pdFALSE )
+		{
+			/* The tick count has not overflowed, has the timer expired? */
+			#if ( configUSE_TIMER_WHEEL == 0 )
+				if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#else
+				if( ( xListWasEmpty == pdFALSE ) && ( tmrTIME_REACHED( xNextExpireTime, xTimeNow ) != pdFALSE ) )
+			#endif
+			{
+				( void ) xTaskResumeAll();
+				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+			}
+			else
+			{
+				/* The tick count has not overflowed, and the next expire
+				time has not been reached yet.  This task should therefore
+				block to wait for the next expire time or a command to be
+				received - whichever comes first.  The following line cannot
+				be reached unless xNextExpireTime > xTimeNow, except in the
+				case when the current timer list is empty. */
+				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ) );
+
+				#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+				{
+					/* The scheduler is suspended, so no task can be applying a
+					command directly while these are updated. */
+					xTimerTaskWakeTime = xNextExpireTime;
+					xTimerTaskWakeTimeValid = ( xListWasEmpty == pdFALSE ) ? pdTRUE : pdFALSE;
+					xTimerTaskBlocked = pdTRUE;
+				}
+				#endif
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					/* Yield to wait for either a command to arrive, or the block time
+					to expire.  If a command arrived between the critical section being
+					exited and this yield then the yield will not cause the task
+					to block. */
+					portYIELD_WITHIN_API();
+				}
+
+				#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+				{
+					/* This task is running, so no other task can be inside the
+					critical section used to apply a command directly. */
+					xTimerTaskBlocked = pdFALSE;
+				}
+				#endif
+			}
+		}
+		else
+		{
+			( void ) xTaskResumeAll();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+{
+portTickType xNextExpireTime;
+
+	/* Timers are listed in expiry time order, with the head of the list
+	referencing the task that will expire first.  Obtain the time at which
+	the timer with the nearest expiry time will expire.  If there are no
+	active timers then just set the next expire time to 0.  That will cause
+	this task to unblock when the tick count overflows, at which point the
+	timer lists will be switched and the next expiry time can be
+	re-assessed.  */
+	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+	if( *pxListWasEmpty == pdFALSE )
+	{
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+	}
+	else
+	{
+		/* Ensure the task unblocks when the tick count rolls over. */
+		xNextExpireTime = ( portTickType ) 0U;
+	}
+
+	return xNextExpireTime;
+}
+/*-----------------------------------------------------------*/
+
+static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+{
+portTickType xTimeNow;
+PRIVILEGED_DATA static portTickType xLastTime = ( portTickType ) 0U; /*lint !e956 Variable is only accessible to one task. */
+
+	xTimeNow = xTaskGetTickCount();
+
+	if( xTimeNow < xLastTime )
+	{
+		prvSwitchTimerLists( xLastTime );
+		*pxTimerListsWereSwitched = pdTRUE;
+	}
+	else
+	{
+		*pxTimerListsWereSwitched = pdFALSE;
+	}
+
+	xLastTime = xTimeNow;
+
+	return xTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
+{
+portBASE_TYPE xProcessTimerNow = pdFALSE;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	if( xNextExpiryTime <= xTimeNow )
+	{
+		/* Has the expiry time elapsed between the command to start/reset a
+		timer was issued, and the time the command was processed? */
+		if( ( xTimeNow - xCommandTime ) >= pxTimer->xTimerPeriodInTicks )
+		{
+			/* The time between a command being issued and the command being
+			processed actually exceeds the timers period.  */
+			xProcessTimerNow = pdTRUE;
+		}
+		else
+		{
+			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+		}
+	}
+	else
+	{
+		if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+		{
+			/* If, since the command was issued, the tick count has overflowed
+			but the expiry time has not, then the timer must have already passed
+			its expiry time and should be processed immediately. */
+			xProcessTimerNow = pdTRUE;
+		}
+		else
+		{
+			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+		}
+	}
+
+	return xProcessTimerNow;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
+static portTickType prvGetNextExpireTime( portBASE_TYPE *pxListWasEmpty )
+{
+portTickType xNextExpireTime;
+
+	/* If there are no active timers then return 0, exactly as the list
+	implementation does, so this task unblocks when the tick count rolls
+	over. */
+	*pxListWasEmpty = ( uxWheelActiveTimers == ( unsigned portBASE_TYPE ) 0U ) ? pdTRUE : pdFALSE;
+	if( *pxListWasEmpty != pdFALSE )
+	{
+		xNextExpireTime = ( portTickType ) 0U;
+	}
+	else if( listLIST_IS_EMPTY( &xExpiredTimerList ) == pdFALSE )
+	{
+		/* A timer that has already expired is waiting to be processed. */
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( &xExpiredTimerList );
+	}
+	else
+	{
+		if( xWheelNextExpireTimeValid == pdFALSE )
+		{
+			prvFindNextExpireTime();
+		}
+
+		xNextExpireTime = xWheelNextExpireTime;
+	}
+
+	return xNextExpireTime;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFindNextExpireTime( void )
+{
+portTickType xSlot, xTime;
+xList *pxSlot;
+xListItem *pxItem;
+
+	/* Search one revolution of the wheel, nearest tick first, for a
+	timer that is due on that tick.  If every active timer is further
+	away than that, wake after one revolution and search again. */
+	xWheelNextExpireTime = xWheelLastTime + ( portTickType ) configTIMER_WHEEL_SLOTS;
+
+	for( xSlot = ( portTickType ) 1U; xSlot <= ( portTickType ) configTIMER_WHEEL_SLOTS; xSlot++ )
+	{
+		xTime = xWheelLastTime + xSlot;
+		pxSlot = tmrWHEEL_SLOT( xTime );
+
+		for( pxItem = ( xListItem * ) pxSlot->xListEnd.pxNext; pxItem != ( xListItem * ) &( pxSlot->xListEnd ); pxItem = ( xListItem * ) pxItem->pxNext )
+		{
+			if( listGET_LIST_ITEM_VALUE( pxItem ) == xTime )
+			{
+				break;
+			}
+		}
+
+		if( pxItem != ( xListItem * ) &( pxSlot->xListEnd ) )
+		{
+			xWheelNextExpireTime = xTime;
+			break;
+		}
+	}
+
+	xWheelNextExpireTimeValid = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static portTickType prvSampleTimeNow( portBASE_TYPE *pxTimerListsWereSwitched )
+{
+	/* The wheel compares times modulo the tick range, so there are never any
+	lists to switch. */
+	*pxTimerListsWereSwitched = pdFALSE;
+
+	return xTaskGetTickCount();
+}
+/*-----------------------------------------------------------*/
+
+static portBASE_TYPE prvInsertTimerInActiveList( xTIMER *pxTimer, portTickType xNextExpiryTime, portTickType xTimeNow, portTickType xCommandTime )
+{
+portBASE_TYPE xProcessTimerNow = pdFALSE;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	/* Has the expiry time elapsed between the command to start/reset a timer
+	being issued and the command being processed?  Measuring both intervals
+	from the command time gives the same answer as the list implementation,
+	whether or not the tick count has overflowed in between.  The casts keep
+	each difference modulo the tick range when portTickType is narrower than
+	an int, as it is with 16-bit ticks. */
+	if( ( portTickType ) ( xTimeNow - xCommandTime ) >= ( portTickType ) ( xNextExpiryTime - xCommandTime ) )
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		if( uxWheelActiveTimers == ( unsigned portBASE_TYPE ) 0U )
+		{
+			/* The wheel is only swept while it holds timers, so it may have
+			been left behind by any number of ticks.  Nothing is due between
+			the last sweep and now, so move it up to now rather than measure
+			the new expiry time from a base that may be more than half the
+			tick range in the past. */
+			xWheelLastTime = xTimeNow;
+			xWheelNextExpireTimeValid = pdFALSE;
+		}
+
+		vListInsertEnd( tmrWHEEL_SLOT( xNextExpiryTime ), &( pxTimer->xTimerListItem ) );
+		uxWheelActiveTimers++;
+
+		if( ( xWheelNextExpireTimeValid != pdFALSE ) && ( ( portTickType ) ( xNextExpiryTime - xWheelLastTime ) < ( portTickType ) ( xWheelNextExpireTime - xWheelLastTime ) ) )
+		{
+			xWheelNextExpireTime = xNextExpiryTime;
+		}
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertExpiredTimer( xListItem *pxNewListItem, portTickType xTimeNow )
+{
+xListItem *pxIterator;
+portTickType xAge;
+
+	/* Keep the expired list in the order the timers expired, oldest first,
+	so they are processed in the same order as from the sorted active list.
+	The expire times cannot be compared directly as the tick count may have
+	overflowed, but how long ago each expired can.  Timers are normally
+	swept in the order they expired, so the search from the end of the list
+	stops straight away - it only moves when the wheel has been swept more
+	than one revolution at once. */
+	xAge = xTimeNow - listGET_LIST_ITEM_VALUE( pxNewListItem );
+
+	for( pxIterator = ( xListItem * ) xExpiredTimerList.xListEnd.pxPrevious; pxIterator != ( xListItem * ) &( xExpiredTimerList.xListEnd ); pxIterator = pxIterator->pxPrevious )
+	{
+		if( ( portTickType ) ( xTimeNow - listGET_LIST_ITEM_VALUE( pxIterator ) ) >= xAge )
+		{
+			break;
+		}
+	}
+
+	pxNewListItem->pxNext = pxIterator->pxNext;
+	pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+	pxNewListItem->pxPrevious = pxIterator;
+	pxIterator->pxNext = pxNewListItem;
+	pxNewListItem->pvContainer = ( void * ) &xExpiredTimerList;
+
+	( xExpiredTimerList.uxNumberOfItems )++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimerFromWheel( xTIMER *pxTimer )
+{
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	uxWheelActiveTimers--;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+	static portBASE_TYPE prvApplyCommandDirectly( xTIMER *pxTimer, portBASE_TYPE xCommandID, portTickType xOptionalValue )
+	{
+	portBASE_TYPE xReturn = pdFAIL;
+	portTickType xTimeNow, xCommandTime, xNextExpiryTime;
+
+		taskENTER_CRITICAL();
+		{
+			if( ( xTimerTaskBlocked != pdFALSE ) && ( uxQueueMessagesWaiting( xTimerQueue ) == ( unsigned portBASE_TYPE ) 0U ) )
+			{
+				xTimeNow = xTaskGetTickCount();
+
+				switch( xCommandID )
+				{
+					case tmrCOMMAND_START :
+						xCommandTime = xOptionalValue;
+						xNextExpiryTime = xOptionalValue + pxTimer->xTimerPeriodInTicks;
+						break;
+
+					case tmrCOMMAND_CHANGE_PERIOD :
+						configASSERT( ( xOptionalValue > 0 ) );
+						xCommandTime = xTimeNow;
+						xNextExpiryTime = xTimeNow + xOptionalValue;
+						break;
+
+					default :
+						xCommandTime = xTimeNow;
+						xNextExpiryTime = xTimeNow;
+						break;
+				}
+
+				if( ( xTimerTaskWakeTimeValid != pdFALSE ) && ( tmrTIME_REACHED( xTimerTaskWakeTime, xTimeNow ) != pdFALSE ) )
+				{
+					/* A timer may be due.  It must be processed before this
+					command is, so the queue is used. */
+				}
+				else if( ( xCommandID == tmrCOMMAND_STOP ) || ( xCommandID == tmrCOMMAND_DELETE ) )
+				{
+					/* Removing a timer never needs the timer service task to
+					unblock earlier.  At worst it unblocks with nothing to
+					do. */
+					xReturn = pdPASS;
+				}
+				else if( xTimerTaskWakeTimeValid != pdFALSE )
+				{
+					/* The timer can be inserted directly if it will not expire
+					before the timer service task unblocks anyway, as is the
+					case when a timer that is already running is reset. */
+					if( ( portTickType ) ( xNextExpiryTime - xTimeNow ) >= ( portTickType ) ( xTimerTaskWakeTime - xTimeNow ) )
+					{
+						xReturn = pdPASS;
+					}
+				}
+				else
+				{
+					/* The timer service task will only unblock when a command
+					is received. */
+				}
+
+				if( xReturn == pdPASS )
+				{
+					if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+					{
+						prvRemoveTimerFromWheel( pxTimer );
+					}
+
+					traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+					if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
+					{
+						pxTimer->xTimerPeriodInTicks = xOptionalValue;
+					}
+
+					if( ( xCommandID == tmrCOMMAND_START ) || ( xCommandID == tmrCOMMAND_CHANGE_PERIOD ) )
+					{
+						/* Cannot return pdTRUE as the expiry time has not been
+						reached. */
+						( void ) prvInsertTimerInActiveList( pxTimer, xNextExpiryTime, xTimeNow, xCommandTime );
+					}
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		if( ( xReturn == pdPASS ) && ( xCommandID == tmrCOMMAND_DELETE ) )
+		{
+			/* The timer has already been removed from the wheel, just free up
+			the memory. */
+			prvFreeTimer( pxTimer );
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void	prvProcessReceivedCommands( void )
+{
+xTIMER_MESSAGE xMessage;
+xTIMER *pxTimer;
+portBASE_TYPE xTimerListsWereSwitched, xResult;
+portTickType xTimeNow;
+
+	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	{
+		pxTimer = xMessage.pxTimer;
+
+		if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE )
+		{
+			/* The timer is in a list, remove it. */
+			#if ( configUSE_TIMER_WHEEL == 0 )
+			{
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				prvRemoveTimerFromWheel( pxTimer );
+			}
+			#endif
+		}
+
+		traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.xMessageValue );
+
+		/* In this case the xTimerListsWereSwitched parameter is not used, but
+		it must be present in the function call.  prvSampleTimeNow() must be
+		called after the message is received from xTimerQueue so there is no
+		possibility of a higher priority task adding a message to the message
+		queue with a time that is ahead of the timer daemon task (because it
+		pre-empted the timer daemon task after the xTimeNow value was set). */
+		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+		switch( xMessage.xMessageID )
+		{
+			case tmrCOMMAND_START :
+				/* Start or restart a timer. */
+				if( prvInsertTimerInActiveList( pxTimer,  xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.xMessageValue ) == pdTRUE )
+				{
+					/* The timer expired before it was added to the active timer
+					list.  Process it now. */
+					pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+					if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+					{
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xMessage.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY );
+						configASSERT( xResult );
+						( void ) xResult;
+					}
+				}
+				break;
+
+			case tmrCOMMAND_STOP :
+				/* The timer has already been removed from the active list.
+				There is nothing to do here. */
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+				pxTimer->xTimerPeriodInTicks = xMessage.xMessageValue;
+				configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+				( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+				break;
+
+			case tmrCOMMAND_DELETE :
+				/* The timer has already been removed from the active list,
+				just free up the memory. */
+				prvFreeTimer( pxTimer );
+				break;
+
+			default	:
+				/* Don't expect to get here. */
+				break;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMER_WHEEL == 0 )
+
+static void prvSwitchTimerLists( portTickType xLastTime )
+{
+portTickType xNextExpireTime, xReloadTime;
+xList *pxTemp;
+xTIMER *pxTimer;
+portBASE_TYPE xResult;
+
+	/* Remove compiler warnings if configASSERT() is not defined. */
+	( void ) xLastTime;
+
+	/* The tick count has overflowed.  The timer lists must be switched.
+	If there are any timers still referenced from the current timer list
+	then they must have expired and should be processed before the lists
+	are switched. */
+	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	{
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+		/* Remove the timer from the list. */
+		pxTimer = ( xTIMER * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+
+		/* Execute its callback, then send a command to restart the timer if
+		it is an auto-reload timer.  It cannot be restarted here as the lists
+		have not yet been switched. */
+		pxTimer->pxCallbackFunction( ( xTimerHandle ) pxTimer );
+
+		if( pxTimer->uxAutoReload == ( unsigned portBASE_TYPE ) pdTRUE )
+		{
+			/* Calculate the reload value, and if the reload value results in
+			the timer going into the same timer list then it has already expired
+			and the timer should be re-inserted into the current list so it is
+			processed again within this loop.  Otherwise a command should be sent
+			to restart the timer to ensure it is only inserted into a list after
+			the lists have been swapped. */
+			xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+			if( xReloadTime > xNextExpireTime )
+			{
+				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			else
+			{
+				xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START, xNextExpireTime, NULL, tmrNO_DELAY );
+				configASSERT( xResult );
+				( void ) xResult;
+			}
+		}
+	}
+
+	pxTemp = pxCurrentTimerList;
+	pxCurrentTimerList = pxOverflowTimerList;
+	pxOverflowTimerList = pxTemp;
+}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvCheckForValidListAndQueue( void )
+{
+	/* Check that the list from which active timers are referenced, and the
+	queue used to communicate with the timer service, have been
+	initialised. */
+	taskENTER_CRITICAL();
+	{
+		if( xTimerQueue == NULL )
+		{
+			#if ( configUSE_TIMER_WHEEL == 0 )
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#else
+			{
+			unsigned portBASE_TYPE uxSlot;
+
+				for( uxSlot = ( unsigned portBASE_TYPE ) 0U; uxSlot < ( unsigned portBASE_TYPE ) configTIMER_WHEEL_SLOTS; uxSlot++ )
+				{
+					vListInitialise( &( xTimerWheel[ uxSlot ] ) );
+				}
+				vListInitialise( &xExpiredTimerList );
+				xWheelLastTime = xTaskGetTickCount();
+			}
+			#endif
+			#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* The timer queue is part of the kernel, so its memory is
+				statically allocated here rather than by the application. */
+				PRIVILEGED_DATA static xStaticQueue xStaticTimerQueue;
+				PRIVILEGED_DATA static unsigned char ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( xTIMER_MESSAGE ) ];
+
+				xTimerQueue = xQueueCreateStatic( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ), ucStaticTimerQueueStorage, &xStaticTimerQueue );
+			}
+			#else
+			{
+				xTimerQueue = xQueueCreate( ( unsigned portBASE_TYPE ) configTIMER_QUEUE_LENGTH, sizeof( xTIMER_MESSAGE ) );
+			}
+			#endif
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xTimerIsTimerActive( xTimerHandle xTimer )
+{
+portBASE_TYPE xTimerIsInActiveList;
+xTIMER *pxTimer = ( xTIMER * ) xTimer;
+
+	/* Is the timer in the list of active timers? */
+	taskENTER_CRITICAL();
+	{
+		/* Checking to see if it is in the NULL list in effect checks to see if
+		it is referenced from either the current or the overflow timer lists in
+		one go, but the logic has to be reversed, hence the '!'. */
+		xTimerIsInActiveList = !( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) );
+	}
+	taskEXIT_CRITICAL();
+
+	return xTimerIsInActiveList;
+}
+/*-----------------------------------------------------------*/
+
+void *pvTimerGetTimerID( xTimerHandle xTimer )
+{
+xTIMER *pxTimer = ( xTIMER * ) xTimer;
+
+	return pxTimer->pvTimerID;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include software timer functionality.  If you want to include software timer
+functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TIMERS == 1 */
+
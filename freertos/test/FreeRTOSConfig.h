@@ -0,0 +1,75 @@
+/*
+ * @brief FreeRTOS configuration for the kernel host tests
+ *
+ * @note
+ * The POSIX host configuration, with the settings the tests vary left to
+ * the compiler command line, for example -DconfigUSE_16_BIT_TICKS=1.  See
+ * readme.txt in this directory.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+#include <assert.h>
+
+#define configUSE_PREEMPTION		1
+#define configUSE_IDLE_HOOK			0
+#define configMAX_PRIORITIES		( ( unsigned portBASE_TYPE ) 8 )
+#ifndef configUSE_TICK_HOOK
+#define configUSE_TICK_HOOK			0
+#endif
+#ifndef configCPU_CLOCK_HZ
+#define configCPU_CLOCK_HZ			( ( unsigned long ) 1000000 )
+#endif
+#ifndef configTICK_RATE_HZ
+#define configTICK_RATE_HZ			( ( portTickType ) 1000 )
+#endif
+#define configMINIMAL_STACK_SIZE	( ( unsigned short ) 128 )
+#define configTOTAL_HEAP_SIZE		( ( size_t ) ( 0 ) )
+#define configMAX_TASK_NAME_LEN		( 20 )
+#define configUSE_TRACE_FACILITY	1
+#ifndef configUSE_16_BIT_TICKS
+#define configUSE_16_BIT_TICKS		0
+#endif
+#define configIDLE_SHOULD_YIELD		1
+#define configUSE_CO_ROUTINES 		0
+#define configUSE_MUTEXES			1
+#ifndef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE		0
+#endif
+
+#define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
+
+#define configUSE_COUNTING_SEMAPHORES 	1
+#define configUSE_ALTERNATIVE_API 		0
+#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configQUEUE_REGISTRY_SIZE		10
+#define configGENERATE_RUN_TIME_STATS	0
+
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#ifndef configTIMER_QUEUE_LENGTH
+#define configTIMER_QUEUE_LENGTH		10
+#endif
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
+
+/* Interrupt priority the LPCOpen hooks use when a test builds them */
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY		31
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet			1
+#define INCLUDE_uxTaskPriorityGet			1
+#define INCLUDE_vTaskDelete					1
+#define INCLUDE_vTaskCleanUpResources		0
+#define INCLUDE_vTaskSuspend				1
+#define INCLUDE_vTaskDelayUntil				1
+#define INCLUDE_vTaskDelay					1
+#define INCLUDE_uxTaskGetStackHighWaterMark	1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+
+#define configASSERT( x )	assert( x )
+
+#endif /* FREERTOS_CONFIG_H */
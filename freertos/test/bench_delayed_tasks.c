@@ -0,0 +1,179 @@
+/*
+ * @brief Host benchmark of the delayed task lists against the number of tasks
+ *
+ * @note
+ * Builds tasks.c into this file, as test_tickless.c does with the hooks, and
+ * blocks 10 to 10000 task control blocks with random wake times without
+ * running the scheduler.  It times what the kernel does with interrupts
+ * masked or the scheduler suspended:
+ *   - the insert of a task into the delayed lists when it blocks
+ *     (prvAddCurrentTaskToDelayedList()), which walks the sorted list by
+ *     default and is a constant time slot insert with
+ *     configUSE_DELAYED_TASK_WHEEL=1;
+ *   - with the wheel, the longest pass of the idle task's scan for the next
+ *     wake time (prvResetNextTaskUnblockTime()), which looks at
+ *     configDELAYED_TASK_WHEEL_SCAN_SLOTS slots with the scheduler suspended.
+ *     Building with the scan slots equal to configDELAYED_TASK_WHEEL_SLOTS
+ *     gives a scan of the whole wheel in one pass.
+ *
+ * @par
+ * Inserts are timed as the mean of many.  A scan pass is timed as the
+ * longest pass of a scan, taking the best of many scans to leave out host
+ * interrupts.  The times are host times, so only the ratios between the rows
+ * and between builds mean anything.
+ *
+ * @par
+ * Build and run from the repository root, without tasks.c:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigUSE_DELAYED_TASK_WHEEL=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/bench_delayed_tasks.c freertos/src/queue.c \
+ *       freertos/src/list.c freertos/src/timers.c freertos/src/heap_3.c \
+ *       freertos/portable/Posix/port.c -lpthread -o bench_delayed_tasks
+ *   ./bench_delayed_tasks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../src/tasks.c"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_TASKS           10000
+
+/* Inserts timed per row, and full scans of the wheel */
+#define INSERTS             100000
+#define SCANS               200
+
+/* Wake times are up to this many ticks away */
+#define MAX_DELAY           100000
+
+static const int iTaskCounts[] = {10, 100, 1000, 10000};
+
+static tskTCB xTCBs[MAX_TASKS];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double prvNow(void)
+{
+	struct timespec xTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &xTime);
+	return (double) xTime.tv_sec * 1e9 + (double) xTime.tv_nsec;
+}
+
+/* Block a task control block as if it were the running task */
+static void prvBlock(tskTCB *pxTCB)
+{
+	pxCurrentTCB = pxTCB;
+	prvAddCurrentTaskToDelayedList(xTickCount + 1 + (portTickType) (rand() % MAX_DELAY));
+}
+
+/* Mean ns per insert of a task, with iCount tasks blocked */
+static double prvTimeInserts(int iCount)
+{
+	double dStart;
+	int i;
+
+	dStart = prvNow();
+	for (i = 0; i < INSERTS; i++) {
+		tskTCB *pxTCB = &xTCBs[rand() % iCount];
+
+		( void ) uxListRemove(&(pxTCB->xGenericListItem));
+		prvBlock(pxTCB);
+	}
+	return (prvNow() - dStart) / INSERTS;
+}
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* Longest pass of the idle task's scan in ns, and passes per scan */
+static double prvTimeScanPass(int *piPasses)
+{
+	double dStart, dPass, dWorst, dBest = 0;
+	int iScan;
+
+	*piPasses = 0;
+	for (iScan = 0; iScan < SCANS; iScan++) {
+		/* As the tick does when it unblocks a task */
+		uxNextSlotToScan = 0;
+		ullScanNextUnblockTime = ~( ( unsigned long long ) 0U );
+		xNextTaskUnblockTimeStale = pdTRUE;
+
+		dWorst = 0;
+		while (xNextTaskUnblockTimeStale != pdFALSE) {
+			dStart = prvNow();
+			prvResetNextTaskUnblockTime();
+			dPass = prvNow() - dStart;
+			if (dPass > dWorst) {
+				dWorst = dPass;
+			}
+			if (iScan == 0) {
+				(*piPasses)++;
+			}
+		}
+		if ((iScan == 0) || (dWorst < dBest)) {
+			dBest = dWorst;
+		}
+	}
+	return dBest;
+}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	int iRow, iBlocked = 0;
+
+	srand(1);
+	prvInitialiseTaskLists();
+	for (iBlocked = 0; iBlocked < MAX_TASKS; iBlocked++) {
+		vListInitialiseItem(&(xTCBs[iBlocked].xGenericListItem));
+		listSET_LIST_ITEM_OWNER(&(xTCBs[iBlocked].xGenericListItem), &xTCBs[iBlocked]);
+	}
+
+	#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		printf("configUSE_DELAYED_TASK_WHEEL=1, %d slots, %d scanned per pass\n",
+			   configDELAYED_TASK_WHEEL_SLOTS, configDELAYED_TASK_WHEEL_SCAN_SLOTS);
+		printf("tasks   ns per insert   ns per scan pass   passes per scan\n");
+	}
+	#else
+	{
+		printf("configUSE_DELAYED_TASK_WHEEL=0\n");
+		printf("tasks   ns per insert\n");
+	}
+	#endif
+
+	iBlocked = 0;
+	for (iRow = 0; iRow < (int) (sizeof(iTaskCounts) / sizeof(iTaskCounts[0])); iRow++) {
+		while (iBlocked < iTaskCounts[iRow]) {
+			prvBlock(&xTCBs[iBlocked++]);
+		}
+
+		#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+		{
+			double dInsert = prvTimeInserts(iTaskCounts[iRow]);
+			int iPasses;
+			double dPass = prvTimeScanPass(&iPasses);
+
+			printf("%5d   %13.0f   %16.0f   %15d\n", iTaskCounts[iRow], dInsert, dPass, iPasses);
+		}
+		#else
+		{
+			printf("%5d   %13.0f\n", iTaskCounts[iRow], prvTimeInserts(iTaskCounts[iRow]));
+		}
+		#endif
+	}
+	return 0;
+}
@@ -0,0 +1,296 @@
+/*
+ * @brief Host benchmark of static against dynamic creation of kernel objects
+ *
+ * @note
+ * Creates tasks, queues, binary semaphores, mutexes and timers before the
+ * scheduler starts, as an application does at boot, once through the heap
+ * (xTaskCreate() and friends) and once in application memory
+ * (xTaskCreateStatic() and friends).  For each object it prints the time per
+ * create, the heap allocations and bytes the dynamic path asks for, and the
+ * bytes the static path uses instead.  A last row adds up a typical boot.
+ *
+ * @par
+ * The heap is counted by this file's own pvPortMalloc(), which is heap_3.c
+ * with a count added, so heap_3.c is left off the build line.  On the chip
+ * newlib adds a header of 4 to 8 bytes to every allocation and rounds it up
+ * to 8 bytes, which the static path does not pay; the byte counts here are
+ * the host's, with 8 byte pointers, so they are larger than the chip's.
+ * Creating a task on the POSIX port also starts a host thread, which costs
+ * the same on both paths and hides most of the difference in the task row.
+ * Times are the best of several runs on the host, so only the ratios between
+ * the two paths mean anything.
+ *
+ * @par
+ * Build and run from the repository root, without heap_3.c:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigSUPPORT_STATIC_ALLOCATION=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/bench_static_alloc.c freertos/src/tasks.c \
+ *       freertos/src/queue.c freertos/src/list.c freertos/src/timers.c \
+ *       freertos/portable/Posix/port.c -lpthread -o bench_static_alloc
+ *   ./bench_static_alloc
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#if configSUPPORT_STATIC_ALLOCATION != 1 || configSUPPORT_DYNAMIC_ALLOCATION != 1
+#error Build with -DconfigSUPPORT_STATIC_ALLOCATION=1 and dynamic allocation left on
+#endif
+
+/* Objects created per run, and runs of which the best is taken */
+#define COUNT               50
+#define RUNS                5
+
+#define STACK_WORDS         configMINIMAL_STACK_SIZE
+#define QUEUE_LENGTH        10
+#define QUEUE_ITEM_SIZE     16
+
+/* Objects of each kind in the typical boot of the last row */
+#define BOOT_TASKS          8
+#define BOOT_QUEUES         4
+#define BOOT_SEMAPHORES     4
+#define BOOT_MUTEXES        2
+#define BOOT_TIMERS         4
+
+typedef enum {
+	OBJ_TASK,
+	OBJ_QUEUE,
+	OBJ_SEMAPHORE,
+	OBJ_MUTEX,
+	OBJ_TIMER,
+	OBJ_COUNT
+} OBJ_T;
+
+typedef struct {
+	const char *pcName;
+	int iBootCount;
+	double dDynamicNs;
+	double dStaticNs;
+	double dAllocs;
+	double dHeapBytes;
+	size_t xStaticBytes;
+} RESULT_T;
+
+static RESULT_T xResults[OBJ_COUNT] = {
+	{"task, 128 words", BOOT_TASKS},
+	{"queue, 10 x 16 B", BOOT_QUEUES},
+	{"binary semaphore", BOOT_SEMAPHORES},
+	{"mutex", BOOT_MUTEXES},
+	{"timer", BOOT_TIMERS},
+};
+
+/* Heap use counted by pvPortMalloc() */
+static unsigned long ulAllocs;
+static size_t xHeapBytes;
+
+/* Storage of the static path, one set per run */
+static xStaticTask xTaskBuffers[RUNS][COUNT];
+static portSTACK_TYPE xStacks[RUNS][COUNT][STACK_WORDS];
+static xStaticQueue xQueueBuffers[RUNS][COUNT];
+static unsigned char ucQueueStorage[RUNS][COUNT][QUEUE_LENGTH * QUEUE_ITEM_SIZE];
+static xStaticSemaphore xSemaphoreBuffers[RUNS][COUNT];
+static xStaticSemaphore xMutexBuffers[RUNS][COUNT];
+static xStaticTimer xTimerBuffers[RUNS][COUNT];
+
+static xStaticTask xIdleTaskBuffer, xTimerTaskBuffer;
+static portSTACK_TYPE xIdleStack[configMINIMAL_STACK_SIZE];
+static portSTACK_TYPE xTimerStack[configTIMER_TASK_STACK_DEPTH];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double prvNow(void)
+{
+	struct timespec xTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &xTime);
+	return (double) xTime.tv_sec * 1e9 + (double) xTime.tv_nsec;
+}
+
+static void prvTask(void *pvParameters)
+{
+	(void) pvParameters;
+	for (;; ) {
+		vTaskSuspend(NULL);
+	}
+}
+
+static void prvCallback(xTimerHandle xTimer)
+{
+	(void) xTimer;
+}
+
+/* Create COUNT objects of one kind on one path, returns ns per create */
+static double prvCreate(OBJ_T eObj, portBASE_TYPE xStatic, int iRun)
+{
+	double dStart;
+	void *pvHandle;
+	int i;
+
+	dStart = prvNow();
+	for (i = 0; i < COUNT; i++) {
+		switch (eObj) {
+		case OBJ_TASK:
+			if (xStatic) {
+				pvHandle = xTaskCreateStatic(prvTask, (const signed char *) "Bench", STACK_WORDS, NULL,
+											 tskIDLE_PRIORITY, xStacks[iRun][i], &xTaskBuffers[iRun][i]);
+			}
+			else {
+				pvHandle = NULL;
+				xTaskCreate(prvTask, (const signed char *) "Bench", STACK_WORDS, NULL, tskIDLE_PRIORITY,
+							(xTaskHandle *) &pvHandle);
+			}
+			break;
+
+		case OBJ_QUEUE:
+			pvHandle = xStatic ?
+					   xQueueCreateStatic(QUEUE_LENGTH, QUEUE_ITEM_SIZE, ucQueueStorage[iRun][i],
+										  &xQueueBuffers[iRun][i]) :
+					   xQueueCreate(QUEUE_LENGTH, QUEUE_ITEM_SIZE);
+			break;
+
+		case OBJ_SEMAPHORE:
+			if (xStatic) {
+				pvHandle = xSemaphoreCreateBinaryStatic(&xSemaphoreBuffers[iRun][i]);
+			}
+			else {
+				vSemaphoreCreateBinary(pvHandle);
+			}
+			break;
+
+		case OBJ_MUTEX:
+			pvHandle = xStatic ? xSemaphoreCreateMutexStatic(&xMutexBuffers[iRun][i]) :
+					   xSemaphoreCreateMutex();
+			break;
+
+		default:
+			pvHandle = xStatic ?
+					   xTimerCreateStatic((const signed char *) "Bench", 1000, pdFALSE, NULL, prvCallback,
+										  &xTimerBuffers[iRun][i]) :
+					   xTimerCreate((const signed char *) "Bench", 1000, pdFALSE, NULL, prvCallback);
+			break;
+		}
+		configASSERT(pvHandle != NULL);
+	}
+	return (prvNow() - dStart) / COUNT;
+}
+
+/* Bytes of application memory one object takes on the static path */
+static size_t prvStaticBytes(OBJ_T eObj)
+{
+	switch (eObj) {
+	case OBJ_TASK:
+		return sizeof(xStaticTask) + sizeof(xStacks[0][0]);
+
+	case OBJ_QUEUE:
+		return sizeof(xStaticQueue) + sizeof(ucQueueStorage[0][0]);
+
+	case OBJ_SEMAPHORE:
+	case OBJ_MUTEX:
+		return sizeof(xStaticSemaphore);
+
+	default:
+		return sizeof(xStaticTimer);
+	}
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* heap_3.c with a count of the allocations */
+void *pvPortMalloc(size_t xWantedSize)
+{
+	void *pvReturn;
+
+	vTaskSuspendAll();
+	pvReturn = malloc(xWantedSize);
+	ulAllocs++;
+	xHeapBytes += xWantedSize;
+	xTaskResumeAll();
+	return pvReturn;
+}
+
+void vPortFree(void *pv)
+{
+	if (pv != NULL) {
+		vTaskSuspendAll();
+		free(pv);
+		xTaskResumeAll();
+	}
+}
+
+void vApplicationGetIdleTaskMemory(xStaticTask **ppxIdleTaskTCBBuffer, portSTACK_TYPE **ppxIdleTaskStackBuffer,
+								   unsigned short *pusIdleTaskStackSize)
+{
+	*ppxIdleTaskTCBBuffer = &xIdleTaskBuffer;
+	*ppxIdleTaskStackBuffer = xIdleStack;
+	*pusIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationGetTimerTaskMemory(xStaticTask **ppxTimerTaskTCBBuffer, portSTACK_TYPE **ppxTimerTaskStackBuffer,
+									unsigned short *pusTimerTaskStackSize)
+{
+	*ppxTimerTaskTCBBuffer = &xTimerTaskBuffer;
+	*ppxTimerTaskStackBuffer = xTimerStack;
+	*pusTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+int main(void)
+{
+	RESULT_T *pxResult;
+	double dNs, dBootDynamic = 0, dBootStatic = 0, dBootAllocs = 0, dBootHeap = 0;
+	size_t xBootStatic = 0;
+	unsigned long ulAllocsBefore;
+	size_t xHeapBefore;
+	int iObj, iRun;
+
+	printf("object               dynamic ns   static ns   heap allocs   heap bytes   static bytes\n");
+	for (iObj = 0; iObj < OBJ_COUNT; iObj++) {
+		pxResult = &xResults[iObj];
+		for (iRun = 0; iRun < RUNS; iRun++) {
+			ulAllocsBefore = ulAllocs;
+			xHeapBefore = xHeapBytes;
+			dNs = prvCreate((OBJ_T) iObj, pdFALSE, iRun);
+			if ((iRun == 0) || (dNs < pxResult->dDynamicNs)) {
+				pxResult->dDynamicNs = dNs;
+			}
+			pxResult->dAllocs = (double) (ulAllocs - ulAllocsBefore) / COUNT;
+			pxResult->dHeapBytes = (double) (xHeapBytes - xHeapBefore) / COUNT;
+
+			ulAllocsBefore = ulAllocs;
+			dNs = prvCreate((OBJ_T) iObj, pdTRUE, iRun);
+			if ((iRun == 0) || (dNs < pxResult->dStaticNs)) {
+				pxResult->dStaticNs = dNs;
+			}
+			configASSERT(ulAllocs == ulAllocsBefore);
+		}
+		pxResult->xStaticBytes = prvStaticBytes((OBJ_T) iObj);
+
+		printf("%-19s   %10.0f   %9.0f   %11.0f   %10.0f   %12u\n", pxResult->pcName, pxResult->dDynamicNs,
+			   pxResult->dStaticNs, pxResult->dAllocs, pxResult->dHeapBytes, (unsigned) pxResult->xStaticBytes);
+
+		dBootDynamic += pxResult->iBootCount * pxResult->dDynamicNs;
+		dBootStatic += pxResult->iBootCount * pxResult->dStaticNs;
+		dBootAllocs += pxResult->iBootCount * pxResult->dAllocs;
+		dBootHeap += pxResult->iBootCount * pxResult->dHeapBytes;
+		xBootStatic += pxResult->iBootCount * pxResult->xStaticBytes;
+	}
+	printf("boot, %d/%d/%d/%d/%d     %10.0f   %9.0f   %11.0f   %10.0f   %12u\n", BOOT_TASKS, BOOT_QUEUES,
+		   BOOT_SEMAPHORES, BOOT_MUTEXES, BOOT_TIMERS, dBootDynamic, dBootStatic, dBootAllocs, dBootHeap,
+		   (unsigned) xBootStatic);
+	return 0;
+}
@@ -0,0 +1,126 @@
+/*
+ * @brief Host benchmark of timer command latency, queued against direct
+ *
+ * @note
+ * A task below the timer service task's priority keeps resetting 100
+ * watchdog style timers that never expire, and times each xTimerReset()
+ * call.  Through the queue the call only returns once the timer service
+ * task has run and applied the command, so its length is the latency of
+ * the command.  With configUSE_TIMER_DIRECT_COMMANDS=1 the command is
+ * applied within the call while the timer service task stays blocked.
+ * Build it once each way and compare.
+ *
+ * @par
+ * A context switch on the POSIX port is two thread wake-ups, many times
+ * the cost of a switch on a Cortex-M3, so the host overstates the gain.
+ * A call that takes longer than SWITCH_NS is counted as one that switched;
+ * that fraction is what carries over to the chip.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigUSE_TIMER_WHEEL=1 \
+ *       -DconfigUSE_TIMER_DIRECT_COMMANDS=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/bench_timer_commands.c freertos/src/tasks.c \
+ *       freertos/src/queue.c freertos/src/list.c freertos/src/timers.c \
+ *       freertos/src/heap_3.c freertos/portable/Posix/port.c \
+ *       -lpthread -o bench_timer_commands
+ *   ./bench_timer_commands
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define NUM_TIMERS          100
+#define TIMER_PERIOD        100000
+#define CALLS               20000
+
+/* Calls longer than this are counted as having switched to the timer
+   service task */
+#define SWITCH_NS           2000
+
+static xTimerHandle xTimers[NUM_TIMERS];
+static double dTimes[CALLS];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void prvCallback(xTimerHandle xTimer)
+{
+	(void) xTimer;
+}
+
+static double prvNow(void)
+{
+	struct timespec xTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &xTime);
+	return (double) xTime.tv_sec * 1e9 + (double) xTime.tv_nsec;
+}
+
+static int prvCompare(const void *pvA, const void *pvB)
+{
+	double dA = *(const double *) pvA, dB = *(const double *) pvB;
+
+	return (dA > dB) - (dA < dB);
+}
+
+static void prvBenchTask(void *pvParameters)
+{
+	double dStart;
+	int i, iSwitched = 0;
+
+	(void) pvParameters;
+
+	for (i = 0; i < NUM_TIMERS; i++) {
+		xTimers[i] = xTimerCreate((const signed char *) "Watchdog", TIMER_PERIOD, pdFALSE, NULL,
+								  prvCallback);
+		configASSERT(xTimers[i] != NULL);
+		xTimerStart(xTimers[i], portMAX_DELAY);
+	}
+	vTaskDelay(1);
+
+	for (i = 0; i < CALLS; i++) {
+		dStart = prvNow();
+		xTimerReset(xTimers[i % NUM_TIMERS], portMAX_DELAY);
+		dTimes[i] = prvNow() - dStart;
+		if (dTimes[i] > SWITCH_NS) {
+			iSwitched++;
+		}
+	}
+	qsort(dTimes, CALLS, sizeof(dTimes[0]), prvCompare);
+
+	printf("configUSE_TIMER_DIRECT_COMMANDS=%d\n", configUSE_TIMER_DIRECT_COMMANDS);
+	printf("xTimerReset() ns: median %.0f, 90%% %.0f, 99%% %.0f\n",
+		   dTimes[CALLS / 2], dTimes[CALLS * 9 / 10], dTimes[CALLS * 99 / 100]);
+	printf("calls over %d ns, taken as a switch to the timer service task: %.1f%%\n", SWITCH_NS,
+		   100.0 * iSwitched / CALLS);
+
+	/* Does not return, main() ends the process */
+	vTaskEndScheduler();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	xTaskCreate(prvBenchTask, (const signed char *) "Bench", configMINIMAL_STACK_SIZE * 4, NULL,
+				tskIDLE_PRIORITY + 1, NULL);
+	vTaskStartScheduler();
+	return 0;
+}
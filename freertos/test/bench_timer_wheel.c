@@ -0,0 +1,146 @@
+/*
+ * @brief Host benchmark of timer commands against the number of timers
+ *
+ * @note
+ * Starts 10 to 10000 software timers with random periods, then times
+ * batches of xTimerReset() commands on random timers, processed by the timer
+ * service task in one go.  With the sorted active list (the default) a
+ * reset costs a list insert that grows with the number of running timers;
+ * with configUSE_TIMER_WHEEL=1 it is a constant time slot insert.  Build it
+ * once each way and compare the ns per command columns.
+ *
+ * @par
+ * The commands are queued with the scheduler suspended and the batch is
+ * timed from xTaskResumeAll() until the timer service task blocks again, so
+ * a context switch is paid once per batch and not per command.  Times are
+ * the best of several batches, on the host, so only the ratios between the
+ * rows and between the two builds mean anything.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigTIMER_QUEUE_LENGTH=1000 \
+ *       -DconfigUSE_TIMER_WHEEL=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/bench_timer_wheel.c freertos/src/tasks.c \
+ *       freertos/src/queue.c freertos/src/list.c freertos/src/timers.c \
+ *       freertos/src/heap_3.c freertos/portable/Posix/port.c \
+ *       -lpthread -o bench_timer_wheel
+ *   ./bench_timer_wheel
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_TIMERS          10000
+
+/* Commands per batch, the timer queue must hold them all */
+#define BATCH               1000
+#define BATCHES             5
+
+#if configTIMER_QUEUE_LENGTH < BATCH
+#error Build with -DconfigTIMER_QUEUE_LENGTH=1000 so a batch fits in the timer queue
+#endif
+
+/* Timer periods, long enough that none expires during a run */
+#define MIN_PERIOD          100000
+#define MAX_PERIOD          1000000
+
+static const int iTimerCounts[] = {10, 100, 1000, 10000};
+
+static xTimerHandle xTimers[MAX_TIMERS];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void prvCallback(xTimerHandle xTimer)
+{
+	(void) xTimer;
+}
+
+static double prvNow(void)
+{
+	struct timespec xTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &xTime);
+	return (double) xTime.tv_sec * 1e9 + (double) xTime.tv_nsec;
+}
+
+/* Best time in ns per command over the batches, with iCount timers running */
+static double prvTimeResets(int iCount)
+{
+	double dStart, dBest = 0;
+	int iBatch, i;
+
+	for (iBatch = 0; iBatch < BATCHES; iBatch++) {
+		/* Wait for a fresh tick so the batch is unlikely to be cut by one */
+		vTaskDelay(1);
+
+		vTaskSuspendAll();
+		for (i = 0; i < BATCH; i++) {
+			xTimerReset(xTimers[rand() % iCount], 0);
+		}
+		dStart = prvNow();
+		xTaskResumeAll();
+
+		/* The timer service task has the higher priority, this task only
+		   runs again once the whole batch has been processed */
+		if ((iBatch == 0) || ((prvNow() - dStart) < dBest)) {
+			dBest = prvNow() - dStart;
+		}
+	}
+	return dBest / BATCH;
+}
+
+static void prvBenchTask(void *pvParameters)
+{
+	int iRow, iCreated = 0;
+	portTickType xPeriod;
+
+	(void) pvParameters;
+	srand(1);
+
+	printf("configUSE_TIMER_WHEEL=%d\n", configUSE_TIMER_WHEEL);
+	printf("timers   ns per reset\n");
+	for (iRow = 0; iRow < (int) (sizeof(iTimerCounts) / sizeof(iTimerCounts[0])); iRow++) {
+		/* Add timers up to the row's count, started in batches */
+		while (iCreated < iTimerCounts[iRow]) {
+			xPeriod = MIN_PERIOD + (portTickType) (rand() % (MAX_PERIOD - MIN_PERIOD));
+			xTimers[iCreated] = xTimerCreate((const signed char *) "Bench", xPeriod, pdFALSE, NULL,
+											 prvCallback);
+			configASSERT(xTimers[iCreated] != NULL);
+			xTimerStart(xTimers[iCreated], portMAX_DELAY);
+			iCreated++;
+		}
+		vTaskDelay(1);
+
+		printf("%6d   %12.0f\n", iTimerCounts[iRow], prvTimeResets(iTimerCounts[iRow]));
+	}
+
+	/* Does not return, main() ends the process */
+	vTaskEndScheduler();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	xTaskCreate(prvBenchTask, (const signed char *) "Bench", configMINIMAL_STACK_SIZE * 4, NULL,
+				tskIDLE_PRIORITY + 1, NULL);
+	vTaskStartScheduler();
+	return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * @brief Host test of earliest deadline first against rate monotonic scheduling
+ *
+ * @note
+ * Runs the same periodic task set on the POSIX port twice, first as tasks
+ * created with xTaskCreatePeriodic() under configUSE_EDF_SCHEDULING, then as
+ * tasks created with xTaskCreate() at rate monotonic priorities that wait with
+ * vTaskDelayUntil().  The set has a utilisation of 0.9, above the Liu &
+ * Layland bound of 0.83 for two tasks: B misses its deadline under rate
+ * monotonic and nothing misses under EDF.  tools/freertos_sched_check.c gives
+ * the same result for the set, with these worst case response times:
+ *     task   C    T = D   rate monotonic   EDF
+ *     A      25   50      25               35
+ *     B      30   75      80 (miss)        55
+ *
+ * @par
+ * Execution time is counted in ticks: the tick hook charges each tick to the
+ * task that was running, and a job spins until it has been charged C ticks.
+ * So the test does not depend on the speed of the host, only on each job
+ * finishing within the tick it is charged its last tick in.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigUSE_EDF_SCHEDULING=1 \
+ *       -DconfigUSE_TICK_HOOK=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/test_edf.c freertos/src/tasks.c \
+ *       freertos/src/queue.c freertos/src/list.c freertos/src/timers.c \
+ *       freertos/src/heap_3.c freertos/portable/Posix/port.c \
+ *       -lpthread -o test_edf
+ *   ./test_edf
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#if configUSE_EDF_SCHEDULING != 1
+#error Build with -DconfigUSE_EDF_SCHEDULING=1
+#endif
+
+#if configUSE_TICK_HOOK != 1
+#error Build with -DconfigUSE_TICK_HOOK=1 to count the execution time of the jobs
+#endif
+
+#define NUM_TASKS           2
+
+/* Ticks each policy runs for, ten hyperperiods of the task set */
+#define RUN_TICKS           1500
+
+/* Rate monotonic priorities, both above configEDF_PRIORITY */
+#define RM_PRIORITY_HIGH    ( configEDF_PRIORITY + 2 )
+#define RM_PRIORITY_LOW     ( configEDF_PRIORITY + 1 )
+
+typedef struct {
+	const char *pcName;
+	portTickType xC;		/* Execution time */
+	portTickType xT;		/* Period and relative deadline */
+	xTaskHandle xHandle;
+	volatile unsigned long ulCharged;	/* Ticks the task was running for */
+	portTickType xWorstResponse;
+	unsigned long ulJobs;
+	unsigned long ulMisses;
+	unsigned portBASE_TYPE uxKernelMisses;	/* uxTaskGetDeadlineMisses() under EDF */
+} PERIODIC_TASK_T;
+
+static PERIODIC_TASK_T xTasks[NUM_TASKS] = {
+	{"A", 25, 50},
+	{"B", 30, 75},
+};
+
+/* Release of the first job of every task */
+static portTickType xFirstRelease;
+
+static int iFailures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			iFailures++; \
+		} \
+} while (0)
+
+/* Run a job of C ticks released at xRelease, and record its response time */
+static void prvRunJob(PERIODIC_TASK_T *pxTask, portTickType xRelease)
+{
+	unsigned long ulTarget = pxTask->ulCharged + pxTask->xC;
+	portTickType xResponse;
+
+	while (pxTask->ulCharged < ulTarget) {}
+
+	xResponse = (portTickType) (xTaskGetTickCount() - xRelease);
+	if (xResponse > pxTask->xWorstResponse) {
+		pxTask->xWorstResponse = xResponse;
+	}
+	if (xResponse > pxTask->xT) {
+		pxTask->ulMisses++;
+	}
+	pxTask->ulJobs++;
+}
+
+static void prvEdfTask(void *pvParameters)
+{
+	PERIODIC_TASK_T *pxTask = (PERIODIC_TASK_T *) pvParameters;
+	portTickType xRelease = xFirstRelease;
+
+	for (;; ) {
+		prvRunJob(pxTask, xRelease);
+		xRelease += pxTask->xT;
+		vTaskWaitForNextPeriod();
+	}
+}
+
+static void prvRmTask(void *pvParameters)
+{
+	PERIODIC_TASK_T *pxTask = (PERIODIC_TASK_T *) pvParameters;
+	portTickType xRelease = xFirstRelease;
+
+	for (;; ) {
+		prvRunJob(pxTask, xRelease);
+		vTaskDelayUntil(&xRelease, pxTask->xT);
+	}
+}
+
+/* Run the task set under one policy, and print and check the results */
+static void prvRunPolicy(portBASE_TYPE xEdf)
+{
+	int i;
+
+	for (i = 0; i < NUM_TASKS; i++) {
+		xTasks[i].xWorstResponse = 0;
+		xTasks[i].ulJobs = 0;
+		xTasks[i].ulMisses = 0;
+	}
+
+	/* Release every first job on the same tick, the worst case phasing */
+	vTaskSuspendAll();
+	xFirstRelease = xTaskGetTickCount();
+	for (i = 0; i < NUM_TASKS; i++) {
+		if (xEdf) {
+			xTaskCreatePeriodic(prvEdfTask, (const signed char *) xTasks[i].pcName,
+								configMINIMAL_STACK_SIZE * 2, &xTasks[i], xTasks[i].xT, xTasks[i].xT,
+								&xTasks[i].xHandle);
+		}
+		else {
+			xTaskCreate(prvRmTask, (const signed char *) xTasks[i].pcName, configMINIMAL_STACK_SIZE * 2,
+						&xTasks[i], (i == 0) ? RM_PRIORITY_HIGH : RM_PRIORITY_LOW, &xTasks[i].xHandle);
+		}
+		configASSERT(xTasks[i].xHandle != NULL);
+	}
+	xTaskResumeAll();
+
+	vTaskDelay(RUN_TICKS);
+
+	for (i = 0; i < NUM_TASKS; i++) {
+		if (xEdf) {
+			xTasks[i].uxKernelMisses = uxTaskGetDeadlineMisses(xTasks[i].xHandle);
+		}
+		vTaskDelete(xTasks[i].xHandle);
+	}
+
+	printf("%s\n", xEdf ? "Earliest deadline first" : "Rate monotonic");
+	printf("  task   jobs   response   deadline   misses\n");
+	for (i = 0; i < NUM_TASKS; i++) {
+		printf("  %-4s   %4lu   %8u   %8u   %6lu\n", xTasks[i].pcName, xTasks[i].ulJobs,
+			   (unsigned) xTasks[i].xWorstResponse, (unsigned) xTasks[i].xT, xTasks[i].ulMisses);
+		CHECK(xTasks[i].ulJobs >= RUN_TICKS / xTasks[i].xT - 1, "task %s ran %lu jobs in %u ticks",
+			  xTasks[i].pcName, xTasks[i].ulJobs, (unsigned) RUN_TICKS);
+	}
+
+	if (xEdf) {
+		for (i = 0; i < NUM_TASKS; i++) {
+			CHECK(xTasks[i].ulMisses == 0, "task %s missed %lu deadlines under EDF", xTasks[i].pcName,
+				  xTasks[i].ulMisses);
+			CHECK(xTasks[i].uxKernelMisses == 0, "kernel counted %u deadline misses of task %s",
+				  (unsigned) xTasks[i].uxKernelMisses, xTasks[i].pcName);
+		}
+	}
+	else {
+		CHECK(xTasks[0].ulMisses == 0, "task A missed %lu deadlines under rate monotonic",
+			  xTasks[0].ulMisses);
+		CHECK(xTasks[1].ulMisses > 0, "task B met every deadline under rate monotonic");
+	}
+}
+
+static void prvTestTask(void *pvParameters)
+{
+	(void) pvParameters;
+
+	prvRunPolicy(pdTRUE);
+	prvRunPolicy(pdFALSE);
+
+	/* Does not return, main() ends the process */
+	vTaskEndScheduler();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Charge the tick to the task that was running */
+void vApplicationTickHook(void)
+{
+	xTaskHandle xCurrent = xTaskGetCurrentTaskHandle();
+	int i;
+
+	for (i = 0; i < NUM_TASKS; i++) {
+		if (xTasks[i].xHandle == xCurrent) {
+			xTasks[i].ulCharged++;
+		}
+	}
+}
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	xTaskCreate(prvTestTask, (const signed char *) "Test", configMINIMAL_STACK_SIZE * 4, NULL,
+				configMAX_PRIORITIES - 2, NULL);
+	vTaskStartScheduler();
+
+	printf("%s\n", iFailures ? "FAILED" : "PASSED");
+	return iFailures ? 1 : 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * @brief Host test of the RIT tickless idle in FreeRTOSCommonHooks.c
+ *
+ * @note
+ * Runs vPortSuppressTicksAndSleep() against the SysTick, RIT and timer
+ * models of the peripheral simulator, with the kernel calls it makes
+ * stubbed, and checks that the tick count and the tick grid survive every
+ * kind of wake-up: the RIT match, another interrupt, a tick that came due
+ * while SysTick was being stopped, a pre-sleep hook that overruns the
+ * match, and a sleep across the wrap of the RIT counter.  It then runs a
+ * long random sequence of sleeps and busy periods and reports the drift.
+ *
+ * @par
+ * Register accesses take no simulated time (SIM_ACCESS_CYCLES=0), so the
+ * checks see the arithmetic of the hook alone.  On the chip each sleep
+ * also loses the few core clocks between stopping and restarting SysTick.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DCORE_M3 -D__USE_LPCOPEN -DSIM_ACCESS_CYCLES=0 \
+ *       -DconfigUSE_TICKLESS_IDLE=1 -DconfigCPU_CLOCK_HZ=96000000 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       -Ilpc_chip_175x_6x/inc -Ilpc_chip_175x_6x/host \
+ *       freertos/test/test_tickless.c lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/timer_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ritimer_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_tickless
+ *   ./test_tickless
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Pre-sleep hook of the test, set before FreeRTOS.h supplies the default */
+static void prvPreSleep(void);
+#define configPRE_SLEEP_PROCESSING(x)   prvPreSleep()
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "chip.h"
+#include "periph_sim.h"
+
+/* The hooks sleep through the simulator instead of the core */
+#define __disable_irq()     Sim_DisableIRQ()
+#define __enable_irq()      Sim_EnableIRQ()
+#define __WFI()             Sim_WaitForInterrupt()
+#define __DSB()
+#define __ISB()
+#define DEBUGSTR(str)       fputs(str, stdout)
+#define DEBUGOUT(...)       printf(__VA_ARGS__)
+
+#include "../src/FreeRTOSCommonHooks.c"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Simulated peripheral clocks per tick, the RIT counts at this rate */
+#define CYCLES_PER_TICK     (24000000 / configTICK_RATE_HZ)
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static portTickType xTickCount;
+static eSleepModeStatus eNextSleepStatus = eStandardSleep;
+static uint64_t ullPreSleepCycles;
+static uint64_t ullGridStart;
+static int iTimerWakes;
+static int iFailures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			iFailures++; \
+		} \
+} while (0)
+
+static void prvPreSleep(void)
+{
+	/* Interrupts are masked here, so only time passes */
+	if (ullPreSleepCycles != 0) {
+		Sim_Advance(ullPreSleepCycles);
+	}
+}
+
+static void prvSysTickHandler(void)
+{
+	xTickCount++;
+}
+
+static void prvTimer0Handler(void)
+{
+	Chip_TIMER_ClearMatch(LPC_TIMER0, 0);
+	iTimerWakes++;
+}
+
+/* Wake the core with TIMER0 after a number of peripheral clocks */
+static void prvWakeAfter(uint32_t cycles)
+{
+	Chip_TIMER_Reset(LPC_TIMER0);
+	Chip_TIMER_SetMatch(LPC_TIMER0, 0, cycles - 1);
+	Chip_TIMER_Enable(LPC_TIMER0);
+}
+
+static void prvWakeNever(void)
+{
+	Chip_TIMER_Disable(LPC_TIMER0);
+}
+
+/* Run with interrupts on, in steps short enough for every tick to be taken */
+static void prvBusy(uint64_t cycles)
+{
+	uint64_t step;
+
+	while (cycles > 0) {
+		step = (cycles < CYCLES_PER_TICK / 4) ? cycles : CYCLES_PER_TICK / 4;
+		Sim_Advance(step);
+		cycles -= step;
+	}
+}
+
+/* Ticks of simulated time since SysTick was started */
+static portTickType prvRealTicks(void)
+{
+	return (portTickType) ((Sim_GetCycles() - ullGridStart) / CYCLES_PER_TICK);
+}
+
+/* Peripheral clocks from the tick grid to the next tick interrupt, 0 when
+   SysTick is still on the grid */
+static int64_t prvGridError(void)
+{
+	portTickType xTicks = xTickCount;
+
+	while (xTickCount == xTicks) {
+		Sim_Advance(1);
+	}
+	return (int64_t) ((Sim_GetCycles() - ullGridStart) % CYCLES_PER_TICK);
+}
+
+static void prvStart(void)
+{
+	Sim_Init();
+	Chip_TIMER_Init(LPC_TIMER0);
+	Chip_TIMER_MatchEnableInt(LPC_TIMER0, 0);
+	Chip_TIMER_StopOnMatchEnable(LPC_TIMER0, 0);
+	Sim_SetIRQHandler(TIMER0_IRQn, prvTimer0Handler);
+	Sim_SetIRQHandler(SysTick_IRQn, prvSysTickHandler);
+	Sim_SetIRQHandler(RITIMER_IRQn, RIT_IRQHandler);
+	NVIC_EnableIRQ(TIMER0_IRQn);
+
+	/* SysTick as the port starts it */
+	ulSysTickCountsPerTick = 0;
+	xTickCount = 0;
+	iTimerWakes = 0;
+	ullPreSleepCycles = 0;
+	eNextSleepStatus = eStandardSleep;
+	SysTick->LOAD = (configCPU_CLOCK_HZ / configTICK_RATE_HZ) - 1;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+	ullGridStart = Sim_GetCycles();
+}
+
+/* Run one idle period the way the idle task does */
+static void prvIdle(portTickType xExpected)
+{
+	vPortSuppressTicksAndSleep(xExpected);
+}
+
+static void prvCheckTicks(const char *pcName)
+{
+	portTickType xReal = prvRealTicks();
+	int64_t err;
+
+	CHECK(xTickCount == xReal, "%s: tick count %u, %u ticks of time", pcName,
+		  (unsigned int) xTickCount, (unsigned int) xReal);
+	err = prvGridError();
+	CHECK(err == 0, "%s: next tick %d cycles off the grid", pcName, (int) err);
+}
+
+/* Woken by the RIT at the end of the period */
+static void prvTestFullSleep(void)
+{
+	prvStart();
+	prvBusy(3 * CYCLES_PER_TICK + 7001);
+	prvIdle(100);
+	CHECK(iTimerWakes == 0, "full sleep: woken by the timer");
+	prvCheckTicks("full sleep");
+}
+
+/* Woken by another interrupt part way through */
+static void prvTestEarlyWake(void)
+{
+	prvStart();
+	prvBusy(CYCLES_PER_TICK + 123);
+	prvWakeAfter(37 * CYCLES_PER_TICK + 4567);
+	prvIdle(1000);
+	CHECK(iTimerWakes == 1, "early wake: timer did not fire");
+	prvCheckTicks("early wake");
+	prvWakeNever();
+}
+
+/* The longest sleep, clamped to xMaxSuppressedTicks */
+static void prvTestLongSleep(void)
+{
+	uint64_t start;
+
+	prvStart();
+	prvBusy(CYCLES_PER_TICK / 2);
+	start = Sim_GetCycles();
+	prvIdle(60000);
+	CHECK((Sim_GetCycles() - start) / CYCLES_PER_TICK == xMaxSuppressedTicks - 1,
+		  "long sleep: slept %u ticks, limit %u",
+		  (unsigned int) ((Sim_GetCycles() - start) / CYCLES_PER_TICK), (unsigned int) xMaxSuppressedTicks);
+	prvCheckTicks("long sleep");
+}
+
+/* A sleep across the 32-bit wrap of the RIT counter */
+static void prvTestCounterWrap(void)
+{
+	prvStart();
+	prvIdle(2);
+	LPC_RITIMER->COUNTER = 0xFFFFFFFF - 5 * CYCLES_PER_TICK;
+	prvBusy(CYCLES_PER_TICK / 3);
+	prvIdle(20);
+	prvCheckTicks("match after wrap");
+
+	LPC_RITIMER->COUNTER = 0xFFFFFFFF - 5 * CYCLES_PER_TICK;
+	prvWakeAfter(11 * CYCLES_PER_TICK + 99);
+	prvIdle(20);
+	CHECK(iTimerWakes == 1, "wake after wrap: timer did not fire");
+	prvCheckTicks("wake after wrap");
+	prvWakeNever();
+}
+
+/* SysTick reached 0 between the idle task's check and stopping it */
+static void prvTestPendingTick(void)
+{
+	uint64_t start;
+
+	prvStart();
+	prvBusy(5 * CYCLES_PER_TICK + 100);
+	Sim_DisableIRQ();
+	Sim_Advance(CYCLES_PER_TICK - 50);
+	start = Sim_GetCycles();
+	prvIdle(50);
+	CHECK(Sim_GetCycles() - start < CYCLES_PER_TICK / 10, "pending tick: slept %u cycles",
+		  (unsigned int) (Sim_GetCycles() - start));
+	prvCheckTicks("pending tick");
+}
+
+/* A pre-sleep hook that runs past the RIT match, which RITINT latches */
+static void prvTestLatePreSleep(void)
+{
+	uint64_t start;
+
+	prvStart();
+	prvBusy(CYCLES_PER_TICK / 2);
+	ullPreSleepCycles = 3 * CYCLES_PER_TICK;
+	start = Sim_GetCycles();
+	prvIdle(2);
+	ullPreSleepCycles = 0;
+	CHECK(Sim_GetCycles() - start < 4 * CYCLES_PER_TICK, "late pre-sleep: slept %llu cycles",
+		  (unsigned long long) (Sim_GetCycles() - start));
+
+	/* The kernel cannot step past the period, the overrun is lost */
+	CHECK(xTickCount == 2, "late pre-sleep: tick count %u", (unsigned int) xTickCount);
+}
+
+/* The kernel aborted the sleep */
+static void prvTestAbort(void)
+{
+	prvStart();
+	prvBusy(2 * CYCLES_PER_TICK + 500);
+	eNextSleepStatus = eAbortSleep;
+	prvIdle(10);
+	eNextSleepStatus = eStandardSleep;
+	prvCheckTicks("abort");
+}
+
+/* Random sleeps, wake-ups and busy periods */
+static void prvTestDrift(void)
+{
+	int i, sleeps = 5000, early = 0;
+	portTickType xExpected;
+	int64_t err;
+
+	srand(1);
+	prvStart();
+	for (i = 0; i < sleeps; i++) {
+		prvBusy(rand() % (3 * CYCLES_PER_TICK));
+		xExpected = 2 + rand() % 300;
+		if (rand() & 1) {
+			prvWakeAfter(1 + rand() % (xExpected * CYCLES_PER_TICK));
+			early++;
+		}
+		prvIdle(xExpected);
+		prvWakeNever();
+	}
+	err = prvGridError();
+	printf("drift: %d sleeps, %d with an early wake-up, %u ticks, tick count %u, "
+		   "grid error %d cycles\n", sleeps, early, (unsigned int) prvRealTicks(),
+		   (unsigned int) xTickCount, (int) err);
+	CHECK(xTickCount == prvRealTicks(), "drift: tick count %u, %u ticks of time",
+		  (unsigned int) xTickCount, (unsigned int) prvRealTicks());
+	CHECK(err == 0, "drift: next tick %d cycles off the grid", (int) err);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Kernel calls made by the hooks */
+eSleepModeStatus eTaskConfirmSleepModeStatus(void)
+{
+	return eNextSleepStatus;
+}
+
+void vTaskStepTick(portTickType xTicksToJump)
+{
+	xTickCount += xTicksToJump;
+}
+
+portTickType xTaskGetTickCount(void)
+{
+	return xTickCount;
+}
+
+void vTaskDelayUntil(portTickType * const pxPreviousWakeTime, portTickType xTimeIncrement)
+{
+	(void) pxPreviousWakeTime;
+	(void) xTimeIncrement;
+}
+
+unsigned portBASE_TYPE uxTaskGetSystemState(xTaskStatusType * const pxTaskStatusArray,
+											const unsigned portBASE_TYPE uxArraySize,
+											unsigned long * const pulTotalRunTime)
+{
+	(void) pxTaskStatusArray;
+	(void) uxArraySize;
+	(void) pulTotalRunTime;
+	return 0;
+}
+
+/* Port call made by the fatal hooks */
+unsigned long ulPortSetInterruptMask(void)
+{
+	Sim_DisableIRQ();
+	return 0;
+}
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	prvTestFullSleep();
+	prvTestEarlyWake();
+	prvTestLongSleep();
+	prvTestCounterWrap();
+	prvTestPendingTick();
+	prvTestLatePreSleep();
+	prvTestAbort();
+	prvTestDrift();
+
+	printf("%s\n", iFailures ? "FAILED" : "PASSED");
+	return iFailures ? 1 : 0;
+}
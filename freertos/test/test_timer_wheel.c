@@ -0,0 +1,207 @@
+/*
+ * @brief Host test of the software timer wheel across tick count overflow
+ *
+ * @note
+ * Runs the timer service task with configUSE_TIMER_WHEEL on the POSIX port
+ * with 16-bit ticks, so the tick count wraps within a few seconds.  It
+ * checks that a timer started after the wheel has been empty for more than
+ * half the tick range still expires on time, and that a periodic timer
+ * keeps its period while the tick count overflows.  A timer started before
+ * the scheduler must expire too.
+ *
+ * @par
+ * The tick rate is raised to 20 kHz to keep the run short.  The same test
+ * passes with configUSE_TIMER_WHEEL=0, the sorted list implementation, and
+ * with configUSE_TIMER_DIRECT_COMMANDS=1.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DFREERTOS_HOST_POSIX -DconfigUSE_16_BIT_TICKS=1 \
+ *       -DconfigTICK_RATE_HZ=20000 -DconfigUSE_TIMER_WHEEL=1 \
+ *       -Ifreertos/test -Ifreertos/portable/Posix -Ifreertos/inc \
+ *       freertos/test/test_timer_wheel.c freertos/src/tasks.c \
+ *       freertos/src/queue.c freertos/src/list.c freertos/src/timers.c \
+ *       freertos/src/heap_3.c freertos/portable/Posix/port.c \
+ *       -lpthread -o test_timer_wheel
+ *   ./test_timer_wheel
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#if configUSE_16_BIT_TICKS != 1
+#error Build with -DconfigUSE_16_BIT_TICKS=1 so the tick count wraps quickly
+#endif
+
+/* Ticks the wheel is left empty, more than half the tick range */
+#define IDLE_TICKS          40000
+
+#define ONE_SHOT_PERIOD     10
+#define PERIODIC_PERIOD     100
+
+/* Ticks the timer service task may run late on a loaded host */
+#define LATENESS            5
+
+static xSemaphoreHandle xExpired;
+static xTimerHandle xEarly;
+static volatile int iEarlyExpired;
+static volatile portTickType xExpiredAt;
+static volatile portTickType xPeriodicLast;
+static volatile portTickType xPeriodicMaxGap, xPeriodicMinGap;
+static volatile unsigned long ulPeriodicCount;
+static int iFailures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			iFailures++; \
+		} \
+} while (0)
+
+static void prvOneShotCallback(xTimerHandle xTimer)
+{
+	(void) xTimer;
+	xExpiredAt = xTaskGetTickCount();
+	xSemaphoreGive(xExpired);
+}
+
+static void prvEarlyCallback(xTimerHandle xTimer)
+{
+	(void) xTimer;
+	iEarlyExpired++;
+}
+
+static void prvPeriodicCallback(xTimerHandle xTimer)
+{
+	portTickType xNow = xTaskGetTickCount();
+	portTickType xGap = xNow - xPeriodicLast;
+
+	(void) xTimer;
+	if (ulPeriodicCount > 0) {
+		if (xGap > xPeriodicMaxGap) {
+			xPeriodicMaxGap = xGap;
+		}
+		if (xGap < xPeriodicMinGap) {
+			xPeriodicMinGap = xGap;
+		}
+	}
+	xPeriodicLast = xNow;
+	ulPeriodicCount++;
+}
+
+/* Start a one shot timer and check it expires after its period */
+static void prvCheckOneShot(xTimerHandle xTimer, const char *pcWhen)
+{
+	portTickType xStart;
+
+	xStart = xTaskGetTickCount();
+	xTimerStart(xTimer, 0);
+	if (xSemaphoreTake(xExpired, ONE_SHOT_PERIOD + 200) != pdPASS) {
+		CHECK(0, "one shot timer started at tick %u %s did not expire",
+			  (unsigned) xStart, pcWhen);
+		return;
+	}
+	CHECK((portTickType) (xExpiredAt - xStart) >= ONE_SHOT_PERIOD &&
+		  (portTickType) (xExpiredAt - xStart) <= ONE_SHOT_PERIOD + LATENESS,
+		  "one shot timer started at tick %u %s expired after %u ticks",
+		  (unsigned) xStart, pcWhen, (unsigned) (portTickType) (xExpiredAt - xStart));
+}
+
+/* A timer started after the wheel has been empty for a long time */
+static void prvTestIdleWheel(xTimerHandle xOneShot)
+{
+	prvCheckOneShot(xOneShot, "on a fresh wheel");
+
+	vTaskDelay(IDLE_TICKS);
+	prvCheckOneShot(xOneShot, "after the wheel was idle");
+}
+
+/* A periodic timer running while the tick count overflows */
+static void prvTestPeriodicWrap(xTimerHandle xPeriodic)
+{
+	portTickType xNow = xTaskGetTickCount();
+	portTickType xToWrap = (portTickType) (0U - xNow);
+	unsigned long ulExpected;
+
+	/* Start well before the wrap and stop well after it */
+	if (xToWrap < 20 * PERIODIC_PERIOD) {
+		vTaskDelay(xToWrap + 1);
+		xToWrap = (portTickType) (0U - xTaskGetTickCount());
+	}
+	if (xToWrap > 20 * PERIODIC_PERIOD) {
+		vTaskDelay(xToWrap - 20 * PERIODIC_PERIOD);
+	}
+
+	ulPeriodicCount = 0;
+	xPeriodicMaxGap = 0;
+	xPeriodicMinGap = portMAX_DELAY;
+	xTimerStart(xPeriodic, 0);
+	vTaskDelay(40 * PERIODIC_PERIOD + PERIODIC_PERIOD / 2);
+	xTimerStop(xPeriodic, 0);
+
+	ulExpected = 40;
+	CHECK(ulPeriodicCount == ulExpected, "periodic timer ran %lu times across the wrap, expected %lu",
+		  ulPeriodicCount, ulExpected);
+	CHECK(xPeriodicMaxGap <= PERIODIC_PERIOD + LATENESS && xPeriodicMinGap >= PERIODIC_PERIOD - LATENESS,
+		  "periodic timer gaps across the wrap were %u to %u ticks, period %u",
+		  (unsigned) xPeriodicMinGap, (unsigned) xPeriodicMaxGap, (unsigned) PERIODIC_PERIOD);
+}
+
+static void prvTestTask(void *pvParameters)
+{
+	xTimerHandle xOneShot, xPeriodic;
+
+	(void) pvParameters;
+
+	xOneShot = xTimerCreate((const signed char *) "OneShot", ONE_SHOT_PERIOD, pdFALSE, NULL,
+							prvOneShotCallback);
+	xPeriodic = xTimerCreate((const signed char *) "Periodic", PERIODIC_PERIOD, pdTRUE, NULL,
+							 prvPeriodicCallback);
+	configASSERT(xOneShot != NULL && xPeriodic != NULL);
+
+	vTaskDelay(ONE_SHOT_PERIOD + LATENESS);
+	CHECK(iEarlyExpired == 1, "timer started before the scheduler expired %d times", iEarlyExpired);
+
+	prvTestIdleWheel(xOneShot);
+	prvTestPeriodicWrap(xPeriodic);
+
+	/* Does not return, main() ends the process */
+	vTaskEndScheduler();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	setvbuf(stdout, NULL, _IONBF, 0);
+
+	vSemaphoreCreateBinary(xExpired);
+	xSemaphoreTake(xExpired, 0);
+	xEarly = xTimerCreate((const signed char *) "Early", ONE_SHOT_PERIOD, pdFALSE, NULL,
+						  prvEarlyCallback);
+	xTimerStart(xEarly, 0);
+	xTaskCreate(prvTestTask, (const signed char *) "Test", configMINIMAL_STACK_SIZE * 4, NULL,
+				tskIDLE_PRIORITY + 1, NULL);
+	vTaskStartScheduler();
+
+	printf("%s\n", iFailures ? "FAILED" : "PASSED");
+	return iFailures ? 1 : 0;
+}
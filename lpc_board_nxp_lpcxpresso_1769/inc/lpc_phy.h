@@ -51,6 +51,10 @@ extern "C" {
  * Once initialized, just preiodically call the lpcPHYStsPoll() function
  * from the background loop or a thread and monitor the returned status
  * to determine if the PHY state has changed and the current PHY state.
+ *
+ * Alternatively, lpc_phy_async_init() hands the status updates to a timer
+ * interrupt and calls back only when the link changes, so nothing has to
+ * poll. Use one of the two ways, not both.
  * @{
  */
 #define PHY_LINK_ERROR     (1 << 0)	/*!< PHY status bit for link error */
@@ -60,6 +64,14 @@ extern "C" {
 #define PHY_LINK_SPEED100  (1 << 4)	/*!< PHY status bit for 100Mbps mode */
 #define PHY_LINK_FULLDUPLX (1 << 5)	/*!< PHY status bit for full duplex mode */
 
+/**
+ * @brief	Link change callback
+ * @param	physts	: An Or'ed value of PHY_LINK_* statuses, PHY_LINK_CHANGED is set
+ * @return	Nothing
+ * @note	Called from the timer interrupt given to lpc_phy_async_init().
+ */
+typedef void (*p_phy_link_func_t)(uint32_t physts);
+
 /**
  * @brief	Phy status update state machine
  * @return	An Or'ed value of PHY_LINK_* statuses
@@ -79,6 +91,47 @@ uint32_t lpcPHYStsPoll(void);
  */
 uint32_t lpc_phy_init(bool rmii, p_msDelay_func_t pDelayMsFunc);
 
+/**
+ * @brief	Run the PHY status updates from a timer interrupt
+ * @param	pTimer		: Timer for the PHY driver alone, match register 0 is used
+ * @param	timerRate	: Clock rate of the timer in Hz, from Chip_Clock_GetPeripheralClockRate(),
+ *						  at least 1 MHz
+ * @param	periodMs	: Time between two status updates
+ * @param	pLinkFunc	: Called when the link state, speed or duplex changes
+ * @return	ERROR if timerRate is below 1 MHz, in which case nothing is set
+ *			up, SUCCESS otherwise
+ * @note	Call after lpc_phy_init(), then enable the timer interrupt in
+ * the NVIC and call lpc_phy_async_irq() from its handler. Each update is
+ * the two MII reads of lpcPHYStsPoll(). An MII read is started, the
+ * interrupt returns, and the result is picked up when the timer fires
+ * again one MII frame later, so no code ever waits on MDIO. The LPC17xx
+ * MAC has no MII done interrupt, the timer stands in for it.
+ */
+Status lpc_phy_async_init(LPC_TIMER_T *pTimer, uint32_t timerRate, uint32_t periodMs,
+						  p_phy_link_func_t pLinkFunc);
+
+/**
+ * @brief	Timer interrupt part of the PHY status updates
+ * @return	Nothing
+ * @note	Call from the IRQ handler of the timer given to lpc_phy_async_init().
+ */
+void lpc_phy_async_irq(void);
+
+/**
+ * @brief	Start a PHY status update now
+ * @return	Nothing
+ * @note	For example from a GPIO interrupt on the PHY interrupt pin. Does
+ * nothing if an update is running. Call it from the timer's interrupt
+ * priority level or with the timer interrupt disabled.
+ */
+void lpc_phy_async_update(void);
+
+/**
+ * @brief	Return the PHY status of the last update
+ * @return	An Or'ed value of PHY_LINK_* statuses
+ */
+uint32_t lpc_phy_async_status(void);
+
 /**
  * @}
  */
@@ -89,6 +89,23 @@ static int32_t phyustate;
 /* Pointer to delay function used for this driver */
 static p_msDelay_func_t pDelayMs;
 
+/* An MII frame is 64 MDC clocks, 26 uS at the usual 2.5MHz MDC */
+#define PHY_MII_WAIT_US     30
+
+/* States of the timer driven status update */
+typedef enum {
+	PHY_ASYNC_IDLE,		/* Waiting for the next update */
+	PHY_ASYNC_BSR,		/* Reading the basic status register */
+	PHY_ASYNC_SPLCTL,	/* Reading the special control/status register */
+} PHY_ASYNC_STATE_T;
+
+/* Timer driven status update state */
+static LPC_TIMER_T *pPhyTimer;
+static uint32_t phyPeriodUs;
+static p_phy_link_func_t pPhyLinkFunc;
+static PHY_ASYNC_STATE_T phyAsyncState;
+static uint16_t phyAsyncBsr;
+
 /* Write to the PHY. Will block for delays based on the pDelayMs function. Returns
    true on success, or false on failure */
 static Status lpc_mii_write(uint8_t reg, uint16_t data)
@@ -265,6 +282,102 @@ uint32_t lpcPHYStsPoll(void)
 	return physts;
 }
 
+/* Fire the PHY timer after the given time */
+static void phy_timer_arm(uint32_t us)
+{
+	Chip_TIMER_SetMatch(pPhyTimer, 0, us);
+	Chip_TIMER_Enable(pPhyTimer);
+}
+
+/* Run the PHY status updates from a timer interrupt */
+Status lpc_phy_async_init(LPC_TIMER_T *pTimer, uint32_t timerRate, uint32_t periodMs,
+						  p_phy_link_func_t pLinkFunc)
+{
+	/* The prescaler divides down to 1 MHz, it cannot go faster */
+	if (timerRate < 1000000) {
+		return ERROR;
+	}
+
+	pPhyTimer = pTimer;
+	phyPeriodUs = periodMs * 1000;
+	pPhyLinkFunc = pLinkFunc;
+	phyAsyncState = PHY_ASYNC_IDLE;
+
+	/* One shot timer counting in uS */
+	Chip_TIMER_Init(pTimer);
+	Chip_TIMER_Disable(pTimer);
+	Chip_TIMER_Reset(pTimer);
+	Chip_TIMER_PrescaleSet(pTimer, (timerRate / 1000000) - 1);
+	Chip_TIMER_MatchEnableInt(pTimer, 0);
+	Chip_TIMER_ResetOnMatchEnable(pTimer, 0);
+	Chip_TIMER_StopOnMatchEnable(pTimer, 0);
+	Chip_TIMER_ClearMatch(pTimer, 0);
+
+	/* First update right away */
+	phy_timer_arm(1);
+
+	return SUCCESS;
+}
+
+/* Timer interrupt part of the PHY status updates */
+void lpc_phy_async_irq(void)
+{
+	Chip_TIMER_ClearMatch(pPhyTimer, 0);
+
+	switch (phyAsyncState) {
+	case PHY_ASYNC_IDLE:
+		/* Read BMSR to clear faults */
+		Chip_ENET_StartMIIRead(LPC_ETHERNET, LAN8_BSR_REG);
+		physts |= PHY_LINK_BUSY;
+		phyAsyncState = PHY_ASYNC_BSR;
+		phy_timer_arm(PHY_MII_WAIT_US);
+		break;
+
+	case PHY_ASYNC_BSR:
+		if (Chip_ENET_IsMIIBusy(LPC_ETHERNET)) {
+			phy_timer_arm(PHY_MII_WAIT_US);
+			break;
+		}
+		phyAsyncBsr = Chip_ENET_ReadMIIData(LPC_ETHERNET);
+		Chip_ENET_StartMIIRead(LPC_ETHERNET, LAN8_PHYSPLCTL_REG);
+		phyAsyncState = PHY_ASYNC_SPLCTL;
+		phy_timer_arm(PHY_MII_WAIT_US);
+		break;
+
+	case PHY_ASYNC_SPLCTL:
+		if (Chip_ENET_IsMIIBusy(LPC_ETHERNET)) {
+			phy_timer_arm(PHY_MII_WAIT_US);
+			break;
+		}
+		physts &= ~(PHY_LINK_BUSY | PHY_LINK_CHANGED);
+		smsc_update_phy_sts(phyAsyncBsr, Chip_ENET_ReadMIIData(LPC_ETHERNET));
+		phyAsyncState = PHY_ASYNC_IDLE;
+		phy_timer_arm(phyPeriodUs);
+
+		/* Only a change is worth telling the network stack */
+		if ((physts & PHY_LINK_CHANGED) && (pPhyLinkFunc != NULL)) {
+			pPhyLinkFunc(physts);
+		}
+		break;
+	}
+}
+
+/* Start a PHY status update now */
+void lpc_phy_async_update(void)
+{
+	if (phyAsyncState == PHY_ASYNC_IDLE) {
+		Chip_TIMER_Disable(pPhyTimer);
+		Chip_TIMER_Reset(pPhyTimer);
+		phy_timer_arm(1);
+	}
+}
+
+/* Return the PHY status of the last update */
+uint32_t lpc_phy_async_status(void)
+{
+	return physts;
+}
+
 /**
  * @}
  */
@@ -0,0 +1,3782 @@
+/*
+ * @brief Host register-level peripheral simulator for the LPC175x/6x drivers
+ *
+ * @note
+ * See periph_sim.h and readme.txt.
+ *
+ * @par
+ * The peripheral address ranges are mapped at their real addresses from one
+ * shared memory object, which is also mapped a second time at an address of
+ * our choosing.  The models work on that second (alias) mapping.  The pages
+ * of the modelled blocks are PROT_NONE in the driver's view, so a driver
+ * access faults.  The SIGSEGV handler brings the model up to date, writes
+ * the value a read must see into the alias, opens the page and single-steps
+ * the faulting instruction.  The SIGTRAP that follows the step closes the
+ * page again and hands a written value to the model.  This needs the x86-64
+ * page fault error code and trap flag, so only x86-64 Linux is supported.
+ *
+ * @par
+ * Built with -DCHIP_LPC177X_8X, the simulator maps the LPC177x/8x address
+ * space instead and adds the SD card interface with an SD card behind it,
+ * for the SD card drivers the LPC175x/6x has no hardware for.  The RIT model
+ * is left out of that build, the chip library has no RIT driver for it.
+ */
+
+#define _GNU_SOURCE
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include "periph_sim.h"
+
+#if !defined(__linux__) || !defined(__x86_64__)
+#error The peripheral simulator needs x86-64 Linux
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define SIM_PAGE_SIZE       0x1000
+#define SIM_NEVER           (~(uint64_t) 0)
+#define SIM_NUM_IRQS        64
+#define SIM_MAX_IRQ_RUNS    100000
+#define SIM_EFLAGS_TF       0x100
+#define SIM_PF_WRITE        0x2
+
+#define SIM_UART_FIFO_SIZE  16
+#define SIM_UART_LINE_SIZE  4096
+#define SIM_SSP_FIFO_SIZE   8
+#define SIM_ENET_MAX_FRAME  2048
+#define SIM_ENET_QUEUE      32
+#define SIM_CAN_QUEUE       64
+#define SIM_SDC_MAX_BLOCK   2048
+#define SIM_SDC_NAC         (SIM_PCLK_HZ / 10000)	/* 100 us from CMD17/18 to the first block */
+#define SIM_SDC_BLOCK_BUSY  (SIM_PCLK_HZ / 100000)	/* 10 us busy after a block of CMD25 */
+#define SIM_SDC_PROG        (SIM_PCLK_HZ / 2500)	/* 400 us programming at the end of a write */
+#define SIM_SDC_INIT_TRIES  3			/* ACMD41s answered busy before the card is ready */
+#define SIM_SDC_RCA         0x4567
+#define SIM_PCLK_HZ         24000000
+#define SIM_CCLK_HZ         96000000
+#define SIM_CCLK_PER_PCLK   (SIM_CCLK_HZ / SIM_PCLK_HZ)
+
+/* Register offsets used by the models */
+#define UART_RBR    0x00
+#define UART_IER    0x04
+#define UART_IIR    0x08
+#define UART_LCR    0x0C
+#define UART_LSR    0x14
+#define UART_FDR    0x28
+#define UART_TER1   0x30
+
+#define SSP_CR0     0x00
+#define SSP_CR1     0x04
+#define SSP_DR      0x08
+#define SSP_SR      0x0C
+#define SSP_CPSR    0x10
+#define SSP_IMSC    0x14
+#define SSP_RIS     0x18
+#define SSP_MIS     0x1C
+#define SSP_ICR     0x20
+#define SSP_DMACR   0x24
+
+/* ICR bits, the SSP_INTCLEAR_T values in ssp_17xx_40xx.h are bit numbers */
+#define SSP_ICR_ROR (1 << 0)
+#define SSP_ICR_RT  (1 << 1)
+
+#define TMR_IR      0x00
+#define TMR_TCR     0x04
+#define TMR_TC      0x08
+#define TMR_PR      0x0C
+#define TMR_PC      0x10
+#define TMR_MCR     0x14
+#define TMR_MR0     0x18
+#define TMR_CTCR    0x70
+
+#define DMA_INTSTAT         0x00
+#define DMA_INTTCSTAT       0x04
+#define DMA_INTTCCLEAR      0x08
+#define DMA_INTERRSTAT      0x0C
+#define DMA_INTERRCLR       0x10
+#define DMA_RAWINTTCSTAT    0x14
+#define DMA_RAWINTERRSTAT   0x18
+#define DMA_ENBLDCHNS       0x1C
+#define DMA_CONFIG          0x30
+#define DMA_CH(n)           (0x100 + ((n) * 0x20))
+#define DMA_CH_SRC          0x00
+#define DMA_CH_DST          0x04
+#define DMA_CH_LLI          0x08
+#define DMA_CH_CONTROL      0x0C
+#define DMA_CH_CONFIG       0x10
+
+#define ENET_MAC1       0x000
+#define ENET_MAC2       0x004
+#define ENET_SUPP       0x018
+#define ENET_MCFG       0x020
+#define ENET_MCMD       0x024
+#define ENET_MADR       0x028
+#define ENET_MWTD       0x02C
+#define ENET_MRDD       0x030
+#define ENET_MIND       0x034
+#define ENET_COMMAND    0x100
+#define ENET_STATUS     0x104
+#define ENET_RXDESC     0x108
+#define ENET_RXSTAT     0x10C
+#define ENET_RXNUM      0x110
+#define ENET_RXPRODUCE  0x114
+#define ENET_RXCONSUME  0x118
+#define ENET_TXDESC     0x11C
+#define ENET_TXSTAT     0x120
+#define ENET_TXNUM      0x124
+#define ENET_TXPRODUCE  0x128
+#define ENET_TXCONSUME  0x12C
+#define ENET_INTSTATUS  0xFE0
+#define ENET_INTENABLE  0xFE4
+#define ENET_INTCLEAR   0xFE8
+#define ENET_INTSET     0xFEC
+
+#define CAN_MOD     0x00
+#define CAN_CMR     0x04
+#define CAN_GSR     0x08
+#define CAN_ICR     0x0C
+#define CAN_IER     0x10
+#define CAN_BTR     0x14
+#define CAN_SR      0x1C
+#define CAN_RFS     0x20
+#define CAN_TFI(n)  (0x30 + ((n) * 0x10))
+
+#define CANCR_TXSR  0x00
+#define CANCR_RXSR  0x04
+
+#define CANAF_AFMR          0x00
+#define SIM_CANAF_ENDADDR(n) (0x04 + ((n) * 4))
+
+#define RIT_COMPVAL 0x00
+#define RIT_CTRL    0x08
+#define RIT_COUNTER 0x0C
+
+#define SDC_POWER       0x00
+#define SDC_CLOCK       0x04
+#define SDC_ARGUMENT    0x08
+#define SDC_COMMAND     0x0C
+#define SDC_RESPCMD     0x10
+#define SDC_RESPONSE(n) (0x14 + ((n) * 4))
+#define SDC_DATATIMER   0x24
+#define SDC_DATALENGTH  0x28
+#define SDC_DATACTRL    0x2C
+#define SDC_DATACNT     0x30
+#define SDC_STATUS      0x34
+#define SDC_CLEAR       0x38
+#define SDC_MASK0       0x3C
+#define SDC_FIFOCNT     0x48
+#define SDC_FIFO        0x80
+#define SDC_FIFO_END    0xC0
+
+#define ST_CTRL     0x010
+#define ST_LOAD     0x014
+#define ST_VAL      0x018
+#define NVIC_ISER   0x100
+#define NVIC_ICER   0x180
+#define NVIC_ISPR   0x200
+#define NVIC_ICPR   0x280
+#define NVIC_IP     0x400
+#define SCB_ICSR    0xD04
+#define SCB_SHP     0xD18
+
+/* Register of a page, through the alias mapping */
+#define REG(pPage, off)     (*(volatile uint32_t *) ((pPage)->alias + (off)))
+
+/* A range of the address space backed by the simulator */
+typedef struct {
+	uint32_t base;
+	uint32_t size;
+	uint8_t *alias;
+} SIM_REGION_T;
+
+/* Kind of block modelled behind a trapped page */
+typedef enum {
+	SIM_UART,
+	SIM_SSP,
+	SIM_TIMER,
+	SIM_GPDMA,
+	SIM_ENET,
+	SIM_NVIC,
+	SIM_CANAF,
+	SIM_CAN,
+	SIM_CANCR,
+	SIM_RIT,
+	SIM_SDC,
+} SIM_KIND_T;
+
+/* A trapped register page */
+typedef struct {
+	uint32_t base;
+	SIM_KIND_T kind;
+	int irq;
+	void *pState;
+	uint8_t *alias;
+	uint32_t accesses;
+} SIM_PAGE_T;
+
+typedef struct {
+	uint8_t rxFifo[SIM_UART_FIFO_SIZE];
+	int rxHead, rxCount;
+	uint8_t txFifo[SIM_UART_FIFO_SIZE];
+	int txHead, txCount;
+	bool txBusy;				/* Character in the shift register */
+	uint8_t txShift;
+	uint64_t txDoneAt;
+	uint8_t line[SIM_UART_LINE_SIZE];	/* Characters still to arrive */
+	int lineHead, lineCount;
+	uint64_t lineNextAt;
+	uint8_t log[SIM_UART_LINE_SIZE];	/* Characters shifted out */
+	int logHead, logCount;
+	uint64_t lastRxAt;			/* Last arrival or RBR read, for the timeout */
+	uint32_t dll, dlm, ier, fcr;
+	bool overrun;
+	bool threPending;
+} SIM_UART_T;
+
+typedef struct {
+	uint16_t rxFifo[SIM_SSP_FIFO_SIZE];
+	int rxHead, rxCount;
+	uint16_t txFifo[SIM_SSP_FIFO_SIZE];
+	int txHead, txCount;
+	bool busy;					/* Frame being shifted */
+	uint16_t shift;
+	uint64_t doneAt;
+	uint64_t lastRxAt;
+	bool overrun;
+	SIM_SSP_DEVICE_T device;
+	void *ctx;
+} SIM_SSP_T;
+
+typedef struct {
+	uint32_t ir;
+	uint64_t lastSync;			/* Time TC and PC in the shadow belong to */
+	bool resetPending;			/* Match reset, TC goes to 0 on the next count */
+} SIM_TIMER_T;
+
+typedef struct {
+	uint32_t rawTc;
+	uint32_t rawErr;
+} SIM_GPDMA_T;
+
+typedef struct {
+	uint32_t len;
+	uint8_t data[SIM_ENET_MAX_FRAME];
+} SIM_FRAME_T;
+
+typedef struct {
+	SIM_FRAME_T line[SIM_ENET_QUEUE];	/* Frames still to arrive */
+	int lineHead, lineCount;
+	uint64_t lineNextAt;		/* End of the first frame on the line */
+	SIM_FRAME_T log[SIM_ENET_QUEUE];	/* Frames sent */
+	int logHead, logCount;
+	bool txBusy;				/* Frame on the wire */
+	SIM_FRAME_T txFrame;
+	uint32_t txEnd;				/* Descriptor after the frame's last one */
+	uint64_t txDoneAt;
+	uint32_t intStatus;
+	uint16_t phyReg[32];		/* PHY registers behind the MII */
+	uint16_t mrdd;				/* Result of the MII read in progress */
+	uint64_t miiDoneAt;
+} SIM_ENET_T;
+
+/* A CAN frame as the controller registers hold it, RFS (or TFI), ID and data */
+typedef struct {
+	uint32_t info;
+	uint32_t id;
+	uint32_t data[2];
+} SIM_CAN_FRAME_T;
+
+typedef struct {
+	int num;					/* 0 for CAN1, as the AF numbers controllers */
+	SIM_CAN_FRAME_T rx[2];		/* Double receive buffer, rx[0] shows in RFS..RDB */
+	int rxCount;
+	bool overrun;
+	uint32_t icr;				/* Latched interrupt flags, RI is a level */
+	uint8_t txPending;			/* Bit n: buffer n waits for the bus */
+	uint8_t txSelf;				/* Bit n: self reception requested */
+	uint8_t txDone;				/* Bit n: TCS */
+	int txActive;				/* Buffer on the bus, or -1 */
+} SIM_CAN_T;
+
+/* The bus between CAN1, CAN2 and the other nodes */
+typedef struct {
+	SIM_CAN_FRAME_T line[SIM_CAN_QUEUE];	/* Frames the other nodes still send */
+	int lineHead, lineCount;
+	SIM_CAN_FRAME_T log[SIM_CAN_QUEUE];		/* Frames sent by CAN1 and CAN2 */
+	int logHead, logCount;
+	bool busy;
+	int sender;					/* Controller sending, -1 for another node */
+	SIM_CAN_FRAME_T frame;		/* Frame on the bus */
+	uint64_t doneAt;
+} SIM_CANBUS_T;
+
+typedef struct {
+	uint32_t enabled[SIM_NUM_IRQS / 32];
+	uint32_t pending[SIM_NUM_IRQS / 32];	/* Set through ISPR */
+	void (*handler[SIM_NUM_IRQS])(void);
+	uint32_t stVal;				/* SysTick current value */
+	bool stCountFlag;
+	bool stPending;				/* SysTick exception, PENDSTSET */
+	uint64_t stLastSync;
+	void (*stHandler)(void);
+} SIM_NVIC_T;
+
+typedef struct {
+	bool intFlag;				/* RITINT */
+	uint64_t lastSync;
+} SIM_RIT_T;
+
+#if defined(CHIP_LPC177X_8X)
+/* The SD card interface and the card on its bus */
+typedef struct {
+	uint8_t *pData;				/* Card blocks, NULL for no card */
+	uint32_t blocks;
+	SDMMC_STATE_T state;
+	uint16_t rca;
+	bool appCmd;				/* CMD55 taken, the next command is an ACMD */
+	bool highCap;				/* ACMD41 came from a host supporting SDHC */
+	bool wide;					/* 4 bit bus set by ACMD6 */
+	uint32_t opCondTries;		/* ACMD41s answered busy */
+	uint32_t errors;			/* R1 error bits, cleared once sent */
+	uint32_t nextBlock;			/* Block the card sends or takes next */
+	bool multi;					/* CMD18 or CMD25, ended by CMD12 */
+	bool busy;					/* DAT0 held low while the card programs */
+	uint64_t busyUntil;
+	int cmdPhase;				/* 0 idle, 1 command on CMD, 2 response on CMD */
+	uint64_t cmdAt;				/* End of the command phase */
+	uint32_t cmd, arg;			/* Command on CMD, latched when it started */
+	uint32_t respType;			/* SDC_COMMAND_xxx_RSP */
+	bool answered;
+	uint32_t respCmd;
+	uint32_t resp[4];
+	uint32_t status;			/* Latched STATUS bits, SDC_CLEAR_ALL */
+	bool dpsm;					/* Data path armed, transfer not finished */
+	bool rx;					/* Data path direction is from the card */
+	uint64_t armedAt;
+	uint32_t blockBytes;
+	uint32_t dataCnt;			/* Bytes still to cross the bus, DATACNT */
+	uint32_t hostLeft;			/* Words still to cross the FIFO register, FIFOCNT */
+	uint64_t timeoutAt;			/* Read data timeout, SIM_NEVER when off */
+	uint32_t fifo[SIM_SDC_MAX_BLOCK / 4];
+	uint32_t fifoHead, fifoCount;
+	bool wireBusy;				/* Block on the data lines */
+	bool wireRx;
+	uint32_t wireBlock;
+	uint64_t wireStartAt, wireDoneAt;
+	uint32_t wire[SIM_SDC_MAX_BLOCK / 4];	/* Block going to the card */
+	SIM_SDC_STATS_T stats;
+} SIM_SDC_T;
+
+static SIM_REGION_T simRegions[] = {
+	{0x10000000, 0x00010000},	/* Local SRAM */
+	{0x20000000, 0x00008000},	/* Peripheral SRAM */
+	{0x20080000, 0x00020000},	/* GPDMA, Ethernet, LCD, USB and GPIO */
+	{0x40000000, 0x00100000},	/* APB peripherals */
+	{0xE000E000, 0x00001000},	/* System control space */
+};
+
+#define SIM_RAM_BASE        0x20000000
+#else
+static SIM_REGION_T simRegions[] = {
+	{0x10000000, 0x00008000},	/* Local SRAM */
+	{0x2007C000, 0x00024000},	/* AHB SRAM and GPIO */
+	{0x40000000, 0x00100000},	/* APB peripherals */
+	{0x50000000, 0x00010000},	/* Ethernet, GPDMA and USB */
+	{0xE000E000, 0x00001000},	/* System control space */
+};
+
+#define SIM_RAM_BASE        0x2007C000
+#endif
+#define SIM_RAM_SIZE        0x8000
+
+static SIM_UART_T simUart[4];
+static SIM_SSP_T simSsp[2];
+static SIM_TIMER_T simTimer[4];
+static SIM_GPDMA_T simGpdma;
+static SIM_ENET_T simEnet;
+static SIM_NVIC_T simNvic;
+static SIM_CAN_T simCan[2];
+static SIM_CANBUS_T simCanBus;
+#if defined(CHIP_LPC175X_6X)
+static SIM_RIT_T simRit;
+#endif
+#if defined(CHIP_LPC177X_8X)
+static SIM_SDC_T simSdc;
+#endif
+
+static SIM_PAGE_T simPages[] = {
+	{LPC_UART0_BASE, SIM_UART, UART0_IRQn, &simUart[0]},
+	{LPC_UART1_BASE, SIM_UART, UART1_IRQn, &simUart[1]},
+	{LPC_UART2_BASE, SIM_UART, UART2_IRQn, &simUart[2]},
+	{LPC_UART3_BASE, SIM_UART, UART3_IRQn, &simUart[3]},
+	{LPC_SSP0_BASE, SIM_SSP, SSP0_IRQn, &simSsp[0]},
+	{LPC_SSP1_BASE, SIM_SSP, SSP1_IRQn, &simSsp[1]},
+	{LPC_TIMER0_BASE, SIM_TIMER, TIMER0_IRQn, &simTimer[0]},
+	{LPC_TIMER1_BASE, SIM_TIMER, TIMER1_IRQn, &simTimer[1]},
+	{LPC_TIMER2_BASE, SIM_TIMER, TIMER2_IRQn, &simTimer[2]},
+	{LPC_TIMER3_BASE, SIM_TIMER, TIMER3_IRQn, &simTimer[3]},
+	{LPC_GPDMA_BASE, SIM_GPDMA, DMA_IRQn, &simGpdma},
+	{LPC_ENET_BASE, SIM_ENET, ETHERNET_IRQn, &simEnet},
+	{SCS_BASE, SIM_NVIC, -1, &simNvic},
+	{LPC_CANAF_RAM_BASE, SIM_CANAF, -1, NULL},
+	{LPC_CANAF_BASE, SIM_CANAF, -1, NULL},
+	{LPC_CAN1_BASE, SIM_CAN, CAN_IRQn, &simCan[0]},
+	{LPC_CAN2_BASE, SIM_CAN, CAN_IRQn, &simCan[1]},
+	{LPC_CANCR_BASE, SIM_CANCR, -1, NULL},
+#if defined(CHIP_LPC175X_6X)
+	{LPC_RITIMER_BASE, SIM_RIT, RITIMER_IRQn, &simRit},
+#endif
+#if defined(CHIP_LPC177X_8X)
+	{LPC_SDC_BASE, SIM_SDC, SDC_IRQn, &simSdc},
+#endif
+};
+
+#define SIM_NUM_PAGES       (sizeof(simPages) / sizeof(simPages[0]))
+#define SIM_NUM_REGIONS     (sizeof(simRegions) / sizeof(simRegions[0]))
+
+static bool simMapped;
+static uint64_t simCycles;
+static bool simPrimask;
+static uint32_t simRamNext;
+
+/* The access being single-stepped */
+static SIM_PAGE_T *pStepPage;
+static uint32_t stepOffset;
+static bool stepWrite;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static SIM_PAGE_T *findPage(uint32_t addr)
+{
+	unsigned int i;
+
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		if ((addr & ~(SIM_PAGE_SIZE - 1)) == simPages[i].base) {
+			return &simPages[i];
+		}
+	}
+	return NULL;
+}
+
+static uint8_t *findAlias(uint32_t addr)
+{
+	unsigned int i;
+
+	for (i = 0; i < SIM_NUM_REGIONS; i++) {
+		if ((addr >= simRegions[i].base) && (addr - simRegions[i].base < simRegions[i].size)) {
+			return simRegions[i].alias + (addr - simRegions[i].base);
+		}
+	}
+	return NULL;
+}
+
+/* UART model */
+
+static uint64_t uartCharCycles(SIM_PAGE_T *pPage)
+{
+	SIM_UART_T *pUart = pPage->pState;
+	uint32_t lcr = REG(pPage, UART_LCR), fdr = REG(pPage, UART_FDR);
+	uint32_t div, divAdd, mul, bits;
+	uint64_t cycles;
+
+	div = (pUart->dlm << 8) | pUart->dll;
+	if (div == 0) {
+		div = 1;
+	}
+	divAdd = fdr & 0xF;
+	mul = (fdr >> 4) & 0xF;
+	if (mul == 0) {
+		mul = 1;
+	}
+	bits = 1 + 5 + (lcr & UART_LCR_WLEN_MASK) + ((lcr & UART_LCR_PARITY_EN) ? 1 : 0) +
+		   ((lcr & UART_LCR_SBS_2BIT) ? 2 : 1);
+	cycles = ((uint64_t) bits * 16 * div * (mul + divAdd)) / mul;
+
+	return cycles ? cycles : 1;
+}
+
+static int uartTrigger(SIM_UART_T *pUart)
+{
+	static const int levels[] = {1, 4, 8, 14};
+
+	if ((pUart->fcr & UART_FCR_FIFO_EN) == 0) {
+		return 1;
+	}
+	return levels[(pUart->fcr >> 6) & 3];
+}
+
+/* Move the next character from the transmit FIFO to the shift register */
+static void uartLoadShift(SIM_PAGE_T *pPage, uint64_t startAt)
+{
+	SIM_UART_T *pUart = pPage->pState;
+
+	pUart->txShift = pUart->txFifo[pUart->txHead];
+	pUart->txHead = (pUart->txHead + 1) % SIM_UART_FIFO_SIZE;
+	pUart->txCount--;
+	pUart->txBusy = true;
+	pUart->txDoneAt = startAt + uartCharCycles(pPage);
+	if (pUart->txCount == 0) {
+		pUart->threPending = true;
+	}
+}
+
+static uint64_t uartNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_UART_T *pUart = pPage->pState;
+	uint64_t next = SIM_NEVER;
+
+	if (pUart->txBusy) {
+		next = pUart->txDoneAt;
+	}
+	if ((pUart->lineCount > 0) && (pUart->lineNextAt < next)) {
+		next = pUart->lineNextAt;
+	}
+	return next;
+}
+
+static void uartSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_UART_T *pUart = pPage->pState;
+
+	while (pUart->txBusy && (pUart->txDoneAt <= until)) {
+		if (pUart->logCount < SIM_UART_LINE_SIZE) {
+			pUart->log[(pUart->logHead + pUart->logCount) % SIM_UART_LINE_SIZE] = pUart->txShift;
+			pUart->logCount++;
+		}
+		pUart->txBusy = false;
+		if ((pUart->txCount > 0) && (REG(pPage, UART_TER1) & UART_TER1_TXEN)) {
+			uartLoadShift(pPage, pUart->txDoneAt);
+		}
+	}
+
+	while ((pUart->lineCount > 0) && (pUart->lineNextAt <= until)) {
+		uint8_t ch = pUart->line[pUart->lineHead];
+
+		pUart->lineHead = (pUart->lineHead + 1) % SIM_UART_LINE_SIZE;
+		pUart->lineCount--;
+		if (pUart->rxCount < SIM_UART_FIFO_SIZE) {
+			pUart->rxFifo[(pUart->rxHead + pUart->rxCount) % SIM_UART_FIFO_SIZE] = ch;
+			pUart->rxCount++;
+		}
+		else {
+			pUart->overrun = true;
+		}
+		pUart->lastRxAt = pUart->lineNextAt;
+		pUart->lineNextAt += uartCharCycles(pPage);
+	}
+}
+
+static bool uartTimeout(SIM_PAGE_T *pPage)
+{
+	SIM_UART_T *pUart = pPage->pState;
+
+	return (pUart->rxCount > 0) && (simCycles - pUart->lastRxAt >= 4 * uartCharCycles(pPage));
+}
+
+/* Interrupt identification, UART_IIR_INTSTAT_PEND when nothing is pending */
+static uint32_t uartIntId(SIM_PAGE_T *pPage)
+{
+	SIM_UART_T *pUart = pPage->pState;
+
+	if ((pUart->ier & UART_IER_RLSINT) && pUart->overrun) {
+		return UART_IIR_INTID_RLS;
+	}
+	if ((pUart->ier & UART_IER_RBRINT) && (pUart->rxCount >= uartTrigger(pUart))) {
+		return UART_IIR_INTID_RDA;
+	}
+	if ((pUart->ier & UART_IER_RBRINT) && uartTimeout(pPage)) {
+		return UART_IIR_INTID_CTI;
+	}
+	if ((pUart->ier & UART_IER_THREINT) && pUart->threPending) {
+		return UART_IIR_INTID_THRE;
+	}
+	return UART_IIR_INTSTAT_PEND;
+}
+
+static uint32_t uartRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	SIM_UART_T *pUart = pPage->pState;
+	bool dlab = (REG(pPage, UART_LCR) & UART_LCR_DLAB_EN) != 0;
+	uint32_t value;
+
+	switch (off) {
+	case UART_RBR:
+		if (dlab) {
+			return pUart->dll;
+		}
+		value = pUart->rxFifo[pUart->rxHead];
+		if (effects && (pUart->rxCount > 0)) {
+			pUart->rxHead = (pUart->rxHead + 1) % SIM_UART_FIFO_SIZE;
+			pUart->rxCount--;
+			pUart->lastRxAt = simCycles;
+		}
+		return value;
+
+	case UART_IER:
+		return dlab ? pUart->dlm : pUart->ier;
+
+	case UART_IIR:
+		value = uartIntId(pPage);
+		if (effects && (value == UART_IIR_INTID_THRE)) {
+			pUart->threPending = false;
+		}
+		return value | ((pUart->fcr & UART_FCR_FIFO_EN) ? UART_IIR_FIFO_EN : 0);
+
+	case UART_LSR:
+		value = 0;
+		if (pUart->rxCount > 0) {
+			value |= UART_LSR_RDR;
+		}
+		if (pUart->overrun) {
+			value |= UART_LSR_OE;
+		}
+		if (pUart->txCount == 0) {
+			value |= UART_LSR_THRE;
+			if (!pUart->txBusy) {
+				value |= UART_LSR_TEMT;
+			}
+		}
+		if (effects) {
+			pUart->overrun = false;
+		}
+		return value;
+
+	default:
+		return REG(pPage, off);
+	}
+}
+
+static void uartWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_UART_T *pUart = pPage->pState;
+	bool dlab = (REG(pPage, UART_LCR) & UART_LCR_DLAB_EN) != 0;
+
+	switch (off) {
+	case UART_RBR:
+		if (dlab) {
+			pUart->dll = value & 0xFF;
+			break;
+		}
+		if (pUart->txCount < SIM_UART_FIFO_SIZE) {
+			pUart->txFifo[(pUart->txHead + pUart->txCount) % SIM_UART_FIFO_SIZE] = (uint8_t) value;
+			pUart->txCount++;
+		}
+		pUart->threPending = false;
+		if (!pUart->txBusy && (REG(pPage, UART_TER1) & UART_TER1_TXEN)) {
+			uartLoadShift(pPage, simCycles);
+		}
+		break;
+
+	case UART_IER:
+		if (dlab) {
+			pUart->dlm = value & 0xFF;
+			break;
+		}
+		/* Enabling THRE with an empty FIFO raises it at once, as on a 16550 */
+		if ((value & ~pUart->ier & UART_IER_THREINT) && (pUart->txCount == 0)) {
+			pUart->threPending = true;
+		}
+		pUart->ier = value & UART_IER_BITMASK;
+		break;
+
+	case UART_IIR:
+		pUart->fcr = value & UART_FCR_BITMASK;
+		if (value & UART_FCR_RX_RS) {
+			pUart->rxCount = 0;
+		}
+		if (value & UART_FCR_TX_RS) {
+			pUart->txCount = 0;
+			pUart->threPending = true;
+		}
+		break;
+
+	case UART_TER1:
+		if ((value & UART_TER1_TXEN) && !pUart->txBusy && (pUart->txCount > 0)) {
+			uartLoadShift(pPage, simCycles);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+static bool uartLevel(SIM_PAGE_T *pPage)
+{
+	return uartIntId(pPage) != UART_IIR_INTSTAT_PEND;
+}
+
+static bool uartDmaReady(SIM_PAGE_T *pPage, uint32_t off, bool toPeriph)
+{
+	SIM_UART_T *pUart = pPage->pState;
+
+	if ((off != UART_RBR) || ((pUart->fcr & UART_FCR_DMAMODE_SEL) == 0)) {
+		return false;
+	}
+	return toPeriph ? (pUart->txCount < SIM_UART_FIFO_SIZE) : (pUart->rxCount > 0);
+}
+
+static void uartReset(SIM_PAGE_T *pPage)
+{
+	memset(pPage->pState, 0, sizeof(SIM_UART_T));
+	((SIM_UART_T *) pPage->pState)->dll = 1;
+	REG(pPage, UART_IIR) = UART_IIR_INTSTAT_PEND;
+	REG(pPage, UART_LSR) = UART_LSR_THRE | UART_LSR_TEMT;
+	REG(pPage, UART_FDR) = 0x10;
+	REG(pPage, UART_TER1) = UART_TER1_TXEN;
+}
+
+/* SSP model */
+
+static uint64_t sspFrameCycles(SIM_PAGE_T *pPage)
+{
+	uint32_t cr0 = REG(pPage, SSP_CR0), cpsr = REG(pPage, SSP_CPSR) & 0xFE;
+
+	if (cpsr < 2) {
+		cpsr = 2;
+	}
+	return (uint64_t) ((cr0 & 0xF) + 1) * (((cr0 >> 8) & 0xFF) + 1) * cpsr;
+}
+
+static void sspStart(SIM_PAGE_T *pPage, uint64_t startAt)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+	uint32_t cr1 = REG(pPage, SSP_CR1);
+
+	/* Only a master clocks frames out by itself */
+	if (pSsp->busy || (pSsp->txCount == 0) || ((cr1 & SSP_CR1_SSP_EN) == 0) || (cr1 & SSP_CR1_SLAVE_EN)) {
+		return;
+	}
+	pSsp->shift = pSsp->txFifo[pSsp->txHead];
+	pSsp->txHead = (pSsp->txHead + 1) % SIM_SSP_FIFO_SIZE;
+	pSsp->txCount--;
+	pSsp->busy = true;
+	pSsp->doneAt = startAt + sspFrameCycles(pPage);
+}
+
+static uint64_t sspNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+
+	return pSsp->busy ? pSsp->doneAt : SIM_NEVER;
+}
+
+static void sspSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+	uint16_t mask = (uint16_t) ((2 << (REG(pPage, SSP_CR0) & 0xF)) - 1);
+	uint16_t rx;
+
+	while (pSsp->busy && (pSsp->doneAt <= until)) {
+		if (REG(pPage, SSP_CR1) & SSP_CR1_LBM_EN) {
+			rx = pSsp->shift;
+		}
+		else if (pSsp->device != NULL) {
+			rx = pSsp->device(pSsp->ctx, pSsp->shift);
+		}
+		else {
+			rx = 0;
+		}
+		if (pSsp->rxCount < SIM_SSP_FIFO_SIZE) {
+			pSsp->rxFifo[(pSsp->rxHead + pSsp->rxCount) % SIM_SSP_FIFO_SIZE] = rx & mask;
+			pSsp->rxCount++;
+		}
+		else {
+			pSsp->overrun = true;
+		}
+		pSsp->lastRxAt = pSsp->doneAt;
+		pSsp->busy = false;
+		sspStart(pPage, pSsp->doneAt);
+	}
+}
+
+static uint32_t sspRawInt(SIM_PAGE_T *pPage)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+	uint32_t cpsr = REG(pPage, SSP_CPSR) & 0xFE, ris = 0;
+	uint64_t bitCycles = (uint64_t) (((REG(pPage, SSP_CR0) >> 8) & 0xFF) + 1) * (cpsr < 2 ? 2 : cpsr);
+
+	if (pSsp->overrun) {
+		ris |= SSP_RORRIS;
+	}
+	if ((pSsp->rxCount > 0) && (simCycles - pSsp->lastRxAt >= 32 * bitCycles)) {
+		ris |= SSP_RTRIS;
+	}
+	if (pSsp->rxCount >= SIM_SSP_FIFO_SIZE / 2) {
+		ris |= SSP_RXRIS;
+	}
+	if (pSsp->txCount <= SIM_SSP_FIFO_SIZE / 2) {
+		ris |= SSP_TXRIS;
+	}
+	return ris;
+}
+
+static uint32_t sspRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+	uint32_t value;
+
+	switch (off) {
+	case SSP_DR:
+		value = pSsp->rxFifo[pSsp->rxHead];
+		if (effects && (pSsp->rxCount > 0)) {
+			pSsp->rxHead = (pSsp->rxHead + 1) % SIM_SSP_FIFO_SIZE;
+			pSsp->rxCount--;
+			pSsp->lastRxAt = simCycles;
+		}
+		return value;
+
+	case SSP_SR:
+		value = 0;
+		if (pSsp->txCount == 0) {
+			value |= SSP_STAT_TFE;
+		}
+		if (pSsp->txCount < SIM_SSP_FIFO_SIZE) {
+			value |= SSP_STAT_TNF;
+		}
+		if (pSsp->rxCount > 0) {
+			value |= SSP_STAT_RNE;
+		}
+		if (pSsp->rxCount == SIM_SSP_FIFO_SIZE) {
+			value |= SSP_STAT_RFF;
+		}
+		if (pSsp->busy || ((pSsp->txCount > 0) && (REG(pPage, SSP_CR1) & SSP_CR1_SSP_EN))) {
+			value |= SSP_STAT_BSY;
+		}
+		return value;
+
+	case SSP_RIS:
+		return sspRawInt(pPage);
+
+	case SSP_MIS:
+		return sspRawInt(pPage) & REG(pPage, SSP_IMSC);
+
+	case SSP_ICR:
+		return 0;
+
+	default:
+		return REG(pPage, off);
+	}
+}
+
+static void sspWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+
+	switch (off) {
+	case SSP_DR:
+		if (pSsp->txCount < SIM_SSP_FIFO_SIZE) {
+			pSsp->txFifo[(pSsp->txHead + pSsp->txCount) % SIM_SSP_FIFO_SIZE] = (uint16_t) value;
+			pSsp->txCount++;
+		}
+		sspStart(pPage, simCycles);
+		break;
+
+	case SSP_CR1:
+		sspStart(pPage, simCycles);
+		break;
+
+	case SSP_ICR:
+		if (value & SSP_ICR_ROR) {
+			pSsp->overrun = false;
+		}
+		if (value & SSP_ICR_RT) {
+			pSsp->lastRxAt = simCycles;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+static bool sspLevel(SIM_PAGE_T *pPage)
+{
+	return (sspRawInt(pPage) & REG(pPage, SSP_IMSC)) != 0;
+}
+
+static bool sspDmaReady(SIM_PAGE_T *pPage, uint32_t off, bool toPeriph)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+
+	if (off != SSP_DR) {
+		return false;
+	}
+	if (toPeriph) {
+		return (REG(pPage, SSP_DMACR) & SSP_DMA_TX) && (pSsp->txCount < SIM_SSP_FIFO_SIZE);
+	}
+	return (REG(pPage, SSP_DMACR) & SSP_DMA_RX) && (pSsp->rxCount > 0);
+}
+
+static void sspReset(SIM_PAGE_T *pPage)
+{
+	SIM_SSP_T *pSsp = pPage->pState;
+	SIM_SSP_DEVICE_T device = pSsp->device;
+	void *ctx = pSsp->ctx;
+
+	/* The attached device survives a reset */
+	memset(pSsp, 0, sizeof(SIM_SSP_T));
+	pSsp->device = device;
+	pSsp->ctx = ctx;
+	REG(pPage, SSP_SR) = SSP_STAT_TFE | SSP_STAT_TNF;
+}
+
+/* Timer model */
+
+static bool timerCounting(SIM_PAGE_T *pPage)
+{
+	/* Timer mode only, counter mode has no input to count */
+	return ((REG(pPage, TMR_TCR) & 3) == 1) && ((REG(pPage, TMR_CTCR) & 3) == 0);
+}
+
+/* Number of counts until TC next equals a match register with an action */
+static uint64_t timerMatchDistance(SIM_PAGE_T *pPage)
+{
+	SIM_TIMER_T *pTimer = pPage->pState;
+	uint32_t mcr = REG(pPage, TMR_MCR), first, i;
+	uint64_t best = SIM_NEVER, d;
+
+	first = pTimer->resetPending ? 0 : REG(pPage, TMR_TC) + 1;
+	for (i = 0; i < 4; i++) {
+		if ((mcr >> (3 * i)) & 7) {
+			d = (uint64_t) (uint32_t) (REG(pPage, TMR_MR0 + 4 * i) - first) + 1;
+			if (d < best) {
+				best = d;
+			}
+		}
+	}
+	return best;
+}
+
+/* Cycles from lastSync to the next count */
+static uint64_t timerFirstCount(SIM_PAGE_T *pPage)
+{
+	uint32_t pr = REG(pPage, TMR_PR), pc = REG(pPage, TMR_PC);
+
+	return (pc > pr) ? 1 : (uint64_t) (pr - pc) + 1;
+}
+
+static uint64_t timerNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_TIMER_T *pTimer = pPage->pState;
+	uint64_t d, period = (uint64_t) REG(pPage, TMR_PR) + 1;
+
+	if (!timerCounting(pPage)) {
+		return SIM_NEVER;
+	}
+	d = timerMatchDistance(pPage);
+	if ((d == SIM_NEVER) || (d - 1 > (SIM_NEVER - pTimer->lastSync) / period / 2)) {
+		return SIM_NEVER;
+	}
+	return pTimer->lastSync + timerFirstCount(pPage) + (d - 1) * period;
+}
+
+static void timerMatch(SIM_PAGE_T *pPage)
+{
+	SIM_TIMER_T *pTimer = pPage->pState;
+	uint32_t tc = REG(pPage, TMR_TC), mcr = REG(pPage, TMR_MCR), i;
+
+	for (i = 0; i < 4; i++) {
+		if (REG(pPage, TMR_MR0 + 4 * i) != tc) {
+			continue;
+		}
+		if (mcr & TIMER_INT_ON_MATCH(i)) {
+			pTimer->ir |= TIMER_IR_CLR(i);
+		}
+		if (mcr & TIMER_RESET_ON_MATCH(i)) {
+			pTimer->resetPending = true;
+		}
+		if (mcr & TIMER_STOP_ON_MATCH(i)) {
+			REG(pPage, TMR_TCR) &= ~TIMER_ENABLE;
+		}
+	}
+	REG(pPage, TMR_IR) = pTimer->ir;
+}
+
+static void timerSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_TIMER_T *pTimer = pPage->pState;
+	uint64_t elapsed, first, period, n, d;
+	uint32_t start;
+
+	while (pTimer->lastSync < until) {
+		if (!timerCounting(pPage)) {
+			pTimer->lastSync = until;
+			break;
+		}
+		elapsed = until - pTimer->lastSync;
+		first = timerFirstCount(pPage);
+		if (elapsed < first) {
+			REG(pPage, TMR_PC) += (uint32_t) elapsed;
+			pTimer->lastSync = until;
+			break;
+		}
+		period = (uint64_t) REG(pPage, TMR_PR) + 1;
+		n = 1 + (elapsed - first) / period;
+		d = timerMatchDistance(pPage);
+		start = pTimer->resetPending ? 0 : REG(pPage, TMR_TC) + 1;
+		pTimer->resetPending = false;
+		if (d <= n) {
+			REG(pPage, TMR_TC) = start + (uint32_t) (d - 1);
+			REG(pPage, TMR_PC) = 0;
+			pTimer->lastSync += first + (d - 1) * period;
+			timerMatch(pPage);
+		}
+		else {
+			REG(pPage, TMR_TC) = start + (uint32_t) (n - 1);
+			REG(pPage, TMR_PC) = (uint32_t) ((elapsed - first) % period);
+			pTimer->lastSync = until;
+		}
+	}
+}
+
+static uint32_t timerRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	(void) effects;
+	if (off == TMR_IR) {
+		return ((SIM_TIMER_T *) pPage->pState)->ir;
+	}
+	return REG(pPage, off);
+}
+
+static void timerWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_TIMER_T *pTimer = pPage->pState;
+
+	switch (off) {
+	case TMR_IR:
+		pTimer->ir &= ~value;
+		REG(pPage, TMR_IR) = pTimer->ir;
+		break;
+
+	case TMR_TCR:
+		if (value & TIMER_RESET) {
+			REG(pPage, TMR_TC) = 0;
+			REG(pPage, TMR_PC) = 0;
+			pTimer->resetPending = false;
+		}
+		break;
+
+	case TMR_TC:
+		pTimer->resetPending = false;
+		break;
+
+	default:
+		break;
+	}
+	pTimer->lastSync = simCycles;
+}
+
+static bool timerLevel(SIM_PAGE_T *pPage)
+{
+	return ((SIM_TIMER_T *) pPage->pState)->ir != 0;
+}
+
+static void timerReset(SIM_PAGE_T *pPage)
+{
+	memset(pPage->pState, 0, sizeof(SIM_TIMER_T));
+}
+
+#if defined(CHIP_LPC175X_6X)
+/* RIT model, one count per peripheral clock, RIMASK taken as 0 */
+
+/* Counts from COUNTER to the next match */
+static uint64_t ritMatchDistance(SIM_PAGE_T *pPage)
+{
+	uint32_t d = REG(pPage, RIT_COMPVAL) - REG(pPage, RIT_COUNTER);
+
+	return (d == 0) ? (1ULL << 32) : d;
+}
+
+static uint64_t ritNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_RIT_T *pRit = pPage->pState;
+
+	if ((REG(pPage, RIT_CTRL) & RIT_CTRL_TEN) == 0) {
+		return SIM_NEVER;
+	}
+	return pRit->lastSync + ritMatchDistance(pPage);
+}
+
+static void ritSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_RIT_T *pRit = pPage->pState;
+	uint32_t compval = REG(pPage, RIT_COMPVAL);
+	uint64_t n, d, period;
+
+	if ((REG(pPage, RIT_CTRL) & RIT_CTRL_TEN) == 0) {
+		pRit->lastSync = until;
+		return;
+	}
+	n = until - pRit->lastSync;
+	pRit->lastSync = until;
+	d = ritMatchDistance(pPage);
+	if (n < d) {
+		REG(pPage, RIT_COUNTER) += (uint32_t) n;
+		return;
+	}
+
+	/* With RITENCLR the counter is cleared on the clock that matches */
+	pRit->intFlag = true;
+	n -= d;
+	if ((REG(pPage, RIT_CTRL) & RIT_CTRL_ENCLR) && (compval != 0)) {
+		period = compval;
+		REG(pPage, RIT_COUNTER) = (uint32_t) (n % period);
+	}
+	else {
+		REG(pPage, RIT_COUNTER) = compval + (uint32_t) n;
+	}
+}
+
+static uint32_t ritRead(SIM_PAGE_T *pPage, uint32_t off)
+{
+	if (off == RIT_CTRL) {
+		return (REG(pPage, RIT_CTRL) & ~RIT_CTRL_INT) |
+			   (((SIM_RIT_T *) pPage->pState)->intFlag ? RIT_CTRL_INT : 0);
+	}
+	return REG(pPage, off);
+}
+
+static void ritWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_RIT_T *pRit = pPage->pState;
+
+	if (off == RIT_CTRL) {
+		/* RITINT is write 1 to clear */
+		if (value & RIT_CTRL_INT) {
+			pRit->intFlag = false;
+		}
+		REG(pPage, RIT_CTRL) = value & ~RIT_CTRL_INT;
+	}
+	pRit->lastSync = simCycles;
+}
+
+static bool ritLevel(SIM_PAGE_T *pPage)
+{
+	return ((SIM_RIT_T *) pPage->pState)->intFlag;
+}
+
+static void ritReset(SIM_PAGE_T *pPage)
+{
+	memset(pPage->pState, 0, sizeof(SIM_RIT_T));
+}
+
+#endif
+
+/* NVIC and SysTick model, SysTick counts CPU clocks whatever CLKSOURCE */
+
+static bool irqLevel(int irq);
+
+static bool sysTickRunning(SIM_PAGE_T *pPage)
+{
+	return (REG(pPage, ST_CTRL) & SysTick_CTRL_ENABLE_Msk) && ((REG(pPage, ST_LOAD) & 0xFFFFFF) != 0);
+}
+
+/* CPU clocks from stVal to the next time the counter reaches 0 */
+static uint64_t sysTickZeroDistance(SIM_PAGE_T *pPage)
+{
+	return (simNvic.stVal != 0) ? simNvic.stVal : (uint64_t) (REG(pPage, ST_LOAD) & 0xFFFFFF) + 1;
+}
+
+static uint64_t sysTickNextEvent(SIM_PAGE_T *pPage)
+{
+	if (!sysTickRunning(pPage) || ((REG(pPage, ST_CTRL) & SysTick_CTRL_TICKINT_Msk) == 0)) {
+		return SIM_NEVER;
+	}
+	return simNvic.stLastSync + (sysTickZeroDistance(pPage) + SIM_CCLK_PER_PCLK - 1) / SIM_CCLK_PER_PCLK;
+}
+
+static void sysTickSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	uint64_t clocks, d, period;
+
+	if (!sysTickRunning(pPage)) {
+		simNvic.stLastSync = until;
+		return;
+	}
+	clocks = (until - simNvic.stLastSync) * SIM_CCLK_PER_PCLK;
+	simNvic.stLastSync = until;
+	d = sysTickZeroDistance(pPage);
+	if (clocks < d) {
+		simNvic.stVal = (uint32_t) (d - clocks);
+		return;
+	}
+
+	/* Reached 0, then reloads from LOAD on the next clock */
+	simNvic.stCountFlag = true;
+	if (REG(pPage, ST_CTRL) & SysTick_CTRL_TICKINT_Msk) {
+		simNvic.stPending = true;
+	}
+	period = (uint64_t) (REG(pPage, ST_LOAD) & 0xFFFFFF) + 1;
+	clocks = (clocks - d) % period;
+	simNvic.stVal = (clocks == 0) ? 0 : (uint32_t) (period - clocks);
+}
+
+static uint32_t nvicPendingWord(int n)
+{
+	uint32_t value = simNvic.pending[n];
+	int i;
+
+	for (i = 0; i < 32; i++) {
+		if (irqLevel(32 * n + i)) {
+			value |= 1UL << i;
+		}
+	}
+	return value;
+}
+
+static uint32_t nvicRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	int n = (off & 0x7F) / 4;
+	bool countFlag = simNvic.stCountFlag;
+
+	switch (off) {
+	case ST_CTRL:
+		/* COUNTFLAG clears on read */
+		if (effects) {
+			simNvic.stCountFlag = false;
+		}
+		return (REG(pPage, ST_CTRL) & ~SysTick_CTRL_COUNTFLAG_Msk) | (countFlag ? SysTick_CTRL_COUNTFLAG_Msk : 0);
+
+	case ST_VAL:
+		return simNvic.stVal;
+
+	case SCB_ICSR:
+		return simNvic.stPending ? SCB_ICSR_PENDSTSET_Msk : 0;
+	}
+	if ((off >= NVIC_ISER) && (off < NVIC_ISPR) && (n < SIM_NUM_IRQS / 32)) {
+		return simNvic.enabled[n];
+	}
+	if ((off >= NVIC_ISPR) && (off < NVIC_ICPR + 0x80) && (n < SIM_NUM_IRQS / 32)) {
+		return nvicPendingWord(n);
+	}
+	return REG(pPage, off);
+}
+
+static void nvicWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	int n = (off & 0x7F) / 4;
+
+	switch (off) {
+	case ST_CTRL:
+	case ST_LOAD:
+		simNvic.stLastSync = simCycles;
+		return;
+
+	case ST_VAL:
+		/* Any write clears the counter and COUNTFLAG */
+		simNvic.stVal = 0;
+		simNvic.stCountFlag = false;
+		simNvic.stLastSync = simCycles;
+		return;
+
+	case SCB_ICSR:
+		if (value & SCB_ICSR_PENDSTSET_Msk) {
+			simNvic.stPending = true;
+		}
+		if (value & SCB_ICSR_PENDSTCLR_Msk) {
+			simNvic.stPending = false;
+		}
+		return;
+	}
+	if ((off < NVIC_ISER) || (off >= NVIC_ICPR + 0x80) || (n >= SIM_NUM_IRQS / 32)) {
+		return;
+	}
+	switch (off & ~0x7F) {
+	case NVIC_ISER:
+		simNvic.enabled[n] |= value;
+		break;
+
+	case NVIC_ICER:
+		simNvic.enabled[n] &= ~value;
+		break;
+
+	case NVIC_ISPR:
+		simNvic.pending[n] |= value;
+		break;
+
+	case NVIC_ICPR:
+		simNvic.pending[n] &= ~value;
+		break;
+	}
+}
+
+static void nvicReset(SIM_PAGE_T *pPage)
+{
+	(void) pPage;
+	memset(simNvic.enabled, 0, sizeof(simNvic.enabled));
+	memset(simNvic.pending, 0, sizeof(simNvic.pending));
+	simNvic.stVal = 0;
+	simNvic.stCountFlag = false;
+	simNvic.stPending = false;
+	simNvic.stLastSync = 0;
+}
+
+/* GPDMA model */
+
+static uint32_t gpdmaTcStat(SIM_PAGE_T *pPage)
+{
+	uint32_t mask = 0;
+	int ch;
+
+	for (ch = 0; ch < GPDMA_NUMBER_CHANNELS; ch++) {
+		if (REG(pPage, DMA_CH(ch) + DMA_CH_CONFIG) & GPDMA_DMACCxConfig_ITC) {
+			mask |= 1UL << ch;
+		}
+	}
+	return simGpdma.rawTc & mask;
+}
+
+static uint32_t gpdmaRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	uint32_t value = 0;
+	int ch;
+
+	(void) effects;
+	switch (off) {
+	case DMA_INTSTAT:
+		return gpdmaTcStat(pPage) | simGpdma.rawErr;
+
+	case DMA_INTTCSTAT:
+		return gpdmaTcStat(pPage);
+
+	case DMA_INTERRSTAT:
+	case DMA_RAWINTERRSTAT:
+		return simGpdma.rawErr;
+
+	case DMA_RAWINTTCSTAT:
+		return simGpdma.rawTc;
+
+	case DMA_ENBLDCHNS:
+		for (ch = 0; ch < GPDMA_NUMBER_CHANNELS; ch++) {
+			if (REG(pPage, DMA_CH(ch) + DMA_CH_CONFIG) & GPDMA_DMACCxConfig_E) {
+				value |= 1UL << ch;
+			}
+		}
+		return value;
+
+	case DMA_INTTCCLEAR:
+	case DMA_INTERRCLR:
+		return 0;
+
+	default:
+		return REG(pPage, off);
+	}
+}
+
+static void gpdmaWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	(void) pPage;
+	if (off == DMA_INTTCCLEAR) {
+		simGpdma.rawTc &= ~value;
+	}
+	else if (off == DMA_INTERRCLR) {
+		simGpdma.rawErr &= ~value;
+	}
+}
+
+static bool gpdmaLevel(SIM_PAGE_T *pPage)
+{
+	return (gpdmaTcStat(pPage) | simGpdma.rawErr) != 0;
+}
+
+static void gpdmaReset(SIM_PAGE_T *pPage)
+{
+	(void) pPage;
+	memset(&simGpdma, 0, sizeof(simGpdma));
+}
+
+/* Ethernet MAC model */
+
+/* Wire time of a frame with preamble, CRC and inter-frame gap */
+static uint64_t enetFrameCycles(SIM_PAGE_T *pPage, uint32_t len)
+{
+	uint64_t rate = (REG(pPage, ENET_SUPP) & ENET_SUPP_100Mbps_SPEED) ? 100000000 : 10000000;
+
+	if (len < 60) {
+		len = 60;
+	}
+	return ((uint64_t) (len + 4 + 8 + 12) * 8 * SIM_PCLK_HZ + rate - 1) / rate;
+}
+
+/* An MII management frame is 64 MDC clocks, MDC is CCLK / MCFG divider */
+static uint64_t enetMiiCycles(SIM_PAGE_T *pPage)
+{
+	static const uint8_t div[16] = {4, 4, 6, 8, 10, 14, 20, 28, 36, 40, 44, 48, 52, 56, 60, 64};
+
+	return (uint64_t) 64 * div[(REG(pPage, ENET_MCFG) >> 2) & 0xF] * SIM_PCLK_HZ / SIM_CCLK_HZ;
+}
+
+static uint32_t enetCrc(const uint8_t *data, uint32_t len)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	int bit;
+
+	while (len--) {
+		crc ^= *data++;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+		}
+	}
+	return ~crc;
+}
+
+static uint32_t enetNext(SIM_PAGE_T *pPage, uint32_t idx, uint32_t numOff)
+{
+	return (idx >= REG(pPage, numOff)) ? 0 : idx + 1;
+}
+
+/* Put the frame at the consume index on the wire once it is complete */
+static void enetTxStart(SIM_PAGE_T *pPage, uint64_t startAt)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	uint32_t idx = REG(pPage, ENET_TXCONSUME), produce = REG(pPage, ENET_TXPRODUCE);
+	uint32_t *pDesc, size, len = 0;
+
+	if (pEnet->txBusy || ((REG(pPage, ENET_COMMAND) & ENET_COMMAND_TXENABLE) == 0)) {
+		return;
+	}
+	while (idx != produce) {
+		pDesc = (uint32_t *) (uintptr_t) (REG(pPage, ENET_TXDESC) + 8 * idx);
+		size = (pDesc[1] & 0x7FF) + 1;
+		if (len + size <= SIM_ENET_MAX_FRAME) {
+			memcpy(&pEnet->txFrame.data[len], (void *) (uintptr_t) pDesc[0], size);
+			len += size;
+		}
+		idx = enetNext(pPage, idx, ENET_TXNUM);
+		if (pDesc[1] & ENET_TCTRL_LAST) {
+			if ((len < 60) && (REG(pPage, ENET_MAC2) & ENET_MAC2_PADCRCEN)) {
+				memset(&pEnet->txFrame.data[len], 0, 60 - len);
+				len = 60;
+			}
+			pEnet->txFrame.len = len;
+			pEnet->txEnd = idx;
+			pEnet->txBusy = true;
+			pEnet->txDoneAt = startAt + enetFrameCycles(pPage, len);
+			return;
+		}
+	}
+	/* The rest of the frame is not queued yet */
+}
+
+static void enetTxDone(SIM_PAGE_T *pPage)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	uint32_t idx = REG(pPage, ENET_TXCONSUME), *pDesc, *pStat;
+	bool intr = false;
+
+	while (idx != pEnet->txEnd) {
+		pDesc = (uint32_t *) (uintptr_t) (REG(pPage, ENET_TXDESC) + 8 * idx);
+		pStat = (uint32_t *) (uintptr_t) (REG(pPage, ENET_TXSTAT) + 4 * idx);
+		*pStat = 0;
+		intr = (pDesc[1] & ENET_TCTRL_INT) != 0;
+		idx = enetNext(pPage, idx, ENET_TXNUM);
+	}
+	REG(pPage, ENET_TXCONSUME) = idx;
+	pEnet->txBusy = false;
+	if (intr) {
+		pEnet->intStatus |= ENET_INT_TXDONE;
+	}
+	if (idx == REG(pPage, ENET_TXPRODUCE)) {
+		pEnet->intStatus |= ENET_INT_TXFINISHED;
+	}
+
+	if (pEnet->logCount < SIM_ENET_QUEUE) {
+		pEnet->log[(pEnet->logHead + pEnet->logCount) % SIM_ENET_QUEUE] = pEnet->txFrame;
+		pEnet->logCount++;
+	}
+	if ((REG(pPage, ENET_MAC1) & ENET_MAC1_LOOPBACK) && (pEnet->lineCount < SIM_ENET_QUEUE)) {
+		if (pEnet->lineCount == 0) {
+			pEnet->lineNextAt = pEnet->txDoneAt;
+		}
+		pEnet->line[(pEnet->lineHead + pEnet->lineCount) % SIM_ENET_QUEUE] = pEnet->txFrame;
+		pEnet->lineCount++;
+	}
+}
+
+/* Store an arrived frame and its CRC in the receive descriptors */
+static void enetRxFrame(SIM_PAGE_T *pPage, SIM_FRAME_T *pFrame)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	uint32_t idx = REG(pPage, ENET_RXPRODUCE), consume = REG(pPage, ENET_RXCONSUME);
+	uint32_t crc = enetCrc(pFrame->data, pFrame->len), total = pFrame->len + 4;
+	uint32_t done = 0, size, n, *pDesc, *pStat = NULL;
+	uint8_t *pDst;
+	bool intr = false;
+
+	if (((REG(pPage, ENET_COMMAND) & ENET_COMMAND_RXENABLE) == 0) ||
+		((REG(pPage, ENET_MAC1) & ENET_MAC1_RXENABLE) == 0)) {
+		return;
+	}
+	while (done < total) {
+		if (enetNext(pPage, idx, ENET_RXNUM) == consume) {
+			/* Out of descriptors, the rest of the frame is lost */
+			if (pStat != NULL) {
+				pStat[0] |= ENET_RINFO_NO_DESCR | ENET_RINFO_ERR;
+			}
+			pEnet->intStatus |= ENET_INT_RXOVERRUN;
+			break;
+		}
+		pDesc = (uint32_t *) (uintptr_t) (REG(pPage, ENET_RXDESC) + 8 * idx);
+		pStat = (uint32_t *) (uintptr_t) (REG(pPage, ENET_RXSTAT) + 8 * idx);
+		size = (pDesc[1] & 0x7FF) + 1;
+		n = (total - done < size) ? total - done : size;
+		pDst = (uint8_t *) (uintptr_t) pDesc[0];
+		for (size = 0; size < n; size++, done++) {
+			pDst[size] = (done < pFrame->len) ? pFrame->data[done] : (uint8_t) (crc >> (8 * (done - pFrame->len)));
+		}
+		pStat[0] = (n - 1) | ((done == total) ? ENET_RINFO_LAST_FLAG : 0);
+		pStat[1] = 0;
+		intr |= (pDesc[1] & ENET_RCTRL_INT) != 0;
+		idx = enetNext(pPage, idx, ENET_RXNUM);
+	}
+	REG(pPage, ENET_RXPRODUCE) = idx;
+	if (intr) {
+		pEnet->intStatus |= ENET_INT_RXDONE;
+	}
+	if (enetNext(pPage, idx, ENET_RXNUM) == consume) {
+		pEnet->intStatus |= ENET_INT_RXFINISHED;
+	}
+}
+
+static uint64_t enetNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	uint64_t next = SIM_NEVER;
+
+	if (pEnet->txBusy) {
+		next = pEnet->txDoneAt;
+	}
+	if ((pEnet->lineCount > 0) && (pEnet->lineNextAt < next)) {
+		next = pEnet->lineNextAt;
+	}
+	return next;
+}
+
+static void enetSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	SIM_FRAME_T *pFrame;
+	uint64_t t;
+
+	for (;; ) {
+		if (pEnet->txBusy && (pEnet->txDoneAt <= until) &&
+			((pEnet->lineCount == 0) || (pEnet->txDoneAt <= pEnet->lineNextAt))) {
+			t = pEnet->txDoneAt;
+			enetTxDone(pPage);
+			enetTxStart(pPage, t);
+		}
+		else if ((pEnet->lineCount > 0) && (pEnet->lineNextAt <= until)) {
+			pFrame = &pEnet->line[pEnet->lineHead];
+			pEnet->lineHead = (pEnet->lineHead + 1) % SIM_ENET_QUEUE;
+			pEnet->lineCount--;
+			enetRxFrame(pPage, pFrame);
+			if (pEnet->lineCount > 0) {
+				pEnet->lineNextAt += enetFrameCycles(pPage, pEnet->line[pEnet->lineHead].len);
+			}
+		}
+		else {
+			break;
+		}
+	}
+}
+
+static uint32_t enetRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+	uint32_t value;
+
+	(void) effects;
+	switch (off) {
+	case ENET_STATUS:
+		value = (REG(pPage, ENET_COMMAND) & ENET_COMMAND_RXENABLE) ? ENET_STATUS_RXSTATUS : 0;
+		return value | (pEnet->txBusy ? ENET_STATUS_TXSTATUS : 0);
+
+	case ENET_INTSTATUS:
+		return pEnet->intStatus;
+
+	case ENET_MIND:
+		return (simCycles < pEnet->miiDoneAt) ? ENET_MIND_BUSY : 0;
+
+	case ENET_MRDD:
+		return pEnet->mrdd;
+
+	case ENET_INTCLEAR:
+	case ENET_INTSET:
+		return 0;
+
+	default:
+		return REG(pPage, off);
+	}
+}
+
+static void enetWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+
+	switch (off) {
+	case ENET_INTCLEAR:
+		pEnet->intStatus &= ~value;
+		break;
+
+	case ENET_INTSET:
+		pEnet->intStatus |= value;
+		break;
+
+	case ENET_COMMAND:
+		if (value & (ENET_COMMAND_REGRESET | ENET_COMMAND_TXRESET)) {
+			pEnet->txBusy = false;
+		}
+		enetTxStart(pPage, simCycles);
+		break;
+
+	case ENET_TXPRODUCE:
+		enetTxStart(pPage, simCycles);
+		break;
+
+	case ENET_MCMD:
+		if (value & ENET_MCMD_READ) {
+			pEnet->mrdd = pEnet->phyReg[REG(pPage, ENET_MADR) & 0x1F];
+			pEnet->miiDoneAt = simCycles + enetMiiCycles(pPage);
+		}
+		break;
+
+	case ENET_MWTD:
+		/* The reset bit of the control register clears itself */
+		pEnet->phyReg[REG(pPage, ENET_MADR) & 0x1F] = (uint16_t) value & (((REG(pPage, ENET_MADR) & 0x1F) == 0) ? 0x7FFF : 0xFFFF);
+		pEnet->miiDoneAt = simCycles + enetMiiCycles(pPage);
+		break;
+
+	default:
+		break;
+	}
+}
+
+static bool enetLevel(SIM_PAGE_T *pPage)
+{
+	return (((SIM_ENET_T *) pPage->pState)->intStatus & REG(pPage, ENET_INTENABLE)) != 0;
+}
+
+static void enetReset(SIM_PAGE_T *pPage)
+{
+	SIM_ENET_T *pEnet = pPage->pState;
+
+	memset(pEnet, 0, sizeof(SIM_ENET_T));
+
+	/* An SMSC LAN8720 with auto-negotiation on and no cable */
+	pEnet->phyReg[0] = 0x3000;
+	pEnet->phyReg[1] = 0x7809;
+	pEnet->phyReg[2] = 0x0007;
+	pEnet->phyReg[3] = 0xC0F1;
+	pEnet->phyReg[31] = 0x0018;
+}
+
+/* CAN controller and bus model */
+
+static const uint32_t canTxInt[3] = {CAN_ICR_TI1, CAN_ICR_TI2, CAN_ICR_TI3};
+
+static SIM_PAGE_T *canPage(int num)
+{
+	return findPage(num ? LPC_CAN2_BASE : LPC_CAN1_BASE);
+}
+
+static bool canOperating(SIM_PAGE_T *pPage)
+{
+	return (REG(pPage, CAN_MOD) & CAN_MOD_RM) == 0;
+}
+
+/* One bit is BRP + 1 times (3 + TSEG1 + TSEG2) peripheral clocks */
+static uint64_t canBitCycles(SIM_PAGE_T *pPage)
+{
+	uint32_t btr = REG(pPage, CAN_BTR);
+
+	return (uint64_t) ((btr & 0x3FF) + 1) * (((btr >> 16) & 0xF) + ((btr >> 20) & 0x7) + 3);
+}
+
+/* Frame length from SOF to the end of the intermission, without stuff bits */
+static uint32_t canFrameBits(const SIM_CAN_FRAME_T *pFrame)
+{
+	uint32_t dlc = (pFrame->info >> 16) & 0xF;
+
+	if (pFrame->info & CAN_TFI_RTR) {
+		dlc = 0;
+	}
+	return ((pFrame->info & CAN_TFI_FF) ? 67 : 47) + 8 * ((dlc > 8) ? 8 : dlc);
+}
+
+/* Bus arbitration order, lower wins: base ID, then RTR or SRR, IDE, the
+   extended ID bits and the extended RTR */
+static uint32_t canArbKey(const SIM_CAN_FRAME_T *pFrame)
+{
+	uint32_t rtr = (pFrame->info & CAN_TFI_RTR) ? 1 : 0;
+
+	if (pFrame->info & CAN_TFI_FF) {
+		return ((pFrame->id >> 18) & 0x7FF) << 21 | (3 << 19) | ((pFrame->id & 0x3FFFF) << 1) | rtr;
+	}
+	return (pFrame->id & 0x7FF) << 21 | (rtr << 20);
+}
+
+/* Transmit buffer the controller offers to the bus, or -1 */
+static int canTxCandidate(SIM_PAGE_T *pPage)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+	SIM_CAN_FRAME_T frame;
+	uint32_t key, bestKey = 0;
+	int n, best = -1;
+
+	if (!canOperating(pPage)) {
+		return -1;
+	}
+	for (n = 0; n < 3; n++) {
+		if ((pCan->txPending & (1 << n)) == 0) {
+			continue;
+		}
+		if (REG(pPage, CAN_MOD) & CAN_MOD_TPM) {
+			key = REG(pPage, CAN_TFI(n)) & 0xFF;
+		}
+		else {
+			frame.info = REG(pPage, CAN_TFI(n));
+			frame.id = REG(pPage, CAN_TFI(n) + 4);
+			key = canArbKey(&frame);
+		}
+		if ((best < 0) || (key < bestKey)) {
+			best = n;
+			bestKey = key;
+		}
+	}
+	return best;
+}
+
+/* Acceptance filter: ID index of the matching entry, -1 to reject, or
+   CAN_RFS_BP in bypass mode.  The entries are numbered two per row in the
+   individual standard sections and one per row after them.  FullCAN
+   message objects are not modelled, that section filters as the
+   individual standard section does. */
+static int canAccept(int num, const SIM_CAN_FRAME_T *pFrame)
+{
+	SIM_PAGE_T *pAf = findPage(LPC_CANAF_BASE), *pRam = findPage(LPC_CANAF_RAM_BASE);
+	uint32_t afmr = REG(pAf, CANAF_AFMR), end[5], row, entry, lo, hi;
+	int s, half, index = 0;
+
+	if (afmr & CANAF_AFMR_ACCOFF) {
+		return -1;
+	}
+	if (afmr & CANAF_AFMR_ACCBP) {
+		return CAN_RFS_BP;
+	}
+	for (s = 0; s < 5; s++) {
+		end[s] = CANAF_ENDADDR_VAL(REG(pAf, SIM_CANAF_ENDADDR(s)));
+	}
+
+	row = 0;
+	if ((pFrame->info & CAN_TFI_FF) == 0) {
+		for (; row < end[1]; row++) {
+			for (half = 0; half < 2; half++, index++) {
+				entry = (REG(pRam, 4 * row) >> (half ? 0 : 16)) & 0xFFFF;
+				if ((((entry >> 13) & 7) == (uint32_t) num) && ((entry & (1 << 12)) == 0) &&
+					((entry & 0x7FF) == (pFrame->id & 0x7FF))) {
+					return index;
+				}
+			}
+		}
+		for (; row < end[2]; row++, index++) {
+			entry = REG(pRam, 4 * row);
+			lo = (entry >> 16) & 0xFFFF;
+			hi = entry & 0xFFFF;
+			if ((((lo >> 13) & 7) == (uint32_t) num) && ((lo & (1 << 12)) == 0) &&
+				((pFrame->id & 0x7FF) >= (lo & 0x7FF)) && ((pFrame->id & 0x7FF) <= (hi & 0x7FF))) {
+				return index;
+			}
+		}
+		return -1;
+	}
+
+	index = 2 * end[1] + (end[2] - end[1]);
+	for (row = end[2]; row < end[3]; row++, index++) {
+		entry = REG(pRam, 4 * row);
+		if (((entry >> 29) == (uint32_t) num) && ((entry & 0x1FFFFFFF) == pFrame->id)) {
+			return index;
+		}
+	}
+	for (; row + 1 < end[4]; row += 2, index += 2) {
+		lo = REG(pRam, 4 * row);
+		hi = REG(pRam, 4 * row + 4);
+		if (((lo >> 29) == (uint32_t) num) && (pFrame->id >= (lo & 0x1FFFFFFF)) &&
+			(pFrame->id <= (hi & 0x1FFFFFFF))) {
+			return index;
+		}
+	}
+	return -1;
+}
+
+/* Show the first frame of the receive buffer in RFS..RDB */
+static void canShowRx(SIM_PAGE_T *pPage)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+
+	if (pCan->rxCount > 0) {
+		REG(pPage, CAN_RFS) = pCan->rx[0].info;
+		REG(pPage, CAN_RFS + 4) = pCan->rx[0].id;
+		REG(pPage, CAN_RFS + 8) = pCan->rx[0].data[0];
+		REG(pPage, CAN_RFS + 12) = pCan->rx[0].data[1];
+	}
+}
+
+static void canRxFrame(SIM_PAGE_T *pPage, const SIM_CAN_FRAME_T *pFrame)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+	int index = canAccept(pCan->num, pFrame);
+
+	if (index < 0) {
+		return;
+	}
+	if (pCan->rxCount == 2) {
+		pCan->overrun = true;
+		if (REG(pPage, CAN_IER) & CAN_IER_DOIE) {
+			pCan->icr |= CAN_ICR_DOI;
+		}
+		return;
+	}
+	pCan->rx[pCan->rxCount] = *pFrame;
+	pCan->rx[pCan->rxCount].info = (pFrame->info & (CAN_RFS_FF | CAN_RFS_RTR | (0xF << 16))) | (uint32_t) index;
+	pCan->rxCount++;
+	canShowRx(pPage);
+}
+
+/* Put the winner of the arbitration on an idle bus */
+static void canBusStart(uint64_t startAt)
+{
+	SIM_PAGE_T *pPage, *pBitPage = NULL;
+	SIM_CAN_T *pCan;
+	uint32_t key, bestKey = 0;
+	int num, n, sender = -1, buf = -1;
+	bool found = false;
+
+	if (simCanBus.busy) {
+		return;
+	}
+	if (simCanBus.lineCount > 0) {
+		simCanBus.frame = simCanBus.line[simCanBus.lineHead];
+		bestKey = canArbKey(&simCanBus.frame);
+		found = true;
+	}
+	for (num = 0; num < 2; num++) {
+		SIM_CAN_FRAME_T frame;
+
+		pPage = canPage(num);
+		if (canOperating(pPage) && (pBitPage == NULL)) {
+			pBitPage = pPage;
+		}
+		n = canTxCandidate(pPage);
+		if (n < 0) {
+			continue;
+		}
+		frame.info = REG(pPage, CAN_TFI(n)) & (CAN_TFI_FF | CAN_TFI_RTR | (0xF << 16));
+		frame.id = REG(pPage, CAN_TFI(n) + 4) & ((frame.info & CAN_TFI_FF) ? 0x1FFFFFFF : 0x7FF);
+		frame.data[0] = REG(pPage, CAN_TFI(n) + 8);
+		frame.data[1] = REG(pPage, CAN_TFI(n) + 12);
+		key = canArbKey(&frame);
+		if (!found || (key < bestKey)) {
+			simCanBus.frame = frame;
+			bestKey = key;
+			sender = num;
+			buf = n;
+			found = true;
+		}
+	}
+	if (!found) {
+		return;
+	}
+
+	if (sender >= 0) {
+		pBitPage = canPage(sender);
+		pCan = pBitPage->pState;
+		pCan->txPending &= ~(1 << buf);
+		pCan->txActive = buf;
+	}
+	else {
+		simCanBus.lineHead = (simCanBus.lineHead + 1) % SIM_CAN_QUEUE;
+		simCanBus.lineCount--;
+		if (pBitPage == NULL) {
+			pBitPage = canPage(0);
+		}
+	}
+	simCanBus.busy = true;
+	simCanBus.sender = sender;
+	simCanBus.doneAt = startAt + canFrameBits(&simCanBus.frame) * canBitCycles(pBitPage);
+}
+
+/* The frame on the bus is through, acknowledge and deliver it */
+static void canBusDone(void)
+{
+	SIM_PAGE_T *pPage;
+	SIM_CAN_T *pCan;
+	int num, n;
+	bool self = false;
+
+	simCanBus.busy = false;
+	if (simCanBus.sender >= 0) {
+		pPage = canPage(simCanBus.sender);
+		pCan = pPage->pState;
+		n = pCan->txActive;
+		pCan->txActive = -1;
+		pCan->txDone |= 1 << n;
+		self = (pCan->txSelf & (1 << n)) != 0;
+		if (REG(pPage, CAN_IER) & canTxInt[n]) {
+			pCan->icr |= canTxInt[n];
+		}
+		if (simCanBus.logCount < SIM_CAN_QUEUE) {
+			simCanBus.log[(simCanBus.logHead + simCanBus.logCount) % SIM_CAN_QUEUE] = simCanBus.frame;
+			simCanBus.logCount++;
+		}
+	}
+	for (num = 0; num < 2; num++) {
+		pPage = canPage(num);
+		if (canOperating(pPage) && ((num != simCanBus.sender) || self)) {
+			canRxFrame(pPage, &simCanBus.frame);
+		}
+	}
+}
+
+static uint64_t canNextEvent(SIM_PAGE_T *pPage)
+{
+	(void) pPage;
+	return simCanBus.busy ? simCanBus.doneAt : SIM_NEVER;
+}
+
+/* The bus is shared, the sync of either controller page runs it */
+static void canSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	uint64_t t;
+
+	(void) pPage;
+	while (simCanBus.busy && (simCanBus.doneAt <= until)) {
+		t = simCanBus.doneAt;
+		canBusDone();
+		canBusStart(t);
+	}
+}
+
+/* GSR status bits 0..7 */
+static uint32_t canStatus(SIM_PAGE_T *pPage)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+	uint32_t value = 0;
+
+	if (pCan->rxCount > 0) {
+		value |= CAN_GSR_RBS;
+	}
+	if (pCan->overrun) {
+		value |= CAN_GSR_DOS;
+	}
+	if ((pCan->txPending == 0) && (pCan->txActive < 0)) {
+		value |= CAN_GSR_TBS;
+	}
+	if (pCan->txDone == 7) {
+		value |= CAN_GSR_TCS;
+	}
+	if (simCanBus.busy && canOperating(pPage)) {
+		value |= (simCanBus.sender == pCan->num) ? CAN_GSR_TS : CAN_GSR_RS;
+	}
+	return value;
+}
+
+static uint32_t canRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+	uint32_t value, common;
+	int n;
+
+	switch (off) {
+	case CAN_GSR:
+		return (REG(pPage, off) & ~0xFF) | canStatus(pPage);
+
+	case CAN_ICR:
+		value = pCan->icr;
+		if ((pCan->rxCount > 0) && (REG(pPage, CAN_IER) & CAN_IER_RIE)) {
+			value |= CAN_ICR_RI;
+		}
+		if (effects) {
+			pCan->icr = 0;
+		}
+		return value;
+
+	case CAN_SR:
+		/* Receive and bus bits in all three bytes, each byte with the
+		   status of its transmit buffer */
+		common = canStatus(pPage) & (CAN_GSR_RBS | CAN_GSR_DOS | CAN_GSR_RS | CAN_GSR_TS);
+		value = 0;
+		for (n = 0; n < 3; n++) {
+			value |= common << (8 * n);
+			if (((pCan->txPending & (1 << n)) == 0) && (pCan->txActive != n)) {
+				value |= CAN_SR_TBS(n);
+			}
+			if (pCan->txDone & (1 << n)) {
+				value |= CAN_SR_TCS(n);
+			}
+		}
+		return value;
+
+	case CAN_CMR:
+		return 0;
+
+	default:
+		return REG(pPage, off);
+	}
+}
+
+static void canWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+	uint8_t sel;
+	int n;
+
+	switch (off) {
+	case CAN_MOD:
+		if (value & CAN_MOD_RM) {
+			/* Reset mode drops the transmission requests */
+			pCan->txPending = 0;
+		}
+		else {
+			canBusStart(simCycles);
+		}
+		break;
+
+	case CAN_CMR:
+		sel = (uint8_t) ((value >> 5) & 7);
+		if (value & CAN_CMR_RRB) {
+			if (pCan->rxCount > 0) {
+				pCan->rx[0] = pCan->rx[1];
+				pCan->rxCount--;
+				canShowRx(pPage);
+			}
+		}
+		if (value & CAN_CMR_CDO) {
+			pCan->overrun = false;
+		}
+		if (value & CAN_CMR_AT) {
+			/* A frame already on the bus is not aborted */
+			for (n = 0; n < 3; n++) {
+				if (sel & pCan->txPending & (1 << n)) {
+					pCan->txPending &= ~(1 << n);
+					pCan->txDone &= ~(1 << n);
+					if (REG(pPage, CAN_IER) & canTxInt[n]) {
+						pCan->icr |= canTxInt[n];
+					}
+				}
+			}
+		}
+		if (value & (CAN_CMR_TR | CAN_CMR_SRR)) {
+			for (n = 0; n < 3; n++) {
+				if ((sel & (1 << n)) && ((pCan->txPending & (1 << n)) == 0) && (pCan->txActive != n)) {
+					pCan->txPending |= 1 << n;
+					pCan->txDone &= ~(1 << n);
+					if (value & CAN_CMR_SRR) {
+						pCan->txSelf |= 1 << n;
+					}
+					else {
+						pCan->txSelf &= ~(1 << n);
+					}
+				}
+			}
+			canBusStart(simCycles);
+		}
+		REG(pPage, CAN_CMR) = 0;
+		break;
+
+	default:
+		break;
+	}
+}
+
+static bool canLevel(SIM_PAGE_T *pPage)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+
+	return (pCan->icr != 0) || ((pCan->rxCount > 0) && (REG(pPage, CAN_IER) & CAN_IER_RIE));
+}
+
+static void canReset(SIM_PAGE_T *pPage)
+{
+	SIM_CAN_T *pCan = pPage->pState;
+
+	memset(pCan, 0, sizeof(SIM_CAN_T));
+	pCan->num = (pCan == &simCan[1]) ? 1 : 0;
+	pCan->txActive = -1;
+	pCan->txDone = 7;
+	REG(pPage, CAN_MOD) = CAN_MOD_RM;
+	memset(&simCanBus, 0, sizeof(simCanBus));
+}
+
+/* Central CAN status registers, gathered from both controllers */
+static uint32_t canCrRead(SIM_PAGE_T *pPage, uint32_t off)
+{
+	uint32_t value = 0, status;
+	int num;
+
+	for (num = 0; num < 2; num++) {
+		status = canStatus(canPage(num));
+		if (off == CANCR_TXSR) {
+			value |= ((status & CAN_GSR_TS) ? CAN_TSR_TS(num) : 0) |
+					 ((status & CAN_GSR_TBS) ? CAN_TSR_TBS(num) : 0) |
+					 ((status & CAN_GSR_TCS) ? CAN_TSR_TCS(num) : 0);
+		}
+		else if (off == CANCR_RXSR) {
+			value |= ((status & CAN_GSR_RS) ? CAN_RSR_RS(num) : 0) |
+					 ((status & CAN_GSR_RBS) ? CAN_RSR_RBS(num) : 0) |
+					 ((status & CAN_GSR_DOS) ? CAN_RSR_DOS(num) : 0);
+		}
+		else {
+			return REG(pPage, off);
+		}
+	}
+	return value;
+}
+
+/* Frame registers from a message, as Chip_CAN_Send() fills them */
+static void canFromMsg(SIM_CAN_FRAME_T *pFrame, const CAN_MSG_T *pMsg)
+{
+	int i;
+
+	pFrame->info = (pMsg->Type & CAN_REMOTE_MSG) ? CAN_TFI_RTR : CAN_TFI_DLC(pMsg->DLC);
+	if (pMsg->ID & CAN_EXTEND_ID_USAGE) {
+		pFrame->info |= CAN_TFI_FF;
+		pFrame->id = pMsg->ID & 0x1FFFFFFF;
+	}
+	else {
+		pFrame->id = pMsg->ID & 0x7FF;
+	}
+	pFrame->data[0] = pFrame->data[1] = 0;
+	for (i = 0; i < 8; i++) {
+		pFrame->data[i / 4] |= (uint32_t) pMsg->Data[i] << (8 * (i % 4));
+	}
+}
+
+#if defined(CHIP_LPC177X_8X)
+/* SD card interface and SD card model.  The card is an SDHC card.  The FIFO
+   is modelled one block deep: a block from the card lands in it whole once
+   its CRC has been received, and a block to the card goes out once the FIFO
+   holds all of it.  The FIFO register moves words far faster than the SD
+   bus, so the bus timing is kept. */
+
+/* Peripheral clocks per SD clock */
+static uint64_t sdcClkCycles(SIM_PAGE_T *pPage)
+{
+	uint32_t clock = REG(pPage, SDC_CLOCK);
+
+	if (clock & (1 << SDC_CLOCK_DIVIDER_BYPASS)) {
+		return 1;
+	}
+	return 2 * ((uint64_t) (clock & SDC_CLOCK_CLKDIV_BITMASK) + 1);
+}
+
+/* A data block with its start bit, CRC16 and end bit */
+static uint64_t sdcBlockCycles(SIM_PAGE_T *pPage, uint32_t bytes)
+{
+	uint32_t clocksPerByte = (REG(pPage, SDC_CLOCK) & (1 << SDC_CLOCK_WIDEBUS_MODE)) ? 2 : 8;
+
+	return ((uint64_t) bytes * clocksPerByte + 18) * sdcClkCycles(pPage);
+}
+
+/* A card is in the slot, powered and clocked */
+static bool sdcCardOn(SIM_PAGE_T *pPage)
+{
+	return (((SIM_SDC_T *) pPage->pState)->pData != NULL) &&
+		   ((REG(pPage, SDC_POWER) & SDC_PWR_CTRL_BITMASK) == SDC_POWER_ON) &&
+		   (REG(pPage, SDC_CLOCK) & (1 << SDC_CLOCK_ENABLE));
+}
+
+/* The card and the interface agree on the bus width */
+static bool sdcWidthOk(SIM_PAGE_T *pPage)
+{
+	return ((SIM_SDC_T *) pPage->pState)->wide == ((REG(pPage, SDC_CLOCK) & (1 << SDC_CLOCK_WIDEBUS_MODE)) != 0);
+}
+
+/* Power up state of the card, also reached by CMD0 */
+static void sdcCardReset(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	pSdc->state = SDMMC_IDLE_ST;
+	pSdc->rca = 0;
+	pSdc->appCmd = false;
+	pSdc->highCap = false;
+	pSdc->wide = false;
+	pSdc->opCondTries = 0;
+	pSdc->errors = 0;
+	pSdc->multi = false;
+	pSdc->busy = false;
+	pSdc->wireBusy = false;
+}
+
+/* The card stops sending or taking the block on the data lines */
+static void sdcWireAbort(SIM_PAGE_T *pPage, uint64_t t)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	if (pSdc->wireBusy && pSdc->wireRx && pSdc->dpsm && pSdc->rx && (pSdc->timeoutAt == SIM_NEVER)) {
+		/* The timer was stopped for this block, restart it */
+		pSdc->timeoutAt = t + REG(pPage, SDC_DATATIMER) * sdcClkCycles(pPage);
+	}
+	pSdc->wireBusy = false;
+}
+
+/* Set len bits from bit start of a 128 bit register, w[0] holding bits 31:0 */
+static void sdcSetBits(uint32_t *w, int start, int len, uint32_t value)
+{
+	int i;
+
+	for (i = 0; i < len; i++) {
+		if (value & ((uint32_t) 1 << i)) {
+			w[(start + i) / 32] |= (uint32_t) 1 << ((start + i) % 32);
+		}
+	}
+}
+
+/* CID or CSD as the R2 response gives it, bits 127:96 in RESPONSE0 and
+   bits 31:1 in RESPONSE3 */
+static void sdcRegisterResp(SIM_SDC_T *pSdc, bool csd)
+{
+	uint32_t w[4] = {0, 0, 0, 0};
+	int i;
+
+	if (csd) {
+		/* CSD version 2.0 */
+		sdcSetBits(w, 126, 2, 1);
+		sdcSetBits(w, 112, 8, 0x0E);		/* TAAC, 1 ms */
+		sdcSetBits(w, 96, 8, 0x32);			/* TRAN_SPEED, 25 MHz */
+		sdcSetBits(w, 84, 12, 0x5B5);		/* CCC */
+		sdcSetBits(w, 80, 4, 9);			/* READ_BL_LEN, 512 */
+		sdcSetBits(w, 48, 22, pSdc->blocks / 1024 - 1);	/* C_SIZE, 512 KB units */
+		sdcSetBits(w, 46, 1, 1);			/* ERASE_BLK_EN */
+		sdcSetBits(w, 39, 7, 0x7F);			/* SECTOR_SIZE */
+		sdcSetBits(w, 26, 3, 2);			/* R2W_FACTOR */
+		sdcSetBits(w, 22, 4, 9);			/* WRITE_BL_LEN, 512 */
+	}
+	else {
+		sdcSetBits(w, 120, 8, 0x03);		/* MID */
+		sdcSetBits(w, 104, 16, 0x5344);		/* OID, "SD" */
+		sdcSetBits(w, 96, 8, 'S');			/* PNM, "SIMSD" */
+		sdcSetBits(w, 64, 32, 0x494D5344);
+		sdcSetBits(w, 56, 8, 0x10);			/* PRV, 1.0 */
+		sdcSetBits(w, 24, 32, 0x00C0FFEE);	/* PSN */
+		sdcSetBits(w, 8, 12, 0x1A5);		/* MDT, May 2026 */
+	}
+	for (i = 0; i < 4; i++) {
+		pSdc->resp[i] = w[3 - i];
+	}
+	pSdc->respCmd = 0x3F;
+}
+
+/* R1 card status of a command taken in state */
+static uint32_t sdcR1(SIM_SDC_T *pSdc, SDMMC_STATE_T state, bool app)
+{
+	uint32_t r1 = pSdc->errors | ((uint32_t) state << 9);
+
+	if (!pSdc->busy) {
+		r1 |= R1_READY_FOR_DATA;
+	}
+	if (app) {
+		r1 |= R1_APP_CMD;
+	}
+	pSdc->errors = 0;
+	return r1;
+}
+
+/* Put the next block of a read on the data lines */
+static void sdcRxNext(SIM_PAGE_T *pPage, uint64_t startAt)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	if (pSdc->nextBlock >= pSdc->blocks) {
+		/* The end of the card, the card sends no more */
+		return;
+	}
+	pSdc->wireBusy = true;
+	pSdc->wireRx = true;
+	pSdc->wireBlock = pSdc->nextBlock++;
+	pSdc->wireStartAt = startAt;
+	pSdc->wireDoneAt = startAt + sdcBlockCycles(pPage, MMC_SECTOR_SIZE);
+}
+
+/* Send the block in the FIFO once it is complete and the card takes it */
+static void sdcTxStart(SIM_PAGE_T *pPage, uint64_t startAt)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	if (pSdc->wireBusy || pSdc->busy || (pSdc->state != SDMMC_RCV_ST) || !pSdc->dpsm || pSdc->rx ||
+		(pSdc->fifoCount * 4 < pSdc->blockBytes)) {
+		return;
+	}
+	memcpy(pSdc->wire, pSdc->fifo, pSdc->blockBytes);
+	pSdc->fifoCount = 0;
+	pSdc->wireBusy = true;
+	pSdc->wireRx = false;
+	pSdc->wireBlock = pSdc->nextBlock++;
+	pSdc->wireStartAt = startAt;
+
+	/* Ncrc and the CRC status token follow the block */
+	pSdc->wireDoneAt = startAt + sdcBlockCycles(pPage, pSdc->blockBytes) + 7 * sdcClkCycles(pPage);
+}
+
+/* The card takes the command at time t, false when it does not answer */
+static bool sdcCardCommand(SIM_PAGE_T *pPage, uint64_t t)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	SDMMC_STATE_T state = pSdc->state;
+	uint32_t index = pSdc->cmd, arg = pSdc->arg, block, r1;
+	bool app = pSdc->appCmd;
+
+	pSdc->appCmd = false;
+	pSdc->respCmd = index;
+	memset(pSdc->resp, 0, sizeof(pSdc->resp));
+	if (app) {
+		pSdc->stats.appCommands[index]++;
+		switch (index) {
+		case SD_APP_SET_BUS_WIDTH:
+			if (state != SDMMC_TRAN_ST) {
+				break;
+			}
+			pSdc->resp[0] = sdcR1(pSdc, state, true);
+			pSdc->wide = ACMD6_BUS_WIDTH(arg) == ACMD6_BUS_WIDTH_4;
+			return true;
+
+		case SD_APP_OP_COND:
+			if (state != SDMMC_IDLE_ST) {
+				break;
+			}
+			/* R3, the OCR, busy until the card has powered up */
+			pSdc->resp[0] = SDC_OCR_27_36;
+			if ((ACMD41_OCR(arg) != 0) && (++pSdc->opCondTries >= SIM_SDC_INIT_TRIES)) {
+				pSdc->highCap = (arg & ACMD41_HCS) != 0;
+				pSdc->state = SDMMC_READY_ST;
+				pSdc->resp[0] |= CMDRESP_R3_INIT_COMPLETE | (pSdc->highCap ? CMDRESP_R3_HC_CCS : 0);
+			}
+			pSdc->respCmd = 0x3F;
+			return true;
+
+		default:
+			break;
+		}
+		pSdc->errors |= R1_ILLEGAL_COMMAND;
+		return false;
+	}
+
+	pSdc->stats.commands[index]++;
+	switch (index) {
+	case MMC_GO_IDLE_STATE:
+		sdcWireAbort(pPage, t);
+		sdcCardReset(pPage);
+		return true;
+
+	case SD_CMD8:
+		if (state != SDMMC_IDLE_ST) {
+			break;
+		}
+		pSdc->resp[0] = arg & 0xFFF;
+		return true;
+
+	case MMC_ALL_SEND_CID:
+		if (state != SDMMC_READY_ST) {
+			break;
+		}
+		sdcRegisterResp(pSdc, false);
+		pSdc->state = SDMMC_IDENT_ST;
+		return true;
+
+	case SD_SEND_RELATIVE_ADDR:
+		if ((state != SDMMC_IDENT_ST) && (state != SDMMC_STBY_ST)) {
+			break;
+		}
+		r1 = sdcR1(pSdc, state, false);
+		pSdc->rca = SIM_SDC_RCA;
+		pSdc->state = SDMMC_STBY_ST;
+
+		/* R6, status bits 23, 22, 19 and 12:0 below the new address */
+		pSdc->resp[0] = ((uint32_t) pSdc->rca << 16) | ((r1 >> 8) & 0xC000) | ((r1 >> 6) & 0x2000) | (r1 & 0x1FFF);
+		return true;
+
+	case MMC_SEND_CSD:
+		if ((state != SDMMC_STBY_ST) || (CMDRESP_R6_RCA_VAL(arg) != pSdc->rca)) {
+			return false;
+		}
+		sdcRegisterResp(pSdc, true);
+		return true;
+
+	case MMC_SELECT_CARD:
+		if (CMDRESP_R6_RCA_VAL(arg) != pSdc->rca) {
+			/* Another card selected, this one goes back to stand-by */
+			if (state == SDMMC_TRAN_ST) {
+				pSdc->state = SDMMC_STBY_ST;
+			}
+			return false;
+		}
+		if ((state != SDMMC_STBY_ST) && (state != SDMMC_TRAN_ST)) {
+			break;
+		}
+		pSdc->resp[0] = sdcR1(pSdc, state, false);
+		pSdc->state = SDMMC_TRAN_ST;
+		return true;
+
+	case MMC_SEND_STATUS:
+		if ((state < SDMMC_STBY_ST) || (CMDRESP_R6_RCA_VAL(arg) != pSdc->rca)) {
+			return false;
+		}
+		pSdc->resp[0] = sdcR1(pSdc, state, false);
+		return true;
+
+	case MMC_SET_BLOCKLEN:
+		if (state != SDMMC_TRAN_ST) {
+			break;
+		}
+		pSdc->resp[0] = sdcR1(pSdc, state, false);
+		return true;
+
+	case MMC_READ_SINGLE_BLOCK:
+	case MMC_READ_MULTIPLE_BLOCK:
+	case MMC_WRITE_BLOCK:
+	case MMC_WRITE_MULTIPLE_BLOCK:
+		if (state != SDMMC_TRAN_ST) {
+			break;
+		}
+		block = pSdc->highCap ? arg : arg / MMC_SECTOR_SIZE;
+		if (block >= pSdc->blocks) {
+			pSdc->errors |= R1_OUT_OF_RANGE;
+			pSdc->resp[0] = sdcR1(pSdc, state, false);
+			return true;
+		}
+		pSdc->resp[0] = sdcR1(pSdc, state, false);
+		pSdc->nextBlock = block;
+		pSdc->multi = (index == MMC_READ_MULTIPLE_BLOCK) || (index == MMC_WRITE_MULTIPLE_BLOCK);
+		if (index <= MMC_READ_MULTIPLE_BLOCK) {
+			pSdc->state = SDMMC_DATA_ST;
+			sdcRxNext(pPage, t + SIM_SDC_NAC);
+		}
+		else {
+			pSdc->state = SDMMC_RCV_ST;
+			sdcTxStart(pPage, t);
+		}
+		return true;
+
+	case MMC_STOP_TRANSMISSION:
+		if (state == SDMMC_DATA_ST) {
+			pSdc->resp[0] = sdcR1(pSdc, state, false);
+			sdcWireAbort(pPage, t);
+			pSdc->state = SDMMC_TRAN_ST;
+		}
+		else if (state == SDMMC_RCV_ST) {
+			/* A block cut short is not written, the blocks before are
+			   programmed with DAT0 held busy */
+			pSdc->resp[0] = sdcR1(pSdc, state, false);
+			sdcWireAbort(pPage, t);
+			pSdc->busyUntil = (pSdc->busy ? MAX(pSdc->busyUntil, t) : t) + SIM_SDC_PROG;
+			pSdc->busy = true;
+			pSdc->state = SDMMC_PRG_ST;
+		}
+		else {
+			break;
+		}
+		return true;
+
+	case MMC_APP_CMD:
+		if ((state != SDMMC_IDLE_ST) && (CMDRESP_R6_RCA_VAL(arg) != pSdc->rca)) {
+			return false;
+		}
+		pSdc->appCmd = true;
+		pSdc->resp[0] = sdcR1(pSdc, state, true);
+		return true;
+
+	default:
+		break;
+	}
+	pSdc->errors |= R1_ILLEGAL_COMMAND;
+	return false;
+}
+
+/* End of the command or of the response on the CMD line */
+static void sdcCmdStep(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint64_t t = pSdc->cmdAt, clk = sdcClkCycles(pPage);
+	int i;
+
+	if (pSdc->cmdPhase == 1) {
+		pSdc->answered = sdcCardOn(pPage) && sdcCardCommand(pPage, t);
+		if (pSdc->respType == SDC_COMMAND_NO_RSP) {
+			pSdc->status |= SDC_STATUS_CMDSENT;
+			pSdc->cmdPhase = 0;
+		}
+		else if (pSdc->answered) {
+			/* Ncr, then a 48 or 136 bit response */
+			pSdc->cmdPhase = 2;
+			pSdc->cmdAt = t + clk * (2 + ((pSdc->respType == SDC_COMMAND_LONG_RSP) ? 136 : 48));
+		}
+		else {
+			/* No start bit within 64 clocks */
+			pSdc->cmdPhase = 2;
+			pSdc->cmdAt = t + clk * 64;
+		}
+		return;
+	}
+
+	pSdc->cmdPhase = 0;
+	if (!pSdc->answered) {
+		pSdc->status |= SDC_STATUS_CMDTIMEOUT;
+		return;
+	}
+	REG(pPage, SDC_RESPCMD) = pSdc->respCmd;
+	for (i = 0; i < ((pSdc->respType == SDC_COMMAND_LONG_RSP) ? 4 : 1); i++) {
+		REG(pPage, SDC_RESPONSE(i)) = pSdc->resp[i];
+	}
+	pSdc->status |= SDC_STATUS_CMDRESPEND;
+}
+
+/* A block from the card has been received, CRC included */
+static void sdcRxDone(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint64_t t = pSdc->wireDoneAt, clk = sdcClkCycles(pPage);
+
+	pSdc->wireBusy = false;
+	if (!pSdc->dpsm || !pSdc->rx || (pSdc->dataCnt == 0) || (pSdc->armedAt > pSdc->wireStartAt)) {
+		/* The data path missed the start bit */
+		pSdc->stats.blocksDiscarded++;
+	}
+	else if (pSdc->fifoCount > 0) {
+		/* The block before is still in the FIFO */
+		pSdc->stats.overruns++;
+		pSdc->status |= SDC_STATUS_RXOVERRUN;
+		pSdc->dpsm = false;
+	}
+	else if ((pSdc->blockBytes != MMC_SECTOR_SIZE) || !sdcWidthOk(pPage)) {
+		pSdc->stats.crcErrors++;
+		pSdc->status |= SDC_STATUS_DATACRCFAIL;
+		pSdc->dpsm = false;
+	}
+	else {
+		memcpy(pSdc->fifo, &pSdc->pData[pSdc->wireBlock * MMC_SECTOR_SIZE], MMC_SECTOR_SIZE);
+		pSdc->fifoHead = 0;
+		pSdc->fifoCount = MMC_SECTOR_SIZE / 4;
+		pSdc->dataCnt -= MIN(pSdc->dataCnt, MMC_SECTOR_SIZE);
+		pSdc->stats.blocksRead++;
+		pSdc->status |= SDC_STATUS_DATABLOCKEND;
+		pSdc->timeoutAt = (pSdc->dataCnt > 0) ? t + REG(pPage, SDC_DATATIMER) * clk : SIM_NEVER;
+	}
+	if (!pSdc->dpsm) {
+		pSdc->timeoutAt = SIM_NEVER;
+	}
+
+	if (pSdc->multi) {
+		sdcRxNext(pPage, t + 2 * clk);
+	}
+	else {
+		pSdc->state = SDMMC_TRAN_ST;
+	}
+}
+
+/* A block to the card and its CRC status token have crossed the bus */
+static void sdcTxDone(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint64_t t = pSdc->wireDoneAt;
+
+	pSdc->wireBusy = false;
+	pSdc->dataCnt -= MIN(pSdc->dataCnt, pSdc->blockBytes);
+	if ((pSdc->blockBytes != MMC_SECTOR_SIZE) || !sdcWidthOk(pPage) || (pSdc->wireBlock >= pSdc->blocks)) {
+		/* Negative CRC status token */
+		if (pSdc->wireBlock >= pSdc->blocks) {
+			pSdc->errors |= R1_OUT_OF_RANGE;
+		}
+		else {
+			pSdc->stats.crcErrors++;
+		}
+		pSdc->status |= SDC_STATUS_DATACRCFAIL;
+		pSdc->dpsm = false;
+	}
+	else {
+		memcpy(&pSdc->pData[pSdc->wireBlock * MMC_SECTOR_SIZE], pSdc->wire, MMC_SECTOR_SIZE);
+		pSdc->stats.blocksWritten++;
+		pSdc->status |= SDC_STATUS_DATABLOCKEND;
+		if (pSdc->dataCnt == 0) {
+			pSdc->status |= SDC_STATUS_DATAEND;
+			pSdc->dpsm = false;
+		}
+	}
+
+	/* DAT0 busy while the card programs, a single block write ends in
+	   prg state */
+	pSdc->busy = true;
+	if (pSdc->multi) {
+		pSdc->busyUntil = t + SIM_SDC_BLOCK_BUSY;
+	}
+	else {
+		pSdc->busyUntil = t + SIM_SDC_PROG;
+		pSdc->state = SDMMC_PRG_ST;
+	}
+}
+
+static void sdcBusyDone(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	pSdc->busy = false;
+	if (pSdc->state == SDMMC_PRG_ST) {
+		pSdc->state = SDMMC_TRAN_ST;
+	}
+	sdcTxStart(pPage, pSdc->busyUntil);
+}
+
+/* The data timer ran out while the data path waited for a block */
+static void sdcTimeout(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	if (pSdc->wireBusy && pSdc->wireRx && (pSdc->wireStartAt >= pSdc->armedAt) &&
+		(pSdc->wireStartAt <= pSdc->timeoutAt)) {
+		/* The block started in time, its end restarts the timer */
+		pSdc->timeoutAt = SIM_NEVER;
+		return;
+	}
+	pSdc->timeoutAt = SIM_NEVER;
+	pSdc->status |= SDC_STATUS_DATATIMEOUT;
+	pSdc->dpsm = false;
+}
+
+static uint64_t sdcNextEvent(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint64_t next = pSdc->timeoutAt;
+
+	if ((pSdc->cmdPhase != 0) && (pSdc->cmdAt < next)) {
+		next = pSdc->cmdAt;
+	}
+	if (pSdc->wireBusy && (pSdc->wireDoneAt < next)) {
+		next = pSdc->wireDoneAt;
+	}
+	if (pSdc->busy && (pSdc->busyUntil < next)) {
+		next = pSdc->busyUntil;
+	}
+	return next;
+}
+
+/* Events in time order, the data lines first on a tie */
+static void sdcSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint64_t next;
+
+	for (;; ) {
+		next = sdcNextEvent(pPage);
+		if (next > until) {
+			break;
+		}
+		if (pSdc->wireBusy && (pSdc->wireDoneAt == next)) {
+			if (pSdc->wireRx) {
+				sdcRxDone(pPage);
+			}
+			else {
+				sdcTxDone(pPage);
+			}
+		}
+		else if ((pSdc->cmdPhase != 0) && (pSdc->cmdAt == next)) {
+			sdcCmdStep(pPage);
+		}
+		else if (pSdc->busy && (pSdc->busyUntil == next)) {
+			sdcBusyDone(pPage);
+		}
+		else {
+			sdcTimeout(pPage);
+		}
+	}
+}
+
+static uint32_t sdcStatus(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint32_t value = pSdc->status;
+
+	if (pSdc->cmdPhase != 0) {
+		value |= SDC_STATUS_CMDACTIVE;
+	}
+	if (pSdc->dpsm && pSdc->rx) {
+		value |= SDC_STATUS_RXACTIVE;
+		value |= (pSdc->fifoCount > 0) ? SDC_STATUS_RXDATAAVLBL : SDC_STATUS_RXFIFOEMPTY;
+		value |= (pSdc->fifoCount >= 8) ? SDC_STATUS_RXFIFOHALFFULL : 0;
+		value |= (pSdc->fifoCount * 4 >= pSdc->blockBytes) ? SDC_STATUS_RXFIFOFULL : 0;
+	}
+	else if (pSdc->dpsm) {
+		value |= SDC_STATUS_TXACTIVE;
+		value |= (pSdc->fifoCount > 0) ? SDC_STATUS_TXDATAAVLBL : SDC_STATUS_TXFIFOEMPTY;
+		value |= (pSdc->fifoCount <= 8) ? SDC_STATUS_TXFIFOHALFEMPTY : 0;
+		value |= (pSdc->fifoCount * 4 >= pSdc->blockBytes) ? SDC_STATUS_TXFIFOFULL : 0;
+	}
+	return value;
+}
+
+static uint32_t sdcRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+	uint32_t value;
+
+	switch (off) {
+	case SDC_STATUS:
+		return sdcStatus(pPage);
+
+	case SDC_DATACNT:
+		return pSdc->dataCnt;
+
+	case SDC_FIFOCNT:
+		return pSdc->hostLeft;
+
+	case SDC_CLEAR:
+		return 0;
+
+	default:
+		if ((off < SDC_FIFO) || (off >= SDC_FIFO_END)) {
+			return REG(pPage, off);
+		}
+		if (!pSdc->dpsm || !pSdc->rx || (pSdc->fifoCount == 0)) {
+			return 0;
+		}
+		value = pSdc->fifo[pSdc->fifoHead];
+		if (effects) {
+			pSdc->fifoHead++;
+			pSdc->fifoCount--;
+			if (pSdc->hostLeft > 0) {
+				pSdc->hostLeft--;
+			}
+			if (pSdc->hostLeft == 0) {
+				pSdc->status |= SDC_STATUS_DATAEND;
+				pSdc->dpsm = false;
+				pSdc->timeoutAt = SIM_NEVER;
+			}
+		}
+		return value;
+	}
+}
+
+static void sdcWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	switch (off) {
+	case SDC_POWER:
+		if ((value & SDC_PWR_CTRL_BITMASK) == SDC_POWER_OFF) {
+			sdcCardReset(pPage);
+		}
+		break;
+
+	case SDC_CLEAR:
+		pSdc->status &= ~(value & SDC_CLEAR_ALL);
+		break;
+
+	case SDC_COMMAND:
+		if (value & SDC_COMMAND_ENABLE) {
+			pSdc->cmd = value & SDC_COMMAND_INDEX_BITMASK;
+			pSdc->arg = REG(pPage, SDC_ARGUMENT);
+			pSdc->respType = value & SDC_COMMAND_RSP_BITMASK;
+			pSdc->cmdPhase = 1;
+
+			/* Start bit to end bit of the 48 bit command */
+			pSdc->cmdAt = simCycles + 48 * sdcClkCycles(pPage);
+		}
+		else {
+			pSdc->cmdPhase = 0;
+		}
+		break;
+
+	case SDC_DATACTRL:
+		pSdc->fifoHead = 0;
+		pSdc->fifoCount = 0;
+		pSdc->timeoutAt = SIM_NEVER;
+		pSdc->dpsm = (value & SDC_DATACTRL_ENABLE) != 0;
+		if (!pSdc->dpsm) {
+			break;
+		}
+		pSdc->rx = (value & SDC_DATACTRL_DIR_FROMCARD) != 0;
+		pSdc->blockBytes = MIN((uint32_t) 1 << ((value >> 4) & 0xF), SIM_SDC_MAX_BLOCK);
+		pSdc->dataCnt = SDC_DATALENGTH_LEN(REG(pPage, SDC_DATALENGTH));
+		pSdc->hostLeft = pSdc->dataCnt / 4;
+		pSdc->armedAt = simCycles;
+		if (pSdc->rx) {
+			pSdc->timeoutAt = simCycles + REG(pPage, SDC_DATATIMER) * sdcClkCycles(pPage);
+		}
+		sdcTxStart(pPage, simCycles);
+		break;
+
+	default:
+		if ((off < SDC_FIFO) || (off >= SDC_FIFO_END)) {
+			break;
+		}
+		if (pSdc->dpsm && !pSdc->rx && (pSdc->hostLeft > 0) && (pSdc->fifoCount * 4 < pSdc->blockBytes)) {
+			pSdc->fifo[pSdc->fifoCount++] = value;
+			pSdc->hostLeft--;
+			sdcTxStart(pPage, simCycles);
+		}
+		break;
+	}
+}
+
+static bool sdcLevel(SIM_PAGE_T *pPage)
+{
+	return (sdcStatus(pPage) & REG(pPage, SDC_MASK0)) != 0;
+}
+
+/* The FIFO takes a word, or has one, for the GPDMA */
+static bool sdcDmaReady(SIM_PAGE_T *pPage, uint32_t off, bool toPeriph)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	if ((off < SDC_FIFO) || (off >= SDC_FIFO_END) || !pSdc->dpsm ||
+		((REG(pPage, SDC_DATACTRL) & SDC_DATACTRL_DMA_ENABLE) == 0)) {
+		return false;
+	}
+	if (toPeriph) {
+		return !pSdc->rx && (pSdc->hostLeft > 0) && (pSdc->fifoCount * 4 < pSdc->blockBytes);
+	}
+	return pSdc->rx && (pSdc->fifoCount > 0);
+}
+
+/* The SDC is the flow controller, the last word of the transfer is LBREQ */
+static bool sdcDmaLast(SIM_PAGE_T *pPage)
+{
+	return ((SIM_SDC_T *) pPage->pState)->hostLeft == 0;
+}
+
+static void sdcReset(SIM_PAGE_T *pPage)
+{
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	memset(pSdc, 0, sizeof(SIM_SDC_T));
+	pSdc->state = SDMMC_IDLE_ST;
+	pSdc->timeoutAt = SIM_NEVER;
+}
+
+#endif /* defined(CHIP_LPC177X_8X) */
+
+/* Model dispatch */
+
+static uint32_t modelRead(SIM_PAGE_T *pPage, uint32_t off, bool effects)
+{
+	switch (pPage->kind) {
+	case SIM_UART:
+		return uartRead(pPage, off, effects);
+
+	case SIM_SSP:
+		return sspRead(pPage, off, effects);
+
+	case SIM_TIMER:
+		return timerRead(pPage, off, effects);
+
+	case SIM_GPDMA:
+		return gpdmaRead(pPage, off, effects);
+
+	case SIM_ENET:
+		return enetRead(pPage, off, effects);
+
+	case SIM_NVIC:
+		return nvicRead(pPage, off, effects);
+
+	case SIM_CANAF:
+		/* Plain memory, trapped only to count the accesses */
+		return REG(pPage, off);
+
+	case SIM_CAN:
+		return canRead(pPage, off, effects);
+
+	case SIM_CANCR:
+		return canCrRead(pPage, off);
+
+#if defined(CHIP_LPC175X_6X)
+	case SIM_RIT:
+		return ritRead(pPage, off);
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		return sdcRead(pPage, off, effects);
+#endif
+
+	default:
+		break;
+	}
+	return 0;
+}
+
+static void modelWrite(SIM_PAGE_T *pPage, uint32_t off, uint32_t value)
+{
+	switch (pPage->kind) {
+	case SIM_UART:
+		uartWrite(pPage, off, value);
+		break;
+
+	case SIM_SSP:
+		sspWrite(pPage, off, value);
+		break;
+
+	case SIM_TIMER:
+		timerWrite(pPage, off, value);
+		break;
+
+	case SIM_GPDMA:
+		gpdmaWrite(pPage, off, value);
+		break;
+
+	case SIM_ENET:
+		enetWrite(pPage, off, value);
+		break;
+
+	case SIM_NVIC:
+		nvicWrite(pPage, off, value);
+		break;
+
+	case SIM_CAN:
+		canWrite(pPage, off, value);
+		break;
+
+#if defined(CHIP_LPC175X_6X)
+	case SIM_RIT:
+		ritWrite(pPage, off, value);
+		break;
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		sdcWrite(pPage, off, value);
+		break;
+#endif
+
+	default:
+		break;
+	}
+}
+
+static uint64_t modelNextEvent(SIM_PAGE_T *pPage)
+{
+	switch (pPage->kind) {
+	case SIM_UART:
+		return uartNextEvent(pPage);
+
+	case SIM_SSP:
+		return sspNextEvent(pPage);
+
+	case SIM_TIMER:
+		return timerNextEvent(pPage);
+
+	case SIM_ENET:
+		return enetNextEvent(pPage);
+
+	case SIM_CAN:
+		return canNextEvent(pPage);
+
+	case SIM_NVIC:
+		return sysTickNextEvent(pPage);
+
+#if defined(CHIP_LPC175X_6X)
+	case SIM_RIT:
+		return ritNextEvent(pPage);
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		return sdcNextEvent(pPage);
+#endif
+
+	default:
+		return SIM_NEVER;
+	}
+}
+
+static void modelSync(SIM_PAGE_T *pPage, uint64_t until)
+{
+	switch (pPage->kind) {
+	case SIM_UART:
+		uartSync(pPage, until);
+		break;
+
+	case SIM_SSP:
+		sspSync(pPage, until);
+		break;
+
+	case SIM_TIMER:
+		timerSync(pPage, until);
+		break;
+
+	case SIM_ENET:
+		enetSync(pPage, until);
+		break;
+
+	case SIM_CAN:
+		canSync(pPage, until);
+		break;
+
+	case SIM_NVIC:
+		sysTickSync(pPage, until);
+		break;
+
+#if defined(CHIP_LPC175X_6X)
+	case SIM_RIT:
+		ritSync(pPage, until);
+		break;
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		sdcSync(pPage, until);
+		break;
+#endif
+
+	default:
+		break;
+	}
+}
+
+static bool irqLevel(int irq)
+{
+	unsigned int i;
+
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		SIM_PAGE_T *pPage = &simPages[i];
+
+		if (pPage->irq != irq) {
+			continue;
+		}
+		switch (pPage->kind) {
+		case SIM_UART:
+			return uartLevel(pPage);
+
+		case SIM_SSP:
+			return sspLevel(pPage);
+
+		case SIM_TIMER:
+			return timerLevel(pPage);
+
+		case SIM_GPDMA:
+			return gpdmaLevel(pPage);
+
+		case SIM_ENET:
+			return enetLevel(pPage);
+
+		case SIM_CAN:
+			/* CAN1 and CAN2 share the interrupt */
+			if (canLevel(pPage)) {
+				return true;
+			}
+			break;
+
+#if defined(CHIP_LPC175X_6X)
+		case SIM_RIT:
+			return ritLevel(pPage);
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+		case SIM_SDC:
+			return sdcLevel(pPage);
+#endif
+
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+/* DMA bus access.  Peripheral registers go through their models, and a
+   peripheral address is only ready while the block requests DMA. */
+static bool dmaReady(uint32_t addr, bool toPeriph)
+{
+	SIM_PAGE_T *pPage = findPage(addr);
+
+	if (pPage == NULL) {
+		return true;
+	}
+	switch (pPage->kind) {
+	case SIM_UART:
+		return uartDmaReady(pPage, addr & (SIM_PAGE_SIZE - 1), toPeriph);
+
+	case SIM_SSP:
+		return sspDmaReady(pPage, addr & (SIM_PAGE_SIZE - 1), toPeriph);
+
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		return sdcDmaReady(pPage, addr & (SIM_PAGE_SIZE - 1), toPeriph);
+#endif
+
+	default:
+		return true;
+	}
+}
+
+/* Peripheral flow control: the block at addr has made its last DMA request
+   of the transfer */
+static bool dmaLast(uint32_t addr)
+{
+	SIM_PAGE_T *pPage = findPage(addr);
+
+	if (pPage == NULL) {
+		return false;
+	}
+	switch (pPage->kind) {
+#if defined(CHIP_LPC177X_8X)
+	case SIM_SDC:
+		return sdcDmaLast(pPage);
+#endif
+
+	default:
+		return false;
+	}
+}
+
+static uint32_t dmaLoad(uint32_t addr, uint32_t width)
+{
+	SIM_PAGE_T *pPage = findPage(addr);
+	uint32_t value = 0;
+
+	if (pPage != NULL) {
+		value = modelRead(pPage, addr & (SIM_PAGE_SIZE - 4), true);
+		return value >> (8 * (addr & 3));
+	}
+	memcpy(&value, (void *) (uintptr_t) addr, width);
+	return value;
+}
+
+static void dmaStore(uint32_t addr, uint32_t width, uint32_t value)
+{
+	SIM_PAGE_T *pPage = findPage(addr);
+
+	if (pPage != NULL) {
+		REG(pPage, addr & (SIM_PAGE_SIZE - 4)) = value;
+		modelWrite(pPage, addr & (SIM_PAGE_SIZE - 4), value);
+		return;
+	}
+	memcpy((void *) (uintptr_t) addr, &value, width);
+}
+
+/* Run every enabled channel as far as its peripherals allow */
+static void dmaService(void)
+{
+	SIM_PAGE_T *pPage = findPage(LPC_GPDMA_BASE);
+	uint32_t control, size, sw, dw, value, lli, flow, periphOff, *pItem;
+	bool last;
+	int ch;
+
+	if ((REG(pPage, DMA_CONFIG) & GPDMA_DMACConfig_E) == 0) {
+		return;
+	}
+
+	/* Channel 0 has the highest priority */
+	for (ch = 0; ch < GPDMA_NUMBER_CHANNELS; ch++) {
+		volatile uint32_t *pCh = &REG(pPage, DMA_CH(ch));
+
+		while (pCh[DMA_CH_CONFIG / 4] & GPDMA_DMACCxConfig_E) {
+			control = pCh[DMA_CH_CONTROL / 4];
+			size = control & 0xFFF;
+			sw = 1UL << ((control >> 18) & 3);
+			dw = 1UL << ((control >> 21) & 3);
+
+			/* Under peripheral flow control (flow 4 to 7) the transfer size
+			   is not used, the destination (4, 5) or source (6, 7)
+			   peripheral ends the descriptor */
+			flow = (pCh[DMA_CH_CONFIG / 4] >> 11) & 7;
+			periphOff = (flow >= 6) ? DMA_CH_SRC : DMA_CH_DST;
+			last = false;
+			while (((size > 0) || (flow >= 4)) && !last &&
+				   dmaReady(pCh[DMA_CH_SRC / 4], false) && dmaReady(pCh[DMA_CH_DST / 4], true)) {
+				value = dmaLoad(pCh[DMA_CH_SRC / 4], sw);
+				dmaStore(pCh[DMA_CH_DST / 4], dw, value);
+				if (flow >= 4) {
+					last = dmaLast(pCh[periphOff / 4]);
+				}
+				if (control & GPDMA_DMACCxControl_SI) {
+					pCh[DMA_CH_SRC / 4] += sw;
+				}
+				if (control & GPDMA_DMACCxControl_DI) {
+					pCh[DMA_CH_DST / 4] += dw;
+				}
+				if (flow < 4) {
+					size--;
+					pCh[DMA_CH_CONTROL / 4] = (control & ~0xFFF) | size;
+				}
+			}
+			if ((flow >= 4) ? !last : (size > 0)) {
+				/* Waiting for the peripheral */
+				break;
+			}
+
+			if (control & GPDMA_DMACCxControl_I) {
+				simGpdma.rawTc |= 1UL << ch;
+			}
+			lli = pCh[DMA_CH_LLI / 4];
+			if (lli == 0) {
+				pCh[DMA_CH_CONFIG / 4] &= ~(GPDMA_DMACCxConfig_E | GPDMA_DMACCxConfig_A);
+				break;
+			}
+			pItem = (uint32_t *) (uintptr_t) lli;
+			pCh[DMA_CH_SRC / 4] = pItem[0];
+			pCh[DMA_CH_DST / 4] = pItem[1];
+			pCh[DMA_CH_LLI / 4] = pItem[2];
+			pCh[DMA_CH_CONTROL / 4] = pItem[3];
+		}
+	}
+}
+
+/* An enabled interrupt or SysTick is pending, whatever PRIMASK says */
+static bool irqWaiting(void)
+{
+	int irq;
+
+	if (simNvic.stPending) {
+		return true;
+	}
+	for (irq = 0; irq < SIM_NUM_IRQS; irq++) {
+		if ((simNvic.enabled[irq / 32] & (1UL << (irq & 31))) &&
+			((simNvic.pending[irq / 32] & (1UL << (irq & 31))) || irqLevel(irq))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Bring every model up to the given time */
+static void runTo(uint64_t until)
+{
+	uint64_t next, t;
+	unsigned int i;
+
+	for (;; ) {
+		next = SIM_NEVER;
+		for (i = 0; i < SIM_NUM_PAGES; i++) {
+			t = modelNextEvent(&simPages[i]);
+			if (t < next) {
+				next = t;
+			}
+		}
+		if (next > until) {
+			break;
+		}
+		if (next > simCycles) {
+			simCycles = next;
+		}
+		for (i = 0; i < SIM_NUM_PAGES; i++) {
+			modelSync(&simPages[i], next);
+		}
+		dmaService();
+	}
+	simCycles = until;
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		modelSync(&simPages[i], until);
+	}
+	dmaService();
+}
+
+static void passOn(int sig)
+{
+	/* Not ours, let the default action take the process down */
+	signal(sig, SIG_DFL);
+}
+
+static void segvHandler(int sig, siginfo_t *si, void *pv)
+{
+	ucontext_t *pContext = pv;
+	uintptr_t addr = (uintptr_t) si->si_addr;
+	SIM_PAGE_T *pPage = (addr >> 32) ? NULL : findPage((uint32_t) addr);
+
+	if ((pPage == NULL) || (pStepPage != NULL)) {
+		passOn(sig);
+		return;
+	}
+
+	pPage->accesses++;
+	stepOffset = (uint32_t) addr & (SIM_PAGE_SIZE - 4);
+	stepWrite = (pContext->uc_mcontext.gregs[REG_ERR] & SIM_PF_WRITE) != 0;
+	runTo(simCycles + SIM_ACCESS_CYCLES);
+
+	/* A write still refreshes the word, without side effects, for
+	   read-modify-write instructions */
+	REG(pPage, stepOffset) = modelRead(pPage, stepOffset, !stepWrite);
+
+	pStepPage = pPage;
+	mprotect((void *) (uintptr_t) pPage->base, SIM_PAGE_SIZE, PROT_READ | PROT_WRITE);
+	pContext->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+static void trapHandler(int sig, siginfo_t *si, void *pv)
+{
+	ucontext_t *pContext = pv;
+	SIM_PAGE_T *pPage = pStepPage;
+
+	(void) si;
+	if (pPage == NULL) {
+		passOn(sig);
+		return;
+	}
+
+	pContext->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+	mprotect((void *) (uintptr_t) pPage->base, SIM_PAGE_SIZE, PROT_NONE);
+	pStepPage = NULL;
+	if (stepWrite) {
+		modelWrite(pPage, stepOffset, REG(pPage, stepOffset));
+		dmaService();
+	}
+}
+
+static bool mapRegions(void)
+{
+	uint32_t total = 0, offset = 0;
+	unsigned int i;
+	void *pView;
+	int fd;
+
+	for (i = 0; i < SIM_NUM_REGIONS; i++) {
+		total += simRegions[i].size;
+	}
+	fd = memfd_create("lpc_periph_sim", 0);
+	if ((fd < 0) || (ftruncate(fd, total) != 0)) {
+		perror("periph_sim: memfd");
+		return false;
+	}
+
+	for (i = 0; i < SIM_NUM_REGIONS; i++) {
+		SIM_REGION_T *pRegion = &simRegions[i];
+
+		pView = mmap((void *) (uintptr_t) pRegion->base, pRegion->size, PROT_READ | PROT_WRITE,
+					 MAP_SHARED | MAP_FIXED_NOREPLACE, fd, offset);
+		if (pView != (void *) (uintptr_t) pRegion->base) {
+			fprintf(stderr, "periph_sim: cannot map 0x%08x, the range is in use\n",
+					(unsigned int) pRegion->base);
+			close(fd);
+			return false;
+		}
+		pRegion->alias = mmap(NULL, pRegion->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+		if (pRegion->alias == MAP_FAILED) {
+			perror("periph_sim: mmap");
+			close(fd);
+			return false;
+		}
+		offset += pRegion->size;
+	}
+	close(fd);
+
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		simPages[i].alias = findAlias(simPages[i].base);
+	}
+	return true;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Map the peripheral address space and reset every model */
+bool Sim_Init(void)
+{
+	struct sigaction action;
+	unsigned int i;
+
+	if (!simMapped) {
+		if (!mapRegions()) {
+			return false;
+		}
+		memset(&action, 0, sizeof(action));
+		action.sa_flags = SA_SIGINFO;
+		sigemptyset(&action.sa_mask);
+		action.sa_sigaction = segvHandler;
+		sigaction(SIGSEGV, &action, NULL);
+		action.sa_sigaction = trapHandler;
+		sigaction(SIGTRAP, &action, NULL);
+		simMapped = true;
+	}
+
+	for (i = 0; i < SIM_NUM_REGIONS; i++) {
+		memset(simRegions[i].alias, 0, simRegions[i].size);
+	}
+	simCycles = 0;
+	simPrimask = false;
+	simRamNext = SIM_RAM_BASE;
+
+#if defined(CHIP_LPC177X_8X)
+	/* The main PLL at 96 MHz from a 12 MHz crystal, CPU clock undivided
+	   and peripheral clock divided by 4 */
+	LPC_SYSCTL->SCS = SYSCTL_OSCSTAT;
+	LPC_SYSCTL->CLKSRCSEL = SYSCTL_PLLCLKSRC_MAINOSC;
+	LPC_SYSCTL->PLL[SYSCTL_MAIN_PLL].PLLCFG = 7;
+	*(volatile uint32_t *) &LPC_SYSCTL->PLL[SYSCTL_MAIN_PLL].PLLSTAT = 7 | SYSCTL_PLLSTS_ENABLED |
+																	   SYSCTL_PLLSTS_LOCKED;
+	LPC_SYSCTL->CCLKSEL = 0x101;
+	LPC_SYSCTL->PCLKSEL = 4;
+#else
+	/* Clocks as Chip_SetupXtalClocking() leaves them, PLL0 at 384 MHz from
+	   the crystal and a 96 MHz CPU clock.  The crystal rate is OscRateIn,
+	   which the board code or the test provides. */
+	LPC_SYSCTL->SCS = SYSCTL_OSCSTAT;
+	LPC_SYSCTL->CLKSRCSEL = SYSCTL_PLLCLKSRC_MAINOSC;
+	LPC_SYSCTL->PLL[SYSCTL_MAIN_PLL].PLLCFG = 15;
+	*(volatile uint32_t *) &LPC_SYSCTL->PLL[SYSCTL_MAIN_PLL].PLLSTAT = 15 | SYSCTL_PLL0STS_ENABLED |
+																	   SYSCTL_PLL0STS_CONNECTED | SYSCTL_PLL0STS_LOCKED;
+	LPC_SYSCTL->CCLKSEL = 3;
+#endif
+
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		SIM_PAGE_T *pPage = &simPages[i];
+
+		pPage->accesses = 0;
+		switch (pPage->kind) {
+		case SIM_UART:
+			uartReset(pPage);
+			break;
+
+		case SIM_SSP:
+			sspReset(pPage);
+			break;
+
+		case SIM_TIMER:
+			timerReset(pPage);
+			break;
+
+		case SIM_GPDMA:
+			gpdmaReset(pPage);
+			break;
+
+		case SIM_ENET:
+			enetReset(pPage);
+			break;
+
+		case SIM_NVIC:
+			nvicReset(pPage);
+			break;
+
+		case SIM_CAN:
+			canReset(pPage);
+			break;
+
+#if defined(CHIP_LPC175X_6X)
+		case SIM_RIT:
+			ritReset(pPage);
+			break;
+#endif
+
+#if defined(CHIP_LPC177X_8X)
+		case SIM_SDC:
+			sdcReset(pPage);
+			break;
+#endif
+
+		default:
+			break;
+		}
+		mprotect((void *) (uintptr_t) pPage->base, SIM_PAGE_SIZE, PROT_NONE);
+	}
+	return true;
+}
+
+/* Let simulated time pass, then deliver pending interrupts */
+void Sim_Advance(uint64_t cycles)
+{
+	runTo(simCycles + cycles);
+	Sim_RunIRQs();
+}
+
+/* Deliver pending interrupts */
+int Sim_RunIRQs(void)
+{
+	SIM_PAGE_T *pNvic = findPage(SCS_BASE);
+	int runs, irq, best, count = 0;
+	uint8_t prio, bestPrio;
+
+	if (simPrimask) {
+		return 0;
+	}
+	for (runs = 0; runs < SIM_MAX_IRQ_RUNS; runs++) {
+		best = SIM_NUM_IRQS;
+		bestPrio = 0xFF;
+
+		/* SysTick wins a tie, as the lower exception number */
+		if (simNvic.stPending && (simNvic.stHandler != NULL)) {
+			best = SysTick_IRQn;
+			bestPrio = pNvic->alias[SCB_SHP + 11];
+		}
+		for (irq = 0; irq < SIM_NUM_IRQS; irq++) {
+			uint32_t bit = 1UL << (irq & 31);
+
+			if (((simNvic.enabled[irq / 32] & bit) == 0) || (simNvic.handler[irq] == NULL)) {
+				continue;
+			}
+			if (((simNvic.pending[irq / 32] & bit) == 0) && !irqLevel(irq)) {
+				continue;
+			}
+			prio = pNvic->alias[NVIC_IP + irq];
+			if ((best == SIM_NUM_IRQS) || (prio < bestPrio)) {
+				best = irq;
+				bestPrio = prio;
+			}
+		}
+		if (best == SIM_NUM_IRQS) {
+			return count;
+		}
+		if (best == SysTick_IRQn) {
+			simNvic.stPending = false;
+			simNvic.stHandler();
+		}
+		else {
+			simNvic.pending[best / 32] &= ~(1UL << (best & 31));
+			simNvic.handler[best]();
+		}
+		count++;
+	}
+
+	fprintf(stderr, "periph_sim: an interrupt stays pending after its handler ran\n");
+	return count;
+}
+
+/* Register the handler the simulator calls for an interrupt */
+void Sim_SetIRQHandler(IRQn_Type irq, void (*handler)(void))
+{
+	if (irq == SysTick_IRQn) {
+		simNvic.stHandler = handler;
+	}
+	else if (((int) irq >= 0) && ((int) irq < SIM_NUM_IRQS)) {
+		simNvic.handler[irq] = handler;
+	}
+}
+
+/* Mask interrupts, as __disable_irq() does */
+void Sim_DisableIRQ(void)
+{
+	simPrimask = true;
+}
+
+/* Unmask interrupts and deliver the pending ones, as __enable_irq() does */
+void Sim_EnableIRQ(void)
+{
+	simPrimask = false;
+	Sim_RunIRQs();
+}
+
+/* Let time pass until an interrupt is pending, as __WFI() does */
+uint64_t Sim_WaitForInterrupt(void)
+{
+	uint64_t start = simCycles, next, t;
+	unsigned int i;
+
+	while (!irqWaiting()) {
+		next = SIM_NEVER;
+		for (i = 0; i < SIM_NUM_PAGES; i++) {
+			t = modelNextEvent(&simPages[i]);
+			if (t < next) {
+				next = t;
+			}
+		}
+		if (next == SIM_NEVER) {
+			fprintf(stderr, "periph_sim: WFI with no interrupt to come\n");
+			break;
+		}
+		runTo((next > simCycles) ? next : simCycles + 1);
+	}
+	Sim_RunIRQs();
+	return simCycles - start;
+}
+
+/* Return the simulated time */
+uint64_t Sim_GetCycles(void)
+{
+	return simCycles;
+}
+
+/* Return the number of trapped register accesses to a peripheral */
+uint32_t Sim_GetAccessCount(const void *pPeriph)
+{
+	SIM_PAGE_T *pPage = findPage((uint32_t) (uintptr_t) pPeriph);
+
+	return pPage ? pPage->accesses : 0;
+}
+
+/* Clear the register access counters of all peripherals */
+void Sim_ClearAccessCounts(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < SIM_NUM_PAGES; i++) {
+		simPages[i].accesses = 0;
+	}
+}
+
+/* Allocate memory in the simulated AHB SRAM */
+void *Sim_RamAlloc(uint32_t size)
+{
+	uint32_t addr = simRamNext;
+
+	size = (size + 3) & ~3;
+	if (size > SIM_RAM_BASE + SIM_RAM_SIZE - addr) {
+		return NULL;
+	}
+	simRamNext += size;
+	return (void *) (uintptr_t) addr;
+}
+
+/* Queue characters on the receive line of a UART */
+int Sim_UART_Receive(LPC_USART_T *pUART, const uint8_t *data, int len)
+{
+	SIM_PAGE_T *pPage = findPage((uint32_t) (uintptr_t) pUART);
+	SIM_UART_T *pUart;
+	int i;
+
+	if ((pPage == NULL) || (pPage->kind != SIM_UART)) {
+		return 0;
+	}
+	pUart = pPage->pState;
+	if (pUart->lineCount == 0) {
+		pUart->lineNextAt = simCycles + uartCharCycles(pPage);
+	}
+	for (i = 0; (i < len) && (pUart->lineCount < SIM_UART_LINE_SIZE); i++) {
+		pUart->line[(pUart->lineHead + pUart->lineCount) % SIM_UART_LINE_SIZE] = data[i];
+		pUart->lineCount++;
+	}
+	return i;
+}
+
+/* Take the characters a UART has shifted out */
+int Sim_UART_Transmitted(LPC_USART_T *pUART, uint8_t *data, int len)
+{
+	SIM_PAGE_T *pPage = findPage((uint32_t) (uintptr_t) pUART);
+	SIM_UART_T *pUart;
+	int i;
+
+	if ((pPage == NULL) || (pPage->kind != SIM_UART)) {
+		return 0;
+	}
+	pUart = pPage->pState;
+	for (i = 0; (i < len) && (pUart->logCount > 0); i++) {
+		data[i] = pUart->log[pUart->logHead];
+		pUart->logHead = (pUart->logHead + 1) % SIM_UART_LINE_SIZE;
+		pUart->logCount--;
+	}
+	return i;
+}
+
+/* Attach a slave device model to an SSP */
+void Sim_SSP_SetDevice(LPC_SSP_T *pSSP, SIM_SSP_DEVICE_T device, void *ctx)
+{
+	SIM_PAGE_T *pPage = findPage((uint32_t) (uintptr_t) pSSP);
+	SIM_SSP_T *pSsp;
+
+	if ((pPage == NULL) || (pPage->kind != SIM_SSP)) {
+		return;
+	}
+	pSsp = pPage->pState;
+	pSsp->device = device;
+	pSsp->ctx = ctx;
+}
+
+/* Queue a frame on the receive side of the Ethernet MAC */
+int Sim_ENET_Receive(const uint8_t *data, int len)
+{
+	SIM_PAGE_T *pPage = findPage(LPC_ENET_BASE);
+	SIM_ENET_T *pEnet = pPage->pState;
+
+	if ((len <= 0) || (len > SIM_ENET_MAX_FRAME - 4) || (pEnet->lineCount >= SIM_ENET_QUEUE)) {
+		return 0;
+	}
+	if (pEnet->lineCount == 0) {
+		pEnet->lineNextAt = simCycles + enetFrameCycles(pPage, len);
+	}
+	pEnet->line[(pEnet->lineHead + pEnet->lineCount) % SIM_ENET_QUEUE].len = len;
+	memcpy(pEnet->line[(pEnet->lineHead + pEnet->lineCount) % SIM_ENET_QUEUE].data, data, len);
+	pEnet->lineCount++;
+	return len;
+}
+
+/* Take the next frame the Ethernet MAC has sent */
+int Sim_ENET_Transmitted(uint8_t *data, int len)
+{
+	SIM_ENET_T *pEnet = findPage(LPC_ENET_BASE)->pState;
+	SIM_FRAME_T *pFrame;
+
+	if (pEnet->logCount == 0) {
+		return 0;
+	}
+	pFrame = &pEnet->log[pEnet->logHead];
+	pEnet->logHead = (pEnet->logHead + 1) % SIM_ENET_QUEUE;
+	pEnet->logCount--;
+	if (len > (int) pFrame->len) {
+		len = pFrame->len;
+	}
+	memcpy(data, pFrame->data, len);
+	return len;
+}
+
+/* Set a register of the PHY behind the Ethernet MII */
+void Sim_ENET_SetPHYReg(uint8_t reg, uint16_t value)
+{
+	((SIM_ENET_T *) findPage(LPC_ENET_BASE)->pState)->phyReg[reg & 0x1F] = value;
+}
+
+/* Queue frames sent by the other nodes on the CAN bus */
+int Sim_CAN_Receive(const CAN_MSG_T *pMsgs, int count)
+{
+	int i;
+
+	for (i = 0; (i < count) && (simCanBus.lineCount < SIM_CAN_QUEUE); i++) {
+		canFromMsg(&simCanBus.line[(simCanBus.lineHead + simCanBus.lineCount) % SIM_CAN_QUEUE], &pMsgs[i]);
+		simCanBus.lineCount++;
+	}
+	canBusStart(simCycles);
+	return i;
+}
+
+/* Take the frames CAN1 and CAN2 have sent */
+int Sim_CAN_Transmitted(CAN_MSG_T *pMsgs, int count)
+{
+	SIM_CAN_FRAME_T *pFrame;
+	int i, j;
+
+	for (i = 0; (i < count) && (simCanBus.logCount > 0); i++) {
+		pFrame = &simCanBus.log[simCanBus.logHead];
+		simCanBus.logHead = (simCanBus.logHead + 1) % SIM_CAN_QUEUE;
+		simCanBus.logCount--;
+		pMsgs[i].ID = pFrame->id | ((pFrame->info & CAN_TFI_FF) ? CAN_EXTEND_ID_USAGE : 0);
+		pMsgs[i].Type = (pFrame->info & CAN_TFI_RTR) ? CAN_REMOTE_MSG : 0;
+		pMsgs[i].DLC = (pFrame->info >> 16) & 0xF;
+		for (j = 0; j < 8; j++) {
+			pMsgs[i].Data[j] = (uint8_t) (pFrame->data[j / 4] >> (8 * (j % 4)));
+		}
+	}
+	return i;
+}
+
+#if defined(CHIP_LPC177X_8X)
+void Sim_SDC_SetCard(uint8_t *pData, uint32_t blocks)
+{
+	SIM_PAGE_T *pPage = findPage(LPC_SDC_BASE);
+	SIM_SDC_T *pSdc = pPage->pState;
+
+	blocks &= ~(uint32_t) 1023;
+	pSdc->pData = (blocks > 0) ? pData : NULL;
+	pSdc->blocks = (pSdc->pData != NULL) ? blocks : 0;
+	sdcWireAbort(pPage, simCycles);
+	sdcCardReset(pPage);
+}
+
+void Sim_SDC_GetStats(SIM_SDC_STATS_T *pStats)
+{
+	*pStats = ((SIM_SDC_T *) findPage(LPC_SDC_BASE)->pState)->stats;
+}
+
+void Sim_SDC_ClearStats(void)
+{
+	memset(&((SIM_SDC_T *) findPage(LPC_SDC_BASE)->pState)->stats, 0, sizeof(SIM_SDC_STATS_T));
+}
+
+#endif
@@ -0,0 +1,277 @@
+/*
+ * @brief Host register-level peripheral simulator for the LPC175x/6x drivers
+ *
+ * @note
+ * Lets the unmodified chip driver sources (uart, ssp, timer, gpdma, enet, can,
+ * ritimer and the code they call) run in a Linux process, for unit tests and for counting
+ * the register traffic of driver hot paths without a board.  See readme.txt
+ * in this directory.  Built with CHIP_LPC177X_8X defined it simulates the
+ * LPC177x/8x instead, with the SD card interface (sdc, sdmmc) and an SD
+ * card in place of the RIT.
+ *
+ * @par
+ * The peripheral blocks are backed by memory mapped at their real
+ * addresses, so LPC_UART0, LPC_SSP1, NVIC and the other base pointers from
+ * chip.h work unchanged.  Plain registers (SYSCTL, IOCON, GPIO, ...) are
+ * ordinary memory.  The UART, SSP, timer, GPDMA, Ethernet, CAN, CAN
+ * acceptance filter, RIT (or SD card interface) and system control space
+ * (NVIC, SysTick) register pages are trapped, and every access to them runs a behavioural model of
+ * the block: FIFOs, status flags, interrupt flags, baud and bit rate timing,
+ * timer counting, DMA transfers, Ethernet descriptor processing and CAN bus
+ * arbitration, SD card commands and blocks.
+ *
+ * @par
+ * Simulated time is counted in peripheral clock cycles.  It advances by
+ * SIM_ACCESS_CYCLES on every trapped register access and by Sim_Advance().
+ * Interrupts are only delivered from Sim_Advance() and Sim_RunIRQs(), never
+ * in the middle of driver code.
+ */
+
+#ifndef __PERIPH_SIM_H_
+#define __PERIPH_SIM_H_
+
+#include "chip.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup PERIPH_SIM CHIP: Host peripheral simulator
+ * @ingroup CHIP_17XX_40XX_Drivers
+ * @{
+ */
+
+/** Peripheral clock cycles used by one trapped register access */
+#ifndef SIM_ACCESS_CYCLES
+#define SIM_ACCESS_CYCLES   4
+#endif
+
+/**
+ * @brief	SSP slave device model, called once per frame shifted out
+ * @param	ctx		: Context pointer given to Sim_SSP_SetDevice()
+ * @param	txFrame	: Frame sent by the SSP
+ * @return	Frame returned by the device
+ */
+typedef uint16_t (*SIM_SSP_DEVICE_T)(void *ctx, uint16_t txFrame);
+
+/**
+ * @brief	Map the peripheral address space and reset every model
+ * @return	true on success, false if the address space could not be mapped
+ * @note	Must be called before any driver function.  Calling it again
+ *			resets the registers, the models and the access counters.
+ */
+bool Sim_Init(void);
+
+/**
+ * @brief	Let simulated time pass, then deliver pending interrupts
+ * @param	cycles	: Number of peripheral clock cycles to run
+ * @return	Nothing
+ */
+void Sim_Advance(uint64_t cycles);
+
+/**
+ * @brief	Deliver pending interrupts
+ * @return	Number of interrupt handlers called
+ * @note	Handlers run in priority order (NVIC IP value, then IRQ number)
+ *			for as long as an enabled interrupt is pending and has a handler.
+ */
+int Sim_RunIRQs(void);
+
+/**
+ * @brief	Register the handler the simulator calls for an interrupt
+ * @param	irq		: Interrupt number, UART0_IRQn for example, or SysTick_IRQn
+ * @param	handler	: Handler, usually the application's IRQ handler, or NULL
+ * @return	Nothing
+ */
+void Sim_SetIRQHandler(IRQn_Type irq, void (*handler)(void));
+
+/**
+ * @brief	Mask interrupts, as __disable_irq() does
+ * @return	Nothing
+ * @note	Interrupts stay pending, and Sim_Advance() and Sim_RunIRQs()
+ *			deliver none, until Sim_EnableIRQ().
+ */
+void Sim_DisableIRQ(void);
+
+/**
+ * @brief	Unmask interrupts and deliver the pending ones, as __enable_irq() does
+ * @return	Nothing
+ */
+void Sim_EnableIRQ(void);
+
+/**
+ * @brief	Let time pass until an interrupt is pending, as __WFI() does
+ * @return	Peripheral clock cycles slept
+ * @note	Wakes on an interrupt enabled in the NVIC or on the SysTick
+ *			exception, even while Sim_DisableIRQ() masks them, and then
+ *			delivers them unless masked.  Returns at once, with a message,
+ *			when no model has an event to come.
+ */
+uint64_t Sim_WaitForInterrupt(void);
+
+/**
+ * @brief	Return the simulated time
+ * @return	Peripheral clock cycles since Sim_Init()
+ */
+uint64_t Sim_GetCycles(void);
+
+/**
+ * @brief	Return the number of trapped register accesses to a peripheral
+ * @param	pPeriph	: Peripheral base, LPC_UART0 for example
+ * @return	Reads plus writes since Sim_Init() or Sim_ClearAccessCounts()
+ */
+uint32_t Sim_GetAccessCount(const void *pPeriph);
+
+/**
+ * @brief	Clear the register access counters of all peripherals
+ * @return	Nothing
+ */
+void Sim_ClearAccessCounts(void);
+
+/**
+ * @brief	Allocate memory in the simulated AHB SRAM
+ * @param	size	: Number of bytes, rounded up to a multiple of 4
+ * @return	Pointer to the memory, or NULL when the 32 KB are used up
+ * @note	The drivers keep buffer addresses in uint32_t, so buffers handed
+ *			to the GPDMA and SSP drivers must come from here (or from the
+ *			simulated local SRAM).  On the LPC177x/8x the memory is the
+ *			peripheral SRAM at 0x20000000.
+ */
+void *Sim_RamAlloc(uint32_t size);
+
+/**
+ * @brief	Queue characters on the receive line of a UART
+ * @param	pUART	: UART peripheral
+ * @param	data	: Characters to receive
+ * @param	len		: Number of characters
+ * @return	Number of characters queued
+ * @note	The characters arrive one character time apart, at the baud
+ *			rate set in the UART.  Characters that find the receive FIFO
+ *			full are lost and set the overrun error.
+ */
+int Sim_UART_Receive(LPC_USART_T *pUART, const uint8_t *data, int len);
+
+/**
+ * @brief	Take the characters a UART has shifted out
+ * @param	pUART	: UART peripheral
+ * @param	data	: Buffer for the characters
+ * @param	len		: Size of the buffer
+ * @return	Number of characters copied
+ */
+int Sim_UART_Transmitted(LPC_USART_T *pUART, uint8_t *data, int len);
+
+/**
+ * @brief	Attach a slave device model to an SSP
+ * @param	pSSP	: SSP peripheral
+ * @param	device	: Device model, or NULL to read back 0 (or the sent
+ *					  frame in loopback mode)
+ * @param	ctx		: Context pointer passed to the device model
+ * @return	Nothing
+ */
+void Sim_SSP_SetDevice(LPC_SSP_T *pSSP, SIM_SSP_DEVICE_T device, void *ctx);
+
+/**
+ * @brief	Queue a frame on the receive side of the Ethernet MAC
+ * @param	data	: Frame, from the destination address to the payload
+ * @param	len		: Frame length without the CRC, at most 2044
+ * @return	len, or 0 if the frame was not queued (32 frames are waiting)
+ * @note	Frames arrive back to back at the speed set in SUPP. The MAC
+ *			appends the CRC when it stores a frame, as the hardware does.
+ */
+int Sim_ENET_Receive(const uint8_t *data, int len);
+
+/**
+ * @brief	Take the next frame the Ethernet MAC has sent
+ * @param	data	: Buffer for the frame
+ * @param	len		: Size of the buffer
+ * @return	Number of bytes copied, 0 if no frame was sent
+ * @note	The frame is padded to 60 bytes as the MAC2 settings ask, and
+ *			comes without its CRC. The last 32 frames are kept. With
+ *			ENET_MAC1_LOOPBACK set in MAC1, sent frames are also received.
+ */
+int Sim_ENET_Transmitted(uint8_t *data, int len);
+
+/**
+ * @brief	Set a register of the PHY behind the Ethernet MII
+ * @param	reg		: PHY register number, 0 to 31
+ * @param	value	: New value
+ * @return	Nothing
+ * @note	The PHY starts as an SMSC LAN8720 without a cable. Set the
+ *			link bit (bit 2) of register 1 to plug the cable in.
+ */
+void Sim_ENET_SetPHYReg(uint8_t reg, uint16_t value);
+
+/**
+ * @brief	Queue frames sent by the other nodes on the CAN bus
+ * @param	pMsgs	: Frames to send
+ * @param	count	: Number of frames
+ * @return	Number of frames queued, at most 64 wait
+ * @note	The frames go out back to back at the bit rate of the first
+ *			controller out of reset mode, and take part in the arbitration
+ *			with the frames of CAN1 and CAN2. They are acknowledged, and
+ *			received by both controllers through the acceptance filter.
+ */
+int Sim_CAN_Receive(const CAN_MSG_T *pMsgs, int count);
+
+/**
+ * @brief	Take the frames CAN1 and CAN2 have sent, in bus order
+ * @param	pMsgs	: Buffer for the frames
+ * @param	count	: Size of the buffer, in frames
+ * @return	Number of frames copied. The last 64 frames are kept.
+ */
+int Sim_CAN_Transmitted(CAN_MSG_T *pMsgs, int count);
+
+#if defined(CHIP_LPC177X_8X)
+/**
+ * @brief SD card counters, see Sim_SDC_GetStats()
+ */
+typedef struct {
+	uint32_t commands[64];		/*!< Commands the card took, by index */
+	uint32_t appCommands[64];	/*!< Application commands (ACMD) the card took, by index */
+	uint32_t blocksRead;		/*!< Blocks the card sent that the data path stored */
+	uint32_t blocksWritten;		/*!< Blocks the card wrote */
+	uint32_t blocksDiscarded;	/*!< Blocks the card sent with no data path waiting */
+	uint32_t overruns;			/*!< Blocks lost to a FIFO not emptied in time */
+	uint32_t crcErrors;			/*!< Blocks of the wrong size or bus width */
+} SIM_SDC_STATS_T;
+
+/**
+ * @brief	Put an SD card in the slot of the SD card interface
+ * @param	pData	: Card contents, blocks * 512 bytes, or NULL for an empty slot
+ * @param	blocks	: Card size in 512 byte blocks, rounded down to a
+ *					  multiple of 1024
+ * @return	Nothing
+ * @note	The card is an SDHC card, addressed by block, that powers up
+ *			after three ACMD41s.  It sends the first block of a read 100 us
+ *			after the command and the next one two SD clocks after the end
+ *			of the last, is busy 10 us after each block of a multiple block
+ *			write and programs for 400 us at the end of a write.  A block
+ *			that arrives while the FIFO still holds the block before is
+ *			lost and sets RXOVERRUN, as on the hardware.
+ */
+void Sim_SDC_SetCard(uint8_t *pData, uint32_t blocks);
+
+/**
+ * @brief	Return the SD card counters
+ * @param	pStats	: Filled with the counters since Sim_Init() or Sim_SDC_ClearStats()
+ * @return	Nothing
+ */
+void Sim_SDC_GetStats(SIM_SDC_STATS_T *pStats);
+
+/**
+ * @brief	Clear the SD card counters
+ * @return	Nothing
+ */
+void Sim_SDC_ClearStats(void);
+
+#endif /* defined(CHIP_LPC177X_8X) */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PERIPH_SIM_H_ */
@@ -32,6 +32,8 @@
 #ifndef __CAN_17XX_40XX_H_
 #define __CAN_17XX_40XX_H_
 
+#include "ring_buffer.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -753,6 +755,102 @@ typedef enum {
 	CAN_AF_FULL_MODE = CANAF_AFMR_EFCAN,	/*!< FullCAN Mode Enhancement */
 } CAN_AF_MODE_T;
 
+/** Number of frames the transmit queue of a CAN service holds */
+#ifndef CAN_SERVICE_TXQ_SIZE
+#define CAN_SERVICE_TXQ_SIZE    16
+#endif
+
+/*
+ * @brief CAN service events, passed to the event callback
+ */
+
+/** Frames were put in the receive ring */
+#define CAN_SERVICE_EVT_RX      ((uint32_t) (1 << 0))
+
+/** Room was made in the transmit queue */
+#define CAN_SERVICE_EVT_TX      ((uint32_t) (1 << 1))
+
+/** Frames were put in mailboxes */
+#define CAN_SERVICE_EVT_MAILBOX ((uint32_t) (1 << 2))
+
+/**
+ * @brief Frame received by a CAN service
+ * @note  The CAN controllers have no capture register, so Timestamp is the
+ *        time base read as the first access of the interrupt that took the
+ *        frame: the end of the frame on the bus plus the interrupt latency.
+ *        With CAN_IRQn free to run that is a few microseconds. A frame
+ *        that waited in the second receive buffer while the interrupt was
+ *        held off is stamped late by as long as it waited.
+ */
+typedef struct {
+	CAN_MSG_T Msg;					/*!< The frame */
+	uint32_t Timestamp;				/*!< Time base count when the frame was taken, see above */
+} CAN_RX_FRAME_T;
+
+/**
+ * @brief Per-ID mailbox of a CAN service, holding the last frame of its ID
+ */
+typedef struct {
+	uint32_t ID;					/*!< Frame ID, with CAN_EXTEND_ID_USAGE for an extended ID */
+	CAN_RX_FRAME_T Frame;			/*!< Last frame received with ID */
+	volatile uint32_t Seq;			/*!< Twice the frames written, odd while the interrupt writes */
+	uint32_t ReadSeq;				/*!< Seq of the frame last read */
+} CAN_MAILBOX_T;
+
+/**
+ * @brief Frame waiting in the transmit queue of a CAN service
+ */
+typedef struct {
+	CAN_MSG_T Msg;					/*!< The frame */
+	uint32_t Seq;					/*!< Queueing order, keeps the frames of one ID in order */
+} CAN_TX_ENTRY_T;
+
+struct CAN_SERVICE;
+
+/**
+ * @brief	CAN service event callback, called from the interrupt
+ * @param	pSvc	: Service the events belong to
+ * @param	Events	: Or'ed CAN_SERVICE_EVT_* values
+ * @return	Nothing
+ * @note	An RTOS port gives the semaphores its wait callback takes here.
+ */
+typedef void (*CAN_SERVICE_EVENT_T)(struct CAN_SERVICE *pSvc, uint32_t Events);
+
+/**
+ * @brief	CAN service wait callback, called by the blocking functions
+ * @param	pSvc	: Service waited on
+ * @return	Nothing
+ * @note	Returns after an event or a timeout. A NULL callback makes the
+ *			blocking functions poll.
+ */
+typedef void (*CAN_SERVICE_WAIT_T)(struct CAN_SERVICE *pSvc);
+
+/**
+ * @brief Interrupt driven CAN controller service
+ */
+typedef struct CAN_SERVICE {
+	LPC_CAN_T *pCAN;				/*!< Controller */
+	RINGBUFF_T *pRxRing;			/*!< Received frames, CAN_RX_FRAME_T items */
+	const volatile uint32_t *pTimeBase;	/*!< Free running counter for the timestamps, or NULL */
+	CAN_SERVICE_EVENT_T pEventFunc;	/*!< Event callback, or NULL */
+	CAN_SERVICE_WAIT_T pWaitFunc;	/*!< Wait callback, or NULL */
+	void *pUserData;				/*!< For the callbacks */
+	CAN_MAILBOX_T *pMailboxes;		/*!< Mailboxes in ascending ID order, or NULL */
+	uint32_t MailboxNum;			/*!< Number of mailboxes */
+	CAN_TX_ENTRY_T TxQueue[CAN_SERVICE_TXQ_SIZE + CAN_BUFFER_LAST];	/*!< Heap, most urgent frame first */
+	uint32_t TxQueueNum;			/*!< Frames in TxQueue */
+	uint32_t TxSeq;					/*!< Queueing order of the next frame */
+	CAN_TX_ENTRY_T TxBuf[CAN_BUFFER_LAST];	/*!< Frames in the transmit buffers */
+	uint8_t TxBusy;					/*!< Bit n set while transmit buffer n holds a frame */
+	uint8_t TxAbort;				/*!< Bit n set while the frame in buffer n is being aborted */
+	uint32_t RxFrames;				/*!< Frames put in the receive ring */
+	uint32_t RxMailboxFrames;		/*!< Frames put in mailboxes */
+	uint32_t RxDropped;				/*!< Frames lost because the receive ring was full */
+	uint32_t RxOverruns;			/*!< Data overruns, frames lost in the controller */
+	uint32_t TxFrames;				/*!< Frames sent */
+	uint32_t TxPreempted;			/*!< Frames taken back from a buffer for a more urgent one */
+} CAN_SERVICE_T;
+
 /**
  * @brief	Set the CAN command request
  * @param	pCAN	: Pointer to CAN peripheral block
@@ -902,6 +1000,24 @@ STATIC INLINE CAN_AF_MODE_T Chip_CAN_GetAFMode(LPC_CANAF_T *pCanAF)
  */
 Status Chip_CAN_SetAFLUT(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam, CANAF_LUT_T *pAFSections);
 
+/**
+ * @brief	Build the whole CAN AF LUT from unsorted sections
+ * @param	pCANAF	: Pointer to CAN AF Register block
+ * @param	pCANAFRam	: Pointer to CAN AF RAM Register block
+ * @param	pAFSections	: Pointer to buffer storing AF Section Data, in any order
+ * @return	SUCCESS/ERROR
+ * @note	The sections are sorted in place in the order the hardware
+ * searches them (controller number, then ID), repeated IDs are dropped,
+ * keeping an enabled entry over a disabled one, and overlapping or adjacent
+ * ranges with the same Disable bits are merged. The entry numbers in
+ * pAFSections are updated to match. The AF RAM is then written once, row
+ * by row, so a large filter set loads in O(n log n) instead of the O(n^2)
+ * row shifting of repeated Chip_CAN_Insert*Entry() calls. ERROR is returned
+ * without touching the AF RAM if a range is reversed or spans two
+ * controllers, or if the table and the FullCAN message objects do not fit.
+ */
+Status Chip_CAN_BuildAFLUT(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam, CANAF_LUT_T *pAFSections);
+
 /**
  * @brief	Insert a FullCAN Entry into the current LUT
  * @param	pCANAF	: Pointer to CAN AF Register block
@@ -1119,6 +1235,101 @@ Status Chip_CAN_FullCANReceive(LPC_CANAF_T *pCANAF,
 							   CAN_MSG_T *pMsg,
 							   uint8_t *pSCC);
 
+/**
+ * @brief	Set up the interrupt driven service of a CAN controller
+ * @param	pSvc		: Service to set up
+ * @param	pCAN		: Controller, set up with Chip_CAN_Init() and Chip_CAN_SetBitRate()
+ * @param	pRxRing		: Ring buffer set up for CAN_RX_FRAME_T items, for the received frames
+ * @param	pTimeBase	: Free running counter the frames are stamped with,
+ *						  &LPC_TIMER1->TC for example, or NULL
+ * @return	Nothing
+ * @note	Turns transmit priority mode off, so that the controller sends
+ *			the lowest ID of its buffers first as the bus would, and enables
+ *			the receive, transmit and data overrun interrupts. Set
+ *			pEventFunc, pWaitFunc and pUserData after this call if needed,
+ *			call Chip_CAN_Service_IRQHandler() from CAN_IRQHandler and
+ *			enable CAN_IRQn.
+ */
+void Chip_CAN_Service_Init(CAN_SERVICE_T *pSvc, LPC_CAN_T *pCAN, RINGBUFF_T *pRxRing,
+						   const volatile uint32_t *pTimeBase);
+
+/**
+ * @brief	CAN service interrupt handler
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @return	Nothing
+ * @note	Empties the receive buffer into the mailboxes of their IDs or
+ *			the ring, stamping the frames with the time base, and loads the most urgent queued frames in
+ *			the free transmit buffers. When the three buffers are taken and
+ *			a more urgent frame waits, the least urgent buffer is aborted
+ *			and its frame queued again, so a low priority frame cannot hold
+ *			up a high priority one (priority inversion). CAN1 and CAN2 share
+ *			CAN_IRQn, call the handler of both services from it.
+ */
+void Chip_CAN_Service_IRQHandler(CAN_SERVICE_T *pSvc);
+
+/**
+ * @brief	Queue a frame for sending
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @param	pMsg	: Frame, copied into the queue
+ * @return	ERROR if the queue is full, SUCCESS otherwise
+ * @note	Frames go out by ID, lowest first, and in queueing order for one
+ *			ID. The transmit buffers are loaded by the interrupt, which this
+ *			function sets pending.
+ */
+Status Chip_CAN_Service_Write(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg);
+
+/**
+ * @brief	Queue a frame for sending, waiting for room in the queue
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @param	pMsg	: Frame, copied into the queue
+ * @return	Nothing
+ */
+void Chip_CAN_Service_WriteBlocking(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg);
+
+/**
+ * @brief	Take a received frame
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @param	pFrame	: Where to store the frame and its timestamp
+ * @return	ERROR if no frame was received, SUCCESS otherwise
+ */
+STATIC INLINE Status Chip_CAN_Service_Read(CAN_SERVICE_T *pSvc, CAN_RX_FRAME_T *pFrame)
+{
+	return RingBuffer_Pop(pSvc->pRxRing, pFrame) ? SUCCESS : ERROR;
+}
+
+/**
+ * @brief	Take a received frame, waiting for one
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @param	pFrame	: Where to store the frame and its timestamp
+ * @return	Nothing
+ */
+void Chip_CAN_Service_ReadBlocking(CAN_SERVICE_T *pSvc, CAN_RX_FRAME_T *pFrame);
+
+/**
+ * @brief	Give the service mailboxes for single IDs
+ * @param	pSvc		: Service set up with Chip_CAN_Service_Init()
+ * @param	pMailboxes	: Mailboxes with ID set, in ascending ID order, or NULL
+ * @param	Num			: Number of mailboxes
+ * @return	ERROR if the IDs are not in ascending order, SUCCESS otherwise
+ * @note	Frames of a mailbox ID no longer go to the receive ring: each
+ *			one replaces the last in the mailbox, as a FullCAN message
+ *			object does, so a fast periodic ID cannot crowd the others out
+ *			of the ring. The interrupt finds the mailbox with a binary
+ *			search. Call it before CAN_IRQn is enabled.
+ */
+Status Chip_CAN_Service_SetMailboxes(CAN_SERVICE_T *pSvc, CAN_MAILBOX_T *pMailboxes, uint32_t Num);
+
+/**
+ * @brief	Take the frame in a mailbox if it came after the last one taken
+ * @param	pSvc	: Service set up with Chip_CAN_Service_Init()
+ * @param	Index	: Mailbox index in the array given to Chip_CAN_Service_SetMailboxes()
+ * @param	pFrame	: Where to store the frame and its timestamp
+ * @return	ERROR if there is no new frame, SUCCESS otherwise
+ * @note	The interrupt may replace the frame while it is copied, the copy
+ *			is then taken again, so the frame is never torn.
+ */
+Status Chip_CAN_Service_ReadMailbox(CAN_SERVICE_T *pSvc, uint32_t Index, CAN_RX_FRAME_T *pFrame);
+
 /**
  * @}
  */
@@ -489,6 +489,80 @@ typedef enum {
 	ENET_BUFF_FULL,				/* buffer is full */
 } ENET_BUFF_STATUS_T;
 
+/**
+ * @brief Number of receive descriptors of an ENET_RING_T
+ */
+#ifndef ENET_RING_RX_DESCS
+#define ENET_RING_RX_DESCS      8
+#endif
+
+/**
+ * @brief Number of transmit descriptors of an ENET_RING_T
+ */
+#ifndef ENET_RING_TX_DESCS
+#define ENET_RING_TX_DESCS      8
+#endif
+
+/**
+ * @brief Number of frame buffers in the pool of an ENET_RING_T, more than ENET_RING_RX_DESCS
+ */
+#ifndef ENET_RING_POOL_BUFS
+#define ENET_RING_POOL_BUFS     16
+#endif
+
+/**
+ * @brief Size of a pool buffer, it holds a full frame with its CRC
+ */
+#define ENET_RING_BUF_SIZE      ENET_ETH_MAX_FLEN
+
+/**
+ * @brief Bytes of Ethernet DMA memory Chip_ENET_Ring_Init() needs for descriptors, status and pool
+ */
+#define ENET_RING_MEM_SIZE      (ENET_RING_RX_DESCS * (sizeof(ENET_RXSTAT_T) + sizeof(ENET_RXDESC_T)) + \
+								 ENET_RING_TX_DESCS * (sizeof(ENET_TXDESC_T) + sizeof(ENET_TXSTAT_T)) + \
+								 ENET_RING_POOL_BUFS * ENET_RING_BUF_SIZE)
+
+/**
+ * @brief One piece of a frame to send, see Chip_ENET_Ring_Send()
+ */
+typedef struct {
+	const void *pData;		/*!< Data, it must stay untouched until the frame is sent */
+	uint32_t len;			/*!< Number of bytes, 1 to 2048 */
+} ENET_FRAG_T;
+
+struct ENET_RING;
+
+/**
+ * @brief	Frame sent callback
+ * @param	pRing	: Ring the frame was sent on
+ * @param	ref		: Reference given to Chip_ENET_Ring_Send()
+ * @return	Nothing
+ */
+typedef void (*ENET_RING_TXDONE_T)(struct ENET_RING *pRing, void *ref);
+
+/**
+ * @brief Ethernet descriptor rings with a frame buffer pool
+ */
+typedef struct ENET_RING {
+	LPC_ENET_T *pENET;				/*!< The ENET peripheral */
+	ENET_RXSTAT_T *pRxStat;			/*!< Receive status array */
+	ENET_RXDESC_T *pRxDesc;			/*!< Receive descriptor array */
+	ENET_TXDESC_T *pTxDesc;			/*!< Transmit descriptor array */
+	ENET_TXSTAT_T *pTxStat;			/*!< Transmit status array */
+	uint8_t *rxBuf[ENET_RING_RX_DESCS];		/*!< Pool buffer behind each receive descriptor */
+	void *txRef[ENET_RING_TX_DESCS];		/*!< Reference of the frame ending at each transmit descriptor */
+	uint8_t *pFree[ENET_RING_POOL_BUFS];	/*!< Free pool buffers */
+	uint32_t freeCount;				/*!< Number of entries in pFree */
+	uint32_t rxConsume;				/*!< Next receive descriptor to hand out */
+	uint32_t txProduce;				/*!< Next transmit descriptor to fill */
+	uint32_t txClean;				/*!< Oldest transmit descriptor not yet reclaimed */
+	ENET_RING_TXDONE_T txDone;		/*!< Frame sent callback, NULL to give ref back to the pool */
+	void *pUserData;				/*!< Free for the application */
+	uint32_t rxDropped;				/*!< Frames dropped for want of a pool buffer */
+	uint32_t rxErrors;				/*!< Frames dropped for receive errors */
+	uint32_t txErrors;				/*!< Frames the MAC reported as failed */
+} ENET_RING_T;
+
 /**
  * @brief	Resets the ethernet interface
  * @param	pENET	: The base of ENET peripheral on the chip
@@ -903,6 +977,83 @@ void Chip_ENET_DeInit(LPC_ENET_T *pENET);
  */
 uint32_t Chip_ENET_FindMIIDiv(LPC_ENET_T *pENET, uint32_t clockRate);
 
+/**
+ * @brief	Set up the descriptor rings and the frame buffer pool
+ * @param	pRing	: Ring to set up
+ * @param	pENET	: The base of ENET peripheral on the chip
+ * @param	pMem	: ENET_RING_MEM_SIZE bytes of memory the Ethernet DMA can
+ *					  reach (AHB SRAM), 8 byte aligned
+ * @param	txDone	: Frame sent callback, or NULL (see Chip_ENET_Ring_Send())
+ * @return	ERROR if pMem is not aligned, SUCCESS otherwise
+ * @note	Call after Chip_ENET_Init() with transmit and receive disabled,
+ *			then enable them. Every receive descriptor is given a pool
+ *			buffer, the rest of the pool is free for the application.
+ */
+Status Chip_ENET_Ring_Init(ENET_RING_T *pRing, LPC_ENET_T *pENET, void *pMem,
+						   ENET_RING_TXDONE_T txDone);
+
+/**
+ * @brief	Take the next received frame, without copying it
+ * @param	pRing	: Ring set up with Chip_ENET_Ring_Init()
+ * @param	pLen	: Set to the frame length, without the CRC
+ * @return	The pool buffer holding the frame, or NULL if none is waiting
+ * @note	The buffer belongs to the caller until it goes back with
+ *			Chip_ENET_Ring_FreeBuf() or is sent with Chip_ENET_Ring_Send().
+ *			The descriptor is refilled from the pool at once. Frames
+ *			with errors, and frames arriving while the pool is empty, are
+ *			dropped and counted so that the MAC never runs out of
+ *			descriptors.
+ */
+uint8_t *Chip_ENET_Ring_Receive(ENET_RING_T *pRing, uint32_t *pLen);
+
+/**
+ * @brief	Queue a frame made of one or more pieces, without copying it
+ * @param	pRing		: Ring set up with Chip_ENET_Ring_Init()
+ * @param	pFrags		: Pieces of the frame, in order
+ * @param	numFrags	: Number of pieces, each takes a transmit descriptor
+ * @param	ref			: Passed to the frame sent callback. Without a
+ *						  callback it must be NULL or a pool buffer, which
+ *						  then goes back to the pool once the frame is sent.
+ * @return	ERROR if there are not numFrags free descriptors, SUCCESS otherwise
+ * @note	The MAC adds the padding and CRC. Sent frames are reclaimed
+ *			here and by Chip_ENET_Ring_TxReclaim().
+ */
+Status Chip_ENET_Ring_Send(ENET_RING_T *pRing, const ENET_FRAG_T *pFrags,
+						   uint32_t numFrags, void *ref);
+
+/**
+ * @brief	Finish the frames the MAC has sent
+ * @param	pRing	: Ring set up with Chip_ENET_Ring_Init()
+ * @return	Number of frames finished
+ * @note	Calls the frame sent callback, or gives ref back to the pool,
+ *			for each frame. Call it from the ENET_INT_TXDONE interrupt or
+ *			before waiting for descriptors.
+ */
+uint32_t Chip_ENET_Ring_TxReclaim(ENET_RING_T *pRing);
+
+/**
+ * @brief	Take a buffer from the pool, to build a frame or a header in
+ * @param	pRing	: Ring set up with Chip_ENET_Ring_Init()
+ * @return	A buffer of ENET_RING_BUF_SIZE bytes, or NULL if the pool is empty
+ */
+STATIC INLINE uint8_t *Chip_ENET_Ring_AllocBuf(ENET_RING_T *pRing)
+{
+	return (pRing->freeCount > 0) ? pRing->pFree[--pRing->freeCount] : NULL;
+}
+
+/**
+ * @brief	Give a buffer back to the pool
+ * @param	pRing	: Ring set up with Chip_ENET_Ring_Init()
+ * @param	pBuf	: Buffer from Chip_ENET_Ring_Receive() or Chip_ENET_Ring_AllocBuf()
+ * @return	Nothing
+ * @note	The pool has no locking, use the ring from one interrupt
+ *			priority level.
+ */
+STATIC INLINE void Chip_ENET_Ring_FreeBuf(ENET_RING_T *pRing, uint8_t *pBuf)
+{
+	pRing->pFree[pRing->freeCount++] = pBuf;
+}
+
 /**
  * @}
  */
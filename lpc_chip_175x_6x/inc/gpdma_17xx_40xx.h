@@ -266,13 +266,41 @@ typedef struct {
 #define SRC_PER_CONTROLLER 1	/*!< Flow control is Source peripheral controller*/
 #define DST_PER_CONTROLLER 2	/*!< Flow control is Destination peripheral controller*/
 
+/**
+ * @brief	GPDMA channel callback
+ * @param	pGPDMA		: The base of GPDMA on the chip
+ * @param	ChannelNum	: Channel that raised the interrupt
+ * @param	status		: SUCCESS on a terminal count, ERROR on a DMA error
+ * @param	pUserData	: Pointer given to Chip_GPDMA_ReserveChannel()
+ * @return	Nothing
+ * @note	Called from Chip_GPDMA_IRQHandler() with the flag already cleared.
+ */
+typedef void (*GPDMA_CALLBACK_T)(LPC_GPDMA_T *pGPDMA, uint8_t ChannelNum, Status status, void *pUserData);
+
 /**
  * @brief DMA channel handle structure
  */
 typedef struct {
 	FunctionalState ChannelStatus;	/*!< DMA channel status */
+	GPDMA_CALLBACK_T callback;		/*!< Interrupt callback, or NULL */
+	void *pUserData;				/*!< Passed to the callback */
 } DMA_ChannelHandle_t;
 
+/**
+ * @brief GPDMA channel priority for Chip_GPDMA_ReserveChannel()
+ */
+typedef enum {
+	GPDMA_PRIO_HIGH,		/*!< Lowest free channel number, wins arbitration */
+	GPDMA_PRIO_LOW			/*!< Highest free channel number */
+} GPDMA_PRIO_T;
+
+/**
+ * @brief Number of descriptors in the pool of Chip_GPDMA_AllocDescriptors(), at most 32
+ */
+#ifndef GPDMA_DESC_POOL_SIZE
+#define GPDMA_DESC_POOL_SIZE    16
+#endif
+
 /**
  * @brief Transfer Descriptor structure typedef
  */
@@ -283,6 +311,18 @@ typedef struct DMA_TransferDescriptor {
 	uint32_t ctrl;	/*!< Control word that has transfer size, type etc. */
 } DMA_TransferDescriptor_t;
 
+/**
+ * @brief Prepared transfer, see Chip_GPDMA_PrepareTransfer()
+ */
+typedef struct {
+	uint32_t SrcAddr;		/*!< Peripheral source register, 0 when the source is memory */
+	uint32_t DstAddr;		/*!< Peripheral destination register, 0 when the destination is memory */
+	uint32_t Control;		/*!< Channel control word without the transfer size */
+	uint32_t Config;		/*!< Channel configuration word without the enable bit */
+	uint8_t ChannelNum;		/*!< Channel the transfer runs on */
+	uint8_t SizeShift;		/*!< Shift from the Size argument to transfers, 2 for M2M (bytes to words) */
+} GPDMA_XFER_T;
+
 /**
  * @brief	Initialize the GPDMA
  * @param	pGPDMA	: The base of GPDMA on the chip
@@ -439,6 +479,147 @@ Status Chip_GPDMA_PrepareDescriptor(LPC_GPDMA_T *pGPDMA,
 									GPDMA_FLOW_CONTROL_T TransferType,
 									const DMA_TransferDescriptor_t *NextDescriptor);
 
+/**
+ * @brief	Work out the channel set-up of a repeated transfer once
+ * @param	pGPDMA		: The base of GPDMA on the chip
+ * @param	pXfer		: Prepared transfer to fill in
+ * @param	ChannelNum	: Channel used for the transfer
+ * @param	src			: Address of Memory or PeripheralConnection_ID which is the source
+ * @param	dst			: Address of Memory or PeripheralConnection_ID which is the destination
+ * @param	TransferType: Select the transfer controller and the type of transfer. (See, #GPDMA_FLOW_CONTROL_T)
+ * @return	ERROR on error, SUCCESS on success
+ * @note	This does the table look-ups, control and configuration word
+ *			building and DMA request multiplexer set-up of
+ *			Chip_GPDMA_Transfer(), so that Chip_GPDMA_StartPrepared() only
+ *			has to write the addresses and the size. Prepare again if the
+ *			multiplexer (DMAREQSEL) of a peripheral connection is switched
+ *			for another transfer in between. Memory addresses given here
+ *			are not kept, they are passed to each Chip_GPDMA_StartPrepared().
+ */
+Status Chip_GPDMA_PrepareTransfer(LPC_GPDMA_T *pGPDMA,
+								  GPDMA_XFER_T *pXfer,
+								  uint8_t ChannelNum,
+								  uint32_t src,
+								  uint32_t dst,
+								  GPDMA_FLOW_CONTROL_T TransferType);
+
+/**
+ * @brief	Start a transfer prepared with Chip_GPDMA_PrepareTransfer()
+ * @param	pGPDMA	: The base of GPDMA on the chip
+ * @param	pXfer	: Prepared transfer
+ * @param	src		: Source memory address, ignored when the source is a peripheral
+ * @param	dst		: Destination memory address, ignored when the destination is a peripheral
+ * @param	Size	: The number of DMA transfers, in bytes for M2M as with
+ *					  Chip_GPDMA_Transfer(), at most 4095 transfers
+ * @return	ERROR if the channel is still running, SUCCESS otherwise
+ */
+STATIC INLINE Status Chip_GPDMA_StartPrepared(LPC_GPDMA_T *pGPDMA,
+											  const GPDMA_XFER_T *pXfer,
+											  uint32_t src,
+											  uint32_t dst,
+											  uint32_t Size)
+{
+	GPDMA_CH_T *pDMAch = &pGPDMA->CH[pXfer->ChannelNum];
+	uint32_t chMask = 1UL << pXfer->ChannelNum;
+
+	if (pGPDMA->ENBLDCHNS & chMask) {
+		return ERROR;
+	}
+
+	pGPDMA->INTTCCLEAR = chMask;
+	pGPDMA->INTERRCLR = chMask;
+	pDMAch->SRCADDR = pXfer->SrcAddr ? pXfer->SrcAddr : src;
+	pDMAch->DESTADDR = pXfer->DstAddr ? pXfer->DstAddr : dst;
+	pDMAch->LLI = 0;
+	pDMAch->CONTROL = pXfer->Control | GPDMA_DMACCxControl_TransferSize(Size >> pXfer->SizeShift);
+	pDMAch->CONFIG = pXfer->Config | GPDMA_DMACCxConfig_E;
+
+	return SUCCESS;
+}
+
+/**
+ * @brief	Fill in a DMA descriptor from a prepared transfer
+ * @param	pXfer			: Prepared transfer
+ * @param	DMADescriptor	: DMA Descriptor to be filled in
+ * @param	src				: Source memory address, ignored when the source is a peripheral
+ * @param	dst				: Destination memory address, ignored when the destination is a peripheral
+ * @param	Size			: The number of DMA transfers, as for Chip_GPDMA_StartPrepared()
+ * @param	NextDescriptor	: Pointer to next descriptor (0 if no more descriptors available)
+ * @return	Nothing
+ * @note	As Chip_GPDMA_PrepareDescriptor(), only the last descriptor of
+ *			a list interrupts. Start the list with Chip_GPDMA_SGTransfer().
+ */
+STATIC INLINE void Chip_GPDMA_FillDescriptor(const GPDMA_XFER_T *pXfer,
+											 DMA_TransferDescriptor_t *DMADescriptor,
+											 uint32_t src,
+											 uint32_t dst,
+											 uint32_t Size,
+											 const DMA_TransferDescriptor_t *NextDescriptor)
+{
+	DMADescriptor->src = pXfer->SrcAddr ? pXfer->SrcAddr : src;
+	DMADescriptor->dst = pXfer->DstAddr ? pXfer->DstAddr : dst;
+	DMADescriptor->lli = (uint32_t) NextDescriptor;
+	DMADescriptor->ctrl = pXfer->Control | GPDMA_DMACCxControl_TransferSize(Size >> pXfer->SizeShift);
+	if (NextDescriptor) {
+		DMADescriptor->ctrl &= ~GPDMA_DMACCxControl_I;
+	}
+}
+
+/**
+ * @brief	Reserve a GPDMA channel and route its interrupts to a callback
+ * @param	pGPDMA		: The base of GPDMA on the chip
+ * @param	prio		: GPDMA_PRIO_HIGH for the lowest free channel, which wins
+ *						  bus arbitration, GPDMA_PRIO_LOW for the highest free one
+ * @param	callback	: Called by Chip_GPDMA_IRQHandler(), or NULL to poll the
+ *						  channel as with Chip_GPDMA_GetFreeChannel()
+ * @param	pUserData	: Passed to the callback
+ * @return	The channel number, or -1 if all channels are in use
+ * @note	The channel stays reserved across transfers until
+ *			Chip_GPDMA_ReleaseChannel() or Chip_GPDMA_Stop(). Reserve
+ *			channels at start-up or from one interrupt priority level.
+ */
+int Chip_GPDMA_ReserveChannel(LPC_GPDMA_T *pGPDMA, GPDMA_PRIO_T prio,
+							  GPDMA_CALLBACK_T callback, void *pUserData);
+
+/**
+ * @brief	Stop a reserved GPDMA channel and make it free again
+ * @param	pGPDMA		: The base of GPDMA on the chip
+ * @param	ChannelNum	: Channel from Chip_GPDMA_ReserveChannel()
+ * @return	Nothing
+ */
+void Chip_GPDMA_ReleaseChannel(LPC_GPDMA_T *pGPDMA, uint8_t ChannelNum);
+
+/**
+ * @brief	GPDMA interrupt dispatcher
+ * @param	pGPDMA	: The base of GPDMA on the chip
+ * @return	Nothing
+ * @note	Call this from DMA_IRQHandler(). It reads the terminal count
+ *			and error flags once, clears those of the channels that have a
+ *			callback, and calls the callbacks lowest channel first. The
+ *			cost follows the number of flags set, not the number of
+ *			channels. Channels without a callback keep their flags for the
+ *			code that polls them.
+ */
+void Chip_GPDMA_IRQHandler(LPC_GPDMA_T *pGPDMA);
+
+/**
+ * @brief	Take consecutive descriptors from the static descriptor pool
+ * @param	num	: Number of descriptors
+ * @return	The first descriptor, or NULL if there are not num free in a row
+ * @note	The pool holds GPDMA_DESC_POOL_SIZE descriptors. Use it from
+ *			one interrupt priority level, it has no locking.
+ */
+DMA_TransferDescriptor_t *Chip_GPDMA_AllocDescriptors(uint32_t num);
+
+/**
+ * @brief	Give descriptors back to the static descriptor pool
+ * @param	pDesc	: First descriptor, as returned by Chip_GPDMA_AllocDescriptors()
+ * @param	num		: Number of descriptors, as passed to Chip_GPDMA_AllocDescriptors()
+ * @return	ERROR if the descriptors are not all in the pool and taken, in
+ *			which case none are given back, SUCCESS otherwise
+ */
+Status Chip_GPDMA_FreeDescriptors(DMA_TransferDescriptor_t *pDesc, uint32_t num);
+
 /**
  * @}
  */
@@ -32,11 +32,22 @@
 #ifndef __RING_BUFFER_H_
 #define __RING_BUFFER_H_
 
+#include <string.h>
 #include "lpc_types.h"
 
 /** @defgroup Ring_Buffer CHIP: Simple ring buffer implementation
  * @ingroup CHIP_Common
  * @{
+ *
+ * A ring buffer can be shared by one producer and one consumer running in
+ * different contexts, an ISR and a task for example, without masking
+ * interrupts. The producer only uses RingBuffer_Insert(),
+ * RingBuffer_InsertMult() and RingBuffer_AcquireWrite()/CommitWrite(),
+ * the consumer only uses RingBuffer_Pop(), RingBuffer_PopMult() and
+ * RingBuffer_PeekRead()/ReleaseRead(). Each side writes only its own index
+ * (head for the producer, tail for the consumer) and publishes it after the
+ * item data with a barrier. RingBuffer_Init() and RingBuffer_Flush() change
+ * both indexes and must not run while either side is active.
  */
 
 /**
@@ -62,6 +73,27 @@ typedef struct {
  */
 #define RB_VTAIL(rb)              (*(volatile uint32_t *) &(rb)->tail)
 
+/**
+ * @def		RB_ACQUIRE()
+ * Barrier between reading the other side's index and accessing the items
+ * it covers
+ * @def		RB_RELEASE()
+ * Barrier between accessing items and publishing the own index
+ */
+#if defined(__GNUC__)
+#define RB_ACQUIRE()              __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define RB_RELEASE()              __atomic_thread_fence(__ATOMIC_RELEASE)
+#elif defined(__CC_ARM)
+#define RB_ACQUIRE()              __dmb(0xF)
+#define RB_RELEASE()              __dmb(0xF)
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+#define RB_ACQUIRE()              __DMB()
+#define RB_RELEASE()              __DMB()
+#else
+#error Ring buffer barriers are not defined for this compiler
+#endif
+
 /**
  * @brief	Initialize ring buffer
  * @param	RingBuff	: Pointer to ring buffer to initialize
@@ -180,6 +212,169 @@ int RingBuffer_Pop(RINGBUFF_T *RingBuff, void *data);
  */
 int RingBuffer_PopMult(RINGBUFF_T *RingBuff, void *data, int num);
 
+/**
+ * @brief	Get the free items at the head that are contiguous in memory
+ * @param	RingBuff	: Pointer to ring buffer
+ * @param	ppData		: Returns a pointer to the first free item
+ * @return	Number of contiguous free items at @a *ppData, 0 when full
+ * @note	Producer side. Fill up to the returned number of items in place,
+ *			a DMA transfer or an ISR for example, then make them visible
+ *			with RingBuffer_CommitWrite(). Free space that wraps around the
+ *			end of the buffer is returned by a second call after the commit.
+ */
+int RingBuffer_AcquireWrite(RINGBUFF_T *RingBuff, void **ppData);
+
+/**
+ * @brief	Make items filled in place visible to the consumer
+ * @param	RingBuff	: Pointer to ring buffer
+ * @param	num			: Number of items written, no more than
+ *						  RingBuffer_AcquireWrite() returned
+ * @return	Nothing
+ */
+STATIC INLINE void RingBuffer_CommitWrite(RINGBUFF_T *RingBuff, int num)
+{
+	RB_RELEASE();
+	RB_VHEAD(RingBuff) = RingBuff->head + num;
+}
+
+/**
+ * @brief	Get the items at the tail that are contiguous in memory
+ * @param	RingBuff	: Pointer to ring buffer
+ * @param	ppData		: Returns a pointer to the oldest item
+ * @return	Number of contiguous items at @a *ppData, 0 when empty
+ * @note	Consumer side. Use up to the returned number of items in place,
+ *			then free them with RingBuffer_ReleaseRead(). Items that wrap
+ *			around the end of the buffer are returned by a second call
+ *			after the release.
+ */
+int RingBuffer_PeekRead(RINGBUFF_T *RingBuff, void **ppData);
+
+/**
+ * @brief	Free items used in place
+ * @param	RingBuff	: Pointer to ring buffer
+ * @param	num			: Number of items used, no more than
+ *						  RingBuffer_PeekRead() returned
+ * @return	Nothing
+ */
+STATIC INLINE void RingBuffer_ReleaseRead(RINGBUFF_T *RingBuff, int num)
+{
+	RB_RELEASE();
+	RB_VTAIL(RingBuff) = RingBuff->tail + num;
+}
+
+/**
+ * @def		RINGBUF_DEFINE(name, type, size)
+ * Define a ring buffer type for items of @a type with room for @a size
+ * items, and its functions. @a size must be a power of 2 and at least 2,
+ * other sizes fail to compile. The item size and index mask are constants,
+ * so an insert or pop of a byte compiles to a byte store or load.
+ * RINGBUF_DEFINE(uart_rb, uint8_t, 256) defines:
+ * - uart_rb_T, the ring buffer, with the item storage inside it
+ * - void uart_rb_Init(uart_rb_T *rb) and void uart_rb_Flush(uart_rb_T *rb)
+ * - int uart_rb_Insert(uart_rb_T *rb, uint8_t item)
+ * - int uart_rb_Pop(uart_rb_T *rb, uint8_t *item)
+ * - int uart_rb_InsertMult(uart_rb_T *rb, const uint8_t *items, int num)
+ * - int uart_rb_PopMult(uart_rb_T *rb, uint8_t *items, int num)
+ * - int uart_rb_GetCount(uart_rb_T *rb), uart_rb_GetFree(),
+ *   uart_rb_IsEmpty() and uart_rb_IsFull()
+ * The return values and the producer/consumer rules are those of the
+ * RingBuffer_ functions of the same name.
+ */
+#define RINGBUF_DEFINE(name, type, size)									\
+	typedef char name##_size_must_be_a_power_of_2							\
+		[(((size) >= 2) && (((size) & ((size) - 1)) == 0)) ? 1 : -1];		\
+																			\
+	typedef struct {														\
+		type data[size];													\
+		uint32_t head;														\
+		uint32_t tail;														\
+	} name##_T;																\
+																			\
+	STATIC INLINE void name##_Init(name##_T *rb)							\
+	{																		\
+		rb->head = rb->tail = 0;											\
+	}																		\
+																			\
+	STATIC INLINE void name##_Flush(name##_T *rb)							\
+	{																		\
+		rb->head = rb->tail = 0;											\
+	}																		\
+																			\
+	STATIC INLINE int name##_GetCount(name##_T *rb)							\
+	{																		\
+		return RB_VHEAD(rb) - RB_VTAIL(rb);									\
+	}																		\
+																			\
+	STATIC INLINE int name##_GetFree(name##_T *rb)							\
+	{																		\
+		return (size) - name##_GetCount(rb);								\
+	}																		\
+																			\
+	STATIC INLINE int name##_IsEmpty(name##_T *rb)							\
+	{																		\
+		return RB_VHEAD(rb) == RB_VTAIL(rb);								\
+	}																		\
+																			\
+	STATIC INLINE int name##_IsFull(name##_T *rb)							\
+	{																		\
+		return name##_GetCount(rb) >= (size);								\
+	}																		\
+																			\
+	STATIC INLINE int name##_Insert(name##_T *rb, type item)				\
+	{																		\
+		if ((rb->head - RB_VTAIL(rb)) >= (uint32_t) (size))					\
+			return 0;														\
+		RB_ACQUIRE();														\
+		rb->data[rb->head & ((size) - 1)] = item;							\
+		RB_RELEASE();														\
+		RB_VHEAD(rb) = rb->head + 1;										\
+		return 1;															\
+	}																		\
+																			\
+	STATIC INLINE int name##_Pop(name##_T *rb, type *item)					\
+	{																		\
+		if (RB_VHEAD(rb) == rb->tail)										\
+			return 0;														\
+		RB_ACQUIRE();														\
+		*item = rb->data[rb->tail & ((size) - 1)];							\
+		RB_RELEASE();														\
+		RB_VTAIL(rb) = rb->tail + 1;										\
+		return 1;															\
+	}																		\
+																			\
+	STATIC INLINE int name##_InsertMult(name##_T *rb, const type *items, int num) \
+	{																		\
+		uint32_t ind = rb->head & ((size) - 1);								\
+		int cnt1, cnt2;														\
+																			\
+		if (num <= 0)														\
+			return 0;														\
+		cnt2 = MIN(num, (int) ((size) - (rb->head - RB_VTAIL(rb))));		\
+		RB_ACQUIRE();														\
+		cnt1 = MIN(cnt2, (int) ((size) - ind));								\
+		memcpy(&rb->data[ind], items, cnt1 * sizeof(type));				\
+		memcpy(&rb->data[0], items + cnt1, (cnt2 - cnt1) * sizeof(type));	\
+		RB_RELEASE();														\
+		RB_VHEAD(rb) = rb->head + cnt2;										\
+		return cnt2;														\
+	}																		\
+																			\
+	STATIC INLINE int name##_PopMult(name##_T *rb, type *items, int num)	\
+	{																		\
+		uint32_t ind = rb->tail & ((size) - 1);								\
+		int cnt1, cnt2;														\
+																			\
+		if (num <= 0)														\
+			return 0;														\
+		cnt2 = MIN(num, (int) (RB_VHEAD(rb) - rb->tail));					\
+		RB_ACQUIRE();														\
+		cnt1 = MIN(cnt2, (int) ((size) - ind));								\
+		memcpy(items, &rb->data[ind], cnt1 * sizeof(type));					\
+		memcpy(items + cnt1, &rb->data[0], (cnt2 - cnt1) * sizeof(type));	\
+		RB_RELEASE();														\
+		RB_VTAIL(rb) = rb->tail + cnt2;										\
+		return cnt2;														\
+	}
 
 /**
  * @}
@@ -0,0 +1,211 @@
+/*
+ * @brief Common SD/MMC card definitions
+ *
+ * @note
+ * Command numbers, response fields, card states and the card information
+ * structure from the SD and MMC specifications, shared by the SD card
+ * drivers of the LPC177x/8x and LPC40xx (sdmmc_17xx_40xx.h).  Nothing here
+ * touches a register.
+ */
+
+#ifndef __SDMMC_H_
+#define __SDMMC_H_
+
+#include "lpc_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup CHIP_SDMMC_Definitions CHIP: SD/MMC common definitions
+ * @ingroup CHIP_17XX_40XX_Drivers
+ * @{
+ */
+
+/** Sector size of the SD/MMC block commands */
+#define MMC_SECTOR_SIZE     512
+
+/*
+ * Card types in SDMMC_CARD_T card_type
+ */
+#define OCR_HC_CCS          (1 << 30)		/*!< Card capacity status in the OCR */
+#define CARD_TYPE_SD        (1 << 0)		/*!< SD card, MMC otherwise */
+#define CARD_TYPE_4BIT      (1 << 1)		/*!< 4 bit bus */
+#define CARD_TYPE_8BIT      (1 << 2)		/*!< 8 bit bus */
+#define CARD_TYPE_HC        (OCR_HC_CCS)	/*!< High capacity card, addressed by block */
+
+/*
+ * MMC command numbers, most of which SD cards share
+ */
+#define MMC_GO_IDLE_STATE           0		/*!< bc                          */
+#define MMC_SEND_OP_COND            1		/*!< bcr  [31:0]  OCR         R3 */
+#define MMC_ALL_SEND_CID            2		/*!< bcr                      R2 */
+#define MMC_SET_RELATIVE_ADDR       3		/*!< ac   [31:16] RCA         R1 */
+#define MMC_SET_DSR                 4		/*!< bc   [31:16] RCA            */
+#define MMC_SELECT_CARD             7		/*!< ac   [31:16] RCA         R1 */
+#define MMC_SEND_EXT_CSD            8		/*!< adtc [31:0]  0           R1 */
+#define MMC_SEND_CSD                9		/*!< ac   [31:16] RCA         R2 */
+#define MMC_SEND_CID                10		/*!< ac   [31:16] RCA         R2 */
+#define MMC_STOP_TRANSMISSION       12		/*!< ac                       R1b */
+#define MMC_SEND_STATUS             13		/*!< ac   [31:16] RCA         R1 */
+#define MMC_GO_INACTIVE_STATE       15		/*!< ac   [31:16] RCA            */
+#define MMC_SET_BLOCKLEN            16		/*!< ac   [31:0]  block len   R1 */
+#define MMC_READ_SINGLE_BLOCK       17		/*!< adtc [31:0]  data addr   R1 */
+#define MMC_READ_MULTIPLE_BLOCK     18		/*!< adtc [31:0]  data addr   R1 */
+#define MMC_WRITE_DAT_UNTIL_STOP    20		/*!< adtc [31:0]  data addr   R1 */
+#define MMC_SET_BLOCK_COUNT         23		/*!< adtc [31:0]  data addr   R1 */
+#define MMC_WRITE_BLOCK             24		/*!< adtc [31:0]  data addr   R1 */
+#define MMC_WRITE_MULTIPLE_BLOCK    25		/*!< adtc                     R1 */
+#define MMC_PROGRAM_CID             26		/*!< adtc                     R1 */
+#define MMC_PROGRAM_CSD             27		/*!< adtc                     R1 */
+#define MMC_SET_WRITE_PROT          28		/*!< ac   [31:0]  data addr   R1b */
+#define MMC_CLR_WRITE_PROT          29		/*!< ac   [31:0]  data addr   R1b */
+#define MMC_SEND_WRITE_PROT         30		/*!< adtc [31:0]  wpdata addr R1 */
+#define MMC_ERASE_GROUP_START       35		/*!< ac   [31:0]  data addr   R1 */
+#define MMC_ERASE_GROUP_END         36		/*!< ac   [31:0]  data addr   R1 */
+#define MMC_ERASE                   38		/*!< ac                       R1b */
+#define MMC_APP_CMD                 55		/*!< ac   [31:16] RCA         R1 */
+#define MMC_GEN_CMD                 56		/*!< adtc [0]     RD/WR       R1 */
+
+/*
+ * SD command numbers, ACMD for the application commands after MMC_APP_CMD
+ */
+#define SD_SEND_RELATIVE_ADDR       3		/*!< bcr                      R6 */
+#define SD_CMD8                     8		/*!< bcr  [11:0]  SEND_IF_COND R7 */
+#define SD_ERASE_WR_BLK_START       32		/*!< ac   [31:0]  data addr   R1 */
+#define SD_ERASE_WR_BLK_END         33		/*!< ac   [31:0]  data addr   R1 */
+#define SD_ERASE                    38		/*!< ac                       R1b */
+#define SD_APP_SET_BUS_WIDTH        6		/*!< ACMD ac [1:0] bus width  R1 */
+#define SD_APP_SEND_STATUS          13		/*!< ACMD adtc                R1 */
+#define SD_APP_OP_COND              41		/*!< ACMD bcr [31:0] OCR      R3 */
+#define SD_APP_SEND_SCR             51		/*!< ACMD adtc                R1 */
+
+/*
+ * Command arguments
+ */
+#define CMD3_RCA(n)         (((uint32_t) (n) & 0xFFFF) << 16)
+#define CMD7_RCA(n)         (((uint32_t) (n) & 0xFFFF) << 16)
+#define CMD9_RCA(n)         (((uint32_t) (n) & 0xFFFF) << 16)
+#define CMD13_RCA(n)        (((uint32_t) (n) & 0xFFFF) << 16)
+#define CMD55_RCA(n)        (((uint32_t) (n) & 0xFFFF) << 16)
+
+#define CMD8_VOLTAGESUPPLIED_27_36  (1 << 8)	/*!< SEND_IF_COND: host supplies 2.7-3.6 V */
+#define CMD8_CHECKPATTERN(n)        ((n) & 0xFF)
+#define CMD8_DEF_PATTERN            0xAA
+
+#define ACMD41_OCR(n)       ((n) & 0xFFFFFF)	/*!< SD_SEND_OP_COND: voltage window */
+#define ACMD41_HCS          (1 << 30)		/*!< SD_SEND_OP_COND: host supports high capacity */
+
+#define ACMD6_BUS_WIDTH(n)  ((n) & 0x03)		/*!< SET_BUS_WIDTH argument */
+#define ACMD6_BUS_WIDTH_1   0
+#define ACMD6_BUS_WIDTH_4   2
+
+/*
+ * OCR bits
+ */
+#define SDC_OCR_27_36       ((uint32_t) 0x00FF8000)	/*!< 2.7 to 3.6 V */
+#define SDC_OCR_IDLE        ((uint32_t) 1 << 31)	/*!< Power up done, the card is not busy */
+
+/*
+ * Responses
+ */
+#define CMDRESP_R3_INIT_COMPLETE    ((uint32_t) 1 << 31)	/*!< OCR busy bit, set once initialized */
+#define CMDRESP_R3_HC_CCS           (1 << 30)				/*!< Card capacity status */
+#define CMDRESP_R3_OCR_VAL(n)       ((n) & 0xFFFFFF)
+
+#define CMDRESP_R6_RCA_VAL(n)       ((uint16_t) (((n) >> 16) & 0xFFFF))
+/** R6 carries status bits 23, 22, 19 and 12:0 in its bits 15:0 */
+#define CMDRESP_R6_CARD_STATUS(n)   ((((n) & 0x8000) << 8) | (((n) & 0x4000) << 8) | \
+									 (((n) & 0x2000) << 6) | ((n) & 0x1FFF))
+
+#define CMDRESP_R7_VOLTAGE_ACCEPTED (1 << 8)
+#define CMDRESP_R7_CHECK_PATTERN(n) ((n) & 0xFF)
+
+/*
+ * Card status (R1)
+ */
+#define R1_OUT_OF_RANGE             ((uint32_t) 1 << 31)	/*!< er, c */
+#define R1_ADDRESS_ERROR            (1 << 30)	/*!< erx, c */
+#define R1_BLOCK_LEN_ERROR          (1 << 29)	/*!< er, c */
+#define R1_ERASE_SEQ_ERROR          (1 << 28)	/*!< er, c */
+#define R1_ERASE_PARAM              (1 << 27)	/*!< ex, c */
+#define R1_WP_VIOLATION             (1 << 26)	/*!< erx, c */
+#define R1_CARD_IS_LOCKED           (1 << 25)	/*!< sx, a */
+#define R1_LOCK_UNLOCK_FAILED       (1 << 24)	/*!< erx, c */
+#define R1_COM_CRC_ERROR            (1 << 23)	/*!< er, b */
+#define R1_ILLEGAL_COMMAND          (1 << 22)	/*!< er, b */
+#define R1_CARD_ECC_FAILED          (1 << 21)	/*!< ex, c */
+#define R1_CC_ERROR                 (1 << 20)	/*!< erx, c */
+#define R1_ERROR                    (1 << 19)	/*!< erx, c */
+#define R1_UNDERRUN                 (1 << 18)	/*!< ex, c */
+#define R1_OVERRUN                  (1 << 17)	/*!< ex, c */
+#define R1_CID_CSD_OVERWRITE        (1 << 16)	/*!< erx, c, CID/CSD overwrite */
+#define R1_WP_ERASE_SKIP            (1 << 15)	/*!< sx, c */
+#define R1_CARD_ECC_DISABLED        (1 << 14)	/*!< sx, a */
+#define R1_ERASE_RESET              (1 << 13)	/*!< sr, c */
+#define R1_CURRENT_STATE(n)         (((n) & 0x00001E00) >> 9)	/*!< sx, b (4 bits) */
+#define R1_READY_FOR_DATA           (1 << 8)	/*!< sx, a */
+#define R1_APP_CMD                  (1 << 5)	/*!< sr, c */
+#define R1_STATUS(n)                ((n) & 0xFFFFE000)	/*!< Error and warning bits */
+
+/**
+ * @brief Card states, as R1_CURRENT_STATE() gives them
+ */
+typedef enum {
+	SDMMC_IDLE_ST = 0,	/*!< Idle state */
+	SDMMC_READY_ST,		/*!< Ready state */
+	SDMMC_IDENT_ST,		/*!< Identification State */
+	SDMMC_STBY_ST,		/*!< standby state */
+	SDMMC_TRAN_ST,		/*!< transfer state */
+	SDMMC_DATA_ST,		/*!< Sending-data State */
+	SDMMC_RCV_ST,		/*!< Receive-data State */
+	SDMMC_PRG_ST,		/*!< Programming State */
+	SDMMC_DIS_ST		/*!< Disconnect State */
+} SDMMC_STATE_T;
+
+/**
+ * @brief	Set up the wait for the end of a data transfer
+ * @param	pEvent	: Driver event, SDMMC_EVENT_T of sdmmc_17xx_40xx.h
+ * @return	Nothing
+ */
+typedef void (*SDMMC_EVSETUP_FUNC_T)(void *pEvent);
+
+/**
+ * @brief	Wait for the end of the data transfer set up by SDMMC_EVSETUP_FUNC_T
+ * @return	0 when the transfer ended, anything else on an error
+ */
+typedef uint32_t (*SDMMC_EVWAIT_FUNC_T)(void);
+
+/**
+ * @brief	Wait a number of milliseconds
+ * @param	time	: Number of milliseconds
+ * @return	Nothing
+ */
+typedef void (*SDMMC_MSDELAY_FUNC_T)(uint32_t time);
+
+/**
+ * @brief Card information, filled by Chip_SDMMC_Acquire()
+ */
+typedef struct {
+	uint32_t cid[4];		/*!< CID of acquired card */
+	uint32_t csd[4];		/*!< CSD of acquired card */
+	uint32_t card_type;		/*!< CARD_TYPE_* bits */
+	uint16_t rca;			/*!< Relative address assigned to card */
+	uint32_t speed;			/*!< Card bus clock rate in Hz */
+	uint32_t block_len;		/*!< Card sector size */
+	uint32_t device_size;	/*!< Device size in bytes */
+	uint32_t blocknr;		/*!< Number of 512 byte blocks */
+	SDMMC_EVSETUP_FUNC_T evsetup_cb;	/*!< Set up the wait for a transfer */
+	SDMMC_EVWAIT_FUNC_T waitfunc_cb;	/*!< Wait for the transfer */
+	SDMMC_MSDELAY_FUNC_T msdelay_func;	/*!< Millisecond delay */
+} SDMMC_CARD_T;
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SDMMC_H_ */
@@ -122,6 +122,11 @@ typedef struct {
  * @return	Positive value: Data transfer
  *          Negative value: Error in data transfer
  *          Zero: Data transfer completed
+ * @note	Must be called for every SDC interrupt during a block transfer.
+ *			When a segment of SDMMC_MAX_BLK (127) blocks ends and more
+ *			blocks are left, it starts the next segment without waking the
+ *			waiting task: the data path is re-armed under the same CMD25, and
+ *			a read is stopped with CMD12 and goes on with a new CMD18.
  */
 int32_t Chip_SDMMC_IRQHandler (LPC_SDC_T *pSDC, uint8_t *txBuf, uint32_t *txCnt,
 							   uint8_t *rxBuf, uint32_t *rxCnt);
@@ -167,6 +172,11 @@ int32_t Chip_SDMMC_GetSDStatus(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, uint32_
  * @param	startblock	: Start block number
  * @param	blockNum	: Number of block to read
  * @return	Bytes read, or 0 on error
+ * @note	All the blocks are read by one open-ended command, ended by
+ *			CMD12, with the DMA descriptor of the next segment queued while
+ *			the current one runs. waitfunc_cb is called once per call. The
+ *			card is known to be in tran state after a successful transfer,
+ *			so the next call does not ask for it again.
  */
 int32_t Chip_SDMMC_ReadBlocks(LPC_SDC_T *pSDC,
 							  SDMMC_CARD_T *pCardInfo,
@@ -182,6 +192,9 @@ int32_t Chip_SDMMC_ReadBlocks(LPC_SDC_T *pSDC,
  * @param	startblock	: Start block number
  * @param	blockNum	: Number of block to write
  * @return	Number of bytes actually written, or 0 on error
+ * @note	All the blocks are written by one CMD25 (CMD24 for one block),
+ *			segments of SDMMC_MAX_BLK blocks are chained from
+ *			Chip_SDMMC_IRQHandler(). waitfunc_cb is called once per call.
  */
 int32_t Chip_SDMMC_WriteBlocks(LPC_SDC_T *pSDC,
 							   SDMMC_CARD_T *pCardInfo,
@@ -587,6 +587,130 @@ void Chip_SSP_SetMaster(LPC_SSP_T *pSSP, bool master);
  */
 void Chip_SSP_SetBitRate(LPC_SSP_T *pSSP, uint32_t bitRate);
 
+/** Number of linked list items per direction of an SSP DMA transaction */
+#define SSP_DMA_MAX_DESC        4
+
+/** Maximum number of frames in one SSP DMA transaction */
+#define SSP_DMA_MAX_FRAMES      (SSP_DMA_MAX_DESC * 0xFFF)
+
+/** SPI_Address_t port value for a transaction without a chip-select pin */
+#define SSP_DMA_NO_CS           0xFF
+
+/**
+ * @brief	SSP DMA context, see Chip_SSP_DMA_Init()
+ */
+typedef struct SSP_DMA_CTX SSP_DMA_CTX_T;
+
+/**
+ * @brief	SSP DMA transaction, see Chip_SSP_DMA_Queue()
+ */
+typedef struct SSP_DMA_XFER SSP_DMA_XFER_T;
+
+/**
+ * @brief	SSP DMA transaction done callback
+ * @param	pDMA	: SSP DMA context that ran the transaction
+ * @param	pXfer	: Finished transaction, with its status set
+ * @return	Nothing
+ * @note	Called from Chip_SSP_DMA_IRQHandler(), after the next queued
+ *			transaction has been started. The transaction and its buffers
+ *			are free again and may be queued from here.
+ */
+typedef void (*SSP_DMA_XFERCB_T)(SSP_DMA_CTX_T *pDMA, SSP_DMA_XFER_T *pXfer);
+
+/**
+ * @brief	SSP DMA transaction
+ */
+struct SSP_DMA_XFER {
+	const void *tx_data;		/*!< Frames to send, or NULL to send all ones */
+	void *rx_data;				/*!< Buffer for the received frames, or NULL to drop them */
+	uint32_t length;			/*!< Number of frames */
+	SPI_Address_t cs;			/*!< Active low chip-select GPIO, port SSP_DMA_NO_CS for none */
+	SSP_DMA_XFERCB_T done;		/*!< Done callback, or NULL */
+	void *pUserData;			/*!< Free for the application */
+	volatile Status status;		/*!< SUCCESS once done, ERROR after a DMA error or a failed start */
+	SSP_DMA_XFER_T *pNext;		/*!< Queue link, used by the driver */
+};
+
+/**
+ * @brief	SSP DMA context
+ */
+struct SSP_DMA_CTX {
+	LPC_SSP_T *pSSP;								/*!< SSP peripheral */
+	LPC_GPDMA_T *pGPDMA;							/*!< GPDMA controller */
+	uint8_t txChannel;								/*!< GPDMA channel for transmit */
+	uint8_t rxChannel;								/*!< GPDMA channel for receive */
+	SSP_DMA_XFER_T *pHead;							/*!< Running transaction, NULL when idle */
+	SSP_DMA_XFER_T *pTail;							/*!< Last queued transaction */
+	uint32_t txFill;								/*!< Frame sent for a NULL tx_data */
+	uint32_t rxDrop;								/*!< Target for the frames of a NULL rx_data */
+	DMA_TransferDescriptor_t txDesc[SSP_DMA_MAX_DESC];	/*!< Transmit linked list */
+	DMA_TransferDescriptor_t rxDesc[SSP_DMA_MAX_DESC];	/*!< Receive linked list */
+};
+
+/**
+ * @brief	Set up GPDMA transfers on an SSP
+ * @param	pDMA	: SSP DMA context to set up
+ * @param	pSSP	: The base SSP peripheral on the chip
+ * @param	pGPDMA	: The base of GPDMA on the chip
+ * @return	ERROR if two GPDMA channels are not free, SUCCESS otherwise
+ * @note	The SSP must be set up as master, with its format and bit rate,
+ *			and enabled, and the GPDMA initialized with Chip_GPDMA_Init().
+ *			This takes two GPDMA channels and turns on the SSP DMA
+ *			requests. DMA_IRQn must be enabled for transactions to finish,
+ *			Chip_SSP_DMA_Queue() masks it for a moment and leaves it as it
+ *			found it. The frame size must not change while transactions
+ *			run. The context must stay valid until Chip_SSP_DMA_DeInit(),
+ *			the DMA reads its descriptors.
+ */
+Status Chip_SSP_DMA_Init(SSP_DMA_CTX_T *pDMA, LPC_SSP_T *pSSP, LPC_GPDMA_T *pGPDMA);
+
+/**
+ * @brief	Stop GPDMA transfers on an SSP
+ * @param	pDMA	: SSP DMA context
+ * @return	Nothing
+ * @note	A running transaction is cut off, it and the queued ones are
+ *			dropped without a callback.
+ */
+void Chip_SSP_DMA_DeInit(SSP_DMA_CTX_T *pDMA);
+
+/**
+ * @brief	Queue an SSP transaction (non-blocking)
+ * @param	pDMA	: SSP DMA context
+ * @param	pXfer	: Transaction to queue
+ * @return	ERROR if the length is 0 or above SSP_DMA_MAX_FRAMES, or if the
+ *			queue was empty and the GPDMA channels do not start, SUCCESS
+ *			otherwise
+ * @note	Transactions run in queue order. For each one the driver pulls
+ *			the chip-select low, the DMA moves all frames both ways without
+ *			the CPU, and at the end of the last received frame the
+ *			interrupt releases the chip-select, starts the next transaction
+ *			and calls done. A queued transaction whose channels do not
+ *			start is done at once with status ERROR. Frames above 8 bits are read and written as
+ *			uint16_t. The transaction and its buffers must stay untouched
+ *			until it is done. May be called from an interrupt, including
+ *			from a done callback.
+ */
+Status Chip_SSP_DMA_Queue(SSP_DMA_CTX_T *pDMA, SSP_DMA_XFER_T *pXfer);
+
+/**
+ * @brief	Check whether SSP DMA transactions are running or queued
+ * @param	pDMA	: SSP DMA context
+ * @return	true while a transaction runs
+ */
+STATIC INLINE bool Chip_SSP_DMA_Busy(SSP_DMA_CTX_T *pDMA)
+{
+	return *(SSP_DMA_XFER_T * volatile *) &pDMA->pHead != NULL;
+}
+
+/**
+ * @brief	GPDMA interrupt handler for an SSP DMA context
+ * @param	pDMA	: SSP DMA context
+ * @return	Nothing
+ * @note	Call this from DMA_IRQHandler(). It handles the interrupts of
+ *			the two channels of this context only.
+ */
+void Chip_SSP_DMA_IRQHandler(SSP_DMA_CTX_T *pDMA);
+
 /**
  * @}
  */
@@ -30,7 +30,10 @@
 #ifndef __SYS_CONFIG_H_
 #define __SYS_CONFIG_H_
 
-/* Build for 175x/6x chip family */
+/* Build for 175x/6x chip family, unless the build names another one (the
+   host tests of the SD card drivers build for the 177x/8x) */
+#if !defined(CHIP_LPC177X_8X) && !defined(CHIP_LPC40XX)
 #define CHIP_LPC175X_6X
+#endif
 
 #endif /* __SYS_CONFIG_H_ */
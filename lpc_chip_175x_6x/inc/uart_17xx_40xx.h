@@ -803,6 +803,135 @@ FlagStatus Chip_UART_GetABEOStatus(LPC_USART_T *pUART);
 void Chip_UART_ABCmd(LPC_USART_T *pUART, uint32_t mode, bool autorestart, 
         FunctionalState NewState);
 
+/**
+ * @brief	UART DMA context, see Chip_UART_DMA_Init()
+ */
+typedef struct UART_DMA UART_DMA_T;
+
+/**
+ * @brief	UART DMA receive callback
+ * @param	pDMA	: UART DMA context the bytes were received on
+ * @param	data	: Received bytes, in the receive buffer
+ * @param	len		: Number of bytes
+ * @return	Nothing
+ * @note	Called from Chip_UART_DMA_IRQHandler() and Chip_UART_DMA_RxTimeout().
+ *			The bytes are overwritten once the DMA gets back to them, half a
+ *			receive buffer after the end of the data.
+ */
+typedef void (*UART_DMA_RXCB_T)(UART_DMA_T *pDMA, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief	UART DMA transmit done callback
+ * @param	pDMA	: UART DMA context whose transmit buffer has been sent
+ * @return	Nothing
+ * @note	Called from Chip_UART_DMA_IRQHandler() once the DMA has moved the
+ *			last byte into the transmit FIFO. The caller's buffer is free
+ *			again and Chip_UART_DMA_Send() may be called from here.
+ */
+typedef void (*UART_DMA_TXCB_T)(UART_DMA_T *pDMA);
+
+/**
+ * @brief	UART DMA context
+ */
+struct UART_DMA {
+	LPC_USART_T *pUART;					/*!< UART peripheral */
+	LPC_GPDMA_T *pGPDMA;				/*!< GPDMA controller */
+	uint8_t txChannel;					/*!< GPDMA channel for transmit */
+	uint8_t rxChannel;					/*!< GPDMA channel for receive */
+	uint8_t txConn;						/*!< GPDMA_CONN_UARTn_Tx */
+	uint8_t rxConn;						/*!< GPDMA_CONN_UARTn_Rx */
+	uint8_t *rxBuf;						/*!< Receive buffer, filled one half after the other */
+	uint32_t rxSize;					/*!< Size of the receive buffer */
+	uint32_t rxTail;					/*!< Offset of the first byte not passed to rxDone */
+	uint32_t rxLastPos;					/*!< DMA write offset at the last Chip_UART_DMA_RxTimeout() */
+	DMA_TransferDescriptor_t rxDesc[2];	/*!< Circular descriptor list, one per half */
+	const uint8_t *txData;				/*!< Next bytes to transmit */
+	uint32_t txLeft;					/*!< Bytes left to transmit, including the running transfer */
+	volatile bool txBusy;				/*!< Transmit running */
+	UART_DMA_RXCB_T rxDone;				/*!< Receive callback */
+	UART_DMA_TXCB_T txDone;				/*!< Transmit done callback, or NULL */
+	void *pUserData;					/*!< Free for the application */
+};
+
+/**
+ * @brief	Start DMA transmit and receive on a UART
+ * @param	pDMA	: UART DMA context to set up
+ * @param	pUART	: Pointer to selected UART peripheral
+ * @param	pGPDMA	: The base of GPDMA on the chip
+ * @param	rxBuf	: Receive buffer
+ * @param	rxSize	: Size of the receive buffer, even and at most 8190 bytes
+ * @param	rxDone	: Receive callback
+ * @param	txDone	: Transmit done callback, or NULL
+ * @return	ERROR on bad parameters or when a channel can not be started,
+ *			SUCCESS otherwise
+ * @note	The UART must be initialized with its baud rate and line format
+ *			set, and the GPDMA with Chip_GPDMA_Init(). This function
+ *			takes two GPDMA channels, switches the UART FIFOs to DMA mode
+ *			and starts receiving into rxBuf for good, one half after the
+ *			other. A finished half is passed to rxDone from the DMA
+ *			interrupt. Bytes of a half that has not filled up are passed on
+ *			by Chip_UART_DMA_RxTimeout() once the line goes quiet. Size
+ *			rxBuf so that rxDone is always done with one half before the
+ *			other half fills up. The context must stay valid until
+ *			Chip_UART_DMA_DeInit(), the DMA reads its descriptors.
+ */
+Status Chip_UART_DMA_Init(UART_DMA_T *pDMA, LPC_USART_T *pUART, LPC_GPDMA_T *pGPDMA,
+						  uint8_t *rxBuf, uint32_t rxSize,
+						  UART_DMA_RXCB_T rxDone, UART_DMA_TXCB_T txDone);
+
+/**
+ * @brief	Stop DMA transmit and receive on a UART
+ * @param	pDMA	: UART DMA context
+ * @return	Nothing
+ * @note	Received bytes not yet passed to rxDone are dropped.
+ */
+void Chip_UART_DMA_DeInit(UART_DMA_T *pDMA);
+
+/**
+ * @brief	Transmit a buffer through the UART with DMA (non-blocking)
+ * @param	pDMA	: UART DMA context
+ * @param	data	: Bytes to transmit
+ * @param	bytes	: Number of bytes to transmit
+ * @return	ERROR if a transmit is still running or bytes is 0, SUCCESS otherwise
+ * @note	The DMA reads the bytes straight from data, so the buffer must
+ *			not change until Chip_UART_DMA_TxBusy() returns false or txDone
+ *			has been called.
+ */
+Status Chip_UART_DMA_Send(UART_DMA_T *pDMA, const void *data, uint32_t bytes);
+
+/**
+ * @brief	Check whether a DMA transmit is running
+ * @param	pDMA	: UART DMA context
+ * @return	true while the last buffer given to Chip_UART_DMA_Send() is in use
+ */
+STATIC INLINE bool Chip_UART_DMA_TxBusy(UART_DMA_T *pDMA)
+{
+	return pDMA->txBusy;
+}
+
+/**
+ * @brief	GPDMA interrupt handler for a UART DMA context
+ * @param	pDMA	: UART DMA context
+ * @return	Nothing
+ * @note	Call this from DMA_IRQHandler(). It handles the interrupts of
+ *			the two channels of this context only.
+ */
+void Chip_UART_DMA_IRQHandler(UART_DMA_T *pDMA);
+
+/**
+ * @brief	Pass on received bytes once the receive line is idle
+ * @param	pDMA	: UART DMA context
+ * @return	Nothing
+ * @note	Call this periodically, from a timer interrupt for example. When
+ *			no byte has arrived since the previous call, the bytes of the
+ *			half that is still filling are passed to rxDone. The period is
+ *			the idle time after which a short message is delivered, a few
+ *			character times is typical. Call it at the same interrupt
+ *			priority as Chip_UART_DMA_IRQHandler(), they must not preempt
+ *			each other.
+ */
+void Chip_UART_DMA_RxTimeout(UART_DMA_T *pDMA);
+
 /**
  * @}
  */
@@ -343,6 +343,207 @@ STATIC int32_t searchInsertIndex(uint32_t *arr, uint32_t arrNum, uint32_t val, u
 	return UpperIndex;
 }
 
+/* LUT order of a standard ID entry, the controller number is compared first */
+STATIC INLINE uint32_t getSTDSortKey(const CAN_STD_ID_ENTRY_T *pEntry)
+{
+	return ((pEntry->CtrlNo & CAN_STD_ENTRY_CTRL_NO_MASK) << 11) | (pEntry->ID_11 & CAN_STD_ENTRY_ID_MASK);
+}
+
+/* LUT order of an extended ID entry, the controller number is compared first */
+STATIC INLINE uint32_t getEXTSortKey(const CAN_EXT_ID_ENTRY_T *pEntry)
+{
+	return ((pEntry->CtrlNo & CAN_EXT_ENTRY_CTRL_NO_MASK) << CAN_EXT_ENTRY_CTRL_NO_POS) |
+		   (pEntry->ID_29 & CAN_EXT_ENTRY_ID_MASK);
+}
+
+/* Get the sort keys of an entry of the given section, ranges sort on the lower bound first.
+   Repeated standard IDs sort enabled first, so that uniqueSection() keeps the enabled one. */
+STATIC INLINE void getSortKeys(const void *pEntry, CANAF_RAM_SECTION_T SectionID, uint32_t *pKey, uint32_t *pKey2)
+{
+	switch (SectionID) {
+	case CANAF_RAM_FULLCAN_SEC:
+	case CANAF_RAM_SFF_SEC:
+		*pKey = getSTDSortKey((const CAN_STD_ID_ENTRY_T *) pEntry);
+		*pKey2 = ((const CAN_STD_ID_ENTRY_T *) pEntry)->Disable & CAN_STD_ENTRY_DISABLE_MASK;
+		break;
+
+	case CANAF_RAM_SFF_GRP_SEC:
+		*pKey = getSTDSortKey(&((const CAN_STD_ID_RANGE_ENTRY_T *) pEntry)->LowerID);
+		*pKey2 = getSTDSortKey(&((const CAN_STD_ID_RANGE_ENTRY_T *) pEntry)->UpperID);
+		break;
+
+	case CANAF_RAM_EFF_SEC:
+		*pKey = getEXTSortKey((const CAN_EXT_ID_ENTRY_T *) pEntry);
+		*pKey2 = 0;
+		break;
+
+	default:
+		*pKey = getEXTSortKey(&((const CAN_EXT_ID_RANGE_ENTRY_T *) pEntry)->LowerID);
+		*pKey2 = getEXTSortKey(&((const CAN_EXT_ID_RANGE_ENTRY_T *) pEntry)->UpperID);
+		break;
+	}
+}
+
+/* Compare two entries of a section, returns <0, 0 or >0 */
+STATIC INLINE int32_t compareEntry(const uint8_t *pA, const uint8_t *pB, CANAF_RAM_SECTION_T SectionID)
+{
+	uint32_t KeyA, KeyA2, KeyB, KeyB2;
+
+	getSortKeys(pA, SectionID, &KeyA, &KeyA2);
+	getSortKeys(pB, SectionID, &KeyB, &KeyB2);
+	if (KeyA != KeyB) {
+		return (KeyA < KeyB) ? -1 : 1;
+	}
+	if (KeyA2 != KeyB2) {
+		return (KeyA2 < KeyB2) ? -1 : 1;
+	}
+	return 0;
+}
+
+/* Swap two entries, all entry types are a multiple of 4 bytes */
+STATIC INLINE void swapEntry(uint8_t *pA, uint8_t *pB, uint32_t size)
+{
+	uint32_t *pWordA = (uint32_t *) pA, *pWordB = (uint32_t *) pB;
+	uint32_t tmp;
+
+	for (size /= 4; size > 0; size--) {
+		tmp = *pWordA;
+		*pWordA++ = *pWordB;
+		*pWordB++ = tmp;
+	}
+}
+
+/* Sift an entry down the heap of a heapsort */
+STATIC void siftEntry(uint8_t *arr, uint32_t root, uint32_t num, uint32_t size, CANAF_RAM_SECTION_T SectionID)
+{
+	uint32_t child;
+
+	while ((child = 2 * root + 1) < num) {
+		if (((child + 1) < num) &&
+			(compareEntry(&arr[child * size], &arr[(child + 1) * size], SectionID) < 0)) {
+			child++;
+		}
+		if (compareEntry(&arr[root * size], &arr[child * size], SectionID) >= 0) {
+			return;
+		}
+		swapEntry(&arr[root * size], &arr[child * size], size);
+		root = child;
+	}
+}
+
+/* Sort the entries of a section in place in LUT order, O(n log n) without extra memory */
+STATIC void sortSection(void *pSec, uint16_t EntryNum, uint32_t size, CANAF_RAM_SECTION_T SectionID)
+{
+	uint8_t *arr = (uint8_t *) pSec;
+	uint32_t i;
+
+	if (EntryNum < 2) {
+		return;
+	}
+	for (i = EntryNum / 2; i > 0; i--) {
+		siftEntry(arr, i - 1, EntryNum, size, SectionID);
+	}
+	for (i = EntryNum - 1; i > 0; i--) {
+		swapEntry(&arr[0], &arr[i * size], size);
+		siftEntry(arr, 0, i, size, SectionID);
+	}
+}
+
+/* Drop repeated IDs of a sorted individual ID section, keeping the first (enabled) entry of each,
+   returns the new number of entries */
+STATIC uint16_t uniqueSection(void *pSec, uint16_t EntryNum, uint32_t size, CANAF_RAM_SECTION_T SectionID)
+{
+	uint8_t *arr = (uint8_t *) pSec;
+	uint16_t i, Cnt = 0;
+	uint32_t Key, LastKey = 0, Key2;
+
+	for (i = 0; i < EntryNum; i++) {
+		getSortKeys(&arr[i * size], SectionID, &Key, &Key2);
+		if ((Cnt == 0) || (Key != LastKey)) {
+			LastKey = Key;
+			if (Cnt != i) {
+				memcpy(&arr[Cnt * size], &arr[i * size], size);
+			}
+			Cnt++;
+		}
+	}
+	return Cnt;
+}
+
+/* Merge overlapping and adjacent ranges of a sorted Group Standard ID section. Only ranges
+   with the same Disable bits are merged, so a disabled range never turns IDs of an enabled
+   one off, or the other way round. */
+STATIC uint16_t mergeSTDRanges(CAN_STD_ID_RANGE_ENTRY_T *pSec, uint16_t EntryNum)
+{
+	uint16_t i, Cnt = 0;
+
+	for (i = 0; i < EntryNum; i++) {
+		if ((Cnt > 0) && (pSec[i].LowerID.CtrlNo == pSec[Cnt - 1].UpperID.CtrlNo) &&
+			(pSec[i].LowerID.Disable == pSec[Cnt - 1].LowerID.Disable) &&
+			(pSec[i].UpperID.Disable == pSec[Cnt - 1].UpperID.Disable) &&
+			((getSTDSortKey(&pSec[i].LowerID) <= getSTDSortKey(&pSec[Cnt - 1].UpperID)) ||
+			 (getSTDSortKey(&pSec[i].LowerID) == getSTDSortKey(&pSec[Cnt - 1].UpperID) + 1))) {
+			if (getSTDSortKey(&pSec[i].UpperID) > getSTDSortKey(&pSec[Cnt - 1].UpperID)) {
+				pSec[Cnt - 1].UpperID = pSec[i].UpperID;
+			}
+		}
+		else {
+			pSec[Cnt++] = pSec[i];
+		}
+	}
+	return Cnt;
+}
+
+/* Merge overlapping and adjacent ranges of a sorted Group Extended ID section */
+STATIC uint16_t mergeEXTRanges(CAN_EXT_ID_RANGE_ENTRY_T *pSec, uint16_t EntryNum)
+{
+	uint16_t i, Cnt = 0;
+
+	for (i = 0; i < EntryNum; i++) {
+		if ((Cnt > 0) && (pSec[i].LowerID.CtrlNo == pSec[Cnt - 1].UpperID.CtrlNo) &&
+			((getEXTSortKey(&pSec[i].LowerID) <= getEXTSortKey(&pSec[Cnt - 1].UpperID)) ||
+			 (getEXTSortKey(&pSec[i].LowerID) == getEXTSortKey(&pSec[Cnt - 1].UpperID) + 1))) {
+			if (getEXTSortKey(&pSec[i].UpperID) > getEXTSortKey(&pSec[Cnt - 1].UpperID)) {
+				pSec[Cnt - 1].UpperID = pSec[i].UpperID;
+			}
+		}
+		else {
+			pSec[Cnt++] = pSec[i];
+		}
+	}
+	return Cnt;
+}
+
+/* Write sorted standard ID entries, two per row, returns the next row */
+STATIC uint16_t writeSTDRows(LPC_CANAF_RAM_T *pCANAFRam, uint16_t Row,
+							 CAN_STD_ID_ENTRY_T *pSec, uint16_t EntryNum, bool IsFullCANEntry)
+{
+	uint16_t i;
+
+	for (i = 0; (i + 1) < EntryNum; i += 2) {
+		pCANAFRam->MASK[Row++] = ((uint32_t) createStdIDEntry(&pSec[i], IsFullCANEntry) << 16) |
+								 createStdIDEntry(&pSec[i + 1], IsFullCANEntry);
+	}
+	if (i < EntryNum) {
+		/* The unused entry takes the controller number of the last one to keep the order */
+		pCANAFRam->MASK[Row++] = ((uint32_t) createStdIDEntry(&pSec[i], IsFullCANEntry) << 16) |
+								 createUnUsedSTDEntry(pSec[i].CtrlNo);
+	}
+	return Row;
+}
+
+/* Write sorted extended ID entries, one per row, returns the next row */
+STATIC uint16_t writeEXTRows(LPC_CANAF_RAM_T *pCANAFRam, uint16_t Row,
+							 CAN_EXT_ID_ENTRY_T *pSec, uint16_t EntryNum)
+{
+	uint16_t i;
+
+	for (i = 0; i < EntryNum; i++) {
+		pCANAFRam->MASK[Row++] = createExtIDEntry(&pSec[i]);
+	}
+	return Row;
+}
+
 /* Insert an entry into FullCAN Table */
 STATIC Status insertSTDEntry(LPC_CANAF_T *pCANAF,
 							 LPC_CANAF_RAM_T *pCANAFRam,
@@ -741,6 +942,180 @@ STATIC CHIP_SYSCTL_PCLK_T Chip_CAN_GetClkIndex(LPC_CAN_T *pCAN)
 
 #endif
 
+/* Bus arbitration order of a frame, lower wins: base ID, then RTR (or SRR),
+   IDE, the rest of an extended ID and its RTR */
+STATIC INLINE uint32_t getArbKey(const CAN_MSG_T *pMsg)
+{
+	uint32_t Rtr = (pMsg->Type & CAN_REMOTE_MSG) ? 1 : 0;
+
+	if (pMsg->ID & CAN_EXTEND_ID_USAGE) {
+		return (((pMsg->ID >> 18) & 0x7FF) << 21) | (3 << 19) | ((pMsg->ID & 0x3FFFF) << 1) | Rtr;
+	}
+	return ((pMsg->ID & 0x7FF) << 21) | (Rtr << 20);
+}
+
+/* True if frame A goes out before frame B, by ID then by queueing order */
+STATIC INLINE bool isTxBefore(const CAN_TX_ENTRY_T *pA, const CAN_TX_ENTRY_T *pB)
+{
+	uint32_t KeyA = getArbKey(&pA->Msg), KeyB = getArbKey(&pB->Msg);
+
+	return (KeyA < KeyB) || ((KeyA == KeyB) && ((int32_t) (pA->Seq - pB->Seq) < 0));
+}
+
+/* Add a frame to the transmit heap */
+STATIC void pushTxEntry(CAN_SERVICE_T *pSvc, const CAN_TX_ENTRY_T *pEntry)
+{
+	uint32_t i = pSvc->TxQueueNum++, Parent;
+
+	while (i > 0) {
+		Parent = (i - 1) / 2;
+		if (!isTxBefore(pEntry, &pSvc->TxQueue[Parent])) {
+			break;
+		}
+		pSvc->TxQueue[i] = pSvc->TxQueue[Parent];
+		i = Parent;
+	}
+	pSvc->TxQueue[i] = *pEntry;
+}
+
+/* Take the most urgent frame off the transmit heap */
+STATIC void popTxEntry(CAN_SERVICE_T *pSvc, CAN_TX_ENTRY_T *pEntry)
+{
+	CAN_TX_ENTRY_T *pQueue = pSvc->TxQueue;
+	uint32_t i = 0, Child, Last = --pSvc->TxQueueNum;
+
+	*pEntry = pQueue[0];
+
+	/* Sift the last entry down from the root */
+	for (Child = 1; Child < Last; Child = 2 * i + 1) {
+		if ((Child + 1 < Last) && isTxBefore(&pQueue[Child + 1], &pQueue[Child])) {
+			Child++;
+		}
+		if (!isTxBefore(&pQueue[Child], &pQueue[Last])) {
+			break;
+		}
+		pQueue[i] = pQueue[Child];
+		i = Child;
+	}
+	pQueue[i] = pQueue[Last];
+}
+
+/* Transmit buffers holding a frame with the same ID as the given one */
+STATIC uint8_t getSameIDBufs(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg)
+{
+	uint8_t Bufs = 0;
+	int n;
+
+	for (n = CAN_BUFFER_1; n < CAN_BUFFER_LAST; n++) {
+		if ((pSvc->TxBusy & (1 << n)) && (pSvc->TxBuf[n].Msg.ID == pMsg->ID)) {
+			Bufs |= 1 << n;
+		}
+	}
+	return Bufs;
+}
+
+/* Account for the frames the transmit buffers let go of and fill the free
+   buffers from the heap. Returns true if the queue got shorter. */
+STATIC bool serviceTx(CAN_SERVICE_T *pSvc)
+{
+	LPC_CAN_T *pCAN = pSvc->pCAN;
+	uint32_t Status, QueueNum = pSvc->TxQueueNum;
+	int n, Worst;
+
+	if (pSvc->TxBusy != 0) {
+		Status = Chip_CAN_GetStatus(pCAN);
+		for (n = CAN_BUFFER_1; n < CAN_BUFFER_LAST; n++) {
+			if ((pSvc->TxBusy & (1 << n)) && (Status & CAN_SR_TBS(n))) {
+				pSvc->TxBusy &= ~(1 << n);
+				pSvc->TxAbort &= ~(1 << n);
+				if (Status & CAN_SR_TCS(n)) {
+					pSvc->TxFrames++;
+				}
+				else {
+					/* Aborted, it goes back with its old place among the frames of its ID */
+					pushTxEntry(pSvc, &pSvc->TxBuf[n]);
+					pSvc->TxPreempted++;
+				}
+			}
+		}
+	}
+
+	/* Frames of one ID are loaded one at a time, the controller would not
+	   keep them in order */
+	while ((pSvc->TxQueueNum > 0) && (pSvc->TxBusy != 0x7) &&
+		   (getSameIDBufs(pSvc, &pSvc->TxQueue[0].Msg) == 0)) {
+		for (n = CAN_BUFFER_1; pSvc->TxBusy & (1 << n); n++) {}
+		popTxEntry(pSvc, &pSvc->TxBuf[n]);
+		Chip_CAN_Send(pCAN, (CAN_BUFFER_ID_T) n, &pSvc->TxBuf[n].Msg);
+		pSvc->TxBusy |= 1 << n;
+	}
+
+	/* All three buffers are taken: abort the least urgent one if a more
+	   urgent frame waits. A frame already on the bus finishes. */
+	if ((pSvc->TxQueueNum > 0) && (pSvc->TxBusy == 0x7) && (pSvc->TxAbort == 0) &&
+		(getSameIDBufs(pSvc, &pSvc->TxQueue[0].Msg) == 0)) {
+		Worst = CAN_BUFFER_1;
+		for (n = CAN_BUFFER_2; n < CAN_BUFFER_LAST; n++) {
+			if (isTxBefore(&pSvc->TxBuf[Worst], &pSvc->TxBuf[n])) {
+				Worst = n;
+			}
+		}
+		if (isTxBefore(&pSvc->TxQueue[0], &pSvc->TxBuf[Worst])) {
+			Chip_CAN_SetCmd(pCAN, CAN_CMR_AT | CAN_CMR_STB(Worst));
+			pSvc->TxAbort |= 1 << Worst;
+		}
+	}
+
+	return pSvc->TxQueueNum < QueueNum;
+}
+
+/* Mailbox of a frame ID, or NULL */
+STATIC CAN_MAILBOX_T *findMailbox(CAN_SERVICE_T *pSvc, uint32_t ID)
+{
+	uint32_t Low = 0, High = pSvc->MailboxNum, Mid;
+
+	while (Low < High) {
+		Mid = (Low + High) / 2;
+		if (pSvc->pMailboxes[Mid].ID == ID) {
+			return &pSvc->pMailboxes[Mid];
+		}
+		if (pSvc->pMailboxes[Mid].ID < ID) {
+			Low = Mid + 1;
+		}
+		else {
+			High = Mid;
+		}
+	}
+	return NULL;
+}
+
+/* Put a frame in its mailbox if it has one, or in the receive ring */
+STATIC void storeRxFrame(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg, uint32_t Stamp)
+{
+	CAN_MAILBOX_T *pBox = findMailbox(pSvc, pMsg->ID);
+	CAN_RX_FRAME_T *pFrame;
+
+	if (pBox != NULL) {
+		/* Odd Seq tells Chip_CAN_Service_ReadMailbox() the frame is being written */
+		pBox->Seq++;
+		RB_RELEASE();
+		pBox->Frame.Msg = *pMsg;
+		pBox->Frame.Timestamp = Stamp;
+		RB_RELEASE();
+		pBox->Seq++;
+		pSvc->RxMailboxFrames++;
+	}
+	else if (RingBuffer_AcquireWrite(pSvc->pRxRing, (void **) &pFrame) > 0) {
+		pFrame->Msg = *pMsg;
+		pFrame->Timestamp = Stamp;
+		RingBuffer_CommitWrite(pSvc->pRxRing, 1);
+		pSvc->RxFrames++;
+	}
+	else {
+		pSvc->RxDropped++;
+	}
+}
+
 /*****************************************************************************
  * Public functions
  ****************************************************************************/
@@ -960,6 +1335,74 @@ Status Chip_CAN_SetAFLUT(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam, CANAF_
 	return ret;
 }
 
+/* Sort, merge and write a whole AF Lookup Table */
+Status Chip_CAN_BuildAFLUT(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam, CANAF_LUT_T *pAFSections)
+{
+	uint16_t i, Row = 0;
+	uint32_t RowNum;
+	CAN_AF_MODE_T CurMode;
+
+	/* A range is Lower <= Upper on one controller */
+	for (i = 0; i < pAFSections->SffGrpEntryNum; i++) {
+		if ((pAFSections->SffGrpSec[i].LowerID.CtrlNo != pAFSections->SffGrpSec[i].UpperID.CtrlNo) ||
+			(getSTDSortKey(&pAFSections->SffGrpSec[i].LowerID) > getSTDSortKey(&pAFSections->SffGrpSec[i].UpperID))) {
+			return ERROR;
+		}
+	}
+	for (i = 0; i < pAFSections->EffGrpEntryNum; i++) {
+		if ((pAFSections->EffGrpSec[i].LowerID.CtrlNo != pAFSections->EffGrpSec[i].UpperID.CtrlNo) ||
+			(getEXTSortKey(&pAFSections->EffGrpSec[i].LowerID) > getEXTSortKey(&pAFSections->EffGrpSec[i].UpperID))) {
+			return ERROR;
+		}
+	}
+
+	/* Sort and merge in the caller's arrays, the AF RAM is only written once */
+	sortSection(pAFSections->FullCANSec, pAFSections->FullCANEntryNum, sizeof(CAN_STD_ID_ENTRY_T),
+				CANAF_RAM_FULLCAN_SEC);
+	pAFSections->FullCANEntryNum = uniqueSection(pAFSections->FullCANSec, pAFSections->FullCANEntryNum,
+												 sizeof(CAN_STD_ID_ENTRY_T), CANAF_RAM_FULLCAN_SEC);
+	sortSection(pAFSections->SffSec, pAFSections->SffEntryNum, sizeof(CAN_STD_ID_ENTRY_T),
+				CANAF_RAM_SFF_SEC);
+	pAFSections->SffEntryNum = uniqueSection(pAFSections->SffSec, pAFSections->SffEntryNum,
+											 sizeof(CAN_STD_ID_ENTRY_T), CANAF_RAM_SFF_SEC);
+	sortSection(pAFSections->SffGrpSec, pAFSections->SffGrpEntryNum, sizeof(CAN_STD_ID_RANGE_ENTRY_T),
+				CANAF_RAM_SFF_GRP_SEC);
+	pAFSections->SffGrpEntryNum = mergeSTDRanges(pAFSections->SffGrpSec, pAFSections->SffGrpEntryNum);
+	sortSection(pAFSections->EffSec, pAFSections->EffEntryNum, sizeof(CAN_EXT_ID_ENTRY_T),
+				CANAF_RAM_EFF_SEC);
+	pAFSections->EffEntryNum = uniqueSection(pAFSections->EffSec, pAFSections->EffEntryNum,
+											 sizeof(CAN_EXT_ID_ENTRY_T), CANAF_RAM_EFF_SEC);
+	sortSection(pAFSections->EffGrpSec, pAFSections->EffGrpEntryNum, sizeof(CAN_EXT_ID_RANGE_ENTRY_T),
+				CANAF_RAM_EFF_GRP_SEC);
+	pAFSections->EffGrpEntryNum = mergeEXTRanges(pAFSections->EffGrpSec, pAFSections->EffGrpEntryNum);
+
+	/* The FullCAN message objects, 3 words each, follow the LUT in AF RAM */
+	RowNum = ((pAFSections->FullCANEntryNum + 1) / 2) + ((pAFSections->SffEntryNum + 1) / 2) +
+			 pAFSections->SffGrpEntryNum + pAFSections->EffEntryNum + (pAFSections->EffGrpEntryNum * 2);
+	if ((RowNum + (pAFSections->FullCANEntryNum * 3)) > CANAF_RAM_ENTRY_NUM) {
+		return ERROR;
+	}
+
+	CurMode = Chip_CAN_GetAFMode(pCANAF);
+	Chip_CAN_SetAFMode(pCANAF, CAN_AF_OFF_MODE);
+
+	Row = writeSTDRows(pCANAFRam, Row, pAFSections->FullCANSec, pAFSections->FullCANEntryNum, true);
+	setSectionEndAddress(pCANAF, CANAF_RAM_FULLCAN_SEC, Row);
+	Row = writeSTDRows(pCANAFRam, Row, pAFSections->SffSec, pAFSections->SffEntryNum, false);
+	setSectionEndAddress(pCANAF, CANAF_RAM_SFF_SEC, Row);
+	Row = writeSTDRows(pCANAFRam, Row, (CAN_STD_ID_ENTRY_T *) pAFSections->SffGrpSec,
+					   pAFSections->SffGrpEntryNum * 2, false);
+	setSectionEndAddress(pCANAF, CANAF_RAM_SFF_GRP_SEC, Row);
+	Row = writeEXTRows(pCANAFRam, Row, pAFSections->EffSec, pAFSections->EffEntryNum);
+	setSectionEndAddress(pCANAF, CANAF_RAM_EFF_SEC, Row);
+	Row = writeEXTRows(pCANAFRam, Row, (CAN_EXT_ID_ENTRY_T *) pAFSections->EffGrpSec,
+					   pAFSections->EffGrpEntryNum * 2);
+	setSectionEndAddress(pCANAF, CANAF_RAM_EFF_GRP_SEC, Row);
+
+	Chip_CAN_SetAFMode(pCANAF, CurMode);
+	return SUCCESS;
+}
+
 /* Get the number of entries of the given section */
 uint16_t Chip_CAN_GetEntriesNum(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam,
 								CANAF_RAM_SECTION_T SectionID)
@@ -1505,3 +1948,163 @@ Status Chip_CAN_FullCANReceive(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam
 
 	return SUCCESS;
 }
+
+/* Set up the interrupt driven service of a CAN controller */
+void Chip_CAN_Service_Init(CAN_SERVICE_T *pSvc, LPC_CAN_T *pCAN, RINGBUFF_T *pRxRing,
+						   const volatile uint32_t *pTimeBase)
+{
+	memset(pSvc, 0, sizeof(CAN_SERVICE_T));
+	pSvc->pCAN = pCAN;
+	pSvc->pRxRing = pRxRing;
+	pSvc->pTimeBase = pTimeBase;
+
+	/* Lowest ID first among the transmit buffers, as on the bus */
+	Chip_CAN_SetMode(pCAN, CAN_TRANSMIT_PRIORITY_MODE, DISABLE);
+	Chip_CAN_EnableInt(pCAN, CAN_IER_RIE | CAN_IER_TIE1 | CAN_IER_TIE2 | CAN_IER_TIE3 | CAN_IER_DOIE);
+}
+
+/* CAN service interrupt handler */
+void Chip_CAN_Service_IRQHandler(CAN_SERVICE_T *pSvc)
+{
+	LPC_CAN_T *pCAN = pSvc->pCAN;
+	CAN_RX_FRAME_T *pFrame;
+	CAN_MSG_T Msg;
+	uint32_t IntStatus, Stamp, Events = 0;
+	uint32_t RingFrames = pSvc->RxFrames + pSvc->RxDropped, BoxFrames = pSvc->RxMailboxFrames;
+
+	/* The controller has no capture register: the time base is read first,
+	   as close to the end of the frame as software gets. It holds two
+	   frames, both get the time of this interrupt. */
+	Stamp = (pSvc->pTimeBase != NULL) ? *pSvc->pTimeBase : 0;
+
+	/* Reading ICR clears the flags, RI stays set until the frames are released */
+	IntStatus = Chip_CAN_GetIntStatus(pCAN);
+
+	if (IntStatus & CAN_ICR_RI) {
+		do {
+			if (pSvc->MailboxNum > 0) {
+				/* The ID decides where the frame goes */
+				Chip_CAN_Receive(pCAN, &Msg);
+				storeRxFrame(pSvc, &Msg, Stamp);
+			}
+			else if (RingBuffer_AcquireWrite(pSvc->pRxRing, (void **) &pFrame) > 0) {
+				Chip_CAN_Receive(pCAN, &pFrame->Msg);
+				pFrame->Timestamp = Stamp;
+				RingBuffer_CommitWrite(pSvc->pRxRing, 1);
+				pSvc->RxFrames++;
+			}
+			else {
+				Chip_CAN_SetCmd(pCAN, CAN_CMR_RRB);
+				pSvc->RxDropped++;
+			}
+		} while (Chip_CAN_GetGlobalStatus(pCAN) & CAN_GSR_RBS);
+		if (pSvc->RxFrames + pSvc->RxDropped != RingFrames) {
+			Events |= CAN_SERVICE_EVT_RX;
+		}
+		if (pSvc->RxMailboxFrames != BoxFrames) {
+			Events |= CAN_SERVICE_EVT_MAILBOX;
+		}
+	}
+
+	if (IntStatus & CAN_ICR_DOI) {
+		pSvc->RxOverruns++;
+		Chip_CAN_SetCmd(pCAN, CAN_CMR_CDO);
+	}
+
+	/* The transmit side is left alone while Chip_CAN_Service_Write() has
+	   the transmit interrupts off, it sets CAN_IRQn pending afterwards */
+	if (((pSvc->TxBusy != 0) || (pSvc->TxQueueNum != 0)) && (pCAN->IER & CAN_IER_TIE1)) {
+		if (serviceTx(pSvc)) {
+			Events |= CAN_SERVICE_EVT_TX;
+		}
+	}
+
+	if ((Events != 0) && (pSvc->pEventFunc != NULL)) {
+		pSvc->pEventFunc(pSvc, Events);
+	}
+}
+
+/* Queue a frame for sending */
+Status Chip_CAN_Service_Write(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg)
+{
+	CAN_TX_ENTRY_T Entry;
+	Status ret = ERROR;
+
+	Entry.Msg = *pMsg;
+
+	/* Keep the interrupt away from the queue, as Chip_UART_SendRB() does */
+	Chip_CAN_DisableInt(pSvc->pCAN, CAN_IER_TIE1 | CAN_IER_TIE2 | CAN_IER_TIE3);
+	if (pSvc->TxQueueNum < CAN_SERVICE_TXQ_SIZE) {
+		Entry.Seq = pSvc->TxSeq++;
+		pushTxEntry(pSvc, &Entry);
+		ret = SUCCESS;
+	}
+	Chip_CAN_EnableInt(pSvc->pCAN, CAN_IER_TIE1 | CAN_IER_TIE2 | CAN_IER_TIE3);
+
+	/* The interrupt loads the buffers, also for releases it missed meanwhile */
+	if (ret == SUCCESS) {
+		NVIC_SetPendingIRQ(CAN_IRQn);
+	}
+	return ret;
+}
+
+/* Queue a frame for sending, waiting for room in the queue */
+void Chip_CAN_Service_WriteBlocking(CAN_SERVICE_T *pSvc, const CAN_MSG_T *pMsg)
+{
+	while (Chip_CAN_Service_Write(pSvc, pMsg) == ERROR) {
+		if (pSvc->pWaitFunc != NULL) {
+			pSvc->pWaitFunc(pSvc);
+		}
+	}
+}
+
+/* Take a received frame, waiting for one */
+void Chip_CAN_Service_ReadBlocking(CAN_SERVICE_T *pSvc, CAN_RX_FRAME_T *pFrame)
+{
+	while (Chip_CAN_Service_Read(pSvc, pFrame) == ERROR) {
+		if (pSvc->pWaitFunc != NULL) {
+			pSvc->pWaitFunc(pSvc);
+		}
+	}
+}
+
+/* Give the service mailboxes for single IDs */
+Status Chip_CAN_Service_SetMailboxes(CAN_SERVICE_T *pSvc, CAN_MAILBOX_T *pMailboxes, uint32_t Num)
+{
+	uint32_t i;
+
+	for (i = 1; i < Num; i++) {
+		if (pMailboxes[i].ID <= pMailboxes[i - 1].ID) {
+			return ERROR;
+		}
+	}
+	for (i = 0; i < Num; i++) {
+		pMailboxes[i].Seq = 0;
+		pMailboxes[i].ReadSeq = 0;
+	}
+	pSvc->pMailboxes = pMailboxes;
+	pSvc->MailboxNum = (pMailboxes != NULL) ? Num : 0;
+	return SUCCESS;
+}
+
+/* Take the frame in a mailbox if it came after the last one taken */
+Status Chip_CAN_Service_ReadMailbox(CAN_SERVICE_T *pSvc, uint32_t Index, CAN_RX_FRAME_T *pFrame)
+{
+	CAN_MAILBOX_T *pBox = &pSvc->pMailboxes[Index];
+	uint32_t Seq;
+
+	if (pBox->Seq == pBox->ReadSeq) {
+		return ERROR;
+	}
+
+	/* Copy again if the interrupt wrote the mailbox meanwhile */
+	do {
+		Seq = pBox->Seq;
+		RB_ACQUIRE();
+		*pFrame = pBox->Frame;
+		RB_ACQUIRE();
+	} while ((Seq & 1) || (Seq != pBox->Seq));
+
+	pBox->ReadSeq = Seq;
+	return SUCCESS;
+}
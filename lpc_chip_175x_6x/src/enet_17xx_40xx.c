@@ -287,3 +287,160 @@ uint16_t Chip_ENET_IncRXConsumeIndex(LPC_ENET_T *pENET)
 
 	return idx;
 }
+
+/* Set up the descriptor rings and the frame buffer pool */
+Status Chip_ENET_Ring_Init(ENET_RING_T *pRing, LPC_ENET_T *pENET, void *pMem,
+						   ENET_RING_TXDONE_T txDone)
+{
+	uint8_t *pNext = (uint8_t *) pMem;
+	uint32_t i;
+
+	if (((uint32_t) pMem & 7) != 0) {
+		return ERROR;
+	}
+
+	memset(pRing, 0, sizeof(ENET_RING_T));
+	pRing->pENET = pENET;
+	pRing->txDone = txDone;
+
+	/* Receive status needs 8 byte alignment, so it goes first */
+	pRing->pRxStat = (ENET_RXSTAT_T *) pNext;
+	pNext += ENET_RING_RX_DESCS * sizeof(ENET_RXSTAT_T);
+	pRing->pRxDesc = (ENET_RXDESC_T *) pNext;
+	pNext += ENET_RING_RX_DESCS * sizeof(ENET_RXDESC_T);
+	pRing->pTxDesc = (ENET_TXDESC_T *) pNext;
+	pNext += ENET_RING_TX_DESCS * sizeof(ENET_TXDESC_T);
+	pRing->pTxStat = (ENET_TXSTAT_T *) pNext;
+	pNext += ENET_RING_TX_DESCS * sizeof(ENET_TXSTAT_T);
+
+	for (i = 0; i < ENET_RING_POOL_BUFS; i++) {
+		pRing->pFree[i] = pNext + (ENET_RING_POOL_BUFS - 1 - i) * ENET_RING_BUF_SIZE;
+	}
+	pRing->freeCount = ENET_RING_POOL_BUFS;
+
+	for (i = 0; i < ENET_RING_RX_DESCS; i++) {
+		pRing->rxBuf[i] = Chip_ENET_Ring_AllocBuf(pRing);
+		pRing->pRxDesc[i].Packet = (uint32_t) pRing->rxBuf[i];
+		pRing->pRxDesc[i].Control = ENET_RCTRL_SIZE(ENET_RING_BUF_SIZE) | ENET_RCTRL_INT;
+		pRing->pRxStat[i].StatusInfo = 0;
+		pRing->pRxStat[i].StatusHashCRC = 0;
+	}
+	for (i = 0; i < ENET_RING_TX_DESCS; i++) {
+		pRing->pTxDesc[i].Packet = 0;
+		pRing->pTxDesc[i].Control = 0;
+		pRing->pTxStat[i].StatusInfo = 0;
+	}
+
+	Chip_ENET_InitRxDescriptors(pENET, pRing->pRxDesc, pRing->pRxStat, ENET_RING_RX_DESCS);
+	Chip_ENET_InitTxDescriptors(pENET, pRing->pTxDesc, pRing->pTxStat, ENET_RING_TX_DESCS);
+
+	return SUCCESS;
+}
+
+/* Take the next received frame, without copying it */
+uint8_t *Chip_ENET_Ring_Receive(ENET_RING_T *pRing, uint32_t *pLen)
+{
+	uint32_t produce = pRing->pENET->CONTROL.RX.PRODUCEINDEX;
+	uint32_t idx = pRing->rxConsume, info;
+	uint8_t *pFrame = NULL, *pFresh;
+
+	while ((pFrame == NULL) && (idx != produce)) {
+		info = pRing->pRxStat[idx].StatusInfo;
+
+		/* Range and length errors come from reading the type field as a
+		   length, most frames carry a type there */
+		if ((info & (ENET_RINFO_ERR_MASK | ENET_RINFO_NO_DESCR) & ~(ENET_RINFO_LEN_ERR | ENET_RINFO_RANGE_ERR)) ||
+			!(info & ENET_RINFO_LAST_FLAG)) {
+			/* Bad, or a part of a frame longer than a buffer */
+			pRing->rxErrors++;
+		}
+		else {
+			pFresh = Chip_ENET_Ring_AllocBuf(pRing);
+			if (pFresh == NULL) {
+				pRing->rxDropped++;
+			}
+			else {
+				pFrame = pRing->rxBuf[idx];
+				*pLen = ENET_RINFO_SIZE(info) - 4;
+				pRing->rxBuf[idx] = pFresh;
+				pRing->pRxDesc[idx].Packet = (uint32_t) pFresh;
+			}
+		}
+
+		idx++;
+		if (idx == ENET_RING_RX_DESCS) {
+			idx = 0;
+		}
+	}
+
+	if (idx != pRing->rxConsume) {
+		pRing->rxConsume = idx;
+		pRing->pENET->CONTROL.RX.CONSUMEINDEX = idx;
+	}
+	return pFrame;
+}
+
+/* Queue a frame made of one or more pieces, without copying it */
+Status Chip_ENET_Ring_Send(ENET_RING_T *pRing, const ENET_FRAG_T *pFrags,
+						   uint32_t numFrags, void *ref)
+{
+	uint32_t idx = pRing->txProduce, used, i;
+
+	used = (idx + ENET_RING_TX_DESCS - pRing->txClean) % ENET_RING_TX_DESCS;
+	if ((numFrags == 0) || (used + numFrags > ENET_RING_TX_DESCS - 1)) {
+		Chip_ENET_Ring_TxReclaim(pRing);
+		used = (idx + ENET_RING_TX_DESCS - pRing->txClean) % ENET_RING_TX_DESCS;
+		if ((numFrags == 0) || (used + numFrags > ENET_RING_TX_DESCS - 1)) {
+			return ERROR;
+		}
+	}
+
+	for (i = 0; i < numFrags; i++) {
+		pRing->pTxDesc[idx].Packet = (uint32_t) pFrags[i].pData;
+		pRing->pTxDesc[idx].Control = ENET_TCTRL_SIZE(pFrags[i].len);
+		pRing->txRef[idx] = NULL;
+		if (i == numFrags - 1) {
+			pRing->pTxDesc[idx].Control |= ENET_TCTRL_LAST | ENET_TCTRL_INT;
+			pRing->txRef[idx] = ref;
+		}
+		idx++;
+		if (idx == ENET_RING_TX_DESCS) {
+			idx = 0;
+		}
+	}
+
+	/* One index write hands the whole frame to the MAC */
+	pRing->txProduce = idx;
+	pRing->pENET->CONTROL.TX.PRODUCEINDEX = idx;
+
+	return SUCCESS;
+}
+
+/* Finish the frames the MAC has sent */
+uint32_t Chip_ENET_Ring_TxReclaim(ENET_RING_T *pRing)
+{
+	uint32_t consume = pRing->pENET->CONTROL.TX.CONSUMEINDEX;
+	uint32_t idx = pRing->txClean, frames = 0;
+
+	while (idx != consume) {
+		if (pRing->pTxDesc[idx].Control & ENET_TCTRL_LAST) {
+			if (pRing->pTxStat[idx].StatusInfo & ENET_TINFO_ERR) {
+				pRing->txErrors++;
+			}
+			if (pRing->txDone != NULL) {
+				pRing->txDone(pRing, pRing->txRef[idx]);
+			}
+			else if (pRing->txRef[idx] != NULL) {
+				Chip_ENET_Ring_FreeBuf(pRing, (uint8_t *) pRing->txRef[idx]);
+			}
+			frames++;
+		}
+		idx++;
+		if (idx == ENET_RING_TX_DESCS) {
+			idx = 0;
+		}
+	}
+	pRing->txClean = idx;
+
+	return frames;
+}
@@ -38,6 +38,20 @@
 /* Channel array to monitor free channel */
 static DMA_ChannelHandle_t ChannelHandlerArray[GPDMA_NUMBER_CHANNELS];
 
+/* Channels with a callback for Chip_GPDMA_IRQHandler() */
+static uint32_t CallbackMask;
+
+/* Descriptor pool and its used map */
+static DMA_TransferDescriptor_t DescPool[GPDMA_DESC_POOL_SIZE];
+static uint32_t DescUsed;
+
+/* Lowest set bit of a channel mask */
+#if defined(__GNUC__)
+#define GPDMA_LOWEST_CH(mask)   __builtin_ctz(mask)
+#else
+#define GPDMA_LOWEST_CH(mask)   (31 - __CLZ((mask) & (0 - (mask))))
+#endif
+
 #if defined(CHIP_LPC177X_8X) || defined(CHIP_LPC40XX)
 /* Optimized Peripheral Source and Destination burst size (177x_8x,407x_8x) */
 static const uint8_t GPDMA_LUTPerBurst[] = {
@@ -271,6 +285,24 @@ STATIC uint8_t configDMAMux(uint32_t gpdma_peripheral_connection_number)
 #endif
 }
 
+/* Find the connection whose peripheral register is at addr, -1 if none.
+   The Tx and Rx connections of a UART or SSP share its data register, the
+   Tx connection comes first in the table and Rx second. */
+STATIC int getConnection(uint32_t addr, bool isSrc)
+{
+	int i, conn = -1;
+
+	for (i = 0; i < (int) (sizeof(GPDMA_LUTPerAddr) / sizeof(GPDMA_LUTPerAddr[0])); i++) {
+		if ((GPDMA_LUTPerAddr[i] != 0) && ((uint32_t) GPDMA_LUTPerAddr[i] == addr)) {
+			conn = i;
+			if (!isSrc) {
+				break;
+			}
+		}
+	}
+	return conn;
+}
+
 uint32_t makeCtrlWord(const GPDMA_CH_CFG_T *GPDMAChannelConfig,
 					  uint32_t GPDMA_LUTPerBurstSrcConn,
 					  uint32_t GPDMA_LUTPerBurstDstConn,
@@ -404,7 +436,9 @@ void Chip_GPDMA_Init(LPC_GPDMA_T *pGPDMA)
 	/* Reset all channels are free */
 	for (i = 0; i < GPDMA_NUMBER_CHANNELS; i++) {
 		ChannelHandlerArray[i].ChannelStatus = DISABLE;
+		ChannelHandlerArray[i].callback = NULL;
 	}
+	CallbackMask = 0;
 }
 
 /* Shutdown the GPDMA */
@@ -427,6 +461,8 @@ void Chip_GPDMA_Stop(LPC_GPDMA_T *pGPDMA,
 		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTERR, ChannelNum);
 	}
 	ChannelHandlerArray[ChannelNum].ChannelStatus = DISABLE;
+	ChannelHandlerArray[ChannelNum].callback = NULL;
+	CallbackMask &= ~(1UL << ChannelNum);
 }
 
 /* The GPDMA stream interrupt status checking */
@@ -647,6 +683,64 @@ Status Chip_GPDMA_PrepareDescriptor(LPC_GPDMA_T *pGPDMA,
 	return SUCCESS;
 }
 
+/* Work out the channel set-up of a repeated transfer once */
+Status Chip_GPDMA_PrepareTransfer(LPC_GPDMA_T *pGPDMA,
+								  GPDMA_XFER_T *pXfer,
+								  uint8_t ChannelNum,
+								  uint32_t src,
+								  uint32_t dst,
+								  GPDMA_FLOW_CONTROL_T TransferType)
+{
+	GPDMA_CH_CFG_T GPDMACfg;
+	uint8_t SrcPeripheral = 0, DstPeripheral = 0;
+	int ret;
+
+	ret = Chip_GPDMA_InitChannelCfg(pGPDMA, &GPDMACfg, ChannelNum, src, dst, 0, TransferType);
+	if (ret < 0) {
+		return ERROR;
+	}
+
+	/* Keep the peripheral register addresses, the memory ones change */
+	pXfer->SrcAddr = GPDMACfg.SrcAddr;
+	pXfer->DstAddr = GPDMACfg.DstAddr;
+
+	/* Adjust src/dst index if they are memory */
+	if (ret & 1) {
+		src = 0;
+		pXfer->SrcAddr = 0;
+	}
+	else {
+		SrcPeripheral = configDMAMux(src);
+	}
+
+	if (ret & 2) {
+		dst = 0;
+		pXfer->DstAddr = 0;
+	}
+	else {
+		DstPeripheral = configDMAMux(dst);
+	}
+
+	pXfer->Control = makeCtrlWord(&GPDMACfg,
+								  (uint32_t) GPDMA_LUTPerBurst[src],
+								  (uint32_t) GPDMA_LUTPerBurst[dst],
+								  (uint32_t) GPDMA_LUTPerWid[src],
+								  (uint32_t) GPDMA_LUTPerWid[dst]);
+	pXfer->Config = GPDMA_DMACCxConfig_IE
+					| GPDMA_DMACCxConfig_ITC
+					| GPDMA_DMACCxConfig_TransferType((uint32_t) TransferType)
+					| GPDMA_DMACCxConfig_SrcPeripheral(SrcPeripheral)
+					| GPDMA_DMACCxConfig_DestPeripheral(DstPeripheral);
+	pXfer->ChannelNum = ChannelNum;
+	pXfer->SizeShift = (TransferType == GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA) ? 2 : 0;
+
+	/* Enable DMA channels, little endian */
+	pGPDMA->CONFIG = GPDMA_DMACConfig_E;
+	while (!(pGPDMA->CONFIG & GPDMA_DMACConfig_E)) {}
+
+	return SUCCESS;
+}
+
 /* Do a DMA scatter-gather transfer M2M, M2P,P2M or P2P using DMA descriptors */
 Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T *pGPDMA,
 							 uint8_t ChannelNum,
@@ -657,7 +751,45 @@ Status Chip_GPDMA_SGTransfer(LPC_GPDMA_T *pGPDMA,
 	GPDMA_CH_CFG_T GPDMACfg;
 	uint8_t SrcPeripheral = 0, DstPeripheral = 0;
 	uint32_t src = DMADescriptor->src, dst = DMADescriptor->dst;
-	int ret;
+	int ret, conn;
+
+	/* The descriptor holds register addresses, but the channel set-up
+	   needs the peripheral connections */
+	switch (TransferType) {
+	case GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA:
+		break;
+
+	case GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA:
+	case GPDMA_TRANSFERTYPE_M2P_CONTROLLER_PERIPHERAL:
+		conn = getConnection(dst, false);
+		if (conn < 0) {
+			return ERROR;
+		}
+		dst = conn;
+		break;
+
+	case GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA:
+	case GPDMA_TRANSFERTYPE_P2M_CONTROLLER_PERIPHERAL:
+		conn = getConnection(src, true);
+		if (conn < 0) {
+			return ERROR;
+		}
+		src = conn;
+		break;
+
+	default:
+		conn = getConnection(src, true);
+		if (conn < 0) {
+			return ERROR;
+		}
+		src = conn;
+		conn = getConnection(dst, false);
+		if (conn < 0) {
+			return ERROR;
+		}
+		dst = conn;
+		break;
+	}
 
 	ret = Chip_GPDMA_InitChannelCfg(pGPDMA, &GPDMACfg, ChannelNum, src, dst, 0, TransferType);
 	if (ret < 0) {
@@ -702,3 +834,95 @@ uint8_t Chip_GPDMA_GetFreeChannel(LPC_GPDMA_T *pGPDMA,
 	}
 	return 0;
 }
+
+/* Reserve a GPDMA channel and route its interrupts to a callback */
+int Chip_GPDMA_ReserveChannel(LPC_GPDMA_T *pGPDMA, GPDMA_PRIO_T prio,
+							  GPDMA_CALLBACK_T callback, void *pUserData)
+{
+	int i, ch;
+
+	for (i = 0; i < GPDMA_NUMBER_CHANNELS; i++) {
+		/* Channel 0 has the highest priority */
+		ch = (prio == GPDMA_PRIO_HIGH) ? i : (GPDMA_NUMBER_CHANNELS - 1 - i);
+		if ((ChannelHandlerArray[ch].ChannelStatus == DISABLE) &&
+			!Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_ENABLED_CH, ch)) {
+			ChannelHandlerArray[ch].ChannelStatus = ENABLE;
+			ChannelHandlerArray[ch].callback = callback;
+			ChannelHandlerArray[ch].pUserData = pUserData;
+			if (callback != NULL) {
+				CallbackMask |= 1UL << ch;
+			}
+			return ch;
+		}
+	}
+	return -1;
+}
+
+/* Stop a reserved GPDMA channel and make it free again */
+void Chip_GPDMA_ReleaseChannel(LPC_GPDMA_T *pGPDMA, uint8_t ChannelNum)
+{
+	Chip_GPDMA_Stop(pGPDMA, ChannelNum);
+}
+
+/* GPDMA interrupt dispatcher */
+void Chip_GPDMA_IRQHandler(LPC_GPDMA_T *pGPDMA)
+{
+	uint32_t tc, err, pending;
+	int ch;
+
+	err = pGPDMA->INTERRSTAT & CallbackMask;
+	tc = pGPDMA->INTTCSTAT & CallbackMask;
+	if (err != 0) {
+		pGPDMA->INTERRCLR = err;
+	}
+	if (tc != 0) {
+		pGPDMA->INTTCCLEAR = tc;
+	}
+
+	for (pending = tc | err; pending != 0; pending &= pending - 1) {
+		ch = GPDMA_LOWEST_CH(pending);
+		ChannelHandlerArray[ch].callback(pGPDMA, ch, (err & (1UL << ch)) ? ERROR : SUCCESS,
+										 ChannelHandlerArray[ch].pUserData);
+	}
+}
+
+/* Take consecutive descriptors from the static descriptor pool */
+DMA_TransferDescriptor_t *Chip_GPDMA_AllocDescriptors(uint32_t num)
+{
+	uint32_t i, mask;
+
+	if ((num == 0) || (num > GPDMA_DESC_POOL_SIZE)) {
+		return NULL;
+	}
+	mask = (num == 32) ? 0xFFFFFFFF : ((1UL << num) - 1);
+
+	for (i = 0; i <= GPDMA_DESC_POOL_SIZE - num; i++) {
+		if ((DescUsed & (mask << i)) == 0) {
+			DescUsed |= mask << i;
+			return &DescPool[i];
+		}
+	}
+	return NULL;
+}
+
+/* Give descriptors back to the static descriptor pool */
+Status Chip_GPDMA_FreeDescriptors(DMA_TransferDescriptor_t *pDesc, uint32_t num)
+{
+	uint32_t first, mask;
+
+	if ((pDesc < DescPool) || (pDesc >= &DescPool[GPDMA_DESC_POOL_SIZE])) {
+		return ERROR;
+	}
+	first = pDesc - DescPool;
+	if ((num == 0) || (num > GPDMA_DESC_POOL_SIZE - first)) {
+		return ERROR;
+	}
+	mask = ((num == 32) ? 0xFFFFFFFF : ((1UL << num) - 1)) << first;
+
+	/* Only descriptors that are in use */
+	if ((DescUsed & mask) != mask) {
+		return ERROR;
+	}
+	DescUsed &= ~mask;
+	return SUCCESS;
+}
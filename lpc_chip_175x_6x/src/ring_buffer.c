@@ -66,14 +66,19 @@ int RingBuffer_Init(RINGBUFF_T *RingBuff, void *buffer, int itemSize, int count)
 int RingBuffer_Insert(RINGBUFF_T *RingBuff, const void *data)
 {
 	uint8_t *ptr = RingBuff->data;
+	uint32_t tail = RB_VTAIL(RingBuff);
 
 	/* We cannot insert when queue is full */
-	if (RingBuffer_IsFull(RingBuff))
+	if ((int) (RingBuff->head - tail) >= RingBuff->count)
 		return 0;
+	RB_ACQUIRE();
 
 	ptr += RB_INDH(RingBuff) * RingBuff->itemSz;
-	memcpy(ptr, data, RingBuff->itemSz);
-	RingBuff->head++;
+	if (RingBuff->itemSz == 1)
+		*ptr = *(const uint8_t *) data;
+	else
+		memcpy(ptr, data, RingBuff->itemSz);
+	RingBuffer_CommitWrite(RingBuff, 1);
 
 	return 1;
 }
@@ -81,51 +86,41 @@ int RingBuffer_Insert(RINGBUFF_T *RingBuff, const void *data)
 /* Insert multiple items into Ring Buffer */
 int RingBuffer_InsertMult(RINGBUFF_T *RingBuff, const void *data, int num)
 {
-	uint8_t *ptr = RingBuff->data;
-	int cnt1, cnt2;
-
-	/* We cannot insert when queue is full */
-	if (RingBuffer_IsFull(RingBuff))
-		return 0;
-
-	/* Calculate the segment lengths */
-	cnt1 = cnt2 = RingBuffer_GetFree(RingBuff);
-	if (RB_INDH(RingBuff) + cnt1 >= RingBuff->count)
-		cnt1 = RingBuff->count - RB_INDH(RingBuff);
-	cnt2 -= cnt1;
-
-	cnt1 = MIN(cnt1, num);
-	num -= cnt1;
-
-	cnt2 = MIN(cnt2, num);
-	num -= cnt2;
-
-	/* Write segment 1 */
-	ptr += RB_INDH(RingBuff) * RingBuff->itemSz;
-	memcpy(ptr, data, cnt1 * RingBuff->itemSz);
-	RingBuff->head += cnt1;
-
-	/* Write segment 2 */
-	ptr = (uint8_t *) RingBuff->data + RB_INDH(RingBuff) * RingBuff->itemSz;
-	data = (const uint8_t *) data + cnt1 * RingBuff->itemSz;
-	memcpy(ptr, data, cnt2 * RingBuff->itemSz);
-	RingBuff->head += cnt2;
-
-	return cnt1 + cnt2;
+	void *ptr;
+	int cnt, total = 0;
+
+	/* Up to the end of the buffer, then from its start */
+	while (total < num) {
+		cnt = RingBuffer_AcquireWrite(RingBuff, &ptr);
+		if (cnt == 0)
+			break;
+		cnt = MIN(cnt, num - total);
+		memcpy(ptr, data, cnt * RingBuff->itemSz);
+		RingBuffer_CommitWrite(RingBuff, cnt);
+		data = (const uint8_t *) data + cnt * RingBuff->itemSz;
+		total += cnt;
+	}
+
+	return total;
 }
 
 /* Pop single item from Ring Buffer */
 int RingBuffer_Pop(RINGBUFF_T *RingBuff, void *data)
 {
 	uint8_t *ptr = RingBuff->data;
+	uint32_t head = RB_VHEAD(RingBuff);
 
 	/* We cannot pop when queue is empty */
-	if (RingBuffer_IsEmpty(RingBuff))
+	if (head == RingBuff->tail)
 		return 0;
+	RB_ACQUIRE();
 
 	ptr += RB_INDT(RingBuff) * RingBuff->itemSz;
-	memcpy(data, ptr, RingBuff->itemSz);
-	RingBuff->tail++;
+	if (RingBuff->itemSz == 1)
+		*(uint8_t *) data = *ptr;
+	else
+		memcpy(data, ptr, RingBuff->itemSz);
+	RingBuffer_ReleaseRead(RingBuff, 1);
 
 	return 1;
 }
@@ -133,35 +128,50 @@ int RingBuffer_Pop(RINGBUFF_T *RingBuff, void *data)
 /* Pop multiple items from Ring buffer */
 int RingBuffer_PopMult(RINGBUFF_T *RingBuff, void *data, int num)
 {
-	uint8_t *ptr = RingBuff->data;
-	int cnt1, cnt2;
+	void *ptr;
+	int cnt, total = 0;
+
+	/* Up to the end of the buffer, then from its start */
+	while (total < num) {
+		cnt = RingBuffer_PeekRead(RingBuff, &ptr);
+		if (cnt == 0)
+			break;
+		cnt = MIN(cnt, num - total);
+		memcpy(data, ptr, cnt * RingBuff->itemSz);
+		RingBuffer_ReleaseRead(RingBuff, cnt);
+		data = (uint8_t *) data + cnt * RingBuff->itemSz;
+		total += cnt;
+	}
+
+	return total;
+}
 
-	/* We cannot insert when queue is empty */
-	if (RingBuffer_IsEmpty(RingBuff))
-		return 0;
+/* Get the contiguous free items at the head */
+int RingBuffer_AcquireWrite(RINGBUFF_T *RingBuff, void **ppData)
+{
+	uint32_t tail = RB_VTAIL(RingBuff);
+	int cnt;
 
-	/* Calculate the segment lengths */
-	cnt1 = cnt2 = RingBuffer_GetCount(RingBuff);
-	if (RB_INDT(RingBuff) + cnt1 >= RingBuff->count)
-		cnt1 = RingBuff->count - RB_INDT(RingBuff);
-	cnt2 -= cnt1;
+	cnt = RingBuff->count - (int) (RingBuff->head - tail);
+	RB_ACQUIRE();
 
-	cnt1 = MIN(cnt1, num);
-	num -= cnt1;
+	cnt = MIN(cnt, RingBuff->count - (int) RB_INDH(RingBuff));
+	*ppData = (uint8_t *) RingBuff->data + RB_INDH(RingBuff) * RingBuff->itemSz;
 
-	cnt2 = MIN(cnt2, num);
-	num -= cnt2;
+	return cnt;
+}
 
-	/* Write segment 1 */
-	ptr += RB_INDT(RingBuff) * RingBuff->itemSz;
-	memcpy(data, ptr, cnt1 * RingBuff->itemSz);
-	RingBuff->tail += cnt1;
+/* Get the contiguous items at the tail */
+int RingBuffer_PeekRead(RINGBUFF_T *RingBuff, void **ppData)
+{
+	uint32_t head = RB_VHEAD(RingBuff);
+	int cnt;
+
+	cnt = (int) (head - RingBuff->tail);
+	RB_ACQUIRE();
 
-	/* Write segment 2 */
-	ptr = (uint8_t *) RingBuff->data + RB_INDT(RingBuff) * RingBuff->itemSz;
-	data = (uint8_t *) data + cnt1 * RingBuff->itemSz;
-	memcpy(data, ptr, cnt2 * RingBuff->itemSz);
-	RingBuff->tail += cnt2;
+	cnt = MIN(cnt, RingBuff->count - (int) RB_INDT(RingBuff));
+	*ppData = (uint8_t *) RingBuff->data + RB_INDT(RingBuff) * RingBuff->itemSz;
 
-	return cnt1 + cnt2;
+	return cnt;
 }
@@ -49,6 +49,37 @@
  #define SDMMC_MAX_BLK               (127)
  #define SDMMC_MAX_TFR_SIZE          (SDMMC_MAX_BLK * MMC_SECTOR_SIZE)
 
+/* State of the transfer of Chip_SDMMC_ReadBlocks() or Chip_SDMMC_WriteBlocks().
+   A transfer of more than SDMMC_MAX_BLK blocks runs in segments under one
+   command, and Chip_SDMMC_IRQHandler() starts each segment as the one
+   before it ends. */
+typedef enum {
+	SDMMC_PIPE_IDLE,		/* No block transfer */
+	SDMMC_PIPE_DATA,		/* Segment data moving */
+	SDMMC_PIPE_STOP,		/* Read: CMD12 sent after a segment */
+	SDMMC_PIPE_RESTART,		/* Read: CMD18 sent for the next segment */
+} SDMMC_PIPE_STATE_T;
+
+typedef struct {
+	volatile SDMMC_PIPE_STATE_T state;
+	SDC_DATA_TRANSFER_T Transfer;	/* Data path set-up, BlockNum is set per segment */
+	uint32_t card_type;		/* Card type, for the block addressing of CMD18 */
+	uint32_t nextBlock;		/* First block of the next segment */
+	uint32_t blocksLeft;	/* Blocks whose segments the data path has not started */
+	bool tranKnown;			/* Card tranRCA was left in tran state by the last transfer */
+	uint16_t tranRCA;
+#ifdef SDC_DMA_ENABLE
+	int dmaChannel;			/* GPDMA channel reserved for the transfer, -1 for none */
+	GPDMA_XFER_T Xfer;		/* DMA set-up the segment descriptors are made from */
+	DMA_TransferDescriptor_t Desc[2];	/* Segment descriptors, used in turn */
+	uint32_t descNext;		/* Desc entry the next segment goes to */
+	uint32_t dmaAddr;		/* Buffer address of the next segment */
+	uint32_t dmaLeft;		/* Blocks whose segments have no descriptor yet */
+#endif
+} SDMMC_PIPE_T;
+
+static SDMMC_PIPE_T sdmmcPipe;
+
 /*****************************************************************************
  * Public types/enumerations/variables
  ****************************************************************************/
@@ -684,6 +715,228 @@ STATIC int32_t stopTranmission(LPC_SDC_T *pSDC, uint32_t rca)
 	return Ret;
 }
 
+/* Put the card in tran state, unless the last block transfer left it there */
+STATIC int32_t checkTranState(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo)
+{
+	if (sdmmcPipe.tranKnown && (sdmmcPipe.tranRCA == pCardInfo->rca)) {
+		return SDC_RET_OK;
+	}
+	return setTranState(pSDC, pCardInfo->rca);
+}
+
+#ifdef SDC_DMA_ENABLE
+/* Write the next segment of the transfer to the free DMA descriptor */
+STATIC void queueSegment(void)
+{
+	DMA_TransferDescriptor_t *pDesc = &sdmmcPipe.Desc[sdmmcPipe.descNext];
+	uint32_t blocks = MIN(sdmmcPipe.dmaLeft, SDMMC_MAX_BLK);
+
+	sdmmcPipe.descNext ^= 1;
+	sdmmcPipe.dmaLeft -= blocks;
+
+	/* The SDC controls the flow, so the descriptor size is not used. The
+	   memory side takes dmaAddr, the FIFO side comes from Xfer. */
+	Chip_GPDMA_FillDescriptor(&sdmmcPipe.Xfer, pDesc, sdmmcPipe.dmaAddr, sdmmcPipe.dmaAddr, 0,
+							  (sdmmcPipe.dmaLeft > 0) ? &sdmmcPipe.Desc[sdmmcPipe.descNext] : NULL);
+	sdmmcPipe.dmaAddr += blocks * MMC_SECTOR_SIZE;
+}
+#endif
+
+/* Start the data path on the next segment of the transfer */
+STATIC void armSegment(LPC_SDC_T *pSDC)
+{
+	uint32_t blocks = MIN(sdmmcPipe.blocksLeft, SDMMC_MAX_BLK);
+
+	sdmmcPipe.Transfer.BlockNum = blocks;
+	Chip_SDC_SetDataTransfer(pSDC, &sdmmcPipe.Transfer);
+	sdmmcPipe.blocksLeft -= blocks;
+	sdmmcPipe.nextBlock += blocks;
+}
+
+/* Set up the interrupts and the DMA of a block transfer, and start the data
+   path on its first segment. Fails when no GPDMA channel is free. */
+STATIC int32_t startTransfer(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, void *buffer,
+						  int32_t startBlock, int32_t blockNum, SDC_TRANSFER_DIR_T dir)
+{
+	SDMMC_EVENT_T  Event;
+
+	sdmmcPipe.Transfer.BlockSize = SDC_BLOCK_SIZE_512;
+	sdmmcPipe.Transfer.Dir = dir;
+#ifdef SDC_DMA_ENABLE
+	sdmmcPipe.Transfer.DMAUsed = true;
+#else
+	sdmmcPipe.Transfer.DMAUsed = false;
+#endif
+	sdmmcPipe.Transfer.Mode = SDC_TRANSFER_MODE_BLOCK;
+	sdmmcPipe.Transfer.Timeout = (dir == SDC_TRANSFER_DIR_FROMCARD) ? DATA_TIMER_VALUE_R : DATA_TIMER_VALUE_W;
+	sdmmcPipe.card_type = pCardInfo->card_type;
+	sdmmcPipe.nextBlock = startBlock;
+	sdmmcPipe.blocksLeft = blockNum;
+
+#ifdef SDC_DMA_ENABLE
+	/* The lowest free channel, so the card FIFO wins bus arbitration */
+	sdmmcPipe.dmaChannel = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	if (sdmmcPipe.dmaChannel < 0) {
+		return SDC_RET_NOT_READY;
+	}
+	Event.DmaChannel = sdmmcPipe.dmaChannel;
+	if (dir == SDC_TRANSFER_DIR_FROMCARD) {
+		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_RXDATAERR);
+		Chip_GPDMA_PrepareTransfer(LPC_GPDMA, &sdmmcPipe.Xfer, Event.DmaChannel, GPDMA_CONN_SDC, 0,
+								   GPDMA_TRANSFERTYPE_P2M_CONTROLLER_PERIPHERAL);
+	}
+	else {
+		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_TXDATAERR);
+		Chip_GPDMA_PrepareTransfer(LPC_GPDMA, &sdmmcPipe.Xfer, Event.DmaChannel, 0, GPDMA_CONN_SDC,
+								   GPDMA_TRANSFERTYPE_M2P_CONTROLLER_PERIPHERAL);
+	}
+
+	/* Descriptors for the first two segments, Chip_SDMMC_IRQHandler()
+	   refills them for the others */
+	sdmmcPipe.dmaAddr = (uint32_t) buffer;
+	sdmmcPipe.dmaLeft = blockNum;
+	sdmmcPipe.descNext = 0;
+	queueSegment();
+	if (sdmmcPipe.dmaLeft > 0) {
+		queueSegment();
+	}
+	Chip_GPDMA_SGTransfer(LPC_GPDMA, Event.DmaChannel, &sdmmcPipe.Desc[0],
+						  (dir == SDC_TRANSFER_DIR_FROMCARD) ? GPDMA_TRANSFERTYPE_P2M_CONTROLLER_PERIPHERAL :
+						  GPDMA_TRANSFERTYPE_M2P_CONTROLLER_PERIPHERAL);
+#else
+	if (dir == SDC_TRANSFER_DIR_FROMCARD) {
+		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_RXDATAERR | SDC_MASK0_RXFIFO);
+	}
+	else {
+		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_TXDATAERR | SDC_MASK0_TXFIFO);
+	}
+
+	Event.Buffer = buffer;
+	Event.Size = blockNum * MMC_SECTOR_SIZE;
+	Event.Index = 0;
+	Event.Dir = (dir == SDC_TRANSFER_DIR_FROMCARD) ? 1 : 0;
+#endif
+	/* Call Event Setup function */
+	pCardInfo->evsetup_cb((void *) &Event);
+
+	sdmmcPipe.state = SDMMC_PIPE_DATA;
+	armSegment(pSDC);
+	return SDC_RET_OK;
+}
+
+/* Go on once the data path has finished a segment and more are left */
+STATIC int32_t nextSegment(LPC_SDC_T *pSDC)
+{
+#ifdef SDC_DMA_ENABLE
+	/* The DMA has loaded the descriptor of the next segment, the other
+	   one is free */
+	if (sdmmcPipe.dmaLeft > 0) {
+		queueSegment();
+	}
+#endif
+
+	if (sdmmcPipe.Transfer.Dir == SDC_TRANSFER_DIR_TOCARD) {
+		/* The card waits for more blocks under the same CMD25 */
+		armSegment(pSDC);
+		return 1;
+	}
+
+	/* The card goes on sending with nothing receiving, so stop it and read
+	   on from the next segment. The data path is not re-armed while the
+	   card streams, a block could start before it is. */
+	sdmmcPipe.state = SDMMC_PIPE_STOP;
+	Chip_SDC_SetIntMask(pSDC, SDC_MASK0_CMDRESPEND | SDC_MASK0_CMDERR);
+	Chip_SDC_SetCommand(pSDC, SD_CMD12_STOP_TRANSMISSION, 0);
+	return 1;
+}
+
+/* Handle the answers to the CMD12 and CMD18 that take a read from one
+   segment to the next */
+STATIC int32_t restartRead(LPC_SDC_T *pSDC, uint32_t Status)
+{
+	SDC_RESP_T Response;
+	uint32_t Argument;
+
+	if (!(Status & (SDC_STATUS_CMDRESPEND | SDC_STATUS_CMDERR))) {
+		return 1;
+	}
+	Chip_SDC_ClearStatus(pSDC, SDC_STATUS_CMDRESPEND | SDC_STATUS_CMDERR);
+
+	/* A CRC error in the CMD12 response is ignored, as in sendCmd() */
+	if ((Status & (SDC_STATUS_CMDTIMEOUT | SDC_STATUS_STARTBITERR)) ||
+		((Status & SDC_STATUS_CMDCRCFAIL) && (sdmmcPipe.state != SDMMC_PIPE_STOP))) {
+		return -1;
+	}
+
+	if (sdmmcPipe.state == SDMMC_PIPE_STOP) {
+		/* Back in tran state, arm the data path before asking for the data */
+		if (sdmmcPipe.card_type & CARD_TYPE_HC) {
+			Argument = sdmmcPipe.nextBlock;
+		}
+		else {
+			Argument = sdmmcPipe.nextBlock << 9;
+		}
+		armSegment(pSDC);
+		sdmmcPipe.state = SDMMC_PIPE_RESTART;
+		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_CMDRESPEND | SDC_MASK0_CMDERR | SDC_MASK0_DATA | SDC_MASK0_RXDATAERR);
+		Chip_SDC_SetCommand(pSDC, SD_CMD18_READ_MULTIPLE_BLOCK, Argument);
+		return 1;
+	}
+
+	Chip_SDC_GetResp(pSDC, &Response);
+	if (R1_STATUS(Response.Data[0])) {
+		return -1;
+	}
+	sdmmcPipe.state = SDMMC_PIPE_DATA;
+	Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_RXDATAERR);
+	return 1;
+}
+
+/* End a block transfer: stop the card and the DMA, and wait for tran state */
+STATIC int32_t endTransfer(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, int32_t blockNum, int32_t Ret)
+{
+	SDC_RESP_T Response;
+
+	sdmmcPipe.state = SDMMC_PIPE_IDLE;
+	sdmmcPipe.tranKnown = false;
+	Chip_SDC_SetIntMask(pSDC, 0);
+#ifdef SDC_DMA_ENABLE
+	if (sdmmcPipe.dmaChannel >= 0) {
+		Chip_GPDMA_ReleaseChannel(LPC_GPDMA, sdmmcPipe.dmaChannel);
+		sdmmcPipe.dmaChannel = -1;
+	}
+#endif
+
+	if (Ret == SDC_RET_OK) {
+		if (blockNum > 1) {
+			/* End the open-ended command */
+			Ret = executeCmd(pSDC, SD_CMD12_STOP_TRANSMISSION, 0, &Response);
+		}
+
+		/* A read is back in tran state as the card answers */
+		if ((Ret == SDC_RET_OK) && (sdmmcPipe.Transfer.Dir == SDC_TRANSFER_DIR_FROMCARD)) {
+			sdmmcPipe.tranKnown = true;
+			sdmmcPipe.tranRCA = pCardInfo->rca;
+			return blockNum * MMC_SECTOR_SIZE;
+		}
+	}
+
+	if (Ret != SDC_RET_OK) {
+		/* Send Stop transmission command, if the card is still in the transfer */
+		stopTranmission(pSDC, pCardInfo->rca);
+	}
+
+	/* Wait for the card to finish programming and enter tran state */
+	while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_TRAN_ST) {}
+
+	if (Ret != SDC_RET_OK) {
+		return 0;
+	}
+	sdmmcPipe.tranKnown = true;
+	sdmmcPipe.tranRCA = pCardInfo->rca;
+	return blockNum * MMC_SECTOR_SIZE;
+}
+
 STATIC int32_t Chip_SDMMC_FIFOIRQHandler(LPC_SDC_T *pSDC, uint8_t *txBuf, uint32_t *txCnt,
 										 uint8_t *rxBuf, uint32_t *rxCnt)
 {
@@ -731,6 +984,17 @@ int32_t Chip_SDMMC_IRQHandler(LPC_SDC_T *pSDC, uint8_t *txBuf, uint32_t *txCnt,
 
 	Status = Chip_SDC_GetStatus(pSDC);
 
+	/* A read between two segments waits for its CMD12 or CMD18 */
+	if ((sdmmcPipe.state == SDMMC_PIPE_STOP) || (sdmmcPipe.state == SDMMC_PIPE_RESTART)) {
+		if (restartRead(pSDC, Status) < 0) {
+			Chip_SDC_SetIntMask(pSDC, 0);
+			return -1;
+		}
+		if (sdmmcPipe.state != SDMMC_PIPE_DATA) {
+			return 1;
+		}
+	}
+
 	if ( Status & SDC_STATUS_DATAERR) {
 		Chip_SDC_ClearStatus(pSDC, SDC_STATUS_DATAERR);
 		return -1;	/* Data transfer error */
@@ -738,6 +1002,9 @@ int32_t Chip_SDMMC_IRQHandler(LPC_SDC_T *pSDC, uint8_t *txBuf, uint32_t *txCnt,
 
 	if ( Status & SDC_STATUS_DATAEND) {
 		Chip_SDC_ClearStatus(pSDC, SDC_STATUS_DATAEND);
+		if ((sdmmcPipe.state == SDMMC_PIPE_DATA) && (sdmmcPipe.blocksLeft > 0)) {
+			return nextSegment(pSDC);
+		}
 		Chip_SDC_SetIntMask(pSDC, 0);
 		return 0;
 	}
@@ -781,6 +1048,9 @@ int32_t Chip_SDMMC_GetSDStatus(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, uint32_
 	uint16_t ByteNum = 64;
 	SDMMC_EVENT_T  Event;
 	SDC_DATA_TRANSFER_T Transfer;
+#ifdef SDC_DMA_ENABLE
+	int dmaChannel;
+#endif
 
 	/* Put to tran state */
 	if (setTranState(pSDC, pCardInfo->rca) != SDC_RET_OK) {
@@ -788,8 +1058,12 @@ int32_t Chip_SDMMC_GetSDStatus(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, uint32_
 	}
 
 #ifdef SDC_DMA_ENABLE
+	dmaChannel = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	if (dmaChannel < 0) {
+		return 0;
+	}
+	Event.DmaChannel = dmaChannel;
 	Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_RXDATAERR);
-	Event.DmaChannel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SDC);
 
 	/* DMA Setup */
 	Chip_GPDMA_Transfer(LPC_GPDMA, Event.DmaChannel,
@@ -834,7 +1108,7 @@ int32_t Chip_SDMMC_GetSDStatus(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo, uint32_
 
 send_end:
 #ifdef SDC_DMA_ENABLE
-	Chip_GPDMA_Stop(LPC_GPDMA, Event.DmaChannel);
+	Chip_GPDMA_ReleaseChannel(LPC_GPDMA, dmaChannel);
 #endif
 	if (Chip_SDMMC_GetCardState(pSDC, pCardInfo) == SDMMC_DATA_ST) {
 		/* Send Stop transmission command */
@@ -853,6 +1127,7 @@ int32_t Chip_SDMMC_Acquire(LPC_SDC_T *pSDC, SDMMC_CARD_T *pCardInfo)
 	int32_t Ret;
 
 	/* Initialize card info */
+	sdmmcPipe.tranKnown = false;
 	pCardInfo->speed = SDC_TRAN_CLOCK_RATE;
 	pCardInfo->card_type = 0;
 
@@ -955,120 +1230,34 @@ int32_t Chip_SDMMC_ReadBlocks(LPC_SDC_T *pSDC,
 							  int32_t startBlock,
 							  int32_t blockNum)
 {
-	int32_t Ret = SDC_RET_FAILED;
-	SDC_DATA_TRANSFER_T Transfer;
-	SDMMC_EVENT_T  Event;
-	int32_t tfr_blk_cnt, start_blk = startBlock, block_cnt = blockNum;
-	int32_t ByteNum = blockNum *  MMC_SECTOR_SIZE;
-	uint32_t buf_ptr = (uint32_t) buffer;
+	int32_t Ret;
 
 	/* if card is not acquired return immediately */
-	if (( startBlock < 0) || ( (startBlock + blockNum) > pCardInfo->blocknr) ) {
+	if (( startBlock < 0) || (blockNum <= 0) || ( (startBlock + blockNum) > pCardInfo->blocknr) ) {
 		return 0;
 	}
 
 	/* Put to tran state */
-	if (setTranState(pSDC, pCardInfo->rca) != SDC_RET_OK) {
+	if (checkTranState(pSDC, pCardInfo) != SDC_RET_OK) {
 		return 0;
 	}
 
-	/* Do data transfers in a loop */
-	Transfer.BlockSize = SDC_BLOCK_SIZE_512;
-	Transfer.Dir = SDC_TRANSFER_DIR_FROMCARD;
-#ifdef SDC_DMA_ENABLE
-	Transfer.DMAUsed = true;
-#else
-	Transfer.DMAUsed = false;
-#endif
-	Transfer.Mode = SDC_TRANSFER_MODE_BLOCK;
-	Transfer.Timeout = DATA_TIMER_VALUE_R;
-
-	while (block_cnt > 0) {
-		if (block_cnt > SDMMC_MAX_BLK) {
-			tfr_blk_cnt = SDMMC_MAX_BLK;
-		}
-		else {
-			tfr_blk_cnt = block_cnt;
-		}
-
-#ifdef SDC_DMA_ENABLE
-		/* Enable Receive interrupts */
-		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_RXDATAERR);
-
-		/* Get DMA channel */
-		Event.DmaChannel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SDC);
-
-		/* Start the DMA transfer */
-		Chip_GPDMA_Transfer(LPC_GPDMA, Event.DmaChannel,
-							GPDMA_CONN_SDC,
-							buf_ptr,
-							GPDMA_TRANSFERTYPE_P2M_CONTROLLER_PERIPHERAL,
-							(tfr_blk_cnt * MMC_SECTOR_SIZE));
-#else
-		/* Enable Receive interrupts */
-		Chip_SDC_SetIntMask(SDC_MASK0_DATA | SDC_MASK0_RXDATAERR | SDC_MASK0_RXFIFO);
-
-		Event.Buffer = buf_ptr;
-		Event.Size = (tfr_blk_cnt * MMC_SECTOR_SIZE);
-		Event.Index = 0;
-		Event.Dir = 1;
-#endif
-		/* Call Event Setup function */
-		pCardInfo->evsetup_cb((void *) &Event);
-
-		/* Set transfer information */
-		Transfer.BlockNum = tfr_blk_cnt;
-		Chip_SDC_SetDataTransfer(pSDC, &Transfer);
-
-		/* Send command for reading data */
-		Ret = readBlocks(pSDC, pCardInfo->card_type, start_blk, tfr_blk_cnt);
-		if (Ret != SDC_RET_OK) {
-			ByteNum = 0;
-			goto send_end;
-		}
+	/* The data path must be ready before the card starts sending */
+	Ret = startTransfer(pSDC, pCardInfo, buffer, startBlock, blockNum, SDC_TRANSFER_DIR_FROMCARD);
 
+	/* One command reads all the blocks, Chip_SDMMC_IRQHandler() moves
+	   from one segment to the next */
+	if (Ret == SDC_RET_OK) {
+		Ret = readBlocks(pSDC, pCardInfo->card_type, startBlock, blockNum);
+	}
+	if (Ret == SDC_RET_OK) {
 		/* Wait for transfer Finish */
 		if ((pCardInfo->waitfunc_cb()) != 0) {
-			ByteNum = 0;
-			goto send_end;
-		}
-
-#ifdef SDC_DMA_ENABLE
-		Chip_GPDMA_Stop(LPC_GPDMA, Event.DmaChannel);
-#endif
-
-		/* Send stop transmission */
-		if ((tfr_blk_cnt > 1) || (Chip_SDMMC_GetCardState(pSDC, pCardInfo) == SDMMC_DATA_ST)) {
-			/* Send Stop transmission command */
-			stopTranmission(pSDC, pCardInfo->rca);
-		}
-
-		/* Wait for card enter to tran state */
-		while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_TRAN_ST) {}
-
-		/* Update block counter, buffer address */
-		block_cnt -= tfr_blk_cnt;
-		buf_ptr += (tfr_blk_cnt * MMC_SECTOR_SIZE);
-		start_blk += tfr_blk_cnt;
-	}
-
-send_end:
-	/* Stop the DMA in case of error */
-	if (ByteNum == 0) {
-#ifdef SDC_DMA_ENABLE
-		Chip_GPDMA_Stop(LPC_GPDMA, Event.DmaChannel);
-#endif
-
-		if ((blockNum > 1) || (Chip_SDMMC_GetCardState(pSDC, pCardInfo) == SDMMC_DATA_ST)) {
-			/* Send Stop transmission command */
-			stopTranmission(pSDC, pCardInfo->rca);
+			Ret = SDC_RET_FAILED;
 		}
-
-		/* Wait for card enter to tran state */
-		while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_TRAN_ST) {}
 	}
 
-	return ByteNum;
+	return endTransfer(pSDC, pCardInfo, blockNum, Ret);
 }
 
 /* Performs write of data to the SD/MMC card */
@@ -1078,119 +1267,37 @@ int32_t Chip_SDMMC_WriteBlocks(LPC_SDC_T *pSDC,
 							   int32_t startBlock,
 							   int32_t blockNum)
 {
-	int32_t Ret = SDC_RET_FAILED;
-	SDC_DATA_TRANSFER_T Transfer;
-	SDMMC_EVENT_T  Event;
-	int32_t tfr_blk_cnt, start_blk = startBlock, block_cnt = blockNum;
-	int32_t ByteNum = blockNum *  MMC_SECTOR_SIZE;
-	uint32_t buf_ptr = (uint32_t) buffer;
+	int32_t Ret;
 
 	/* if card is not acquired return immediately */
-	if (( startBlock < 0) || ( (startBlock + blockNum) > pCardInfo->blocknr) ) {
+	if (( startBlock < 0) || (blockNum <= 0) || ( (startBlock + blockNum) > pCardInfo->blocknr) ) {
 		return 0;
 	}
 
 	/* Put to tran state */
-	if (setTranState(pSDC, pCardInfo->rca) != SDC_RET_OK) {
+	if (checkTranState(pSDC, pCardInfo) != SDC_RET_OK) {
 		return 0;
 	}
 
-	/* Do the trnasfers */
-	Transfer.BlockSize = SDC_BLOCK_SIZE_512;
-	Transfer.Dir = SDC_TRANSFER_DIR_TOCARD;
-#ifdef SDC_DMA_ENABLE
-	Transfer.DMAUsed = true;
-#else
-	Transfer.DMAUsed = false;
-#endif
-	Transfer.Mode = SDC_TRANSFER_MODE_BLOCK;
-	Transfer.Timeout = DATA_TIMER_VALUE_W;
-	while (block_cnt > 0) {
-		if (block_cnt > SDMMC_MAX_BLK) {
-			tfr_blk_cnt = SDMMC_MAX_BLK;
-		}
-		else {
-			tfr_blk_cnt = block_cnt;
-		}
-
-		/* Send Write block(s) command */
-		Ret = writeBlocks(pSDC, pCardInfo->card_type, start_blk, tfr_blk_cnt);
-		if (Ret != SDC_RET_OK) {
-			return 0;
-		}
-
-		/* Wait for card enter to rcv state */
-		while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_RCV_ST) {}
-
-#ifdef SDC_DMA_ENABLE
-		/* Enable Transmit interrupts */
-		Chip_SDC_SetIntMask(pSDC, SDC_MASK0_DATA | SDC_MASK0_TXDATAERR);
-
-		/* Get DMA channel */
-		Event.DmaChannel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SDC);
-
-		/* Start the DMA transfer */
-		Chip_GPDMA_Transfer(LPC_GPDMA, Event.DmaChannel,
-							buf_ptr,
-							GPDMA_CONN_SDC,
-							GPDMA_TRANSFERTYPE_M2P_CONTROLLER_PERIPHERAL,
-							(tfr_blk_cnt * MMC_SECTOR_SIZE));
-#else
-		/* Enable Transmit interrupts */
-		Chip_SDC_SetIntMask(SDC_MASK0_DATA | SDC_MASK0_TXDATAERR | SDC_MASK0_TXFIFO);
-
-		Event.Buffer = buf_ptr;
-		Event.Size = (tfr_blk_cnt * MMC_SECTOR_SIZE);
-		Event.Index = 0;
-		Event.Dir = 0;
-#endif
-		/* Call Event Setup function */
-		pCardInfo->evsetup_cb((void *) &Event);
-
-		/* Set transfer information */
-		Transfer.BlockNum = tfr_blk_cnt;
-		Chip_SDC_SetDataTransfer(pSDC, &Transfer);
-
-		/* Wait for transfer done */
-		if ((pCardInfo->waitfunc_cb()) != 0) {
-			ByteNum = 0;
-			goto end_send;
-		}
-
-#ifdef SDC_DMA_ENABLE
-		Chip_GPDMA_Stop(LPC_GPDMA, Event.DmaChannel);
-#endif
-
-		if ((tfr_blk_cnt > 1) || (Chip_SDMMC_GetCardState(pSDC, pCardInfo) == SDMMC_RCV_ST)) {
-			/* Send Stop transmission command */
-			stopTranmission(pSDC, pCardInfo->rca);
-		}
-
-		/*Wait for card enter to tran state*/
-		while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_TRAN_ST) {}
-
-		/* Update cnt */
-		block_cnt -= tfr_blk_cnt;
-		buf_ptr += (tfr_blk_cnt * MMC_SECTOR_SIZE);
-		start_blk += tfr_blk_cnt;
+	/* Send Write block(s) command, one for all the blocks */
+	sdmmcPipe.tranKnown = false;
+	Ret = writeBlocks(pSDC, pCardInfo->card_type, startBlock, blockNum);
+	if (Ret != SDC_RET_OK) {
+		return 0;
 	}
 
-end_send:
-	if (ByteNum == 0) {
-#ifdef SDC_DMA_ENABLE
-		Chip_GPDMA_Stop(LPC_GPDMA, Event.DmaChannel);
-#endif
+	/* Wait for card enter to rcv state */
+	while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_RCV_ST) {}
 
-		if ((blockNum > 1) || (Chip_SDMMC_GetCardState(pSDC, pCardInfo) == SDMMC_RCV_ST)) {
-			/* Send Stop transmission command */
-			stopTranmission(pSDC, pCardInfo->rca);
-		}
+	/* Chip_SDMMC_IRQHandler() moves from one segment to the next */
+	Ret = startTransfer(pSDC, pCardInfo, buffer, startBlock, blockNum, SDC_TRANSFER_DIR_TOCARD);
 
-		/* Wait for card enter to tran state */
-		while (Chip_SDMMC_GetCardState(pSDC, pCardInfo) != SDMMC_TRAN_ST) {}
+	/* Wait for transfer done */
+	if ((Ret == SDC_RET_OK) && ((pCardInfo->waitfunc_cb()) != 0)) {
+		Ret = SDC_RET_FAILED;
 	}
 
-	return ByteNum;
+	return endTransfer(pSDC, pCardInfo, blockNum, Ret);
 }
 
 #endif /* defined(CHIP_LPC177X_8X) || defined(CHIP_LPC4XX) */
@@ -139,6 +139,105 @@ STATIC CHIP_SYSCTL_PCLK_T Chip_SSP_GetClkIndex(LPC_SSP_T *pSSP)
 
 #endif
 
+/* Returns the GPDMA transmit connection of an SSP, receive is the next one */
+STATIC uint8_t Chip_SSP_GetDMAConn(LPC_SSP_T *pSSP)
+{
+	if (pSSP == LPC_SSP1) {
+		return GPDMA_CONN_SSP1_Tx;
+	}
+#if defined(CHIP_LPC177X_8X) || defined(CHIP_LPC40XX)
+	else if (pSSP == LPC_SSP2) {
+		return GPDMA_CONN_SSP2_Tx;
+	}
+#endif
+	return GPDMA_CONN_SSP0_Tx;
+}
+
+/* Releases the chip-select of a transaction */
+STATIC void Chip_SSP_DMA_Deselect(SSP_DMA_XFER_T *pXfer)
+{
+	if (pXfer->cs.port != SSP_DMA_NO_CS) {
+		Chip_GPIO_SetPinOutHigh(LPC_GPIO, pXfer->cs.port, pXfer->cs.pin);
+	}
+}
+
+/* Builds the linked lists of the transaction at the queue head and starts it */
+STATIC Status Chip_SSP_DMA_Start(SSP_DMA_CTX_T *pDMA)
+{
+	SSP_DMA_XFER_T *pXfer = pDMA->pHead;
+	LPC_GPDMA_T *pGPDMA = pDMA->pGPDMA;
+	uint32_t conn = Chip_SSP_GetDMAConn(pDMA->pSSP);
+	uint32_t tx = (uint32_t) pXfer->tx_data, rx = (uint32_t) pXfer->rx_data;
+	uint32_t left = pXfer->length, size, width, step, ctrl;
+	int i, num = (pXfer->length + 0xFFE) / 0xFFF;
+
+	/* Frames above 8 bits move as half words */
+	if (Chip_SSP_GetDataSize(pDMA->pSSP) > SSP_BITS_8) {
+		width = GPDMA_WIDTH_HALFWORD;
+		step = 2;
+	}
+	else {
+		width = GPDMA_WIDTH_BYTE;
+		step = 1;
+	}
+
+	for (i = 0; i < num; i++) {
+		size = MIN(left, 0xFFF);
+		left -= size;
+
+		Chip_GPDMA_PrepareDescriptor(pGPDMA, &pDMA->txDesc[i], (tx != 0) ? tx : (uint32_t) &pDMA->txFill,
+									 conn, size, GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA,
+									 (i + 1 < num) ? &pDMA->txDesc[i + 1] : NULL);
+		Chip_GPDMA_PrepareDescriptor(pGPDMA, &pDMA->rxDesc[i], conn + 1,
+									 (rx != 0) ? rx : (uint32_t) &pDMA->rxDrop, size,
+									 GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA,
+									 (i + 1 < num) ? &pDMA->rxDesc[i + 1] : NULL);
+
+		/* Only the end of the last receive item interrupts. A missing
+		   buffer is one frame the DMA does not step over. */
+		ctrl = pDMA->txDesc[i].ctrl & ~(GPDMA_DMACCxControl_SWidth(7) | GPDMA_DMACCxControl_DWidth(7) |
+										GPDMA_DMACCxControl_I);
+		ctrl |= GPDMA_DMACCxControl_SWidth(width) | GPDMA_DMACCxControl_DWidth(width);
+		if (tx != 0) {
+			tx += size * step;
+		}
+		else {
+			ctrl &= ~GPDMA_DMACCxControl_SI;
+		}
+		pDMA->txDesc[i].ctrl = ctrl;
+
+		ctrl = pDMA->rxDesc[i].ctrl & ~(GPDMA_DMACCxControl_SWidth(7) | GPDMA_DMACCxControl_DWidth(7));
+		ctrl |= GPDMA_DMACCxControl_SWidth(width) | GPDMA_DMACCxControl_DWidth(width);
+		if (rx != 0) {
+			rx += size * step;
+		}
+		else {
+			ctrl &= ~GPDMA_DMACCxControl_DI;
+		}
+		pDMA->rxDesc[i].ctrl = ctrl;
+	}
+
+	if (pXfer->cs.port != SSP_DMA_NO_CS) {
+		Chip_GPIO_SetPinOutLow(LPC_GPIO, pXfer->cs.port, pXfer->cs.pin);
+	}
+
+	/* Receive first, so the channel is ready for the first frame */
+	if (Chip_GPDMA_SGTransfer(pGPDMA, pDMA->rxChannel, &pDMA->rxDesc[0],
+							  GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA) == ERROR) {
+		Chip_SSP_DMA_Deselect(pXfer);
+		return ERROR;
+	}
+	if (Chip_GPDMA_SGTransfer(pGPDMA, pDMA->txChannel, &pDMA->txDesc[0],
+							  GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA) == ERROR) {
+		/* No frame has moved without the transmit channel */
+		Chip_GPDMA_ChannelCmd(pGPDMA, pDMA->rxChannel, DISABLE);
+		Chip_SSP_DMA_Deselect(pXfer);
+		return ERROR;
+	}
+
+	return SUCCESS;
+}
+
 /*****************************************************************************
  * Public functions
  ****************************************************************************/
@@ -476,3 +575,136 @@ void Chip_SSP_DeInit(LPC_SSP_T *pSSP)
 
 	Chip_Clock_DisablePeriphClock(Chip_SSP_GetClockIndex(pSSP));
 }
+
+/* Set up GPDMA transfers on an SSP */
+Status Chip_SSP_DMA_Init(SSP_DMA_CTX_T *pDMA, LPC_SSP_T *pSSP, LPC_GPDMA_T *pGPDMA)
+{
+	int txChannel, rxChannel;
+
+	memset(pDMA, 0, sizeof(SSP_DMA_CTX_T));
+	pDMA->pSSP = pSSP;
+	pDMA->pGPDMA = pGPDMA;
+	pDMA->txFill = 0xFFFF;
+
+	/* The lower channel wins on the bus, receive must not fall behind */
+	rxChannel = Chip_GPDMA_ReserveChannel(pGPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	txChannel = Chip_GPDMA_ReserveChannel(pGPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	if ((rxChannel < 0) || (txChannel < 0)) {
+		if (rxChannel >= 0) {
+			Chip_GPDMA_ReleaseChannel(pGPDMA, rxChannel);
+		}
+		return ERROR;
+	}
+	pDMA->rxChannel = rxChannel;
+	pDMA->txChannel = txChannel;
+
+	Chip_SSP_Int_FlushData(pSSP);
+	Chip_SSP_DMA_Enable(pSSP);
+
+	return SUCCESS;
+}
+
+/* Stop GPDMA transfers on an SSP */
+void Chip_SSP_DMA_DeInit(SSP_DMA_CTX_T *pDMA)
+{
+	Chip_GPDMA_ReleaseChannel(pDMA->pGPDMA, pDMA->txChannel);
+	Chip_GPDMA_ReleaseChannel(pDMA->pGPDMA, pDMA->rxChannel);
+	Chip_SSP_DMA_Disable(pDMA->pSSP);
+	Chip_SSP_Int_FlushData(pDMA->pSSP);
+
+	if (pDMA->pHead != NULL) {
+		Chip_SSP_DMA_Deselect(pDMA->pHead);
+	}
+	pDMA->pHead = pDMA->pTail = NULL;
+}
+
+/* Queue an SSP transaction (non-blocking) */
+Status Chip_SSP_DMA_Queue(SSP_DMA_CTX_T *pDMA, SSP_DMA_XFER_T *pXfer)
+{
+	uint32_t dmaIntEnabled;
+	Status status = SUCCESS;
+
+	if ((pXfer->length == 0) || (pXfer->length > SSP_DMA_MAX_FRAMES)) {
+		return ERROR;
+	}
+	pXfer->pNext = NULL;
+
+	/* The DMA interrupt takes transactions off the queue. It is only
+	   turned back on if it was on, the application may poll with it off. */
+	dmaIntEnabled = NVIC->ISER[((uint32_t) DMA_IRQn) >> 5] & (1UL << ((uint32_t) DMA_IRQn & 0x1F));
+	NVIC_DisableIRQ(DMA_IRQn);
+	if (pDMA->pHead == NULL) {
+		pDMA->pHead = pDMA->pTail = pXfer;
+		status = Chip_SSP_DMA_Start(pDMA);
+		if (status == ERROR) {
+			pDMA->pHead = pDMA->pTail = NULL;
+		}
+	}
+	else {
+		pDMA->pTail->pNext = pXfer;
+		pDMA->pTail = pXfer;
+	}
+	if (dmaIntEnabled != 0) {
+		NVIC_EnableIRQ(DMA_IRQn);
+	}
+
+	return status;
+}
+
+/* GPDMA interrupt handler for an SSP DMA context */
+void Chip_SSP_DMA_IRQHandler(SSP_DMA_CTX_T *pDMA)
+{
+	LPC_GPDMA_T *pGPDMA = pDMA->pGPDMA;
+	SSP_DMA_XFER_T *pXfer = pDMA->pHead, *pFailed, *pRunning;
+	Status status;
+
+	if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTERR, pDMA->rxChannel) ||
+		Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTERR, pDMA->txChannel)) {
+		/* Cut the transaction off, the channels stay allocated */
+		Chip_GPDMA_ChannelCmd(pGPDMA, pDMA->txChannel, DISABLE);
+		Chip_GPDMA_ChannelCmd(pGPDMA, pDMA->rxChannel, DISABLE);
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTERR, pDMA->txChannel);
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTERR, pDMA->rxChannel);
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTTC, pDMA->rxChannel);
+		Chip_SSP_Int_FlushData(pDMA->pSSP);
+		status = ERROR;
+	}
+	else if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTTC, pDMA->rxChannel)) {
+		/* The last frame is in, so the transaction is over on the bus */
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTTC, pDMA->rxChannel);
+		status = SUCCESS;
+	}
+	else {
+		return;
+	}
+
+	if (pXfer == NULL) {
+		return;
+	}
+	Chip_SSP_DMA_Deselect(pXfer);
+	pXfer->status = status;
+
+	/* Keep the bus busy before calling back. Transactions whose channels
+	   do not start are done at once with ERROR. */
+	pFailed = pDMA->pHead = pXfer->pNext;
+	while ((pDMA->pHead != NULL) && (Chip_SSP_DMA_Start(pDMA) == ERROR)) {
+		pDMA->pHead->status = ERROR;
+		pDMA->pHead = pDMA->pHead->pNext;
+	}
+	if (pDMA->pHead == NULL) {
+		pDMA->pTail = NULL;
+	}
+	pRunning = pDMA->pHead;
+
+	if (pXfer->done != NULL) {
+		pXfer->done(pDMA, pXfer);
+	}
+	while (pFailed != pRunning) {
+		/* The callback may queue the transaction again */
+		pXfer = pFailed;
+		pFailed = pFailed->pNext;
+		if (pXfer->done != NULL) {
+			pXfer->done(pDMA, pXfer);
+		}
+	}
+}
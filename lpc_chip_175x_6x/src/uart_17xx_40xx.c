@@ -38,6 +38,9 @@
 /* Autobaud status flag */
 STATIC volatile FlagStatus ABsyncSts = RESET;
 
+/* Largest GPDMA transfer size */
+#define UART_DMA_MAX_XFER   0xFFF
+
 /*****************************************************************************
  * Public types/enumerations/variables
  ****************************************************************************/
@@ -114,6 +117,55 @@ STATIC CHIP_SYSCTL_PCLK_T Chip_UART_GetClkIndex(LPC_USART_T *pUART)
 }
 #endif
 
+/* Returns the GPDMA transmit connection of a UART, receive is the next one */
+STATIC uint8_t Chip_UART_GetDMAConn(LPC_USART_T *pUART)
+{
+	if (pUART == LPC_UART1) {
+		return GPDMA_CONN_UART1_Tx;
+	}
+	else if (pUART == LPC_UART2) {
+		return GPDMA_CONN_UART2_Tx;
+	}
+	else if (pUART == LPC_UART3) {
+		return GPDMA_CONN_UART3_Tx;
+	}
+#if defined(CHIP_LPC177X_8X) || defined(CHIP_LPC40XX)
+	else if (pUART == LPC_UART4) {
+		return GPDMA_CONN_UART4_Tx;
+	}
+#endif
+	return GPDMA_CONN_UART0_Tx;
+}
+
+/* Returns the receive buffer offset the DMA writes next */
+STATIC uint32_t Chip_UART_DMA_RxPos(UART_DMA_T *pDMA)
+{
+	uint32_t pos = pDMA->pGPDMA->CH[pDMA->rxChannel].DESTADDR - (uint32_t) pDMA->rxBuf;
+
+	/* At the end only until the channel loads the first descriptor again */
+	return (pos >= pDMA->rxSize) ? 0 : pos;
+}
+
+/* Passes the bytes up to offset pos to the receive callback */
+STATIC void Chip_UART_DMA_RxFlush(UART_DMA_T *pDMA, uint32_t pos)
+{
+	uint32_t end;
+
+	while (pDMA->rxTail != pos) {
+		/* Bytes that wrap around the buffer end go in two calls */
+		end = (pos > pDMA->rxTail) ? pos : pDMA->rxSize;
+		pDMA->rxDone(pDMA, &pDMA->rxBuf[pDMA->rxTail], end - pDMA->rxTail);
+		pDMA->rxTail = (end == pDMA->rxSize) ? 0 : end;
+	}
+}
+
+/* Starts the DMA for the next part of the transmit buffer */
+STATIC Status Chip_UART_DMA_TxStart(UART_DMA_T *pDMA)
+{
+	return Chip_GPDMA_Transfer(pDMA->pGPDMA, pDMA->txChannel, (uint32_t) pDMA->txData, pDMA->txConn,
+							   GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, MIN(pDMA->txLeft, UART_DMA_MAX_XFER));
+}
+
 /*****************************************************************************
  * Public functions
  ****************************************************************************/
@@ -333,17 +385,21 @@ uint32_t Chip_UART_SendRB(LPC_USART_T *pUART, RINGBUFF_T *pRB, const void *data,
 	uint32_t ret;
 	uint8_t *p8 = (uint8_t *) data;
 
-	/* Don't let UART transmit ring buffer change in the UART IRQ handler */
-	Chip_UART_IntDisable(pUART, UART_IER_THREINT);
-
 	/* Move as much data as possible into transmit ring buffer */
 	ret = RingBuffer_InsertMult(pRB, p8, bytes);
-	Chip_UART_TXIntHandlerRB(pUART, pRB);
 
-	/* Add additional data to transmit ring buffer if possible */
-	ret += RingBuffer_InsertMult(pRB, (p8 + ret), (bytes - ret));
+	/* The IRQ handler only takes data from the ring buffer while the
+	   transmit interrupt is enabled. When it is off, this is the only
+	   consumer and can start the transfer without masking interrupts. */
+	if ((pUART->IER & UART_IER_THREINT) == 0) {
+		Chip_UART_TXIntHandlerRB(pUART, pRB);
+
+		/* Add additional data to transmit ring buffer if possible */
+		ret += RingBuffer_InsertMult(pRB, (p8 + ret), (bytes - ret));
+	}
 
-	/* Enable UART transmit interrupt */
+	/* Enable UART transmit interrupt, also when the IRQ handler has just
+	   disabled it on an empty ring buffer */
 	Chip_UART_IntEnable(pUART, UART_IER_THREINT);
 
 	return ret;
@@ -360,6 +416,12 @@ int Chip_UART_ReadRB(LPC_USART_T *pUART, RINGBUFF_T *pRB, void *data, int bytes)
 /* UART receive/transmit interrupt handler for ring buffers */
 void Chip_UART_IRQRBHandler(LPC_USART_T *pUART, RINGBUFF_T *pRXRB, RINGBUFF_T *pTXRB)
 {
+	/* Handle Autobaud interrupts first. Reading IIR clears a pending THRE
+	   interrupt, so it must not come after the transmit FIFO is refilled:
+	   a THRE raised in between would be lost and, with Chip_UART_SendRB()
+	   leaving the interrupt enabled, transmission would stall. */
+	Chip_UART_ABIntHandler(pUART);
+
 	/* Handle transmit interrupt if enabled */
 	if (pUART->IER & UART_IER_THREINT) {
 		Chip_UART_TXIntHandlerRB(pUART, pTXRB);
@@ -372,9 +434,6 @@ void Chip_UART_IRQRBHandler(LPC_USART_T *pUART, RINGBUFF_T *pRXRB, RINGBUFF_T *p
 
 	/* Handle receive interrupt */
 	Chip_UART_RXIntHandlerRB(pUART, pRXRB);
-
-    /* Handle Autobaud interrupts */
-    Chip_UART_ABIntHandler(pUART);
 }
 
 /* Determines and sets best dividers to get a target baud rate */
@@ -531,3 +590,130 @@ void Chip_UART_ABCmd(LPC_USART_T *pUART, uint32_t mode, bool autorestart, Functi
 	}
 }
 
+
+/* Start DMA transmit and receive on a UART */
+Status Chip_UART_DMA_Init(UART_DMA_T *pDMA, LPC_USART_T *pUART, LPC_GPDMA_T *pGPDMA,
+						  uint8_t *rxBuf, uint32_t rxSize,
+						  UART_DMA_RXCB_T rxDone, UART_DMA_TXCB_T txDone)
+{
+	uint32_t half = rxSize / 2;
+	int txChannel, rxChannel;
+
+	if ((rxBuf == NULL) || (rxDone == NULL) || (rxSize & 1) || (half == 0) || (half > UART_DMA_MAX_XFER)) {
+		return ERROR;
+	}
+
+	memset(pDMA, 0, sizeof(UART_DMA_T));
+	pDMA->pUART = pUART;
+	pDMA->pGPDMA = pGPDMA;
+	pDMA->rxBuf = rxBuf;
+	pDMA->rxSize = rxSize;
+	pDMA->rxDone = rxDone;
+	pDMA->txDone = txDone;
+	pDMA->txConn = Chip_UART_GetDMAConn(pUART);
+	pDMA->rxConn = pDMA->txConn + 1;
+
+	/* Receive must keep up with the line, transmit can wait */
+	rxChannel = Chip_GPDMA_ReserveChannel(pGPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	txChannel = Chip_GPDMA_ReserveChannel(pGPDMA, GPDMA_PRIO_LOW, NULL, NULL);
+	if ((rxChannel < 0) || (txChannel < 0)) {
+		if (rxChannel >= 0) {
+			Chip_GPDMA_ReleaseChannel(pGPDMA, rxChannel);
+		}
+		return ERROR;
+	}
+	pDMA->rxChannel = rxChannel;
+	pDMA->txChannel = txChannel;
+
+	/* The UART requests DMA for every received byte and for every free
+	   transmit FIFO entry */
+	Chip_UART_SetupFIFOS(pUART, (UART_FCR_FIFO_EN | UART_FCR_DMAMODE_SEL | UART_FCR_RX_RS |
+								 UART_FCR_TX_RS | UART_FCR_TRG_LEV0));
+
+	/* Receive into the two halves in turn, for good, with an interrupt
+	   at the end of each half */
+	Chip_GPDMA_PrepareDescriptor(pGPDMA, &pDMA->rxDesc[0], pDMA->rxConn, (uint32_t) rxBuf, half,
+								 GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &pDMA->rxDesc[1]);
+	Chip_GPDMA_PrepareDescriptor(pGPDMA, &pDMA->rxDesc[1], pDMA->rxConn, (uint32_t) (rxBuf + half), half,
+								 GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, &pDMA->rxDesc[0]);
+	pDMA->rxDesc[0].ctrl |= GPDMA_DMACCxControl_I;
+	pDMA->rxDesc[1].ctrl |= GPDMA_DMACCxControl_I;
+
+	return Chip_GPDMA_SGTransfer(pGPDMA, pDMA->rxChannel, &pDMA->rxDesc[0],
+								 GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+}
+
+/* Stop DMA transmit and receive on a UART */
+void Chip_UART_DMA_DeInit(UART_DMA_T *pDMA)
+{
+	Chip_GPDMA_ReleaseChannel(pDMA->pGPDMA, pDMA->rxChannel);
+	Chip_GPDMA_ReleaseChannel(pDMA->pGPDMA, pDMA->txChannel);
+	pDMA->txBusy = false;
+
+	/* Back to the FIFO set-up of Chip_UART_Init() */
+	Chip_UART_SetupFIFOS(pDMA->pUART, (UART_FCR_FIFO_EN | UART_FCR_RX_RS | UART_FCR_TX_RS));
+}
+
+/* Transmit a buffer through the UART with DMA (non-blocking) */
+Status Chip_UART_DMA_Send(UART_DMA_T *pDMA, const void *data, uint32_t bytes)
+{
+	if (pDMA->txBusy || (bytes == 0)) {
+		return ERROR;
+	}
+
+	pDMA->txData = (const uint8_t *) data;
+	pDMA->txLeft = bytes;
+	pDMA->txBusy = true;
+	if (Chip_UART_DMA_TxStart(pDMA) == ERROR) {
+		pDMA->txBusy = false;
+		return ERROR;
+	}
+
+	return SUCCESS;
+}
+
+/* GPDMA interrupt handler for a UART DMA context */
+void Chip_UART_DMA_IRQHandler(UART_DMA_T *pDMA)
+{
+	LPC_GPDMA_T *pGPDMA = pDMA->pGPDMA;
+	uint32_t sent;
+
+	/* A receive half is full */
+	if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTTC, pDMA->rxChannel)) {
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTTC, pDMA->rxChannel);
+		Chip_UART_DMA_RxFlush(pDMA, Chip_UART_DMA_RxPos(pDMA));
+	}
+	if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTERR, pDMA->rxChannel)) {
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTERR, pDMA->rxChannel);
+	}
+
+	/* A transmit transfer is done, start the next part of the buffer */
+	if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTTC, pDMA->txChannel)) {
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTTC, pDMA->txChannel);
+		sent = MIN(pDMA->txLeft, UART_DMA_MAX_XFER);
+		pDMA->txData += sent;
+		pDMA->txLeft -= sent;
+		if ((pDMA->txLeft == 0) || (Chip_UART_DMA_TxStart(pDMA) == ERROR)) {
+			pDMA->txBusy = false;
+			if (pDMA->txDone != NULL) {
+				pDMA->txDone(pDMA);
+			}
+		}
+	}
+	if (Chip_GPDMA_IntGetStatus(pGPDMA, GPDMA_STAT_INTERR, pDMA->txChannel)) {
+		Chip_GPDMA_ClearIntPending(pGPDMA, GPDMA_STATCLR_INTERR, pDMA->txChannel);
+		pDMA->txBusy = false;
+	}
+}
+
+/* Pass on received bytes once the receive line is idle */
+void Chip_UART_DMA_RxTimeout(UART_DMA_T *pDMA)
+{
+	uint32_t pos = Chip_UART_DMA_RxPos(pDMA);
+
+	/* Nothing arrived for a whole period, the line is idle */
+	if (pos == pDMA->rxLastPos) {
+		Chip_UART_DMA_RxFlush(pDMA, pos);
+	}
+	pDMA->rxLastPos = pos;
+}
@@ -0,0 +1,211 @@
+/*
+ * @brief Host benchmark of loading a CAN acceptance filter table
+ *
+ * @note
+ * Loads 1 to 512 random standard IDs of one controller into the acceptance
+ * filter, once with one Chip_CAN_InsertSTDEntry() per ID and once with one
+ * Chip_CAN_BuildAFLUT() call, starting from an empty table.  For each size
+ * it prints the CAN AF RAM and AF register accesses of both on the
+ * peripheral simulator, the host time of both against AF blocks in plain
+ * memory, and whether the BuildAFLUT() table is word for word the one
+ * Chip_CAN_SetAFLUT() writes from the same IDs sorted.
+ *
+ * @par
+ * Accesses depend only on the driver, so they are the same on every run.
+ * Host times are the best of several runs and only the ratios between
+ * columns mean anything.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/bench_can_aflut.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/can_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o bench_can_aflut
+ *   ./bench_can_aflut
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_IDS             512
+
+/* Loads per timed run, and runs of which the best is taken */
+#define TIMED_LOADS         20
+#define RUNS                5
+
+typedef enum {
+	LOAD_INSERT,
+	LOAD_BUILD
+} LOAD_T;
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static CAN_STD_ID_ENTRY_T ids[MAX_IDS], work[MAX_IDS];
+static uint32_t built[CANAF_RAM_ENTRY_NUM];
+
+/* AF blocks in plain memory, for the host timing */
+static LPC_CANAF_T plainAF;
+static LPC_CANAF_RAM_T plainRAM;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+/* n different random standard IDs on CAN1 */
+static void pickIDs(uint32_t n)
+{
+	static uint8_t taken[0x800];
+	uint32_t i, id;
+
+	memset(taken, 0, sizeof(taken));
+	for (i = 0; i < n; i++) {
+		do {
+			id = (uint32_t) rand() & 0x7FF;
+		} while (taken[id]);
+		taken[id] = 1;
+		ids[i].CtrlNo = 0;
+		ids[i].Disable = 0;
+		ids[i].ID_11 = (uint16_t) id;
+	}
+}
+
+static void clearLUT(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam)
+{
+	int i;
+
+	Chip_CAN_SetAFMode(pCANAF, CAN_AF_OFF_MODE);
+	for (i = 0; i < CANAF_RAM_ENTRY_NUM; i++) {
+		pCANAFRam->MASK[i] = 0;
+	}
+	for (i = 0; i < 5; i++) {
+		pCANAF->ENDADDR[i] = 0;
+	}
+	Chip_CAN_SetAFMode(pCANAF, CAN_AF_NORMAL_MODE);
+}
+
+static void load(LPC_CANAF_T *pCANAF, LPC_CANAF_RAM_T *pCANAFRam, uint32_t n, LOAD_T how)
+{
+	CANAF_LUT_T lut;
+	uint32_t i;
+
+	if (how == LOAD_INSERT) {
+		for (i = 0; i < n; i++) {
+			Chip_CAN_InsertSTDEntry(pCANAF, pCANAFRam, &ids[i]);
+		}
+	}
+	else {
+		memcpy(work, ids, n * sizeof(ids[0]));
+		memset(&lut, 0, sizeof(lut));
+		lut.SffSec = work;
+		lut.SffEntryNum = (uint16_t) n;
+		Chip_CAN_BuildAFLUT(pCANAF, pCANAFRam, &lut);
+	}
+}
+
+/* AF RAM and register accesses of a load into an empty table */
+static uint32_t countAccesses(uint32_t n, LOAD_T how)
+{
+	clearLUT(LPC_CANAF, LPC_CANAF_RAM);
+	Sim_ClearAccessCounts();
+	load(LPC_CANAF, LPC_CANAF_RAM, n, how);
+	return Sim_GetAccessCount(LPC_CANAF_RAM) + Sim_GetAccessCount(LPC_CANAF);
+}
+
+/* Whether the BuildAFLUT() table is the one SetAFLUT() writes from the sorted IDs */
+static int sameAsSetAFLUT(uint32_t n)
+{
+	CANAF_LUT_T lut;
+	uint32_t end, i;
+	int same;
+
+	clearLUT(LPC_CANAF, LPC_CANAF_RAM);
+	load(LPC_CANAF, LPC_CANAF_RAM, n, LOAD_BUILD);
+	end = CANAF_ENDADDR_VAL(LPC_CANAF->ENDADDR[CANAF_RAM_EFF_GRP_SEC]);
+	for (i = 0; i < end; i++) {
+		built[i] = LPC_CANAF_RAM->MASK[i];
+	}
+
+	/* work[] holds the IDs sorted by the build */
+	clearLUT(LPC_CANAF, LPC_CANAF_RAM);
+	memset(&lut, 0, sizeof(lut));
+	lut.SffSec = work;
+	lut.SffEntryNum = (uint16_t) n;
+	Chip_CAN_SetAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut);
+	same = (CANAF_ENDADDR_VAL(LPC_CANAF->ENDADDR[CANAF_RAM_EFF_GRP_SEC]) == end);
+	for (i = 0; i < end; i++) {
+		same &= (LPC_CANAF_RAM->MASK[i] == built[i]);
+	}
+	return same;
+}
+
+/* us per load into an empty table of the plain memory blocks */
+static double bestTimed(uint32_t n, LOAD_T how)
+{
+	double best = 0, start, us;
+	int run, i;
+
+	for (run = 0; run < RUNS; run++) {
+		start = now();
+		for (i = 0; i < TIMED_LOADS; i++) {
+			memset(&plainAF, 0, sizeof(plainAF));
+			memset(&plainRAM, 0, sizeof(plainRAM));
+			load(&plainAF, &plainRAM, n, how);
+		}
+		us = (now() - start) / TIMED_LOADS / 1000;
+		if ((run == 0) || (us < best)) {
+			best = us;
+		}
+	}
+	return best;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	static const uint32_t sizes[] = {1, 16, 64, 256, MAX_IDS};
+	uint32_t i, n;
+	int same, allSame = 1;
+
+	Sim_Init();
+	srand(1);
+
+	printf("standard IDs on CAN1, loaded into an empty table\n");
+	printf("          AF accesses              host us\n");
+	printf("  IDs     insert      build       insert      build   same LUT\n");
+	for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+		n = sizes[i];
+		pickIDs(n);
+		same = sameAsSetAFLUT(n);
+		allSame &= same;
+		printf("%5u   %8u   %8u   %10.1f   %8.1f   %8s\n", n, countAccesses(n, LOAD_INSERT),
+			   countAccesses(n, LOAD_BUILD), bestTimed(n, LOAD_INSERT), bestTimed(n, LOAD_BUILD),
+			   same ? "yes" : "NO");
+	}
+	return allSame ? 0 : 1;
+}
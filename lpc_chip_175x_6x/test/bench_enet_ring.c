@@ -0,0 +1,256 @@
+/*
+ * @brief Host benchmark of forwarding frames through the Ethernet rings
+ *
+ * @note
+ * Keeps frames of 64, 512 and 1514 bytes going round the ENET model of the
+ * peripheral simulator in MAC1 loopback at 100 Mbps: every frame received
+ * with Chip_ENET_Ring_Receive() is sent back by reference with
+ * Chip_ENET_Ring_Send(), polling about twice per frame time.  For each size
+ * it prints the frames per second against the line rate, whether every
+ * frame came back unchanged, and the ENET register accesses per frame.
+ *
+ * @par
+ * It then times the same receive, send and reclaim against an ENET register
+ * block in plain memory, once passing the frame on by reference and once
+ * copying it out of the pool buffer and into a transmit buffer, as a driver
+ * without the pool would.  Rates and accesses depend only on the driver and
+ * the model, so they are the same on every run.  Host times are the best of
+ * several runs and only the ratios between rows mean anything.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/bench_enet_ring.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/enet_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o bench_enet_ring
+ *   ./bench_enet_ring
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define LINE_BPS            100000000
+#define MAX_FRAME           1514
+
+/* Frames forwarded per size, and frames kept in flight */
+#define FRAMES              2000
+#define IN_FLIGHT           4
+
+/* Frames per timed run, and runs of which the best is taken */
+#define TIMED_FRAMES        (1000 * 1000)
+#define RUNS                5
+
+typedef enum {
+	FWD_REFERENCE,
+	FWD_COPY
+} FWD_T;
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static ENET_RING_T ring;
+static void *pMem;
+static uint8_t *pTxBuf;
+
+/* ENET registers in plain memory, for the host timing */
+static LPC_ENET_T plainENET;
+static uint8_t appBuf[MAX_FRAME];
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+/* Wire time of a frame with preamble, CRC and gap, in peripheral clocks */
+static uint32_t frameCycles(uint32_t len)
+{
+	return (uint32_t) (((uint64_t) (MAX(len, 60) + 4 + 8 + 12) * 8 * PCLK_HZ) / LINE_BPS);
+}
+
+static void fillFrame(uint8_t *pBuf, uint32_t len, uint32_t seed)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		pBuf[i] = (uint8_t) (i * 7 + seed);
+	}
+}
+
+static int checkFrame(const uint8_t *pBuf, uint32_t len, uint32_t wantLen)
+{
+	const uint8_t seed = pBuf[0];
+	uint32_t i;
+
+	if (len != wantLen) {
+		return 0;
+	}
+	for (i = 0; i < len; i++) {
+		if (pBuf[i] != (uint8_t) (i * 7 + seed)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Forward FRAMES frames of len bytes on the simulator, returns 0 on a bad frame */
+static int runSim(uint32_t len)
+{
+	ENET_FRAG_T frag;
+	uint8_t *pBuf;
+	uint32_t rxLen, received = 0, sent = 0, i;
+	uint64_t start;
+	double fps, lineFps;
+	int ok = 1;
+
+	Chip_ENET_Init(LPC_ETHERNET, true);
+	Chip_ENET_Ring_Init(&ring, LPC_ETHERNET, pMem, NULL);
+	LPC_ETHERNET->MAC.MAC1 |= ENET_MAC1_LOOPBACK;
+	Chip_ENET_TXEnable(LPC_ETHERNET);
+	Chip_ENET_RXEnable(LPC_ETHERNET);
+
+	Sim_ClearAccessCounts();
+	start = Sim_GetCycles();
+	for (i = 0; i < IN_FLIGHT; i++) {
+		pBuf = Chip_ENET_Ring_AllocBuf(&ring);
+		fillFrame(pBuf, len, i);
+		frag.pData = pBuf;
+		frag.len = len;
+		Chip_ENET_Ring_Send(&ring, &frag, 1, pBuf);
+		sent++;
+	}
+
+	while ((received < FRAMES) && ok) {
+		Sim_Advance(frameCycles(len) / 2);
+		while ((pBuf = Chip_ENET_Ring_Receive(&ring, &rxLen)) != NULL) {
+			received++;
+			ok &= checkFrame(pBuf, rxLen, len);
+			if (sent < FRAMES) {
+				frag.pData = pBuf;
+				frag.len = rxLen;
+				if (Chip_ENET_Ring_Send(&ring, &frag, 1, pBuf) == SUCCESS) {
+					sent++;
+					continue;
+				}
+			}
+			Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+		}
+	}
+	Chip_ENET_Ring_TxReclaim(&ring);
+	ok &= (ring.rxErrors == 0) && (ring.txErrors == 0) && (ring.rxDropped == 0);
+
+	fps = received * (double) PCLK_HZ / (double) (Sim_GetCycles() - start);
+	lineFps = (double) LINE_BPS / ((MAX(len, 60) + 4 + 8 + 12) * 8);
+	printf("%5u   %10.0f   %8.1f%%   %6s   %13.1f\n", len, fps, 100 * fps / lineFps, ok ? "yes" : "NO",
+		   (double) Sim_GetAccessCount(LPC_ETHERNET) / received);
+
+	Chip_ENET_TXDisable(LPC_ETHERNET);
+	Chip_ENET_RXDisable(LPC_ETHERNET);
+	return ok;
+}
+
+/* ns per frame received, sent on and reclaimed against the plain memory registers */
+static double runTimed(uint32_t len, FWD_T how)
+{
+	ENET_FRAG_T frag;
+	uint8_t *pBuf;
+	uint32_t rxLen, idx, i;
+	double start;
+
+	memset(&plainENET, 0, sizeof(plainENET));
+	Chip_ENET_Ring_Init(&ring, &plainENET, pMem, NULL);
+
+	start = now();
+	for (i = 0; i < TIMED_FRAMES; i++) {
+		/* The MAC stores a frame, with its CRC, size field one less */
+		idx = ring.rxConsume;
+		ring.pRxStat[idx].StatusInfo = ENET_RINFO_LAST_FLAG | (len + 4 - 1);
+		plainENET.CONTROL.RX.PRODUCEINDEX = (idx + 1) % ENET_RING_RX_DESCS;
+
+		pBuf = Chip_ENET_Ring_Receive(&ring, &rxLen);
+		if (how == FWD_REFERENCE) {
+			frag.pData = pBuf;
+			frag.len = rxLen;
+			Chip_ENET_Ring_Send(&ring, &frag, 1, pBuf);
+		}
+		else {
+			memcpy(appBuf, pBuf, rxLen);
+			Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+			memcpy(pTxBuf, appBuf, rxLen);
+			frag.pData = pTxBuf;
+			frag.len = rxLen;
+			Chip_ENET_Ring_Send(&ring, &frag, 1, NULL);
+		}
+
+		/* The MAC sends it */
+		plainENET.CONTROL.TX.CONSUMEINDEX = ring.txProduce;
+		Chip_ENET_Ring_TxReclaim(&ring);
+	}
+	return (now() - start) / TIMED_FRAMES;
+}
+
+static double bestTimed(uint32_t len, FWD_T how)
+{
+	double best = 0, ns;
+	int run;
+
+	for (run = 0; run < RUNS; run++) {
+		ns = runTimed(len, how);
+		if ((run == 0) || (ns < best)) {
+			best = ns;
+		}
+	}
+	return best;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	static const uint32_t lens[] = {64, 512, MAX_FRAME};
+	uint32_t i;
+	int ok = 1;
+
+	Sim_Init();
+	pMem = Sim_RamAlloc(ENET_RING_MEM_SIZE);
+	pTxBuf = Sim_RamAlloc(MAX_FRAME);
+	if ((pMem == NULL) || (pTxBuf == NULL)) {
+		printf("FAIL: Sim_RamAlloc()\n");
+		return 1;
+	}
+
+	printf("%d frames forwarded by reference in MAC loopback, 100 Mbps\n", FRAMES);
+	printf("bytes     frames/s   line rate   intact   ENET access/frame\n");
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		ok &= runSim(lens[i]);
+	}
+
+	printf("\nns per frame received, sent on and reclaimed, plain memory registers\n");
+	printf("bytes   by reference   copied\n");
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		printf("%5u   %12.1f   %6.1f\n", lens[i], bestTimed(lens[i], FWD_REFERENCE),
+			   bestTimed(lens[i], FWD_COPY));
+	}
+	return ok ? 0 : 1;
+}
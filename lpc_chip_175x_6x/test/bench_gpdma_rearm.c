@@ -0,0 +1,255 @@
+/*
+ * @brief Host benchmark of re-arming a GPDMA transfer, prepared or not
+ *
+ * @note
+ * Re-arms the same transfers over and over, once with Chip_GPDMA_Transfer()
+ * and once with Chip_GPDMA_StartPrepared() after one
+ * Chip_GPDMA_PrepareTransfer():
+ *   - on the GPDMA model of the peripheral simulator, 40 UART0 receive
+ *     transfers of 16 bytes at 921600 baud and 4 memory to memory transfers
+ *     of 256 bytes, checking that every byte arrives in order, and counting
+ *     the GPDMA register accesses and simulated cycles of each arm;
+ *   - against a GPDMA register block in plain memory, ADC to memory arms,
+ *     timing the host CPU.
+ *
+ * @par
+ * Accesses and cycles depend only on the driver and the model, so they are
+ * the same on every run.  Host times are the best of several runs and only
+ * the ratio of the two columns means anything; on the chip each register
+ * write is a bus access of its own, which the plain memory block hides.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/bench_gpdma_rearm.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/uart_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o bench_gpdma_rearm
+ *   ./bench_gpdma_rearm
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define CHANNEL             0
+#define BAUD                921600
+#define UART_ARMS           40
+#define UART_BYTES          16
+#define M2M_ARMS            4
+#define M2M_BYTES           256
+
+/* Simulated time per poll of the channel, about a character */
+#define STEP_CYCLES         240
+#define MAX_STEPS           10000
+
+/* Arms per timed run, and runs of which the best is taken */
+#define TIMED_ARMS          (1000 * 1000)
+#define RUNS                5
+
+typedef enum {
+	ARM_TRANSFER,
+	ARM_PREPARED
+} ARM_T;
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+/* GPDMA registers in plain memory, for the host timing */
+static LPC_GPDMA_T plainGPDMA;
+
+/* Register accesses and simulated cycles of the arms of one run */
+static uint32_t armAccesses, arms;
+static uint64_t armCycles;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+/* One arm on the simulator, counting its accesses and cycles only */
+static Status arm(ARM_T how, const GPDMA_XFER_T *pXfer, uint32_t src, uint32_t dst,
+				  GPDMA_FLOW_CONTROL_T TransferType, uint32_t Size)
+{
+	uint64_t start;
+	Status ret;
+
+	Sim_ClearAccessCounts();
+	start = Sim_GetCycles();
+	if (how == ARM_TRANSFER) {
+		ret = Chip_GPDMA_Transfer(LPC_GPDMA, CHANNEL, src, dst, TransferType, Size);
+	}
+	else {
+		ret = Chip_GPDMA_StartPrepared(LPC_GPDMA, pXfer, src, dst, Size);
+	}
+	armCycles += Sim_GetCycles() - start;
+	armAccesses += Sim_GetAccessCount(LPC_GPDMA);
+	arms++;
+	return ret;
+}
+
+/* Let the channel finish, returns 0 if it does not */
+static int waitChannel(void)
+{
+	int i;
+
+	for (i = 0; (i < MAX_STEPS) && (LPC_GPDMA->ENBLDCHNS & (1UL << CHANNEL)); i++) {
+		Sim_Advance(STEP_CYCLES);
+	}
+	return (LPC_GPDMA->ENBLDCHNS & (1UL << CHANNEL)) == 0;
+}
+
+/* UART0 receive re-arms, returns 0 when the bytes were wrong */
+static int runUART(ARM_T how, const uint8_t *pSource)
+{
+	uint8_t *pBuf = Sim_RamAlloc(UART_ARMS * UART_BYTES);
+	GPDMA_XFER_T xfer;
+	int i, ok = 1;
+
+	Chip_UART_SetupFIFOS(LPC_UART0, UART_FCR_FIFO_EN | UART_FCR_DMAMODE_SEL | UART_FCR_TRG_LEV0 |
+						 UART_FCR_RX_RS);
+	if (how == ARM_PREPARED) {
+		Chip_GPDMA_PrepareTransfer(LPC_GPDMA, &xfer, CHANNEL, GPDMA_CONN_UART0_Rx, 0,
+								   GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+	}
+
+	Sim_UART_Receive(LPC_UART0, pSource, UART_ARMS * UART_BYTES);
+	for (i = 0; (i < UART_ARMS) && ok; i++) {
+		ok = (arm(how, &xfer, GPDMA_CONN_UART0_Rx, (uint32_t) &pBuf[i * UART_BYTES],
+				  GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, UART_BYTES) == SUCCESS) && waitChannel();
+	}
+	return ok && (memcmp(pBuf, pSource, UART_ARMS * UART_BYTES) == 0);
+}
+
+/* Memory to memory re-arms, returns 0 when the bytes were wrong */
+static int runM2M(ARM_T how, const uint8_t *pSource)
+{
+	uint8_t *pBuf = Sim_RamAlloc(M2M_ARMS * M2M_BYTES);
+	GPDMA_XFER_T xfer;
+	int i, ok = 1;
+
+	if (how == ARM_PREPARED) {
+		Chip_GPDMA_PrepareTransfer(LPC_GPDMA, &xfer, CHANNEL, GPDMA_CONN_MEMORY, GPDMA_CONN_MEMORY,
+								   GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA);
+	}
+
+	for (i = 0; (i < M2M_ARMS) && ok; i++) {
+		ok = (arm(how, &xfer, (uint32_t) &pSource[i * M2M_BYTES], (uint32_t) &pBuf[i * M2M_BYTES],
+				  GPDMA_TRANSFERTYPE_M2M_CONTROLLER_DMA, M2M_BYTES) == SUCCESS) && waitChannel();
+	}
+	return ok && (memcmp(pBuf, pSource, M2M_ARMS * M2M_BYTES) == 0);
+}
+
+/* ns per ADC to memory arm against the plain memory registers */
+static double runTimed(ARM_T how)
+{
+	GPDMA_XFER_T xfer;
+	uint32_t dst = 0x2007C000;
+	double start;
+	int i;
+
+	memset(&plainGPDMA, 0, sizeof(plainGPDMA));
+	Chip_GPDMA_PrepareTransfer(&plainGPDMA, &xfer, CHANNEL, GPDMA_CONN_ADC, 0,
+							   GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+
+	start = now();
+	for (i = 0; i < TIMED_ARMS; i++) {
+		if (how == ARM_TRANSFER) {
+			Chip_GPDMA_Transfer(&plainGPDMA, CHANNEL, GPDMA_CONN_ADC, dst, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA,
+								UART_BYTES);
+		}
+		else {
+			Chip_GPDMA_StartPrepared(&plainGPDMA, &xfer, 0, dst, UART_BYTES);
+		}
+		/* The plain memory channel never runs, clear its enable for the next arm */
+		plainGPDMA.CH[CHANNEL].CONFIG = 0;
+		dst += 4;
+	}
+	return (now() - start) / TIMED_ARMS;
+}
+
+static double bestTimed(ARM_T how)
+{
+	double best = 0, ns;
+	int run;
+
+	for (run = 0; run < RUNS; run++) {
+		ns = runTimed(how);
+		if ((run == 0) || (ns < best)) {
+			best = ns;
+		}
+	}
+	return best;
+}
+
+static void printRow(const char *pName, int ok)
+{
+	printf("%-28s   %8s   %12.1f   %10.1f\n", pName, ok ? "yes" : "NO",
+		   (double) armAccesses / arms, (double) armCycles / arms);
+	armAccesses = 0;
+	armCycles = 0;
+	arms = 0;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	uint8_t *pUARTSource, *pM2MSource;
+	int i, ok, allOk = 1;
+
+	Sim_Init();
+	pUARTSource = Sim_RamAlloc(UART_ARMS * UART_BYTES);
+	pM2MSource = Sim_RamAlloc(M2M_ARMS * M2M_BYTES);
+	for (i = 0; i < UART_ARMS * UART_BYTES; i++) {
+		pUARTSource[i] = (uint8_t) (i * 7 + 3);
+	}
+	for (i = 0; i < M2M_ARMS * M2M_BYTES; i++) {
+		pM2MSource[i] = (uint8_t) (i * 13 + 1);
+	}
+
+	Chip_UART_Init(LPC_UART0);
+	Chip_UART_SetBaud(LPC_UART0, BAUD);
+	Chip_UART_ConfigData(LPC_UART0, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT);
+	Chip_GPDMA_Init(LPC_GPDMA);
+
+	printf("per arm                        in order   GPDMA access   sim cycles\n");
+	ok = runUART(ARM_TRANSFER, pUARTSource);
+	printRow("UART0 Rx, Transfer", ok);
+	allOk &= ok;
+	ok = runUART(ARM_PREPARED, pUARTSource);
+	printRow("UART0 Rx, StartPrepared", ok);
+	allOk &= ok;
+	ok = runM2M(ARM_TRANSFER, pM2MSource);
+	printRow("M2M, Transfer", ok);
+	allOk &= ok;
+	ok = runM2M(ARM_PREPARED, pM2MSource);
+	printRow("M2M, StartPrepared", ok);
+	allOk &= ok;
+
+	printf("\nns per ADC to memory arm, plain memory registers\n");
+	printf("Transfer       %6.1f\n", bestTimed(ARM_TRANSFER));
+	printf("StartPrepared  %6.1f\n", bestTimed(ARM_PREPARED));
+	return allOk ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+/*
+ * @brief Host benchmark of RINGBUF_DEFINE() ring buffers against RINGBUFF_T
+ *
+ * @note
+ * Moves bytes and 32-bit items through a ring buffer of 256 items in bursts
+ * of 16, as a UART or SSP interrupt fills a receive buffer that a task then
+ * empties, once with the RingBuffer_ functions and once with the functions
+ * of RINGBUF_DEFINE().  Each burst is 16 Insert() then 16 Pop() calls, or one
+ * InsertMult() and one PopMult() of 16 items.  It prints the time per item,
+ * inserted and popped.
+ *
+ * @par
+ * Times are the best of several runs on the host, so only the ratios between
+ * the two columns mean anything.  On the chip RingBuffer_Insert() is a call
+ * with a multiply by the item size and a load of the buffer size, which the
+ * host's faster call and multiply hide in part.  On x86-64 GCC inlines the
+ * copies of byte_rb_InsertMult() and byte_rb_PopMult() as rep movsq, which
+ * is slow to start for 16 bytes, and that row is slower than RINGBUFF_T; on
+ * the chip both are calls to memcpy().
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -Ilpc_chip_175x_6x/inc \
+ *       lpc_chip_175x_6x/test/bench_ring_buffer.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c -o bench_ring_buffer
+ *   ./bench_ring_buffer
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ring_buffer.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define RB_SIZE             256
+#define BURST               16
+
+/* Items moved per run, and runs of which the best is taken */
+#define ITEMS               (4 * 1000 * 1000)
+#define RUNS                5
+
+RINGBUF_DEFINE(byte_rb, uint8_t, RB_SIZE)
+RINGBUF_DEFINE(word_rb, uint32_t, RB_SIZE)
+
+typedef enum {
+	OP_SINGLE,
+	OP_MULT
+} OP_T;
+
+static byte_rb_T byteRing;
+static word_rb_T wordRing;
+static RINGBUFF_T genericRing;
+static uint32_t genericData[RB_SIZE];
+
+/* Read back after each run so the compiler keeps the pops */
+static volatile uint32_t sink;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+/* ns per item through RINGBUFF_T with items of itemSz bytes */
+static double runGeneric(int itemSz, OP_T op)
+{
+	uint32_t items[BURST], sum = 0;
+	double start;
+	int i, j;
+
+	RingBuffer_Init(&genericRing, genericData, itemSz, RB_SIZE);
+	for (i = 0; i < BURST; i++) {
+		items[i] = i;
+	}
+
+	start = now();
+	for (i = 0; i < ITEMS; i += BURST) {
+		if (op == OP_SINGLE) {
+			for (j = 0; j < BURST; j++) {
+				RingBuffer_Insert(&genericRing, (uint8_t *) items + j * itemSz);
+			}
+			for (j = 0; j < BURST; j++) {
+				RingBuffer_Pop(&genericRing, (uint8_t *) items + j * itemSz);
+			}
+		}
+		else {
+			RingBuffer_InsertMult(&genericRing, items, BURST);
+			RingBuffer_PopMult(&genericRing, items, BURST);
+		}
+		sum += items[0];
+	}
+	sink = sum;
+	return (now() - start) / ITEMS;
+}
+
+/* ns per item through a RINGBUF_DEFINE() ring buffer of bytes */
+static double runTypedBytes(OP_T op)
+{
+	uint8_t items[BURST];
+	uint32_t sum = 0;
+	double start;
+	int i, j;
+
+	byte_rb_Init(&byteRing);
+	for (i = 0; i < BURST; i++) {
+		items[i] = (uint8_t) i;
+	}
+
+	start = now();
+	for (i = 0; i < ITEMS; i += BURST) {
+		if (op == OP_SINGLE) {
+			for (j = 0; j < BURST; j++) {
+				byte_rb_Insert(&byteRing, items[j]);
+			}
+			for (j = 0; j < BURST; j++) {
+				byte_rb_Pop(&byteRing, &items[j]);
+			}
+		}
+		else {
+			byte_rb_InsertMult(&byteRing, items, BURST);
+			byte_rb_PopMult(&byteRing, items, BURST);
+		}
+		sum += items[0];
+	}
+	sink = sum;
+	return (now() - start) / ITEMS;
+}
+
+/* ns per item through a RINGBUF_DEFINE() ring buffer of 32-bit items */
+static double runTypedWords(OP_T op)
+{
+	uint32_t items[BURST], sum = 0;
+	double start;
+	int i, j;
+
+	word_rb_Init(&wordRing);
+	for (i = 0; i < BURST; i++) {
+		items[i] = i;
+	}
+
+	start = now();
+	for (i = 0; i < ITEMS; i += BURST) {
+		if (op == OP_SINGLE) {
+			for (j = 0; j < BURST; j++) {
+				word_rb_Insert(&wordRing, items[j]);
+			}
+			for (j = 0; j < BURST; j++) {
+				word_rb_Pop(&wordRing, &items[j]);
+			}
+		}
+		else {
+			word_rb_InsertMult(&wordRing, items, BURST);
+			word_rb_PopMult(&wordRing, items, BURST);
+		}
+		sum += items[0];
+	}
+	sink = sum;
+	return (now() - start) / ITEMS;
+}
+
+/* Best of RUNS for one row */
+static void printRow(const char *pName, int itemSz, OP_T op)
+{
+	double generic = 0, typed = 0, ns;
+	int run;
+
+	for (run = 0; run < RUNS; run++) {
+		ns = runGeneric(itemSz, op);
+		if ((run == 0) || (ns < generic)) {
+			generic = ns;
+		}
+		ns = (itemSz == 1) ? runTypedBytes(op) : runTypedWords(op);
+		if ((run == 0) || (ns < typed)) {
+			typed = ns;
+		}
+	}
+	printf("%-26s   %10.2f   %14.2f\n", pName, generic, typed);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	printf("%d item ring buffer, bursts of %d items\n", RB_SIZE, BURST);
+	printf("ns per item                  RINGBUFF_T   RINGBUF_DEFINE\n");
+	printRow("bytes, Insert/Pop", 1, OP_SINGLE);
+	printRow("bytes, InsertMult/PopMult", 1, OP_MULT);
+	printRow("words, Insert/Pop", 4, OP_SINGLE);
+	printRow("words, InsertMult/PopMult", 4, OP_MULT);
+	return 0;
+}
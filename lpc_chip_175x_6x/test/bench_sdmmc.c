@@ -0,0 +1,253 @@
+/*
+ * @brief Host benchmark of SD card block transfers, direct and through blkcache
+ *
+ * @note
+ * Runs sdmmc_17xx_40xx.c with GPDMA on the SD card interface model of the
+ * peripheral simulator, built for the LPC177x/8x, with an SDHC card on a
+ * 4 bit bus at the SD clock Chip_SDMMC_Acquire() sets.  It prints:
+ *   - MB/s (10^6 bytes per second) of sequential reads and writes made of
+ *     calls of 1 to 1024 blocks, against the bus rate of back to back
+ *     blocks with their CRC, and the SDC register accesses per call;
+ *   - operations per second of random 4 KB and 512 byte reads and writes,
+ *     calling the driver directly and through blkcache with all
+ *     BLKCACHE_MAX_SEGS segments.  A 4 KB operation is a whole segment,
+ *     which blkcache passes straight to the driver.  The 512 byte
+ *     operations fall in 16 KB, as file system metadata does, and the
+ *     blkcache rows include the BlkCache_Flush() at the end.
+ *
+ * @par
+ * Rates are in simulated time, from the model's card timing (see
+ * Sim_SDC_SetCard()), so they are the same on every run.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -no-pie -DCORE_M3 -D__USE_LPCOPEN -DCHIP_LPC177X_8X \
+ *       -DSDC_DMA_ENABLE -Ilpc_chip_175x_6x/inc -Ilpc_chip_175x_6x/host \
+ *       -Iblkcache/inc lpc_chip_175x_6x/test/bench_sdmmc.c \
+ *       blkcache/src/blkcache.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/sdmmc_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sdc_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o bench_sdmmc
+ *   ./bench_sdmmc
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+#include "blkcache.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define CARD_BLOCKS         8192
+#define MAX_BLOCKS          1024
+
+/* Calls per sequential row, fewer for the large calls */
+#define SEQ_CALLS           16
+#define SEQ_LARGE_CALLS     4
+
+/* Operations per random row, and the area of the 512 byte operations */
+#define RANDOM_OPS          64
+#define HOT_BLOCKS          32
+
+typedef enum {
+	OP_READ,
+	OP_WRITE
+} OP_T;
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static uint8_t card[CARD_BLOCKS * MMC_SECTOR_SIZE];
+static uint32_t buf[MAX_BLOCKS * MMC_SECTOR_SIZE / 4];
+static uint32_t cacheMem[BLKCACHE_MAX_SEGS * BLKCACHE_SEG_SIZE / 4];
+static SDMMC_CARD_T cardInfo;
+static BLKCACHE_T cache;
+static volatile bool sdcDone;
+static volatile int32_t sdcResult;
+static uint32_t errors;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void sdcIRQHandler(void)
+{
+	int32_t ret = Chip_SDMMC_IRQHandler(LPC_SDC, NULL, NULL, NULL, NULL);
+
+	if (ret <= 0) {
+		sdcResult = ret;
+		sdcDone = true;
+	}
+}
+
+static void evSetup(void *pEvent)
+{
+	(void) pEvent;
+	sdcDone = false;
+	sdcResult = 0;
+}
+
+static uint32_t evWait(void)
+{
+	int idle = 0;
+
+	while (!sdcDone) {
+		if (Sim_WaitForInterrupt() > 0) {
+			idle = 0;
+		}
+		else if (++idle > 100) {
+			return 1;
+		}
+	}
+	return (sdcResult == 0) ? 0 : 1;
+}
+
+static void msDelay(uint32_t time)
+{
+	Sim_Advance((uint64_t) time * (PCLK_HZ / 1000));
+}
+
+static Status sdRead(void *ctx, void *pBuf, uint32_t sector, uint32_t count)
+{
+	return (Chip_SDMMC_ReadBlocks(LPC_SDC, ctx, pBuf, sector, count) ==
+			(int32_t) (count * BLKCACHE_SECTOR_SIZE)) ? SUCCESS : ERROR;
+}
+
+static Status sdWrite(void *ctx, const void *pBuf, uint32_t sector, uint32_t count)
+{
+	return (Chip_SDMMC_WriteBlocks(LPC_SDC, ctx, (void *) pBuf, sector, count) ==
+			(int32_t) (count * BLKCACHE_SECTOR_SIZE)) ? SUCCESS : ERROR;
+}
+
+static bool setUp(void)
+{
+	if (!Sim_Init()) {
+		return false;
+	}
+	Sim_SDC_SetCard(card, CARD_BLOCKS);
+	Sim_SetIRQHandler(SDC_IRQn, sdcIRQHandler);
+	Chip_SDC_Init(LPC_SDC);
+	NVIC_EnableIRQ(SDC_IRQn);
+
+	memset(&cardInfo, 0, sizeof(cardInfo));
+	cardInfo.evsetup_cb = evSetup;
+	cardInfo.waitfunc_cb = evWait;
+	cardInfo.msdelay_func = msDelay;
+	return Chip_SDMMC_Acquire(LPC_SDC, &cardInfo) == 1;
+}
+
+static double mbps(uint64_t bytes, uint64_t cycles)
+{
+	return (double) bytes * PCLK_HZ / (double) cycles / 1e6;
+}
+
+/* Sequential calls of count blocks, returns MB/s and the accesses per call */
+static double sequential(OP_T op, uint32_t count, double *pAccesses)
+{
+	uint32_t calls = (count > 127) ? SEQ_LARGE_CALLS : SEQ_CALLS, i;
+	uint64_t start;
+	Status ret;
+
+	Sim_ClearAccessCounts();
+	start = Sim_GetCycles();
+	for (i = 0; i < calls; i++) {
+		if (op == OP_READ) {
+			ret = sdRead(&cardInfo, buf, i * count, count);
+		}
+		else {
+			ret = sdWrite(&cardInfo, buf, i * count, count);
+		}
+		errors += (ret == SUCCESS) ? 0 : 1;
+	}
+	*pAccesses = (double) Sim_GetAccessCount(LPC_SDC) / calls;
+	return mbps((uint64_t) calls * count * MMC_SECTOR_SIZE, Sim_GetCycles() - start);
+}
+
+/* Random operations of count blocks, aligned to count, within area blocks.
+   Returns operations per second. */
+static double randomOps(OP_T op, uint32_t count, uint32_t area, bool cached)
+{
+	uint32_t i, sector;
+	uint64_t start;
+	Status ret;
+
+	srand(1);
+	if (cached) {
+		BlkCache_Init(&cache, sdRead, sdWrite, &cardInfo, cacheMem, sizeof(cacheMem));
+	}
+	start = Sim_GetCycles();
+	for (i = 0; i < RANDOM_OPS; i++) {
+		sector = ((uint32_t) rand() % (area / count)) * count;
+		if (cached) {
+			ret = (op == OP_READ) ? BlkCache_Read(&cache, buf, sector, count) :
+				  BlkCache_Write(&cache, buf, sector, count);
+		}
+		else {
+			ret = (op == OP_READ) ? sdRead(&cardInfo, buf, sector, count) : sdWrite(&cardInfo, buf, sector, count);
+		}
+		errors += (ret == SUCCESS) ? 0 : 1;
+	}
+	if (cached && (BlkCache_Flush(&cache) != SUCCESS)) {
+		errors++;
+	}
+	return (double) RANDOM_OPS * PCLK_HZ / (double) (Sim_GetCycles() - start);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	static const uint32_t counts[] = {1, 8, 64, 127, 128, 254, 1024};
+	uint32_t div, i;
+	double sdClk, busRate, readRate, writeRate, readAcc, writeAcc;
+
+	if (!setUp()) {
+		printf("FAIL: card not acquired\n");
+		return 1;
+	}
+
+	/* Back to back blocks: 1024 data clocks on 4 lines, 16 CRC clocks,
+	   start and end bits */
+	div = LPC_SDC->CLOCK & SDC_CLOCK_CLKDIV_BITMASK;
+	sdClk = (double) PCLK_HZ / (2 * (div + 1));
+	busRate = MMC_SECTOR_SIZE * sdClk / (2 * MMC_SECTOR_SIZE + 18) / 1e6;
+
+	printf("Sequential transfers, SD clock %.1f MHz, 4 bit bus, %.2f MB/s bus rate\n", sdClk / 1e6, busRate);
+	printf("blocks/call   read MB/s   bus rate   write MB/s   SDC access/call read   write\n");
+	for (i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+		readRate = sequential(OP_READ, counts[i], &readAcc);
+		writeRate = sequential(OP_WRITE, counts[i], &writeAcc);
+		printf("%11u   %9.2f   %7.1f%%   %10.2f   %20.0f   %5.0f\n", counts[i], readRate,
+			   100 * readRate / busRate, writeRate, readAcc, writeAcc);
+	}
+
+	printf("\nRandom operations per second, %d operations per row\n", RANDOM_OPS);
+	printf("operation                  direct   blkcache\n");
+	printf("4 KB reads, whole card   %8.0f   %8.0f\n", randomOps(OP_READ, 8, CARD_BLOCKS, false),
+		   randomOps(OP_READ, 8, CARD_BLOCKS, true));
+	printf("4 KB writes, whole card  %8.0f   %8.0f\n", randomOps(OP_WRITE, 8, CARD_BLOCKS, false),
+		   randomOps(OP_WRITE, 8, CARD_BLOCKS, true));
+	printf("512 B reads, 16 KB       %8.0f   %8.0f\n", randomOps(OP_READ, 1, HOT_BLOCKS, false),
+		   randomOps(OP_READ, 1, HOT_BLOCKS, true));
+	printf("512 B writes, 16 KB      %8.0f   %8.0f\n", randomOps(OP_WRITE, 1, HOT_BLOCKS, false),
+		   randomOps(OP_WRITE, 1, HOT_BLOCKS, true));
+
+	if (errors > 0) {
+		printf("FAIL: %u transfers failed\n", errors);
+		return 1;
+	}
+	return 0;
+}
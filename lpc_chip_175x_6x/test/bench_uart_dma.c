@@ -0,0 +1,238 @@
+/*
+ * @brief Host benchmark of UART DMA against the UART ring buffer interrupt
+ *
+ * @note
+ * Runs the same full duplex traffic at 921600 baud through two UARTs of the
+ * peripheral simulator: 4000 bytes received while 8200 are sent.  UART0 uses
+ * Chip_UART_DMA_Init() with a 128 byte receive buffer and
+ * Chip_UART_DMA_RxTimeout() on a 50 us timer, UART1 uses
+ * Chip_UART_IRQRBHandler() with 256 byte ring buffers and receive trigger
+ * level 2.  For each it prints whether every byte arrived in order, and the
+ * interrupts taken and driver register accesses made, which stand for the CPU
+ * load.  A last row checks that a 5 byte message is passed on by the timeout.
+ *
+ * @par
+ * Interrupts and register accesses depend only on the drivers and the models,
+ * not on the host, so the numbers are the same on every run.  The DMA path's
+ * timer interrupts are one per period for as long as it runs, so a longer
+ * timeout period trades them for a later delivery of short messages.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/bench_uart_dma.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/uart_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/timer_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o bench_uart_dma
+ *   ./bench_uart_dma
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define BAUD                921600
+#define RX_BYTES            4000
+#define TX_BYTES            8200
+#define DMA_RX_SIZE         128
+#define RB_SIZE             256
+
+/* Timeout period, about 4.6 character times, in 24 MHz timer clocks */
+#define TIMEOUT_CLOCKS      (24 * 50)
+
+/* Simulated time per step of the main loop, about one character */
+#define STEP_CYCLES         240
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static UART_DMA_T *pUartDMA;
+static RINGBUFF_T rxRing, txRing;
+static uint8_t rxRingData[RB_SIZE], txRingData[RB_SIZE];
+
+static uint8_t *pRxSource, *pTxSource;
+static uint8_t received[RX_BYTES], transmitted[TX_BYTES];
+static int numReceived, rxCalls, txDoneCalls;
+static int dmaIRQs, timerIRQs, uartIRQs;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void rxDone(UART_DMA_T *pDMA, const uint8_t *data, uint32_t len)
+{
+	(void) pDMA;
+	len = MIN(len, (uint32_t) (RX_BYTES - numReceived));
+	memcpy(&received[numReceived], data, len);
+	numReceived += len;
+	rxCalls++;
+}
+
+static void txDone(UART_DMA_T *pDMA)
+{
+	(void) pDMA;
+	txDoneCalls++;
+}
+
+static void dmaIRQHandler(void)
+{
+	dmaIRQs++;
+	Chip_UART_DMA_IRQHandler(pUartDMA);
+}
+
+static void timer0IRQHandler(void)
+{
+	timerIRQs++;
+	Chip_TIMER_ClearMatch(LPC_TIMER0, 0);
+	Chip_UART_DMA_RxTimeout(pUartDMA);
+}
+
+static void uart1IRQHandler(void)
+{
+	uartIRQs++;
+	Chip_UART_IRQRBHandler(LPC_UART1, &rxRing, &txRing);
+}
+
+static void setupUART(LPC_USART_T *pUART)
+{
+	Chip_UART_Init(pUART);
+	Chip_UART_SetBaud(pUART, BAUD);
+	Chip_UART_ConfigData(pUART, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT);
+	Chip_UART_TXEnable(pUART);
+}
+
+static int checkBytes(int numTransmitted)
+{
+	return (numReceived == RX_BYTES) && (memcmp(received, pRxSource, RX_BYTES) == 0) &&
+		   (numTransmitted == TX_BYTES) && (memcmp(transmitted, pTxSource, TX_BYTES) == 0);
+}
+
+/* UART0 through Chip_UART_DMA_Init(), returns 0 when the bytes were wrong */
+static int runDMA(void)
+{
+	uint8_t *pRxBuf = Sim_RamAlloc(DMA_RX_SIZE);
+	int i, numTransmitted = 0, ok;
+
+	pUartDMA = Sim_RamAlloc(sizeof(UART_DMA_T));
+	setupUART(LPC_UART0);
+	Chip_GPDMA_Init(LPC_GPDMA);
+	if (Chip_UART_DMA_Init(pUartDMA, LPC_UART0, LPC_GPDMA, pRxBuf, DMA_RX_SIZE, rxDone, txDone) != SUCCESS) {
+		printf("FAIL: Chip_UART_DMA_Init()\n");
+		return 0;
+	}
+	Sim_SetIRQHandler(DMA_IRQn, dmaIRQHandler);
+	NVIC_EnableIRQ(DMA_IRQn);
+
+	Chip_TIMER_Init(LPC_TIMER0);
+	Chip_TIMER_PrescaleSet(LPC_TIMER0, 0);
+	Chip_TIMER_SetMatch(LPC_TIMER0, 0, TIMEOUT_CLOCKS - 1);
+	Chip_TIMER_MatchEnableInt(LPC_TIMER0, 0);
+	Chip_TIMER_ResetOnMatchEnable(LPC_TIMER0, 0);
+	Chip_TIMER_Reset(LPC_TIMER0);
+	Sim_SetIRQHandler(TIMER0_IRQn, timer0IRQHandler);
+	NVIC_EnableIRQ(TIMER0_IRQn);
+	Chip_TIMER_Enable(LPC_TIMER0);
+
+	Sim_ClearAccessCounts();
+	Sim_UART_Receive(LPC_UART0, pRxSource, RX_BYTES);
+	Chip_UART_DMA_Send(pUartDMA, pTxSource, TX_BYTES);
+	for (i = 0; i < (TX_BYTES + 200) * 11 / 10; i++) {
+		Sim_Advance(STEP_CYCLES);
+		numTransmitted += Sim_UART_Transmitted(LPC_UART0, &transmitted[numTransmitted], TX_BYTES - numTransmitted);
+	}
+	ok = checkBytes(numTransmitted) && (txDoneCalls == 1) && !Chip_UART_DMA_TxBusy(pUartDMA);
+
+	printf("%-18s   %8s   %10d   %8d   %10u\n", "GPDMA, rx timeout", ok ? "yes" : "NO", dmaIRQs + timerIRQs,
+		   rxCalls, Sim_GetAccessCount(LPC_UART0) + Sim_GetAccessCount(LPC_GPDMA) +
+		   Sim_GetAccessCount(LPC_TIMER0));
+	printf("  of which %d GPDMA and %d timer interrupts\n", dmaIRQs, timerIRQs);
+	return ok;
+}
+
+/* A short message must be passed on by the timeout, returns 0 if not */
+static int runShortMessage(void)
+{
+	int i, ok;
+
+	numReceived = 0;
+	rxCalls = 0;
+	Sim_UART_Receive(LPC_UART0, (const uint8_t *) "hello", 5);
+	for (i = 0; i < 20; i++) {
+		Sim_Advance(STEP_CYCLES);
+	}
+	ok = (numReceived == 5) && (memcmp(received, "hello", 5) == 0);
+
+	Chip_UART_DMA_DeInit(pUartDMA);
+	Chip_TIMER_Disable(LPC_TIMER0);
+	return ok;
+}
+
+/* UART1 through Chip_UART_IRQRBHandler(), returns 0 when the bytes were wrong */
+static int runRingBuffer(void)
+{
+	int i, numSent = 0, numTransmitted = 0, ok;
+
+	RingBuffer_Init(&rxRing, rxRingData, 1, RB_SIZE);
+	RingBuffer_Init(&txRing, txRingData, 1, RB_SIZE);
+	setupUART(LPC_UART1);
+	Chip_UART_SetupFIFOS(LPC_UART1, UART_FCR_FIFO_EN | UART_FCR_TRG_LEV2);
+	Chip_UART_IntEnable(LPC_UART1, UART_IER_RBRINT | UART_IER_RLSINT);
+	Sim_SetIRQHandler(UART1_IRQn, uart1IRQHandler);
+	NVIC_EnableIRQ(UART1_IRQn);
+
+	numReceived = 0;
+	Sim_ClearAccessCounts();
+	Sim_UART_Receive(LPC_UART1, pRxSource, RX_BYTES);
+	for (i = 0; (i < 100000) && ((numTransmitted < TX_BYTES) || (numReceived < RX_BYTES)); i++) {
+		if (numSent < TX_BYTES) {
+			numSent += Chip_UART_SendRB(LPC_UART1, &txRing, &pTxSource[numSent], TX_BYTES - numSent);
+		}
+		Sim_Advance(STEP_CYCLES);
+		numReceived += Chip_UART_ReadRB(LPC_UART1, &rxRing, &received[numReceived], RX_BYTES - numReceived);
+		numTransmitted += Sim_UART_Transmitted(LPC_UART1, &transmitted[numTransmitted], TX_BYTES - numTransmitted);
+	}
+	ok = checkBytes(numTransmitted);
+
+	printf("%-18s   %8s   %10d   %8s   %10u\n", "IRQ, ring buffer", ok ? "yes" : "NO", uartIRQs, "-",
+		   Sim_GetAccessCount(LPC_UART1));
+	return ok;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	int i, ok, shortOk;
+
+	Sim_Init();
+	pRxSource = Sim_RamAlloc(RX_BYTES);
+	pTxSource = Sim_RamAlloc(TX_BYTES);
+	for (i = 0; i < RX_BYTES; i++) {
+		pRxSource[i] = (uint8_t) (i * 7 + 3);
+	}
+	for (i = 0; i < TX_BYTES; i++) {
+		pTxSource[i] = (uint8_t) (i * 13 + 1);
+	}
+
+	printf("%d baud, %d bytes received while %d are sent\n", BAUD, RX_BYTES, TX_BYTES);
+	printf("path                 in order   interrupts   rx calls   reg access\n");
+	ok = runDMA();
+	shortOk = runShortMessage();
+	ok &= runRingBuffer();
+	printf("5 byte message passed on by the timeout: %s\n", shortOk ? "yes" : "NO");
+	return (ok && shortOk) ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/*
+ * @brief Host benchmark of the udpip stack in MAC loopback
+ *
+ * @note
+ * Sends datagrams of 18, 512 and 1472 bytes to the stack's own address on
+ * the ENET model of the peripheral simulator, with MAC1 loopback on at
+ * 100 Mbps, keeping a few in flight and polling with UdpIp_Poll() about
+ * twice per frame time.  For each size it prints the datagrams per second
+ * against the line rate, whether every datagram reached the bound port
+ * intact with no errors, drops or pool buffers lost, and the ENET register
+ * accesses per datagram.
+ *
+ * @par
+ * It then times UdpIp_Checksum() on the host against a bytewise loop over a
+ * full 1472 byte payload.  Rates and accesses depend only on the stack, the
+ * driver and the model, so they are the same on every run.  Host times are
+ * the best of several runs and only their ratio means anything.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host -Iudpip/inc lpc_chip_175x_6x/test/bench_udpip.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/enet_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c udpip/src/udpip.c -o bench_udpip
+ *   ./bench_udpip
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+#include "udpip.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define LINE_BPS            100000000
+#define OUR_IP              UDPIP_IPADDR(192, 168, 1, 10)
+#define PORT                5000
+
+/* Datagrams per size, and datagrams kept in flight */
+#define DATAGRAMS           5000
+#define IN_FLIGHT           4
+
+/* Checksums per timed run, and runs of which the best is taken */
+#define TIMED_SUMS          (100 * 1000)
+#define RUNS                5
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static const uint8_t ourMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x0A};
+
+static ENET_RING_T ring;
+static UDPIP_T stack;
+static void *pMem;
+static uint8_t sumBuf[UDPIP_MAX_PAYLOAD];
+
+/* Datagrams received, and whether all were as sent */
+static uint32_t received, wantLen;
+static int intact;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static double now(void)
+{
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double) time.tv_sec * 1e9 + (double) time.tv_nsec;
+}
+
+/* Wire time of a frame with preamble, CRC and gap, in peripheral clocks */
+static uint32_t frameCycles(uint32_t len)
+{
+	return (uint32_t) (((uint64_t) (MAX(len, 60) + 4 + 8 + 12) * 8 * PCLK_HZ) / LINE_BPS);
+}
+
+static void datagramReceived(UDPIP_T *pStack, const uint8_t *pData, uint32_t len,
+							 uint32_t srcIp, uint16_t srcPort, void *ctx)
+{
+	uint32_t i;
+
+	if (len != wantLen) {
+		intact = 0;
+	}
+	for (i = 0; (i < len) && intact; i++) {
+		if (pData[i] != (uint8_t) (i * 7 + pData[0])) {
+			intact = 0;
+		}
+	}
+	received++;
+}
+
+/* Send one datagram of len bytes, returns 0 if the pool is empty */
+static int sendOne(uint32_t len, uint32_t seed)
+{
+	uint8_t *p = UdpIp_AllocPayload(&stack);
+	uint32_t i;
+
+	if (p == NULL) {
+		return 0;
+	}
+	for (i = 0; i < len; i++) {
+		p[i] = (uint8_t) (i * 7 + seed);
+	}
+	return UdpIp_SendTo(&stack, p, len, OUR_IP, PORT, PORT) == SUCCESS;
+}
+
+/* Send DATAGRAMS datagrams of len bytes to ourselves, returns 0 on a fault */
+static int runSim(uint32_t len)
+{
+	uint32_t frameLen = UDPIP_HDR_LEN + len, sent = 0, poolBufs;
+	uint64_t start;
+	double pps, linePps;
+	int ok;
+
+	Chip_ENET_Init(LPC_ETHERNET, true);
+	Chip_ENET_Ring_Init(&ring, LPC_ETHERNET, pMem, NULL);
+	LPC_ETHERNET->MAC.MAC1 |= ENET_MAC1_LOOPBACK;
+	Chip_ENET_TXEnable(LPC_ETHERNET);
+	Chip_ENET_RXEnable(LPC_ETHERNET);
+	UdpIp_Init(&stack, &ring, ourMac, OUR_IP, UDPIP_IPADDR(255, 255, 255, 0), 0);
+	UdpIp_Bind(&stack, PORT, datagramReceived, NULL);
+	poolBufs = ring.freeCount;
+
+	received = 0;
+	wantLen = len;
+	intact = 1;
+	Sim_ClearAccessCounts();
+	start = Sim_GetCycles();
+	while (received < DATAGRAMS) {
+		while ((sent < DATAGRAMS) && (sent - received < IN_FLIGHT) && sendOne(len, sent)) {
+			sent++;
+		}
+		Sim_Advance(frameCycles(frameLen) / 2);
+		UdpIp_Poll(&stack);
+	}
+	pps = received * (double) PCLK_HZ / (double) (Sim_GetCycles() - start);
+	linePps = (double) LINE_BPS / ((MAX(frameLen, 60) + 4 + 8 + 12) * 8);
+
+	ok = intact && (stack.rxErrors == 0) && (stack.rxUnhandled == 0) && (stack.txDropped == 0) &&
+		 (ring.freeCount == poolBufs);
+	printf("%5u   %11.0f   %8.1f%%   %6s   %13.1f\n", len, pps, 100 * pps / linePps, ok ? "yes" : "NO",
+		   (double) Sim_GetAccessCount(LPC_ETHERNET) / received);
+
+	Chip_ENET_TXDisable(LPC_ETHERNET);
+	Chip_ENET_RXDisable(LPC_ETHERNET);
+	return ok;
+}
+
+/* The plain bytewise sum of big endian halfwords */
+static uint32_t bytewiseSum(const uint8_t *p, uint32_t len)
+{
+	uint32_t sum = 0, i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += ((uint32_t) p[i] << 8) | p[i + 1];
+	}
+	if (i < len) {
+		sum += (uint32_t) p[i] << 8;
+	}
+	while (sum > 0xFFFF) {
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	}
+	return sum;
+}
+
+/* ns per checksum of the payload buffer, the result kept in *pSum */
+static double runTimed(int bytewise, volatile uint32_t *pSum)
+{
+	double start;
+	int i;
+
+	start = now();
+	for (i = 0; i < TIMED_SUMS; i++) {
+		sumBuf[0] = (uint8_t) i;
+		*pSum = bytewise ? bytewiseSum(sumBuf, sizeof(sumBuf)) : UdpIp_Checksum(sumBuf, sizeof(sumBuf), 0);
+	}
+	return (now() - start) / TIMED_SUMS;
+}
+
+static double bestTimed(int bytewise)
+{
+	volatile uint32_t sum;
+	double best = 0, ns;
+	int run;
+
+	for (run = 0; run < RUNS; run++) {
+		ns = runTimed(bytewise, &sum);
+		if ((run == 0) || (ns < best)) {
+			best = ns;
+		}
+	}
+	return best;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	static const uint32_t lens[] = {18, 512, UDPIP_MAX_PAYLOAD};
+	double fast, slow;
+	uint32_t i;
+	int ok = 1;
+
+	Sim_Init();
+	pMem = Sim_RamAlloc(ENET_RING_MEM_SIZE);
+	if (pMem == NULL) {
+		printf("FAIL: Sim_RamAlloc()\n");
+		return 1;
+	}
+
+	printf("%d datagrams to the own address in MAC loopback, 100 Mbps\n", DATAGRAMS);
+	printf("bytes   datagrams/s   line rate   intact   ENET access/dgram\n");
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		ok &= runSim(lens[i]);
+	}
+
+	for (i = 0; i < sizeof(sumBuf); i++) {
+		sumBuf[i] = (uint8_t) (i * 13 + 5);
+	}
+	fast = bestTimed(0);
+	slow = bestTimed(1);
+	printf("\nns per checksum of %u bytes, host CPU\n", (unsigned) sizeof(sumBuf));
+	printf("UdpIp_Checksum   %6.1f\n", fast);
+	printf("bytewise         %6.1f   (%.1fx)\n", slow, slow / fast);
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/*
+ * @brief Host test of the blkcache write-back sector cache
+ *
+ * @note
+ * Runs blkcache/ over a RAM disk that counts its calls, and checks that:
+ *   - BlkCache_Init() refuses memory smaller than one segment and NULL
+ *     pointers, and that a refused or zeroed cache returns ERROR from
+ *     BlkCache_Read(), BlkCache_Write() and BlkCache_Flush() without
+ *     calling the device;
+ *   - sector by sector reads cost one device call per segment;
+ *   - small writes reach the device only on BlkCache_Flush(), one call per
+ *     run of dirty sectors, and never read it;
+ *   - a device error is returned;
+ *   - 20000 random reads and writes of 1 to 20 sectors read back what was
+ *     written, and the disk matches after BlkCache_Flush().
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc -Iblkcache/inc \
+ *       lpc_chip_175x_6x/test/test_blkcache.c blkcache/src/blkcache.c \
+ *       -o test_blkcache
+ *   ./test_blkcache
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "lpc_types.h"
+#include "blkcache.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define DISK_SECTORS        4096
+#define RANDOM_OPS          20000
+#define MAX_COUNT           20
+
+/* RAM disk with the calls it got */
+typedef struct {
+	uint8_t data[DISK_SECTORS * BLKCACHE_SECTOR_SIZE];
+	uint32_t reads;
+	uint32_t writes;
+	uint32_t badCalls;
+	bool fail;
+} DISK_T;
+
+static DISK_T disk;
+static uint8_t shadow[DISK_SECTORS * BLKCACHE_SECTOR_SIZE];
+static uint32_t cacheMem[BLKCACHE_MAX_SEGS * BLKCACHE_SEG_SIZE / 4];
+static uint32_t buf[MAX_COUNT * BLKCACHE_SECTOR_SIZE / 4];
+static BLKCACHE_T cache;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static Status diskRead(void *ctx, void *pBuf, uint32_t sector, uint32_t count)
+{
+	DISK_T *pDisk = ctx;
+
+	pDisk->reads++;
+	if ((count == 0) || (sector + count > DISK_SECTORS)) {
+		pDisk->badCalls++;
+		return ERROR;
+	}
+	if (pDisk->fail) {
+		return ERROR;
+	}
+	memcpy(pBuf, &pDisk->data[sector * BLKCACHE_SECTOR_SIZE], count * BLKCACHE_SECTOR_SIZE);
+	return SUCCESS;
+}
+
+static Status diskWrite(void *ctx, const void *pBuf, uint32_t sector, uint32_t count)
+{
+	DISK_T *pDisk = ctx;
+
+	pDisk->writes++;
+	if ((count == 0) || (sector + count > DISK_SECTORS)) {
+		pDisk->badCalls++;
+		return ERROR;
+	}
+	if (pDisk->fail) {
+		return ERROR;
+	}
+	memcpy(&pDisk->data[sector * BLKCACHE_SECTOR_SIZE], pBuf, count * BLKCACHE_SECTOR_SIZE);
+	return SUCCESS;
+}
+
+/* Fill the disk and its shadow with the same pattern */
+static void resetDisk(void)
+{
+	uint32_t i;
+
+	memset(&disk, 0, sizeof(disk));
+	for (i = 0; i < sizeof(disk.data); i++) {
+		disk.data[i] = (uint8_t) (i * 7 + (i >> 9));
+	}
+	memcpy(shadow, disk.data, sizeof(shadow));
+}
+
+static void fill(void *pBuf, uint32_t count, uint32_t seed)
+{
+	uint8_t *p = pBuf;
+	uint32_t i;
+
+	for (i = 0; i < count * BLKCACHE_SECTOR_SIZE; i++) {
+		p[i] = (uint8_t) (seed + i * 13);
+	}
+}
+
+static void testInit(void)
+{
+	static BLKCACHE_T zeroed;
+
+	resetDisk();
+	CHECK(BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, BLKCACHE_SEG_SIZE - 1) == 0,
+		  "memory smaller than a segment taken");
+	CHECK(BlkCache_Read(&cache, buf, 0, 1) == ERROR, "refused cache read");
+	CHECK(BlkCache_Read(&cache, buf, 0, BLKCACHE_SEG_SECTORS) == ERROR, "refused cache large read");
+	CHECK(BlkCache_Write(&cache, buf, 0, 1) == ERROR, "refused cache written");
+	CHECK(BlkCache_Flush(&cache) == ERROR, "refused cache flushed");
+	CHECK(BlkCache_Read(&zeroed, buf, 0, 1) == ERROR, "zeroed cache read");
+	CHECK(BlkCache_Write(&zeroed, buf, 0, BLKCACHE_SEG_SECTORS) == ERROR, "zeroed cache written");
+	CHECK(BlkCache_Flush(&zeroed) == ERROR, "zeroed cache flushed");
+	CHECK((disk.reads == 0) && (disk.writes == 0), "refused caches called the device %u times",
+		  disk.reads + disk.writes);
+
+	CHECK(BlkCache_Init(&cache, diskRead, diskWrite, &disk, NULL, sizeof(cacheMem)) == 0, "NULL memory taken");
+	CHECK(BlkCache_Init(&cache, NULL, diskWrite, &disk, cacheMem, sizeof(cacheMem)) == 0, "NULL read taken");
+	CHECK(BlkCache_Init(&cache, diskRead, NULL, &disk, cacheMem, sizeof(cacheMem)) == 0, "NULL write taken");
+
+	CHECK(BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, BLKCACHE_SEG_SIZE) == 1,
+		  "one segment refused");
+	CHECK(BlkCache_Read(&cache, buf, 3, 1) == SUCCESS, "one segment cache read");
+	CHECK(BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, sizeof(cacheMem) + BLKCACHE_SEG_SIZE) ==
+		  BLKCACHE_MAX_SEGS, "segments not capped at BLKCACHE_MAX_SEGS");
+}
+
+static void testReadAhead(void)
+{
+	uint32_t i;
+	int same = 1;
+
+	resetDisk();
+	BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, sizeof(cacheMem));
+	for (i = 100; i < 164; i++) {
+		CHECK(BlkCache_Read(&cache, buf, i, 1) == SUCCESS, "read of sector %u", i);
+		same &= (memcmp(buf, &shadow[i * BLKCACHE_SECTOR_SIZE], BLKCACHE_SECTOR_SIZE) == 0);
+	}
+	CHECK(same, "sequential reads differ from the disk");
+
+	/* The first read is not known to be sequential yet. The second reads
+	   101 to 103, the end of its segment, and each of the 8 segments after
+	   it costs one call. */
+	CHECK(disk.reads == 10, "%u device reads for 64 sequential sectors", disk.reads);
+	CHECK(cache.readAhead == 2 + 8 * (BLKCACHE_SEG_SECTORS - 1), "%u sectors read ahead", cache.readAhead);
+}
+
+static void testWriteBack(void)
+{
+	uint32_t i;
+
+	resetDisk();
+	BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, sizeof(cacheMem));
+
+	/* Sectors 16-18 and 20-23 of one segment, and 40 */
+	for (i = 16; i < 24; i++) {
+		if (i != 19) {
+			fill(buf, 1, i);
+			memcpy(&shadow[i * BLKCACHE_SECTOR_SIZE], buf, BLKCACHE_SECTOR_SIZE);
+			CHECK(BlkCache_Write(&cache, buf, i, 1) == SUCCESS, "write of sector %u", i);
+		}
+	}
+	fill(buf, 1, 40);
+	memcpy(&shadow[40 * BLKCACHE_SECTOR_SIZE], buf, BLKCACHE_SECTOR_SIZE);
+	CHECK(BlkCache_Write(&cache, buf, 40, 1) == SUCCESS, "write of sector 40");
+	CHECK((disk.reads == 0) && (disk.writes == 0), "small writes called the device, %u reads, %u writes",
+		  disk.reads, disk.writes);
+
+	CHECK(BlkCache_Flush(&cache) == SUCCESS, "flush");
+	CHECK((disk.reads == 0) && (disk.writes == 3), "flush took %u reads, %u writes", disk.reads, disk.writes);
+	CHECK(memcmp(disk.data, shadow, sizeof(shadow)) == 0, "disk differs after the flush");
+
+	CHECK(BlkCache_Flush(&cache) == SUCCESS, "second flush");
+	CHECK(disk.writes == 3, "clean cache wrote %u times", disk.writes - 3);
+}
+
+static void testDeviceError(void)
+{
+	resetDisk();
+	BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, sizeof(cacheMem));
+	CHECK(BlkCache_Write(&cache, buf, 5, 1) == SUCCESS, "small write");
+
+	disk.fail = true;
+	CHECK(BlkCache_Read(&cache, buf, 200, 1) == ERROR, "failed small read");
+	CHECK(BlkCache_Read(&cache, buf, 200, BLKCACHE_SEG_SECTORS) == ERROR, "failed large read");
+	CHECK(BlkCache_Write(&cache, buf, 200, BLKCACHE_SEG_SECTORS) == ERROR, "failed large write");
+	CHECK(BlkCache_Flush(&cache) == ERROR, "failed flush");
+
+	disk.fail = false;
+	CHECK(BlkCache_Flush(&cache) == SUCCESS, "flush after the error");
+}
+
+static void testRandom(void)
+{
+	uint32_t op, sector, count;
+	int readsOk = 1;
+
+	resetDisk();
+	srand(1);
+	BlkCache_Init(&cache, diskRead, diskWrite, &disk, cacheMem, sizeof(cacheMem));
+	for (op = 0; op < RANDOM_OPS; op++) {
+		count = 1 + (uint32_t) rand() % MAX_COUNT;
+
+		/* Mostly a small hot area, so segments are hit, evicted and
+		   written back */
+		sector = (uint32_t) rand() % ((rand() % 4) ? 256 : DISK_SECTORS - MAX_COUNT);
+
+		if (rand() % 2) {
+			fill(buf, count, op);
+			memcpy(&shadow[sector * BLKCACHE_SECTOR_SIZE], buf, count * BLKCACHE_SECTOR_SIZE);
+			CHECK(BlkCache_Write(&cache, buf, sector, count) == SUCCESS, "write of %u at %u", count, sector);
+		}
+		else {
+			CHECK(BlkCache_Read(&cache, buf, sector, count) == SUCCESS, "read of %u at %u", count, sector);
+			readsOk &= (memcmp(buf, &shadow[sector * BLKCACHE_SECTOR_SIZE], count * BLKCACHE_SECTOR_SIZE) == 0);
+		}
+	}
+	CHECK(readsOk, "random reads differ from what was written");
+	CHECK(BlkCache_Flush(&cache) == SUCCESS, "flush");
+	CHECK(memcmp(disk.data, shadow, sizeof(shadow)) == 0, "disk differs after the flush");
+	CHECK(disk.badCalls == 0, "%u device calls out of range or empty", disk.badCalls);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	testInit();
+	testReadAhead();
+	testWriteBack();
+	testDeviceError();
+	testRandom();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,364 @@
+/*
+ * @brief Host test of Chip_CAN_BuildAFLUT()
+ *
+ * @note
+ * Builds acceptance filter tables in the CAN AF RAM of the peripheral
+ * simulator and reads them back through a model of the hardware search,
+ * checking that:
+ *   - an ID given both enabled and disabled is kept once, enabled, in
+ *     whatever order the copies come, in the FullCAN and the individual
+ *     standard sections;
+ *   - overlapping ranges are merged only with ranges of the same Disable
+ *     bits, so no ID of an enabled range is turned off and no ID of a
+ *     disabled range is turned on;
+ *   - a mixed set with two controllers, repeated IDs, FullCAN entries,
+ *     ranges to merge and extended IDs accepts exactly the IDs it was
+ *     given, and its sections are in ascending order;
+ *   - the table is word for word the one Chip_CAN_SetAFLUT() writes from
+ *     the same IDs sorted by hand;
+ *   - reversed ranges and ranges across two controllers are refused.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_can_aflut.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/can_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_can_aflut
+ *   ./test_can_aflut
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define STD_DISABLE         (1 << 12)
+#define STD_KEY(entry)      ((entry) & 0xE7FF)	/* Controller and ID */
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static uint32_t endRow(int section)
+{
+	return CANAF_ENDADDR_VAL(LPC_CANAF->ENDADDR[section]);
+}
+
+/* Whether the table takes a frame, searched as the hardware does */
+static int accepts(uint32_t ctrl, uint32_t id, int ext)
+{
+	uint32_t row, hi, lo, key;
+
+	if (!ext) {
+		key = (ctrl << 13) | id;
+		for (row = 0; row < endRow(CANAF_RAM_SFF_SEC); row++) {
+			hi = LPC_CANAF_RAM->MASK[row] >> 16;
+			lo = LPC_CANAF_RAM->MASK[row] & 0xFFFF;
+			if ((((hi & STD_DISABLE) == 0) && (STD_KEY(hi) == key)) ||
+				(((lo & STD_DISABLE) == 0) && (STD_KEY(lo) == key))) {
+				return 1;
+			}
+		}
+		for (; row < endRow(CANAF_RAM_SFF_GRP_SEC); row++) {
+			hi = LPC_CANAF_RAM->MASK[row] >> 16;
+			lo = LPC_CANAF_RAM->MASK[row] & 0xFFFF;
+			if (((hi & STD_DISABLE) == 0) && (key >= STD_KEY(hi)) && (key <= STD_KEY(lo))) {
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+	key = (ctrl << 29) | id;
+	for (row = endRow(CANAF_RAM_SFF_GRP_SEC); row < endRow(CANAF_RAM_EFF_SEC); row++) {
+		if (LPC_CANAF_RAM->MASK[row] == key) {
+			return 1;
+		}
+	}
+	for (; row + 1 < endRow(CANAF_RAM_EFF_GRP_SEC); row += 2) {
+		if ((key >= LPC_CANAF_RAM->MASK[row]) && (key <= LPC_CANAF_RAM->MASK[row + 1])) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Whether the individual sections are in ascending order, unused entries aside */
+static int sorted(void)
+{
+	uint32_t row, half, entry, last, start = 0;
+	int s;
+
+	for (s = CANAF_RAM_FULLCAN_SEC; s <= CANAF_RAM_SFF_SEC; s++) {
+		last = 0;
+		for (row = start; row < endRow(s); row++) {
+			for (half = 0; half < 2; half++) {
+				entry = (LPC_CANAF_RAM->MASK[row] >> (half ? 0 : 16)) & 0xFFFF;
+				if ((half == 1) && ((entry & 0x7FF) == 0) && ((entry & STD_DISABLE) != 0)) {
+					continue;
+				}
+				if (((row > start) || (half > 0)) && (STD_KEY(entry) <= last)) {
+					return 0;
+				}
+				last = STD_KEY(entry);
+			}
+		}
+		start = endRow(s);
+	}
+	for (row = endRow(CANAF_RAM_SFF_GRP_SEC) + 1; row < endRow(CANAF_RAM_EFF_SEC); row++) {
+		if (LPC_CANAF_RAM->MASK[row] <= LPC_CANAF_RAM->MASK[row - 1]) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void setSTD(CAN_STD_ID_ENTRY_T *pEntry, uint8_t ctrl, uint8_t disable, uint16_t id)
+{
+	pEntry->CtrlNo = ctrl;
+	pEntry->Disable = disable;
+	pEntry->ID_11 = id;
+}
+
+static void setSTDRange(CAN_STD_ID_RANGE_ENTRY_T *pRange, uint8_t ctrl, uint8_t disable, uint16_t lower,
+						uint16_t upper)
+{
+	setSTD(&pRange->LowerID, ctrl, disable, lower);
+	setSTD(&pRange->UpperID, ctrl, disable, upper);
+}
+
+static void testDisabledDuplicates(void)
+{
+	static const uint8_t perms[24][4] = {
+		{0, 1, 2, 3}, {0, 1, 3, 2}, {0, 2, 1, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {0, 3, 2, 1},
+		{1, 0, 2, 3}, {1, 0, 3, 2}, {1, 2, 0, 3}, {1, 2, 3, 0}, {1, 3, 0, 2}, {1, 3, 2, 0},
+		{2, 0, 1, 3}, {2, 0, 3, 1}, {2, 1, 0, 3}, {2, 1, 3, 0}, {2, 3, 0, 1}, {2, 3, 1, 0},
+		{3, 0, 1, 2}, {3, 0, 2, 1}, {3, 1, 0, 2}, {3, 1, 2, 0}, {3, 2, 0, 1}, {3, 2, 1, 0}
+	};
+	CAN_STD_ID_ENTRY_T given[4], full[4], sff[4];
+	CANAF_LUT_T lut;
+	int p, i, bad = 0;
+
+	/* 0x100 twice disabled and once enabled */
+	setSTD(&given[0], 0, 1, 0x100);
+	setSTD(&given[1], 0, 0, 0x100);
+	setSTD(&given[2], 0, 0, 0x080);
+	setSTD(&given[3], 0, 1, 0x100);
+
+	for (p = 0; p < 24; p++) {
+		for (i = 0; i < 4; i++) {
+			full[i] = given[perms[p][i]];
+			sff[i] = given[perms[p][i]];
+			full[i].ID_11 += 0x200;
+		}
+		memset(&lut, 0, sizeof(lut));
+		lut.FullCANSec = full;
+		lut.FullCANEntryNum = 4;
+		lut.SffSec = sff;
+		lut.SffEntryNum = 4;
+		if ((Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) != SUCCESS) || (lut.FullCANEntryNum != 2) ||
+			(lut.SffEntryNum != 2) || !accepts(0, 0x100, 0) || !accepts(0, 0x080, 0) ||
+			((LPC_CANAF_RAM->MASK[0] & (STD_DISABLE * 0x10001)) != 0) ||
+			((LPC_CANAF_RAM->MASK[1] & (STD_DISABLE * 0x10001)) != 0)) {
+			bad++;
+		}
+	}
+	CHECK(bad == 0, "%d of 24 orders kept a disabled copy of an enabled ID", bad);
+
+	/* Only disabled copies, one stays, disabled */
+	setSTD(&sff[0], 1, 1, 0x200);
+	setSTD(&sff[1], 1, 1, 0x200);
+	memset(&lut, 0, sizeof(lut));
+	lut.SffSec = sff;
+	lut.SffEntryNum = 2;
+	CHECK((Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) == SUCCESS) && (lut.SffEntryNum == 1) &&
+		  !accepts(1, 0x200, 0), "disabled ID not kept once, disabled");
+}
+
+static void testRangeDisable(void)
+{
+	CAN_STD_ID_RANGE_ENTRY_T ranges[5];
+	CANAF_LUT_T lut;
+	int id, bad = 0;
+
+	setSTDRange(&ranges[0], 0, 0, 0x10, 0x20);
+	setSTDRange(&ranges[1], 0, 1, 0x18, 0x30);
+	setSTDRange(&ranges[2], 0, 0, 0x21, 0x28);
+	setSTDRange(&ranges[3], 0, 1, 0x48, 0x60);
+	setSTDRange(&ranges[4], 0, 1, 0x40, 0x50);
+	memset(&lut, 0, sizeof(lut));
+	lut.SffGrpSec = ranges;
+	lut.SffGrpEntryNum = 5;
+	CHECK(Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) == SUCCESS, "ranges refused");
+
+	for (id = 0; id < 0x80; id++) {
+		if (accepts(0, id, 0) != ((id >= 0x10) && (id <= 0x28))) {
+			bad++;
+		}
+	}
+	CHECK(bad == 0, "%d IDs accepted or refused against the Disable bits of their ranges", bad);
+	CHECK(lut.SffGrpEntryNum == 4, "%u ranges, 4 expected", lut.SffGrpEntryNum);
+}
+
+static void testMixed(void)
+{
+	static CAN_STD_ID_ENTRY_T sff[100], sffGiven[100], full[6], sorted100[100];
+	static CAN_EXT_ID_ENTRY_T eff[41], effGiven[41];
+	static CAN_STD_ID_RANGE_ENTRY_T sffGrp[6];
+	static CAN_EXT_ID_RANGE_ENTRY_T effGrp[3];
+	static uint32_t built[CANAF_RAM_ENTRY_NUM];
+	CANAF_LUT_T lut;
+	int i, k, id, ctrl, want, bad = 0;
+	uint32_t builtEnd;
+
+	srand(1);
+	for (i = 0; i < 100; i++) {
+		setSTD(&sff[i], rand() & 1, 0, rand() & 0x7F);
+	}
+	for (i = 0; i < 5; i++) {
+		setSTD(&full[i], 0, 0, 0x700 - i * 3);
+	}
+	full[5] = full[1];
+	for (i = 0; i < 40; i++) {
+		eff[i].CtrlNo = rand() & 1;
+		eff[i].ID_29 = rand() % 5000;
+	}
+	eff[40] = eff[3];
+	setSTDRange(&sffGrp[0], 0, 0, 0x300, 0x310);
+	setSTDRange(&sffGrp[1], 1, 0, 0x200, 0x250);
+	setSTDRange(&sffGrp[2], 0, 0, 0x305, 0x320);
+	setSTDRange(&sffGrp[3], 0, 0, 0x321, 0x330);
+	setSTDRange(&sffGrp[4], 0, 0, 0x7F0, 0x7FF);
+	setSTDRange(&sffGrp[5], 1, 0, 0x000, 0x005);
+	effGrp[0].LowerID.CtrlNo = effGrp[0].UpperID.CtrlNo = 1;
+	effGrp[0].LowerID.ID_29 = 100000;
+	effGrp[0].UpperID.ID_29 = 200000;
+	effGrp[1].LowerID.CtrlNo = effGrp[1].UpperID.CtrlNo = 0;
+	effGrp[1].LowerID.ID_29 = 100000;
+	effGrp[1].UpperID.ID_29 = 100010;
+	effGrp[2].LowerID.CtrlNo = effGrp[2].UpperID.CtrlNo = 1;
+	effGrp[2].LowerID.ID_29 = 150000;
+	effGrp[2].UpperID.ID_29 = 250000;
+	memcpy(sffGiven, sff, sizeof(sff));
+	memcpy(effGiven, eff, sizeof(eff));
+
+	lut.FullCANSec = full;
+	lut.FullCANEntryNum = 6;
+	lut.SffSec = sff;
+	lut.SffEntryNum = 100;
+	lut.SffGrpSec = sffGrp;
+	lut.SffGrpEntryNum = 6;
+	lut.EffSec = eff;
+	lut.EffEntryNum = 41;
+	lut.EffGrpSec = effGrp;
+	lut.EffGrpEntryNum = 3;
+	CHECK(Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) == SUCCESS, "mixed set refused");
+	CHECK(sorted(), "sections not in ascending order");
+	CHECK((lut.FullCANEntryNum == 5) && (lut.SffGrpEntryNum == 4) && (lut.EffGrpEntryNum == 2),
+		  "%u FullCAN entries and %u and %u ranges", lut.FullCANEntryNum, lut.SffGrpEntryNum, lut.EffGrpEntryNum);
+
+	/* Every standard ID below 0x80 on both controllers, as given or not */
+	for (id = 0; id < 0x80; id++) {
+		for (ctrl = 0; ctrl < 2; ctrl++) {
+			want = (ctrl == 1) && (id <= 5);
+			for (k = 0; k < 100; k++) {
+				if ((sffGiven[k].CtrlNo == ctrl) && (sffGiven[k].ID_11 == id)) {
+					want = 1;
+				}
+			}
+			if (accepts(ctrl, id, 0) != want) {
+				bad++;
+			}
+		}
+	}
+	for (i = 0; i < 41; i++) {
+		bad += !accepts(effGiven[i].CtrlNo, effGiven[i].ID_29, 1);
+	}
+	for (i = 0; i < 5; i++) {
+		bad += !accepts(0, 0x700 - i * 3, 0);
+	}
+	for (id = 0x300; id <= 0x330; id++) {
+		bad += !accepts(0, id, 0);
+	}
+	bad += accepts(0, 0x2FF, 0) + accepts(0, 0x331, 0) + !accepts(1, 0x225, 0) + accepts(1, 0x251, 0);
+	bad += !accepts(1, 240000, 1) + accepts(1, 250001, 1) + !accepts(0, 100005, 1) + accepts(0, 100011, 1);
+	CHECK(bad == 0, "%d IDs of the mixed set accepted or refused wrongly", bad);
+
+	/* The same as Chip_CAN_SetAFLUT() from the sorted individual IDs */
+	memcpy(sff, sffGiven, sizeof(sff));
+	memset(&lut, 0, sizeof(lut));
+	lut.SffSec = sff;
+	lut.SffEntryNum = 100;
+	Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut);
+	builtEnd = endRow(CANAF_RAM_EFF_GRP_SEC);
+	for (i = 0; i < (int) builtEnd; i++) {
+		built[i] = LPC_CANAF_RAM->MASK[i];
+	}
+	memcpy(sorted100, sff, sizeof(sff));
+	lut.SffSec = sorted100;
+	Chip_CAN_SetAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut);
+	bad = (endRow(CANAF_RAM_EFF_GRP_SEC) != builtEnd);
+	for (i = 0; i < (int) builtEnd; i++) {
+		bad += (LPC_CANAF_RAM->MASK[i] != built[i]);
+	}
+	CHECK(bad == 0, "table differs from Chip_CAN_SetAFLUT() of the sorted IDs");
+}
+
+static void testRefused(void)
+{
+	CAN_STD_ID_RANGE_ENTRY_T range;
+	CANAF_LUT_T lut;
+	uint32_t row0 = LPC_CANAF_RAM->MASK[0];
+
+	memset(&lut, 0, sizeof(lut));
+	lut.SffGrpSec = &range;
+	lut.SffGrpEntryNum = 1;
+	setSTDRange(&range, 0, 0, 0x20, 0x10);
+	CHECK(Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) == ERROR, "reversed range taken");
+	setSTDRange(&range, 0, 0, 0x05, 0x06);
+	range.UpperID.CtrlNo = 1;
+	CHECK(Chip_CAN_BuildAFLUT(LPC_CANAF, LPC_CANAF_RAM, &lut) == ERROR, "range across controllers taken");
+	CHECK(LPC_CANAF_RAM->MASK[0] == row0, "refused table written");
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	Sim_Init();
+
+	testDisabledDuplicates();
+	testRangeDisable();
+	testMixed();
+	testRefused();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
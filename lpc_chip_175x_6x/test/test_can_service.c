@@ -0,0 +1,468 @@
+/*
+ * @brief Host test of the interrupt driven CAN service
+ *
+ * @note
+ * Runs Chip_CAN_Service_* on the CAN model of the peripheral simulator at
+ * 1 Mbit/s, with TIMER1 counting microseconds as the time base, and checks
+ * that:
+ *   - while another node floods the bus with 5000 frames and the
+ *     application works in 1 ms slices, the service drops none, where
+ *     polling Chip_CAN_Receive() between the slices drops most of them;
+ *   - every timestamp lies at or after the end of its frame on the bus, and
+ *     less than the interrupt latency after it;
+ *   - an urgent frame queued behind three less urgent frames in the
+ *     transmit buffers gets on the bus within a few frame times, where
+ *     Chip_CAN_Send() waits for the whole flood;
+ *   - queued frames go out in bus arbitration order, frames of one ID in
+ *     the order they were queued, and a full queue refuses a frame;
+ *   - the blocking calls carry 300 frames from CAN1 to CAN2 in order;
+ *   - mailbox IDs bypass the ring, each mailbox keeps the last frame of
+ *     its ID and reports it once, IDs out of order are refused.
+ *
+ * @par
+ * The drop counts and the largest timestamp error are printed.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_can_service.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/can_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/timer_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_can_service
+ *   ./test_can_service
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define CYCLES_PER_US       (PCLK_HZ / 1000000)
+
+/* An 8 byte standard frame at 1 Mbit/s, the model adds no stuff bits */
+#define FRAME_US            111
+
+/* Steps of 10 us, interrupts are delivered at the end of Sim_Advance() */
+#define STEP_US             10
+
+#define FLOOD_FRAMES        5000
+#define RING1_SIZE          32
+#define RING2_SIZE          64
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static CAN_SERVICE_T svc1, svc2;
+static bool useSvc1, useSvc2;
+static CAN_RX_FRAME_T rxBuf1[RING1_SIZE], rxBuf2[RING2_SIZE];
+static RINGBUFF_T rxRing1, rxRing2;
+static uint32_t events;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void canIRQHandler(void)
+{
+	if (useSvc1) {
+		Chip_CAN_Service_IRQHandler(&svc1);
+	}
+	if (useSvc2) {
+		Chip_CAN_Service_IRQHandler(&svc2);
+	}
+}
+
+static void eventFunc(CAN_SERVICE_T *pSvc, uint32_t Events)
+{
+	events |= Events;
+}
+
+static void waitFunc(CAN_SERVICE_T *pSvc)
+{
+	Sim_Advance(STEP_US * CYCLES_PER_US);
+}
+
+static void runUs(uint32_t us)
+{
+	uint32_t i;
+
+	for (i = 0; i < us / STEP_US; i++) {
+		Sim_Advance(STEP_US * CYCLES_PER_US);
+	}
+}
+
+/* Both controllers at 1 Mbit/s taking every frame, TIMER1 counting us */
+static void setup(void)
+{
+	Sim_Init();
+	Chip_CAN_Init(LPC_CAN1, LPC_CANAF, LPC_CANAF_RAM);
+	Chip_CAN_Init(LPC_CAN2, LPC_CANAF, LPC_CANAF_RAM);
+	Chip_CAN_SetBitRate(LPC_CAN1, 1000000);
+	Chip_CAN_SetBitRate(LPC_CAN2, 1000000);
+	Chip_CAN_SetAFMode(LPC_CANAF, CAN_AF_BYBASS_MODE);
+
+	Chip_TIMER_Init(LPC_TIMER1);
+	Chip_TIMER_PrescaleSet(LPC_TIMER1, CYCLES_PER_US - 1);
+	Chip_TIMER_Enable(LPC_TIMER1);
+
+	RingBuffer_Init(&rxRing1, rxBuf1, sizeof(CAN_RX_FRAME_T), RING1_SIZE);
+	RingBuffer_Init(&rxRing2, rxBuf2, sizeof(CAN_RX_FRAME_T), RING2_SIZE);
+	Sim_SetIRQHandler(CAN_IRQn, canIRQHandler);
+	useSvc1 = false;
+	useSvc2 = false;
+	events = 0;
+}
+
+/* 8 byte frame carrying seq in its first two bytes */
+static CAN_MSG_T makeMsg(uint32_t id, uint32_t seq)
+{
+	CAN_MSG_T msg;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.ID = id;
+	msg.DLC = 8;
+	msg.Data[0] = (uint8_t) seq;
+	msg.Data[1] = (uint8_t) (seq >> 8);
+	return msg;
+}
+
+static uint32_t getSeq(const CAN_MSG_T *pMsg)
+{
+	return pMsg->Data[0] | ((uint32_t) pMsg->Data[1] << 8);
+}
+
+/* Another node sends FLOOD_FRAMES back to back to CAN1 while the
+   application works in 1 ms slices, taking the frames between them.
+   Returns the frames taken, and the stamp errors of the service in us. */
+static uint32_t flood(bool service, int32_t *pMinErr, int32_t *pMaxErr)
+{
+	uint32_t sent = 0, taken = 0, start;
+	int32_t err;
+	CAN_MSG_T msg;
+	CAN_RX_FRAME_T frame;
+
+	setup();
+	if (service) {
+		Chip_CAN_Service_Init(&svc1, LPC_CAN1, &rxRing1, &LPC_TIMER1->TC);
+		useSvc1 = true;
+		NVIC_EnableIRQ(CAN_IRQn);
+	}
+	*pMinErr = INT32_MAX;
+	*pMaxErr = INT32_MIN;
+
+	start = LPC_TIMER1->TC;
+	while (LPC_TIMER1->TC - start < (FLOOD_FRAMES + 10) * FRAME_US) {
+		while (sent < FLOOD_FRAMES) {
+			msg = makeMsg(0x123, sent);
+			if (Sim_CAN_Receive(&msg, 1) != 1) {
+				break;
+			}
+			sent++;
+		}
+
+		runUs(1000);
+
+		if (service) {
+			while (Chip_CAN_Service_Read(&svc1, &frame) == SUCCESS) {
+				/* Frame seq ends (seq + 1) frame times after the flood starts */
+				err = (int32_t) (frame.Timestamp - start) - (int32_t) ((getSeq(&frame.Msg) + 1) * FRAME_US);
+				*pMinErr = MIN(*pMinErr, err);
+				*pMaxErr = MAX(*pMaxErr, err);
+				taken++;
+			}
+		}
+		else {
+			while (Chip_CAN_Receive(LPC_CAN1, &msg) == SUCCESS) {
+				taken++;
+			}
+		}
+	}
+	NVIC_DisableIRQ(CAN_IRQn);
+	return taken;
+}
+
+static void testFlood(void)
+{
+	uint32_t polled, serviced;
+	int32_t minErr, maxErr;
+
+	polled = flood(false, &minErr, &maxErr);
+	serviced = flood(true, &minErr, &maxErr);
+	printf("%u frames at 1 Mbit/s, application busy in 1 ms slices\n", FLOOD_FRAMES);
+	printf("  polling between slices   %4u dropped (%.1f%%)\n", FLOOD_FRAMES - polled,
+		   100.0 * (FLOOD_FRAMES - polled) / FLOOD_FRAMES);
+	printf("  service                  %4u dropped (%.1f%%), timestamp %d to %d us after the frame\n",
+		   FLOOD_FRAMES - serviced, 100.0 * (FLOOD_FRAMES - serviced) / FLOOD_FRAMES, minErr, maxErr);
+
+	CHECK(polled < FLOOD_FRAMES / 2, "polling took %u frames, the flood is too slow", polled);
+	CHECK(serviced == FLOOD_FRAMES, "service took %u frames", serviced);
+	CHECK((svc1.RxDropped == 0) && (svc1.RxOverruns == 0), "service dropped %u, overruns %u",
+		  svc1.RxDropped, svc1.RxOverruns);
+	CHECK(minErr >= 0, "frame stamped %d us before its end", minErr);
+	CHECK(maxErr <= STEP_US + 2, "frame stamped %d us after its end", maxErr);
+}
+
+/* Three frames of CAN1 wait in the transmit buffers while another node
+   floods the bus with ID 0x100, then an urgent 0x050 is queued. Returns
+   the us until 0x050 is on the bus. */
+static uint32_t urgentLatency(bool service)
+{
+	CAN_MSG_T msg, log[64];
+	uint32_t i, n, queued;
+	int found = 0;
+
+	setup();
+	if (service) {
+		Chip_CAN_Service_Init(&svc1, LPC_CAN1, &rxRing1, NULL);
+		useSvc1 = true;
+		NVIC_EnableIRQ(CAN_IRQn);
+	}
+	for (i = 0; i < 40; i++) {
+		msg = makeMsg(0x100, i);
+		Sim_CAN_Receive(&msg, 1);
+	}
+	runUs(50);
+	for (i = 0; i < 3; i++) {
+		msg = makeMsg(0x700 + i, i);
+		if (service) {
+			Chip_CAN_Service_Write(&svc1, &msg);
+		}
+		else {
+			Chip_CAN_Send(LPC_CAN1, Chip_CAN_GetFreeTxBuf(LPC_CAN1), &msg);
+		}
+	}
+	runUs(500);
+
+	queued = LPC_TIMER1->TC;
+	msg = makeMsg(0x050, 99);
+	if (service) {
+		Chip_CAN_Service_Write(&svc1, &msg);
+	}
+	else {
+		while (Chip_CAN_GetFreeTxBuf(LPC_CAN1) == CAN_BUFFER_LAST) {
+			runUs(STEP_US);
+		}
+		Chip_CAN_Send(LPC_CAN1, Chip_CAN_GetFreeTxBuf(LPC_CAN1), &msg);
+	}
+	while (!found && (LPC_TIMER1->TC - queued < 100 * FRAME_US)) {
+		runUs(STEP_US);
+		n = Sim_CAN_Transmitted(log, 64);
+		for (i = 0; i < n; i++) {
+			found |= (log[i].ID == 0x050);
+		}
+	}
+	NVIC_DisableIRQ(CAN_IRQn);
+	return LPC_TIMER1->TC - queued;
+}
+
+static void testPriority(void)
+{
+	uint32_t plain, serviced;
+
+	plain = urgentLatency(false);
+	serviced = urgentLatency(true);
+	printf("urgent frame behind three queued frames and a flood of 40\n");
+	printf("  Chip_CAN_Send()          %4u us\n", plain);
+	printf("  service                  %4u us, %u preempted\n", serviced, svc1.TxPreempted);
+
+	CHECK(plain > 30 * FRAME_US, "plain send took %u us, the flood is too short", plain);
+	CHECK(serviced < 3 * FRAME_US, "urgent frame took %u us", serviced);
+	CHECK(svc1.TxPreempted >= 1, "no frame preempted");
+}
+
+/* CAN1 sends a mixed queue to CAN2 */
+static void testOrder(void)
+{
+	static const uint32_t ids[] = {
+		0x300, 0x100, 0x300, 0x200 | CAN_EXTEND_ID_USAGE, 0x080, 0x300, 0x100, 0x7FF,
+		0x010, 0x300, 0x555, 0x100, 0x300, 0x020, 0x1FFFFFFF | CAN_EXTEND_ID_USAGE, 0x300
+	};
+	/* The extended 0x200 has base ID 0, the extended 0x1FFFFFFF loses to 0x7FF */
+	static const uint32_t busOrder[] = {
+		0x200 | CAN_EXTEND_ID_USAGE, 0x010, 0x020, 0x080, 0x100, 0x100, 0x100, 0x300,
+		0x300, 0x300, 0x300, 0x300, 0x300, 0x555, 0x7FF, 0x1FFFFFFF | CAN_EXTEND_ID_USAGE
+	};
+	CAN_MSG_T msg, log[64];
+	CAN_RX_FRAME_T frame;
+	uint32_t i, n, last300 = 0, got = 0;
+	int queueOk = 1;
+
+	setup();
+	Chip_CAN_Service_Init(&svc1, LPC_CAN1, &rxRing1, NULL);
+	Chip_CAN_Service_Init(&svc2, LPC_CAN2, &rxRing2, &LPC_TIMER1->TC);
+	useSvc1 = true;
+	useSvc2 = true;
+
+	/* All of it is queued before the interrupt gets to run */
+	for (i = 0; i < sizeof(ids) / sizeof(ids[0]); i++) {
+		msg = makeMsg(ids[i], i);
+		queueOk &= (Chip_CAN_Service_Write(&svc1, &msg) == SUCCESS);
+	}
+	CHECK(queueOk, "queue refused a frame");
+	msg = makeMsg(0x001, 0);
+	CHECK(Chip_CAN_Service_Write(&svc1, &msg) == ERROR, "full queue took a frame");
+	NVIC_EnableIRQ(CAN_IRQn);
+	runUs(40 * FRAME_US);
+
+	n = Sim_CAN_Transmitted(log, 64);
+	CHECK(n == sizeof(busOrder) / sizeof(busOrder[0]), "%u frames on the bus", n);
+	for (i = 0; (i < n) && (i < sizeof(busOrder) / sizeof(busOrder[0])); i++) {
+		CHECK(log[i].ID == busOrder[i], "frame %u on the bus is 0x%x, not 0x%x", i, log[i].ID, busOrder[i]);
+	}
+
+	while (Chip_CAN_Service_Read(&svc2, &frame) == SUCCESS) {
+		CHECK(frame.Msg.ID == ids[getSeq(&frame.Msg)], "frame %u received with ID 0x%x",
+			  getSeq(&frame.Msg), frame.Msg.ID);
+		if (frame.Msg.ID == 0x300) {
+			CHECK(getSeq(&frame.Msg) >= last300, "0x300 frame %u after frame %u", getSeq(&frame.Msg), last300);
+			last300 = getSeq(&frame.Msg);
+		}
+		got++;
+	}
+	CHECK(got == n, "CAN2 received %u of %u frames", got, n);
+	CHECK(svc1.TxFrames == n, "CAN1 counted %u frames sent", svc1.TxFrames);
+	NVIC_DisableIRQ(CAN_IRQn);
+}
+
+/* 300 frames from CAN1 to CAN2 through the blocking calls */
+static void testBlocking(void)
+{
+	CAN_MSG_T msg;
+	CAN_RX_FRAME_T frame;
+	uint32_t i, next = 0;
+	int inOrder = 1;
+
+	setup();
+	Chip_CAN_Service_Init(&svc1, LPC_CAN1, &rxRing1, NULL);
+	Chip_CAN_Service_Init(&svc2, LPC_CAN2, &rxRing2, NULL);
+	svc1.pWaitFunc = waitFunc;
+	svc2.pWaitFunc = waitFunc;
+	useSvc1 = true;
+	useSvc2 = true;
+	NVIC_EnableIRQ(CAN_IRQn);
+
+	for (i = 0; i < 300; i++) {
+		msg = makeMsg(0x200, i);
+		Chip_CAN_Service_WriteBlocking(&svc1, &msg);
+		while (Chip_CAN_Service_Read(&svc2, &frame) == SUCCESS) {
+			inOrder &= (getSeq(&frame.Msg) == next++);
+		}
+	}
+	while (next < 300) {
+		Chip_CAN_Service_ReadBlocking(&svc2, &frame);
+		inOrder &= (getSeq(&frame.Msg) == next++);
+	}
+	CHECK(inOrder, "blocking frames out of order");
+	CHECK((svc1.TxFrames == 300) && (svc2.RxFrames == 300) && (svc2.RxDropped == 0),
+		  "sent %u, received %u, dropped %u", svc1.TxFrames, svc2.RxFrames, svc2.RxDropped);
+	NVIC_DisableIRQ(CAN_IRQn);
+}
+
+static void testMailboxes(void)
+{
+	static const uint32_t sendIds[] = {
+		0x100, 0x300, 0x100, 0x200 | CAN_EXTEND_ID_USAGE, 0x100, 0x300, 0x080
+	};
+	CAN_MAILBOX_T boxes[2], badBoxes[2];
+	CAN_MSG_T msg;
+	CAN_RX_FRAME_T frame;
+	uint32_t i, start, ringSeqs[8], ringNum = 0;
+
+	setup();
+	Chip_CAN_Service_Init(&svc1, LPC_CAN1, &rxRing1, &LPC_TIMER1->TC);
+	svc1.pEventFunc = eventFunc;
+
+	/* Ascending order only, an extended ID sorts after every standard one */
+	badBoxes[0].ID = 0x200;
+	badBoxes[1].ID = 0x100;
+	CHECK(Chip_CAN_Service_SetMailboxes(&svc1, badBoxes, 2) == ERROR, "descending IDs taken");
+	badBoxes[1].ID = 0x200;
+	CHECK(Chip_CAN_Service_SetMailboxes(&svc1, badBoxes, 2) == ERROR, "same ID twice taken");
+	CHECK(svc1.MailboxNum == 0, "refused mailboxes set");
+
+	boxes[0].ID = 0x100;
+	boxes[1].ID = 0x200 | CAN_EXTEND_ID_USAGE;
+	CHECK(Chip_CAN_Service_SetMailboxes(&svc1, boxes, 2) == SUCCESS, "mailboxes refused");
+	useSvc1 = true;
+	NVIC_EnableIRQ(CAN_IRQn);
+
+	CHECK(Chip_CAN_Service_ReadMailbox(&svc1, 0, &frame) == ERROR, "empty mailbox read");
+
+	start = LPC_TIMER1->TC;
+	for (i = 0; i < sizeof(sendIds) / sizeof(sendIds[0]); i++) {
+		msg = makeMsg(sendIds[i], i);
+		Sim_CAN_Receive(&msg, 1);
+	}
+	runUs(10 * FRAME_US);
+
+	CHECK(events == (CAN_SERVICE_EVT_RX | CAN_SERVICE_EVT_MAILBOX), "events 0x%x", events);
+	CHECK(svc1.RxMailboxFrames == 4, "%u frames put in mailboxes", svc1.RxMailboxFrames);
+
+	/* The ring holds the other IDs only */
+	while (Chip_CAN_Service_Read(&svc1, &frame) == SUCCESS) {
+		if (ringNum < 8) {
+			ringSeqs[ringNum] = getSeq(&frame.Msg);
+		}
+		ringNum++;
+	}
+	CHECK((ringNum == 3) && (ringSeqs[0] == 1) && (ringSeqs[1] == 5) && (ringSeqs[2] == 6),
+		  "%u frames in the ring", ringNum);
+
+	/* The last frame of 0x100 is kept, with its own stamp, and read once */
+	CHECK(Chip_CAN_Service_ReadMailbox(&svc1, 0, &frame) == SUCCESS, "0x100 mailbox empty");
+	CHECK((frame.Msg.ID == 0x100) && (getSeq(&frame.Msg) == 4), "0x100 mailbox holds frame %u",
+		  getSeq(&frame.Msg));
+	CHECK(frame.Timestamp - start >= 5 * FRAME_US, "0x100 frame stamped %u us after the start",
+		  frame.Timestamp - start);
+	CHECK(Chip_CAN_Service_ReadMailbox(&svc1, 0, &frame) == ERROR, "0x100 frame read twice");
+
+	CHECK(Chip_CAN_Service_ReadMailbox(&svc1, 1, &frame) == SUCCESS, "extended mailbox empty");
+	CHECK((frame.Msg.ID == (0x200 | CAN_EXTEND_ID_USAGE)) && (getSeq(&frame.Msg) == 3),
+		  "extended mailbox holds 0x%x frame %u", frame.Msg.ID, getSeq(&frame.Msg));
+
+	/* A new frame is reported again */
+	msg = makeMsg(0x100, 7);
+	Sim_CAN_Receive(&msg, 1);
+	runUs(2 * FRAME_US);
+	CHECK(Chip_CAN_Service_ReadMailbox(&svc1, 0, &frame) == SUCCESS, "new 0x100 frame not reported");
+	CHECK(getSeq(&frame.Msg) == 7, "0x100 mailbox holds frame %u", getSeq(&frame.Msg));
+	NVIC_DisableIRQ(CAN_IRQn);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	testFlood();
+	testPriority();
+	testOrder();
+	testBlocking();
+	testMailboxes();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
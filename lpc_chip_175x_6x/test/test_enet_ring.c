@@ -0,0 +1,241 @@
+/*
+ * @brief Host test of the Ethernet descriptor rings in MAC loopback
+ *
+ * @note
+ * Runs Chip_ENET_Ring_Send(), Chip_ENET_Ring_Receive() and
+ * Chip_ENET_Ring_TxReclaim() on the ENET model of the peripheral simulator
+ * with MAC1 loopback on, and checks that:
+ *   - frames of 60 to 1514 bytes sent in 3 fragments come back as sent,
+ *     with no receive or transmit errors;
+ *   - fragments of less than 60 bytes in all arrive as one frame padded
+ *     with zeros to 60 bytes;
+ *   - a pool buffer given as the frame reference goes back to the pool
+ *     once the frame is sent;
+ *   - frames that arrive while the pool is empty are dropped and counted
+ *     without stopping the MAC, and reception resumes once buffers are
+ *     given back.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_enet_ring.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/enet_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_enet_ring
+ *   ./test_enet_ring
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define HDR_LEN             14
+#define MAX_FRAME           1514
+
+/* A 1514 byte frame takes 2952 peripheral clocks at 100 Mbps, polled in
+   steps of about half of that */
+#define STEP_CYCLES         1500
+#define MAX_STEPS           100
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static ENET_RING_T ring;
+static uint8_t *pFrame;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void fillFrame(uint32_t len, uint32_t seed)
+{
+	uint32_t i;
+
+	memset(pFrame, 0xFF, 6);
+	for (i = 6; i < len; i++) {
+		pFrame[i] = (uint8_t) (i * 7 + seed);
+	}
+	pFrame[12] = 0x08;
+	pFrame[13] = 0x00;
+}
+
+/* Wait for the next frame, NULL if none comes */
+static uint8_t *receiveFrame(uint32_t *pLen)
+{
+	uint8_t *pBuf = NULL;
+	int i;
+
+	for (i = 0; (i < MAX_STEPS) && (pBuf == NULL); i++) {
+		Sim_Advance(STEP_CYCLES);
+		pBuf = Chip_ENET_Ring_Receive(&ring, pLen);
+	}
+	return pBuf;
+}
+
+/* Send pFrame as the header, then the payload in two pieces */
+static Status sendFragments(uint32_t len, void *ref)
+{
+	ENET_FRAG_T frags[3];
+	uint32_t half = (len - HDR_LEN) / 2;
+
+	frags[0].pData = pFrame;
+	frags[0].len = HDR_LEN;
+	frags[1].pData = &pFrame[HDR_LEN];
+	frags[1].len = half;
+	frags[2].pData = &pFrame[HDR_LEN + half];
+	frags[2].len = len - HDR_LEN - half;
+	return Chip_ENET_Ring_Send(&ring, frags, 3, ref);
+}
+
+static void testLoopback(void)
+{
+	static const uint32_t lens[] = {60, 61, 64, 128, 500, 1000, 1390, 1513, MAX_FRAME};
+	uint8_t *pBuf;
+	uint32_t i, len;
+
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		fillFrame(lens[i], i);
+		CHECK(sendFragments(lens[i], NULL) == SUCCESS, "send of %u bytes", lens[i]);
+		pBuf = receiveFrame(&len);
+		CHECK(pBuf != NULL, "frame of %u bytes not received", lens[i]);
+		if (pBuf != NULL) {
+			CHECK(len == lens[i], "frame of %u bytes received as %u", lens[i], len);
+			CHECK(memcmp(pBuf, pFrame, lens[i]) == 0, "frame of %u bytes changed", lens[i]);
+			Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+		}
+	}
+	Chip_ENET_Ring_TxReclaim(&ring);
+	CHECK((ring.rxErrors == 0) && (ring.txErrors == 0), "%u receive and %u transmit errors",
+		  ring.rxErrors, ring.txErrors);
+}
+
+static void testPadding(void)
+{
+	static const uint8_t zeros[60];
+	ENET_FRAG_T frags[2];
+	uint8_t *pBuf;
+	uint32_t len;
+
+	fillFrame(HDR_LEN + 10, 99);
+	frags[0].pData = pFrame;
+	frags[0].len = HDR_LEN;
+	frags[1].pData = &pFrame[HDR_LEN];
+	frags[1].len = 10;
+	CHECK(Chip_ENET_Ring_Send(&ring, frags, 2, NULL) == SUCCESS, "send of a short frame");
+	pBuf = receiveFrame(&len);
+	CHECK((pBuf != NULL) && (len == 60), "short frame not received as 60 bytes");
+	if (pBuf != NULL) {
+		CHECK(memcmp(pBuf, pFrame, HDR_LEN + 10) == 0, "short frame changed");
+		CHECK(memcmp(&pBuf[HDR_LEN + 10], zeros, 60 - HDR_LEN - 10) == 0, "padding not zero");
+		Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+	}
+	Chip_ENET_Ring_TxReclaim(&ring);
+}
+
+/* A frame built in a pool buffer, given back once sent */
+static void testPoolRef(void)
+{
+	uint32_t freeBefore = ring.freeCount, len;
+	ENET_FRAG_T frag;
+	uint8_t *pTx = Chip_ENET_Ring_AllocBuf(&ring), *pBuf;
+
+	fillFrame(200, 5);
+	memcpy(pTx, pFrame, 200);
+	frag.pData = pTx;
+	frag.len = 200;
+	CHECK(Chip_ENET_Ring_Send(&ring, &frag, 1, pTx) == SUCCESS, "send from a pool buffer");
+	pBuf = receiveFrame(&len);
+	CHECK((pBuf != NULL) && (len == 200) && (memcmp(pBuf, pFrame, 200) == 0), "frame from a pool buffer");
+	if (pBuf != NULL) {
+		Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+	}
+	CHECK(Chip_ENET_Ring_TxReclaim(&ring) == 1, "sent frame not reclaimed");
+	CHECK(ring.freeCount == freeBefore, "pool has %u buffers, %u before", ring.freeCount, freeBefore);
+}
+
+static void testPoolEmpty(void)
+{
+	uint8_t *pTaken[ENET_RING_POOL_BUFS], *pBuf;
+	uint32_t numTaken = 0, len, dropped = ring.rxDropped, i;
+	int received = 0;
+
+	while ((pTaken[numTaken] = Chip_ENET_Ring_AllocBuf(&ring)) != NULL) {
+		numTaken++;
+	}
+
+	/* More frames than receive descriptors, all dropped */
+	for (i = 0; i < ENET_RING_RX_DESCS + 4; i++) {
+		fillFrame(100, i);
+		CHECK(sendFragments(100, NULL) == SUCCESS, "send %u with the pool empty", i);
+		CHECK(receiveFrame(&len) == NULL, "frame %u received with the pool empty", i);
+	}
+	CHECK(ring.rxDropped - dropped == ENET_RING_RX_DESCS + 4, "%u of %u frames dropped",
+		  ring.rxDropped - dropped, ENET_RING_RX_DESCS + 4);
+
+	for (i = 0; i < numTaken; i++) {
+		Chip_ENET_Ring_FreeBuf(&ring, pTaken[i]);
+	}
+	for (i = 0; i < 4; i++) {
+		fillFrame(300, 40 + i);
+		CHECK(sendFragments(300, NULL) == SUCCESS, "send %u after the pool refill", i);
+		pBuf = receiveFrame(&len);
+		if ((pBuf != NULL) && (len == 300) && (memcmp(pBuf, pFrame, 300) == 0)) {
+			received++;
+		}
+		if (pBuf != NULL) {
+			Chip_ENET_Ring_FreeBuf(&ring, pBuf);
+		}
+	}
+	CHECK(received == 4, "%d of 4 frames received after the pool refill", received);
+	CHECK(ring.rxErrors == 0, "%u receive errors", ring.rxErrors);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	void *pMem;
+
+	Sim_Init();
+	pMem = Sim_RamAlloc(ENET_RING_MEM_SIZE);
+	pFrame = Sim_RamAlloc(MAX_FRAME);
+
+	Chip_ENET_Init(LPC_ETHERNET, true);
+	if ((pMem == NULL) || (pFrame == NULL) || (Chip_ENET_Ring_Init(&ring, LPC_ETHERNET, pMem, NULL) != SUCCESS)) {
+		printf("FAIL: Chip_ENET_Ring_Init()\n");
+		return 1;
+	}
+	LPC_ETHERNET->MAC.MAC1 |= ENET_MAC1_LOOPBACK;
+	Chip_ENET_TXEnable(LPC_ETHERNET);
+	Chip_ENET_RXEnable(LPC_ETHERNET);
+
+	testLoopback();
+	testPadding();
+	testPoolRef();
+	testPoolEmpty();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * @brief Host test of GPDMA channel reservation and the descriptor pool
+ *
+ * @note
+ * Checks on the GPDMA model of the peripheral simulator that:
+ *   - Chip_GPDMA_ReserveChannel() hands out the lowest free channel for
+ *     GPDMA_PRIO_HIGH and the highest for GPDMA_PRIO_LOW, skips channels
+ *     that are running, returns -1 once all are taken, and that
+ *     Chip_GPDMA_ReleaseChannel() makes a channel free again;
+ *   - Chip_GPDMA_AllocDescriptors() gives out runs of free descriptors and
+ *     Chip_GPDMA_FreeDescriptors() takes them back, while refusing pointers
+ *     outside the pool, counts of 0 or past its end, and descriptors that are
+ *     not in use, without changing the pool.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_gpdma.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_gpdma
+ *   ./test_gpdma
+ */
+
+#include <stdio.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void testChannels(void)
+{
+	uint8_t *pBuf = Sim_RamAlloc(4);
+	int ch[GPDMA_NUMBER_CHANNELS], i;
+
+	ch[0] = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	ch[1] = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_LOW, NULL, NULL);
+	CHECK(ch[0] == 0, "high priority channel %d", ch[0]);
+	CHECK(ch[1] == GPDMA_NUMBER_CHANNELS - 1, "low priority channel %d", ch[1]);
+
+	/* A channel left running by code that did not reserve it is skipped */
+	Chip_GPDMA_Transfer(LPC_GPDMA, 1, GPDMA_CONN_UART1_Rx, (uint32_t) pBuf, GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, 4);
+	ch[2] = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	CHECK(ch[2] == 2, "channel %d reserved next to a running one", ch[2]);
+
+	for (i = 3; i < GPDMA_NUMBER_CHANNELS; i++) {
+		ch[i] = Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_HIGH, NULL, NULL);
+	}
+	CHECK(ch[GPDMA_NUMBER_CHANNELS - 1] == -1, "channel %d reserved with all taken",
+		  ch[GPDMA_NUMBER_CHANNELS - 1]);
+
+	Chip_GPDMA_ReleaseChannel(LPC_GPDMA, ch[2]);
+	CHECK(Chip_GPDMA_ReserveChannel(LPC_GPDMA, GPDMA_PRIO_LOW, NULL, NULL) == ch[2],
+		  "released channel not reserved again");
+
+	Chip_GPDMA_Stop(LPC_GPDMA, 1);
+	for (i = 0; i < GPDMA_NUMBER_CHANNELS; i++) {
+		Chip_GPDMA_ReleaseChannel(LPC_GPDMA, i);
+	}
+}
+
+static void testDescriptors(void)
+{
+	DMA_TransferDescriptor_t *pA, *pB, *pC, outside;
+
+	pA = Chip_GPDMA_AllocDescriptors(3);
+	pB = Chip_GPDMA_AllocDescriptors(GPDMA_DESC_POOL_SIZE - 3);
+	CHECK((pA != NULL) && (pB == pA + 3), "descriptors not given out in runs");
+	CHECK(Chip_GPDMA_AllocDescriptors(1) == NULL, "descriptor given out of a full pool");
+	CHECK(Chip_GPDMA_AllocDescriptors(0) == NULL, "0 descriptors given out");
+
+	/* Refused without a change to the pool */
+	CHECK(Chip_GPDMA_FreeDescriptors(&outside, 1) == ERROR, "descriptor outside the pool freed");
+	CHECK(Chip_GPDMA_FreeDescriptors(pA - 1, 1) == ERROR, "descriptor before the pool freed");
+	CHECK(Chip_GPDMA_FreeDescriptors(pA, 0) == ERROR, "0 descriptors freed");
+	CHECK(Chip_GPDMA_FreeDescriptors(pB, GPDMA_DESC_POOL_SIZE) == ERROR, "descriptors past the pool freed");
+	CHECK(Chip_GPDMA_AllocDescriptors(1) == NULL, "a refused free changed the pool");
+
+	CHECK(Chip_GPDMA_FreeDescriptors(pA + 1, 2) == SUCCESS, "free of taken descriptors");
+	CHECK(Chip_GPDMA_FreeDescriptors(pA + 1, 2) == ERROR, "descriptors freed twice");
+	CHECK(Chip_GPDMA_FreeDescriptors(pA, 2) == ERROR, "free of a run that is partly free");
+	pC = Chip_GPDMA_AllocDescriptors(2);
+	CHECK(pC == pA + 1, "freed descriptors not given out again");
+
+	CHECK(Chip_GPDMA_FreeDescriptors(pA, 3) == SUCCESS, "free of the first run");
+	CHECK(Chip_GPDMA_FreeDescriptors(pB, GPDMA_DESC_POOL_SIZE - 3) == SUCCESS, "free of the second run");
+	CHECK(Chip_GPDMA_AllocDescriptors(GPDMA_DESC_POOL_SIZE) != NULL, "pool not empty at the end");
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	Sim_Init();
+	Chip_GPDMA_Init(LPC_GPDMA);
+
+	testChannels();
+	testDescriptors();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
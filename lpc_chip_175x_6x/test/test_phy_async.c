@@ -0,0 +1,145 @@
+/*
+ * @brief Host test of the timer driven PHY status updates
+ *
+ * @note
+ * Runs lpc_phy_async_init() of the LPCXpresso 1769 board's SMSC 87x0 PHY
+ * driver on the ENET (MII) and timer models of the peripheral simulator,
+ * and checks that:
+ *   - timer clocks below 1 MHz, which the microsecond prescaler cannot
+ *     divide down to, are refused without touching the timer;
+ *   - 1 MHz and 24 MHz set the prescaler for microsecond counts;
+ *   - the link change callback reports the state found by the first
+ *     update, then is called once, with the new state, when the cable is
+ *     plugged in, and not while nothing changes.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host -Ilpc_board_nxp_lpcxpresso_1769/inc \
+ *       lpc_chip_175x_6x/test/test_phy_async.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_board_nxp_lpcxpresso_1769/src/lpc_phy_smsc87x0.c \
+ *       lpc_chip_175x_6x/src/enet_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/timer_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_phy_async
+ *   ./test_phy_async
+ */
+
+#include <stdio.h>
+
+#include "chip.h"
+#include "lpc_phy.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define PHY_ADDR            1
+#define PERIOD_MS           100
+
+/* LAN8720 basic status register and its link bit */
+#define PHY_BSR             1
+#define PHY_BSR_LINK        (1 << 2)
+
+/* Steps of 10 us, interrupts are delivered at the end of Sim_Advance() */
+#define STEP_CYCLES         (PCLK_HZ / 100000)
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static int linkCalls;
+static uint32_t lastSts;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void runMs(uint32_t ms)
+{
+	uint32_t i;
+
+	for (i = 0; i < ms * 100; i++) {
+		Sim_Advance(STEP_CYCLES);
+	}
+}
+
+static void linkChanged(uint32_t physts)
+{
+	linkCalls++;
+	lastSts = physts;
+}
+
+static void timer1IRQHandler(void)
+{
+	lpc_phy_async_irq();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	uint16_t bsr = 0x7809;
+
+	Sim_Init();
+	Chip_ENET_Init(LPC_ETHERNET, true);
+	Chip_ENET_SetupMII(LPC_ETHERNET, Chip_ENET_FindMIIDiv(LPC_ETHERNET, 2500000), PHY_ADDR);
+	Sim_ENET_SetPHYReg(PHY_BSR, bsr);
+	if (lpc_phy_init(true, runMs) != SUCCESS) {
+		printf("FAIL: lpc_phy_init()\n");
+		return 1;
+	}
+
+	/* Clocks the prescaler cannot divide down to 1 MHz */
+	CHECK(lpc_phy_async_init(LPC_TIMER1, 0, PERIOD_MS, linkChanged) == ERROR, "0 Hz timer clock taken");
+	CHECK(lpc_phy_async_init(LPC_TIMER1, 999999, PERIOD_MS, linkChanged) == ERROR,
+		  "999999 Hz timer clock taken");
+	CHECK((LPC_TIMER1->TCR == 0) && (LPC_TIMER1->PR == 0), "refused clock changed the timer");
+
+	CHECK(lpc_phy_async_init(LPC_TIMER1, 1000000, PERIOD_MS, linkChanged) == SUCCESS, "1 MHz timer clock refused");
+	CHECK(LPC_TIMER1->PR == 0, "prescaler %u at 1 MHz", LPC_TIMER1->PR);
+	CHECK(lpc_phy_async_init(LPC_TIMER1, PCLK_HZ, PERIOD_MS, linkChanged) == SUCCESS, "24 MHz timer clock refused");
+	CHECK(LPC_TIMER1->PR == PCLK_HZ / 1000000 - 1, "prescaler %u at 24 MHz", LPC_TIMER1->PR);
+
+	Sim_SetIRQHandler(TIMER1_IRQn, timer1IRQHandler);
+	NVIC_EnableIRQ(TIMER1_IRQn);
+
+	/* The first update reports the speed and duplex without a link */
+	runMs(1);
+	CHECK(linkCalls == 1, "%d link callbacks for the first update", linkCalls);
+	CHECK((lastSts & PHY_LINK_CONNECTED) == 0, "link up without a cable");
+
+	/* No cable, nothing changes */
+	runMs(3 * PERIOD_MS);
+	CHECK(linkCalls == 1, "%d link callbacks without a cable", linkCalls);
+
+	Sim_ENET_SetPHYReg(PHY_BSR, bsr | PHY_BSR_LINK);
+	runMs(PERIOD_MS + 10);
+	CHECK(linkCalls == 2, "%d link callbacks for the cable plugged in", linkCalls);
+	CHECK((lastSts & (PHY_LINK_CONNECTED | PHY_LINK_CHANGED)) == (PHY_LINK_CONNECTED | PHY_LINK_CHANGED),
+		  "link status 0x%x", lastSts);
+	CHECK((lpc_phy_async_status() & PHY_LINK_CONNECTED) != 0, "link status not kept");
+
+	runMs(3 * PERIOD_MS);
+	CHECK(linkCalls == 2, "%d link callbacks with the link up", linkCalls);
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * @brief Host stress test of RINGBUFF_T with one producer and one consumer
+ *
+ * @note
+ * A producer thread and a consumer thread share a ring buffer of 32-bit
+ * items and one of bytes, without a lock, as an ISR and a task do on the
+ * chip.  Each side picks one of its calls at random for every step: the
+ * producer RingBuffer_Insert(), RingBuffer_InsertMult() or
+ * RingBuffer_AcquireWrite() and RingBuffer_CommitWrite(), the consumer
+ * RingBuffer_Pop(), RingBuffer_PopMult() or RingBuffer_PeekRead() and
+ * RingBuffer_ReleaseRead().  The producer writes a sequence count and the
+ * consumer checks that every item arrives once and in order, and that the
+ * counts both sides see stay within the buffer size.
+ *
+ * @par
+ * A ring buffer of RINGBUF_DEFINE() then runs the same sequence check from
+ * one thread, with random InsertMult() and PopMult() calls across the wrap,
+ * and must return 0 for counts of 0 or less without moving its indexes.
+ *
+ * @par
+ * On a host with several CPUs the threads run in parallel and the GCC
+ * fences of RB_ACQUIRE() and RB_RELEASE() are what keeps the items intact.
+ * On one CPU the threads interleave by preemption, and the random
+ * sched_yield() calls move the switch points around.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -Ilpc_chip_175x_6x/inc \
+ *       lpc_chip_175x_6x/test/test_ring_buffer.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c -lpthread -o test_ring_buffer
+ *   ./test_ring_buffer
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#include "ring_buffer.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Items passed through each ring buffer */
+#define ITEMS               (4 * 1000 * 1000)
+
+#define WORD_RB_SIZE        64
+#define BYTE_RB_SIZE        32
+
+/* Most items a multiple call asks for, more than the buffer holds */
+#define MAX_MULT            (WORD_RB_SIZE + 8)
+
+typedef struct {
+	RINGBUFF_T rb;
+	int itemSz;
+	const char *pName;
+	volatile int failures;
+} STRESS_T;
+
+static uint32_t wordData[WORD_RB_SIZE];
+static uint8_t byteData[BYTE_RB_SIZE];
+
+static STRESS_T stress[2];
+
+#define TYPED_RB_SIZE       16
+#define TYPED_ITEMS         (1000 * 1000)
+
+RINGBUF_DEFINE(typed_rb, uint16_t, TYPED_RB_SIZE)
+
+static typed_rb_T typedRing;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Thread-local xorshift, rand() takes a lock */
+static uint32_t nextRandom(uint32_t *pState)
+{
+	*pState ^= *pState << 13;
+	*pState ^= *pState >> 17;
+	*pState ^= *pState << 5;
+	return *pState;
+}
+
+static void putItem(STRESS_T *pStress, void *pItem, uint32_t seq)
+{
+	if (pStress->itemSz == 1) {
+		*(uint8_t *) pItem = (uint8_t) seq;
+	}
+	else {
+		*(uint32_t *) pItem = seq;
+	}
+}
+
+static int checkItem(STRESS_T *pStress, const void *pItem, uint32_t seq)
+{
+	uint32_t value = (pStress->itemSz == 1) ? *(const uint8_t *) pItem : *(const uint32_t *) pItem;
+	uint32_t expected = (pStress->itemSz == 1) ? (uint8_t) seq : seq;
+
+	if (value != expected) {
+		if (pStress->failures++ == 0) {
+			printf("FAIL %s: item %u is %u, expected %u\n", pStress->pName, (unsigned) seq,
+				   (unsigned) value, (unsigned) expected);
+		}
+		return 0;
+	}
+	return 1;
+}
+
+static void checkCount(STRESS_T *pStress)
+{
+	int count = RingBuffer_GetCount(&pStress->rb);
+
+	if ((count < 0) || (count > RingBuffer_GetSize(&pStress->rb))) {
+		if (pStress->failures++ == 0) {
+			printf("FAIL %s: count %d out of range\n", pStress->pName, count);
+		}
+	}
+}
+
+static void *producer(void *pArg)
+{
+	STRESS_T *pStress = (STRESS_T *) pArg;
+	uint32_t items[MAX_MULT], seq = 0, state = 0x12345678;
+	void *ptr;
+	int i, num, done;
+
+	while (seq < ITEMS) {
+		switch (nextRandom(&state) % 3) {
+		case 0:
+			putItem(pStress, items, seq);
+			seq += RingBuffer_Insert(&pStress->rb, items);
+			break;
+
+		case 1:
+			num = MIN(1 + (int) (nextRandom(&state) % MAX_MULT), (int) (ITEMS - seq));
+			for (i = 0; i < num; i++) {
+				putItem(pStress, (uint8_t *) items + i * pStress->itemSz, seq + i);
+			}
+			seq += RingBuffer_InsertMult(&pStress->rb, items, num);
+			break;
+
+		default:
+			num = RingBuffer_AcquireWrite(&pStress->rb, &ptr);
+			num = MIN(num, (int) (ITEMS - seq));
+			done = (num > 0) ? (int) (nextRandom(&state) % (num + 1)) : 0;
+			for (i = 0; i < done; i++) {
+				putItem(pStress, (uint8_t *) ptr + i * pStress->itemSz, seq + i);
+			}
+			RingBuffer_CommitWrite(&pStress->rb, done);
+			seq += done;
+			break;
+		}
+		checkCount(pStress);
+		if ((nextRandom(&state) & 0xFF) == 0) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void *consumer(void *pArg)
+{
+	STRESS_T *pStress = (STRESS_T *) pArg;
+	uint32_t items[MAX_MULT], seq = 0, state = 0x9abcdef0;
+	void *ptr;
+	int i, num, got;
+
+	while ((seq < ITEMS) && (pStress->failures == 0)) {
+		switch (nextRandom(&state) % 3) {
+		case 0:
+			if (RingBuffer_Pop(&pStress->rb, items)) {
+				checkItem(pStress, items, seq++);
+			}
+			break;
+
+		case 1:
+			num = 1 + (int) (nextRandom(&state) % MAX_MULT);
+			got = RingBuffer_PopMult(&pStress->rb, items, num);
+			for (i = 0; i < got; i++) {
+				checkItem(pStress, (uint8_t *) items + i * pStress->itemSz, seq++);
+			}
+			break;
+
+		default:
+			num = RingBuffer_PeekRead(&pStress->rb, &ptr);
+			got = (num > 0) ? (int) (nextRandom(&state) % (num + 1)) : 0;
+			for (i = 0; i < got; i++) {
+				checkItem(pStress, (uint8_t *) ptr + i * pStress->itemSz, seq++);
+			}
+			RingBuffer_ReleaseRead(&pStress->rb, got);
+			break;
+		}
+		checkCount(pStress);
+		if ((nextRandom(&state) & 0xFF) == 0) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+/* Sequence check of a RINGBUF_DEFINE() ring buffer, returns the failures */
+static int checkTyped(void)
+{
+	uint16_t items[TYPED_RB_SIZE + 4];
+	uint32_t inSeq = 0, outSeq = 0, state = 0x2468ace0;
+	int i, num, failures = 0;
+
+	typed_rb_Init(&typedRing);
+	if ((typed_rb_InsertMult(&typedRing, items, 0) != 0) || (typed_rb_InsertMult(&typedRing, items, -1) != 0) ||
+		(typed_rb_PopMult(&typedRing, items, -1) != 0) || !typed_rb_IsEmpty(&typedRing)) {
+		printf("FAIL typed: count of 0 or less moved the ring buffer\n");
+		failures++;
+	}
+
+	while ((outSeq < TYPED_ITEMS) && (failures == 0)) {
+		num = (int) (nextRandom(&state) % (TYPED_RB_SIZE + 4));
+		for (i = 0; i < num; i++) {
+			items[i] = (uint16_t) (inSeq + i);
+		}
+		inSeq += typed_rb_InsertMult(&typedRing, items, num);
+		if (typed_rb_GetCount(&typedRing) + typed_rb_GetFree(&typedRing) != TYPED_RB_SIZE) {
+			printf("FAIL typed: count %d and free %d\n", typed_rb_GetCount(&typedRing),
+				   typed_rb_GetFree(&typedRing));
+			failures++;
+		}
+
+		num = typed_rb_PopMult(&typedRing, items, (int) (nextRandom(&state) % (TYPED_RB_SIZE + 4)));
+		for (i = 0; i < num; i++, outSeq++) {
+			if (items[i] != (uint16_t) outSeq) {
+				printf("FAIL typed: item %u is %u\n", (unsigned) outSeq, (unsigned) items[i]);
+				failures++;
+				break;
+			}
+		}
+	}
+	return failures;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	pthread_t threads[4];
+	int i, failures = 0;
+
+	stress[0].pName = "32-bit items";
+	stress[0].itemSz = sizeof(wordData[0]);
+	RingBuffer_Init(&stress[0].rb, wordData, sizeof(wordData[0]), WORD_RB_SIZE);
+	stress[1].pName = "bytes";
+	stress[1].itemSz = sizeof(byteData[0]);
+	RingBuffer_Init(&stress[1].rb, byteData, sizeof(byteData[0]), BYTE_RB_SIZE);
+
+	for (i = 0; i < 2; i++) {
+		pthread_create(&threads[2 * i], NULL, producer, &stress[i]);
+		pthread_create(&threads[2 * i + 1], NULL, consumer, &stress[i]);
+	}
+	for (i = 0; i < 2; i++) {
+		/* A failed consumer stops, leaving its producer spinning on a full buffer */
+		pthread_join(threads[2 * i + 1], NULL);
+		if (stress[i].failures == 0) {
+			pthread_join(threads[2 * i], NULL);
+			if (!RingBuffer_IsEmpty(&stress[i].rb)) {
+				printf("FAIL %s: %d items left over\n", stress[i].pName, RingBuffer_GetCount(&stress[i].rb));
+				stress[i].failures++;
+			}
+		}
+		failures += stress[i].failures;
+	}
+	failures += checkTyped();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,290 @@
+/*
+ * @brief Host test of the pipelined SD card block transfers
+ *
+ * @note
+ * Runs sdmmc_17xx_40xx.c with GPDMA on the SD card interface model of the
+ * peripheral simulator, built for the LPC177x/8x (the LPC175x/6x has no
+ * SD card interface), with a 4 MB SDHC card, and checks that:
+ *   - Chip_SDMMC_Acquire() identifies the card and its size, and sets a
+ *     4 bit bus;
+ *   - single block and multiple block reads and writes, across the 127
+ *     block segments of the data length register, move the right data;
+ *   - a read of N blocks takes one CMD18 per segment and a write one
+ *     CMD25, and no block is lost to a FIFO overrun or sent to a data path
+ *     that is not there;
+ *   - a read after a read or a write skips the CMD13 and CMD7 of the
+ *     tran state check;
+ *   - transfers beyond the card and of no blocks are refused.
+ *
+ * @par
+ * Build and run from the repository root (-no-pie keeps the buffers that
+ * the driver hands to the GPDMA below 4 GB):
+ *
+ *   gcc -O2 -no-pie -DCORE_M3 -D__USE_LPCOPEN -DCHIP_LPC177X_8X \
+ *       -DSDC_DMA_ENABLE -Ilpc_chip_175x_6x/inc -Ilpc_chip_175x_6x/host \
+ *       lpc_chip_175x_6x/test/test_sdmmc.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/sdmmc_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sdc_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_sdmmc
+ *   ./test_sdmmc
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define PCLK_HZ             24000000
+#define CARD_BLOCKS         8192
+#define MAX_BLOCKS          300
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static uint8_t card[CARD_BLOCKS * MMC_SECTOR_SIZE];
+static uint32_t buf[MAX_BLOCKS * MMC_SECTOR_SIZE / 4];
+static SDMMC_CARD_T cardInfo;
+static volatile bool sdcDone;
+static volatile int32_t sdcResult;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void sdcIRQHandler(void)
+{
+	int32_t ret = Chip_SDMMC_IRQHandler(LPC_SDC, NULL, NULL, NULL, NULL);
+
+	if (ret <= 0) {
+		sdcResult = ret;
+		sdcDone = true;
+	}
+}
+
+static void evSetup(void *pEvent)
+{
+	(void) pEvent;
+	sdcDone = false;
+	sdcResult = 0;
+}
+
+/* Sleep until the transfer ends, as the board code does with __WFI() */
+static uint32_t evWait(void)
+{
+	int idle = 0;
+
+	while (!sdcDone) {
+		if (Sim_WaitForInterrupt() > 0) {
+			idle = 0;
+		}
+		else if (++idle > 100) {
+			/* Nothing left to happen */
+			return 1;
+		}
+	}
+	return (sdcResult == 0) ? 0 : 1;
+}
+
+static void msDelay(uint32_t time)
+{
+	Sim_Advance((uint64_t) time * (PCLK_HZ / 1000));
+}
+
+static void fillCard(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < sizeof(card); i++) {
+		card[i] = (uint8_t) (i * 7 + (i >> 9));
+	}
+}
+
+static void fill(void *pBuf, uint32_t count, uint32_t seed)
+{
+	uint8_t *p = pBuf;
+	uint32_t i;
+
+	for (i = 0; i < count * MMC_SECTOR_SIZE; i++) {
+		p[i] = (uint8_t) (seed + i * 13);
+	}
+}
+
+static void setUp(void)
+{
+	Sim_Init();
+	fillCard();
+	Sim_SDC_SetCard(card, CARD_BLOCKS);
+	Sim_SetIRQHandler(SDC_IRQn, sdcIRQHandler);
+	Chip_SDC_Init(LPC_SDC);
+	NVIC_EnableIRQ(SDC_IRQn);
+
+	memset(&cardInfo, 0, sizeof(cardInfo));
+	cardInfo.evsetup_cb = evSetup;
+	cardInfo.waitfunc_cb = evWait;
+	cardInfo.msdelay_func = msDelay;
+}
+
+static void testAcquire(void)
+{
+	SIM_SDC_STATS_T stats;
+
+	setUp();
+	CHECK(Chip_SDMMC_Acquire(LPC_SDC, &cardInfo) == 1, "card not acquired");
+	CHECK(cardInfo.blocknr == CARD_BLOCKS, "%u blocks", cardInfo.blocknr);
+	CHECK(cardInfo.block_len == MMC_SECTOR_SIZE, "block length %u", cardInfo.block_len);
+	CHECK((cardInfo.card_type & (CARD_TYPE_SD | CARD_TYPE_HC)) == (CARD_TYPE_SD | CARD_TYPE_HC),
+		  "card type 0x%x", cardInfo.card_type);
+	CHECK(LPC_SDC->CLOCK & (1 << SDC_CLOCK_WIDEBUS_MODE), "bus left 1 bit wide");
+	CHECK(Chip_SDMMC_GetCardState(LPC_SDC, &cardInfo) == SDMMC_TRAN_ST, "card not in tran state");
+
+	Sim_SDC_GetStats(&stats);
+	CHECK(stats.appCommands[SD_APP_OP_COND] == 3, "%u ACMD41s", stats.appCommands[SD_APP_OP_COND]);
+	CHECK(stats.appCommands[SD_APP_SET_BUS_WIDTH] == 1, "%u ACMD6s", stats.appCommands[SD_APP_SET_BUS_WIDTH]);
+}
+
+/* Read count blocks from start, check them and the card commands */
+static void checkRead(uint32_t start, uint32_t count)
+{
+	SIM_SDC_STATS_T stats;
+	uint32_t segments = (count + 126) / 127;
+
+	memset(buf, 0, sizeof(buf));
+	Sim_SDC_ClearStats();
+	CHECK(Chip_SDMMC_ReadBlocks(LPC_SDC, &cardInfo, buf, start, count) == (int32_t) (count * MMC_SECTOR_SIZE),
+		  "read of %u at %u", count, start);
+	CHECK(memcmp(buf, &card[start * MMC_SECTOR_SIZE], count * MMC_SECTOR_SIZE) == 0,
+		  "read of %u at %u differs from the card", count, start);
+
+	Sim_SDC_GetStats(&stats);
+	CHECK(stats.blocksRead == count, "read of %u took %u blocks", count, stats.blocksRead);
+	CHECK((stats.overruns == 0) && (stats.crcErrors == 0), "read of %u: %u overruns, %u CRC errors",
+		  count, stats.overruns, stats.crcErrors);
+	if (count == 1) {
+		CHECK((stats.commands[MMC_READ_SINGLE_BLOCK] == 1) && (stats.commands[MMC_READ_MULTIPLE_BLOCK] == 0),
+			  "read of 1 took %u CMD17s, %u CMD18s", stats.commands[MMC_READ_SINGLE_BLOCK],
+			  stats.commands[MMC_READ_MULTIPLE_BLOCK]);
+	}
+	else {
+		CHECK(stats.commands[MMC_READ_MULTIPLE_BLOCK] == segments, "read of %u took %u CMD18s", count,
+			  stats.commands[MMC_READ_MULTIPLE_BLOCK]);
+		CHECK(stats.commands[MMC_STOP_TRANSMISSION] == segments, "read of %u took %u CMD12s", count,
+			  stats.commands[MMC_STOP_TRANSMISSION]);
+	}
+}
+
+static void testRead(void)
+{
+	SIM_SDC_STATS_T stats;
+
+	setUp();
+	Chip_SDMMC_Acquire(LPC_SDC, &cardInfo);
+	checkRead(5, 1);
+	checkRead(1000, 2);
+	checkRead(1000, 127);
+	checkRead(1000, 128);
+	checkRead(2000, MAX_BLOCKS);
+	checkRead(CARD_BLOCKS - MAX_BLOCKS, MAX_BLOCKS);
+
+	/* The read before left the card in tran state */
+	Sim_SDC_ClearStats();
+	Chip_SDMMC_ReadBlocks(LPC_SDC, &cardInfo, buf, 77, 3);
+	Sim_SDC_GetStats(&stats);
+	CHECK((stats.commands[MMC_SEND_STATUS] == 0) && (stats.commands[MMC_SELECT_CARD] == 0),
+		  "read after a read took %u CMD13s, %u CMD7s", stats.commands[MMC_SEND_STATUS],
+		  stats.commands[MMC_SELECT_CARD]);
+
+	CHECK(Chip_SDMMC_ReadBlocks(LPC_SDC, &cardInfo, buf, CARD_BLOCKS - 1, 2) == 0, "read beyond the card");
+	CHECK(Chip_SDMMC_ReadBlocks(LPC_SDC, &cardInfo, buf, 0, 0) == 0, "read of no blocks");
+	checkRead(0, 1);
+}
+
+/* Write count blocks to start and check the card */
+static void checkWrite(uint32_t start, uint32_t count, uint32_t seed)
+{
+	SIM_SDC_STATS_T stats;
+
+	fill(buf, count, seed);
+	Sim_SDC_ClearStats();
+	CHECK(Chip_SDMMC_WriteBlocks(LPC_SDC, &cardInfo, buf, start, count) == (int32_t) (count * MMC_SECTOR_SIZE),
+		  "write of %u at %u", count, start);
+	CHECK(memcmp(buf, &card[start * MMC_SECTOR_SIZE], count * MMC_SECTOR_SIZE) == 0,
+		  "card differs after the write of %u at %u", count, start);
+
+	Sim_SDC_GetStats(&stats);
+	CHECK(stats.blocksWritten == count, "write of %u wrote %u blocks", count, stats.blocksWritten);
+	CHECK(stats.crcErrors == 0, "write of %u: %u CRC errors", count, stats.crcErrors);
+	CHECK(stats.commands[(count == 1) ? MMC_WRITE_BLOCK : MMC_WRITE_MULTIPLE_BLOCK] == 1,
+		  "write of %u took %u CMD24s, %u CMD25s", count, stats.commands[MMC_WRITE_BLOCK],
+		  stats.commands[MMC_WRITE_MULTIPLE_BLOCK]);
+	CHECK(Chip_SDMMC_GetCardState(LPC_SDC, &cardInfo) == SDMMC_TRAN_ST, "card not in tran state after the write");
+}
+
+static void testWrite(void)
+{
+	static uint8_t around[2][MMC_SECTOR_SIZE];
+	SIM_SDC_STATS_T stats;
+
+	setUp();
+	Chip_SDMMC_Acquire(LPC_SDC, &cardInfo);
+	checkWrite(7, 1, 1);
+	checkWrite(3000, 2, 2);
+	checkWrite(3100, 127, 3);
+	checkWrite(3300, 128, 4);
+	checkWrite(4000, MAX_BLOCKS, 5);
+	checkWrite(CARD_BLOCKS - MAX_BLOCKS, MAX_BLOCKS, 6);
+
+	/* Blocks before and after the write are left alone */
+	memcpy(around[0], &card[499 * MMC_SECTOR_SIZE], MMC_SECTOR_SIZE);
+	memcpy(around[1], &card[510 * MMC_SECTOR_SIZE], MMC_SECTOR_SIZE);
+	checkWrite(500, 10, 7);
+	CHECK(memcmp(around[0], &card[499 * MMC_SECTOR_SIZE], MMC_SECTOR_SIZE) == 0, "block before the write changed");
+	CHECK(memcmp(around[1], &card[510 * MMC_SECTOR_SIZE], MMC_SECTOR_SIZE) == 0, "block after the write changed");
+
+	/* Read back through the driver, the write waited for tran state so
+	   the read does not check it again */
+	checkWrite(600, 200, 8);
+	Sim_SDC_ClearStats();
+	memset(buf, 0, sizeof(buf));
+	CHECK(Chip_SDMMC_ReadBlocks(LPC_SDC, &cardInfo, buf, 600, 200) == 200 * MMC_SECTOR_SIZE, "read back");
+	CHECK(memcmp(buf, &card[600 * MMC_SECTOR_SIZE], 200 * MMC_SECTOR_SIZE) == 0, "read back differs");
+	Sim_SDC_GetStats(&stats);
+	CHECK((stats.commands[MMC_SEND_STATUS] == 0) && (stats.commands[MMC_SELECT_CARD] == 0),
+		  "read after a write took %u CMD13s, %u CMD7s", stats.commands[MMC_SEND_STATUS],
+		  stats.commands[MMC_SELECT_CARD]);
+
+	CHECK(Chip_SDMMC_WriteBlocks(LPC_SDC, &cardInfo, buf, CARD_BLOCKS - 1, 2) == 0, "write beyond the card");
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	testAcquire();
+	testRead();
+	testWrite();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+/*
+ * @brief Host test of the SSP DMA transaction queue
+ *
+ * @note
+ * Runs SSP0 in loopback through Chip_SSP_DMA_Queue() on the SSP and GPDMA
+ * models of the peripheral simulator, and checks that:
+ *   - transactions move every frame and call done in queue order;
+ *   - Chip_SSP_DMA_Queue() leaves DMA_IRQn enabled or disabled as it found
+ *     it, and transactions queued with it disabled finish once it is enabled;
+ *   - a transaction whose GPDMA channels do not start fails: the queue call
+ *     returns ERROR when it would run at once, and a queued one is done with
+ *     status ERROR from the interrupt, after the one before it.
+ * A channel is kept from starting by a UART receive transfer left waiting on
+ * the SSP transmit channel, as an application bug that shares the channel
+ * would.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_ssp_dma.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/ssp_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_ssp_dma
+ *   ./test_ssp_dma
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define NUM_XFERS           4
+#define XFER_FRAMES         64
+
+/* Long enough for any transaction here at 4 MHz, run in steps of about a
+   frame since interrupts are delivered at the end of Sim_Advance() */
+#define RUN_CYCLES          (24 * 1000)
+#define STEP_CYCLES         48
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static SSP_DMA_CTX_T *pSSPDMA;
+static SSP_DMA_XFER_T xfers[NUM_XFERS];
+static uint8_t *pTx[NUM_XFERS], *pRx[NUM_XFERS];
+
+/* Transactions in the order their done callbacks ran */
+static int doneOrder[NUM_XFERS * 2];
+static int numDone;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void dmaIRQHandler(void)
+{
+	Chip_SSP_DMA_IRQHandler(pSSPDMA);
+}
+
+static void xferDone(SSP_DMA_CTX_T *pDMA, SSP_DMA_XFER_T *pXfer)
+{
+	(void) pDMA;
+	doneOrder[numDone++] = (int) (pXfer - xfers);
+}
+
+static void run(uint32_t cycles)
+{
+	uint32_t i;
+
+	for (i = 0; i < cycles; i += STEP_CYCLES) {
+		Sim_Advance(STEP_CYCLES);
+	}
+}
+
+static bool dmaIRQEnabled(void)
+{
+	return (NVIC->ISER[((uint32_t) DMA_IRQn) >> 5] & (1UL << ((uint32_t) DMA_IRQn & 0x1F))) != 0;
+}
+
+static void prepareXfer(int i)
+{
+	int j;
+
+	for (j = 0; j < XFER_FRAMES; j++) {
+		pTx[i][j] = (uint8_t) (i * 31 + j);
+	}
+	memset(pRx[i], 0, XFER_FRAMES);
+	memset(&xfers[i], 0, sizeof(xfers[i]));
+	xfers[i].tx_data = pTx[i];
+	xfers[i].rx_data = pRx[i];
+	xfers[i].length = XFER_FRAMES;
+	xfers[i].cs.port = SSP_DMA_NO_CS;
+	xfers[i].done = xferDone;
+	xfers[i].status = ERROR;
+}
+
+static void checkXfer(int i)
+{
+	CHECK(xfers[i].status == SUCCESS, "transaction %d status ERROR", i);
+	CHECK(memcmp(pRx[i], pTx[i], XFER_FRAMES) == 0, "transaction %d frames wrong", i);
+}
+
+/* Transactions queued with DMA_IRQn on and off */
+static void testQueue(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_XFERS; i++) {
+		prepareXfer(i);
+	}
+	numDone = 0;
+
+	NVIC_EnableIRQ(DMA_IRQn);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[0]) == SUCCESS, "queue 0");
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[1]) == SUCCESS, "queue 1");
+	CHECK(dmaIRQEnabled(), "DMA_IRQn left disabled");
+	run(2 * RUN_CYCLES);
+
+	/* An application polling with the interrupt off */
+	NVIC_DisableIRQ(DMA_IRQn);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[2]) == SUCCESS, "queue 2");
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[3]) == SUCCESS, "queue 3");
+	CHECK(!dmaIRQEnabled(), "DMA_IRQn turned on by Chip_SSP_DMA_Queue()");
+	run(RUN_CYCLES);
+	CHECK(numDone == 2, "%d transactions done with DMA_IRQn off", numDone);
+
+	NVIC_EnableIRQ(DMA_IRQn);
+	run(2 * RUN_CYCLES);
+
+	CHECK(numDone == NUM_XFERS, "%d of %d transactions done", numDone, NUM_XFERS);
+	for (i = 0; i < NUM_XFERS; i++) {
+		checkXfer(i);
+		CHECK((i >= numDone) || (doneOrder[i] == i), "transaction %d done in place %d", doneOrder[i], i);
+	}
+	CHECK(!Chip_SSP_DMA_Busy(pSSPDMA), "queue not empty");
+}
+
+/* Transactions whose transmit channel is held by another transfer */
+static void testStartFailure(void)
+{
+	uint8_t *pBlock = Sim_RamAlloc(4);
+	int i;
+
+	for (i = 0; i < NUM_XFERS; i++) {
+		prepareXfer(i);
+	}
+	numDone = 0;
+
+	/* Queue failing at once, with the queue empty */
+	Chip_GPDMA_Transfer(LPC_GPDMA, pSSPDMA->txChannel, GPDMA_CONN_UART1_Rx, (uint32_t) pBlock,
+						GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, 4);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[0]) == ERROR, "queue with the channel held");
+	CHECK(!Chip_SSP_DMA_Busy(pSSPDMA), "failed transaction left on the queue");
+	CHECK((LPC_GPDMA->ENBLDCHNS & (1UL << pSSPDMA->rxChannel)) == 0, "receive channel left running");
+	CHECK(dmaIRQEnabled(), "DMA_IRQn left disabled");
+	Chip_GPDMA_ChannelCmd(LPC_GPDMA, pSSPDMA->txChannel, DISABLE);
+
+	/* Transaction 0 finishes while the interrupt is off, then the channel
+	   is taken before the interrupt starts transactions 1 and 2 */
+	prepareXfer(0);
+	NVIC_DisableIRQ(DMA_IRQn);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[0]) == SUCCESS, "queue 0");
+	run(RUN_CYCLES);
+	Chip_GPDMA_Transfer(LPC_GPDMA, pSSPDMA->txChannel, GPDMA_CONN_UART1_Rx, (uint32_t) pBlock,
+						GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, 4);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[1]) == SUCCESS, "queue 1 behind 0");
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[2]) == SUCCESS, "queue 2 behind 1");
+	NVIC_EnableIRQ(DMA_IRQn);
+	run(RUN_CYCLES);
+
+	CHECK(numDone == 3, "%d of 3 transactions done", numDone);
+	CHECK((numDone == 3) && (doneOrder[0] == 0) && (doneOrder[1] == 1) && (doneOrder[2] == 2),
+		  "transactions done out of order");
+	checkXfer(0);
+	CHECK(xfers[1].status == ERROR, "transaction 1 status SUCCESS");
+	CHECK(xfers[2].status == ERROR, "transaction 2 status SUCCESS");
+	CHECK(!Chip_SSP_DMA_Busy(pSSPDMA), "failed transactions left on the queue");
+
+	/* The queue works again once the channel is free */
+	Chip_GPDMA_ChannelCmd(LPC_GPDMA, pSSPDMA->txChannel, DISABLE);
+	prepareXfer(3);
+	CHECK(Chip_SSP_DMA_Queue(pSSPDMA, &xfers[3]) == SUCCESS, "queue 3");
+	run(RUN_CYCLES);
+	checkXfer(3);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	int i;
+
+	Sim_Init();
+	for (i = 0; i < NUM_XFERS; i++) {
+		pTx[i] = Sim_RamAlloc(XFER_FRAMES);
+		pRx[i] = Sim_RamAlloc(XFER_FRAMES);
+	}
+
+	Chip_SSP_Init(LPC_SSP0);
+	Chip_SSP_SetBitRate(LPC_SSP0, 4000000);
+	Chip_SSP_EnableLoopBack(LPC_SSP0);
+	Chip_SSP_Enable(LPC_SSP0);
+	Chip_GPDMA_Init(LPC_GPDMA);
+
+	pSSPDMA = Sim_RamAlloc(sizeof(SSP_DMA_CTX_T));
+	if (Chip_SSP_DMA_Init(pSSPDMA, LPC_SSP0, LPC_GPDMA) != SUCCESS) {
+		printf("FAIL: Chip_SSP_DMA_Init()\n");
+		return 1;
+	}
+	Sim_SetIRQHandler(DMA_IRQn, dmaIRQHandler);
+
+	testQueue();
+	testStartFailure();
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
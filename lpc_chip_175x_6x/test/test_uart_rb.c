@@ -0,0 +1,142 @@
+/*
+ * @brief Host test of UART transmission through a ring buffer
+ *
+ * @note
+ * Sends 10000 bytes through a 32 byte transmit ring buffer on the UART
+ * model of the peripheral simulator.  Chip_UART_SendRB() is the producer and
+ * Chip_UART_IRQRBHandler() the consumer, as a task and the UART interrupt are
+ * on the chip.  The sends are of random lengths, with random gaps between
+ * them, so SendRB() finds the transmit interrupt both on (the handler is
+ * draining the ring buffer) and off (the handler found it empty and stopped).
+ * Every byte must come out of the UART once and in order, without the
+ * transmission stalling on a lost THRE interrupt.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host lpc_chip_175x_6x/test/test_uart_rb.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/uart_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/gpdma_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/ring_buffer.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c -o test_uart_rb
+ *   ./test_uart_rb
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define TOTAL_BYTES         10000
+#define TX_RB_SIZE          32
+#define MAX_SEND            48
+
+/* 115200 baud is about 2080 peripheral clocks a character at 24 MHz */
+#define CHAR_CYCLES         2080
+#define MAX_GAP_CYCLES      (40 * CHAR_CYCLES)
+
+/* Time without a character on the line after which transmission has stalled */
+#define STALL_CYCLES        (100 * CHAR_CYCLES)
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static RINGBUFF_T txRing, rxRing;
+static uint8_t txData[TX_RB_SIZE], rxData[TX_RB_SIZE];
+
+static uint8_t sent[TOTAL_BYTES], received[TOTAL_BYTES];
+static int numReceived;
+
+static unsigned long sendsWithIntOn, sendsWithIntOff;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void uart0IRQHandler(void)
+{
+	Chip_UART_IRQRBHandler(LPC_UART0, &rxRing, &txRing);
+}
+
+static void collect(void)
+{
+	numReceived += Sim_UART_Transmitted(LPC_UART0, &received[numReceived], TOTAL_BYTES - numReceived);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	int i, numSent = 0, num, failures = 0, lastReceived = 0;
+	uint64_t lastProgress;
+
+	srand(1);
+	for (i = 0; i < TOTAL_BYTES; i++) {
+		sent[i] = (uint8_t) rand();
+	}
+
+	Sim_Init();
+	RingBuffer_Init(&txRing, txData, 1, TX_RB_SIZE);
+	RingBuffer_Init(&rxRing, rxData, 1, TX_RB_SIZE);
+	Chip_UART_Init(LPC_UART0);
+	Chip_UART_SetBaud(LPC_UART0, 115200);
+	Chip_UART_ConfigData(LPC_UART0, UART_LCR_WLEN8 | UART_LCR_SBS_1BIT);
+	Chip_UART_SetupFIFOS(LPC_UART0, UART_FCR_FIFO_EN | UART_FCR_TRG_LEV2);
+	Chip_UART_TXEnable(LPC_UART0);
+	Sim_SetIRQHandler(UART0_IRQn, uart0IRQHandler);
+	NVIC_EnableIRQ(UART0_IRQn);
+
+	lastProgress = Sim_GetCycles();
+	while ((numReceived < TOTAL_BYTES) && ((Sim_GetCycles() - lastProgress) < STALL_CYCLES)) {
+		if (numSent < TOTAL_BYTES) {
+			num = MIN(1 + rand() % MAX_SEND, TOTAL_BYTES - numSent);
+			if ((LPC_UART0->IER & UART_IER_THREINT) != 0) {
+				sendsWithIntOn++;
+			}
+			else {
+				sendsWithIntOff++;
+			}
+			numSent += Chip_UART_SendRB(LPC_UART0, &txRing, &sent[numSent], num);
+			Sim_Advance(rand() % MAX_GAP_CYCLES);
+		}
+		else {
+			/* All queued, let the ring buffer drain */
+			Sim_Advance(CHAR_CYCLES);
+		}
+		collect();
+		if (numReceived != lastReceived) {
+			lastReceived = numReceived;
+			lastProgress = Sim_GetCycles();
+		}
+	}
+
+	if (numReceived != TOTAL_BYTES) {
+		printf("FAIL: transmission stalled after %d of %d bytes\n", numReceived, TOTAL_BYTES);
+		failures++;
+	}
+	for (i = 0; i < numReceived; i++) {
+		if (received[i] != sent[i]) {
+			printf("FAIL: byte %d is 0x%02x, expected 0x%02x\n", i, received[i], sent[i]);
+			failures++;
+			break;
+		}
+	}
+	if ((sendsWithIntOn == 0) || (sendsWithIntOff == 0)) {
+		printf("FAIL: sends with the transmit interrupt on %lu, off %lu\n", sendsWithIntOn, sendsWithIntOff);
+		failures++;
+	}
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
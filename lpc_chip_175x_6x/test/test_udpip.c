@@ -0,0 +1,480 @@
+/*
+ * @brief Host test of the udpip stack over the Ethernet rings
+ *
+ * @note
+ * Runs udpip/ on the ENET model of the peripheral simulator and checks that:
+ *   - UdpIp_Checksum() gives the same sum as a bytewise big endian
+ *     reference for every start alignment, lengths of 0 to 299 and in
+ *     pieces;
+ *   - with MAC1 loopback on, datagrams of 0 to 1472 bytes sent to the
+ *     stack's own address come back to the bound port intact, from the
+ *     right port, with header fields in network byte order and valid IP
+ *     and UDP checksums on the wire; a datagram for a port nobody bound is
+ *     counted in rxUnhandled;
+ *   - playing a peer on the wire, ARP requests are answered, pings are
+ *     answered with a valid checksum and the data as sent, datagrams from
+ *     the peer reach the bound port with or without a UDP checksum, and a
+ *     bad UDP or IP checksum is counted in rxErrors without a callback;
+ *   - a datagram for an address not in the ARP cache waits for the reply
+ *     to the ARP request, and one outside the subnet goes to the gateway;
+ *   - every pool buffer is back in the pool at the end.
+ * Frames from the peer are built and checked byte by byte, without the
+ * stack's own helpers, so a byte order mistake shows.
+ *
+ * @par
+ * Build and run from the repository root:
+ *
+ *   gcc -O2 -DCORE_M3 -D__USE_LPCOPEN -Ilpc_chip_175x_6x/inc \
+ *       -Ilpc_chip_175x_6x/host -Iudpip/inc lpc_chip_175x_6x/test/test_udpip.c \
+ *       lpc_chip_175x_6x/host/periph_sim.c \
+ *       lpc_chip_175x_6x/src/enet_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/clock_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/sysctl_17xx_40xx.c \
+ *       lpc_chip_175x_6x/src/chip_17xx_40xx.c udpip/src/udpip.c -o test_udpip
+ *   ./test_udpip
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "chip.h"
+#include "periph_sim.h"
+#include "udpip.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define OUR_IP              UDPIP_IPADDR(192, 168, 1, 10)
+#define NET_MASK            UDPIP_IPADDR(255, 255, 255, 0)
+#define GATEWAY_IP          UDPIP_IPADDR(192, 168, 1, 1)
+#define PEER_IP             UDPIP_IPADDR(192, 168, 1, 20)
+#define OTHER_IP            UDPIP_IPADDR(192, 168, 1, 21)
+#define REMOTE_IP           UDPIP_IPADDR(10, 0, 0, 5)
+#define PORT                5000
+#define PEER_PORT           6000
+
+#define MAX_FRAME           1514
+
+/* A 1514 byte frame takes 2952 peripheral clocks at 100 Mbps, polled in
+   steps of about half of that */
+#define STEP_CYCLES         1500
+#define MAX_STEPS           100
+
+const uint32_t OscRateIn = 12000000;
+const uint32_t RTCOscRateIn = 32768;
+
+static const uint8_t ourMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x0A};
+static const uint8_t peerMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x14};
+static const uint8_t otherMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x15};
+static const uint8_t gatewayMac[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+
+static ENET_RING_T ring;
+static UDPIP_T stack;
+static uint8_t wire[MAX_FRAME];
+static uint8_t payload[UDPIP_MAX_PAYLOAD];
+
+/* Last datagram given to the bound port */
+static uint8_t recvData[UDPIP_MAX_PAYLOAD];
+static uint32_t recvLen, recvIp;
+static uint16_t recvPort;
+static int recvCount;
+
+static int failures;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+#define CHECK(cond, ...) do { \
+		if (!(cond)) { \
+			printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+			printf(__VA_ARGS__); \
+			printf("\n"); \
+			failures++; \
+		} \
+} while (0)
+
+static void put16(uint8_t *p, uint32_t value)
+{
+	p[0] = (uint8_t) (value >> 8);
+	p[1] = (uint8_t) value;
+}
+
+static uint32_t get16(const uint8_t *p)
+{
+	return ((uint32_t) p[0] << 8) | p[1];
+}
+
+/* Stack addresses are kept with the first byte lowest */
+static void putIp(uint8_t *p, uint32_t ip)
+{
+	p[0] = (uint8_t) ip;
+	p[1] = (uint8_t) (ip >> 8);
+	p[2] = (uint8_t) (ip >> 16);
+	p[3] = (uint8_t) (ip >> 24);
+}
+
+static uint32_t getIp(const uint8_t *p)
+{
+	return p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+/* Bytewise one's complement sum of big endian halfwords, folded */
+static uint32_t refSum(const uint8_t *p, uint32_t len, uint32_t sum)
+{
+	uint32_t i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += get16(&p[i]);
+	}
+	if (i < len) {
+		sum += (uint32_t) p[i] << 8;
+	}
+	while (sum > 0xFFFF) {
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	}
+	return sum;
+}
+
+/* Sum of the UDP pseudo header, source and destination as on the wire */
+static uint32_t refPseudoSum(const uint8_t *pIp, uint32_t udpLen)
+{
+	return refSum(&pIp[12], 8, 0) + 17 + udpLen;
+}
+
+static void datagramReceived(UDPIP_T *pStack, const uint8_t *pData, uint32_t len,
+							 uint32_t srcIp, uint16_t srcPort, void *ctx)
+{
+	memcpy(recvData, pData, len);
+	recvLen = len;
+	recvIp = srcIp;
+	recvPort = srcPort;
+	recvCount++;
+}
+
+/* Run the stack until the wire has a frame, returns its length or 0 */
+static int takeFrame(uint8_t *pFrame)
+{
+	int i, len = 0;
+
+	for (i = 0; (i < MAX_STEPS) && (len == 0); i++) {
+		Sim_Advance(STEP_CYCLES);
+		UdpIp_Poll(&stack);
+		len = Sim_ENET_Transmitted(pFrame, MAX_FRAME);
+	}
+	return len;
+}
+
+/* Run the stack for a while, throwing away what it sends */
+static void runIdle(void)
+{
+	int i;
+
+	for (i = 0; i < MAX_STEPS; i++) {
+		Sim_Advance(STEP_CYCLES);
+		UdpIp_Poll(&stack);
+	}
+	while (Sim_ENET_Transmitted(wire, MAX_FRAME) > 0) {}
+}
+
+static void fillPayload(uint8_t *p, uint32_t len, uint32_t seed)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		p[i] = (uint8_t) (i * 7 + seed);
+	}
+}
+
+/* Check a UDP/IPv4 frame the stack sent, returns 0 if it is wrong */
+static int checkUdpFrame(const uint8_t *pFrame, uint32_t len, const uint8_t *dstMac, uint32_t dstIp,
+						 uint32_t dstPort, const uint8_t *pData, uint32_t dataLen)
+{
+	const uint8_t *pIp = &pFrame[14], *pUdp = &pFrame[34];
+	uint32_t udpLen = dataLen + 8;
+
+	return (len == MAX(34 + udpLen, 60)) && (memcmp(pFrame, dstMac, 6) == 0) &&
+		   (memcmp(&pFrame[6], ourMac, 6) == 0) && (get16(&pFrame[12]) == 0x0800) &&
+		   (pIp[0] == 0x45) && (get16(&pIp[2]) == 20 + udpLen) && (get16(&pIp[6]) == 0x4000) &&
+		   (pIp[8] == UDPIP_TTL) && (pIp[9] == 17) && (refSum(pIp, 20, 0) == 0xFFFF) &&
+		   (getIp(&pIp[12]) == OUR_IP) && (getIp(&pIp[16]) == dstIp) &&
+		   (get16(&pUdp[0]) == PORT) && (get16(&pUdp[2]) == dstPort) && (get16(&pUdp[4]) == udpLen) &&
+		   (get16(&pUdp[6]) != 0) && (refSum(pUdp, udpLen, refPseudoSum(pIp, udpLen)) == 0xFFFF) &&
+		   (memcmp(&pUdp[8], pData, dataLen) == 0);
+}
+
+/* Ethernet header from the peer and an IPv4 header, returns the frame length */
+static uint32_t buildIp(uint8_t *pFrame, uint32_t proto, uint32_t ipPayloadLen)
+{
+	uint8_t *pIp = &pFrame[14];
+
+	memcpy(pFrame, ourMac, 6);
+	memcpy(&pFrame[6], peerMac, 6);
+	put16(&pFrame[12], 0x0800);
+	pIp[0] = 0x45;
+	pIp[1] = 0;
+	put16(&pIp[2], 20 + ipPayloadLen);
+	put16(&pIp[4], 0x1234);
+	put16(&pIp[6], 0);
+	pIp[8] = 64;
+	pIp[9] = (uint8_t) proto;
+	put16(&pIp[10], 0);
+	putIp(&pIp[12], PEER_IP);
+	putIp(&pIp[16], OUR_IP);
+	put16(&pIp[10], ~refSum(pIp, 20, 0));
+	return 34 + ipPayloadLen;
+}
+
+/* UDP datagram from the peer to PORT, returns the frame length */
+static uint32_t buildUdp(uint8_t *pFrame, const uint8_t *pData, uint32_t dataLen, int withSum)
+{
+	uint8_t *pUdp = &pFrame[34];
+	uint32_t len = buildIp(pFrame, 17, dataLen + 8);
+
+	put16(&pUdp[0], PEER_PORT);
+	put16(&pUdp[2], PORT);
+	put16(&pUdp[4], dataLen + 8);
+	put16(&pUdp[6], 0);
+	memcpy(&pUdp[8], pData, dataLen);
+	if (withSum) {
+		put16(&pUdp[6], ~refSum(pUdp, dataLen + 8, refPseudoSum(&pFrame[14], dataLen + 8)));
+	}
+	return len;
+}
+
+static uint32_t buildArp(uint8_t *pFrame, uint32_t oper, const uint8_t *senderMac, uint32_t senderIp)
+{
+	static const uint8_t macUnknown[6];
+
+	memcpy(pFrame, (oper == 1) ? (const uint8_t *) "\xFF\xFF\xFF\xFF\xFF\xFF" : ourMac, 6);
+	memcpy(&pFrame[6], senderMac, 6);
+	put16(&pFrame[12], 0x0806);
+	put16(&pFrame[14], 1);
+	put16(&pFrame[16], 0x0800);
+	pFrame[18] = 6;
+	pFrame[19] = 4;
+	put16(&pFrame[20], oper);
+	memcpy(&pFrame[22], senderMac, 6);
+	putIp(&pFrame[28], senderIp);
+	memcpy(&pFrame[32], (oper == 1) ? macUnknown : ourMac, 6);
+	putIp(&pFrame[38], OUR_IP);
+	return 42;
+}
+
+/* Check an ARP request of the stack for an address */
+static int checkArpRequest(const uint8_t *pFrame, uint32_t len, uint32_t ip)
+{
+	return (len == 60) && (memcmp(pFrame, "\xFF\xFF\xFF\xFF\xFF\xFF", 6) == 0) &&
+		   (get16(&pFrame[12]) == 0x0806) && (get16(&pFrame[20]) == 1) &&
+		   (memcmp(&pFrame[22], ourMac, 6) == 0) && (getIp(&pFrame[28]) == OUR_IP) &&
+		   (getIp(&pFrame[38]) == ip);
+}
+
+static void testChecksum(void)
+{
+	uint8_t *pBuf = payload;
+	uint32_t off, len, split, want;
+	int bad = 0;
+
+	fillPayload(pBuf, 512, 11);
+	for (off = 0; off < 8; off++) {
+		for (len = 0; len < 300; len++) {
+			want = UDPIP_HTONS(refSum(&pBuf[off], len, 0));
+			if (UdpIp_Checksum(&pBuf[off], len, 0) != want) {
+				bad++;
+			}
+			split = (len / 3) & ~1;
+			if (UdpIp_Checksum(&pBuf[off + split], len - split, UdpIp_Checksum(&pBuf[off], split, 0)) != want) {
+				bad++;
+			}
+		}
+	}
+	CHECK(bad == 0, "%d checksums differ from the reference", bad);
+}
+
+static void testLoopback(void)
+{
+	static const uint32_t lens[] = {0, 1, 2, 3, 18, 100, 511, 512, 1471, UDPIP_MAX_PAYLOAD};
+	uint32_t freeBefore = ring.freeCount, unhandled, i;
+	uint8_t *p;
+	int len;
+
+	LPC_ETHERNET->MAC.MAC1 |= ENET_MAC1_LOOPBACK;
+	CHECK(UdpIp_Bind(&stack, PORT, datagramReceived, NULL) == SUCCESS, "bind");
+
+	for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++) {
+		fillPayload(payload, lens[i], i);
+		p = UdpIp_AllocPayload(&stack);
+		memcpy(p, payload, lens[i]);
+		recvCount = 0;
+		CHECK(UdpIp_SendTo(&stack, p, lens[i], OUR_IP, PORT, PORT) == SUCCESS, "send of %u bytes", lens[i]);
+		len = takeFrame(wire);
+		CHECK(checkUdpFrame(wire, len, ourMac, OUR_IP, PORT, payload, lens[i]),
+			  "frame of %u bytes wrong on the wire", lens[i]);
+		runIdle();
+		CHECK(recvCount == 1, "datagram of %u bytes received %d times", lens[i], recvCount);
+		CHECK((recvLen == lens[i]) && (memcmp(recvData, payload, lens[i]) == 0),
+			  "datagram of %u bytes received as %u bytes or changed", lens[i], recvLen);
+		CHECK((recvIp == OUR_IP) && (recvPort == PORT), "datagram from 0x%08x port %u", recvIp, recvPort);
+	}
+	CHECK(stack.rxErrors == 0, "%u receive errors in loopback", stack.rxErrors);
+
+	unhandled = stack.rxUnhandled;
+	recvCount = 0;
+	p = UdpIp_AllocPayload(&stack);
+	CHECK(UdpIp_SendTo(&stack, p, 10, OUR_IP, PORT + 1, PORT) == SUCCESS, "send to an unbound port");
+	runIdle();
+	CHECK((recvCount == 0) && (stack.rxUnhandled == unhandled + 1), "datagram for an unbound port handled");
+
+	LPC_ETHERNET->MAC.MAC1 &= ~ENET_MAC1_LOOPBACK;
+	runIdle();
+	CHECK(ring.freeCount == freeBefore, "pool has %u buffers, %u before", ring.freeCount, freeBefore);
+}
+
+static void testArpReply(void)
+{
+	int len;
+
+	Sim_ENET_Receive(wire, buildArp(wire, 1, peerMac, PEER_IP));
+	len = takeFrame(wire);
+	CHECK((len == 60) && (memcmp(wire, peerMac, 6) == 0) && (memcmp(&wire[6], ourMac, 6) == 0) &&
+		  (get16(&wire[12]) == 0x0806) && (get16(&wire[14]) == 1) && (get16(&wire[16]) == 0x0800) &&
+		  (wire[18] == 6) && (wire[19] == 4) && (get16(&wire[20]) == 2) &&
+		  (memcmp(&wire[22], ourMac, 6) == 0) && (getIp(&wire[28]) == OUR_IP) &&
+		  (memcmp(&wire[32], peerMac, 6) == 0) && (getIp(&wire[38]) == PEER_IP), "ARP reply wrong");
+}
+
+static void testPing(void)
+{
+	uint8_t *pIcmp = &wire[34], data[56];
+	uint32_t packets = stack.rxPackets, frameLen;
+	int len;
+
+	fillPayload(data, sizeof(data), 3);
+	frameLen = buildIp(wire, 1, 8 + sizeof(data));
+	pIcmp[0] = 8;
+	pIcmp[1] = 0;
+	put16(&pIcmp[2], 0);
+	put16(&pIcmp[4], 0xBEEF);
+	put16(&pIcmp[6], 7);
+	memcpy(&pIcmp[8], data, sizeof(data));
+	put16(&pIcmp[2], ~refSum(pIcmp, 8 + sizeof(data), 0));
+	Sim_ENET_Receive(wire, frameLen);
+
+	len = takeFrame(wire);
+	CHECK(((uint32_t) len == frameLen) && (memcmp(wire, peerMac, 6) == 0) && (memcmp(&wire[6], ourMac, 6) == 0),
+		  "ping reply of %d bytes, Ethernet header wrong", len);
+	CHECK((refSum(&wire[14], 20, 0) == 0xFFFF) && (getIp(&wire[26]) == OUR_IP) && (getIp(&wire[30]) == PEER_IP),
+		  "ping reply IP header wrong");
+	CHECK((pIcmp[0] == 0) && (get16(&pIcmp[4]) == 0xBEEF) && (get16(&pIcmp[6]) == 7) &&
+		  (memcmp(&pIcmp[8], data, sizeof(data)) == 0), "ping reply fields wrong");
+	CHECK(refSum(pIcmp, 8 + sizeof(data), 0) == 0xFFFF, "ping reply checksum wrong");
+	CHECK(stack.rxPackets == packets + 1, "ping not counted");
+}
+
+static void testPeerDatagrams(void)
+{
+	uint32_t errors = stack.rxErrors, frameLen;
+
+	fillPayload(payload, 300, 21);
+
+	recvCount = 0;
+	Sim_ENET_Receive(wire, buildUdp(wire, payload, 300, 1));
+	runIdle();
+	CHECK((recvCount == 1) && (recvLen == 300) && (memcmp(recvData, payload, 300) == 0),
+		  "datagram from the peer not received intact");
+	CHECK((recvIp == PEER_IP) && (recvPort == PEER_PORT), "datagram from 0x%08x port %u", recvIp, recvPort);
+
+	/* A zero UDP checksum means none was sent */
+	recvCount = 0;
+	Sim_ENET_Receive(wire, buildUdp(wire, payload, 33, 0));
+	runIdle();
+	CHECK((recvCount == 1) && (recvLen == 33), "datagram without a checksum not received");
+
+	recvCount = 0;
+	frameLen = buildUdp(wire, payload, 300, 1);
+	wire[34 + 8 + 100] ^= 0x01;
+	Sim_ENET_Receive(wire, frameLen);
+	frameLen = buildUdp(wire, payload, 300, 1);
+	wire[14 + 8] = 1;
+	Sim_ENET_Receive(wire, frameLen);
+	runIdle();
+	CHECK(recvCount == 0, "%d datagrams with a bad checksum received", recvCount);
+	CHECK(stack.rxErrors == errors + 2, "%u of 2 bad checksums counted", stack.rxErrors - errors);
+}
+
+/* Datagrams for hops not in the ARP cache */
+static void testArpResolve(void)
+{
+	uint8_t *p;
+	int len;
+
+	fillPayload(payload, 200, 31);
+	p = UdpIp_AllocPayload(&stack);
+	memcpy(p, payload, 200);
+	CHECK(UdpIp_SendTo(&stack, p, 200, OTHER_IP, PEER_PORT, PORT) == SUCCESS, "send to an unresolved address");
+	len = takeFrame(wire);
+	CHECK(checkArpRequest(wire, len, OTHER_IP), "no ARP request for an unresolved address");
+	runIdle();
+
+	Sim_ENET_Receive(wire, buildArp(wire, 2, otherMac, OTHER_IP));
+	len = takeFrame(wire);
+	CHECK(checkUdpFrame(wire, len, otherMac, OTHER_IP, PEER_PORT, payload, 200),
+		  "waiting datagram not sent after the ARP reply");
+
+	/* Resolved, the next one goes straight out */
+	p = UdpIp_AllocPayload(&stack);
+	memcpy(p, payload, 50);
+	UdpIp_SendTo(&stack, p, 50, OTHER_IP, PEER_PORT, PORT);
+	len = takeFrame(wire);
+	CHECK(checkUdpFrame(wire, len, otherMac, OTHER_IP, PEER_PORT, payload, 50), "datagram to a resolved address");
+
+	/* Outside the subnet, through the gateway */
+	p = UdpIp_AllocPayload(&stack);
+	memcpy(p, payload, 80);
+	UdpIp_SendTo(&stack, p, 80, REMOTE_IP, PEER_PORT, PORT);
+	len = takeFrame(wire);
+	CHECK(checkArpRequest(wire, len, GATEWAY_IP), "no ARP request for the gateway");
+	Sim_ENET_Receive(wire, buildArp(wire, 2, gatewayMac, GATEWAY_IP));
+	len = takeFrame(wire);
+	CHECK(checkUdpFrame(wire, len, gatewayMac, REMOTE_IP, PEER_PORT, payload, 80),
+		  "datagram outside the subnet not sent to the gateway");
+	runIdle();
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(void)
+{
+	uint32_t poolBufs;
+	void *pMem;
+
+	Sim_Init();
+	pMem = Sim_RamAlloc(ENET_RING_MEM_SIZE);
+
+	Chip_ENET_Init(LPC_ETHERNET, true);
+	if ((pMem == NULL) || (Chip_ENET_Ring_Init(&ring, LPC_ETHERNET, pMem, NULL) != SUCCESS)) {
+		printf("FAIL: Chip_ENET_Ring_Init()\n");
+		return 1;
+	}
+	Chip_ENET_TXEnable(LPC_ETHERNET);
+	Chip_ENET_RXEnable(LPC_ETHERNET);
+	poolBufs = ring.freeCount;
+	UdpIp_Init(&stack, &ring, ourMac, OUR_IP, NET_MASK, GATEWAY_IP);
+
+	testChecksum();
+	testLoopback();
+	testArpReply();
+	testPing();
+	testPeerDatagrams();
+	testArpResolve();
+
+	CHECK(ring.freeCount == poolBufs, "pool has %u of %u buffers at the end", ring.freeCount, poolBufs);
+	CHECK(stack.txDropped == 0, "%u frames dropped on send", stack.txDropped);
+
+	printf("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
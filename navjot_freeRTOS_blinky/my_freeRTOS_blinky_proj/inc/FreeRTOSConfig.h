@@ -83,6 +83,7 @@
 #endif
 #define configMAX_TASK_NAME_LEN		( 20 )
 #define configUSE_TRACE_FACILITY	1
+#define configUSE_TRACE_RECORDER	0
 #define configUSE_16_BIT_TICKS		0
 #define configIDLE_SHOULD_YIELD		1
 #define configUSE_CO_ROUTINES 		0
@@ -93,10 +94,10 @@
 
 #define configUSE_COUNTING_SEMAPHORES 	1
 #define configUSE_ALTERNATIVE_API 		0
-#define configCHECK_FOR_STACK_OVERFLOW	0
+#define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configQUEUE_REGISTRY_SIZE		10
-#define configGENERATE_RUN_TIME_STATS	0
+#define configGENERATE_RUN_TIME_STATS	1
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -163,10 +164,27 @@ See http://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html. */
 #endif /* defined(CORE_M4) */
 #endif /* defined(CORE_M3) */
 
+/* Run time stats time base: a free-running 32-bit timer, read directly on
+every context switch.  See FreeRTOSRunTimeStats.h. */
+#define configRUN_TIME_STATS_TIMER			LPC_TIMER1
+#define configRUN_TIME_STATS_TIMER_PCLK		SYSCTL_PCLK_TIMER1
+#define configRUN_TIME_STATS_CLOCK_HZ		( 1000000UL )
+
+#ifndef __IASMARM__
+void vConfigureTimerForRunTimeStats(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vConfigureTimerForRunTimeStats()
+#define portGET_RUN_TIME_COUNTER_VALUE()			( configRUN_TIME_STATS_TIMER->TC )
+
 /* Definitions that map the FreeRTOS port interrupt handlers to their CMSIS
 standard names - or at least those used in the unmodified vector table. */
 #define vPortSVCHandler SVC_Handler
 #define xPortPendSVHandler PendSV_Handler
 #define xPortSysTickHandler SysTick_Handler
 
+/* Kernel trace macros, mapped onto the binary trace recorder */
+#ifndef __IASMARM__
+#include "FreeRTOSTrace.h"
+#endif
+
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,663 @@
+/*
+ * @brief Host flash and RAM footprint report from GNU ld map files
+ *
+ * @note
+ * Parses the "Linker script and memory map" part of a GNU ld map file (the
+ * *.map written to each Debug/ directory) into per object and per symbol size
+ * tables, split into text (code and constants in flash), data (initialised
+ * RAM, which also takes its load image in flash) and bss (zeroed RAM), and
+ * prints how full each memory region is.
+ *
+ * With two map files it prints the difference between the builds instead:
+ * totals, then every object and symbol that changed size, largest change
+ * first.  Symbols are named after their input section, so builds should use
+ * -ffunction-sections -fdata-sections as the LPCOpen projects do.
+ *
+ * A budget file makes the tool fail (exit status 1) when a build is too big
+ * or, in diff mode, grew too much.  One limit per line, in bytes:
+ *     flash <bytes>                total text + data
+ *     ram <bytes>                  total data + bss
+ *     growth flash|ram <bytes>     increase over the old build, diff mode only
+ *     object <name> flash|ram <bytes>
+ * where <name> matches any object whose name contains it, for example
+ * "tasks.o" or "liblpc_chip_175x_6x.a".  Lines starting with # are ignored.
+ *
+ * Build:  gcc -O2 -o freertos_map_report freertos_map_report.c
+ * Usage:  freertos_map_report [-n symbols] [-b budget.txt] app.map
+ *         freertos_map_report [-n symbols] [-b budget.txt] old.map new.map
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_LINE        4096
+#define MAX_NAME_LEN    128
+#define MAX_REGIONS     16
+#define DEFAULT_SYMBOLS 20
+
+typedef enum {
+	KIND_TEXT,			/* Code and read only data, flash */
+	KIND_DATA,			/* Initialised data, RAM plus its load image in flash */
+	KIND_BSS,			/* Zero initialised and uninitialised data, RAM */
+	KIND_COUNT,
+	KIND_NONE = KIND_COUNT	/* Not loaded, debug information and the like */
+} KIND_T;
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	char object[MAX_NAME_LEN];
+	KIND_T kind;
+	uint32_t size;
+} SYMBOL_T;
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	uint32_t size[KIND_COUNT];
+} OBJECT_T;
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	uint64_t origin, length, used;
+} REGION_T;
+
+typedef struct {
+	SYMBOL_T *pSymbols;
+	int numSymbols, maxSymbols;
+	OBJECT_T *pObjects;
+	int numObjects, maxObjects;
+	REGION_T regions[MAX_REGIONS];
+	int numRegions;
+	uint32_t total[KIND_COUNT];
+} MAP_T;
+
+static const char *const kindNames[KIND_COUNT] = {"text", "data", "bss"};
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void *growArray(void *p, int *pMax, size_t elementSize)
+{
+	*pMax = *pMax ? (*pMax * 2) : 256;
+	p = realloc(p, (size_t) *pMax * elementSize);
+	if (p == NULL) {
+		fprintf(stderr, "error: out of memory\n");
+		exit(1);
+	}
+	return p;
+}
+
+static int startsWith(const char *s, const char *prefix)
+{
+	return strncmp(s, prefix, strlen(prefix)) == 0;
+}
+
+/* What an output section holds, from its name */
+static KIND_T outputKind(const char *name)
+{
+	if (startsWith(name, ".text") || startsWith(name, ".rodata") || startsWith(name, ".ARM.ex") ||
+		startsWith(name, ".isr_vector")) {
+		return KIND_TEXT;
+	}
+	if (startsWith(name, ".data")) {
+		return KIND_DATA;
+	}
+	if (startsWith(name, ".bss") || startsWith(name, ".noinit") || startsWith(name, ".uninit")) {
+		return KIND_BSS;
+	}
+	return KIND_NONE;
+}
+
+/* Shorten an object path, archive members keep only the archive file name */
+static void objectName(const char *path, char *pOut)
+{
+	const char *pParen = strchr(path, '(');
+	const char *pSlash = path, *p;
+
+	for (p = path; (*p != 0) && ((pParen == NULL) || (p < pParen)); p++) {
+		if (*p == '/') {
+			pSlash = p + 1;
+		}
+	}
+	if (pParen == NULL) {
+		/* Objects of the project keep their path relative to Debug/ */
+		pSlash = startsWith(path, "./") ? (path + 2) : path;
+	}
+	snprintf(pOut, MAX_NAME_LEN, "%s", pSlash);
+}
+
+/* Symbol name from an input section, .text.foo becomes foo */
+static void symbolName(const char *section, char *pOut)
+{
+	const char *p = strchr(section + 1, '.');
+
+	snprintf(pOut, MAX_NAME_LEN, "%s", (p != NULL) ? (p + 1) : section);
+}
+
+static OBJECT_T *findObject(MAP_T *pMap, const char *name)
+{
+	int i;
+
+	for (i = 0; i < pMap->numObjects; i++) {
+		if (strcmp(pMap->pObjects[i].name, name) == 0) {
+			return &pMap->pObjects[i];
+		}
+	}
+	if (pMap->numObjects == pMap->maxObjects) {
+		pMap->pObjects = growArray(pMap->pObjects, &pMap->maxObjects, sizeof(OBJECT_T));
+	}
+	memset(&pMap->pObjects[pMap->numObjects], 0, sizeof(OBJECT_T));
+	snprintf(pMap->pObjects[pMap->numObjects].name, MAX_NAME_LEN, "%s", name);
+	return &pMap->pObjects[pMap->numObjects++];
+}
+
+static SYMBOL_T *addSymbol(MAP_T *pMap, const char *name, const char *object, KIND_T kind, uint32_t size)
+{
+	SYMBOL_T *pSymbol;
+
+	if (pMap->numSymbols == pMap->maxSymbols) {
+		pMap->pSymbols = growArray(pMap->pSymbols, &pMap->maxSymbols, sizeof(SYMBOL_T));
+	}
+	pSymbol = &pMap->pSymbols[pMap->numSymbols++];
+	snprintf(pSymbol->name, MAX_NAME_LEN, "%s", name);
+	snprintf(pSymbol->object, MAX_NAME_LEN, "%s", object);
+	pSymbol->kind = kind;
+	pSymbol->size = size;
+
+	findObject(pMap, object)->size[kind] += size;
+	pMap->total[kind] += size;
+	return pSymbol;
+}
+
+static REGION_T *findRegion(MAP_T *pMap, uint64_t addr)
+{
+	int i;
+
+	for (i = 0; i < pMap->numRegions; i++) {
+		if ((addr >= pMap->regions[i].origin) && (addr < pMap->regions[i].origin + pMap->regions[i].length)) {
+			return &pMap->regions[i];
+		}
+	}
+	return NULL;
+}
+
+/* Charge an output section to the regions holding it and its load image */
+static void useRegions(MAP_T *pMap, uint64_t vma, uint64_t lma, uint64_t size)
+{
+	REGION_T *pRegion = findRegion(pMap, vma);
+
+	if (pRegion != NULL) {
+		pRegion->used += size;
+	}
+	if (lma != vma) {
+		pRegion = findRegion(pMap, lma);
+		if (pRegion != NULL) {
+			pRegion->used += size;
+		}
+	}
+}
+
+/* Parse a map file */
+static int loadMap(const char *path, MAP_T *pMap)
+{
+	char line[MAX_LINE], pendingInput[MAX_NAME_LEN] = "", pendingOutput[MAX_NAME_LEN] = "";
+	char tok[4][MAX_LINE], object[MAX_NAME_LEN], name[MAX_NAME_LEN];
+	unsigned long long addr, size, lma;
+	KIND_T kind = KIND_NONE;
+	SYMBOL_T *pLast = NULL;
+	int inMemoryConfig = 0, inMap = 0, n;
+	char *p;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+	memset(pMap, 0, sizeof(*pMap));
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		line[strcspn(line, "\r\n")] = 0;
+
+		if (startsWith(line, "Memory Configuration")) {
+			inMemoryConfig = 1;
+			continue;
+		}
+		if (startsWith(line, "Linker script and memory map")) {
+			inMemoryConfig = 0;
+			inMap = 1;
+			continue;
+		}
+		if (inMemoryConfig) {
+			/* name origin length [attributes] */
+			if ((sscanf(line, "%127s 0x%llx 0x%llx", name, &addr, &size) == 3) &&
+				(strcmp(name, "*default*") != 0) && (pMap->numRegions < MAX_REGIONS)) {
+				REGION_T *pRegion = &pMap->regions[pMap->numRegions++];
+
+				snprintf(pRegion->name, MAX_NAME_LEN, "%s", name);
+				pRegion->origin = addr;
+				pRegion->length = size;
+			}
+			continue;
+		}
+		if (!inMap || (line[0] == 0)) {
+			continue;
+		}
+
+		/* Output section, name at column 0, address and size on the same
+		   line or the next */
+		if ((line[0] == '.') || (pendingOutput[0] != 0 && line[0] == ' ' && strstr(line, "0x") != NULL &&
+								 sscanf(line, " 0x%llx 0x%llx", &addr, &size) == 2)) {
+			if (line[0] == '.') {
+				n = sscanf(line, "%127s 0x%llx 0x%llx", name, &addr, &size);
+				if (n != 3) {
+					snprintf(pendingOutput, MAX_NAME_LEN, "%s", name);
+					continue;
+				}
+			}
+			else {
+				snprintf(name, MAX_NAME_LEN, "%s", pendingOutput);
+			}
+			pendingOutput[0] = 0;
+			pendingInput[0] = 0;
+			pLast = NULL;
+			kind = outputKind(name);
+			lma = addr;
+			p = strstr(line, "load address 0x");
+			if (p != NULL) {
+				lma = strtoull(p + 13, NULL, 16);
+			}
+			if ((kind != KIND_NONE) && (size > 0)) {
+				useRegions(pMap, addr, lma, size);
+			}
+			continue;
+		}
+		pendingOutput[0] = 0;
+		if (kind == KIND_NONE) {
+			continue;
+		}
+
+		n = sscanf(line, "%s %s %s %s", tok[0], tok[1], tok[2], tok[3]);
+		if (n < 1) {
+			continue;
+		}
+
+		/* Input section, " .text.foo 0xaddr 0xsize file" or the name alone
+		   with the rest on the next line */
+		if ((line[0] == ' ') && (line[1] != ' ') && (tok[0][0] != '*' || strcmp(tok[0], "*fill*") == 0) &&
+			!startsWith(tok[0], "0x") && (strcmp(tok[0], "FILL") != 0) && (strcmp(tok[0], "[!provide]") != 0)) {
+			if (n == 1) {
+				snprintf(pendingInput, MAX_NAME_LEN, "%.127s", tok[0]);
+				continue;
+			}
+			if ((n < 3) || !startsWith(tok[1], "0x") || !startsWith(tok[2], "0x")) {
+				continue;
+			}
+			size = strtoull(tok[2], NULL, 16);
+			if (strcmp(tok[0], "*fill*") == 0) {
+				snprintf(object, MAX_NAME_LEN, "*fill*");
+			}
+			else if (n == 4) {
+				objectName(strstr(line, tok[3]), object);
+			}
+			else {
+				continue;
+			}
+			symbolName(tok[0], name);
+			pLast = NULL;
+			if (size > 0) {
+				pLast = addSymbol(pMap, name, object, kind, (uint32_t) size);
+
+				/* Plain .text/.data/.bss and COMMON get the first symbol
+				   defined in them */
+				if ((strchr(tok[0] + 1, '.') == NULL) && (tok[0][0] != '*')) {
+					pLast->name[0] = 0;
+				}
+			}
+			continue;
+		}
+
+		/* Continuation of a long input section name */
+		if ((pendingInput[0] != 0) && (n == 3) && startsWith(tok[0], "0x") && startsWith(tok[1], "0x")) {
+			size = strtoull(tok[1], NULL, 16);
+			objectName(strstr(line, tok[2]), object);
+			symbolName(pendingInput, name);
+			pLast = NULL;
+			if (size > 0) {
+				pLast = addSymbol(pMap, name, object, kind, (uint32_t) size);
+				if (strchr(pendingInput + 1, '.') == NULL) {
+					pLast->name[0] = 0;
+				}
+			}
+			pendingInput[0] = 0;
+			continue;
+		}
+		pendingInput[0] = 0;
+
+		/* Data placed by the linker script, "0xaddr 0xsize LONG value" */
+		if ((n >= 3) && startsWith(tok[0], "0x") && startsWith(tok[1], "0x") &&
+			((strcmp(tok[2], "LONG") == 0) || (strcmp(tok[2], "SHORT") == 0) ||
+			 (strcmp(tok[2], "BYTE") == 0) || (strcmp(tok[2], "QUAD") == 0))) {
+			size = strtoull(tok[1], NULL, 16);
+			pLast = addSymbol(pMap, "linker script data", "*linker*", kind, (uint32_t) size);
+			continue;
+		}
+
+		/* Symbol defined in the previous input section, "0xaddr name" */
+		if ((n == 2) && startsWith(tok[0], "0x") && (pLast != NULL) && (pLast->name[0] == 0)) {
+			snprintf(pLast->name, MAX_NAME_LEN, "%.127s", tok[1]);
+		}
+	}
+	fclose(fp);
+
+	/* Sections with no symbols at all are named after their object */
+	for (n = 0; n < pMap->numSymbols; n++) {
+		if (pMap->pSymbols[n].name[0] == 0) {
+			snprintf(pMap->pSymbols[n].name, MAX_NAME_LEN, "(%s)", kindNames[pMap->pSymbols[n].kind]);
+		}
+	}
+	if (pMap->numSymbols == 0) {
+		fprintf(stderr, "error: %s has no memory map, link with -Map\n", path);
+		return -1;
+	}
+	return 0;
+}
+
+static uint32_t flashOf(const uint32_t *pSize)
+{
+	return pSize[KIND_TEXT] + pSize[KIND_DATA];
+}
+
+static uint32_t ramOf(const uint32_t *pSize)
+{
+	return pSize[KIND_DATA] + pSize[KIND_BSS];
+}
+
+static int compareObjects(const void *a, const void *b)
+{
+	const OBJECT_T *pA = a, *pB = b;
+	uint32_t sa = flashOf(pA->size) + ramOf(pA->size), sb = flashOf(pB->size) + ramOf(pB->size);
+
+	return (sa < sb) ? 1 : (sa > sb) ? -1 : strcmp(pA->name, pB->name);
+}
+
+static int compareSymbols(const void *a, const void *b)
+{
+	const SYMBOL_T *pA = a, *pB = b;
+
+	return (pA->size < pB->size) ? 1 : (pA->size > pB->size) ? -1 : strcmp(pA->name, pB->name);
+}
+
+static void printRegions(const MAP_T *pMap)
+{
+	int i;
+
+	printf("%-16s %10s %10s %7s\n", "region", "used", "size", "used%");
+	for (i = 0; i < pMap->numRegions; i++) {
+		const REGION_T *pRegion = &pMap->regions[i];
+
+		printf("%-16s %10llu %10llu %6.1f%%\n", pRegion->name, (unsigned long long) pRegion->used,
+			   (unsigned long long) pRegion->length,
+			   pRegion->length ? (100.0 * (double) pRegion->used / (double) pRegion->length) : 0.0);
+	}
+	printf("\n");
+}
+
+static void printReport(MAP_T *pMap, int numSymbols)
+{
+	int i;
+
+	printRegions(pMap);
+
+	qsort(pMap->pObjects, pMap->numObjects, sizeof(OBJECT_T), compareObjects);
+	printf("%-56s %8s %8s %8s %8s %8s\n", "object", "text", "data", "bss", "flash", "ram");
+	for (i = 0; i < pMap->numObjects; i++) {
+		const OBJECT_T *pObject = &pMap->pObjects[i];
+
+		printf("%-56s %8u %8u %8u %8u %8u\n", pObject->name, (unsigned) pObject->size[KIND_TEXT],
+			   (unsigned) pObject->size[KIND_DATA], (unsigned) pObject->size[KIND_BSS],
+			   (unsigned) flashOf(pObject->size), (unsigned) ramOf(pObject->size));
+	}
+	printf("%-56s %8u %8u %8u %8u %8u\n\n", "total", (unsigned) pMap->total[KIND_TEXT],
+		   (unsigned) pMap->total[KIND_DATA], (unsigned) pMap->total[KIND_BSS],
+		   (unsigned) flashOf(pMap->total), (unsigned) ramOf(pMap->total));
+
+	qsort(pMap->pSymbols, pMap->numSymbols, sizeof(SYMBOL_T), compareSymbols);
+	printf("%-40s %-5s %8s  %s\n", "symbol", "kind", "size", "object");
+	for (i = 0; (i < pMap->numSymbols) && (i < numSymbols); i++) {
+		const SYMBOL_T *pSymbol = &pMap->pSymbols[i];
+
+		printf("%-40s %-5s %8u  %s\n", pSymbol->name, kindNames[pSymbol->kind], (unsigned) pSymbol->size,
+			   pSymbol->object);
+	}
+}
+
+/* Size of a symbol in a build, summed over sections of the same name */
+static uint32_t symbolSize(const MAP_T *pMap, const SYMBOL_T *pKey)
+{
+	uint32_t size = 0;
+	int i;
+
+	for (i = 0; i < pMap->numSymbols; i++) {
+		const SYMBOL_T *pSymbol = &pMap->pSymbols[i];
+
+		if ((pSymbol->kind == pKey->kind) && (strcmp(pSymbol->name, pKey->name) == 0) &&
+			(strcmp(pSymbol->object, pKey->object) == 0)) {
+			size += pSymbol->size;
+		}
+	}
+	return size;
+}
+
+typedef struct {
+	const char *name, *object;
+	KIND_T kind;
+	long oldSize, newSize;
+} DELTA_T;
+
+static int compareDeltas(const void *a, const void *b)
+{
+	const DELTA_T *pA = a, *pB = b;
+	long da = labs(pA->newSize - pA->oldSize), db = labs(pB->newSize - pB->oldSize);
+
+	return (da < db) ? 1 : (da > db) ? -1 : strcmp(pA->name, pB->name);
+}
+
+static void printDelta(const char *label, long oldSize, long newSize)
+{
+	printf("%-56s %8ld %8ld %+8ld\n", label, oldSize, newSize, newSize - oldSize);
+}
+
+static void printDiff(MAP_T *pOld, MAP_T *pNew, int numSymbols)
+{
+	DELTA_T *pDeltas;
+	int i, j, n = 0;
+
+	printf("%-56s %8s %8s %8s\n", "", "old", "new", "change");
+	printDelta("flash (text + data)", flashOf(pOld->total), flashOf(pNew->total));
+	printDelta("ram (data + bss)", ramOf(pOld->total), ramOf(pNew->total));
+	for (i = 0; i < KIND_COUNT; i++) {
+		printDelta(kindNames[i], pOld->total[i], pNew->total[i]);
+	}
+
+	/* Objects, in either build */
+	pDeltas = calloc((size_t) (pOld->numObjects + pNew->numObjects) * KIND_COUNT +
+					 (size_t) pOld->numSymbols + (size_t) pNew->numSymbols + 1, sizeof(DELTA_T));
+	if (pDeltas == NULL) {
+		fprintf(stderr, "error: out of memory\n");
+		exit(1);
+	}
+	for (i = 0; i < pNew->numObjects; i++) {
+		findObject(pOld, pNew->pObjects[i].name);
+	}
+	for (i = 0; i < pOld->numObjects; i++) {
+		const OBJECT_T *pA = &pOld->pObjects[i], *pB = findObject(pNew, pA->name);
+
+		if ((flashOf(pA->size) != flashOf(pB->size)) || (ramOf(pA->size) != ramOf(pB->size))) {
+			pDeltas[n].name = pA->name;
+			pDeltas[n].oldSize = (long) (flashOf(pA->size) + ramOf(pA->size));
+			pDeltas[n].newSize = (long) (flashOf(pB->size) + ramOf(pB->size));
+			n++;
+		}
+	}
+	qsort(pDeltas, n, sizeof(DELTA_T), compareDeltas);
+	printf("\n%-56s %8s %8s %8s   %s\n", "object", "old", "new", "change", "(flash + ram)");
+	for (i = 0; i < n; i++) {
+		printDelta(pDeltas[i].name, pDeltas[i].oldSize, pDeltas[i].newSize);
+	}
+
+	/* Symbols, in either build, each name once */
+	n = 0;
+	for (i = 0; i < pOld->numSymbols + pNew->numSymbols; i++) {
+		const SYMBOL_T *pSymbol = (i < pOld->numSymbols) ? &pOld->pSymbols[i] : &pNew->pSymbols[i - pOld->numSymbols];
+
+		for (j = 0; j < n; j++) {
+			if ((pDeltas[j].kind == pSymbol->kind) && (strcmp(pDeltas[j].name, pSymbol->name) == 0) &&
+				(strcmp(pDeltas[j].object, pSymbol->object) == 0)) {
+				break;
+			}
+		}
+		if (j < n) {
+			continue;
+		}
+		pDeltas[n].name = pSymbol->name;
+		pDeltas[n].object = pSymbol->object;
+		pDeltas[n].kind = pSymbol->kind;
+		pDeltas[n].oldSize = (long) symbolSize(pOld, pSymbol);
+		pDeltas[n].newSize = (long) symbolSize(pNew, pSymbol);
+		n++;
+	}
+	qsort(pDeltas, n, sizeof(DELTA_T), compareDeltas);
+	printf("\n%-40s %-5s %8s %8s %8s  %s\n", "symbol", "kind", "old", "new", "change", "object");
+	for (i = 0, j = 0; (i < n) && (j < numSymbols); i++) {
+		if (pDeltas[i].oldSize == pDeltas[i].newSize) {
+			break;
+		}
+		printf("%-40s %-5s %8ld %8ld %+8ld  %s%s\n", pDeltas[i].name, kindNames[pDeltas[i].kind],
+			   pDeltas[i].oldSize, pDeltas[i].newSize, pDeltas[i].newSize - pDeltas[i].oldSize,
+			   pDeltas[i].object, (pDeltas[i].oldSize == 0) ? " (new)" : (pDeltas[i].newSize == 0) ? " (removed)" : "");
+		j++;
+	}
+	free(pDeltas);
+}
+
+static int overBudget(const char *what, uint32_t size, unsigned long limit)
+{
+	if (size > limit) {
+		printf("BUDGET: %s is %u bytes, budget %lu, over by %lu\n", what, (unsigned) size, limit,
+			   (unsigned long) size - limit);
+		return 1;
+	}
+	return 0;
+}
+
+/* Check a build, and its growth over pOld if given, against a budget file */
+static int checkBudget(const char *path, MAP_T *pMap, MAP_T *pOld)
+{
+	char line[MAX_LINE], what[MAX_NAME_LEN], name[MAX_NAME_LEN], label[MAX_LINE];
+	unsigned long limit;
+	int i, over = 0;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return 1;
+	}
+	printf("\n");
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (line[0] == '#') {
+			continue;
+		}
+		if ((sscanf(line, "flash %lu", &limit) == 1)) {
+			over |= overBudget("flash", flashOf(pMap->total), limit);
+		}
+		else if ((sscanf(line, "ram %lu", &limit) == 1)) {
+			over |= overBudget("ram", ramOf(pMap->total), limit);
+		}
+		else if (sscanf(line, "growth %127s %lu", what, &limit) == 2) {
+			uint32_t oldSize, newSize;
+
+			if (pOld == NULL) {
+				continue;
+			}
+			oldSize = (strcmp(what, "ram") == 0) ? ramOf(pOld->total) : flashOf(pOld->total);
+			newSize = (strcmp(what, "ram") == 0) ? ramOf(pMap->total) : flashOf(pMap->total);
+			snprintf(label, sizeof(label), "%s growth", what);
+			over |= overBudget(label, (newSize > oldSize) ? (newSize - oldSize) : 0, limit);
+		}
+		else if (sscanf(line, "object %127s %127s %lu", name, what, &limit) == 3) {
+			uint32_t size[KIND_COUNT] = {0, 0, 0};
+			int k;
+
+			for (i = 0; i < pMap->numObjects; i++) {
+				if (strstr(pMap->pObjects[i].name, name) != NULL) {
+					for (k = 0; k < KIND_COUNT; k++) {
+						size[k] += pMap->pObjects[i].size[k];
+					}
+				}
+			}
+			snprintf(label, sizeof(label), "%s %s", name, what);
+			over |= overBudget(label, (strcmp(what, "ram") == 0) ? ramOf(size) : flashOf(size), limit);
+		}
+	}
+	fclose(fp);
+	if (!over) {
+		printf("within budget\n");
+	}
+	return over;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	static MAP_T oldMap, newMap;
+	const char *pBudget = NULL;
+	int argi, numSymbols = DEFAULT_SYMBOLS, ret = 0;
+
+	for (argi = 1; (argi < argc) && (argv[argi][0] == '-'); argi++) {
+		if ((strcmp(argv[argi], "-n") == 0) && (argi + 1 < argc)) {
+			numSymbols = atoi(argv[++argi]);
+		}
+		else if ((strcmp(argv[argi], "-b") == 0) && (argi + 1 < argc)) {
+			pBudget = argv[++argi];
+		}
+		else {
+			break;
+		}
+	}
+	if ((argc - argi < 1) || (argc - argi > 2)) {
+		fprintf(stderr, "usage: %s [-n symbols] [-b budget.txt] app.map\n"
+				"       %s [-n symbols] [-b budget.txt] old.map new.map\n", argv[0], argv[0]);
+		return 2;
+	}
+
+	if (argc - argi == 1) {
+		if (loadMap(argv[argi], &newMap) != 0) {
+			return 1;
+		}
+		printReport(&newMap, numSymbols);
+		if (pBudget != NULL) {
+			ret = checkBudget(pBudget, &newMap, NULL);
+		}
+	}
+	else {
+		if ((loadMap(argv[argi], &oldMap) != 0) || (loadMap(argv[argi + 1], &newMap) != 0)) {
+			return 1;
+		}
+		printDiff(&oldMap, &newMap, numSymbols);
+		if (pBudget != NULL) {
+			ret = checkBudget(pBudget, &newMap, &oldMap);
+		}
+	}
+	return ret;
+}
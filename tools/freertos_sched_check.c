@@ -0,0 +1,431 @@
+/*
+ * @brief Host schedulability check for periodic FreeRTOS task sets
+ *
+ * @note
+ * Compares fixed priority rate monotonic scheduling (the priorities chosen by
+ * hand with xTaskCreate()) against earliest deadline first scheduling (tasks
+ * created with xTaskCreatePeriodic() when configUSE_EDF_SCHEDULING is 1).
+ *
+ * For both policies it prints the analytic result - the Liu & Layland bound
+ * and exact response time analysis for rate monotonic, the utilisation or
+ * processor demand test for EDF - and then simulates the task set tick by tick
+ * from a synchronous release, the worst case for both policies, reporting the
+ * worst response time, worst release to start latency and deadline misses of
+ * each task.  The simulation follows the kernel: one job runs per tick, a job
+ * released on a tick can run on that tick, and tasks with equal priority or
+ * equal deadlines run in the order they were released.
+ *
+ * The task set is read from a text file, one task per line:
+ *     name  C  T  [D]
+ * with execution time C, period T and relative deadline D (default T) all in
+ * ticks.  Lines starting with # are ignored.
+ *
+ * Build:  gcc -O2 -o freertos_sched_check freertos_sched_check.c
+ * Usage:  freertos_sched_check [-n ticks] taskset.txt
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_TASKS       32
+#define MAX_NAME_LEN    32
+
+/* Limit of the simulated time when the hyperperiod is very long */
+#define DEFAULT_SIM_TICKS   10000000ULL
+
+typedef enum {
+	POLICY_RM,
+	POLICY_EDF,
+} POLICY_T;
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	uint64_t c;
+	uint64_t t;
+	uint64_t d;
+	int rmPriority;		/* 0 is the highest */
+} TASK_T;
+
+typedef struct {
+	uint64_t release;	/* Release time of the current job */
+	uint64_t deadline;	/* Absolute deadline of the current job */
+	uint64_t remaining;	/* Execution time left, 0 when waiting for the next release */
+	uint64_t seq;		/* Release order, breaks ties like the kernel ready lists */
+	int started;
+	uint64_t worstResponse;
+	uint64_t worstLatency;
+	uint64_t jobs;
+	uint64_t misses;
+} JOB_STATE_T;
+
+static TASK_T tasks[MAX_TASKS];
+static int numTasks;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static uint64_t gcd(uint64_t a, uint64_t b)
+{
+	while (b != 0) {
+		uint64_t r = a % b;
+		a = b;
+		b = r;
+	}
+	return a;
+}
+
+/* 2^(1/n) by bisection, so the tool needs no maths library */
+static double nthRootOfTwo(int n)
+{
+	double lo = 1.0, hi = 2.0, mid, p;
+	int i, k;
+
+	for (i = 0; i < 60; i++) {
+		mid = (lo + hi) / 2.0;
+		for (p = 1.0, k = 0; k < n; k++) {
+			p *= mid;
+		}
+		if (p < 2.0) {
+			lo = mid;
+		}
+		else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/* Least common multiple of the periods, or 0 if it is larger than limit */
+static uint64_t hyperperiod(uint64_t limit)
+{
+	uint64_t h = 1;
+	int i;
+
+	for (i = 0; i < numTasks; i++) {
+		uint64_t m = tasks[i].t / gcd(h, tasks[i].t);
+		if (h > (limit / m)) {
+			return 0;
+		}
+		h *= m;
+	}
+	return h;
+}
+
+static int loadTaskSet(const char *pPath)
+{
+	char line[256], name[MAX_NAME_LEN];
+	unsigned long long c, t, d;
+	int fields, lineNo = 0;
+	FILE *fp;
+
+	fp = fopen(pPath, "r");
+	if (fp == NULL) {
+		perror(pPath);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lineNo++;
+		if ((line[0] == '#') || (strspn(line, " \t\r\n") == strlen(line))) {
+			continue;
+		}
+
+		fields = sscanf(line, "%31s %llu %llu %llu", name, &c, &t, &d);
+		if (fields == 3) {
+			d = t;
+		}
+		if ((fields < 3) || (c == 0) || (t == 0) || (d == 0) || (d > t) || (c > d)) {
+			fprintf(stderr, "error: %s:%d: expected 'name C T [D]' with 0 < C <= D <= T\n", pPath, lineNo);
+			fclose(fp);
+			return -1;
+		}
+		if (numTasks == MAX_TASKS) {
+			fprintf(stderr, "error: more than %d tasks\n", MAX_TASKS);
+			fclose(fp);
+			return -1;
+		}
+
+		strcpy(tasks[numTasks].name, name);
+		tasks[numTasks].c = c;
+		tasks[numTasks].t = t;
+		tasks[numTasks].d = d;
+		numTasks++;
+	}
+
+	fclose(fp);
+	if (numTasks == 0) {
+		fprintf(stderr, "error: %s holds no tasks\n", pPath);
+		return -1;
+	}
+	return 0;
+}
+
+/* Shorter period is higher priority, file order breaks ties */
+static void assignRmPriorities(void)
+{
+	int i, j;
+
+	for (i = 0; i < numTasks; i++) {
+		tasks[i].rmPriority = 0;
+		for (j = 0; j < numTasks; j++) {
+			if ((tasks[j].t < tasks[i].t) || ((tasks[j].t == tasks[i].t) && (j < i))) {
+				tasks[i].rmPriority++;
+			}
+		}
+	}
+}
+
+/* Exact worst case response time under fixed priorities, 0 if it exceeds the deadline */
+static uint64_t rmResponseTime(int i)
+{
+	uint64_t r = tasks[i].c, next;
+	int j;
+
+	for (;; ) {
+		next = tasks[i].c;
+		for (j = 0; j < numTasks; j++) {
+			if (tasks[j].rmPriority < tasks[i].rmPriority) {
+				next += ((r + tasks[j].t - 1) / tasks[j].t) * tasks[j].c;
+			}
+		}
+		if (next > tasks[i].d) {
+			return 0;
+		}
+		if (next == r) {
+			return r;
+		}
+		r = next;
+	}
+}
+
+/* Execution time of the jobs that are both released and due within [0, l] */
+static uint64_t demand(uint64_t l)
+{
+	uint64_t h = 0;
+	int i;
+
+	for (i = 0; i < numTasks; i++) {
+		if (l >= tasks[i].d) {
+			h += ((l - tasks[i].d) / tasks[i].t + 1) * tasks[i].c;
+		}
+	}
+	return h;
+}
+
+/* Processor demand test, returns the first deadline that fails or 0 */
+static uint64_t edfDemandTest(double u, uint64_t *pChecked)
+{
+	uint64_t limit, l, next;
+	double la = 0.0;
+	int i;
+
+	/* Only deadlines within the first busy period need to be checked.  When
+	   deadlines equal periods U <= 1 is already exact. */
+	for (i = 0; i < numTasks; i++) {
+		la += (double) (tasks[i].t - tasks[i].d) * ((double) tasks[i].c / (double) tasks[i].t);
+	}
+	if (u < 1.0) {
+		la /= (1.0 - u);
+	}
+	else {
+		la = (double) hyperperiod(DEFAULT_SIM_TICKS);
+	}
+	limit = (uint64_t) la;
+	if ((double) limit < la) {
+		limit++;
+	}
+	for (i = 0; i < numTasks; i++) {
+		if (tasks[i].d > limit) {
+			limit = tasks[i].d;
+		}
+	}
+	*pChecked = limit;
+
+	/* Step through the absolute deadlines in order */
+	for (l = 0;; l = next) {
+		next = UINT64_MAX;
+		for (i = 0; i < numTasks; i++) {
+			uint64_t k = (l < tasks[i].d) ? 0 : ((l - tasks[i].d) / tasks[i].t + 1);
+			uint64_t dl = tasks[i].d + k * tasks[i].t;
+			if (dl < next) {
+				next = dl;
+			}
+		}
+		if (next > limit) {
+			return 0;
+		}
+		if (demand(next) > next) {
+			return next;
+		}
+	}
+}
+
+/* Index of the job the policy runs at this tick, -1 to idle */
+static int pickJob(const JOB_STATE_T *pState, POLICY_T policy)
+{
+	int i, best = -1;
+
+	for (i = 0; i < numTasks; i++) {
+		if (pState[i].remaining == 0) {
+			continue;
+		}
+		if (best < 0) {
+			best = i;
+		}
+		else if (policy == POLICY_RM) {
+			if (tasks[i].rmPriority < tasks[best].rmPriority) {
+				best = i;
+			}
+		}
+		else if ((pState[i].deadline < pState[best].deadline) ||
+				 ((pState[i].deadline == pState[best].deadline) && (pState[i].seq < pState[best].seq))) {
+			best = i;
+		}
+	}
+	return best;
+}
+
+static void simulate(POLICY_T policy, uint64_t ticks)
+{
+	JOB_STATE_T state[MAX_TASKS];
+	uint64_t now, seq = 0, busy = 0, total = 0;
+	int i, run;
+
+	memset(state, 0, sizeof(state));
+
+	for (now = 0; now < ticks; now++) {
+		/* Release the jobs due on this tick.  A job that has not finished by
+		   its next release keeps running, like a task that is late calling
+		   vTaskWaitForNextPeriod(), and the next job starts when it ends. */
+		for (i = 0; i < numTasks; i++) {
+			if ((state[i].remaining == 0) && (now >= state[i].release)) {
+				state[i].deadline = state[i].release + tasks[i].d;
+				state[i].remaining = tasks[i].c;
+				state[i].started = 0;
+				state[i].seq = seq++;
+				state[i].jobs++;
+			}
+		}
+
+		run = pickJob(state, policy);
+		if (run < 0) {
+			continue;
+		}
+
+		busy++;
+		if (!state[run].started) {
+			uint64_t latency = now - state[run].release;
+			if (latency > state[run].worstLatency) {
+				state[run].worstLatency = latency;
+			}
+			state[run].started = 1;
+		}
+
+		if (--state[run].remaining == 0) {
+			uint64_t response = now + 1 - state[run].release;
+			if (response > state[run].worstResponse) {
+				state[run].worstResponse = response;
+			}
+			if ((now + 1) > state[run].deadline) {
+				state[run].misses++;
+			}
+			state[run].release += tasks[run].t;
+		}
+	}
+
+	printf("  %-16s %8s %10s %10s %10s %10s\n", "task", "jobs", "response", "latency", "deadline", "misses");
+	for (i = 0; i < numTasks; i++) {
+		printf("  %-16s %8llu %10llu %10llu %10llu %10llu\n", tasks[i].name,
+			   (unsigned long long) state[i].jobs, (unsigned long long) state[i].worstResponse,
+			   (unsigned long long) state[i].worstLatency, (unsigned long long) tasks[i].d,
+			   (unsigned long long) state[i].misses);
+		total += state[i].misses;
+	}
+	printf("  simulated %llu ticks, %.1f%% busy, %llu deadline misses\n", (unsigned long long) ticks,
+		   100.0 * (double) busy / (double) ticks, (unsigned long long) total);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint64_t ticks = 0, h, checked, fail, r;
+	double u = 0.0, bound;
+	int i, arg = 1, rmOk = 1;
+
+	if ((argc > 3) && (strcmp(argv[1], "-n") == 0)) {
+		ticks = strtoull(argv[2], NULL, 0);
+		arg = 3;
+	}
+	if (arg != (argc - 1)) {
+		fprintf(stderr, "usage: %s [-n ticks] taskset.txt\n", argv[0]);
+		return 1;
+	}
+	if (loadTaskSet(argv[arg]) != 0) {
+		return 1;
+	}
+
+	assignRmPriorities();
+	for (i = 0; i < numTasks; i++) {
+		u += (double) tasks[i].c / (double) tasks[i].t;
+	}
+	bound = numTasks * (nthRootOfTwo(numTasks) - 1.0);
+
+	/* One hyperperiod from a synchronous release covers every phasing */
+	h = hyperperiod(DEFAULT_SIM_TICKS);
+	if (ticks == 0) {
+		ticks = (h != 0) ? h : DEFAULT_SIM_TICKS;
+	}
+
+	printf("%d tasks, utilisation %.4f, hyperperiod ", numTasks, u);
+	if (h != 0) {
+		printf("%llu ticks\n\n", (unsigned long long) h);
+	}
+	else {
+		printf("over %llu ticks\n\n", (unsigned long long) DEFAULT_SIM_TICKS);
+	}
+
+	printf("Rate monotonic\n");
+	printf("  Liu & Layland bound %.4f: %s\n", bound, (u <= bound) ? "schedulable" : "inconclusive");
+	for (i = 0; i < numTasks; i++) {
+		r = rmResponseTime(i);
+		if (r == 0) {
+			rmOk = 0;
+			printf("  %-16s priority %d, misses its deadline of %llu\n", tasks[i].name,
+				   numTasks - tasks[i].rmPriority, (unsigned long long) tasks[i].d);
+		}
+		else {
+			printf("  %-16s priority %d, response time %llu of %llu\n", tasks[i].name,
+				   numTasks - tasks[i].rmPriority, (unsigned long long) r, (unsigned long long) tasks[i].d);
+		}
+	}
+	printf("  response time analysis: %s\n", rmOk ? "schedulable" : "not schedulable");
+	simulate(POLICY_RM, ticks);
+
+	printf("\nEarliest deadline first\n");
+	if (u > 1.0) {
+		printf("  utilisation above 1: not schedulable\n");
+	}
+	else {
+		fail = edfDemandTest(u, &checked);
+		if (fail != 0) {
+			printf("  processor demand %llu exceeds %llu: not schedulable\n",
+				   (unsigned long long) demand(fail), (unsigned long long) fail);
+		}
+		else {
+			printf("  processor demand test up to %llu: schedulable\n", (unsigned long long) checked);
+		}
+	}
+	simulate(POLICY_EDF, ticks);
+
+	return 0;
+}
@@ -0,0 +1,589 @@
+/*
+ * @brief Host worst case stack report for FreeRTOS tasks
+ *
+ * @note
+ * Combines the per function stack usage that GCC writes with -fstack-usage
+ * (the .su files next to each object in the Debug/ trees) with the call graph
+ * taken from a disassembly of the linked image, and computes the worst case
+ * stack depth of every task entry function.  The result is compared against
+ * the stack each task was given and, when available, against the high water
+ * marks measured at run time with FreeRTOSStackReport().
+ *
+ * The call graph follows direct calls (bl, blx <symbol>) and tail calls (a
+ * branch to the start of another function).  Calls through pointers,
+ * recursion, functions without a .su entry (library and assembler code) and
+ * variable sized frames cannot be bounded; tasks reaching any of them are
+ * flagged and their figure is a lower bound.
+ *
+ * Each task needs room for its deepest call chain, the context saved by the
+ * port when it is switched out (64 bytes on the Cortex-M3 port, -c to
+ * change) and the 20 byte pattern checked by configCHECK_FOR_STACK_OVERFLOW
+ * method 2.  Interrupts run on the main stack so are reported separately.
+ *
+ * The task list is read from a text file, one task per line:
+ *     entry  stack_words  name
+ * where entry is the task function, stack_words the usStackDepth given to
+ * xTaskCreate() and name the task name, which is matched against the lines
+ *     STACK:<name>:<free words>
+ * printed by FreeRTOSStackReport() and captured in the -l log.  Lines
+ * starting with # are ignored.
+ *
+ * Build:  gcc -O2 -o freertos_stack_report freertos_stack_report.c
+ * Usage:  arm-none-eabi-objdump -d app.axf > app.dis
+ *         freertos_stack_report [-c bytes] [-l uart.log] -d app.dis tasks.txt Debug/
+ */
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_FUNCS       8192	/* Must be a power of 2 */
+#define MAX_TASKS       32
+#define MAX_NAME_LEN    64
+#define MAX_LINE        1024
+
+/* Default bytes saved on a task stack by a context switch, r4-r11 plus the
+   8 word exception frame on the Cortex-M3 port */
+#define DEFAULT_CONTEXT_BYTES   64
+
+/* Bytes at the end of each stack checked by overflow detection method 2 */
+#define CANARY_BYTES    20
+
+/* Reasons a worst case cannot be bounded */
+#define FLAG_UNKNOWN    0x01	/* A function without a .su entry */
+#define FLAG_DYNAMIC    0x02	/* A variable sized stack frame */
+#define FLAG_INDIRECT   0x04	/* A call through a pointer */
+#define FLAG_RECURSIVE  0x08	/* A cycle in the call graph */
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	int used;			/* Entry in use */
+	int hasSize;		/* A .su entry was found */
+	uint32_t self;		/* Own frame in bytes */
+	uint32_t flags;		/* Own FLAG_ bits */
+	int *pCallees;
+	int numCallees, maxCallees;
+	int state;			/* 0 unvisited, 1 on the DFS stack, 2 done */
+	uint32_t worst;		/* Deepest chain from here, including self */
+	uint32_t worstFlags;
+	int next;			/* Callee on the deepest chain, -1 for none */
+} FUNC_T;
+
+typedef struct {
+	char name[MAX_NAME_LEN];
+	char entry[MAX_NAME_LEN];
+	uint32_t stackWords;
+	long minFree;		/* Lowest free words seen at run time, -1 if none */
+} TASK_T;
+
+static FUNC_T funcs[MAX_FUNCS];
+static TASK_T tasks[MAX_TASKS];
+static int numTasks;
+static int numSuFiles;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static uint32_t hashName(const char *s)
+{
+	uint32_t h = 5381;
+
+	while (*s) {
+		h = (h * 33) ^ (unsigned char) *s++;
+	}
+	return h;
+}
+
+/* Find a function by name, optionally adding it */
+static int findFunc(const char *name, int create)
+{
+	uint32_t i = hashName(name) & (MAX_FUNCS - 1);
+	uint32_t probes;
+
+	for (probes = 0; probes < MAX_FUNCS; probes++) {
+		if (!funcs[i].used) {
+			if (!create) {
+				return -1;
+			}
+			funcs[i].used = 1;
+			snprintf(funcs[i].name, MAX_NAME_LEN, "%s", name);
+			funcs[i].next = -1;
+			return (int) i;
+		}
+		if (strcmp(funcs[i].name, name) == 0) {
+			return (int) i;
+		}
+		i = (i + 1) & (MAX_FUNCS - 1);
+	}
+	fprintf(stderr, "error: more than %d functions\n", MAX_FUNCS);
+	exit(1);
+}
+
+static void addCallee(FUNC_T *pFunc, int callee)
+{
+	int i;
+
+	for (i = 0; i < pFunc->numCallees; i++) {
+		if (pFunc->pCallees[i] == callee) {
+			return;
+		}
+	}
+	if (pFunc->numCallees == pFunc->maxCallees) {
+		pFunc->maxCallees = pFunc->maxCallees ? (pFunc->maxCallees * 2) : 8;
+		pFunc->pCallees = realloc(pFunc->pCallees, pFunc->maxCallees * sizeof(int));
+		if (pFunc->pCallees == NULL) {
+			fprintf(stderr, "error: out of memory\n");
+			exit(1);
+		}
+	}
+	pFunc->pCallees[pFunc->numCallees++] = callee;
+}
+
+/* Read one .su file, lines are file:line:column:function<TAB>bytes<TAB>qualifier */
+static void loadSuFile(const char *path)
+{
+	char line[MAX_LINE], *pName, *pTab;
+	unsigned long bytes;
+	FILE *fp;
+	int f;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		pTab = strchr(line, '\t');
+		if (pTab == NULL) {
+			continue;
+		}
+		*pTab++ = 0;
+		pName = strrchr(line, ':');
+		pName = (pName != NULL) ? (pName + 1) : line;
+		bytes = strtoul(pTab, &pTab, 10);
+
+		/* Static functions of the same name in two files keep the larger */
+		f = findFunc(pName, 1);
+		if (!funcs[f].hasSize || (bytes > funcs[f].self)) {
+			funcs[f].self = (uint32_t) bytes;
+		}
+		funcs[f].hasSize = 1;
+
+		/* "dynamic,bounded" is still a fixed worst case */
+		if ((strstr(pTab, "dynamic") != NULL) && (strstr(pTab, "bounded") == NULL)) {
+			funcs[f].flags |= FLAG_DYNAMIC;
+		}
+	}
+	fclose(fp);
+	numSuFiles++;
+}
+
+/* Load a .su file, or every .su file below a directory */
+static void loadSuPath(const char *path)
+{
+	char child[MAX_LINE];
+	struct dirent *pEntry;
+	struct stat st;
+	size_t len;
+	DIR *pDir;
+
+	if (stat(path, &st) != 0) {
+		perror(path);
+		return;
+	}
+	if (!S_ISDIR(st.st_mode)) {
+		loadSuFile(path);
+		return;
+	}
+
+	pDir = opendir(path);
+	if (pDir == NULL) {
+		perror(path);
+		return;
+	}
+	while ((pEntry = readdir(pDir)) != NULL) {
+		if (pEntry->d_name[0] == '.') {
+			continue;
+		}
+		snprintf(child, sizeof(child), "%s/%s", path, pEntry->d_name);
+		len = strlen(pEntry->d_name);
+		if (stat(child, &st) != 0) {
+			continue;
+		}
+		if (S_ISDIR(st.st_mode)) {
+			loadSuPath(child);
+		}
+		else if ((len > 3) && (strcmp(&pEntry->d_name[len - 3], ".su") == 0)) {
+			loadSuFile(child);
+		}
+	}
+	closedir(pDir);
+}
+
+/* True for b, b<cond> and their .n/.w forms */
+static int isBranch(const char *pMnemonic)
+{
+	static const char *const conds[] = {
+		"", "eq", "ne", "cs", "cc", "hs", "lo", "mi", "pl", "vs", "vc",
+		"hi", "ls", "ge", "lt", "gt", "le", "al"
+	};
+	char m[16];
+	size_t i, len;
+
+	if (pMnemonic[0] != 'b') {
+		return 0;
+	}
+	snprintf(m, sizeof(m), "%s", pMnemonic + 1);
+	len = strlen(m);
+	if ((len >= 2) && (m[len - 2] == '.')) {
+		m[len - 2] = 0;
+	}
+	for (i = 0; i < (sizeof(conds) / sizeof(conds[0])); i++) {
+		if (strcmp(m, conds[i]) == 0) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* Build the call graph from objdump -d output (GNU or LLVM) */
+static int loadDisassembly(const char *path)
+{
+	char line[MAX_LINE], target[MAX_NAME_LEN], mnemonic[16], *p, *q, *pEnd;
+	int current = -1, callee;
+	unsigned long addr;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		/* Function header: "000000f4 <data_init>:" */
+		addr = strtoul(line, &pEnd, 16);
+		(void) addr;
+		if ((pEnd != line) && (pEnd[0] == ' ') && (pEnd[1] == '<')) {
+			q = strstr(pEnd, ">:");
+			if (q != NULL) {
+				*q = 0;
+				current = findFunc(pEnd + 2, 1);
+				continue;
+			}
+		}
+		if ((current < 0) || (strchr(line, ':') == NULL)) {
+			continue;
+		}
+
+		/* The mnemonic is the first token after the address and the raw
+		   instruction bytes, which are separated from it by a tab */
+		p = strchr(line, '\t');
+		if (p == NULL) {
+			continue;
+		}
+		while ((*p == '\t') || (*p == ' ')) {
+			p++;
+		}
+		/* GNU objdump puts the raw bytes between two tabs */
+		q = strchr(p, '\t');
+		if ((q != NULL) && (strspn(p, "0123456789abcdef ") == (size_t) (q - p))) {
+			p = q + 1;
+		}
+		if (sscanf(p, "%15s", mnemonic) != 1) {
+			continue;
+		}
+		p += strlen(mnemonic);
+		while ((*p == '\t') || (*p == ' ')) {
+			p++;
+		}
+
+		if ((strcmp(mnemonic, "blx") == 0) || (strcmp(mnemonic, "bx") == 0)) {
+			/* Register operand, bx lr is a plain return */
+			if ((p[0] == 'r') || (strncmp(p, "ip", 2) == 0)) {
+				funcs[current].flags |= FLAG_INDIRECT;
+				continue;
+			}
+		}
+		if ((strcmp(mnemonic, "bl") != 0) && (strcmp(mnemonic, "blx") != 0) && !isBranch(mnemonic)) {
+			continue;
+		}
+
+		q = strchr(p, '<');
+		if ((q == NULL) || (sscanf(q + 1, "%63[^>]", target) != 1)) {
+			continue;
+		}
+
+		if (strchr(target, '+') != NULL) {
+			/* A branch into the middle of a function, a local jump for b,
+			   unusual for bl but still a call of that function */
+			if (isBranch(mnemonic)) {
+				continue;
+			}
+			*strchr(target, '+') = 0;
+		}
+		callee = findFunc(target, 1);
+		if (callee != current) {
+			addCallee(&funcs[current], callee);
+		}
+		else if (!isBranch(mnemonic)) {
+			funcs[current].flags |= FLAG_RECURSIVE;
+		}
+	}
+	fclose(fp);
+	return 0;
+}
+
+/* Worst case depth below a function, memoised depth first search */
+static void computeWorst(int f)
+{
+	FUNC_T *pFunc = &funcs[f];
+	uint32_t best = 0, bestFlags = 0;
+	int i, c;
+
+	if (pFunc->state == 2) {
+		return;
+	}
+	pFunc->state = 1;
+	pFunc->next = -1;
+	for (i = 0; i < pFunc->numCallees; i++) {
+		c = pFunc->pCallees[i];
+		if (funcs[c].state == 1) {
+			/* Back edge, the depth of a cycle is unbounded */
+			bestFlags |= FLAG_RECURSIVE;
+			continue;
+		}
+		computeWorst(c);
+		bestFlags |= funcs[c].worstFlags;
+		if ((pFunc->next < 0) || (funcs[c].worst > best)) {
+			best = funcs[c].worst;
+			pFunc->next = c;
+		}
+	}
+	pFunc->worst = pFunc->self + best;
+	pFunc->worstFlags = bestFlags | pFunc->flags | (pFunc->hasSize ? 0 : FLAG_UNKNOWN);
+	pFunc->state = 2;
+}
+
+static void printFlags(uint32_t flags)
+{
+	if (flags & FLAG_UNKNOWN) {
+		printf(" unknown-callee");
+	}
+	if (flags & FLAG_DYNAMIC) {
+		printf(" dynamic-frame");
+	}
+	if (flags & FLAG_INDIRECT) {
+		printf(" indirect-call");
+	}
+	if (flags & FLAG_RECURSIVE) {
+		printf(" recursion");
+	}
+}
+
+static void printPath(int f)
+{
+	printf("    path:");
+	while (f >= 0) {
+		printf(" %s(%u%s)", funcs[f].name, (unsigned) funcs[f].self, funcs[f].hasSize ? "" : "?");
+		f = funcs[f].next;
+		if (f >= 0) {
+			printf(" ->");
+		}
+	}
+	printf("\n");
+}
+
+/* Read the task list, entry stack_words name */
+static int loadTasks(const char *path)
+{
+	char line[MAX_LINE], entry[MAX_NAME_LEN], name[MAX_NAME_LEN];
+	unsigned long words;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if ((line[0] == '#') || (sscanf(line, "%63s %lu %63[^\r\n]", entry, &words, name) != 3)) {
+			continue;
+		}
+		if (numTasks == MAX_TASKS) {
+			fprintf(stderr, "error: more than %d tasks\n", MAX_TASKS);
+			break;
+		}
+		snprintf(tasks[numTasks].entry, MAX_NAME_LEN, "%s", entry);
+		snprintf(tasks[numTasks].name, MAX_NAME_LEN, "%s", name);
+		tasks[numTasks].stackWords = (uint32_t) words;
+		tasks[numTasks].minFree = -1;
+		numTasks++;
+	}
+	fclose(fp);
+	return 0;
+}
+
+/* Pick the run time high water marks out of a captured console log */
+static void loadHighWaterMarks(const char *path)
+{
+	char line[MAX_LINE], name[MAX_NAME_LEN], *p;
+	unsigned long freeWords;
+	FILE *fp;
+	int i;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return;
+	}
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		p = strstr(line, "STACK:");
+		if ((p == NULL) || (sscanf(p, "STACK:%63[^:]:%lu", name, &freeWords) != 2)) {
+			continue;
+		}
+		for (i = 0; i < numTasks; i++) {
+			if ((strcmp(tasks[i].name, name) == 0) &&
+				((tasks[i].minFree < 0) || ((long) freeWords < tasks[i].minFree))) {
+				tasks[i].minFree = (long) freeWords;
+			}
+		}
+	}
+	fclose(fp);
+}
+
+static int isInterruptHandler(const char *name)
+{
+	size_t len = strlen(name);
+
+	return (len > 7) && (strcmp(&name[len - 7], "Handler") == 0);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *pDisassembly = NULL, *pLog = NULL;
+	uint32_t contextBytes = DEFAULT_CONTEXT_BYTES, need, isrWorst = 0, isrSum = 0;
+	int i, f, argi, over = 0;
+
+	for (argi = 1; (argi < argc) && (argv[argi][0] == '-'); argi++) {
+		if ((strcmp(argv[argi], "-d") == 0) && (argi + 1 < argc)) {
+			pDisassembly = argv[++argi];
+		}
+		else if ((strcmp(argv[argi], "-l") == 0) && (argi + 1 < argc)) {
+			pLog = argv[++argi];
+		}
+		else if ((strcmp(argv[argi], "-c") == 0) && (argi + 1 < argc)) {
+			contextBytes = (uint32_t) strtoul(argv[++argi], NULL, 0);
+		}
+		else {
+			break;
+		}
+	}
+	if ((pDisassembly == NULL) || (argc - argi < 2)) {
+		fprintf(stderr, "usage: %s [-c context_bytes] [-l console.log] -d objdump.txt tasks.txt <.su file or dir>...\n",
+				argv[0]);
+		return 2;
+	}
+
+	if (loadTasks(argv[argi]) != 0) {
+		return 1;
+	}
+	for (argi++; argi < argc; argi++) {
+		loadSuPath(argv[argi]);
+	}
+	if (numSuFiles == 0) {
+		fprintf(stderr, "error: no .su files found, build with -fstack-usage\n");
+		return 1;
+	}
+	if (loadDisassembly(pDisassembly) != 0) {
+		return 1;
+	}
+	if (pLog != NULL) {
+		loadHighWaterMarks(pLog);
+	}
+
+	printf("%d .su files, context %u bytes, canary %u bytes\n\n", numSuFiles, (unsigned) contextBytes,
+		   (unsigned) CANARY_BYTES);
+	printf("%-16s %-24s %8s %8s %8s %8s %8s  %s\n",
+		   "task", "entry", "stack", "static", "needed", "measured", "suggest", "notes");
+	printf("%-16s %-24s %8s %8s %8s %8s %8s\n",
+		   "", "", "(bytes)", "(bytes)", "(bytes)", "(bytes)", "(words)");
+
+	for (i = 0; i < numTasks; i++) {
+		TASK_T *pTask = &tasks[i];
+		uint32_t stackBytes = pTask->stackWords * 4;
+
+		f = findFunc(pTask->entry, 0);
+		if (f < 0) {
+			printf("%-16s %-24s %8u  entry function not in the disassembly\n",
+				   pTask->name, pTask->entry, (unsigned) stackBytes);
+			continue;
+		}
+		computeWorst(f);
+		need = funcs[f].worst + contextBytes + CANARY_BYTES;
+
+		printf("%-16s %-24s %8u %8u %8u ", pTask->name, pTask->entry, (unsigned) stackBytes,
+			   (unsigned) funcs[f].worst, (unsigned) need);
+		if (pTask->minFree >= 0) {
+			printf("%8u ", (unsigned) (stackBytes - (uint32_t) pTask->minFree * 4));
+		}
+		else {
+			printf("%8s ", "-");
+		}
+
+		/* Round up to a whole number of 8 byte aligned words */
+		printf("%8u ", (unsigned) (((need + 7) / 8) * 2));
+		if (need > stackBytes) {
+			printf(" OVER");
+			over = 1;
+		}
+		else if (need < stackBytes / 2) {
+			printf(" oversized");
+		}
+		if ((pTask->minFree >= 0) && ((uint32_t) pTask->minFree * 4 < CANARY_BYTES)) {
+			printf(" canary-hit");
+			over = 1;
+		}
+		if ((pTask->minFree >= 0) && (stackBytes - (uint32_t) pTask->minFree * 4 > need)) {
+			/* Some of the call graph was not seen, usually a function pointer */
+			printf(" measured-exceeds-static");
+		}
+		printFlags(funcs[f].worstFlags);
+		printf("\n");
+		printPath(f);
+	}
+
+	/* Handlers run on the main stack, nested up to one per priority level */
+	printf("\ninterrupt handlers (main stack):\n");
+	for (f = 0; f < MAX_FUNCS; f++) {
+		if (!funcs[f].used || !isInterruptHandler(funcs[f].name)) {
+			continue;
+		}
+		computeWorst(f);
+		if (funcs[f].worst == 0) {
+			continue;
+		}
+		printf("  %-30s %6u", funcs[f].name, (unsigned) funcs[f].worst);
+		printFlags(funcs[f].worstFlags);
+		printf("\n");
+		isrSum += funcs[f].worst + 32;
+		if (funcs[f].worst + 32 > isrWorst) {
+			isrWorst = funcs[f].worst + 32;
+		}
+	}
+	printf("  worst single handler with its 32 byte frame %u bytes, all nested %u bytes\n",
+		   (unsigned) isrWorst, (unsigned) isrSum);
+
+	return over;
+}
@@ -0,0 +1,513 @@
+/*
+ * @brief Host timeline report for FreeRTOS Task Aware Debugger logs
+ *
+ * @note
+ * Reads the TAD_log_*.log files written by the MCUXpresso FreeRTOS Task
+ * Aware Debugger in one pass and rebuilds a timeline for every DSF debug
+ * session from its "TAD state changed" lines.  For each session it reports
+ * how long the target was halted (SUSPENDED) and running (RESUMED), how many
+ * single steps and breakpoint stops there were, and the distribution of step
+ * latency, the time from a STEP resume to the target halting again.
+ *
+ * TAD prints the milliseconds without leading zeros, "22:19:42.89" is 89 ms
+ * past the second, and the time of day only, so a time earlier than the line
+ * before it is taken to be on the next day.  State changes carry no session
+ * ID and belong to the session started most recently.  A session that never
+ * logs its end is closed by the next session starting or by the end of the
+ * file.
+ *
+ * Build:  gcc -O2 -o freertos_tad_report freertos_tad_report.c
+ * Usage:  freertos_tad_report [-c timeline.csv] [-j summary.json] TAD_log_*.log
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+#define MAX_LINE        4096
+#define MAX_NAME_LEN    64
+#define MS_PER_DAY      (24UL * 60 * 60 * 1000)
+
+typedef enum {
+	RUN_UNKNOWN = -1,
+	RUN_HALTED,
+	RUN_RUNNING
+} RUN_T;
+
+typedef struct {
+	uint32_t *pSamples;
+	int num, max;
+} SAMPLES_T;
+
+typedef struct {
+	char file[MAX_NAME_LEN];
+	int id;
+	int open;
+	uint64_t start, end;		/* ms since midnight of the first day in the file */
+	uint64_t last;				/* Time of the last state change */
+	RUN_T run;
+	char state[MAX_NAME_LEN];
+	char reason[MAX_NAME_LEN];
+	uint64_t time[2];			/* Halted and running time */
+	uint64_t resumeTime;
+	int stepPending;			/* Last resume was a STEP */
+	uint32_t resumes, steps, breakpoints, signals;
+	SAMPLES_T latency;			/* Step latencies */
+} SESSION_T;
+
+typedef struct {
+	const char *pFile;
+	SESSION_T *pCurrent;
+	uint64_t dayOffset, lastTime;
+	FILE *pCsv;
+} LOG_T;
+
+static SESSION_T *sessions;
+static int numSessions, maxSessions;
+
+/* Upper bounds of the step latency histogram, in ms */
+static const uint32_t histogramBounds[] = {50, 100, 200, 500, 1000, 2000, 5000, 10000};
+#define HISTOGRAM_BUCKETS   (sizeof(histogramBounds) / sizeof(histogramBounds[0]) + 1)
+
+static const char *const runNames[] = {"halted", "running"};
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static void *growArray(void *p, int *pMax, size_t elementSize)
+{
+	*pMax = *pMax ? (*pMax * 2) : 64;
+	p = realloc(p, (size_t) *pMax * elementSize);
+	if (p == NULL) {
+		fprintf(stderr, "error: out of memory\n");
+		exit(1);
+	}
+	return p;
+}
+
+static void addSample(SAMPLES_T *pSamples, uint32_t value)
+{
+	if (pSamples->num == pSamples->max) {
+		pSamples->pSamples = growArray(pSamples->pSamples, &pSamples->max, sizeof(uint32_t));
+	}
+	pSamples->pSamples[pSamples->num++] = value;
+}
+
+static int compareSamples(const void *a, const void *b)
+{
+	uint32_t sa = *(const uint32_t *) a, sb = *(const uint32_t *) b;
+
+	return (sa > sb) - (sa < sb);
+}
+
+/* Nearest rank percentile of sorted samples */
+static uint32_t percentile(const SAMPLES_T *pSamples, int pct)
+{
+	int rank = (pct * pSamples->num + 99) / 100;
+
+	return pSamples->num ? pSamples->pSamples[(rank > 0) ? (rank - 1) : 0] : 0;
+}
+
+static void formatTime(uint64_t ms, char *pOut, size_t size)
+{
+	snprintf(pOut, size, "%02u:%02u:%02u.%03u", (unsigned) ((ms / 3600000) % 24), (unsigned) ((ms / 60000) % 60),
+			 (unsigned) ((ms / 1000) % 60), (unsigned) (ms % 1000));
+}
+
+/* "HH:MM:SS.mmm" at the start of a line, unwrapped across midnight */
+static int parseTime(LOG_T *pLog, const char *line, uint64_t *pTime)
+{
+	unsigned h, m, s, ms;
+	uint64_t t;
+
+	if ((sscanf(line, "%u:%u:%u.%u", &h, &m, &s, &ms) != 4) || (h > 23) || (m > 59) || (s > 59) || (ms > 999)) {
+		return 0;
+	}
+	t = ((((uint64_t) h * 60 + m) * 60 + s) * 1000) + ms + pLog->dayOffset;
+	if (t < pLog->lastTime) {
+		pLog->dayOffset += MS_PER_DAY;
+		t += MS_PER_DAY;
+	}
+	pLog->lastTime = t;
+	*pTime = t;
+	return 1;
+}
+
+/* Account the time in the current state up to t, and write it to the CSV */
+static void closeInterval(LOG_T *pLog, SESSION_T *pSession, uint64_t t)
+{
+	char start[16];
+
+	if ((pSession->run == RUN_UNKNOWN) || (t < pSession->last)) {
+		return;
+	}
+	pSession->time[pSession->run] += t - pSession->last;
+	if (pLog->pCsv != NULL) {
+		formatTime(pSession->last, start, sizeof(start));
+		fprintf(pLog->pCsv, "%s,%d,%s,%llu,%llu,%s,%s,%s\n", pSession->file, pSession->id, start,
+				(unsigned long long) (pSession->last - pSession->start), (unsigned long long) (t - pSession->last),
+				pSession->state, runNames[pSession->run], pSession->reason);
+	}
+	pSession->last = t;
+}
+
+static void endSession(LOG_T *pLog, SESSION_T *pSession, uint64_t t)
+{
+	if (!pSession->open) {
+		return;
+	}
+	closeInterval(pLog, pSession, t);
+	pSession->end = t;
+	pSession->open = 0;
+	if (pLog->pCurrent == pSession) {
+		pLog->pCurrent = NULL;
+	}
+}
+
+static SESSION_T *startSession(LOG_T *pLog, int id, uint64_t t)
+{
+	SESSION_T *pSession;
+	const char *pName = strrchr(pLog->pFile, '/');
+
+	if (pLog->pCurrent != NULL) {
+		endSession(pLog, pLog->pCurrent, t);
+	}
+	if (numSessions == maxSessions) {
+		sessions = growArray(sessions, &maxSessions, sizeof(SESSION_T));
+	}
+	pSession = &sessions[numSessions++];
+	memset(pSession, 0, sizeof(*pSession));
+	snprintf(pSession->file, sizeof(pSession->file), "%s", (pName != NULL) ? (pName + 1) : pLog->pFile);
+	pSession->id = id;
+	pSession->open = 1;
+	pSession->start = pSession->end = pSession->last = t;
+	pSession->run = RUN_UNKNOWN;
+	pLog->pCurrent = pSession;
+	return pSession;
+}
+
+/* "A -> B (RESUMED|SUSPENDED, REASON)" */
+static void stateChanged(LOG_T *pLog, const char *pText, uint64_t t)
+{
+	char from[MAX_NAME_LEN], to[MAX_NAME_LEN], run[MAX_NAME_LEN], reason[MAX_NAME_LEN];
+	SESSION_T *pSession = pLog->pCurrent;
+
+	if (sscanf(pText, "%63s -> %63s (%63[^,], %63[^)])", from, to, run, reason) != 4) {
+		return;
+	}
+	if (pSession == NULL) {
+		/* Log started part way through a session */
+		pSession = startSession(pLog, -1, t);
+	}
+	closeInterval(pLog, pSession, t);
+
+	if (strcmp(run, "RESUMED") == 0) {
+		pSession->run = RUN_RUNNING;
+		pSession->resumes++;
+		pSession->resumeTime = t;
+		pSession->stepPending = (strcmp(reason, "STEP") == 0);
+	}
+	else {
+		pSession->run = RUN_HALTED;
+		if (strcmp(reason, "STEP") == 0) {
+			pSession->steps++;
+			if (pSession->stepPending) {
+				addSample(&pSession->latency, (uint32_t) (t - pSession->resumeTime));
+			}
+		}
+		else if (strcmp(reason, "BREAKPOINT") == 0) {
+			pSession->breakpoints++;
+		}
+		else if (strcmp(reason, "SIGNAL") == 0) {
+			pSession->signals++;
+		}
+		pSession->stepPending = 0;
+	}
+	snprintf(pSession->state, sizeof(pSession->state), "%s", to);
+	snprintf(pSession->reason, sizeof(pSession->reason), "%s", reason);
+	pSession->last = t;
+	pSession->end = t;
+}
+
+static int parseLog(const char *path, FILE *pCsv)
+{
+	char line[MAX_LINE];
+	const char *p;
+	LOG_T log;
+	uint64_t t;
+	size_t len;
+	int id, partial = 0;
+	FILE *fp;
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+	memset(&log, 0, sizeof(log));
+	log.pFile = path;
+	log.pCsv = pCsv;
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		/* Only the start of an overlong line is of interest */
+		len = strlen(line);
+		if (partial) {
+			partial = (len > 0) && (line[len - 1] != '\n');
+			continue;
+		}
+		partial = (len > 0) && (line[len - 1] != '\n');
+
+		if (!parseTime(&log, line, &t)) {
+			continue;
+		}
+		if ((p = strstr(line, "TAD state changed:")) != NULL) {
+			stateChanged(&log, p + strlen("TAD state changed:"), t);
+		}
+		else if ((p = strstr(line, "DSF session ID ")) != NULL) {
+			if (sscanf(p, "DSF session ID %d", &id) != 1) {
+				continue;
+			}
+			if (strstr(p, "has started") != NULL) {
+				startSession(&log, id, t);
+			}
+			else if ((strstr(p, "has ended") != NULL) && (log.pCurrent != NULL) && (log.pCurrent->id == id)) {
+				endSession(&log, log.pCurrent, t);
+			}
+		}
+	}
+	fclose(fp);
+
+	if (log.pCurrent != NULL) {
+		endSession(&log, log.pCurrent, log.lastTime);
+	}
+	return 0;
+}
+
+/* Combine every session into one for the totals */
+static void totalSessions(SESSION_T *pTotal)
+{
+	int i, j;
+
+	memset(pTotal, 0, sizeof(*pTotal));
+	pTotal->id = -1;
+	for (i = 0; i < numSessions; i++) {
+		const SESSION_T *pSession = &sessions[i];
+
+		pTotal->end += pSession->end - pSession->start;
+		pTotal->time[RUN_HALTED] += pSession->time[RUN_HALTED];
+		pTotal->time[RUN_RUNNING] += pSession->time[RUN_RUNNING];
+		pTotal->resumes += pSession->resumes;
+		pTotal->steps += pSession->steps;
+		pTotal->breakpoints += pSession->breakpoints;
+		pTotal->signals += pSession->signals;
+		for (j = 0; j < pSession->latency.num; j++) {
+			addSample(&pTotal->latency, pSession->latency.pSamples[j]);
+		}
+	}
+	qsort(pTotal->latency.pSamples, pTotal->latency.num, sizeof(uint32_t), compareSamples);
+}
+
+static double percentOf(uint64_t part, uint64_t whole)
+{
+	return whole ? (100.0 * (double) part / (double) whole) : 0.0;
+}
+
+static uint64_t sumSamples(const SAMPLES_T *pSamples)
+{
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < pSamples->num; i++) {
+		sum += pSamples->pSamples[i];
+	}
+	return sum;
+}
+
+static void printSession(const SESSION_T *pSession, const char *pStart)
+{
+	const SAMPLES_T *pLatency = &pSession->latency;
+	uint64_t length = pSession->end - pSession->start;
+
+	char id[16] = "-";
+
+	if (pSession->id >= 0) {
+		snprintf(id, sizeof(id), "%d", pSession->id);
+	}
+	printf("%-28s %4s %12s %10.1f %6.1f%% %6.1f%% %6u %6u", (pSession->file[0] != 0) ? pSession->file : "total", id,
+		   pStart, (double) length / 1000.0, percentOf(pSession->time[RUN_HALTED], length),
+		   percentOf(pSession->time[RUN_RUNNING], length), (unsigned) pSession->steps,
+		   (unsigned) pSession->breakpoints);
+	if (pLatency->num) {
+		printf(" %6u %6u %6u %6u\n", (unsigned) percentile(pLatency, 0), (unsigned) percentile(pLatency, 50),
+			   (unsigned) percentile(pLatency, 90), (unsigned) percentile(pLatency, 100));
+	}
+	else {
+		printf(" %6s %6s %6s %6s\n", "-", "-", "-", "-");
+	}
+}
+
+static void histogram(const SAMPLES_T *pSamples, uint32_t *pCounts)
+{
+	int i;
+	unsigned b;
+
+	memset(pCounts, 0, HISTOGRAM_BUCKETS * sizeof(uint32_t));
+	for (i = 0; i < pSamples->num; i++) {
+		for (b = 0; (b < HISTOGRAM_BUCKETS - 1) && (pSamples->pSamples[i] > histogramBounds[b]); b++) {}
+		pCounts[b]++;
+	}
+}
+
+static void printReport(const SESSION_T *pTotal)
+{
+	uint32_t counts[HISTOGRAM_BUCKETS];
+	char start[16];
+	unsigned b;
+	int i;
+
+	printf("%-28s %4s %12s %10s %7s %7s %6s %6s %6s %6s %6s %6s\n", "log", "id", "start", "length s",
+		   "halted", "running", "steps", "bkpts", "min", "p50", "p90", "max");
+	for (i = 0; i < numSessions; i++) {
+		formatTime(sessions[i].start, start, sizeof(start));
+		printSession(&sessions[i], start);
+	}
+	printSession(pTotal, "");
+	printf("\nhalted %.1f s, running %.1f s, %u resumes, %u signal stops\n",
+		   (double) pTotal->time[RUN_HALTED] / 1000.0, (double) pTotal->time[RUN_RUNNING] / 1000.0,
+		   (unsigned) pTotal->resumes, (unsigned) pTotal->signals);
+
+	if (pTotal->latency.num) {
+		printf("\nstep latency, %d steps, mean %.0f ms\n", pTotal->latency.num,
+			   (double) sumSamples(&pTotal->latency) / pTotal->latency.num);
+		histogram(&pTotal->latency, counts);
+		for (b = 0; b < HISTOGRAM_BUCKETS; b++) {
+			if (b < HISTOGRAM_BUCKETS - 1) {
+				printf("  <= %5u ms %6u\n", (unsigned) histogramBounds[b], (unsigned) counts[b]);
+			}
+			else {
+				printf("   > %5u ms %6u\n", (unsigned) histogramBounds[b - 1], (unsigned) counts[b]);
+			}
+		}
+	}
+}
+
+static void writeJsonSession(FILE *fp, const SESSION_T *pSession, const char *pIndent)
+{
+	const SAMPLES_T *pLatency = &pSession->latency;
+	char start[16];
+
+	if (pSession->file[0] != 0) {
+		formatTime(pSession->start, start, sizeof(start));
+		fprintf(fp, "%s\"log\": \"%s\", \"session\": %d, \"start\": \"%s\",\n", pIndent, pSession->file,
+				pSession->id, start);
+	}
+	fprintf(fp, "%s\"length_ms\": %llu, \"halted_ms\": %llu, \"running_ms\": %llu,\n", pIndent,
+			(unsigned long long) (pSession->end - pSession->start), (unsigned long long) pSession->time[RUN_HALTED],
+			(unsigned long long) pSession->time[RUN_RUNNING]);
+	fprintf(fp, "%s\"resumes\": %u, \"steps\": %u, \"breakpoints\": %u, \"signals\": %u,\n", pIndent,
+			(unsigned) pSession->resumes, (unsigned) pSession->steps, (unsigned) pSession->breakpoints,
+			(unsigned) pSession->signals);
+	fprintf(fp, "%s\"step_latency_ms\": {\"count\": %d, \"min\": %u, \"p50\": %u, \"p90\": %u, \"max\": %u, "
+			"\"mean\": %.1f}", pIndent, pLatency->num, (unsigned) percentile(pLatency, 0),
+			(unsigned) percentile(pLatency, 50), (unsigned) percentile(pLatency, 90),
+			(unsigned) percentile(pLatency, 100),
+			pLatency->num ? ((double) sumSamples(pLatency) / pLatency->num) : 0.0);
+}
+
+static int writeJson(const char *path, const SESSION_T *pTotal)
+{
+	uint32_t counts[HISTOGRAM_BUCKETS];
+	unsigned b;
+	int i;
+	FILE *fp;
+
+	fp = fopen(path, "w");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+	fprintf(fp, "{\n  \"sessions\": [\n");
+	for (i = 0; i < numSessions; i++) {
+		fprintf(fp, "    {\n");
+		writeJsonSession(fp, &sessions[i], "      ");
+		fprintf(fp, "\n    }%s\n", (i + 1 < numSessions) ? "," : "");
+	}
+	fprintf(fp, "  ],\n  \"total\": {\n");
+	writeJsonSession(fp, pTotal, "    ");
+	fprintf(fp, ",\n    \"step_latency_histogram\": [");
+	histogram(&pTotal->latency, counts);
+	for (b = 0; b < HISTOGRAM_BUCKETS; b++) {
+		if (b < HISTOGRAM_BUCKETS - 1) {
+			fprintf(fp, "{\"le_ms\": %u, \"count\": %u}, ", (unsigned) histogramBounds[b], (unsigned) counts[b]);
+		}
+		else {
+			fprintf(fp, "{\"le_ms\": null, \"count\": %u}", (unsigned) counts[b]);
+		}
+	}
+	fprintf(fp, "]\n  }\n}\n");
+	return fclose(fp);
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	const char *pCsvPath = NULL, *pJsonPath = NULL;
+	SESSION_T total;
+	FILE *pCsv = NULL;
+	int argi, i, ret = 0;
+
+	for (argi = 1; (argi < argc) && (argv[argi][0] == '-'); argi++) {
+		if ((strcmp(argv[argi], "-c") == 0) && (argi + 1 < argc)) {
+			pCsvPath = argv[++argi];
+		}
+		else if ((strcmp(argv[argi], "-j") == 0) && (argi + 1 < argc)) {
+			pJsonPath = argv[++argi];
+		}
+		else {
+			break;
+		}
+	}
+	if (argi >= argc) {
+		fprintf(stderr, "usage: %s [-c timeline.csv] [-j summary.json] TAD_log_*.log\n", argv[0]);
+		return 2;
+	}
+
+	if (pCsvPath != NULL) {
+		pCsv = fopen(pCsvPath, "w");
+		if (pCsv == NULL) {
+			perror(pCsvPath);
+			return 1;
+		}
+		fprintf(pCsv, "log,session,start,offset_ms,duration_ms,state,run,reason\n");
+	}
+	for (; argi < argc; argi++) {
+		if (parseLog(argv[argi], pCsv) != 0) {
+			ret = 1;
+		}
+	}
+	if ((pCsv != NULL) && (fclose(pCsv) != 0)) {
+		perror(pCsvPath);
+		ret = 1;
+	}
+
+	for (i = 0; i < numSessions; i++) {
+		qsort(sessions[i].latency.pSamples, sessions[i].latency.num, sizeof(uint32_t), compareSamples);
+	}
+	totalSessions(&total);
+	printReport(&total);
+
+	if ((pJsonPath != NULL) && (writeJson(pJsonPath, &total) != 0)) {
+		perror(pJsonPath);
+		ret = 1;
+	}
+	return ret;
+}
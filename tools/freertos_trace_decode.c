@@ -0,0 +1,356 @@
+/*
+ * @brief Host decoder for FreeRTOS binary trace recorder dumps
+ *
+ * @note
+ * Converts a raw image of xTraceRecorder (see freertos/inc/FreeRTOSTrace.h),
+ * as dumped by a debugger, into a Chrome trace / Perfetto JSON timeline.
+ * Each task becomes a thread track with one slice per time it was running,
+ * every other kernel event becomes an instant event on the running task.
+ * Task names come from the recorder's name table.
+ *
+ * Build:  gcc -O2 -o freertos_trace_decode freertos_trace_decode.c
+ * Usage:  freertos_trace_decode trace.bin > trace.json
+ *         then open trace.json in chrome://tracing or ui.perfetto.dev
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Must match FreeRTOSTrace.h */
+#define TRACE_MAGIC         0x52545246UL
+#define TRACE_VERSION       2
+#define TRACE_HEADER_SIZE   28
+#define TRACE_RECORD_SIZE   12
+
+#define TRACE_EV_TASK_SWITCHED_IN   1
+#define TRACE_EV_TASK_SWITCHED_OUT  2
+#define TRACE_EV_TASK_CREATE        3
+#define TRACE_EV_USER               0x8000
+
+#define MAX_TASKS       64
+#define MAX_NAME_LEN    32
+
+typedef struct {
+	uint64_t time;		/* Unwrapped timestamp */
+	uint32_t object;
+	uint16_t event;
+	uint16_t info;
+} RECORD_T;
+
+typedef struct {
+	uint32_t handle;
+	char name[MAX_NAME_LEN];
+} TASK_NAME_T;
+
+static const char *const eventNames[] = {
+	"NONE",
+	"TASK_SWITCHED_IN",
+	"TASK_SWITCHED_OUT",
+	"TASK_CREATE",
+	"TASK_DELETE",
+	"TASK_DELAY",
+	"TASK_DELAY_UNTIL",
+	"TASK_SUSPEND",
+	"TASK_RESUME",
+	"TASK_RESUME_FROM_ISR",
+	"TASK_PRIORITY_SET",
+	"TASK_PRIORITY_INHERIT",
+	"TASK_PRIORITY_DISINHERIT",
+	"TASK_READY",
+	"TICK",
+	"TICK_STEP",
+	"LOW_POWER_BEGIN",
+	"LOW_POWER_END",
+	"QUEUE_CREATE",
+	"MUTEX_CREATE",
+	"QUEUE_DELETE",
+	"QUEUE_SEND",
+	"QUEUE_SEND_FAILED",
+	"QUEUE_SEND_FROM_ISR",
+	"QUEUE_SEND_FROM_ISR_FAILED",
+	"QUEUE_RECEIVE",
+	"QUEUE_RECEIVE_FAILED",
+	"QUEUE_RECEIVE_FROM_ISR",
+	"QUEUE_RECEIVE_FROM_ISR_FAILED",
+	"QUEUE_PEEK",
+	"QUEUE_BLOCK_SEND",
+	"QUEUE_BLOCK_RECEIVE",
+	"MUTEX_GIVE_RECURSIVE",
+	"MUTEX_TAKE_RECURSIVE",
+	"TIMER_CREATE",
+	"TIMER_COMMAND_SEND",
+	"TIMER_COMMAND_RECEIVED",
+	"TIMER_EXPIRED",
+};
+
+static TASK_NAME_T tasks[MAX_TASKS];
+static int numTasks;
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+static uint32_t getU32(const unsigned char *p)
+{
+	return (uint32_t) p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static uint16_t getU16(const unsigned char *p)
+{
+	return (uint16_t) (p[0] | (p[1] << 8));
+}
+
+static TASK_NAME_T *findTask(uint32_t handle, int create)
+{
+	int i;
+
+	for (i = 0; i < numTasks; i++) {
+		if (tasks[i].handle == handle) {
+			return &tasks[i];
+		}
+	}
+	if (!create || (numTasks == MAX_TASKS)) {
+		return NULL;
+	}
+
+	tasks[numTasks].handle = handle;
+	snprintf(tasks[numTasks].name, MAX_NAME_LEN, "Task 0x%08x", (unsigned) handle);
+	return &tasks[numTasks++];
+}
+
+/* Print a string as the contents of a JSON string. Bytes outside printable
+   ASCII are escaped, so the output stays valid whatever the task names hold */
+static void printJsonString(const char *s)
+{
+	const unsigned char *p;
+
+	for (p = (const unsigned char *) s; *p != 0; p++) {
+		if ((*p == '"') || (*p == '\\')) {
+			printf("\\%c", *p);
+		}
+		else if ((*p < 0x20) || (*p >= 0x7F)) {
+			printf("\\u%04x", (unsigned) *p);
+		}
+		else {
+			putchar(*p);
+		}
+	}
+}
+
+/* Read the name table that follows the records, oldest entry first so the
+   most recent name of a reused handle wins */
+static int loadNames(FILE *fp, uint32_t nameCapacity, uint32_t nameSize, uint32_t namesWritten)
+{
+	unsigned char *pTable;
+	uint32_t i, first, count, len;
+	TASK_NAME_T *pTask;
+	const unsigned char *pEntry;
+
+	if ((nameCapacity == 0) || (nameSize <= 4)) {
+		return 0;
+	}
+	pTable = malloc(nameCapacity * nameSize);
+	if (pTable == NULL) {
+		return -1;
+	}
+	if (fread(pTable, 1, nameCapacity * nameSize, fp) != nameCapacity * nameSize) {
+		fprintf(stderr, "error: dump truncated in the name table\n");
+		free(pTable);
+		return -1;
+	}
+
+	count = (namesWritten < nameCapacity) ? namesWritten : nameCapacity;
+	first = (namesWritten < nameCapacity) ? 0 : (namesWritten % nameCapacity);
+	for (i = 0; i < count; i++) {
+		pEntry = &pTable[((first + i) % nameCapacity) * nameSize];
+		if (getU32(pEntry) == 0) {
+			continue;
+		}
+		pTask = findTask(getU32(pEntry), 1);
+		if (pTask == NULL) {
+			continue;
+		}
+		len = nameSize - 4;
+		if (len > (MAX_NAME_LEN - 1)) {
+			len = MAX_NAME_LEN - 1;
+		}
+		memcpy(pTask->name, pEntry + 4, len);
+		pTask->name[len] = 0;
+	}
+
+	free(pTable);
+	return 0;
+}
+
+static void printEventName(uint16_t event)
+{
+	if (event >= TRACE_EV_USER) {
+		printf("USER_%u", (unsigned) (event - TRACE_EV_USER));
+	}
+	else if (event < (sizeof(eventNames) / sizeof(eventNames[0]))) {
+		printf("%s", eventNames[event]);
+	}
+	else {
+		printf("EVENT_%u", (unsigned) event);
+	}
+}
+
+/* Read a recorder image and return the records in time order */
+static RECORD_T *loadRecords(FILE *fp, uint32_t *pCount, uint32_t *pHz)
+{
+	unsigned char header[TRACE_HEADER_SIZE], raw[TRACE_RECORD_SIZE];
+	uint32_t capacity, written, first, count, i, prev = 0;
+	uint16_t recordSize, nameCapacity, nameSize;
+	uint64_t time = 0;
+	RECORD_T *pRecords;
+
+	if (fread(header, 1, sizeof(header), fp) != sizeof(header)) {
+		fprintf(stderr, "error: dump is shorter than the recorder header\n");
+		return NULL;
+	}
+	if ((getU32(&header[0]) != TRACE_MAGIC) || (getU16(&header[4]) != TRACE_VERSION)) {
+		fprintf(stderr, "error: not a version %d trace recorder dump\n", TRACE_VERSION);
+		return NULL;
+	}
+
+	recordSize = getU16(&header[6]);
+	capacity = getU32(&header[8]);
+	*pHz = getU32(&header[12]);
+	written = getU32(&header[16]);
+	nameCapacity = getU16(&header[20]);
+	nameSize = getU16(&header[22]);
+	if ((recordSize != TRACE_RECORD_SIZE) || (capacity == 0) || (*pHz == 0)) {
+		fprintf(stderr, "error: unsupported or uninitialised recorder\n");
+		return NULL;
+	}
+
+	/* Oldest record is at the write position once the buffer has wrapped */
+	count = (written < capacity) ? written : capacity;
+	first = (written < capacity) ? 0 : (written % capacity);
+
+	pRecords = calloc(capacity, sizeof(RECORD_T));
+	if (pRecords == NULL) {
+		return NULL;
+	}
+	for (i = 0; i < capacity; i++) {
+		if (fread(raw, 1, sizeof(raw), fp) != sizeof(raw)) {
+			fprintf(stderr, "error: dump truncated at record %u\n", (unsigned) i);
+			free(pRecords);
+			return NULL;
+		}
+		pRecords[(i + capacity - first) % capacity].time = getU32(&raw[0]);
+		pRecords[(i + capacity - first) % capacity].object = getU32(&raw[4]);
+		pRecords[(i + capacity - first) % capacity].event = getU16(&raw[8]);
+		pRecords[(i + capacity - first) % capacity].info = getU16(&raw[10]);
+	}
+	if (loadNames(fp, nameCapacity, nameSize, getU32(&header[24])) != 0) {
+			free(pRecords);
+			return NULL;
+		}
+
+	/* Unwrap the 32-bit timestamps into a monotonic 64-bit time line */
+	for (i = 0; i < count; i++) {
+		uint32_t stamp = (uint32_t) pRecords[i].time;
+
+		if (i > 0) {
+			time += (uint32_t) (stamp - prev);
+		}
+		prev = stamp;
+		pRecords[i].time = time;
+	}
+
+	*pCount = count;
+	return pRecords;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	uint32_t count, hz, i, running = 0;
+	TASK_NAME_T *pTask;
+	RECORD_T *pRecords;
+	FILE *fp;
+
+	if (argc != 2) {
+		fprintf(stderr, "usage: %s <recorder dump>\n", argv[0]);
+		return 2;
+	}
+	fp = fopen(argv[1], "rb");
+	if (fp == NULL) {
+		perror(argv[1]);
+		return 1;
+	}
+	pRecords = loadRecords(fp, &count, &hz);
+	fclose(fp);
+	if (pRecords == NULL) {
+		return 1;
+	}
+
+	/* First pass, a track for every task seen, named or not */
+	for (i = 0; i < count; i++) {
+		if ((pRecords[i].event == TRACE_EV_TASK_CREATE) ||
+			(pRecords[i].event == TRACE_EV_TASK_SWITCHED_IN)) {
+			findTask(pRecords[i].object, 1);
+		}
+	}
+
+	printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"FreeRTOS\"}}");
+	for (i = 0; i < (uint32_t) numTasks; i++) {
+		printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"",
+			   (unsigned) tasks[i].handle);
+		printJsonString(tasks[i].name);
+		printf("\"}}");
+	}
+
+	/* Second pass, the time line */
+	for (i = 0; i < count; i++) {
+		double us = (double) pRecords[i].time * 1000000.0 / hz;
+
+		switch (pRecords[i].event) {
+		case TRACE_EV_TASK_SWITCHED_IN:
+			running = pRecords[i].object;
+			pTask = findTask(running, 0);
+			printf(",\n{\"name\":\"");
+			printJsonString(pTask ? pTask->name : "?");
+			printf("\",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"args\":{\"priority\":%u}}",
+				   (unsigned) running, us, (unsigned) pRecords[i].info);
+			break;
+
+		case TRACE_EV_TASK_SWITCHED_OUT:
+			/* A switch out without its switch in was cut off by the wrap */
+			if ((running != 0) && (pRecords[i].object == running)) {
+				printf(",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", (unsigned) running, us);
+			}
+			running = 0;
+			break;
+
+		default:
+			printf(",\n{\"name\":\"");
+			printEventName(pRecords[i].event);
+			printf("\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+				   "\"args\":{\"object\":\"0x%08x\",\"info\":%u}}",
+				   (unsigned) running, us, (unsigned) pRecords[i].object, (unsigned) pRecords[i].info);
+			break;
+		}
+	}
+
+	/* Close the slice of the task still running when the dump was taken */
+	if (running != 0 && count > 0) {
+		printf(",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", (unsigned) running,
+			   (double) pRecords[count - 1].time * 1000000.0 / hz);
+	}
+	printf("\n]}\n");
+
+	free(pRecords);
+	return 0;
+}
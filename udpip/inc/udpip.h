@@ -0,0 +1,233 @@
+/*
+ * @brief Minimal UDP/IPv4 stack over the Ethernet descriptor rings
+ *
+ * @note
+ * ARP, IPv4, ICMP echo and UDP for firmware that streams datagrams.  There
+ * is no heap and no copy: frames are built and parsed in place in the pool
+ * buffers of an ENET_RING_T (see Chip_ENET_Ring_Init()).  See readme.txt in
+ * this directory.
+ *
+ * @par
+ * The stack runs from one place, the background loop, a task or the
+ * Ethernet interrupt, because the buffer pool of the ring has no locking.
+ * It is written for a little endian CPU, as the LPC17xx is: header fields
+ * are read and written as native halfwords compared with UDPIP_HTONS()
+ * constants, UDPIP_IPADDR() puts the first byte of the address lowest, and
+ * UdpIp_Checksum() adds the packet as native words.  A big endian build
+ * stops with an error below instead of sending garbage.
+ */
+
+#ifndef __UDPIP_H_
+#define __UDPIP_H_
+
+#include "chip.h"
+
+#if (defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)) || \
+	(defined(__CC_ARM) && defined(__BIG_ENDIAN)) || (defined(__ICCARM__) && (__LITTLE_ENDIAN__ == 0))
+#error "udpip is written for a little endian CPU"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup UDPIP UDP/IP: Minimal UDP/IPv4 stack
+ * @{
+ */
+
+/** Number of entries in the ARP cache */
+#ifndef UDPIP_ARP_ENTRIES
+#define UDPIP_ARP_ENTRIES   4
+#endif
+
+/** Number of UDP ports that can be bound */
+#ifndef UDPIP_UDP_PORTS
+#define UDPIP_UDP_PORTS     4
+#endif
+
+/** Time to live of sent IP packets */
+#ifndef UDPIP_TTL
+#define UDPIP_TTL           64
+#endif
+
+#define UDPIP_ETH_HDR_LEN   14	/*!< Ethernet header size */
+#define UDPIP_IP_HDR_LEN    20	/*!< IPv4 header size, without options */
+#define UDPIP_UDP_HDR_LEN   8	/*!< UDP header size */
+
+/** Room in front of a payload from UdpIp_AllocPayload() for the headers */
+#define UDPIP_HDR_LEN       (UDPIP_ETH_HDR_LEN + UDPIP_IP_HDR_LEN + UDPIP_UDP_HDR_LEN)
+
+/** Largest UDP payload, datagrams are never fragmented */
+#define UDPIP_MAX_PAYLOAD   (1500 - UDPIP_IP_HDR_LEN - UDPIP_UDP_HDR_LEN)
+
+/** IPv4 address a.b.c.d as the stack keeps it, in network byte order */
+#define UDPIP_IPADDR(a, b, c, d) ((uint32_t) (a) | ((uint32_t) (b) << 8) | \
+								  ((uint32_t) (c) << 16) | ((uint32_t) (d) << 24))
+
+/** Swap a 16-bit value between host and network byte order */
+#define UDPIP_HTONS(x)      ((uint16_t) ((((x) & 0xFF) << 8) | (((x) >> 8) & 0xFF)))
+
+struct UDPIP;
+
+/**
+ * @brief	Datagram received callback
+ * @param	pStack	: Stack the datagram came in on
+ * @param	pData	: Payload, valid until the callback returns
+ * @param	len		: Payload length
+ * @param	srcIp	: Address of the sender
+ * @param	srcPort	: Port of the sender, in host byte order
+ * @param	ctx		: Context pointer given to UdpIp_Bind()
+ * @return	Nothing
+ * @note	The callback may send, with UdpIp_AllocPayload() and UdpIp_SendTo().
+ */
+typedef void (*UDPIP_RECV_T)(struct UDPIP *pStack, const uint8_t *pData, uint32_t len,
+							 uint32_t srcIp, uint16_t srcPort, void *ctx);
+
+/**
+ * @brief ARP cache entry
+ */
+typedef struct {
+	uint32_t ipAddr;		/*!< Address, 0 for an unused entry */
+	uint8_t macAddr[6];		/*!< Hardware address, once resolved */
+	uint8_t resolved;		/*!< Non-zero when macAddr is valid */
+	uint8_t *pPending;		/*!< Frame waiting for the ARP reply, or NULL */
+	uint16_t pendingLen;	/*!< Length of the waiting frame */
+} UDPIP_ARP_T;
+
+/**
+ * @brief Bound UDP port
+ */
+typedef struct {
+	uint16_t port;			/*!< Port in host byte order, 0 for a free entry */
+	UDPIP_RECV_T pRecv;		/*!< Datagram received callback */
+	void *ctx;				/*!< Passed to pRecv */
+} UDPIP_PORT_T;
+
+/**
+ * @brief UDP/IP stack state
+ */
+typedef struct UDPIP {
+	ENET_RING_T *pRing;		/*!< Rings the frames go through */
+	uint8_t macAddr[6];		/*!< Own hardware address */
+	uint16_t ipId;			/*!< Identification of the next IP packet */
+	uint32_t ipAddr;		/*!< Own address */
+	uint32_t netMask;		/*!< Subnet mask */
+	uint32_t gateway;		/*!< Router for addresses outside the subnet, or 0 */
+	uint32_t arpNext;		/*!< Next ARP entry to replace */
+	UDPIP_ARP_T arp[UDPIP_ARP_ENTRIES];		/*!< ARP cache */
+	UDPIP_PORT_T ports[UDPIP_UDP_PORTS];	/*!< Bound UDP ports */
+	uint32_t rxPackets;		/*!< UDP datagrams and pings handled */
+	uint32_t rxErrors;		/*!< Frames dropped for bad lengths or checksums */
+	uint32_t rxUnhandled;	/*!< Frames dropped for unknown protocols, ports or fragments */
+	uint32_t txPackets;		/*!< Frames handed to the MAC */
+	uint32_t txDropped;		/*!< Frames dropped for want of descriptors or an ARP reply */
+} UDPIP_T;
+
+/**
+ * @brief	Set up the stack
+ * @param	pStack	: Stack to set up
+ * @param	pRing	: Rings set up with Chip_ENET_Ring_Init() and a NULL
+ *					  frame sent callback, so that sent frames go back to the pool
+ * @param	macAddr	: Own hardware address, as given to Chip_ENET_SetADDR()
+ * @param	ipAddr	: Own address, UDPIP_IPADDR(192, 168, 1, 10) for example
+ * @param	netMask	: Subnet mask
+ * @param	gateway	: Router for addresses outside the subnet, or 0
+ * @return	Nothing
+ */
+void UdpIp_Init(UDPIP_T *pStack, ENET_RING_T *pRing, const uint8_t *macAddr,
+				uint32_t ipAddr, uint32_t netMask, uint32_t gateway);
+
+/**
+ * @brief	Receive the datagrams sent to a UDP port
+ * @param	pStack	: Stack set up with UdpIp_Init()
+ * @param	port	: Port in host byte order
+ * @param	pRecv	: Datagram received callback
+ * @param	ctx		: Passed to the callback
+ * @return	ERROR if all UDPIP_UDP_PORTS entries are in use, SUCCESS otherwise
+ */
+Status UdpIp_Bind(UDPIP_T *pStack, uint16_t port, UDPIP_RECV_T pRecv, void *ctx);
+
+/**
+ * @brief	Handle the received frames and finish the sent ones
+ * @param	pStack	: Stack set up with UdpIp_Init()
+ * @return	Number of frames received
+ * @note	Answers ARP requests and pings, and calls the bound UDP
+ *			callbacks. Call it from the ENET_INT_RXDONE interrupt or
+ *			regularly from the background loop.
+ */
+uint32_t UdpIp_Poll(UDPIP_T *pStack);
+
+/**
+ * @brief	Take a buffer to write a datagram payload into
+ * @param	pStack	: Stack set up with UdpIp_Init()
+ * @return	Room for UDPIP_MAX_PAYLOAD bytes, or NULL if the pool is empty
+ * @note	The headers go in front of the payload in the same pool buffer,
+ *			so the payload is never copied. Hand it to UdpIp_SendTo() or
+ *			back with UdpIp_FreePayload().
+ */
+STATIC INLINE uint8_t *UdpIp_AllocPayload(UDPIP_T *pStack)
+{
+	uint8_t *pBuf = Chip_ENET_Ring_AllocBuf(pStack->pRing);
+
+	return (pBuf != NULL) ? pBuf + UDPIP_HDR_LEN : NULL;
+}
+
+/**
+ * @brief	Give back a payload buffer that is not sent
+ * @param	pStack		: Stack set up with UdpIp_Init()
+ * @param	pPayload	: Buffer from UdpIp_AllocPayload()
+ * @return	Nothing
+ */
+STATIC INLINE void UdpIp_FreePayload(UDPIP_T *pStack, uint8_t *pPayload)
+{
+	Chip_ENET_Ring_FreeBuf(pStack->pRing, pPayload - UDPIP_HDR_LEN);
+}
+
+/**
+ * @brief	Send a datagram, without copying it
+ * @param	pStack		: Stack set up with UdpIp_Init()
+ * @param	pPayload	: Buffer from UdpIp_AllocPayload() holding the payload
+ * @param	len			: Payload length, at most UDPIP_MAX_PAYLOAD
+ * @param	dstIp		: Destination address, 0xFFFFFFFF to broadcast
+ * @param	dstPort		: Destination port, in host byte order
+ * @param	srcPort		: Source port, in host byte order
+ * @return	ERROR if the datagram was dropped, SUCCESS otherwise
+ * @note	The buffer is taken over in both cases. When the hardware
+ *			address of the next hop is not known yet, the frame waits in
+ *			the ARP cache for the reply, and is replaced by the next
+ *			datagram for the same hop if the reply has not come.
+ */
+Status UdpIp_SendTo(UDPIP_T *pStack, uint8_t *pPayload, uint32_t len,
+					uint32_t dstIp, uint16_t dstPort, uint16_t srcPort);
+
+/**
+ * @brief	Add data to an Internet checksum
+ * @param	pData	: Data, any alignment
+ * @param	len		: Number of bytes, even except for the last piece
+ * @param	sum		: 0, or the result for the previous pieces
+ * @return	The one's complement sum, folded to 16 bits, in network byte
+ *			order as it is stored in the packet
+ * @note	Adds 32-bit words into a 64-bit accumulator, 16 bytes per loop,
+ *			and folds the carries once at the end.
+ */
+uint32_t UdpIp_Checksum(const void *pData, uint32_t len, uint32_t sum);
+
+/**
+ * @brief	Turn a sum from UdpIp_Checksum() into the checksum field value
+ * @param	sum		: Folded one's complement sum
+ * @return	The value to store in the header
+ */
+STATIC INLINE uint16_t UdpIp_ChecksumFinish(uint32_t sum)
+{
+	return (uint16_t) ~sum;
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UDPIP_H_ */
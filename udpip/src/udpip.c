@@ -0,0 +1,543 @@
+/*
+ * @brief Minimal UDP/IPv4 stack over the Ethernet descriptor rings
+ *
+ * @note
+ * Received frames are handled in the pool buffer the MAC wrote them to.
+ * ARP replies and ping replies are made by rewriting the request in place
+ * and sending the same buffer back.  Datagrams are built in a pool buffer
+ * the application wrote its payload into.
+ */
+
+#include <string.h>
+#include "udpip.h"
+
+/*****************************************************************************
+ * Private types/enumerations/variables
+ ****************************************************************************/
+
+/* Ethernet header */
+#define ETH_DST             0
+#define ETH_SRC             6
+#define ETH_TYPE            12
+#define ETH_TYPE_IP         UDPIP_HTONS(0x0800)
+#define ETH_TYPE_ARP        UDPIP_HTONS(0x0806)
+
+/* ARP packet for IPv4 over Ethernet, after the Ethernet header */
+#define ARP_HTYPE           14
+#define ARP_PTYPE           16
+#define ARP_HLEN            18
+#define ARP_OPER            20
+#define ARP_SHA             22
+#define ARP_SPA             28
+#define ARP_THA             32
+#define ARP_TPA             38
+#define ARP_FRAME_LEN       42
+#define ARP_OPER_REQUEST    UDPIP_HTONS(1)
+#define ARP_OPER_REPLY      UDPIP_HTONS(2)
+
+/* IPv4 header */
+#define IP_VHL              14
+#define IP_TOS              15
+#define IP_LEN              16
+#define IP_ID               18
+#define IP_FRAG             20
+#define IP_TTL              22
+#define IP_PROTO            23
+#define IP_SUM              24
+#define IP_SRC              26
+#define IP_DST              30
+#define IP_FRAG_DF          UDPIP_HTONS(0x4000)
+#define IP_FRAG_MASK        UDPIP_HTONS(0x3FFF)	/* More fragments and offset */
+#define IP_PROTO_ICMP       1
+#define IP_PROTO_UDP        17
+
+/* ICMP and UDP headers, from the start of the IP payload */
+#define ICMP_TYPE           0
+#define ICMP_SUM            2
+#define ICMP_ECHO_REPLY     0
+#define ICMP_ECHO_REQUEST   8
+#define UDP_SRC             0
+#define UDP_DST             2
+#define UDP_LEN             4
+#define UDP_SUM             6
+
+/* 16-bit field at an even offset of a frame */
+#define FIELD16(p, off)     (*(uint16_t *) ((p) + (off)))
+
+static const uint8_t macBroadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+/*****************************************************************************
+ * Public types/enumerations/variables
+ ****************************************************************************/
+
+/*****************************************************************************
+ * Private functions
+ ****************************************************************************/
+
+/* Read an address from a frame, it is only 2 byte aligned */
+static uint32_t getIp(const uint8_t *p)
+{
+	uint32_t ip;
+
+	memcpy(&ip, p, 4);
+	return ip;
+}
+
+/* Sum of the IPv4 pseudo header, for the UDP checksum */
+static uint32_t pseudoSum(uint32_t srcIp, uint32_t dstIp, uint32_t udpLen)
+{
+	return (srcIp & 0xFFFF) + (srcIp >> 16) + (dstIp & 0xFFFF) + (dstIp >> 16) +
+		   UDPIP_HTONS(IP_PROTO_UDP) + UDPIP_HTONS(udpLen);
+}
+
+/* Hand a frame to the MAC, the pool buffer comes back once it is sent */
+static Status sendFrame(UDPIP_T *pStack, uint8_t *pFrame, uint32_t len)
+{
+	ENET_FRAG_T frag;
+
+	frag.pData = pFrame;
+	frag.len = len;
+	if (Chip_ENET_Ring_Send(pStack->pRing, &frag, 1, pFrame) != SUCCESS) {
+		Chip_ENET_Ring_FreeBuf(pStack->pRing, pFrame);
+		pStack->txDropped++;
+		return ERROR;
+	}
+
+	pStack->txPackets++;
+	return SUCCESS;
+}
+
+/* Find the ARP cache entry of an address */
+static UDPIP_ARP_T *arpFind(UDPIP_T *pStack, uint32_t ip)
+{
+	int i;
+
+	for (i = 0; i < UDPIP_ARP_ENTRIES; i++) {
+		if (pStack->arp[i].ipAddr == ip) {
+			return &pStack->arp[i];
+		}
+	}
+	return NULL;
+}
+
+/* Take an ARP cache entry for an address, replacing the oldest one */
+static UDPIP_ARP_T *arpNew(UDPIP_T *pStack, uint32_t ip)
+{
+	UDPIP_ARP_T *pEntry = &pStack->arp[pStack->arpNext];
+
+	pStack->arpNext = (pStack->arpNext + 1) % UDPIP_ARP_ENTRIES;
+	if (pEntry->pPending != NULL) {
+		Chip_ENET_Ring_FreeBuf(pStack->pRing, pEntry->pPending);
+		pStack->txDropped++;
+	}
+	pEntry->ipAddr = ip;
+	pEntry->resolved = 0;
+	pEntry->pPending = NULL;
+	return pEntry;
+}
+
+/* Store a resolved address and send the frame waiting for it */
+static void arpUpdate(UDPIP_T *pStack, UDPIP_ARP_T *pEntry, const uint8_t *macAddr)
+{
+	uint8_t *pFrame = pEntry->pPending;
+
+	memcpy(pEntry->macAddr, macAddr, 6);
+	pEntry->resolved = 1;
+	if (pFrame != NULL) {
+		pEntry->pPending = NULL;
+		memcpy(pFrame + ETH_DST, macAddr, 6);
+		sendFrame(pStack, pFrame, pEntry->pendingLen);
+	}
+}
+
+/* Fill the Ethernet and ARP fields shared by requests and replies */
+static void arpFill(UDPIP_T *pStack, uint8_t *pFrame, uint16_t oper,
+					const uint8_t *dstMac, uint32_t dstIp)
+{
+	memcpy(pFrame + ETH_DST, (oper == ARP_OPER_REQUEST) ? macBroadcast : dstMac, 6);
+	memcpy(pFrame + ETH_SRC, pStack->macAddr, 6);
+	FIELD16(pFrame, ETH_TYPE) = ETH_TYPE_ARP;
+	FIELD16(pFrame, ARP_HTYPE) = UDPIP_HTONS(1);
+	FIELD16(pFrame, ARP_PTYPE) = ETH_TYPE_IP;
+	FIELD16(pFrame, ARP_HLEN) = 6 | (4 << 8);
+	FIELD16(pFrame, ARP_OPER) = oper;
+	memcpy(pFrame + ARP_SHA, pStack->macAddr, 6);
+	memcpy(pFrame + ARP_SPA, &pStack->ipAddr, 4);
+	memcpy(pFrame + ARP_THA, dstMac, 6);
+	memcpy(pFrame + ARP_TPA, &dstIp, 4);
+}
+
+/* Ask for the hardware address of an address */
+static void arpRequest(UDPIP_T *pStack, uint32_t ip)
+{
+	static const uint8_t macUnknown[6] = {0, 0, 0, 0, 0, 0};
+	uint8_t *pFrame = Chip_ENET_Ring_AllocBuf(pStack->pRing);
+
+	/* Without a buffer the next datagram for this hop asks again */
+	if (pFrame != NULL) {
+		arpFill(pStack, pFrame, ARP_OPER_REQUEST, macUnknown, ip);
+		sendFrame(pStack, pFrame, ARP_FRAME_LEN);
+	}
+}
+
+/* Handle an ARP packet, returns true if the frame was sent back */
+static bool arpInput(UDPIP_T *pStack, uint8_t *pFrame, uint32_t len)
+{
+	UDPIP_ARP_T *pEntry;
+	uint32_t senderIp;
+	uint8_t senderMac[6];
+	uint16_t oper;
+
+	if ((len < ARP_FRAME_LEN) || (FIELD16(pFrame, ARP_HTYPE) != UDPIP_HTONS(1)) ||
+		(FIELD16(pFrame, ARP_PTYPE) != ETH_TYPE_IP) || (FIELD16(pFrame, ARP_HLEN) != (6 | (4 << 8)))) {
+		pStack->rxErrors++;
+		return false;
+	}
+
+	/* Keep the hardware address of whoever asks for or answers with ours */
+	senderIp = getIp(pFrame + ARP_SPA);
+	pEntry = arpFind(pStack, senderIp);
+	if (getIp(pFrame + ARP_TPA) != pStack->ipAddr) {
+		if (pEntry != NULL) {
+			arpUpdate(pStack, pEntry, pFrame + ARP_SHA);
+		}
+		return false;
+	}
+	if (pEntry == NULL) {
+		pEntry = arpNew(pStack, senderIp);
+	}
+	arpUpdate(pStack, pEntry, pFrame + ARP_SHA);
+
+	oper = FIELD16(pFrame, ARP_OPER);
+	if (oper != ARP_OPER_REQUEST) {
+		return false;
+	}
+
+	/* The request becomes the reply */
+	memcpy(senderMac, pFrame + ARP_SHA, 6);
+	arpFill(pStack, pFrame, ARP_OPER_REPLY, senderMac, senderIp);
+	sendFrame(pStack, pFrame, ARP_FRAME_LEN);
+	return true;
+}
+
+/* Answer a ping in place, returns true if the frame was sent back */
+static bool icmpInput(UDPIP_T *pStack, uint8_t *pFrame, uint32_t hdrLen, uint32_t ipLen)
+{
+	uint8_t *pIcmp = pFrame + UDPIP_ETH_HDR_LEN + hdrLen;
+	uint32_t icmpLen = ipLen - hdrLen, sum, ip;
+	uint8_t mac[6];
+
+	if ((icmpLen < 8) || (UdpIp_Checksum(pIcmp, icmpLen, 0) != 0xFFFF)) {
+		pStack->rxErrors++;
+		return false;
+	}
+	if (pIcmp[ICMP_TYPE] != ICMP_ECHO_REQUEST) {
+		pStack->rxUnhandled++;
+		return false;
+	}
+	pStack->rxPackets++;
+
+	/* Changing the type from 8 to 0 lowers the sum by 0x0800, raise the
+	   checksum by as much (RFC 1624) */
+	pIcmp[ICMP_TYPE] = ICMP_ECHO_REPLY;
+	sum = (uint32_t) FIELD16(pIcmp, ICMP_SUM) + UDPIP_HTONS(ICMP_ECHO_REQUEST << 8);
+	FIELD16(pIcmp, ICMP_SUM) = (uint16_t) (sum + (sum >> 16));
+
+	ip = getIp(pFrame + IP_SRC);
+	memcpy(pFrame + IP_SRC, &pStack->ipAddr, 4);
+	memcpy(pFrame + IP_DST, &ip, 4);
+	pFrame[IP_TTL] = UDPIP_TTL;
+	FIELD16(pFrame, IP_SUM) = 0;
+	FIELD16(pFrame, IP_SUM) = UdpIp_ChecksumFinish(UdpIp_Checksum(pFrame + IP_VHL, hdrLen, 0));
+
+	memcpy(mac, pFrame + ETH_SRC, 6);
+	memcpy(pFrame + ETH_DST, mac, 6);
+	memcpy(pFrame + ETH_SRC, pStack->macAddr, 6);
+
+	sendFrame(pStack, pFrame, UDPIP_ETH_HDR_LEN + ipLen);
+	return true;
+}
+
+/* Hand a datagram to its port */
+static void udpInput(UDPIP_T *pStack, uint8_t *pFrame, uint32_t hdrLen, uint32_t ipLen)
+{
+	uint8_t *pUdp = pFrame + UDPIP_ETH_HDR_LEN + hdrLen;
+	uint32_t udpLen, srcIp;
+	uint16_t port;
+	int i;
+
+	if (ipLen - hdrLen < UDPIP_UDP_HDR_LEN) {
+		pStack->rxErrors++;
+		return;
+	}
+	udpLen = UDPIP_HTONS(FIELD16(pUdp, UDP_LEN));
+	srcIp = getIp(pFrame + IP_SRC);
+	if ((udpLen < UDPIP_UDP_HDR_LEN) || (udpLen > ipLen - hdrLen) ||
+		((FIELD16(pUdp, UDP_SUM) != 0) &&
+		 (UdpIp_Checksum(pUdp, udpLen, pseudoSum(srcIp, getIp(pFrame + IP_DST), udpLen)) != 0xFFFF))) {
+		pStack->rxErrors++;
+		return;
+	}
+
+	port = UDPIP_HTONS(FIELD16(pUdp, UDP_DST));
+	for (i = 0; i < UDPIP_UDP_PORTS; i++) {
+		if ((pStack->ports[i].port == port) && (port != 0)) {
+			pStack->rxPackets++;
+			pStack->ports[i].pRecv(pStack, pUdp + UDPIP_UDP_HDR_LEN, udpLen - UDPIP_UDP_HDR_LEN,
+								   srcIp, UDPIP_HTONS(FIELD16(pUdp, UDP_SRC)), pStack->ports[i].ctx);
+			return;
+		}
+	}
+	pStack->rxUnhandled++;
+}
+
+/* Check an IP packet for us, returns true if the frame was sent back */
+static bool ipInput(UDPIP_T *pStack, uint8_t *pFrame, uint32_t len)
+{
+	uint32_t hdrLen, ipLen, dst;
+
+	if (len < UDPIP_ETH_HDR_LEN + UDPIP_IP_HDR_LEN) {
+		pStack->rxErrors++;
+		return false;
+	}
+	hdrLen = (pFrame[IP_VHL] & 0x0F) * 4;
+	ipLen = UDPIP_HTONS(FIELD16(pFrame, IP_LEN));
+	if (((pFrame[IP_VHL] >> 4) != 4) || (hdrLen < UDPIP_IP_HDR_LEN) || (ipLen < hdrLen) ||
+		(ipLen > len - UDPIP_ETH_HDR_LEN) || (UdpIp_Checksum(pFrame + IP_VHL, hdrLen, 0) != 0xFFFF)) {
+		pStack->rxErrors++;
+		return false;
+	}
+
+	dst = getIp(pFrame + IP_DST);
+	if ((dst != pStack->ipAddr) && (dst != 0xFFFFFFFF) && (dst != (pStack->ipAddr | ~pStack->netMask))) {
+		pStack->rxUnhandled++;
+		return false;
+	}
+	if ((FIELD16(pFrame, IP_FRAG) & IP_FRAG_MASK) != 0) {
+		pStack->rxUnhandled++;
+		return false;
+	}
+
+	switch (pFrame[IP_PROTO]) {
+	case IP_PROTO_UDP:
+		udpInput(pStack, pFrame, hdrLen, ipLen);
+		return false;
+
+	case IP_PROTO_ICMP:
+		/* Only pings sent to us are answered */
+		if (dst == pStack->ipAddr) {
+			return icmpInput(pStack, pFrame, hdrLen, ipLen);
+		}
+		break;
+	}
+	pStack->rxUnhandled++;
+	return false;
+}
+
+/*****************************************************************************
+ * Public functions
+ ****************************************************************************/
+
+/* Set up the stack */
+void UdpIp_Init(UDPIP_T *pStack, ENET_RING_T *pRing, const uint8_t *macAddr,
+				uint32_t ipAddr, uint32_t netMask, uint32_t gateway)
+{
+	memset(pStack, 0, sizeof(UDPIP_T));
+	pStack->pRing = pRing;
+	memcpy(pStack->macAddr, macAddr, 6);
+	pStack->ipAddr = ipAddr;
+	pStack->netMask = netMask;
+	pStack->gateway = gateway;
+}
+
+/* Receive the datagrams sent to a UDP port */
+Status UdpIp_Bind(UDPIP_T *pStack, uint16_t port, UDPIP_RECV_T pRecv, void *ctx)
+{
+	int i;
+
+	for (i = 0; i < UDPIP_UDP_PORTS; i++) {
+		if (pStack->ports[i].port == 0) {
+			pStack->ports[i].port = port;
+			pStack->ports[i].pRecv = pRecv;
+			pStack->ports[i].ctx = ctx;
+			return SUCCESS;
+		}
+	}
+	return ERROR;
+}
+
+/* Handle the received frames and finish the sent ones */
+uint32_t UdpIp_Poll(UDPIP_T *pStack)
+{
+	uint8_t *pFrame;
+	uint32_t len, frames = 0;
+	bool sent;
+
+	while ((pFrame = Chip_ENET_Ring_Receive(pStack->pRing, &len)) != NULL) {
+		frames++;
+		switch (FIELD16(pFrame, ETH_TYPE)) {
+		case ETH_TYPE_IP:
+			sent = ipInput(pStack, pFrame, len);
+			break;
+
+		case ETH_TYPE_ARP:
+			sent = arpInput(pStack, pFrame, len);
+			break;
+
+		default:
+			pStack->rxUnhandled++;
+			sent = false;
+			break;
+		}
+		if (!sent) {
+			Chip_ENET_Ring_FreeBuf(pStack->pRing, pFrame);
+		}
+	}
+	Chip_ENET_Ring_TxReclaim(pStack->pRing);
+
+	return frames;
+}
+
+/* Send a datagram, without copying it */
+Status UdpIp_SendTo(UDPIP_T *pStack, uint8_t *pPayload, uint32_t len,
+					uint32_t dstIp, uint16_t dstPort, uint16_t srcPort)
+{
+	uint8_t *pFrame = pPayload - UDPIP_HDR_LEN;
+	uint8_t *pUdp = pFrame + UDPIP_ETH_HDR_LEN + UDPIP_IP_HDR_LEN;
+	uint32_t udpLen = len + UDPIP_UDP_HDR_LEN, frameLen = UDPIP_HDR_LEN + len, hop;
+	UDPIP_ARP_T *pEntry;
+	uint16_t sum;
+
+	if (len > UDPIP_MAX_PAYLOAD) {
+		Chip_ENET_Ring_FreeBuf(pStack->pRing, pFrame);
+		pStack->txDropped++;
+		return ERROR;
+	}
+
+	/* UDP header, the checksum covers it, the payload and the pseudo header
+	   in one pass */
+	FIELD16(pUdp, UDP_SRC) = UDPIP_HTONS(srcPort);
+	FIELD16(pUdp, UDP_DST) = UDPIP_HTONS(dstPort);
+	FIELD16(pUdp, UDP_LEN) = UDPIP_HTONS(udpLen);
+	FIELD16(pUdp, UDP_SUM) = 0;
+	sum = UdpIp_ChecksumFinish(UdpIp_Checksum(pUdp, udpLen, pseudoSum(pStack->ipAddr, dstIp, udpLen)));
+	FIELD16(pUdp, UDP_SUM) = (sum != 0) ? sum : 0xFFFF;
+
+	/* IP header, no options, version and length share a halfword with TOS 0 */
+	FIELD16(pFrame, IP_VHL) = 0x45;
+	FIELD16(pFrame, IP_LEN) = UDPIP_HTONS(udpLen + UDPIP_IP_HDR_LEN);
+	FIELD16(pFrame, IP_ID) = UDPIP_HTONS(pStack->ipId);
+	pStack->ipId++;
+	FIELD16(pFrame, IP_FRAG) = IP_FRAG_DF;
+	pFrame[IP_TTL] = UDPIP_TTL;
+	pFrame[IP_PROTO] = IP_PROTO_UDP;
+	FIELD16(pFrame, IP_SUM) = 0;
+	memcpy(pFrame + IP_SRC, &pStack->ipAddr, 4);
+	memcpy(pFrame + IP_DST, &dstIp, 4);
+	FIELD16(pFrame, IP_SUM) = UdpIp_ChecksumFinish(UdpIp_Checksum(pFrame + IP_VHL, UDPIP_IP_HDR_LEN, 0));
+
+	memcpy(pFrame + ETH_SRC, pStack->macAddr, 6);
+	FIELD16(pFrame, ETH_TYPE) = ETH_TYPE_IP;
+
+	/* Broadcasts and datagrams to ourselves need no ARP */
+	if ((dstIp == 0xFFFFFFFF) || (dstIp == (pStack->ipAddr | ~pStack->netMask))) {
+		memcpy(pFrame + ETH_DST, macBroadcast, 6);
+		return sendFrame(pStack, pFrame, frameLen);
+	}
+	if (dstIp == pStack->ipAddr) {
+		memcpy(pFrame + ETH_DST, pStack->macAddr, 6);
+		return sendFrame(pStack, pFrame, frameLen);
+	}
+
+	hop = dstIp;
+	if (((dstIp ^ pStack->ipAddr) & pStack->netMask) != 0) {
+		if (pStack->gateway == 0) {
+			Chip_ENET_Ring_FreeBuf(pStack->pRing, pFrame);
+			pStack->txDropped++;
+			return ERROR;
+		}
+		hop = pStack->gateway;
+	}
+
+	pEntry = arpFind(pStack, hop);
+	if ((pEntry != NULL) && pEntry->resolved) {
+		memcpy(pFrame + ETH_DST, pEntry->macAddr, 6);
+		return sendFrame(pStack, pFrame, frameLen);
+	}
+
+	/* Park the frame until the reply comes, asking again each time */
+	if (pEntry == NULL) {
+		pEntry = arpNew(pStack, hop);
+	}
+	else if (pEntry->pPending != NULL) {
+		Chip_ENET_Ring_FreeBuf(pStack->pRing, pEntry->pPending);
+		pStack->txDropped++;
+	}
+	pEntry->pPending = pFrame;
+	pEntry->pendingLen = (uint16_t) frameLen;
+	arpRequest(pStack, hop);
+
+	return SUCCESS;
+}
+
+/* Add data to an Internet checksum */
+uint32_t UdpIp_Checksum(const void *pData, uint32_t len, uint32_t sum)
+{
+	const uint8_t *p = (const uint8_t *) pData;
+	const uint32_t *pWord;
+	uint64_t acc = 0;
+	uint32_t odd = (uint32_t) p & 1;
+
+	/* Align to a word. A byte at an odd address is the high byte of its
+	   halfword, so an odd start swaps the bytes of the whole sum. */
+	if ((odd != 0) && (len > 0)) {
+		acc = (uint32_t) *p++ << 8;
+		len--;
+	}
+	if ((((uint32_t) p & 2) != 0) && (len >= 2)) {
+		acc += *(const uint16_t *) p;
+		p += 2;
+		len -= 2;
+	}
+
+	/* The 64-bit accumulator keeps the carries, 16 bytes per loop */
+	pWord = (const uint32_t *) p;
+	while (len >= 16) {
+		acc += pWord[0];
+		acc += pWord[1];
+		acc += pWord[2];
+		acc += pWord[3];
+		pWord += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		acc += *pWord++;
+		len -= 4;
+	}
+	p = (const uint8_t *) pWord;
+	if (len >= 2) {
+		acc += *(const uint16_t *) p;
+		p += 2;
+		len -= 2;
+	}
+	if (len > 0) {
+		acc += *p;
+	}
+
+	/* Fold 64 to 16 bits */
+	acc = (acc & 0xFFFFFFFF) + (acc >> 32);
+	acc = (acc & 0xFFFFFFFF) + (acc >> 32);
+	acc = (acc & 0xFFFF) + (acc >> 16);
+	acc = (acc & 0xFFFF) + (acc >> 16);
+	acc = (acc & 0xFFFF) + (acc >> 16);
+	if (odd != 0) {
+		acc = ((acc & 0xFF) << 8) | (acc >> 8);
+	}
+
+	/* Add the earlier pieces */
+	acc += sum;
+	acc = (acc & 0xFFFF) + (acc >> 16);
+	acc = (acc & 0xFFFF) + (acc >> 16);
+
+	return (uint32_t) acc;
+}